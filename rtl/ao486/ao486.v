@@ -26,7 +26,18 @@
 
 `include "defines.v"
 
-module ao486 (
+module ao486
+#(
+	parameter ICACHE_LINES         = 128, // l1 instruction cache geometry, see rtl/cache/l1_icache.v
+	parameter ICACHE_LINESIZE      = 8,
+	parameter ICACHE_ASSOCIATIVITY = 4,
+	parameter ICACHE_PREFETCH      = 0,   // next line prefetch
+	parameter DCACHE               = 0,   // l1 data cache, see rtl/cache/l1_dcache.v; 1 builds it in
+	parameter DCACHE_LINES         = 128,
+	parameter DCACHE_ASSOCIATIVITY = 4,
+	parameter DCACHE_WRITEBACK     = 0
+)
+(
 	input               clk,
 	input               rst_n,
 
@@ -91,6 +102,7 @@ wire        exe_trigger_ts_fault;
 wire        exe_trigger_ss_fault;
 wire        exe_trigger_np_fault;
 wire        exe_trigger_nm_fault;
+wire        exe_trigger_mf_fault;
 wire        exe_trigger_db_fault;
 wire        exe_trigger_pf_fault;
 wire        exe_bound_fault;
@@ -258,6 +270,7 @@ exception exception_inst(
     .exe_trigger_ss_fault          (exe_trigger_ss_fault),          //input
     .exe_trigger_np_fault          (exe_trigger_np_fault),          //input
     .exe_trigger_nm_fault          (exe_trigger_nm_fault),          //input
+    .exe_trigger_mf_fault          (exe_trigger_mf_fault),          //input
     .exe_trigger_db_fault          (exe_trigger_db_fault),          //input
     .exe_trigger_pf_fault          (exe_trigger_pf_fault),          //input
     .exe_bound_fault               (exe_bound_fault),               //input
@@ -415,7 +428,17 @@ global_regs global_regs_inst(
 //------------------------------------------------------------------------------
 
 
-memory memory_inst(
+memory #(
+    .ICACHE_LINES         (ICACHE_LINES),
+    .ICACHE_LINESIZE      (ICACHE_LINESIZE),
+    .ICACHE_ASSOCIATIVITY (ICACHE_ASSOCIATIVITY),
+    .ICACHE_PREFETCH      (ICACHE_PREFETCH),
+    .DCACHE               (DCACHE),
+    .DCACHE_LINES         (DCACHE_LINES),
+    .DCACHE_ASSOCIATIVITY (DCACHE_ASSOCIATIVITY),
+    .DCACHE_WRITEBACK     (DCACHE_WRITEBACK)
+)
+memory_inst(
     .clk                (clk),
     .rst_n              (rst_n),
     
@@ -633,6 +656,7 @@ pipeline pipeline_inst(
     .exe_trigger_pf_fault          (exe_trigger_pf_fault),          //output
     .exe_trigger_db_fault          (exe_trigger_db_fault),          //output
     .exe_trigger_nm_fault          (exe_trigger_nm_fault),          //output
+    .exe_trigger_mf_fault          (exe_trigger_mf_fault),          //output
     .exe_load_seg_gp_fault         (exe_load_seg_gp_fault),         //output
     .exe_load_seg_ss_fault         (exe_load_seg_ss_fault),         //output
     .exe_load_seg_np_fault         (exe_load_seg_np_fault),         //output
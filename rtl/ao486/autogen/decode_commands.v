@@ -66,7 +66,7 @@ wire cond_63 = dec_ready_2byte_modregrm && decoder[7:0] == 8'h01 && decoder[13:1
 wire cond_64 = dec_ready_2byte_modregrm && decoder[7:0] == 8'h01 && decoder[13:11] == 3'd3;
 wire cond_65 = dec_ready_one && decoder[7:0] == 8'h60;
 wire cond_66 = dec_ready_one && decoder[7:0] == 8'h9B;
-wire cond_67 = dec_ready_modregrm_one && { decoder[7:3], 3'b0 } == 8'hD8;
+wire cond_67 = dec_ready_modregrm_one && ~(dec_fpu_present) && { decoder[7:3], 3'b0 } == 8'hD8;
 wire cond_68 = dec_ready_2byte_modregrm && decoder[7:4] == 4'h9;
 wire cond_69 = dec_ready_2byte_modregrm && { decoder[7:1], 1'b0 } == 8'hB0;
 wire cond_70 = dec_ready_one_three && decoder[7:0] == 8'hC8;
@@ -143,6 +143,11 @@ wire cond_140 = dec_ready_one && decoder[7:0] == 8'h27;
 wire cond_141 = dec_ready_one && decoder[7:0] == 8'h2F;
 wire cond_142 = dec_ready_2byte_modregrm && decoder[7:0] == 8'hBC;
 wire cond_143 = dec_ready_2byte_modregrm && decoder[7:0] == 8'hBD;
+wire cond_144 = dec_ready_modregrm_one && dec_fpu_present && (decoder[7:0] == 8'hD9 || decoder[7:0] == 8'hDD) && decoder[13] && ~(decoder[11]) && ~(`DEC_MODREGRM_IS_MOD_11);
+wire cond_145 = dec_ready_modregrm_one && dec_fpu_present && ~(`DEC_MODREGRM_IS_MOD_11) && ((decoder[7:0] == 8'hDD && decoder[13:12] == 2'd1) || (decoder[7:0] == 8'hDB && decoder[13:11] == 3'd7) || (decoder[7:0] == 8'hDF && decoder[13:12] == 2'd3));
+wire cond_146 = dec_ready_modregrm_one && dec_fpu_present && ~(`DEC_MODREGRM_IS_MOD_11) && ((decoder[7:0] == 8'hD9 && (decoder[13:12] == 2'd1 || decoder[13:11] == 3'd7)) || ((decoder[7:0] == 8'hDB || decoder[7:0] == 8'hDF) && decoder[13:12] == 2'd1) || (decoder[7:0] == 8'hDD && decoder[13:11] == 3'd7));
+wire cond_147 = dec_ready_modregrm_one && dec_fpu_present && ~(`DEC_MODREGRM_IS_MOD_11) && (decoder[7:0] == 8'hDC || (decoder[7:0] == 8'hDD && decoder[13:11] == 3'd0) || (decoder[7:0] == 8'hDB && decoder[13:11] == 3'd5) || (decoder[7:0] == 8'hDF && decoder[13:12] == 2'd2));
+wire cond_148 = dec_ready_modregrm_one && dec_fpu_present && { decoder[7:3], 3'b0 } == 8'hD8;
 //======================================================== saves
 //======================================================== always
 //======================================================== sets
@@ -269,6 +274,11 @@ assign dec_cmd =
     (cond_141 && ~cond_4)? ( `CMD_DAS) :
     (cond_142 && ~cond_4)? ( `CMD_BSF) :
     (cond_143 && ~cond_4)? ( `CMD_BSR) :
+    (cond_144 && ~cond_4)? ( `CMD_x87_env) :
+    (cond_145 && ~cond_4)? ( `CMD_x87_store) :
+    (cond_146 && ~cond_4)? ( `CMD_x87_store) :
+    (cond_147 && ~cond_4)? ( `CMD_x87) :
+    (cond_148 && ~cond_4)? ( `CMD_x87) :
     7'd0;
 assign dec_is_complex =
     (cond_0 && ~cond_1)? (`TRUE) :
@@ -318,6 +328,9 @@ assign dec_is_complex =
     (cond_132 && ~cond_4 && cond_25)? (`TRUE) :
     (cond_135 && ~cond_4)? (`TRUE) :
     (cond_136 && ~cond_4 && cond_56)? (`TRUE) :
+    (cond_144 && ~cond_4)? (`TRUE) :
+    (cond_145 && ~cond_4)? (`TRUE) :
+    (cond_147 && ~cond_4)? (`TRUE) :
     1'd0;
 assign consume_one_two =
     (cond_28 && ~cond_4 && cond_2)? (`TRUE) :
@@ -516,6 +529,11 @@ assign exception_ud =
     (cond_141 && cond_4)? (`TRUE) :
     (cond_142 && cond_4)? (`TRUE) :
     (cond_143 && cond_4)? (`TRUE) :
+    (cond_144 && cond_4)? (`TRUE) :
+    (cond_145 && cond_4)? (`TRUE) :
+    (cond_146 && cond_4)? (`TRUE) :
+    (cond_147 && cond_4)? (`TRUE) :
+    (cond_148 && cond_4)? (`TRUE) :
     1'd0;
 assign consume_one_imm =
     (cond_17 && ~cond_4 && cond_19)? (`TRUE) :
@@ -582,6 +600,11 @@ assign consume_modregrm_one =
     (cond_136 && ~cond_4)? (`TRUE) :
     (cond_142 && ~cond_4)? (`TRUE) :
     (cond_143 && ~cond_4)? (`TRUE) :
+    (cond_144 && ~cond_4)? (`TRUE) :
+    (cond_145 && ~cond_4)? (`TRUE) :
+    (cond_146 && ~cond_4)? (`TRUE) :
+    (cond_147 && ~cond_4)? (`TRUE) :
+    (cond_148 && ~cond_4)? (`TRUE) :
     1'd0;
 assign consume_one_three =
     (cond_70 && ~cond_4)? (`TRUE) :
@@ -734,4 +757,9 @@ assign dec_cmdex =
     (cond_135 && ~cond_4)? ( `CMDEX_POPA_STEP_0) :
     (cond_136 && ~cond_4 && cond_56)? ( `CMDEX_debug_reg_MOV_load_STEP_0) :
     (cond_136 && ~cond_4 && ~cond_56)? ( `CMDEX_debug_reg_MOV_store_STEP_0) :
+    (cond_144 && ~cond_4)? ( `CMDEX_x87_env_STEP_0) :
+    (cond_145 && ~cond_4)? ( `CMDEX_x87_STEP_0) :
+    (cond_146 && ~cond_4)? ( `CMDEX_x87_STEP_0) :
+    (cond_147 && ~cond_4)? ( `CMDEX_x87_STEP_0) :
+    (cond_148 && ~cond_4)? ( `CMDEX_x87_STEP_0) :
     4'd0;
@@ -66,10 +66,13 @@
 `define CMD_SCAS 7'd13
 `define CMD_int_2 7'd29
 `define CMD_INT_INTO 7'd75
+`define CMDEX_x87_STEP_0 4'd0
 `define CMDEX_LAR_LSL_VERR_VERW_STEP_1 4'd0
 `define CMDEX_LAR_LSL_VERR_VERW_STEP_2 4'd1
 `define CMD_IRET_2 7'd40
+`define CMDEX_x87_STEP_1 4'd1
 `define CMD_load_seg 7'd33
+`define CMDEX_x87_STEP_2 4'd2
 `define CMDEX_XCHG_modregrm 4'd1
 `define CMDEX_PUSH_MOV_SEG_modregrm_LDT 4'd14
 `define CMD_SAHF 7'd27
@@ -206,6 +209,7 @@
 `define CMDEX_int_protected_STEP_1 4'd9
 `define CMDEX_int_protected_STEP_2 4'd10
 `define CMDEX_INC_DEC_increment_modregrm 4'd2
+`define CMD_x87 7'd118
 `define CMDEX_INT_INTO_INTO_STEP_0 4'd2
 `define CMDEX_IRET_2_idle 4'd0
 `define CMDEX_PUSHA_STEP_1 4'd1
@@ -229,7 +233,10 @@
 `define CMDEX_IRET_real_v86_STEP_0 4'd0
 `define CMDEX_IRET_real_v86_STEP_1 4'd1
 `define CMDEX_CALL_Ev_Jv_STEP_1 4'd4
+`define CMDEX_x87_env_STEP_1 4'd1
+`define CMDEX_x87_env_STEP_2 4'd2
 `define CMDEX_IRET_task_switch_STEP_1 4'd6
+`define CMDEX_x87_env_STEP_0 4'd0
 `define CMDEX_IRET_task_switch_STEP_0 4'd5
 `define CMD_INC_DEC 7'd14
 `define CMDEX_POP_modregrm_STEP_1 4'd2
@@ -259,6 +266,7 @@
 `define CMDEX_PUSH_implicit 4'd0
 `define CMD_IRET 7'd35
 `define CMDEX_IRET_2_protected_to_v86_STEP_6 4'd10
+`define CMD_x87_store 7'd119
 `define CMDEX_RET_far_real_STEP_3 4'd3
 `define CMDEX_task_switch_3_STEP_0 4'd0
 `define CMDEX_task_switch_3_STEP_7 4'd7
@@ -346,6 +354,7 @@
 `define CMDEX_Shift_modregrm_imm 4'd2
 `define CMDEX_INC_DEC_decrement_implicit 4'd1
 `define CMD_POP_seg 7'd34
+`define CMD_x87_env 7'd120
 `define CMD_CALL 7'd3
 `define CMDEX_XCHG_implicit 4'd0
 `define CMDEX_JMP_protected_seg_STEP_1 4'd12
@@ -269,161 +269,166 @@ wire cond_152 = exe_cmd == `CMD_control_reg && exe_cmdex == `CMDEX_control_reg_S
 wire cond_153 = exe_cmd == `CMD_LGDT || exe_cmd == `CMD_LIDT;
 wire cond_154 = exe_cmd == `CMD_PUSHA;
 wire cond_155 = exe_cmdex[2:0] == 3'd4;
-wire cond_156 = exe_cmd == `CMD_fpu && exe_cmdex == `CMDEX_ESC_STEP_0;
-wire cond_157 = cr0_em || cr0_ts;
-wire cond_158 = exe_cmd == `CMD_SETcc;
-wire cond_159 = exe_condition;
-wire cond_160 = exe_cmd == `CMD_CMPXCHG;
-wire cond_161 = exe_mutex_current[`MUTEX_EAX_BIT];
-wire cond_162 = exe_cmd == `CMD_ENTER && exe_cmdex == `CMDEX_ENTER_FIRST;
-wire cond_163 = exe_cmd == `CMD_ENTER && exe_cmdex == `CMDEX_ENTER_LAST;
-wire cond_164 = exe_cmd == `CMD_ENTER && (exe_cmdex == `CMDEX_ENTER_PUSH || exe_cmdex == `CMDEX_ENTER_LOOP);
-wire cond_165 = exe_cmdex == `CMDEX_ENTER_PUSH;
-wire cond_166 = exe_cmd == `CMD_IMUL;
-wire cond_167 = exe_cmd == `CMD_LEAVE;
-wire cond_168 = { exe_cmd[6:1], 1'd0 } == `CMD_SHxD;
-wire cond_169 = exe_cmd == `CMD_WBINVD && exe_cmdex == `CMDEX_WBINVD_STEP_0;
-wire cond_170 = exe_cmd == `CMD_WBINVD && exe_cmdex == `CMDEX_WBINVD_STEP_1;
-wire cond_171 = ~(e_wbinvd_code_done && e_wbinvd_data_done);
-wire cond_172 = { exe_cmd[6:3], 3'd0 } == `CMD_Arith;
-wire cond_173 = exe_cmd[2:1] == 2'b01 && exe_mutex_current[`MUTEX_EFLAGS_BIT];
-wire cond_174 = exe_cmd == `CMD_MUL;
-wire cond_175 = exe_cmd == `CMD_LOOP;
-wire cond_176 = exe_mutex_current[`MUTEX_ECX_BIT] || (exe_mutex_current[`MUTEX_EFLAGS_BIT] && (exe_cmdex == `CMDEX_LOOP_NE || exe_cmdex == `CMDEX_LOOP_E));
-wire cond_177 = exe_cmd_loop_condition && exe_branch_eip > cs_limit;
-wire cond_178 = exe_cmd == `CMD_TEST;
-wire cond_179 = exe_cmd == `CMD_CLTS;
-wire cond_180 = exe_cmd == `CMD_RET_far  && exe_cmdex == `CMDEX_RET_far_STEP_1;
-wire cond_181 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_STEP_2;
-wire cond_182 = (v8086_mode || real_mode) && glob_param_2 > cs_limit;
-wire cond_183 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_same_STEP_3;
-wire cond_184 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_5;
-wire cond_185 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_6;
-wire cond_186 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_7;
-wire cond_187 = exe_cmd == `CMD_RET_far && (exe_cmdex == `CMDEX_RET_far_real_STEP_3 || exe_cmdex == `CMDEX_RET_far_same_STEP_4);
-wire cond_188 = exe_cmdex == `CMDEX_RET_far_real_STEP_3;
-wire cond_189 = exe_cmd == `CMD_LODS;
-wire cond_190 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_implicit;
-wire cond_191 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_modregrm;
-wire cond_192 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_modregrm_LAST;
-wire cond_193 = exe_cmd == `CMD_PUSH;
-wire cond_194 = exe_cmdex == `CMDEX_PUSH_immediate_se;
-wire cond_195 = exe_cmd == `CMD_IN && exe_cmdex == `CMDEX_IN_protected;
-wire cond_196 = exe_cmd == `CMD_IN && (exe_cmdex == `CMDEX_IN_dx || exe_cmdex == `CMDEX_IN_imm);
-wire cond_197 = exe_cmdex == `CMDEX_IN_dx && exe_mutex_current[`MUTEX_EDX_BIT];
-wire cond_198 = exe_cmd == `CMD_NOT;
-wire cond_199 = (exe_cmd == `CMD_LAR || exe_cmd == `CMD_LSL) && exe_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
-wire cond_200 = (exe_cmd == `CMD_LAR || exe_cmd == `CMD_LSL || exe_cmd == `CMD_VERR || exe_cmd == `CMD_VERW) && exe_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_2;
-wire cond_201 = (exe_cmd == `CMD_CALL && exe_cmdex == `CMDEX_CALL_protected_STEP_0) || (exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_protected_STEP_0);
-wire cond_202 = glob_param_1[15:2] == 14'd0 || (exe_descriptor[`DESC_BIT_SEG] == `FALSE && ( exe_descriptor[`DESC_BITS_DPL] < cpl || exe_descriptor[`DESC_BITS_DPL] < exe_selector[`SELECTOR_BITS_RPL] || ((exe_descriptor[`DESC_BITS_TYPE] == 4'd1 || exe_descriptor[`DESC_BITS_TYPE] == 4'd9) && exe_selector[`SELECTOR_BIT_TI]) ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd0  || exe_descriptor[`DESC_BITS_TYPE] == 4'd8  || exe_descriptor[`DESC_BITS_TYPE] == 4'd10 || exe_descriptor[`DESC_BITS_TYPE] == 4'd13 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd2  || exe_descriptor[`DESC_BITS_TYPE] == 4'd3  || exe_descriptor[`DESC_BITS_TYPE] == 4'd6  || exe_descriptor[`DESC_BITS_TYPE] == 4'd7  || exe_descriptor[`DESC_BITS_TYPE] == 4'd11 || exe_descriptor[`DESC_BITS_TYPE] == 4'd14 || exe_descriptor[`DESC_BITS_TYPE] == 4'd15)  ) || (exe_descriptor[`DESC_BIT_SEG] && ( `DESC_IS_DATA(exe_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && (exe_descriptor[`DESC_BITS_DPL] != cpl || exe_selector[`SELECTOR_BITS_RPL] > cpl)) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     &&  exe_descriptor[`DESC_BITS_DPL] > cpl))  ) ;
-wire cond_203 = ~(exe_trigger_gp_fault) && exe_descriptor[`DESC_BIT_P] == `FALSE &&  (exe_descriptor[`DESC_BIT_SEG] || exe_descriptor[`DESC_BITS_TYPE] == 4'd1 || exe_descriptor[`DESC_BITS_TYPE] == 4'd9 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd4 || exe_descriptor[`DESC_BITS_TYPE] == 4'd12 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd5)  ;
-wire cond_204 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_task_switch_STEP_0) || (exe_cmd == `CMD_JMP    && exe_cmdex == `CMDEX_JMP_task_switch_STEP_0);
-wire cond_205 = exe_cmd == `CMD_CALL_2;
-wire cond_206 = exe_cmd == `CMD_JMP;
-wire cond_207 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_task_gate_STEP_1) || (exe_cmd == `CMD_JMP    && exe_cmdex == `CMDEX_JMP_task_gate_STEP_1) || (exe_cmd == `CMD_int    && exe_cmdex == `CMDEX_int_task_gate_STEP_1);
-wire cond_208 = glob_param_1[`SELECTOR_BIT_TI] || glob_descriptor[`DESC_BIT_SEG] || (glob_descriptor[`DESC_BITS_TYPE] != `DESC_TSS_AVAIL_386 && glob_descriptor[`DESC_BITS_TYPE] != `DESC_TSS_AVAIL_286);
-wire cond_209 = exe_cmd == `CMD_int;
-wire cond_210 = exe_cmd != `CMD_int;
-wire cond_211 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_call_gate_STEP_1) || (exe_cmd == `CMD_int    && exe_cmdex == `CMDEX_int_int_trap_gate_STEP_1);
-wire cond_212 = glob_param_1[15:2] == 14'd0 || glob_descriptor[`DESC_BIT_SEG] == `FALSE ||  `DESC_IS_DATA(glob_descriptor) || glob_descriptor[`DESC_BITS_DPL] > cpl;
-wire cond_213 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_2) || (exe_cmd == `CMD_int_2  && exe_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_2);
-wire cond_214 = glob_param_5[0] || glob_param_1[`SELECTOR_BITS_RPL] != glob_descriptor_2[`DESC_BITS_DPL] ||  glob_descriptor[`DESC_BITS_DPL] != glob_descriptor_2[`DESC_BITS_DPL] || glob_descriptor[`DESC_BIT_SEG] == `FALSE || `DESC_IS_CODE(glob_descriptor) || `DESC_IS_DATA_RO(glob_descriptor);
-wire cond_215 = glob_param_5[0] == 1'b0 && ~(exe_trigger_ts_fault) && ~(glob_descriptor[`DESC_BIT_P]);
-wire cond_216 = exe_cmd == `CMD_STOS;
-wire cond_217 = exe_cmd == `CMD_INS;
-wire cond_218 = exe_mutex_current[`MUTEX_EDX_BIT];
-wire cond_219 = exe_cmd == `CMD_OUTS;
-wire cond_220 = exe_cmd == `CMD_PUSHF;
-wire cond_221 = exe_mutex_current[`MUTEX_ESP_BIT] || exe_mutex_current[`MUTEX_EFLAGS_BIT];
-wire cond_222 = exe_cmd == `CMD_JMP  && (exe_cmdex == `CMDEX_JMP_Ev_STEP_0  || exe_cmdex == `CMDEX_JMP_Ep_STEP_0  || exe_cmdex == `CMDEX_JMP_Ap_STEP_0);
-wire cond_223 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Jv_STEP_0;
-wire cond_224 = exe_cmd == `CMD_CALL && exe_mutex_current[`MUTEX_ESP_BIT];
-wire cond_225 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ev_Jv_STEP_1;
-wire cond_226 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ep_STEP_1;
-wire cond_227 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ap_STEP_1;
-wire cond_228 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_real_v8086_STEP_0;
-wire cond_229 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_real_v8086_STEP_1;
-wire cond_230 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_protected_seg_STEP_0;
-wire cond_231 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_protected_seg_STEP_1;
-wire cond_232 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_1;
-wire cond_233 = glob_param_1[15:2] == 14'd0 || glob_descriptor[`DESC_BIT_SEG] == `FALSE || `DESC_IS_DATA(glob_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && exe_descriptor[`DESC_BITS_DPL] != cpl) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     && exe_descriptor[`DESC_BITS_DPL] > cpl);
-wire cond_234 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_2;
-wire cond_235 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_3;
-wire cond_236 = exe_cmd == `CMD_OUT && (exe_cmdex == `CMDEX_OUT_dx || exe_cmdex == `CMDEX_OUT_imm);
-wire cond_237 = exe_cmdex == `CMDEX_OUT_dx && exe_mutex_current[`MUTEX_EDX_BIT];
-wire cond_238 = exe_cmd == `CMD_OUT && exe_cmdex == `CMDEX_OUT_protected;
-wire cond_239 = exe_cmd == `CMD_MOV;
-wire cond_240 = exe_cmd == `CMD_POPF && exe_cmdex == `CMDEX_POPF_STEP_0;
-wire cond_241 = exe_cmd == `CMD_CLI || exe_cmd == `CMD_STI;
-wire cond_242 = (protected_mode && iopl < cpl) || (v8086_mode && iopl != 2'd3);
-wire cond_243 = exe_cmd == `CMD_BOUND && exe_cmdex == `CMDEX_BOUND_STEP_FIRST;
-wire cond_244 = exe_cmd == `CMD_BOUND && exe_cmdex == `CMDEX_BOUND_STEP_LAST;
-wire cond_245 = exe_bound_fault;
-wire cond_246 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_1;
-wire cond_247 = glob_desc_limit < exe_new_tss_max;
-wire cond_248 = tr_limit < ((tr_cache[`DESC_BITS_TYPE] <= 4'd3)? 32'h29 : 32'h5F);
-wire cond_249 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_2;
-wire cond_250 = ~(tlbcheck_done) && ~(tlbcheck_page_fault);
-wire cond_251 = tlbcheck_page_fault;
-wire cond_252 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_3;
-wire cond_253 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_4;
-wire cond_254 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_5;
-wire cond_255 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_7;
-wire cond_256 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_8;
-wire cond_257 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_10;
-wire cond_258 = exe_cmd == `CMD_task_switch && exe_cmdex >= `CMDEX_task_switch_STEP_12 && exe_cmdex <= `CMDEX_task_switch_STEP_14;
-wire cond_259 = exe_cmd == `CMD_task_switch_2;
-wire cond_260 = exe_cmdex <= `CMDEX_task_switch_2_STEP_7;
-wire cond_261 = exe_cmdex > `CMDEX_task_switch_2_STEP_7;
-wire cond_262 = exe_cmd == `CMD_task_switch_3;
-wire cond_263 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_0;
-wire cond_264 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_2;
-wire cond_265 = glob_param_2[2] || glob_param_2[2:0] == 3'b010 || ( glob_param_2[2:0] == 3'b000 && ( exe_descriptor[`DESC_BIT_SEG] || exe_descriptor[`DESC_BITS_TYPE] != `DESC_LDT ||  exe_descriptor[`DESC_BIT_P] == `FALSE ) );
-wire cond_266 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_3;
-wire cond_267 = ~(v8086_mode);
-wire cond_268 = glob_param_2[1:0] != 2'b00 || ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_CODE(exe_descriptor) || `DESC_IS_DATA_RO(exe_descriptor) || (exe_descriptor[`DESC_BIT_P] && ( exe_descriptor[`DESC_BITS_DPL] != wr_task_rpl || exe_descriptor[`DESC_BITS_DPL] != exe_selector[`SELECTOR_BITS_RPL] ) ) );
-wire cond_269 = glob_param_2[1:0] == 2'b00 && exe_descriptor[`DESC_BIT_SEG] && `DESC_IS_DATA_RW(exe_descriptor) && ~(exe_descriptor[`DESC_BIT_P]);
-wire cond_270 = exe_cmd == `CMD_task_switch_4 && exe_cmdex >= `CMDEX_task_switch_4_STEP_4 && exe_cmdex <= `CMDEX_task_switch_4_STEP_7;
-wire cond_271 = glob_param_2[1:0] == 2'b10 || (glob_param_2[1:0] == 2'b00 && ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_CODE_EO(exe_descriptor) || ((`DESC_IS_DATA(exe_descriptor) || `DESC_IS_CODE_NON_CONFORMING(exe_descriptor)) && exe_privilege_not_accepted) ));
-wire cond_272 = glob_param_2[1:0] == 2'b00 && ~(exe_trigger_ts_fault) && ~(exe_descriptor[`DESC_BIT_P]);
-wire cond_273 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_8;
-wire cond_274 = glob_param_2[1:0] != 2'b00 || ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_DATA(exe_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && exe_descriptor[`DESC_BITS_DPL] != exe_selector[`SELECTOR_BITS_RPL]) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     && exe_descriptor[`DESC_BITS_DPL] >  exe_selector[`SELECTOR_BITS_RPL]) );
-wire cond_275 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_9;
-wire cond_276 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_10;
-wire cond_277 = exe_eip > cs_limit;
-wire cond_278 = exe_cmd == `CMD_LEA;
-wire cond_279 = exe_cmd == `CMD_SGDT;
-wire cond_280 = exe_cmdex == `CMDEX_SGDT_SIDT_STEP_1;
-wire cond_281 = exe_cmdex == `CMDEX_SGDT_SIDT_STEP_2;
-wire cond_282 = exe_cmd == `CMD_SIDT;
-wire cond_283 = exe_cmd == `CMD_MOVS;
-wire cond_284 = exe_cmd == `CMD_MOVSX || exe_cmd == `CMD_MOVZX;
-wire cond_285 = exe_cmd == `CMD_POPA;
-wire cond_286 = exe_cmd == `CMD_debug_reg && (exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 || exe_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0);
-wire cond_287 = exe_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0;
-wire cond_288 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd0;
-wire cond_289 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd1;
-wire cond_290 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd2;
-wire cond_291 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd3;
-wire cond_292 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && (exe_modregrm_reg == 3'd4 || exe_modregrm_reg == 3'd6);
-wire cond_293 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && (exe_modregrm_reg == 3'd5 || exe_modregrm_reg == 3'd7);
-wire cond_294 = dr7[`DR7_BIT_GD];
-wire cond_295 = exe_cmd == `CMD_XLAT;
-wire cond_296 = exe_cmd == `CMD_AAA || exe_cmd == `CMD_AAS || exe_cmd == `CMD_DAA || exe_cmd == `CMD_DAS;
-wire cond_297 = { exe_cmd[6:1], 1'd0 } == `CMD_BSx;
-wire cond_298 = exe_cmd == `CMD_BSF;
-wire cond_299 = exe_cmd == `CMD_BSR;
+wire cond_156 = exe_cmd == `CMD_fpu && exe_cmdex == `CMDEX_WAIT_STEP_0;
+wire cond_157 = fpu_nm_fault;
+wire cond_158 = fpu_mf_fault;
+wire cond_159 = fpu_busy;
+wire cond_160 = exe_cmd == `CMD_fpu && exe_cmdex == `CMDEX_ESC_STEP_0;
+wire cond_161 = cr0_em || cr0_ts;
+wire cond_162 = exe_cmd == `CMD_SETcc;
+wire cond_163 = exe_condition;
+wire cond_164 = exe_cmd == `CMD_CMPXCHG;
+wire cond_165 = exe_mutex_current[`MUTEX_EAX_BIT];
+wire cond_166 = exe_cmd == `CMD_ENTER && exe_cmdex == `CMDEX_ENTER_FIRST;
+wire cond_167 = exe_cmd == `CMD_ENTER && exe_cmdex == `CMDEX_ENTER_LAST;
+wire cond_168 = exe_cmd == `CMD_ENTER && (exe_cmdex == `CMDEX_ENTER_PUSH || exe_cmdex == `CMDEX_ENTER_LOOP);
+wire cond_169 = exe_cmdex == `CMDEX_ENTER_PUSH;
+wire cond_170 = exe_cmd == `CMD_IMUL;
+wire cond_171 = exe_cmd == `CMD_LEAVE;
+wire cond_172 = { exe_cmd[6:1], 1'd0 } == `CMD_SHxD;
+wire cond_173 = exe_cmd == `CMD_WBINVD && exe_cmdex == `CMDEX_WBINVD_STEP_0;
+wire cond_174 = exe_cmd == `CMD_WBINVD && exe_cmdex == `CMDEX_WBINVD_STEP_1;
+wire cond_175 = ~(e_wbinvd_code_done && e_wbinvd_data_done);
+wire cond_176 = { exe_cmd[6:3], 3'd0 } == `CMD_Arith;
+wire cond_177 = exe_cmd[2:1] == 2'b01 && exe_mutex_current[`MUTEX_EFLAGS_BIT];
+wire cond_178 = exe_cmd == `CMD_MUL;
+wire cond_179 = exe_cmd == `CMD_LOOP;
+wire cond_180 = exe_mutex_current[`MUTEX_ECX_BIT] || (exe_mutex_current[`MUTEX_EFLAGS_BIT] && (exe_cmdex == `CMDEX_LOOP_NE || exe_cmdex == `CMDEX_LOOP_E));
+wire cond_181 = exe_cmd_loop_condition && exe_branch_eip > cs_limit;
+wire cond_182 = exe_cmd == `CMD_TEST;
+wire cond_183 = exe_cmd == `CMD_CLTS;
+wire cond_184 = exe_cmd == `CMD_RET_far  && exe_cmdex == `CMDEX_RET_far_STEP_1;
+wire cond_185 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_STEP_2;
+wire cond_186 = (v8086_mode || real_mode) && glob_param_2 > cs_limit;
+wire cond_187 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_same_STEP_3;
+wire cond_188 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_5;
+wire cond_189 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_6;
+wire cond_190 = exe_cmd == `CMD_RET_far && exe_cmdex == `CMDEX_RET_far_outer_STEP_7;
+wire cond_191 = exe_cmd == `CMD_RET_far && (exe_cmdex == `CMDEX_RET_far_real_STEP_3 || exe_cmdex == `CMDEX_RET_far_same_STEP_4);
+wire cond_192 = exe_cmdex == `CMDEX_RET_far_real_STEP_3;
+wire cond_193 = exe_cmd == `CMD_LODS;
+wire cond_194 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_implicit;
+wire cond_195 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_modregrm;
+wire cond_196 = exe_cmd == `CMD_XCHG && exe_cmdex == `CMDEX_XCHG_modregrm_LAST;
+wire cond_197 = exe_cmd == `CMD_PUSH;
+wire cond_198 = exe_cmdex == `CMDEX_PUSH_immediate_se;
+wire cond_199 = exe_cmd == `CMD_IN && exe_cmdex == `CMDEX_IN_protected;
+wire cond_200 = exe_cmd == `CMD_IN && (exe_cmdex == `CMDEX_IN_dx || exe_cmdex == `CMDEX_IN_imm);
+wire cond_201 = exe_cmdex == `CMDEX_IN_dx && exe_mutex_current[`MUTEX_EDX_BIT];
+wire cond_202 = exe_cmd == `CMD_NOT;
+wire cond_203 = (exe_cmd == `CMD_LAR || exe_cmd == `CMD_LSL) && exe_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
+wire cond_204 = (exe_cmd == `CMD_LAR || exe_cmd == `CMD_LSL || exe_cmd == `CMD_VERR || exe_cmd == `CMD_VERW) && exe_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_2;
+wire cond_205 = (exe_cmd == `CMD_CALL && exe_cmdex == `CMDEX_CALL_protected_STEP_0) || (exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_protected_STEP_0);
+wire cond_206 = glob_param_1[15:2] == 14'd0 || (exe_descriptor[`DESC_BIT_SEG] == `FALSE && ( exe_descriptor[`DESC_BITS_DPL] < cpl || exe_descriptor[`DESC_BITS_DPL] < exe_selector[`SELECTOR_BITS_RPL] || ((exe_descriptor[`DESC_BITS_TYPE] == 4'd1 || exe_descriptor[`DESC_BITS_TYPE] == 4'd9) && exe_selector[`SELECTOR_BIT_TI]) ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd0  || exe_descriptor[`DESC_BITS_TYPE] == 4'd8  || exe_descriptor[`DESC_BITS_TYPE] == 4'd10 || exe_descriptor[`DESC_BITS_TYPE] == 4'd13 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd2  || exe_descriptor[`DESC_BITS_TYPE] == 4'd3  || exe_descriptor[`DESC_BITS_TYPE] == 4'd6  || exe_descriptor[`DESC_BITS_TYPE] == 4'd7  || exe_descriptor[`DESC_BITS_TYPE] == 4'd11 || exe_descriptor[`DESC_BITS_TYPE] == 4'd14 || exe_descriptor[`DESC_BITS_TYPE] == 4'd15)  ) || (exe_descriptor[`DESC_BIT_SEG] && ( `DESC_IS_DATA(exe_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && (exe_descriptor[`DESC_BITS_DPL] != cpl || exe_selector[`SELECTOR_BITS_RPL] > cpl)) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     &&  exe_descriptor[`DESC_BITS_DPL] > cpl))  ) ;
+wire cond_207 = ~(exe_trigger_gp_fault) && exe_descriptor[`DESC_BIT_P] == `FALSE &&  (exe_descriptor[`DESC_BIT_SEG] || exe_descriptor[`DESC_BITS_TYPE] == 4'd1 || exe_descriptor[`DESC_BITS_TYPE] == 4'd9 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd4 || exe_descriptor[`DESC_BITS_TYPE] == 4'd12 ||  exe_descriptor[`DESC_BITS_TYPE] == 4'd5)  ;
+wire cond_208 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_task_switch_STEP_0) || (exe_cmd == `CMD_JMP    && exe_cmdex == `CMDEX_JMP_task_switch_STEP_0);
+wire cond_209 = exe_cmd == `CMD_CALL_2;
+wire cond_210 = exe_cmd == `CMD_JMP;
+wire cond_211 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_task_gate_STEP_1) || (exe_cmd == `CMD_JMP    && exe_cmdex == `CMDEX_JMP_task_gate_STEP_1) || (exe_cmd == `CMD_int    && exe_cmdex == `CMDEX_int_task_gate_STEP_1);
+wire cond_212 = glob_param_1[`SELECTOR_BIT_TI] || glob_descriptor[`DESC_BIT_SEG] || (glob_descriptor[`DESC_BITS_TYPE] != `DESC_TSS_AVAIL_386 && glob_descriptor[`DESC_BITS_TYPE] != `DESC_TSS_AVAIL_286);
+wire cond_213 = exe_cmd == `CMD_int;
+wire cond_214 = exe_cmd != `CMD_int;
+wire cond_215 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_call_gate_STEP_1) || (exe_cmd == `CMD_int    && exe_cmdex == `CMDEX_int_int_trap_gate_STEP_1);
+wire cond_216 = glob_param_1[15:2] == 14'd0 || glob_descriptor[`DESC_BIT_SEG] == `FALSE ||  `DESC_IS_DATA(glob_descriptor) || glob_descriptor[`DESC_BITS_DPL] > cpl;
+wire cond_217 = (exe_cmd == `CMD_CALL_2 && exe_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_2) || (exe_cmd == `CMD_int_2  && exe_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_2);
+wire cond_218 = glob_param_5[0] || glob_param_1[`SELECTOR_BITS_RPL] != glob_descriptor_2[`DESC_BITS_DPL] ||  glob_descriptor[`DESC_BITS_DPL] != glob_descriptor_2[`DESC_BITS_DPL] || glob_descriptor[`DESC_BIT_SEG] == `FALSE || `DESC_IS_CODE(glob_descriptor) || `DESC_IS_DATA_RO(glob_descriptor);
+wire cond_219 = glob_param_5[0] == 1'b0 && ~(exe_trigger_ts_fault) && ~(glob_descriptor[`DESC_BIT_P]);
+wire cond_220 = exe_cmd == `CMD_STOS;
+wire cond_221 = exe_cmd == `CMD_INS;
+wire cond_222 = exe_mutex_current[`MUTEX_EDX_BIT];
+wire cond_223 = exe_cmd == `CMD_OUTS;
+wire cond_224 = exe_cmd == `CMD_PUSHF;
+wire cond_225 = exe_mutex_current[`MUTEX_ESP_BIT] || exe_mutex_current[`MUTEX_EFLAGS_BIT];
+wire cond_226 = exe_cmd == `CMD_JMP  && (exe_cmdex == `CMDEX_JMP_Ev_STEP_0  || exe_cmdex == `CMDEX_JMP_Ep_STEP_0  || exe_cmdex == `CMDEX_JMP_Ap_STEP_0);
+wire cond_227 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Jv_STEP_0;
+wire cond_228 = exe_cmd == `CMD_CALL && exe_mutex_current[`MUTEX_ESP_BIT];
+wire cond_229 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ev_Jv_STEP_1;
+wire cond_230 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ep_STEP_1;
+wire cond_231 = exe_cmd == `CMD_JMP  && exe_cmdex == `CMDEX_JMP_Ap_STEP_1;
+wire cond_232 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_real_v8086_STEP_0;
+wire cond_233 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_real_v8086_STEP_1;
+wire cond_234 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_protected_seg_STEP_0;
+wire cond_235 = exe_cmd == `CMD_JMP && exe_cmdex == `CMDEX_JMP_protected_seg_STEP_1;
+wire cond_236 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_1;
+wire cond_237 = glob_param_1[15:2] == 14'd0 || glob_descriptor[`DESC_BIT_SEG] == `FALSE || `DESC_IS_DATA(glob_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && exe_descriptor[`DESC_BITS_DPL] != cpl) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     && exe_descriptor[`DESC_BITS_DPL] > cpl);
+wire cond_238 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_2;
+wire cond_239 = exe_cmd == `CMD_JMP_2 && exe_cmdex == `CMDEX_JMP_2_call_gate_STEP_3;
+wire cond_240 = exe_cmd == `CMD_OUT && (exe_cmdex == `CMDEX_OUT_dx || exe_cmdex == `CMDEX_OUT_imm);
+wire cond_241 = exe_cmdex == `CMDEX_OUT_dx && exe_mutex_current[`MUTEX_EDX_BIT];
+wire cond_242 = exe_cmd == `CMD_OUT && exe_cmdex == `CMDEX_OUT_protected;
+wire cond_243 = exe_cmd == `CMD_MOV;
+wire cond_244 = exe_cmd == `CMD_POPF && exe_cmdex == `CMDEX_POPF_STEP_0;
+wire cond_245 = exe_cmd == `CMD_CLI || exe_cmd == `CMD_STI;
+wire cond_246 = (protected_mode && iopl < cpl) || (v8086_mode && iopl != 2'd3);
+wire cond_247 = exe_cmd == `CMD_BOUND && exe_cmdex == `CMDEX_BOUND_STEP_FIRST;
+wire cond_248 = exe_cmd == `CMD_BOUND && exe_cmdex == `CMDEX_BOUND_STEP_LAST;
+wire cond_249 = exe_bound_fault;
+wire cond_250 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_1;
+wire cond_251 = glob_desc_limit < exe_new_tss_max;
+wire cond_252 = tr_limit < ((tr_cache[`DESC_BITS_TYPE] <= 4'd3)? 32'h29 : 32'h5F);
+wire cond_253 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_2;
+wire cond_254 = ~(tlbcheck_done) && ~(tlbcheck_page_fault);
+wire cond_255 = tlbcheck_page_fault;
+wire cond_256 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_3;
+wire cond_257 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_4;
+wire cond_258 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_5;
+wire cond_259 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_7;
+wire cond_260 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_8;
+wire cond_261 = exe_cmd == `CMD_task_switch && exe_cmdex == `CMDEX_task_switch_STEP_10;
+wire cond_262 = exe_cmd == `CMD_task_switch && exe_cmdex >= `CMDEX_task_switch_STEP_12 && exe_cmdex <= `CMDEX_task_switch_STEP_14;
+wire cond_263 = exe_cmd == `CMD_task_switch_2;
+wire cond_264 = exe_cmdex <= `CMDEX_task_switch_2_STEP_7;
+wire cond_265 = exe_cmdex > `CMDEX_task_switch_2_STEP_7;
+wire cond_266 = exe_cmd == `CMD_task_switch_3;
+wire cond_267 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_0;
+wire cond_268 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_2;
+wire cond_269 = glob_param_2[2] || glob_param_2[2:0] == 3'b010 || ( glob_param_2[2:0] == 3'b000 && ( exe_descriptor[`DESC_BIT_SEG] || exe_descriptor[`DESC_BITS_TYPE] != `DESC_LDT ||  exe_descriptor[`DESC_BIT_P] == `FALSE ) );
+wire cond_270 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_3;
+wire cond_271 = ~(v8086_mode);
+wire cond_272 = glob_param_2[1:0] != 2'b00 || ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_CODE(exe_descriptor) || `DESC_IS_DATA_RO(exe_descriptor) || (exe_descriptor[`DESC_BIT_P] && ( exe_descriptor[`DESC_BITS_DPL] != wr_task_rpl || exe_descriptor[`DESC_BITS_DPL] != exe_selector[`SELECTOR_BITS_RPL] ) ) );
+wire cond_273 = glob_param_2[1:0] == 2'b00 && exe_descriptor[`DESC_BIT_SEG] && `DESC_IS_DATA_RW(exe_descriptor) && ~(exe_descriptor[`DESC_BIT_P]);
+wire cond_274 = exe_cmd == `CMD_task_switch_4 && exe_cmdex >= `CMDEX_task_switch_4_STEP_4 && exe_cmdex <= `CMDEX_task_switch_4_STEP_7;
+wire cond_275 = glob_param_2[1:0] == 2'b10 || (glob_param_2[1:0] == 2'b00 && ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_CODE_EO(exe_descriptor) || ((`DESC_IS_DATA(exe_descriptor) || `DESC_IS_CODE_NON_CONFORMING(exe_descriptor)) && exe_privilege_not_accepted) ));
+wire cond_276 = glob_param_2[1:0] == 2'b00 && ~(exe_trigger_ts_fault) && ~(exe_descriptor[`DESC_BIT_P]);
+wire cond_277 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_8;
+wire cond_278 = glob_param_2[1:0] != 2'b00 || ( exe_descriptor[`DESC_BIT_SEG] == 1'b0 || `DESC_IS_DATA(exe_descriptor) || (`DESC_IS_CODE_NON_CONFORMING(exe_descriptor) && exe_descriptor[`DESC_BITS_DPL] != exe_selector[`SELECTOR_BITS_RPL]) || (`DESC_IS_CODE_CONFORMING(exe_descriptor)     && exe_descriptor[`DESC_BITS_DPL] >  exe_selector[`SELECTOR_BITS_RPL]) );
+wire cond_279 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_9;
+wire cond_280 = exe_cmd == `CMD_task_switch_4 && exe_cmdex == `CMDEX_task_switch_4_STEP_10;
+wire cond_281 = exe_eip > cs_limit;
+wire cond_282 = exe_cmd == `CMD_LEA;
+wire cond_283 = exe_cmd == `CMD_SGDT;
+wire cond_284 = exe_cmdex == `CMDEX_SGDT_SIDT_STEP_1;
+wire cond_285 = exe_cmdex == `CMDEX_SGDT_SIDT_STEP_2;
+wire cond_286 = exe_cmd == `CMD_SIDT;
+wire cond_287 = exe_cmd == `CMD_MOVS;
+wire cond_288 = exe_cmd == `CMD_MOVSX || exe_cmd == `CMD_MOVZX;
+wire cond_289 = exe_cmd == `CMD_POPA;
+wire cond_290 = exe_cmd == `CMD_debug_reg && (exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 || exe_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0);
+wire cond_291 = exe_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0;
+wire cond_292 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd0;
+wire cond_293 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd1;
+wire cond_294 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd2;
+wire cond_295 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && exe_modregrm_reg == 3'd3;
+wire cond_296 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && (exe_modregrm_reg == 3'd4 || exe_modregrm_reg == 3'd6);
+wire cond_297 = exe_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0 && (exe_modregrm_reg == 3'd5 || exe_modregrm_reg == 3'd7);
+wire cond_298 = dr7[`DR7_BIT_GD];
+wire cond_299 = exe_cmd == `CMD_XLAT;
+wire cond_300 = exe_cmd == `CMD_AAA || exe_cmd == `CMD_AAS || exe_cmd == `CMD_DAA || exe_cmd == `CMD_DAS;
+wire cond_301 = { exe_cmd[6:1], 1'd0 } == `CMD_BSx;
+wire cond_302 = exe_cmd == `CMD_BSF;
+wire cond_303 = exe_cmd == `CMD_BSR;
+wire cond_304 = exe_cmd == `CMD_x87 || exe_cmd == `CMD_x87_store || exe_cmd == `CMD_x87_env;
 //======================================================== saves
 wire [31:0] exe_buffer_to_reg =
     (cond_0)? ( dst) :
     (cond_134 && cond_36)? ( src) :
     (cond_139)? ( src) :
-    (cond_162 && ~cond_10)? ( exe_enter_offset) :
-    (cond_191)? ( dst) :
-    (cond_243)? ( src) :
-    (cond_258 && cond_36)? ( src) :
-    (cond_262 && cond_36)? ( (exe_cmdex == `CMDEX_task_switch_3_STEP_15 && glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? 32'd0 : src) :
-    (cond_285 && cond_36)? ( src) :
+    (cond_166 && ~cond_10)? ( exe_enter_offset) :
+    (cond_195)? ( dst) :
+    (cond_247)? ( src) :
+    (cond_262 && cond_36)? ( src) :
+    (cond_266 && cond_36)? ( (exe_cmdex == `CMDEX_task_switch_3_STEP_15 && glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? 32'd0 : src) :
+    (cond_289 && cond_36)? ( src) :
     exe_buffer;
 //======================================================== always
 always @(posedge clk) begin
@@ -432,39 +437,39 @@ always @(posedge clk) begin
 end
 //======================================================== sets
 assign tlbcheck_rw =
-    (cond_249)? (       `FALSE) :
-    (cond_252)? (       `FALSE) :
-    (cond_253)? (       `TRUE) :
-    (cond_254)? (       `TRUE) :
-    (cond_255)? (       `TRUE) :
-    (cond_256)? (       `TRUE) :
+    (cond_253)? (       `FALSE) :
+    (cond_256)? (       `FALSE) :
+    (cond_257)? (       `TRUE) :
+    (cond_258)? (       `TRUE) :
+    (cond_259)? (       `TRUE) :
+    (cond_260)? (       `TRUE) :
     1'd0;
 assign exe_cmpxchg_switch =
-    (cond_160)? (`TRUE) :
+    (cond_164)? (`TRUE) :
     1'd0;
 assign wbinvddata_do =
-    (cond_170)? ( ~(e_wbinvd_data_done)) :
+    (cond_174)? ( ~(e_wbinvd_data_done)) :
     1'd0;
 assign exe_trigger_ss_fault =
-    (cond_213 && cond_215)? (`TRUE) :
-    (cond_266 && cond_267 && cond_269)? (`TRUE) :
+    (cond_217 && cond_219)? (`TRUE) :
+    (cond_270 && cond_271 && cond_273)? (`TRUE) :
     1'd0;
 assign offset_ret =
     (cond_65 && cond_67)? (`TRUE) :
-    (cond_183)? ( exe_decoder[0] == 1'b0) :
-    (cond_187 && cond_188)? ( exe_decoder[0] == 1'b0) :
+    (cond_187)? ( exe_decoder[0] == 1'b0) :
+    (cond_191 && cond_192)? ( exe_decoder[0] == 1'b0) :
     1'd0;
 assign exe_buffer_shift_word =
-    (cond_262 && cond_36)? (  exe_cmdex >  `CMDEX_task_switch_3_STEP_8) :
+    (cond_266 && cond_36)? (  exe_cmdex >  `CMDEX_task_switch_3_STEP_8) :
     1'd0;
 assign exe_buffer_shift =
     (cond_134 && cond_36)? (`TRUE) :
-    (cond_258 && cond_36)? (`TRUE) :
-    (cond_262 && cond_36)? (       exe_cmdex <= `CMDEX_task_switch_3_STEP_8) :
-    (cond_285 && cond_36)? (`TRUE) :
+    (cond_262 && cond_36)? (`TRUE) :
+    (cond_266 && cond_36)? (       exe_cmdex <= `CMDEX_task_switch_3_STEP_8) :
+    (cond_289 && cond_36)? (`TRUE) :
     1'd0;
 assign offset_ret_far_se =
-    (cond_187 && cond_188)? (`TRUE) :
+    (cond_191 && cond_192)? (`TRUE) :
     1'd0;
 assign exe_eip_from_glob_param_2 =
     (cond_13)? (`TRUE) :
@@ -479,16 +484,16 @@ assign exe_eip_from_glob_param_2 =
     (cond_119)? (`TRUE) :
     (cond_122)? (`TRUE) :
     (cond_128)? (`TRUE) :
-    (cond_186)? (`TRUE) :
-    (cond_187)? (`TRUE) :
-    (cond_225)? (`TRUE) :
+    (cond_190)? (`TRUE) :
+    (cond_191)? (`TRUE) :
     (cond_229)? (`TRUE) :
-    (cond_231)? (`TRUE) :
+    (cond_233)? (`TRUE) :
     (cond_235)? (`TRUE) :
-    (cond_276)? (`TRUE) :
+    (cond_239)? (`TRUE) :
+    (cond_280)? (`TRUE) :
     1'd0;
 assign exe_task_switch_finished =
-    (cond_276)? (`TRUE) :
+    (cond_280)? (`TRUE) :
     1'd0;
 assign offset_esp =
     (cond_5)? (`TRUE) :
@@ -496,12 +501,12 @@ assign offset_esp =
 assign exe_trigger_np_fault =
     (cond_93 && cond_95)? (`TRUE) :
     (cond_131 && cond_133)? (`TRUE) :
-    (cond_201 && cond_203)? (`TRUE) :
-    (cond_207 && cond_95)? (`TRUE) :
+    (cond_205 && cond_207)? (`TRUE) :
     (cond_211 && cond_95)? (`TRUE) :
-    (cond_232 && cond_95)? (`TRUE) :
-    (cond_270 && cond_267 && cond_272)? (`TRUE) :
-    (cond_273 && cond_267 && cond_272)? (`TRUE) :
+    (cond_215 && cond_95)? (`TRUE) :
+    (cond_236 && cond_95)? (`TRUE) :
+    (cond_274 && cond_271 && cond_276)? (`TRUE) :
+    (cond_277 && cond_271 && cond_276)? (`TRUE) :
     1'd0;
 assign offset_iret =
     (cond_118)? (`TRUE) :
@@ -542,25 +547,25 @@ assign exe_trigger_gp_fault =
     (cond_146 && cond_54)? (`TRUE) :
     (cond_150 && cond_151)? (`TRUE) :
     (cond_153 && cond_72)? (`TRUE) :
-    (cond_169 && cond_54)? (`TRUE) :
-    (cond_175 && ~cond_176 && cond_177)? (`TRUE) :
-    (cond_179 && cond_54)? (`TRUE) :
-    (cond_181 && cond_182)? (`TRUE) :
-    (cond_183 && cond_7)? (`TRUE) :
-    (cond_184 && cond_44)? (`TRUE) :
-    (cond_201 && cond_202)? (`TRUE) :
-    (cond_207 && cond_208)? (`TRUE) :
+    (cond_173 && cond_54)? (`TRUE) :
+    (cond_179 && ~cond_180 && cond_181)? (`TRUE) :
+    (cond_183 && cond_54)? (`TRUE) :
+    (cond_185 && cond_186)? (`TRUE) :
+    (cond_187 && cond_7)? (`TRUE) :
+    (cond_188 && cond_44)? (`TRUE) :
+    (cond_205 && cond_206)? (`TRUE) :
     (cond_211 && cond_212)? (`TRUE) :
-    (cond_220 && ~cond_221 && cond_124)? (`TRUE) :
-    (cond_225 && cond_14)? (`TRUE) :
-    (cond_228 && cond_14)? (`TRUE) :
-    (cond_230 && cond_7)? (`TRUE) :
-    (cond_232 && cond_233)? (`TRUE) :
+    (cond_215 && cond_216)? (`TRUE) :
+    (cond_224 && ~cond_225 && cond_124)? (`TRUE) :
+    (cond_229 && cond_14)? (`TRUE) :
+    (cond_232 && cond_14)? (`TRUE) :
     (cond_234 && cond_7)? (`TRUE) :
-    (cond_240 && ~cond_51 && cond_124)? (`TRUE) :
-    (cond_241 && ~cond_51 && cond_242)? (`TRUE) :
-    (cond_276 && cond_277)? (`TRUE) :
-    (cond_286 && ~cond_294 && cond_54)? (`TRUE) :
+    (cond_236 && cond_237)? (`TRUE) :
+    (cond_238 && cond_7)? (`TRUE) :
+    (cond_244 && ~cond_51 && cond_124)? (`TRUE) :
+    (cond_245 && ~cond_51 && cond_246)? (`TRUE) :
+    (cond_280 && cond_281)? (`TRUE) :
+    (cond_290 && ~cond_298 && cond_54)? (`TRUE) :
     1'd0;
 assign exe_glob_descriptor_value =
     (cond_24)? (  ss_cache) :
@@ -569,11 +574,11 @@ assign exe_glob_descriptor_value =
     (cond_79 && cond_80)? ( glob_descriptor_2) :
     (cond_120 && ~cond_44)? ( glob_descriptor_2) :
     (cond_121)? ( glob_descriptor_2) :
-    (cond_184 && ~cond_44)? ( glob_descriptor_2) :
-    (cond_185)? ( glob_descriptor_2) :
+    (cond_188 && ~cond_44)? ( glob_descriptor_2) :
+    (cond_189)? ( glob_descriptor_2) :
     64'd0;
 assign offset_task =
-    (cond_275)? (`TRUE) :
+    (cond_279)? (`TRUE) :
     1'd0;
 assign exe_glob_param_2_set =
     (cond_8 && cond_11)? (`TRUE) :
@@ -582,12 +587,12 @@ assign exe_glob_param_2_set =
     (cond_12 && ~cond_11)? (`TRUE) :
     (cond_28)? (`TRUE) :
     (cond_73)? (`TRUE) :
-    (cond_200)? (`TRUE) :
-    (cond_222 && cond_11)? (`TRUE) :
-    (cond_222 && ~cond_11)? (`TRUE) :
-    (cond_223 && cond_11)? (`TRUE) :
-    (cond_223 && ~cond_11)? (`TRUE) :
-    (cond_276)? (`TRUE) :
+    (cond_204)? (`TRUE) :
+    (cond_226 && cond_11)? (`TRUE) :
+    (cond_226 && ~cond_11)? (`TRUE) :
+    (cond_227 && cond_11)? (`TRUE) :
+    (cond_227 && ~cond_11)? (`TRUE) :
+    (cond_280)? (`TRUE) :
     1'd0;
 assign offset_pop =
     (cond_65 && cond_66)? (`TRUE) :
@@ -598,11 +603,11 @@ assign offset_pop =
     (cond_138)? (`TRUE) :
     (cond_139)? (`TRUE) :
     (cond_140)? (`TRUE) :
-    (cond_180)? (`TRUE) :
-    (cond_183)? ( exe_decoder[0] == 1'b1) :
-    (cond_187 && cond_188)? ( exe_decoder[0] == 1'b1) :
-    (cond_240)? (`TRUE) :
-    (cond_285)? (`TRUE) :
+    (cond_184)? (`TRUE) :
+    (cond_187)? ( exe_decoder[0] == 1'b1) :
+    (cond_191 && cond_192)? ( exe_decoder[0] == 1'b1) :
+    (cond_244)? (`TRUE) :
+    (cond_289)? (`TRUE) :
     1'd0;
 assign exe_result2 =
     (cond_106)? ( mult_result[63:32]) :
@@ -611,21 +616,25 @@ assign exe_result2 =
     (cond_145)? ( src) :
     (cond_150)? ( src) :
     (cond_153)? ( src) :
-    (cond_160)? ( dst) :
-    (cond_166)? ( mult_result[63:32]) :
-    (cond_174)? ( mult_result[63:32]) :
-    (cond_189)? ( src) :
-    (cond_190)? ( dst) :
-    (cond_195)? ( src) :
-    (cond_196)? ( src) :
-    (cond_239)? ( dst) :
-    (cond_240)? ( src) :
-    (cond_259 && cond_260)? ( src) :
-    (cond_259 && cond_261)? ( { 16'd0, e_seg_by_cmdex }) :
-    (cond_263)? ( src) :
-    (cond_286 && cond_287)? ( src) :
-    (cond_295)? ( dst) :
+    (cond_164)? ( dst) :
+    (cond_170)? ( mult_result[63:32]) :
+    (cond_178)? ( mult_result[63:32]) :
+    (cond_193)? ( src) :
+    (cond_194)? ( dst) :
+    (cond_199)? ( src) :
+    (cond_200)? ( src) :
+    (cond_243)? ( dst) :
+    (cond_244)? ( src) :
+    (cond_263 && cond_264)? ( src) :
+    (cond_263 && cond_265)? ( { 16'd0, e_seg_by_cmdex }) :
+    (cond_267)? ( src) :
+    (cond_290 && cond_291)? ( src) :
+    (cond_299)? ( dst) :
     32'd0;
+assign exe_trigger_mf_fault =
+    (cond_156 && ~cond_157 && cond_158)? (`TRUE) :
+    (cond_304 && ~cond_157 && cond_158)? (`TRUE) :
+    1'd0;
 assign offset_new_stack_continue =
     (cond_37)? (`TRUE) :
     (cond_39)? (`TRUE) :
@@ -650,11 +659,12 @@ assign exe_result_signals =
     (cond_117)? ( { 4'd0, e_bit_selected }) :
     (cond_142)? ( { e_shift_no_write, e_shift_oszapc_update, e_shift_cf_of_update, e_shift_oflag, e_shift_cflag }) :
     (cond_143)? ( { e_shift_no_write, e_shift_oszapc_update, e_shift_cf_of_update, e_shift_oflag, e_shift_cflag }) :
-    (cond_160)? ( { 4'd0, e_cmpxchg_eq }) :
-    (cond_168)? ( { e_shift_no_write, e_shift_oszapc_update, e_shift_cf_of_update, e_shift_oflag, e_shift_cflag }) :
-    (cond_175 && ~cond_176)? ( { 4'd0, exe_cmd_loop_condition }) :
-    (cond_296)? ( { 3'b0, exe_bcd_condition_af, exe_bcd_condition_cf }) :
-    (cond_297)? ( { 4'd0, e_bit_scan_zero }) :
+    (cond_164)? ( { 4'd0, e_cmpxchg_eq }) :
+    (cond_172)? ( { e_shift_no_write, e_shift_oszapc_update, e_shift_cf_of_update, e_shift_oflag, e_shift_cflag }) :
+    (cond_179 && ~cond_180)? ( { 4'd0, exe_cmd_loop_condition }) :
+    (cond_300)? ( { 3'b0, exe_bcd_condition_af, exe_bcd_condition_cf }) :
+    (cond_301)? ( { 4'd0, e_bit_scan_zero }) :
+    (cond_304)? ( { 3'd0, fpu_last, fpu_store_skip }) :
     5'd0;
 assign exe_result_push =
     (cond_8 && cond_9)? ( exe_eip) :
@@ -686,22 +696,22 @@ assign exe_result_push =
     (cond_105)? ( { 16'd0, exc_error_code[15:0] }) :
     (cond_154 && cond_155)? ( wr_esp_prev) :
     (cond_154 && ~cond_155)? ( src) :
-    (cond_162)? ( ebp) :
-    (cond_164 && cond_165)? ( exe_buffer) :
-    (cond_164 && ~cond_165)? ( src) :
-    (cond_167)? ( src) :
-    (cond_193 && cond_194)? ( { {24{src[7]}}, src[7:0] }) :
-    (cond_193 && ~cond_194)? ( src) :
-    (cond_213 && cond_205)? ( { 16'd0, ss[15:0] }) :
-    (cond_216)? ( src) :
-    (cond_217)? ( src) :
-    (cond_219)? ( src) :
-    (cond_220)? ( exe_pushf_eflags) :
-    (cond_236)? ( src) :
-    (cond_238)? ( src) :
-    (cond_257)? ( exe_push_eflags) :
-    (cond_275)? ( { 16'd0, glob_param_3[15:0] }) :
-    (cond_283)? ( src) :
+    (cond_166)? ( ebp) :
+    (cond_168 && cond_169)? ( exe_buffer) :
+    (cond_168 && ~cond_169)? ( src) :
+    (cond_171)? ( src) :
+    (cond_197 && cond_198)? ( { {24{src[7]}}, src[7:0] }) :
+    (cond_197 && ~cond_198)? ( src) :
+    (cond_217 && cond_209)? ( { 16'd0, ss[15:0] }) :
+    (cond_220)? ( src) :
+    (cond_221)? ( src) :
+    (cond_223)? ( src) :
+    (cond_224)? ( exe_pushf_eflags) :
+    (cond_240)? ( src) :
+    (cond_242)? ( src) :
+    (cond_261)? ( exe_push_eflags) :
+    (cond_279)? ( { 16'd0, glob_param_3[15:0] }) :
+    (cond_287)? ( src) :
     32'd0;
 assign exe_error_code =
     (cond_74 && cond_75)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
@@ -715,25 +725,25 @@ assign exe_error_code =
     (cond_131 && cond_132)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
     (cond_131 && cond_133)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
     (cond_136 && cond_137)? ( { glob_param_1[15:2], 2'd0 }) :
-    (cond_201 && cond_202)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_201 && cond_203)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_207 && cond_208)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_207 && cond_95)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_205 && cond_206)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_205 && cond_207)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
     (cond_211 && cond_212)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
     (cond_211 && cond_95)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_213 && cond_214)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_213 && cond_215)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_232 && cond_233)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_232 && cond_95)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_246 && cond_247)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_246 && cond_248)? ( `SELECTOR_FOR_CODE(tr)) :
-    (cond_264 && cond_265)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_266 && cond_267 && cond_268)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_266 && cond_267 && cond_269)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_270 && cond_267 && cond_271)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_270 && cond_267 && cond_272)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_273 && cond_267 && cond_274)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
-    (cond_273 && cond_267 && cond_272)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_215 && cond_216)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_215 && cond_95)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_217 && cond_218)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_217 && cond_219)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_236 && cond_237)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_236 && cond_95)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_250 && cond_251)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_250 && cond_252)? ( `SELECTOR_FOR_CODE(tr)) :
+    (cond_268 && cond_269)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_270 && cond_271 && cond_272)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_270 && cond_271 && cond_273)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_274 && cond_271 && cond_275)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_274 && cond_271 && cond_276)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_277 && cond_271 && cond_278)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
+    (cond_277 && cond_271 && cond_276)? ( `SELECTOR_FOR_CODE(glob_param_1)) :
     16'd0;
 assign exe_waiting =
     (cond_2 && cond_3)? (`TRUE) :
@@ -792,87 +802,93 @@ assign exe_waiting =
     (cond_153 && cond_72)? (`TRUE) :
     (cond_154 && cond_10)? (`TRUE) :
     (cond_156 && cond_157)? (`TRUE) :
-    (cond_158 && cond_51)? (`TRUE) :
+    (cond_156 && ~cond_157 && cond_158)? (`TRUE) :
+    (cond_156 && ~cond_157 && ~cond_158 && cond_159)? (`TRUE) :
     (cond_160 && cond_161)? (`TRUE) :
-    (cond_162 && cond_10)? (`TRUE) :
-    (cond_164 && cond_10)? (`TRUE) :
-    (cond_166 && cond_107)? (`TRUE) :
-    (cond_169 && cond_54)? (`TRUE) :
-    (cond_170 && cond_171)? (`TRUE) :
-    (cond_172 && cond_173)? (`TRUE) :
-    (cond_174 && cond_107)? (`TRUE) :
-    (cond_175 && cond_176)? (`TRUE) :
-    (cond_175 && ~cond_176 && cond_177)? (`TRUE) :
-    (cond_179 && cond_54)? (`TRUE) :
-    (cond_181 && cond_182)? (`TRUE) :
-    (cond_183 && cond_7)? (`TRUE) :
-    (cond_184 && cond_44)? (`TRUE) :
-    (cond_186 && cond_20)? (`TRUE) :
-    (cond_193 && cond_10)? (`TRUE) :
-    (cond_196 && cond_197)? (`TRUE) :
-    (cond_201 && cond_202)? (`TRUE) :
-    (cond_201 && cond_203)? (`TRUE) :
-    (cond_207 && cond_208)? (`TRUE) :
-    (cond_207 && cond_95)? (`TRUE) :
+    (cond_162 && cond_51)? (`TRUE) :
+    (cond_164 && cond_165)? (`TRUE) :
+    (cond_166 && cond_10)? (`TRUE) :
+    (cond_168 && cond_10)? (`TRUE) :
+    (cond_170 && cond_107)? (`TRUE) :
+    (cond_173 && cond_54)? (`TRUE) :
+    (cond_174 && cond_175)? (`TRUE) :
+    (cond_176 && cond_177)? (`TRUE) :
+    (cond_178 && cond_107)? (`TRUE) :
+    (cond_179 && cond_180)? (`TRUE) :
+    (cond_179 && ~cond_180 && cond_181)? (`TRUE) :
+    (cond_183 && cond_54)? (`TRUE) :
+    (cond_185 && cond_186)? (`TRUE) :
+    (cond_187 && cond_7)? (`TRUE) :
+    (cond_188 && cond_44)? (`TRUE) :
+    (cond_190 && cond_20)? (`TRUE) :
+    (cond_197 && cond_10)? (`TRUE) :
+    (cond_200 && cond_201)? (`TRUE) :
+    (cond_205 && cond_206)? (`TRUE) :
+    (cond_205 && cond_207)? (`TRUE) :
     (cond_211 && cond_212)? (`TRUE) :
     (cond_211 && cond_95)? (`TRUE) :
-    (cond_213 && cond_214)? (`TRUE) :
-    (cond_213 && cond_215)? (`TRUE) :
+    (cond_215 && cond_216)? (`TRUE) :
+    (cond_215 && cond_95)? (`TRUE) :
     (cond_217 && cond_218)? (`TRUE) :
-    (cond_219 && cond_218)? (`TRUE) :
-    (cond_220 && cond_221)? (`TRUE) :
-    (cond_220 && ~cond_221 && cond_124)? (`TRUE) :
-    (cond_223 && cond_224)? (`TRUE) :
-    (cond_225 && cond_14)? (`TRUE) :
-    (cond_228 && cond_14)? (`TRUE) :
-    (cond_230 && cond_7)? (`TRUE) :
-    (cond_232 && cond_233)? (`TRUE) :
-    (cond_232 && cond_95)? (`TRUE) :
+    (cond_217 && cond_219)? (`TRUE) :
+    (cond_221 && cond_222)? (`TRUE) :
+    (cond_223 && cond_222)? (`TRUE) :
+    (cond_224 && cond_225)? (`TRUE) :
+    (cond_224 && ~cond_225 && cond_124)? (`TRUE) :
+    (cond_227 && cond_228)? (`TRUE) :
+    (cond_229 && cond_14)? (`TRUE) :
+    (cond_232 && cond_14)? (`TRUE) :
     (cond_234 && cond_7)? (`TRUE) :
     (cond_236 && cond_237)? (`TRUE) :
-    (cond_240 && cond_51)? (`TRUE) :
-    (cond_240 && ~cond_51 && cond_124)? (`TRUE) :
-    (cond_241 && cond_51)? (`TRUE) :
-    (cond_241 && ~cond_51 && cond_242)? (`TRUE) :
-    (cond_244 && cond_245)? (`TRUE) :
-    (cond_246 && cond_247)? (`TRUE) :
-    (cond_246 && cond_248)? (`TRUE) :
-    (cond_249 && cond_250)? (`TRUE) :
-    (cond_249 && cond_251)? (`TRUE) :
-    (cond_252 && cond_250)? (`TRUE) :
-    (cond_252 && cond_251)? (`TRUE) :
-    (cond_253 && cond_250)? (`TRUE) :
-    (cond_253 && cond_251)? (`TRUE) :
-    (cond_254 && cond_250)? (`TRUE) :
-    (cond_254 && cond_251)? (`TRUE) :
-    (cond_255 && cond_250)? (`TRUE) :
-    (cond_255 && cond_251)? (`TRUE) :
-    (cond_256 && cond_250)? (`TRUE) :
-    (cond_256 && cond_251)? (`TRUE) :
-    (cond_264 && cond_265)? (`TRUE) :
-    (cond_266 && cond_267 && cond_268)? (`TRUE) :
-    (cond_266 && cond_267 && cond_269)? (`TRUE) :
-    (cond_270 && cond_267 && cond_271)? (`TRUE) :
-    (cond_270 && cond_267 && cond_272)? (`TRUE) :
-    (cond_273 && cond_267 && cond_274)? (`TRUE) :
-    (cond_273 && cond_267 && cond_272)? (`TRUE) :
-    (cond_276 && cond_277)? (`TRUE) :
-    (cond_286 && cond_294)? (`TRUE) :
-    (cond_286 && ~cond_294 && cond_54)? (`TRUE) :
-    (cond_296 && cond_51)? (`TRUE) :
+    (cond_236 && cond_95)? (`TRUE) :
+    (cond_238 && cond_7)? (`TRUE) :
+    (cond_240 && cond_241)? (`TRUE) :
+    (cond_244 && cond_51)? (`TRUE) :
+    (cond_244 && ~cond_51 && cond_124)? (`TRUE) :
+    (cond_245 && cond_51)? (`TRUE) :
+    (cond_245 && ~cond_51 && cond_246)? (`TRUE) :
+    (cond_248 && cond_249)? (`TRUE) :
+    (cond_250 && cond_251)? (`TRUE) :
+    (cond_250 && cond_252)? (`TRUE) :
+    (cond_253 && cond_254)? (`TRUE) :
+    (cond_253 && cond_255)? (`TRUE) :
+    (cond_256 && cond_254)? (`TRUE) :
+    (cond_256 && cond_255)? (`TRUE) :
+    (cond_257 && cond_254)? (`TRUE) :
+    (cond_257 && cond_255)? (`TRUE) :
+    (cond_258 && cond_254)? (`TRUE) :
+    (cond_258 && cond_255)? (`TRUE) :
+    (cond_259 && cond_254)? (`TRUE) :
+    (cond_259 && cond_255)? (`TRUE) :
+    (cond_260 && cond_254)? (`TRUE) :
+    (cond_260 && cond_255)? (`TRUE) :
+    (cond_268 && cond_269)? (`TRUE) :
+    (cond_270 && cond_271 && cond_272)? (`TRUE) :
+    (cond_270 && cond_271 && cond_273)? (`TRUE) :
+    (cond_274 && cond_271 && cond_275)? (`TRUE) :
+    (cond_274 && cond_271 && cond_276)? (`TRUE) :
+    (cond_277 && cond_271 && cond_278)? (`TRUE) :
+    (cond_277 && cond_271 && cond_276)? (`TRUE) :
+    (cond_280 && cond_281)? (`TRUE) :
+    (cond_290 && cond_298)? (`TRUE) :
+    (cond_290 && ~cond_298 && cond_54)? (`TRUE) :
+    (cond_300 && cond_51)? (`TRUE) :
+    (cond_304 && cond_157)? (`TRUE) :
+    (cond_304 && ~cond_157 && cond_158)? (`TRUE) :
+    (cond_304 && ~cond_157 && ~cond_158 && cond_159)? (`TRUE) :
     1'd0;
 assign exe_trigger_pf_fault =
-    (cond_249 && cond_251)? (`TRUE) :
-    (cond_252 && cond_251)? (`TRUE) :
-    (cond_253 && cond_251)? (`TRUE) :
-    (cond_254 && cond_251)? (`TRUE) :
-    (cond_255 && cond_251)? (`TRUE) :
-    (cond_256 && cond_251)? (`TRUE) :
+    (cond_253 && cond_255)? (`TRUE) :
+    (cond_256 && cond_255)? (`TRUE) :
+    (cond_257 && cond_255)? (`TRUE) :
+    (cond_258 && cond_255)? (`TRUE) :
+    (cond_259 && cond_255)? (`TRUE) :
+    (cond_260 && cond_255)? (`TRUE) :
     1'd0;
 assign exe_branch =
     (cond_2 && ~cond_3)? (         exe_jecxz_condition) :
     (cond_50 && ~cond_51)? (         exe_condition) :
-    (cond_175 && ~cond_176)? (         exe_cmd_loop_condition) :
+    (cond_179 && ~cond_180)? (         exe_cmd_loop_condition) :
     1'd0;
 assign offset_call =
     (cond_24)? (`TRUE) :
@@ -886,20 +902,20 @@ assign offset_int_real =
     1'd0;
 assign offset_iret_glob_param_4 =
     (cond_122)? (`TRUE) :
-    (cond_186)? (   exe_decoder[0] == 1'b1) :
+    (cond_190)? (   exe_decoder[0] == 1'b1) :
     1'd0;
 assign offset_leave =
-    (cond_167)? (`TRUE) :
+    (cond_171)? (`TRUE) :
     1'd0;
 assign offset_new_stack_minus =
-    (cond_213 && cond_205)? (`TRUE) :
+    (cond_217 && cond_209)? (`TRUE) :
     1'd0;
 assign offset_call_int_same_first =
     (cond_29)? (`TRUE) :
     (cond_96)? (`TRUE) :
     1'd0;
 assign exe_trigger_db_fault =
-    (cond_286 && cond_294)? (`TRUE) :
+    (cond_290 && cond_298)? (`TRUE) :
     1'd0;
 assign exe_glob_descriptor_2_set =
     (cond_24)? (`TRUE) :
@@ -908,8 +924,8 @@ assign exe_glob_descriptor_2_set =
     (cond_79 && cond_80)? (`TRUE) :
     (cond_120 && ~cond_44)? (`TRUE) :
     (cond_121)? (`TRUE) :
-    (cond_184 && ~cond_44)? (`TRUE) :
-    (cond_185)? ( exe_ready) :
+    (cond_188 && ~cond_44)? (`TRUE) :
+    (cond_189)? ( exe_ready) :
     1'd0;
 assign exe_glob_param_1_value =
     (cond_15)? ( { 13'd0, `SEGMENT_CS, src[15:0] }) :
@@ -923,20 +939,20 @@ assign exe_glob_param_1_value =
     (cond_79 && cond_80)? ( glob_param_3) :
     (cond_120 && ~cond_44)? ( glob_param_3) :
     (cond_121)? ( glob_param_3) :
-    (cond_184 && ~cond_44)? ( glob_param_3) :
-    (cond_185)? ( glob_param_3) :
-    (cond_196 && ~cond_197)? ( (exe_cmdex == `CMDEX_IN_dx)? { 16'd0, edx[15:0] } : { 24'd0, exe_decoder[15:8] }) :
-    (cond_204 && cond_205)? ( { 14'd0, `TASK_SWITCH_FROM_CALL, glob_param_1[15:0] }) :
-    (cond_204 && cond_206)? ( { 14'd0, `TASK_SWITCH_FROM_JUMP, glob_param_1[15:0] }) :
-    (cond_207 && cond_205)? ( { 14'd0, `TASK_SWITCH_FROM_CALL, glob_param_1[15:0] }) :
-    (cond_207 && cond_206)? ( { 14'd0, `TASK_SWITCH_FROM_JUMP, glob_param_1[15:0] }) :
-    (cond_207 && cond_209)? ( { 14'd0, `TASK_SWITCH_FROM_INT,  glob_param_1[15:0] }) :
-    (cond_217 && ~cond_218)? ( { 16'd0, edx[15:0] }) :
-    (cond_219 && ~cond_218)? ( { 16'd0, edx[15:0] }) :
-    (cond_226)? ( { 13'd0, `SEGMENT_CS, src[15:0] }) :
-    (cond_227 && cond_11)? ( { 13'd0, `SEGMENT_CS, exe_extra[31:16] }) :
-    (cond_227 && ~cond_11)? ( { 13'd0, `SEGMENT_CS, exe_extra[15:0] }) :
-    (cond_236 && ~cond_237)? ( (exe_cmdex == `CMDEX_OUT_dx)? { 16'd0, edx[15:0] } : { 24'd0, exe_decoder[15:8] }) :
+    (cond_188 && ~cond_44)? ( glob_param_3) :
+    (cond_189)? ( glob_param_3) :
+    (cond_200 && ~cond_201)? ( (exe_cmdex == `CMDEX_IN_dx)? { 16'd0, edx[15:0] } : { 24'd0, exe_decoder[15:8] }) :
+    (cond_208 && cond_209)? ( { 14'd0, `TASK_SWITCH_FROM_CALL, glob_param_1[15:0] }) :
+    (cond_208 && cond_210)? ( { 14'd0, `TASK_SWITCH_FROM_JUMP, glob_param_1[15:0] }) :
+    (cond_211 && cond_209)? ( { 14'd0, `TASK_SWITCH_FROM_CALL, glob_param_1[15:0] }) :
+    (cond_211 && cond_210)? ( { 14'd0, `TASK_SWITCH_FROM_JUMP, glob_param_1[15:0] }) :
+    (cond_211 && cond_213)? ( { 14'd0, `TASK_SWITCH_FROM_INT,  glob_param_1[15:0] }) :
+    (cond_221 && ~cond_222)? ( { 16'd0, edx[15:0] }) :
+    (cond_223 && ~cond_222)? ( { 16'd0, edx[15:0] }) :
+    (cond_230)? ( { 13'd0, `SEGMENT_CS, src[15:0] }) :
+    (cond_231 && cond_11)? ( { 13'd0, `SEGMENT_CS, exe_extra[31:16] }) :
+    (cond_231 && ~cond_11)? ( { 13'd0, `SEGMENT_CS, exe_extra[15:0] }) :
+    (cond_240 && ~cond_241)? ( (exe_cmdex == `CMDEX_OUT_dx)? { 16'd0, edx[15:0] } : { 24'd0, exe_decoder[15:8] }) :
     32'd0;
 assign exe_glob_param_1_set =
     (cond_15)? (`TRUE) :
@@ -950,20 +966,20 @@ assign exe_glob_param_1_set =
     (cond_79 && cond_80)? (`TRUE) :
     (cond_120 && ~cond_44)? (`TRUE) :
     (cond_121)? (`TRUE) :
-    (cond_184 && ~cond_44)? (`TRUE) :
-    (cond_185)? ( exe_ready) :
-    (cond_196 && ~cond_197)? (`TRUE) :
-    (cond_204 && cond_205)? (`TRUE) :
-    (cond_204 && cond_206)? (`TRUE) :
-    (cond_207 && cond_205)? (`TRUE) :
-    (cond_207 && cond_206)? (`TRUE) :
-    (cond_207 && cond_209)? (`TRUE) :
-    (cond_217 && ~cond_218)? (`TRUE) :
-    (cond_219 && ~cond_218)? (`TRUE) :
-    (cond_226)? (`TRUE) :
-    (cond_227 && cond_11)? (`TRUE) :
-    (cond_227 && ~cond_11)? (`TRUE) :
-    (cond_236 && ~cond_237)? (`TRUE) :
+    (cond_188 && ~cond_44)? (`TRUE) :
+    (cond_189)? ( exe_ready) :
+    (cond_200 && ~cond_201)? (`TRUE) :
+    (cond_208 && cond_209)? (`TRUE) :
+    (cond_208 && cond_210)? (`TRUE) :
+    (cond_211 && cond_209)? (`TRUE) :
+    (cond_211 && cond_210)? (`TRUE) :
+    (cond_211 && cond_213)? (`TRUE) :
+    (cond_221 && ~cond_222)? (`TRUE) :
+    (cond_223 && ~cond_222)? (`TRUE) :
+    (cond_230)? (`TRUE) :
+    (cond_231 && cond_11)? (`TRUE) :
+    (cond_231 && ~cond_11)? (`TRUE) :
+    (cond_240 && ~cond_241)? (`TRUE) :
     1'd0;
 assign offset_call_int_same_next =
     (cond_30)? (`TRUE) :
@@ -978,10 +994,10 @@ assign offset_call_keep =
     1'd0;
 assign invdcode_do =
     (cond_55)? ( ~(e_invd_code_done)) :
-    (cond_170)? (   ~(e_wbinvd_code_done)) :
+    (cond_174)? (   ~(e_wbinvd_code_done)) :
     1'd0;
 assign exe_is_8bit_clear =
-    (cond_284)? ( exe_is_8bit) :
+    (cond_288)? ( exe_is_8bit) :
     1'd0;
 assign exe_glob_param_3_value =
     (cond_34 && cond_36)? ( glob_param_1) :
@@ -989,31 +1005,31 @@ assign exe_glob_param_3_value =
     (cond_79 && cond_80)? ( glob_param_1) :
     (cond_120 && ~cond_44)? ( glob_param_1) :
     (cond_121)? ( glob_param_1) :
-    (cond_184 && ~cond_44)? ( glob_param_1) :
-    (cond_185)? ( glob_param_1) :
-    (cond_204)? ( { 10'd0, exe_consumed, 1'd0, 1'd0, 16'd0 }) :
-    (cond_207 && cond_210)? ( { 10'd0, exe_consumed, 1'd0, 1'd0, 16'd0 }) :
-    (cond_207 && cond_209)? ( { 10'd0, exe_consumed, 1'd0, exc_push_error, exc_error_code[15:0] }) :
+    (cond_188 && ~cond_44)? ( glob_param_1) :
+    (cond_189)? ( glob_param_1) :
+    (cond_208)? ( { 10'd0, exe_consumed, 1'd0, 1'd0, 16'd0 }) :
+    (cond_211 && cond_214)? ( { 10'd0, exe_consumed, 1'd0, 1'd0, 16'd0 }) :
+    (cond_211 && cond_213)? ( { 10'd0, exe_consumed, 1'd0, exc_push_error, exc_error_code[15:0] }) :
     32'd0;
 assign tlbcheck_do =
-    (cond_249)? (`TRUE) :
-    (cond_252)? (`TRUE) :
     (cond_253)? (`TRUE) :
-    (cond_254)? (`TRUE) :
-    (cond_255)? (`TRUE) :
     (cond_256)? (`TRUE) :
+    (cond_257)? (`TRUE) :
+    (cond_258)? (`TRUE) :
+    (cond_259)? (`TRUE) :
+    (cond_260)? (`TRUE) :
     1'd0;
 assign offset_int_real_next =
     (cond_87)? (`TRUE) :
     (cond_88)? (`TRUE) :
     1'd0;
 assign tlbcheck_address =
-    (cond_249)? (   glob_desc_base) :
-    (cond_252)? (   glob_desc_base + exe_new_tss_max) :
     (cond_253)? (   glob_desc_base) :
-    (cond_254)? (   glob_desc_base + 32'd1) :
-    (cond_255)? (   (tr_cache[`DESC_BITS_TYPE] <= 4'd3)? tr_base + 32'd14 : tr_base + 32'h20) :
-    (cond_256)? (   (tr_cache[`DESC_BITS_TYPE] <= 4'd3)? tr_base + 32'd41 : tr_base + 32'h5D) :
+    (cond_256)? (   glob_desc_base + exe_new_tss_max) :
+    (cond_257)? (   glob_desc_base) :
+    (cond_258)? (   glob_desc_base + 32'd1) :
+    (cond_259)? (   (tr_cache[`DESC_BITS_TYPE] <= 4'd3)? tr_base + 32'd14 : tr_base + 32'h20) :
+    (cond_260)? (   (tr_cache[`DESC_BITS_TYPE] <= 4'd3)? tr_base + 32'd41 : tr_base + 32'h5D) :
     32'd0;
 assign exe_glob_param_2_value =
     (cond_8 && cond_11)? ( src) :
@@ -1022,18 +1038,20 @@ assign exe_glob_param_2_value =
     (cond_12 && ~cond_11)? ( { 16'd0, exe_arith_add[15:0] }) :
     (cond_28)? ( (glob_descriptor[`DESC_BITS_TYPE] == `DESC_CALL_GATE_386)? { glob_descriptor[63:48], glob_descriptor[15:0] } : { 16'd0, glob_descriptor[15:0] }) :
     (cond_73)? ( (glob_descriptor[`DESC_BITS_TYPE] >= `DESC_INTERRUPT_GATE_386)? { glob_descriptor[63:48], glob_descriptor[15:0] } : { 16'd0, glob_descriptor[15:0] }) :
-    (cond_200)? ( { 26'd0, exe_cmd_verw_desc_invalid, exe_cmd_verr_desc_invalid, exe_cmd_lsl_desc_invalid, exe_cmd_lar_desc_invalid, glob_param_2[1:0] }) :
-    (cond_222 && cond_11)? ( src) :
-    (cond_222 && ~cond_11)? ( { 16'd0, src[15:0] }) :
-    (cond_223 && cond_11)? ( exe_arith_add[31:0]) :
-    (cond_223 && ~cond_11)? ( { 16'd0, exe_arith_add[15:0] }) :
-    (cond_276)? ( exe_eip) :
+    (cond_204)? ( { 26'd0, exe_cmd_verw_desc_invalid, exe_cmd_verr_desc_invalid, exe_cmd_lsl_desc_invalid, exe_cmd_lar_desc_invalid, glob_param_2[1:0] }) :
+    (cond_226 && cond_11)? ( src) :
+    (cond_226 && ~cond_11)? ( { 16'd0, src[15:0] }) :
+    (cond_227 && cond_11)? ( exe_arith_add[31:0]) :
+    (cond_227 && ~cond_11)? ( { 16'd0, exe_arith_add[15:0] }) :
+    (cond_280)? ( exe_eip) :
     32'd0;
 assign exe_cmpxchg_switch_carry =
-    (cond_160)? ( e_cmpxchg_sub[32]) :
+    (cond_164)? ( e_cmpxchg_sub[32]) :
     1'd0;
 assign exe_trigger_nm_fault =
     (cond_156 && cond_157)? (`TRUE) :
+    (cond_160 && cond_161)? (`TRUE) :
+    (cond_304 && cond_157)? (`TRUE) :
     1'd0;
 assign exe_arith_index =
     (cond_0)? ( (`ARITH_VALID | `ARITH_ADD)) :
@@ -1041,9 +1059,9 @@ assign exe_arith_index =
     (cond_63)? ( (`ARITH_VALID | `ARITH_SUB)) :
     (cond_64)? ( (exe_cmdex[0] == `FALSE)? (`ARITH_VALID | `ARITH_ADD) : (`ARITH_VALID | `ARITH_SUB)) :
     (cond_144)? ( (`ARITH_VALID | `ARITH_SUB)) :
-    (cond_160)? ( (`ARITH_VALID | `ARITH_SUB)) :
-    (cond_172)? ( {`TRUE, exe_cmd[2:0]}) :
-    (cond_178)? ( (`ARITH_VALID | `ARITH_AND)) :
+    (cond_164)? ( (`ARITH_VALID | `ARITH_SUB)) :
+    (cond_176)? ( {`TRUE, exe_cmd[2:0]}) :
+    (cond_182)? ( (`ARITH_VALID | `ARITH_AND)) :
     4'd0;
 assign exe_glob_descriptor_set =
     (cond_24)? (`TRUE) :
@@ -1052,8 +1070,8 @@ assign exe_glob_descriptor_set =
     (cond_79 && cond_80)? (`TRUE) :
     (cond_120 && ~cond_44)? (`TRUE) :
     (cond_121)? (`TRUE) :
-    (cond_184 && ~cond_44)? (`TRUE) :
-    (cond_185)? ( exe_ready) :
+    (cond_188 && ~cond_44)? (`TRUE) :
+    (cond_189)? ( exe_ready) :
     1'd0;
 assign exe_result =
     (cond_0)? (  exe_arith_add[31:0]) :
@@ -1078,48 +1096,49 @@ assign exe_result =
     (cond_146 && cond_148)? ( cr2) :
     (cond_146 && cond_149)? ( cr3) :
     (cond_152)? ( e_cr0_reg) :
-    (cond_158 && cond_159)? ( 32'd1) :
-    (cond_160)? (  e_cmpxchg_result) :
-    (cond_166)? (  mult_result[31:0]) :
-    (cond_168)? ( e_shift_result) :
-    (cond_172)? ( ({ 1'b0, exe_cmd[2:0] } == `ARITH_ADD)?   exe_arith_add[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_OR)?    exe_arith_or : ({ 1'b0, exe_cmd[2:0] } == `ARITH_ADC)?   exe_arith_adc[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_SBB)?   exe_arith_sbb[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_AND)?   exe_arith_and : ({ 1'b0, exe_cmd[2:0] } == `ARITH_XOR)?   exe_arith_xor : exe_arith_sub[31:0]) :
-    (cond_174)? (  mult_result[31:0]) :
-    (cond_178)? ( exe_arith_and) :
-    (cond_190)? (  src) :
-    (cond_191)? (  src) :
-    (cond_192)? ( exe_buffer) :
-    (cond_198)? ( exe_arith_not) :
-    (cond_199)? ( exe_extra) :
-    (cond_239)? (  src) :
-    (cond_278)? ( exe_address_effective) :
-    (cond_279 && cond_280)? ( { 16'd0, gdtr_limit }) :
-    (cond_279 && cond_281)? ( gdtr_base) :
-    (cond_282 && cond_280)? ( { 16'd0, idtr_limit }) :
-    (cond_282 && cond_281)? ( idtr_base) :
-    (cond_284)? ( (exe_cmd == `CMD_MOVSX && exe_is_8bit)?     { {24{src[7]}},  src[7:0] } : (exe_cmd == `CMD_MOVSX)?                    { {16{src[15]}}, src[15:0] } : (exe_cmd == `CMD_MOVZX && exe_is_8bit)?     { 24'd0, src[7:0] } : { 16'd0, src[15:0] }) :
-    (cond_286 && cond_288)? ( dr0) :
-    (cond_286 && cond_289)? ( dr1) :
-    (cond_286 && cond_290)? ( dr2) :
-    (cond_286 && cond_291)? ( dr3) :
-    (cond_286 && cond_292)? ( { 16'hFFFF, dr6_bt, dr6_bs, dr6_bd, dr6_b12, 8'hFF, dr6_breakpoints }) :
-    (cond_286 && cond_293)? ( dr7) :
-    (cond_295)? (  src) :
-    (cond_296)? ( (exe_cmd == `CMD_AAA)?  { 16'd0, e_aaa_result } : (exe_cmd == `CMD_AAS)?  { 16'd0, e_aas_result } : (exe_cmd == `CMD_DAA)?  { 16'd0, dst[15:8], e_daa_result } : { 16'd0, dst[15:8], e_das_result }) :
-    (cond_297 && cond_298)? ( { 27'd0, e_bit_scan_forward }) :
-    (cond_297 && cond_299)? ( { 27'd0, e_bit_scan_reverse }) :
+    (cond_162 && cond_163)? ( 32'd1) :
+    (cond_164)? (  e_cmpxchg_result) :
+    (cond_170)? (  mult_result[31:0]) :
+    (cond_172)? ( e_shift_result) :
+    (cond_176)? ( ({ 1'b0, exe_cmd[2:0] } == `ARITH_ADD)?   exe_arith_add[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_OR)?    exe_arith_or : ({ 1'b0, exe_cmd[2:0] } == `ARITH_ADC)?   exe_arith_adc[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_SBB)?   exe_arith_sbb[31:0] : ({ 1'b0, exe_cmd[2:0] } == `ARITH_AND)?   exe_arith_and : ({ 1'b0, exe_cmd[2:0] } == `ARITH_XOR)?   exe_arith_xor : exe_arith_sub[31:0]) :
+    (cond_178)? (  mult_result[31:0]) :
+    (cond_182)? ( exe_arith_and) :
+    (cond_194)? (  src) :
+    (cond_195)? (  src) :
+    (cond_196)? ( exe_buffer) :
+    (cond_202)? ( exe_arith_not) :
+    (cond_203)? ( exe_extra) :
+    (cond_243)? (  src) :
+    (cond_282)? ( exe_address_effective) :
+    (cond_283 && cond_284)? ( { 16'd0, gdtr_limit }) :
+    (cond_283 && cond_285)? ( gdtr_base) :
+    (cond_286 && cond_284)? ( { 16'd0, idtr_limit }) :
+    (cond_286 && cond_285)? ( idtr_base) :
+    (cond_288)? ( (exe_cmd == `CMD_MOVSX && exe_is_8bit)?     { {24{src[7]}},  src[7:0] } : (exe_cmd == `CMD_MOVSX)?                    { {16{src[15]}}, src[15:0] } : (exe_cmd == `CMD_MOVZX && exe_is_8bit)?     { 24'd0, src[7:0] } : { 16'd0, src[15:0] }) :
+    (cond_290 && cond_292)? ( dr0) :
+    (cond_290 && cond_293)? ( dr1) :
+    (cond_290 && cond_294)? ( dr2) :
+    (cond_290 && cond_295)? ( dr3) :
+    (cond_290 && cond_296)? ( { 16'hFFFF, dr6_bt, dr6_bs, dr6_bd, dr6_b12, 8'hFF, dr6_breakpoints }) :
+    (cond_290 && cond_297)? ( dr7) :
+    (cond_299)? (  src) :
+    (cond_300)? ( (exe_cmd == `CMD_AAA)?  { 16'd0, e_aaa_result } : (exe_cmd == `CMD_AAS)?  { 16'd0, e_aas_result } : (exe_cmd == `CMD_DAA)?  { 16'd0, dst[15:8], e_daa_result } : { 16'd0, dst[15:8], e_das_result }) :
+    (cond_301 && cond_302)? ( { 27'd0, e_bit_scan_forward }) :
+    (cond_301 && cond_303)? ( { 27'd0, e_bit_scan_reverse }) :
+    (cond_304)? ( fpu_result) :
     32'd0;
 assign exe_trigger_ts_fault =
     (cond_34 && cond_35)? (`TRUE) :
     (cond_74 && cond_76)? (`TRUE) :
     (cond_129 && cond_130)? (`TRUE) :
     (cond_131 && cond_132)? (`TRUE) :
-    (cond_213 && cond_214)? (`TRUE) :
-    (cond_246 && cond_247)? (`TRUE) :
-    (cond_246 && cond_248)? (`TRUE) :
-    (cond_264 && cond_265)? (`TRUE) :
-    (cond_266 && cond_267 && cond_268)? (`TRUE) :
-    (cond_270 && cond_267 && cond_271)? (`TRUE) :
-    (cond_273 && cond_267 && cond_274)? (`TRUE) :
+    (cond_217 && cond_218)? (`TRUE) :
+    (cond_250 && cond_251)? (`TRUE) :
+    (cond_250 && cond_252)? (`TRUE) :
+    (cond_268 && cond_269)? (`TRUE) :
+    (cond_270 && cond_271 && cond_272)? (`TRUE) :
+    (cond_274 && cond_271 && cond_275)? (`TRUE) :
+    (cond_277 && cond_271 && cond_278)? (`TRUE) :
     1'd0;
 assign exe_glob_param_3_set =
     (cond_34 && cond_36)? (`TRUE) :
@@ -1127,11 +1146,11 @@ assign exe_glob_param_3_set =
     (cond_79 && cond_80)? (`TRUE) :
     (cond_120 && ~cond_44)? (`TRUE) :
     (cond_121)? (`TRUE) :
-    (cond_184 && ~cond_44)? (`TRUE) :
-    (cond_185)? ( exe_ready) :
-    (cond_204)? (`TRUE) :
-    (cond_207 && cond_210)? (`TRUE) :
-    (cond_207 && cond_209)? (`TRUE) :
+    (cond_188 && ~cond_44)? (`TRUE) :
+    (cond_189)? ( exe_ready) :
+    (cond_208)? (`TRUE) :
+    (cond_211 && cond_214)? (`TRUE) :
+    (cond_211 && cond_213)? (`TRUE) :
     1'd0;
 assign exe_glob_descriptor_2_value =
     (cond_24)? ( glob_descriptor) :
@@ -1140,18 +1159,18 @@ assign exe_glob_descriptor_2_value =
     (cond_79 && cond_80)? ( glob_descriptor) :
     (cond_120 && ~cond_44)? ( glob_descriptor) :
     (cond_121)? ( glob_descriptor) :
-    (cond_184 && ~cond_44)? ( glob_descriptor) :
-    (cond_185)? ( glob_descriptor) :
+    (cond_188 && ~cond_44)? ( glob_descriptor) :
+    (cond_189)? ( glob_descriptor) :
     64'd0;
 assign dr6_bd_set =
-    (cond_286 && cond_294)? ( `TRUE) :
+    (cond_290 && cond_298)? ( `TRUE) :
     1'd0;
 assign offset_enter_last =
-    (cond_163)? (`TRUE) :
+    (cond_167)? (`TRUE) :
     1'd0;
 assign offset_new_stack =
     (cond_77)? (`TRUE) :
     1'd0;
 assign offset_ret_imm =
-    (cond_186)? (             exe_decoder[0] == 1'b0) :
+    (cond_190)? (             exe_decoder[0] == 1'b0) :
     1'd0;
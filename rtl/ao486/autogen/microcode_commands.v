@@ -210,7 +210,14 @@ wire cond_207 = mc_cmd == `CMD_SGDT || mc_cmd == `CMD_SIDT;
 wire cond_208 = mc_cmd == `CMD_POPA && mc_step < 6'd7;
 wire cond_209 = mc_cmd == `CMD_POPA && mc_step == 6'd7;
 wire cond_210 = mc_cmd == `CMD_debug_reg && mc_cmdex_last == `CMDEX_debug_reg_MOV_load_STEP_0;
-wire cond_211 = 
+wire cond_211 = (mc_cmd == `CMD_x87 || mc_cmd == `CMD_x87_store) && mc_step == 6'd1 && mc_decoder[13] && ((mc_decoder[2:0] == 3'd3 && mc_decoder[11]) || (mc_decoder[2:0] == 3'd7 && ~(mc_decoder[11])));
+wire cond_212 = (mc_cmd == `CMD_x87 || mc_cmd == `CMD_x87_store) && mc_step == 6'd1 && ~(mc_decoder[13] && ((mc_decoder[2:0] == 3'd3 && mc_decoder[11]) || (mc_decoder[2:0] == 3'd7 && ~(mc_decoder[11]))));
+wire cond_213 = (mc_cmd == `CMD_x87 || mc_cmd == `CMD_x87_store) && mc_step == 6'd2;
+wire cond_214 = mc_cmd == `CMD_x87_env && (mc_step < 6'd6 || (mc_step == 6'd6 && mc_decoder[2]));
+wire cond_215 = mc_cmd == `CMD_x87_env && mc_step == 6'd6 && ~(mc_decoder[2]);
+wire cond_216 = mc_cmd == `CMD_x87_env && mc_step > 6'd6 && mc_step < 6'd26;
+wire cond_217 = mc_cmd == `CMD_x87_env && mc_step == 6'd26;
+wire cond_218 = 
 (mc_cmd == `CMD_CALL && mc_cmdex_last == `CMDEX_CALL_Ev_Jv_STEP_1) ||
 (mc_cmd == `CMD_CALL && mc_cmdex_last == `CMDEX_CALL_real_v8086_STEP_3) ||
 (mc_cmd == `CMD_CALL_2 && mc_cmdex_last == `CMDEX_CALL_2_protected_seg_STEP_4) ||
@@ -495,6 +502,9 @@ assign mc_cmd_next =
     (cond_208)? (      mc_cmd) :
     (cond_210)? (      `CMD_debug_reg) :
     (cond_211)? (      mc_cmd) :
+    (cond_214)? (      mc_cmd) :
+    (cond_216)? (      mc_cmd) :
+    (cond_218)? (      mc_cmd) :
     7'd0;
 assign mc_cmdex_current =
     (cond_0)? ( `CMDEX_XADD_LAST) :
@@ -708,7 +718,14 @@ assign mc_cmdex_current =
     (cond_208)? (  mc_step[3:0]) :
     (cond_209)? ( `CMDEX_POPA_STEP_7) :
     (cond_210)? ( `CMDEX_debug_reg_MOV_load_STEP_1) :
-    (cond_211)? ( mc_cmdex_last) :
+    (cond_211)? (  `CMDEX_x87_STEP_1) :
+    (cond_212)? (  `CMDEX_x87_STEP_1) :
+    (cond_213)? (  `CMDEX_x87_STEP_2) :
+    (cond_214)? (  `CMDEX_x87_env_STEP_1) :
+    (cond_215)? (  `CMDEX_x87_env_STEP_1) :
+    (cond_216)? (  `CMDEX_x87_env_STEP_2) :
+    (cond_217)? (  `CMDEX_x87_env_STEP_2) :
+    (cond_218)? ( mc_cmdex_last) :
     4'd0;
 assign mc_cmd_current =
     (cond_0)? (   `CMD_XADD) :
@@ -923,4 +940,11 @@ assign mc_cmd_current =
     (cond_209)? (   `CMD_POPA) :
     (cond_210)? (   `CMD_debug_reg) :
     (cond_211)? (   mc_cmd) :
+    (cond_212)? (   mc_cmd) :
+    (cond_213)? (   mc_cmd) :
+    (cond_214)? (   mc_cmd) :
+    (cond_215)? (   mc_cmd) :
+    (cond_216)? (   mc_cmd) :
+    (cond_217)? (   mc_cmd) :
+    (cond_218)? (   mc_cmd) :
     7'd0;
@@ -34,6 +34,9 @@ assign rd_task_switch_linear_next = (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)?
 always @(posedge clk) begin if(rst_n == 1'b0)                                                               rd_task_switch_linear_reg <= 32'd0; else if(rd_cmd == `CMD_task_switch && rd_cmdex == `CMDEX_task_switch_STEP_12)   rd_task_switch_linear_reg <= rd_system_linear; else if(rd_ready)                                                               rd_task_switch_linear_reg <= rd_task_switch_linear_next;
 end
 
+wire rd_x87_word;
+assign rd_x87_word = (rd_cmd != `CMD_x87_env && rd_cmdex == `CMDEX_x87_STEP_2) || rd_decoder[2:0] == 3'd6 || (rd_decoder[2:0] == 3'd7 && ~(rd_decoder[13])) || (rd_decoder[2:0] == 3'd1 && (rd_decoder[13:11] == 3'd5 || rd_decoder[13:11] == 3'd7)) || (rd_decoder[2:0] == 3'd5 && rd_decoder[13:11] == 3'd7);
+
 //======================================================== conditions
 wire cond_0 = rd_cmd == `CMD_XADD && rd_cmdex == `CMDEX_XADD_FIRST;
 wire cond_1 = rd_modregrm_mod == 2'b11;
@@ -294,6 +297,13 @@ wire cond_255 = rd_cmd == `CMD_debug_reg && rd_cmdex == `CMDEX_debug_reg_MOV_loa
 wire cond_256 = rd_cmd == `CMD_XLAT;
 wire cond_257 = rd_cmd == `CMD_AAA || rd_cmd == `CMD_AAS || rd_cmd == `CMD_DAA || rd_cmd == `CMD_DAS;
 wire cond_258 = { rd_cmd[6:1], 1'd0 } == `CMD_BSx;
+wire cond_259 = (rd_cmd == `CMD_x87 || rd_cmd == `CMD_x87_store || rd_cmd == `CMD_x87_env) && rd_modregrm_mod != 2'b11;
+wire cond_260 = rd_cmdex != `CMDEX_x87_STEP_0;
+wire cond_261 = rd_cmd == `CMD_x87_env && rd_cmdex == `CMDEX_x87_env_STEP_2;
+wire cond_262 = rd_cmd != `CMD_x87_env && rd_x87_word;
+wire cond_263 = rd_cmd != `CMD_x87_env;
+wire cond_264 = rd_cmd == `CMD_x87_store || (rd_cmd == `CMD_x87_env && rd_decoder[12]);
+wire cond_265 = rd_cmd == `CMD_x87 && rd_decoder[15:0] == 16'hE0DF;
 //======================================================== saves
 //======================================================== always
 //======================================================== sets
@@ -468,6 +478,7 @@ assign rd_req_eax =
     (cond_226)? (`TRUE) :
     (cond_256)? (`TRUE) :
     (cond_257)? (`TRUE) :
+    (cond_265)? (`TRUE) :
     1'd0;
 assign address_stack_for_iret_last =
     (cond_98 && cond_101)? (`TRUE) :
@@ -536,6 +547,7 @@ assign read_virtual =
     (cond_251 && ~cond_104)? (`TRUE) :
     (cond_256 && ~cond_9)? (`TRUE) :
     (cond_258 && cond_3 && ~cond_9)? (`TRUE) :
+    (cond_259 && ~cond_264 && ~cond_9)? (`TRUE) :
     1'd0;
 assign rd_glob_param_4_value =
     (cond_98 && cond_99)? ( (rd_operand_16bit)? { 16'd0, read_4[15:0] } : read_4) :
@@ -560,6 +572,7 @@ assign write_virtual_check =
     (cond_217 && cond_3 && ~cond_218)? (`TRUE) :
     (cond_219 && cond_3 && ~cond_218)? (`TRUE) :
     (cond_246)? (`TRUE) :
+    (cond_259 && cond_264)? (`TRUE) :
     1'd0;
 assign rd_req_esi =
     (cond_114 && ~cond_38 && cond_39)? (`TRUE) :
@@ -670,6 +683,7 @@ assign rd_req_memory =
     (cond_231)? (`TRUE) :
     (cond_246)? (`TRUE) :
     (cond_249 && ~cond_38 && cond_39)? (`TRUE) :
+    (cond_259 && cond_264)? (`TRUE) :
     1'd0;
 assign rd_glob_param_3_set =
     (cond_15 && ~cond_16 && cond_17)? (`TRUE) :
@@ -748,6 +762,7 @@ assign rd_src_is_memory =
     (cond_251 && ~cond_104)? (`TRUE) :
     (cond_256)? (`TRUE) :
     (cond_258 && cond_3)? (`TRUE) :
+    (cond_259 && ~cond_264)? (`TRUE) :
     1'd0;
 assign read_system_qword =
     (cond_66 && ~cond_16)? (`TRUE) :
@@ -1162,6 +1177,9 @@ assign rd_waiting =
     (cond_258 && cond_1 && cond_8)? (`TRUE) :
     (cond_258 && cond_3 && cond_9)? (`TRUE) :
     (cond_258 && cond_3 && ~cond_9 && cond_5)? (`TRUE) :
+    (cond_259 && cond_264 && cond_29)? (`TRUE) :
+    (cond_259 && ~cond_264 && cond_9)? (`TRUE) :
+    (cond_259 && ~cond_264 && ~cond_9 && cond_5)? (`TRUE) :
     1'd0;
 assign address_ea_buffer =
     (cond_11 && cond_12)? (`TRUE) :
@@ -1171,6 +1189,7 @@ assign address_ea_buffer =
     (cond_206 && cond_207)? (`TRUE) :
     (cond_225)? (`TRUE) :
     (cond_246 && cond_248)? (`TRUE) :
+    (cond_259 && cond_260)? (`TRUE) :
     1'd0;
 assign address_stack_for_iret_to_v86 =
     (cond_95 && cond_96)? (`TRUE) :
@@ -1233,6 +1252,7 @@ assign read_length_word =
     (cond_206 && cond_207)? (`TRUE) :
     (cond_246 && cond_247)? (`TRUE) :
     (cond_250 && cond_3)? (`TRUE) :
+    (cond_259 && ~cond_261 && cond_262)? (`TRUE) :
     1'd0;
 assign address_xlat_transform =
     (cond_256)? (`TRUE) :
@@ -1380,6 +1400,9 @@ assign rd_src_is_modregrm_imm =
     (cond_155)? (`TRUE) :
     (cond_219)? (`TRUE) :
     1'd0;
+assign address_ea_buffer_plus_4 =
+    (cond_259)? ( rd_cmd != `CMD_x87_env || rd_cmdex == `CMDEX_x87_env_STEP_2) :
+    1'd0;
 assign address_stack_for_call_param_first =
     (cond_22 && cond_26)? (`TRUE) :
     1'd0;
@@ -1437,4 +1460,6 @@ assign read_length_dword =
     (cond_22 && cond_24)? (`TRUE) :
     (cond_121 && cond_123)? (`TRUE) :
     (cond_246 && cond_248)? (`TRUE) :
+    (cond_259 && cond_261)? (`TRUE) :
+    (cond_259 && ~cond_261 && ~cond_262 && cond_263)? (`TRUE) :
     1'd0;
@@ -22,6 +22,9 @@ assign wr_task_switch_linear_next = (tr_cache[`DESC_BITS_TYPE] <= 4'd3)?    wr_t
 always @(posedge clk) begin if(rst_n == 1'b0)                                                               wr_task_switch_linear_reg <= 32'd0; else if(wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_9)    wr_task_switch_linear_reg <= wr_task_switch_linear; else if(wr_ready)                                                               wr_task_switch_linear_reg <= wr_task_switch_linear_next;
 end
 
+wire wr_x87_word;
+assign wr_x87_word = wr_cmdex == `CMDEX_x87_STEP_2 || (wr_decoder[2:0] == 3'd7 && ~(wr_decoder[13])) || ((wr_decoder[2:0] == 3'd1 || wr_decoder[2:0] == 3'd5) && wr_decoder[13:11] == 3'd7);
+
 //======================================================== conditions
 wire cond_0 = wr_cmd == `CMD_XADD && wr_cmdex == `CMDEX_XADD_FIRST;
 wire cond_1 = wr_dst_is_memory && ~(write_for_wr_ready);
@@ -190,128 +193,136 @@ wire cond_163 = oflag;
 wire cond_164 = wr_cmd == `CMD_CPUID;
 wire cond_165 = eax == 32'd0;
 wire cond_166 = eax == 32'd1;
-wire cond_167 = wr_cmd == `CMD_IN;
-wire cond_168 = ~(io_allow_check_needed) || wr_cmdex == `CMDEX_IN_protected;
-wire cond_169 = wr_cmd == `CMD_NOT;
-wire cond_170 = (wr_cmd == `CMD_LAR || wr_cmd == `CMD_LSL || wr_cmd == `CMD_VERR || wr_cmd == `CMD_VERW) && (wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_1 || wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_2);
-wire cond_171 = (wr_cmd == `CMD_LAR || wr_cmd == `CMD_LSL) && wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
-wire cond_172 = wr_dst_is_reg;
-wire cond_173 = (wr_cmd == `CMD_VERR || wr_cmd == `CMD_VERW) && wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
-wire cond_174 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_same_STEP_3) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_same_STEP_0) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_protected_seg_STEP_3) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_2) || (wr_cmd == `CMD_JMP     && wr_cmdex == `CMDEX_JMP_protected_seg_STEP_0) || (wr_cmd == `CMD_JMP_2   && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_2) || (wr_cmd == `CMD_int_2   && wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_4);
-wire cond_175 = `DESC_IS_NOT_ACCESSED(glob_descriptor);
-wire cond_176 = wr_cmd != `CMD_JMP && wr_cmd != `CMD_JMP_2 && wr_cmd != `CMD_int_2;
-wire cond_177 = (wr_cmd == `CMD_CALL_3 && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_9) || (wr_cmd == `CMD_int_3  && wr_cmdex == `CMDEX_int_3_int_trap_gate_more_STEP_4);
-wire cond_178 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_same_STEP_4) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_protected_seg_STEP_4) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_3) || (wr_cmd == `CMD_CALL_3  && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_10) || (wr_cmd == `CMD_JMP     && wr_cmdex == `CMDEX_JMP_protected_seg_STEP_1) || (wr_cmd == `CMD_JMP_2   && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_3);
-wire cond_179 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_5) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_3);
-wire cond_180 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_6) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_5) || (wr_cmd == `CMD_CALL_3  && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_8) || (wr_cmd == `CMD_int_3   && wr_cmdex == `CMDEX_int_3_int_trap_gate_more_STEP_5);
-wire cond_181 = `DESC_IS_NOT_ACCESSED(glob_descriptor) && glob_param_1[15:2] != 14'd0;
-wire cond_182 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_7) ||  + (wr_cmd == `CMD_IRET_2 && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_6);
-wire cond_183 = (wr_cmd == `CMD_CALL && (wr_cmdex == `CMDEX_CALL_protected_STEP_0 || wr_cmdex == `CMDEX_CALL_protected_STEP_1)) || (wr_cmd == `CMD_JMP  && (wr_cmdex == `CMDEX_JMP_protected_STEP_0  || wr_cmdex == `CMDEX_JMP_protected_STEP_1));
-wire cond_184 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_task_gate_STEP_0) || (wr_cmd == `CMD_JMP    && wr_cmdex == `CMDEX_JMP_task_gate_STEP_0) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_task_gate_STEP_0);
-wire cond_185 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_task_gate_STEP_1) || (wr_cmd == `CMD_JMP    && wr_cmdex == `CMDEX_JMP_task_gate_STEP_1) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_task_gate_STEP_1);
-wire cond_186 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_0) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_0);
-wire cond_187 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_1) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_1);
-wire cond_188 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_2) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_2);
-wire cond_189 = (wr_cmd == `CMD_CALL_2 && (wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_0 || wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_1)) || (wr_cmd == `CMD_int_2 && (wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_0 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_1 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_2 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_3));
-wire cond_190 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_0) || (wr_cmd == `CMD_int_2  && wr_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_0);
-wire cond_191 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_1) || (wr_cmd == `CMD_int_2  && wr_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_1);
-wire cond_192 = wr_cmd == `CMD_STOS;
-wire cond_193 = ~(wr_string_es_fault);
-wire cond_194 = wr_string_finish;
-wire cond_195 = wr_string_ignore;
-wire cond_196 = wr_cmd == `CMD_INS;
-wire cond_197 = wr_cmdex == `CMDEX_INS_real_1 || wr_cmdex == `CMDEX_INS_protected_1;
-wire cond_198 = wr_string_finish || wr_prefix_group_1_rep == 2'd0;
-wire cond_199 = wr_cmd == `CMD_OUTS;
-wire cond_200 = io_allow_check_needed && wr_cmdex == `CMDEX_OUTS_first;
-wire cond_201 = ~(write_io_for_wr_ready);
-wire cond_202 = wr_cmd == `CMD_PUSHF;
-wire cond_203 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Jv_STEP_0 || wr_cmdex == `CMDEX_JMP_Ev_STEP_0);
-wire cond_204 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Ev_Jv_STEP_1 || wr_cmdex == `CMDEX_JMP_real_v8086_STEP_1);
-wire cond_205 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Ep_STEP_0 || wr_cmdex == `CMDEX_JMP_Ap_STEP_0 ||  +  wr_cmdex == `CMDEX_JMP_Ep_STEP_1 || wr_cmdex == `CMDEX_JMP_Ap_STEP_1);
-wire cond_206 = wr_cmd == `CMD_JMP && wr_cmdex == `CMDEX_JMP_real_v8086_STEP_0;
-wire cond_207 = wr_cmd == `CMD_JMP && wr_cmdex == `CMDEX_JMP_task_switch_STEP_0;
-wire cond_208 = wr_cmd == `CMD_JMP_2 && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_0;
-wire cond_209 = wr_cmd == `CMD_JMP_2 && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_1;
-wire cond_210 = wr_cmd == `CMD_OUT;
-wire cond_211 = ~(io_allow_check_needed) || wr_cmdex == `CMDEX_OUT_protected;
-wire cond_212 = wr_cmd == `CMD_MOV;
-wire cond_213 = wr_cmd == `CMD_LAHF;
-wire cond_214 = wr_cmd == `CMD_CBW;
-wire cond_215 = wr_cmd == `CMD_CWD;
-wire cond_216 = wr_cmd == `CMD_POPF && wr_cmdex == `CMDEX_POPF_STEP_0;
-wire cond_217 = (protected_mode && cpl == 2'd0) || real_mode;
-wire cond_218 = (protected_mode && cpl <= iopl) || v8086_mode || real_mode;
-wire cond_219 = wr_cmd == `CMD_CLI;
-wire cond_220 = wr_cmd == `CMD_STI;
-wire cond_221 = iflag == `FALSE;
-wire cond_222 = wr_cmd == `CMD_BOUND && wr_cmdex == `CMDEX_BOUND_STEP_FIRST;
-wire cond_223 = wr_cmd == `CMD_SALC && wr_cmdex == `CMDEX_SALC_STEP_0;
-wire cond_224 = cflag;
-wire cond_225 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_1;
-wire cond_226 = wr_cmd == `CMD_task_switch && (wr_cmdex == `CMDEX_task_switch_STEP_2 || wr_cmdex == `CMDEX_task_switch_STEP_3 || wr_cmdex == `CMDEX_task_switch_STEP_4 || wr_cmdex == `CMDEX_task_switch_STEP_5);
-wire cond_227 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_6;
-wire cond_228 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_JUMP || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_IRET;
-wire cond_229 = wr_cmd == `CMD_task_switch && (wr_cmdex == `CMDEX_task_switch_STEP_7 || wr_cmdex == `CMDEX_task_switch_STEP_8);
-wire cond_230 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_9;
-wire cond_231 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_10;
-wire cond_232 = wr_cmd == `CMD_task_switch_2 && wr_cmdex <= `CMDEX_task_switch_2_STEP_13;
-wire cond_233 = tr_cache[`DESC_BITS_TYPE] > 4'd3 || wr_cmdex <= `CMDEX_task_switch_2_STEP_11;
-wire cond_234 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_11;
-wire cond_235 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_CALL || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT;
-wire cond_236 = wr_cmd == `CMD_task_switch && wr_cmdex >= `CMDEX_task_switch_STEP_12 && wr_cmdex <= `CMDEX_task_switch_STEP_14;
-wire cond_237 = wr_cmd == `CMD_task_switch_3;
-wire cond_238 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_0;
-wire cond_239 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] != `TASK_SWITCH_FROM_IRET;
-wire cond_240 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_1;
-wire cond_241 = glob_descriptor[`DESC_BITS_TYPE] >= 4'd9 && cr0_pg && cr3 != exe_buffer_shifted[463:432];
-wire cond_242 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_2;
-wire cond_243 = glob_param_2[2:0] == 3'b000;
-wire cond_244 = wr_cmd == `CMD_task_switch_4 && wr_cmdex >= `CMDEX_task_switch_4_STEP_3 && wr_cmdex <= `CMDEX_task_switch_4_STEP_8;
-wire cond_245 = wr_cmdex == `CMDEX_task_switch_4_STEP_3;
-wire cond_246 = glob_param_2[1:0] == 2'b00 && ~(v8086_mode) && `DESC_IS_NOT_ACCESSED(glob_descriptor);
-wire cond_247 = wr_cmdex == `CMDEX_task_switch_4_STEP_4;
-wire cond_248 = wr_cmdex == `CMDEX_task_switch_4_STEP_5;
-wire cond_249 = wr_cmdex == `CMDEX_task_switch_4_STEP_6;
-wire cond_250 = wr_cmdex == `CMDEX_task_switch_4_STEP_7;
-wire cond_251 = glob_param_2[1:0] == 2'b00 && `DESC_IS_ACCESSED(glob_descriptor);
-wire cond_252 = glob_param_2[1:0] != 2'b00;
-wire cond_253 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_9;
-wire cond_254 = glob_param_3[16];
-wire cond_255 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_10;
-wire cond_256 = glob_param_3[17] && task_trap[0];
-wire cond_257 = wr_cmd == `CMD_LEA;
-wire cond_258 = (wr_cmd == `CMD_SGDT || wr_cmd == `CMD_SIDT);
-wire cond_259 = wr_cmdex == `CMDEX_SGDT_SIDT_STEP_1;
-wire cond_260 = wr_cmdex == `CMDEX_SGDT_SIDT_STEP_2;
-wire cond_261 = wr_cmd == `CMD_MOVS;
-wire cond_262 = wr_cmd == `CMD_MOVSX || wr_cmd == `CMD_MOVZX;
-wire cond_263 = wr_cmd == `CMD_POPA;
-wire cond_264 = wr_cmdex[2:0] == 3'd7;
-wire cond_265 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0;
-wire cond_266 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0;
-wire cond_267 = wr_decoder[13:11] == 3'd1;
-wire cond_268 = (wr_decoder[13:11] == 3'd4 || wr_decoder[13:11] == 3'd6);
-wire cond_269 = (wr_decoder[13:11] == 3'd5 || wr_decoder[13:11] == 3'd7);
-wire cond_270 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_load_STEP_1;
-wire cond_271 = wr_cmd == `CMD_XLAT;
-wire cond_272 = wr_cmd == `CMD_AAA || wr_cmd == `CMD_AAS;
-wire cond_273 = wr_cmd == `CMD_DAA || wr_cmd == `CMD_DAS;
-wire cond_274 = { wr_cmd[6:1], 1'd0 } == `CMD_BSx;
-wire cond_275 = eax > 32'd1;
+wire cond_167 = eax > 32'd1;
+wire cond_168 = wr_cmd == `CMD_IN;
+wire cond_169 = ~(io_allow_check_needed) || wr_cmdex == `CMDEX_IN_protected;
+wire cond_170 = wr_cmd == `CMD_NOT;
+wire cond_171 = (wr_cmd == `CMD_LAR || wr_cmd == `CMD_LSL || wr_cmd == `CMD_VERR || wr_cmd == `CMD_VERW) && (wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_1 || wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_2);
+wire cond_172 = (wr_cmd == `CMD_LAR || wr_cmd == `CMD_LSL) && wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
+wire cond_173 = wr_dst_is_reg;
+wire cond_174 = (wr_cmd == `CMD_VERR || wr_cmd == `CMD_VERW) && wr_cmdex == `CMDEX_LAR_LSL_VERR_VERW_STEP_LAST;
+wire cond_175 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_same_STEP_3) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_same_STEP_0) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_protected_seg_STEP_3) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_2) || (wr_cmd == `CMD_JMP     && wr_cmdex == `CMDEX_JMP_protected_seg_STEP_0) || (wr_cmd == `CMD_JMP_2   && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_2) || (wr_cmd == `CMD_int_2   && wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_4);
+wire cond_176 = `DESC_IS_NOT_ACCESSED(glob_descriptor);
+wire cond_177 = wr_cmd != `CMD_JMP && wr_cmd != `CMD_JMP_2 && wr_cmd != `CMD_int_2;
+wire cond_178 = (wr_cmd == `CMD_CALL_3 && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_9) || (wr_cmd == `CMD_int_3  && wr_cmdex == `CMDEX_int_3_int_trap_gate_more_STEP_4);
+wire cond_179 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_same_STEP_4) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_protected_seg_STEP_4) || (wr_cmd == `CMD_CALL_2  && wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_3) || (wr_cmd == `CMD_CALL_3  && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_10) || (wr_cmd == `CMD_JMP     && wr_cmdex == `CMDEX_JMP_protected_seg_STEP_1) || (wr_cmd == `CMD_JMP_2   && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_3);
+wire cond_180 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_5) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_3);
+wire cond_181 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_6) || (wr_cmd == `CMD_IRET_2  && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_5) || (wr_cmd == `CMD_CALL_3  && wr_cmdex == `CMDEX_CALL_3_call_gate_more_STEP_8) || (wr_cmd == `CMD_int_3   && wr_cmdex == `CMDEX_int_3_int_trap_gate_more_STEP_5);
+wire cond_182 = `DESC_IS_NOT_ACCESSED(glob_descriptor) && glob_param_1[15:2] != 14'd0;
+wire cond_183 = (wr_cmd == `CMD_RET_far && wr_cmdex == `CMDEX_RET_far_outer_STEP_7) ||  + (wr_cmd == `CMD_IRET_2 && wr_cmdex == `CMDEX_IRET_2_protected_outer_STEP_6);
+wire cond_184 = (wr_cmd == `CMD_CALL && (wr_cmdex == `CMDEX_CALL_protected_STEP_0 || wr_cmdex == `CMDEX_CALL_protected_STEP_1)) || (wr_cmd == `CMD_JMP  && (wr_cmdex == `CMDEX_JMP_protected_STEP_0  || wr_cmdex == `CMDEX_JMP_protected_STEP_1));
+wire cond_185 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_task_gate_STEP_0) || (wr_cmd == `CMD_JMP    && wr_cmdex == `CMDEX_JMP_task_gate_STEP_0) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_task_gate_STEP_0);
+wire cond_186 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_task_gate_STEP_1) || (wr_cmd == `CMD_JMP    && wr_cmdex == `CMDEX_JMP_task_gate_STEP_1) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_task_gate_STEP_1);
+wire cond_187 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_0) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_0);
+wire cond_188 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_1) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_1);
+wire cond_189 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_STEP_2) || (wr_cmd == `CMD_int    && wr_cmdex == `CMDEX_int_int_trap_gate_STEP_2);
+wire cond_190 = (wr_cmd == `CMD_CALL_2 && (wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_0 || wr_cmdex == `CMDEX_CALL_2_call_gate_same_STEP_1)) || (wr_cmd == `CMD_int_2 && (wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_0 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_1 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_2 || wr_cmdex == `CMDEX_int_2_int_trap_gate_same_STEP_3));
+wire cond_191 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_0) || (wr_cmd == `CMD_int_2  && wr_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_0);
+wire cond_192 = (wr_cmd == `CMD_CALL_2 && wr_cmdex == `CMDEX_CALL_2_call_gate_more_STEP_1) || (wr_cmd == `CMD_int_2  && wr_cmdex == `CMDEX_int_2_int_trap_gate_more_STEP_1);
+wire cond_193 = wr_cmd == `CMD_STOS;
+wire cond_194 = ~(wr_string_es_fault);
+wire cond_195 = wr_string_finish;
+wire cond_196 = wr_string_ignore;
+wire cond_197 = wr_cmd == `CMD_INS;
+wire cond_198 = wr_cmdex == `CMDEX_INS_real_1 || wr_cmdex == `CMDEX_INS_protected_1;
+wire cond_199 = wr_string_finish || wr_prefix_group_1_rep == 2'd0;
+wire cond_200 = wr_cmd == `CMD_OUTS;
+wire cond_201 = io_allow_check_needed && wr_cmdex == `CMDEX_OUTS_first;
+wire cond_202 = ~(write_io_for_wr_ready);
+wire cond_203 = wr_cmd == `CMD_PUSHF;
+wire cond_204 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Jv_STEP_0 || wr_cmdex == `CMDEX_JMP_Ev_STEP_0);
+wire cond_205 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Ev_Jv_STEP_1 || wr_cmdex == `CMDEX_JMP_real_v8086_STEP_1);
+wire cond_206 = wr_cmd == `CMD_JMP && (wr_cmdex == `CMDEX_JMP_Ep_STEP_0 || wr_cmdex == `CMDEX_JMP_Ap_STEP_0 ||  +  wr_cmdex == `CMDEX_JMP_Ep_STEP_1 || wr_cmdex == `CMDEX_JMP_Ap_STEP_1);
+wire cond_207 = wr_cmd == `CMD_JMP && wr_cmdex == `CMDEX_JMP_real_v8086_STEP_0;
+wire cond_208 = wr_cmd == `CMD_JMP && wr_cmdex == `CMDEX_JMP_task_switch_STEP_0;
+wire cond_209 = wr_cmd == `CMD_JMP_2 && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_0;
+wire cond_210 = wr_cmd == `CMD_JMP_2 && wr_cmdex == `CMDEX_JMP_2_call_gate_STEP_1;
+wire cond_211 = wr_cmd == `CMD_OUT;
+wire cond_212 = ~(io_allow_check_needed) || wr_cmdex == `CMDEX_OUT_protected;
+wire cond_213 = wr_cmd == `CMD_MOV;
+wire cond_214 = wr_cmd == `CMD_LAHF;
+wire cond_215 = wr_cmd == `CMD_CBW;
+wire cond_216 = wr_cmd == `CMD_CWD;
+wire cond_217 = wr_cmd == `CMD_POPF && wr_cmdex == `CMDEX_POPF_STEP_0;
+wire cond_218 = (protected_mode && cpl == 2'd0) || real_mode;
+wire cond_219 = (protected_mode && cpl <= iopl) || v8086_mode || real_mode;
+wire cond_220 = wr_cmd == `CMD_CLI;
+wire cond_221 = wr_cmd == `CMD_STI;
+wire cond_222 = iflag == `FALSE;
+wire cond_223 = wr_cmd == `CMD_BOUND && wr_cmdex == `CMDEX_BOUND_STEP_FIRST;
+wire cond_224 = wr_cmd == `CMD_SALC && wr_cmdex == `CMDEX_SALC_STEP_0;
+wire cond_225 = cflag;
+wire cond_226 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_1;
+wire cond_227 = wr_cmd == `CMD_task_switch && (wr_cmdex == `CMDEX_task_switch_STEP_2 || wr_cmdex == `CMDEX_task_switch_STEP_3 || wr_cmdex == `CMDEX_task_switch_STEP_4 || wr_cmdex == `CMDEX_task_switch_STEP_5);
+wire cond_228 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_6;
+wire cond_229 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_JUMP || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_IRET;
+wire cond_230 = wr_cmd == `CMD_task_switch && (wr_cmdex == `CMDEX_task_switch_STEP_7 || wr_cmdex == `CMDEX_task_switch_STEP_8);
+wire cond_231 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_9;
+wire cond_232 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_10;
+wire cond_233 = wr_cmd == `CMD_task_switch_2 && wr_cmdex <= `CMDEX_task_switch_2_STEP_13;
+wire cond_234 = tr_cache[`DESC_BITS_TYPE] > 4'd3 || wr_cmdex <= `CMDEX_task_switch_2_STEP_11;
+wire cond_235 = wr_cmd == `CMD_task_switch && wr_cmdex == `CMDEX_task_switch_STEP_11;
+wire cond_236 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_CALL || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT;
+wire cond_237 = wr_cmd == `CMD_task_switch && wr_cmdex >= `CMDEX_task_switch_STEP_12 && wr_cmdex <= `CMDEX_task_switch_STEP_14;
+wire cond_238 = wr_cmd == `CMD_task_switch_3;
+wire cond_239 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_0;
+wire cond_240 = glob_param_1[`TASK_SWITCH_SOURCE_BITS] != `TASK_SWITCH_FROM_IRET;
+wire cond_241 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_1;
+wire cond_242 = glob_descriptor[`DESC_BITS_TYPE] >= 4'd9 && cr0_pg && cr3 != exe_buffer_shifted[463:432];
+wire cond_243 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_2;
+wire cond_244 = glob_param_2[2:0] == 3'b000;
+wire cond_245 = wr_cmd == `CMD_task_switch_4 && wr_cmdex >= `CMDEX_task_switch_4_STEP_3 && wr_cmdex <= `CMDEX_task_switch_4_STEP_8;
+wire cond_246 = wr_cmdex == `CMDEX_task_switch_4_STEP_3;
+wire cond_247 = glob_param_2[1:0] == 2'b00 && ~(v8086_mode) && `DESC_IS_NOT_ACCESSED(glob_descriptor);
+wire cond_248 = wr_cmdex == `CMDEX_task_switch_4_STEP_4;
+wire cond_249 = wr_cmdex == `CMDEX_task_switch_4_STEP_5;
+wire cond_250 = wr_cmdex == `CMDEX_task_switch_4_STEP_6;
+wire cond_251 = wr_cmdex == `CMDEX_task_switch_4_STEP_7;
+wire cond_252 = glob_param_2[1:0] == 2'b00 && `DESC_IS_ACCESSED(glob_descriptor);
+wire cond_253 = glob_param_2[1:0] != 2'b00;
+wire cond_254 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_9;
+wire cond_255 = glob_param_3[16];
+wire cond_256 = wr_cmd == `CMD_task_switch_4 && wr_cmdex == `CMDEX_task_switch_4_STEP_10;
+wire cond_257 = glob_param_3[17] && task_trap[0];
+wire cond_258 = wr_cmd == `CMD_LEA;
+wire cond_259 = (wr_cmd == `CMD_SGDT || wr_cmd == `CMD_SIDT);
+wire cond_260 = wr_cmdex == `CMDEX_SGDT_SIDT_STEP_1;
+wire cond_261 = wr_cmdex == `CMDEX_SGDT_SIDT_STEP_2;
+wire cond_262 = wr_cmd == `CMD_MOVS;
+wire cond_263 = wr_cmd == `CMD_MOVSX || wr_cmd == `CMD_MOVZX;
+wire cond_264 = wr_cmd == `CMD_POPA;
+wire cond_265 = wr_cmdex[2:0] == 3'd7;
+wire cond_266 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_store_STEP_0;
+wire cond_267 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_load_STEP_0;
+wire cond_268 = wr_decoder[13:11] == 3'd1;
+wire cond_269 = (wr_decoder[13:11] == 3'd4 || wr_decoder[13:11] == 3'd6);
+wire cond_270 = (wr_decoder[13:11] == 3'd5 || wr_decoder[13:11] == 3'd7);
+wire cond_271 = wr_cmd == `CMD_debug_reg && wr_cmdex == `CMDEX_debug_reg_MOV_load_STEP_1;
+wire cond_272 = wr_cmd == `CMD_XLAT;
+wire cond_273 = wr_cmd == `CMD_AAA || wr_cmd == `CMD_AAS;
+wire cond_274 = wr_cmd == `CMD_DAA || wr_cmd == `CMD_DAS;
+wire cond_275 = { wr_cmd[6:1], 1'd0 } == `CMD_BSx;
+wire cond_276 = wr_cmd == `CMD_x87 || wr_cmd == `CMD_x87_store || wr_cmd == `CMD_x87_env;
+wire cond_277 = (wr_cmd == `CMD_x87_store || (wr_cmd == `CMD_x87_env && wr_decoder[12])) && ~(result_signals[0]);
+wire cond_278 = wr_cmd == `CMD_x87_env && wr_cmdex == `CMDEX_x87_env_STEP_2;
+wire cond_279 = wr_cmd == `CMD_x87_store && wr_x87_word;
+wire cond_280 = wr_cmd == `CMD_x87_store;
+wire cond_281 = ~(result_signals[1]);
+wire cond_282 = write_for_wr_ready || ~(wr_cmd == `CMD_x87_store || (wr_cmd == `CMD_x87_env && wr_decoder[12])) || result_signals[0];
+wire cond_283 = wr_cmd == `CMD_x87 && wr_decoder[15:0] == 16'hE0DF;
 //======================================================== saves
 assign gdtr_limit_to_reg =
     (cond_119 && cond_121 && cond_120)? ( result2[15:0]) :
     gdtr_limit;
 assign tr_to_reg =
-    (cond_240)? (         glob_param_1[15:0]) :
+    (cond_241)? (         glob_param_1[15:0]) :
     tr;
 assign cr0_nw_to_reg =
     (cond_113 && cond_114)? ( result2[29]) :
     cr0_nw;
 assign ss_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (            task_ss[1:0]) :
+    (cond_241)? (            task_ss[1:0]) :
     ss_rpl;
 assign cr0_cd_to_reg =
     (cond_113 && cond_114)? ( result2[30]) :
@@ -321,18 +332,18 @@ assign cs_cache_to_reg =
     (cond_113 && cond_114 && cond_116)? ( { cs_cache[63:48], 1'b1, cs_cache[46:45], 1'b1, 4'b0011, cs_cache[39:0] }) :
     cs_cache;
 assign tr_cache_to_reg =
-    (cond_240)? (   glob_descriptor | 64'h0000020000000000) :
+    (cond_241)? (   glob_descriptor | 64'h0000020000000000) :
     tr_cache;
 assign fs_cache_valid_to_reg =
     (cond_63 && cond_64)? ( `FALSE) :
     (cond_87)? ( `TRUE) :
-    (cond_240)? (    `FALSE) :
+    (cond_241)? (    `FALSE) :
     fs_cache_valid;
 assign ldtr_to_reg =
-    (cond_240)? (              task_ldtr) :
+    (cond_241)? (              task_ldtr) :
     ldtr;
 assign dr6_b12_to_reg =
-    (cond_266 && cond_268)? (    result2[12]) :
+    (cond_267 && cond_269)? (    result2[12]) :
     dr6_b12;
 assign zflag_to_reg =
     (cond_0)? ( zflag_result) :
@@ -356,19 +367,19 @@ assign zflag_to_reg =
     (cond_139)? ( zflag_result) :
     (cond_142)? ( zflag_result) :
     (cond_145)? ( zflag_result) :
-    (cond_171 && cond_172)? ( `TRUE) :
-    (cond_171 && ~cond_172)? ( `FALSE) :
-    (cond_173)? ( wr_dst_is_reg) :
-    (cond_216)? (  result2[6]) :
-    (cond_240)? (  task_eflags[6]) :
-    (cond_272)? ( zflag_result) :
+    (cond_172 && cond_173)? ( `TRUE) :
+    (cond_172 && ~cond_173)? ( `FALSE) :
+    (cond_174)? ( wr_dst_is_reg) :
+    (cond_217)? (  result2[6]) :
+    (cond_241)? (  task_eflags[6]) :
     (cond_273)? ( zflag_result) :
-    (cond_274 && cond_5)? ( `TRUE) :
-    (cond_274 && ~cond_5)? ( `FALSE) :
+    (cond_274)? ( zflag_result) :
+    (cond_275 && cond_5)? ( `TRUE) :
+    (cond_275 && ~cond_5)? ( `FALSE) :
     zflag;
 assign fs_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (            task_fs[1:0]) :
+    (cond_241)? (            task_fs[1:0]) :
     fs_rpl;
 assign esp_to_reg =
     (cond_8 && cond_10)? ( wr_stack_esp) :
@@ -392,29 +403,29 @@ assign esp_to_reg =
     (cond_147)? ( wr_stack_esp) :
     (cond_149)? ( wr_stack_esp) :
     (cond_158 && cond_22)? ( wr_stack_esp) :
-    (cond_174 && cond_175 && ~cond_9 && cond_176)? ( wr_stack_esp) :
-    (cond_174 && ~cond_175 && cond_176)? ( wr_stack_esp) :
-    (cond_182)? ( wr_stack_esp) :
-    (cond_189 && cond_10)? ( wr_stack_esp) :
-    (cond_202 && cond_22)? ( wr_stack_esp) :
-    (cond_216)? ( wr_stack_esp) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[223:208] } : exe_buffer_shifted[239:208]) :
-    (cond_253 && cond_254 && cond_10)? ( wr_stack_esp) :
-    (cond_263)? ( wr_stack_esp) :
+    (cond_175 && cond_176 && ~cond_9 && cond_177)? ( wr_stack_esp) :
+    (cond_175 && ~cond_176 && cond_177)? ( wr_stack_esp) :
+    (cond_183)? ( wr_stack_esp) :
+    (cond_190 && cond_10)? ( wr_stack_esp) :
+    (cond_203 && cond_22)? ( wr_stack_esp) :
+    (cond_217)? ( wr_stack_esp) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[223:208] } : exe_buffer_shifted[239:208]) :
+    (cond_254 && cond_255 && cond_10)? ( wr_stack_esp) :
+    (cond_264)? ( wr_stack_esp) :
     esp;
 assign ebp_to_reg =
     (cond_131)? ( { wr_operand_16bit? ebp[31:16] : exe_buffer[31:16], exe_buffer[15:0] }) :
     (cond_135)? ( { wr_operand_16bit? ebp[31:16] : result_push[31:16], result_push[15:0] }) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[191:176] } : exe_buffer_shifted[207:176]) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? ebp[31:16] : exe_buffer_shifted[159:144], exe_buffer_shifted[143:128] }) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[191:176] } : exe_buffer_shifted[207:176]) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? ebp[31:16] : exe_buffer_shifted[159:144], exe_buffer_shifted[143:128] }) :
     ebp;
 assign tr_rpl_to_reg =
-    (cond_240)? (     glob_param_1[1:0]) :
+    (cond_241)? (     glob_param_1[1:0]) :
     tr_rpl;
 assign fs_to_reg =
     (cond_63 && cond_64)? (             16'd0) :
     (cond_87)? ( wr_IRET_to_v86_fs) :
-    (cond_240)? (                task_fs) :
+    (cond_241)? (                task_fs) :
     fs;
 assign gs_cache_to_reg =
     (cond_87)? ( `DESC_MASK_P | `DESC_MASK_DPL | `DESC_MASK_SEG | `DESC_MASK_DATA_RWA | { 24'd0, 4'd0,wr_IRET_to_v86_gs[15:12], wr_IRET_to_v86_gs[11:0],4'd0, 16'hFFFF }) :
@@ -438,22 +449,22 @@ assign oflag_to_reg =
     (cond_139)? ( oflag_arith) :
     (cond_142)? ( wr_mult_overflow) :
     (cond_145)? ( oflag_arith) :
-    (cond_216)? (  result2[11]) :
-    (cond_240)? (  task_eflags[11]) :
-    (cond_272)? ( oflag_arith) :
+    (cond_217)? (  result2[11]) :
+    (cond_241)? (  task_eflags[11]) :
     (cond_273)? ( oflag_arith) :
-    (cond_274 && ~cond_5)? ( oflag_arith) :
+    (cond_274)? ( oflag_arith) :
+    (cond_275 && ~cond_5)? ( oflag_arith) :
     oflag;
 assign ss_to_reg =
     (cond_87)? ( wr_IRET_to_v86_ss) :
-    (cond_240)? (                task_ss) :
+    (cond_241)? (                task_ss) :
     ss;
 assign ebx_to_reg =
     (cond_164 && cond_165)? ( "uneG") :
     (cond_164 && cond_166)? ( 32'h0) :
-    (cond_164 && cond_275)? ( 32'd0) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[255:240] } : exe_buffer_shifted[271:240]) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? ebx[31:16] : exe_buffer_shifted[95:80],   exe_buffer_shifted[79:64] }) :
+    (cond_164 && cond_167)? ( 32'd0) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[255:240] } : exe_buffer_shifted[271:240]) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? ebx[31:16] : exe_buffer_shifted[95:80],   exe_buffer_shifted[79:64] }) :
     ebx;
 assign dflag_to_reg =
     (cond_48)? ( `FALSE) :
@@ -462,14 +473,14 @@ assign dflag_to_reg =
     (cond_87)? (  glob_param_3[10]) :
     (cond_89)? (  glob_param_3[10]) :
     (cond_93)? (  glob_param_5[10]) :
-    (cond_216)? (  result2[10]) :
-    (cond_240)? (  task_eflags[10]) :
+    (cond_217)? (  result2[10]) :
+    (cond_241)? (  task_eflags[10]) :
     dflag;
 assign dr3_to_reg =
-    (cond_266 && cond_118)? ( result2) :
+    (cond_267 && cond_118)? ( result2) :
     dr3;
 assign dr2_to_reg =
-    (cond_266 && cond_117)? ( result2) :
+    (cond_267 && cond_117)? ( result2) :
     dr2;
 assign acflag_to_reg =
     (cond_60)? ( `FALSE) :
@@ -477,8 +488,8 @@ assign acflag_to_reg =
     (cond_87)? ( glob_param_3[18]) :
     (cond_89 && cond_83)? ( glob_param_3[18]) :
     (cond_93 && cond_83)? ( glob_param_5[18]) :
-    (cond_216 && cond_83)? ( result2[18]) :
-    (cond_240)? ( task_eflags[18]) :
+    (cond_217 && cond_83)? ( result2[18]) :
+    (cond_241)? ( task_eflags[18]) :
     acflag;
 assign cr0_mp_to_reg =
     (cond_110)? ( result2[1]) :
@@ -492,37 +503,37 @@ assign cr2_to_reg =
     cr2;
 assign cr3_to_reg =
     (cond_113 && cond_118)? ( result2) :
-    (cond_240 && cond_241)? ( exe_buffer_shifted[463:432]) :
+    (cond_241 && cond_242)? ( exe_buffer_shifted[463:432]) :
     cr3;
 assign dr1_to_reg =
-    (cond_266 && cond_267)? ( result2) :
+    (cond_267 && cond_268)? ( result2) :
     dr1;
 assign dr0_to_reg =
-    (cond_266 && cond_114)? ( result2) :
+    (cond_267 && cond_114)? ( result2) :
     dr0;
 assign ds_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (            task_ds[1:0]) :
+    (cond_241)? (            task_ds[1:0]) :
     ds_rpl;
 assign dr7_to_reg =
-    (cond_240)? ( dr7 & 32'hFFFFFEAA) :
-    (cond_266 && cond_269)? (    result2 | 32'h00000400) :
+    (cond_241)? ( dr7 & 32'hFFFFFEAA) :
+    (cond_267 && cond_270)? (    result2 | 32'h00000400) :
     dr7;
 assign ds_cache_valid_to_reg =
     (cond_63 && cond_64)? ( `FALSE) :
     (cond_87)? ( `TRUE) :
-    (cond_240)? (    `FALSE) :
+    (cond_241)? (    `FALSE) :
     ds_cache_valid;
 assign cs_to_reg =
     (cond_87)? ( wr_IRET_to_v86_cs) :
-    (cond_240)? (             task_cs) :
+    (cond_241)? (             task_cs) :
     cs;
 assign cr0_am_to_reg =
     (cond_113 && cond_114)? ( result2[18]) :
     cr0_am;
 assign cs_cache_valid_to_reg =
     (cond_87)? ( `TRUE) :
-    (cond_240)? ( `FALSE) :
+    (cond_241)? ( `FALSE) :
     cs_cache_valid;
 assign idtr_limit_to_reg =
     (cond_119 && cond_122 && cond_120)? ( result2[15:0]) :
@@ -541,7 +552,7 @@ assign fs_cache_to_reg =
     (cond_87)? ( `DESC_MASK_P | `DESC_MASK_DPL | `DESC_MASK_SEG | `DESC_MASK_DATA_RWA | { 24'd0, 4'd0,wr_IRET_to_v86_fs[15:12], wr_IRET_to_v86_fs[11:0],4'd0, 16'hFFFF }) :
     fs_cache;
 assign dr6_bd_to_reg =
-    (cond_266 && cond_268)? (     result2[13]) :
+    (cond_267 && cond_269)? (     result2[13]) :
     dr6_bd;
 assign idtr_base_to_reg =
     (cond_119 && cond_122 && ~cond_120)? ( wr_operand_32bit? result2 : { 8'd0, result2[23:0] }) :
@@ -549,10 +560,10 @@ assign idtr_base_to_reg =
 assign gs_to_reg =
     (cond_63 && cond_64)? (             16'd0) :
     (cond_87)? ( wr_IRET_to_v86_gs) :
-    (cond_240)? (                task_gs) :
+    (cond_241)? (                task_gs) :
     gs;
 assign ldtr_cache_to_reg =
-    (cond_242 && cond_243)? (         glob_descriptor) :
+    (cond_243 && cond_244)? (         glob_descriptor) :
     ldtr_cache;
 assign eax_to_reg =
     (cond_66)? ( { eax[31:16], result[15:0] }) :
@@ -564,55 +575,56 @@ assign eax_to_reg =
     (cond_155)? ( (wr_operand_16bit)? { eax[31:16], result2[15:0] } : result2) :
     (cond_164 && cond_165)? ( 32'd1) :
     (cond_164 && cond_166)? ( `CPUID_MODEL_FAMILY_STEPPING) :
-    (cond_164 && cond_275)? ( 32'd0) :
-    (cond_167 && cond_168)? ( (wr_is_8bit)? { eax[31:8], result2[7:0] } : (wr_operand_16bit)? { eax[31:16], result2[15:0] } : result2) :
-    (cond_213)? ( { eax[31:16], sflag, zflag, 1'b0, aflag, 1'b0, pflag, 1'b1, cflag, eax[7:0] }) :
-    (cond_214 && cond_83)? ( { {16{eax[15]}}, eax[15:0] }) :
-    (cond_214 && ~cond_83)? ( { eax[31:16], {8{eax[7]}}, eax[7:0] }) :
-    (cond_223 && cond_224)? ( { eax[31:8], 8'hFF }) :
-    (cond_223 && ~cond_224)? ( { eax[31:8], 8'h00 }) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[351:336] } : exe_buffer_shifted[367:336]) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? eax[31:16] : exe_buffer[31:16],           exe_buffer[15:0] }) :
-    (cond_272)? ( { eax[31:16], result[15:0] }) :
+    (cond_164 && cond_167)? ( 32'd0) :
+    (cond_168 && cond_169)? ( (wr_is_8bit)? { eax[31:8], result2[7:0] } : (wr_operand_16bit)? { eax[31:16], result2[15:0] } : result2) :
+    (cond_214)? ( { eax[31:16], sflag, zflag, 1'b0, aflag, 1'b0, pflag, 1'b1, cflag, eax[7:0] }) :
+    (cond_215 && cond_83)? ( { {16{eax[15]}}, eax[15:0] }) :
+    (cond_215 && ~cond_83)? ( { eax[31:16], {8{eax[7]}}, eax[7:0] }) :
+    (cond_224 && cond_225)? ( { eax[31:8], 8'hFF }) :
+    (cond_224 && ~cond_225)? ( { eax[31:8], 8'h00 }) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[351:336] } : exe_buffer_shifted[367:336]) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? eax[31:16] : exe_buffer[31:16],           exe_buffer[15:0] }) :
     (cond_273)? ( { eax[31:16], result[15:0] }) :
+    (cond_274)? ( { eax[31:16], result[15:0] }) :
+    (cond_276 && cond_283)? ( { eax[31:16], result[15:0] }) :
     eax;
 assign dr6_bs_to_reg =
-    (cond_266 && cond_268)? (     result2[14]) :
+    (cond_267 && cond_269)? (     result2[14]) :
     dr6_bs;
 assign edi_to_reg =
     (cond_32 && cond_33)? ( wr_edi_final) :
     (cond_107 && cond_33)? ( wr_edi_final) :
-    (cond_192 && cond_33 && ~cond_9)? ( wr_edi_final) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9)? ( wr_edi_final) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[127:112] } : exe_buffer_shifted[143:112]) :
-    (cond_261 && cond_33 && ~cond_9)? ( wr_edi_final) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? edi[31:16] : exe_buffer_shifted[223:208], exe_buffer_shifted[207:192] }) :
+    (cond_193 && cond_33 && ~cond_9)? ( wr_edi_final) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9)? ( wr_edi_final) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[127:112] } : exe_buffer_shifted[143:112]) :
+    (cond_262 && cond_33 && ~cond_9)? ( wr_edi_final) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? edi[31:16] : exe_buffer_shifted[223:208], exe_buffer_shifted[207:192] }) :
     edi;
 assign dr6_bt_to_reg =
-    (cond_266 && cond_268)? (     result2[15]) :
+    (cond_267 && cond_269)? (     result2[15]) :
     dr6_bt;
 wire [1:0] wr_task_rpl_to_reg =
-    (cond_179)? ( cpl) :
-    (cond_240)? ( task_cs[1:0]) :
+    (cond_180)? ( cpl) :
+    (cond_241)? ( task_cs[1:0]) :
     wr_task_rpl;
 assign iopl_to_reg =
     (cond_82 && cond_68)? (  glob_param_3[13:12]) :
     (cond_87)? (   glob_param_3[13:12]) :
     (cond_89 && cond_91)? (  glob_param_3[13:12]) :
     (cond_93 && cond_95)? (  glob_param_5[13:12]) :
-    (cond_216 && cond_217)? (  result2[13:12]) :
-    (cond_240)? (   task_eflags[13:12]) :
+    (cond_217 && cond_218)? (  result2[13:12]) :
+    (cond_241)? (   task_eflags[13:12]) :
     iopl;
 assign ldtr_rpl_to_reg =
-    (cond_240)? (          task_ldtr[1:0]) :
+    (cond_241)? (          task_ldtr[1:0]) :
     ldtr_rpl;
 assign es_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (            task_es[1:0]) :
+    (cond_241)? (            task_es[1:0]) :
     es_rpl;
 assign ldtr_cache_valid_to_reg =
-    (cond_240)? (  `FALSE) :
-    (cond_242 && cond_243)? (   `TRUE) :
+    (cond_241)? (  `FALSE) :
+    (cond_243 && cond_244)? (   `TRUE) :
     ldtr_cache_valid;
 assign es_cache_to_reg =
     (cond_87)? ( `DESC_MASK_P | `DESC_MASK_DPL | `DESC_MASK_SEG | `DESC_MASK_DATA_RWA | { 24'd0, 4'd0,wr_IRET_to_v86_es[15:12], wr_IRET_to_v86_es[11:0],4'd0, 16'hFFFF }) :
@@ -625,10 +637,10 @@ assign iflag_to_reg =
     (cond_87)? (  glob_param_3[9]) :
     (cond_89 && cond_90)? (  glob_param_3[9]) :
     (cond_93 && cond_94)? (  glob_param_5[9]) :
-    (cond_216 && cond_218)? ( result2[9]) :
-    (cond_219)? ( `FALSE) :
-    (cond_220)? ( `TRUE) :
-    (cond_240)? (  task_eflags[9]) :
+    (cond_217 && cond_219)? ( result2[9]) :
+    (cond_220)? ( `FALSE) :
+    (cond_221)? ( `TRUE) :
+    (cond_241)? (  task_eflags[9]) :
     iflag;
 assign sflag_to_reg =
     (cond_0)? ( sflag_result) :
@@ -650,38 +662,38 @@ assign sflag_to_reg =
     (cond_139)? ( sflag_result) :
     (cond_142)? ( sflag_result) :
     (cond_145)? ( sflag_result) :
-    (cond_216)? (  result2[7]) :
-    (cond_240)? (  task_eflags[7]) :
-    (cond_272)? ( sflag_result) :
+    (cond_217)? (  result2[7]) :
+    (cond_241)? (  task_eflags[7]) :
     (cond_273)? ( sflag_result) :
-    (cond_274 && ~cond_5)? ( sflag_result) :
+    (cond_274)? ( sflag_result) :
+    (cond_275 && ~cond_5)? ( sflag_result) :
     sflag;
 assign edx_to_reg =
     (cond_100 && cond_101)? ( (wr_operand_16bit)? { edx[31:16], result[31:16] } : result2) :
     (cond_133 && cond_134 && cond_101)? ( (wr_operand_16bit)? { edx[31:16], result[31:16] } : result2) :
     (cond_142 && cond_134 && cond_101)? ( (wr_operand_16bit)? { edx[31:16], result[31:16] } : result2) :
     (cond_164 && cond_165)? ( "Ieni") :
-    (cond_164 && cond_166)? ( 32'd0) :
-    (cond_164 && cond_275)? ( 32'd0) :
-    (cond_215 && cond_83)? ( {32{eax[31]}}) :
-    (cond_215 && ~cond_83)? ( { edx[31:16], {16{eax[15]}} }) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[287:272] } : exe_buffer_shifted[303:272]) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? edx[31:16] : exe_buffer_shifted[63:48],   exe_buffer_shifted[47:32] }) :
+    (cond_164 && cond_166)? ( `CPUID_FEATURES) :
+    (cond_164 && cond_167)? ( 32'd0) :
+    (cond_216 && cond_83)? ( {32{eax[31]}}) :
+    (cond_216 && ~cond_83)? ( { edx[31:16], {16{eax[15]}} }) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[287:272] } : exe_buffer_shifted[303:272]) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? edx[31:16] : exe_buffer_shifted[63:48],   exe_buffer_shifted[47:32] }) :
     edx;
 assign vmflag_to_reg =
     (cond_62)? ( `FALSE) :
     (cond_63)? ( `FALSE) :
     (cond_87)? ( glob_param_3[`EFLAGS_BIT_VM]) :
-    (cond_240)? ( task_eflags[17]) :
+    (cond_241)? ( task_eflags[17]) :
     vmflag;
 assign gs_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (            task_gs[1:0]) :
+    (cond_241)? (            task_gs[1:0]) :
     gs_rpl;
 assign ds_to_reg =
     (cond_63 && cond_64)? (             16'd0) :
     (cond_87)? ( wr_IRET_to_v86_ds) :
-    (cond_240)? (                task_ds) :
+    (cond_241)? (                task_ds) :
     ds;
 assign ds_cache_to_reg =
     (cond_87)? ( `DESC_MASK_P | `DESC_MASK_DPL | `DESC_MASK_SEG | `DESC_MASK_DATA_RWA | { 24'd0, 4'd0,wr_IRET_to_v86_ds[15:12], wr_IRET_to_v86_ds[11:0],4'd0, 16'hFFFF }) :
@@ -694,16 +706,16 @@ assign rflag_to_reg =
     (cond_87)? (  glob_param_3[16]) :
     (cond_89 && cond_83)? (  glob_param_3[16]) :
     (cond_93 && cond_83)? (  glob_param_5[16]) :
-    (cond_216 && cond_83)? (  result2[16]) :
-    (cond_240)? (  task_eflags[16]) :
+    (cond_217 && cond_83)? (  result2[16]) :
+    (cond_241)? (  task_eflags[16]) :
     rflag;
 assign esi_to_reg =
     (cond_107 && cond_33)? ( wr_esi_final) :
     (cond_152 && cond_33)? ( wr_esi_final) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201)? ( wr_esi_final) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[159:144] } : exe_buffer_shifted[175:144]) :
-    (cond_261 && cond_33 && ~cond_9)? ( wr_esi_final) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? esi[31:16] : exe_buffer_shifted[191:176], exe_buffer_shifted[175:160] }) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202)? ( wr_esi_final) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[159:144] } : exe_buffer_shifted[175:144]) :
+    (cond_262 && cond_33 && ~cond_9)? ( wr_esi_final) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? esi[31:16] : exe_buffer_shifted[191:176], exe_buffer_shifted[175:160] }) :
     esi;
 assign ss_cache_to_reg =
     (cond_87)? ( `DESC_MASK_P | `DESC_MASK_DPL | `DESC_MASK_SEG | `DESC_MASK_DATA_RWA | { 24'd0, 4'd0,wr_IRET_to_v86_ss[15:12], wr_IRET_to_v86_ss[11:0],4'd0, 16'hFFFF }) :
@@ -711,12 +723,12 @@ assign ss_cache_to_reg =
 assign gs_cache_valid_to_reg =
     (cond_63 && cond_64)? ( `FALSE) :
     (cond_87)? ( `TRUE) :
-    (cond_240)? (    `FALSE) :
+    (cond_241)? (    `FALSE) :
     gs_cache_valid;
 assign es_cache_valid_to_reg =
     (cond_63 && cond_64)? ( `FALSE) :
     (cond_87)? ( `TRUE) :
-    (cond_240)? (    `FALSE) :
+    (cond_241)? (    `FALSE) :
     es_cache_valid;
 assign ntflag_to_reg =
     (cond_62)? ( `FALSE) :
@@ -725,8 +737,8 @@ assign ntflag_to_reg =
     (cond_87)? ( glob_param_3[14]) :
     (cond_89)? ( glob_param_3[14]) :
     (cond_93)? ( glob_param_5[14]) :
-    (cond_216)? ( result2[14]) :
-    (cond_240)? ( task_eflags[14] |  + (glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_CALL || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT)) :
+    (cond_217)? ( result2[14]) :
+    (cond_241)? ( task_eflags[14] |  + (glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_CALL || glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT)) :
     ntflag;
 assign cr0_pg_to_reg =
     (cond_113 && cond_114)? ( result2[31]) :
@@ -739,14 +751,14 @@ assign tflag_to_reg =
     (cond_87)? (  glob_param_3[8]) :
     (cond_89)? (  glob_param_3[8]) :
     (cond_93)? (  glob_param_5[8]) :
-    (cond_216)? (  result2[8]) :
-    (cond_240)? (  task_eflags[8]) :
+    (cond_217)? (  result2[8]) :
+    (cond_241)? (  task_eflags[8]) :
     tflag;
 assign cr0_ts_to_reg =
     (cond_110)? ( result2[3]) :
     (cond_113 && cond_114)? ( result2[3]) :
     (cond_146)? ( `FALSE) :
-    (cond_240)? ( `TRUE) :
+    (cond_241)? ( `TRUE) :
     cr0_ts;
 assign aflag_to_reg =
     (cond_0)? ( aflag_arith) :
@@ -768,11 +780,11 @@ assign aflag_to_reg =
     (cond_139)? ( aflag_arith) :
     (cond_142)? ( 1'b0) :
     (cond_145)? ( aflag_arith) :
-    (cond_216)? (  result2[4]) :
-    (cond_240)? (  task_eflags[4]) :
-    (cond_272)? ( result_signals[1]) :
+    (cond_217)? (  result2[4]) :
+    (cond_241)? (  task_eflags[4]) :
     (cond_273)? ( result_signals[1]) :
-    (cond_274 && ~cond_5)? ( aflag_arith) :
+    (cond_274)? ( result_signals[1]) :
+    (cond_275 && ~cond_5)? ( aflag_arith) :
     aflag;
 assign ecx_to_reg =
     (cond_32 && cond_33 && cond_34)? ( wr_ecx_final) :
@@ -782,13 +794,13 @@ assign ecx_to_reg =
     (cond_152 && cond_33 && cond_34)? ( wr_ecx_final) :
     (cond_164 && cond_165)? ( "letn") :
     (cond_164 && cond_166)? ( 32'd0) :
-    (cond_164 && cond_275)? ( 32'd0) :
-    (cond_192 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && cond_34)? ( wr_ecx_final) :
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[319:304] } : exe_buffer_shifted[335:304]) :
-    (cond_261 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
-    (cond_263 && cond_264)? ( { wr_operand_16bit? ecx[31:16] : exe_buffer_shifted[31:16],   exe_buffer_shifted[15:0] }) :
+    (cond_164 && cond_167)? ( 32'd0) :
+    (cond_193 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && cond_34)? ( wr_ecx_final) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 16'hFFFF, exe_buffer_shifted[319:304] } : exe_buffer_shifted[335:304]) :
+    (cond_262 && cond_33 && ~cond_9 && cond_34)? ( wr_ecx_final) :
+    (cond_264 && cond_265)? ( { wr_operand_16bit? ecx[31:16] : exe_buffer_shifted[31:16],   exe_buffer_shifted[15:0] }) :
     ecx;
 assign cr0_pe_to_reg =
     (cond_110)? ( cr0_pe | result2[0]) :
@@ -796,7 +808,7 @@ assign cr0_pe_to_reg =
     cr0_pe;
 assign ss_cache_valid_to_reg =
     (cond_87)? ( `TRUE) :
-    (cond_240)? (    `FALSE) :
+    (cond_241)? (    `FALSE) :
     ss_cache_valid;
 assign pflag_to_reg =
     (cond_0)? ( pflag_result) :
@@ -818,24 +830,24 @@ assign pflag_to_reg =
     (cond_139)? ( pflag_result) :
     (cond_142)? ( pflag_result) :
     (cond_145)? ( pflag_result) :
-    (cond_216)? (  result2[2]) :
-    (cond_240)? (  task_eflags[2]) :
-    (cond_272)? ( pflag_result) :
+    (cond_217)? (  result2[2]) :
+    (cond_241)? (  task_eflags[2]) :
     (cond_273)? ( pflag_result) :
-    (cond_274 && ~cond_5)? ( pflag_result) :
+    (cond_274)? ( pflag_result) :
+    (cond_275 && ~cond_5)? ( pflag_result) :
     pflag;
 assign dr6_breakpoints_to_reg =
-    (cond_266 && cond_268)? ( result2[3:0]) :
+    (cond_267 && cond_269)? ( result2[3:0]) :
     dr6_breakpoints;
 assign cs_rpl_to_reg =
     (cond_87)? ( 2'd3) :
-    (cond_240)? (         2'd3) :
-    (cond_244 && cond_245)? ( wr_task_rpl) :
+    (cond_241)? (         2'd3) :
+    (cond_245 && cond_246)? ( wr_task_rpl) :
     cs_rpl;
 assign es_to_reg =
     (cond_63 && cond_64)? (             16'd0) :
     (cond_87)? ( wr_IRET_to_v86_es) :
-    (cond_240)? (                task_es) :
+    (cond_241)? (                task_es) :
     es;
 assign cflag_to_reg =
     (cond_0)? ( cflag_arith) :
@@ -860,19 +872,19 @@ assign cflag_to_reg =
     (cond_139)? ( cflag_arith) :
     (cond_142)? ( wr_mult_overflow) :
     (cond_145)? ( cflag_arith) :
-    (cond_216)? (  result2[0]) :
-    (cond_240)? (  task_eflags[0]) :
-    (cond_272)? ( result_signals[1]) :
-    (cond_273)? ( result_signals[0]) :
-    (cond_274 && ~cond_5)? ( cflag_arith) :
+    (cond_217)? (  result2[0]) :
+    (cond_241)? (  task_eflags[0]) :
+    (cond_273)? ( result_signals[1]) :
+    (cond_274)? ( result_signals[0]) :
+    (cond_275 && ~cond_5)? ( cflag_arith) :
     cflag;
 assign idflag_to_reg =
     (cond_82 && cond_83)? ( glob_param_3[21]) :
     (cond_87)? ( glob_param_3[21]) :
     (cond_89 && cond_83)? ( glob_param_3[21]) :
     (cond_93 && cond_83)? ( glob_param_5[21]) :
-    (cond_216 && cond_83)? ( result2[21]) :
-    (cond_240)? ( task_eflags[21]) :
+    (cond_217 && cond_83)? ( result2[21]) :
+    (cond_241)? ( task_eflags[21]) :
     idflag;
 //======================================================== always
 always @(posedge clk) begin
@@ -891,30 +903,30 @@ assign wr_make_esp_commit =
     (cond_124 && cond_127)? (`TRUE) :
     (cond_131)? (`TRUE) :
     (cond_149)? (`TRUE) :
-    (cond_174 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_174 && ~cond_175)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_240)? (`TRUE) :
-    (cond_255)? (`TRUE) :
-    (cond_263 && cond_264)? (`TRUE) :
+    (cond_175 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_175 && ~cond_176)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_241)? (`TRUE) :
+    (cond_256)? (`TRUE) :
+    (cond_264 && cond_265)? (`TRUE) :
     1'd0;
 assign wr_glob_param_3_value =
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? glob_param_3 : glob_param_3 | 32'h00020000) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? glob_param_3 : glob_param_3 | 32'h00020000) :
     32'd0;
 assign wr_seg_sel =
     (cond_67)? ( glob_param_1[15:0]) :
     (cond_70 && cond_71)? (          glob_param_1[15:0]) :
-    (cond_174)? (          (wr_cmd == `CMD_CALL_2 || wr_cmd == `CMD_JMP || wr_cmd == `CMD_JMP_2 || wr_cmd == `CMD_int_2)? { glob_param_1[15:2], cpl } : glob_param_1[15:0]) :
-    (cond_177)? (          { glob_param_1[15:2], glob_descriptor[`DESC_BITS_DPL] }) :
-    (cond_179)? (          glob_param_1[15:0]) :
+    (cond_175)? (          (wr_cmd == `CMD_CALL_2 || wr_cmd == `CMD_JMP || wr_cmd == `CMD_JMP_2 || wr_cmd == `CMD_int_2)? { glob_param_1[15:2], cpl } : glob_param_1[15:0]) :
+    (cond_178)? (          { glob_param_1[15:2], glob_descriptor[`DESC_BITS_DPL] }) :
     (cond_180)? (          glob_param_1[15:0]) :
-    (cond_244 && cond_251)? ( glob_param_1[15:0]) :
+    (cond_181)? (          glob_param_1[15:0]) :
+    (cond_245 && cond_252)? ( glob_param_1[15:0]) :
     16'd0;
 assign wr_exception_finished =
     (cond_60)? (`TRUE) :
     (cond_62)? (`TRUE) :
     (cond_63)? (`TRUE) :
-    (cond_255)? (`TRUE) :
+    (cond_256)? (`TRUE) :
     1'd0;
 assign wr_seg_cache_mask =
     (cond_67 && cond_68)? ( `DESC_MASK_G | `DESC_MASK_D_B | `DESC_MASK_AVL | `DESC_MASK_LIMIT | `DESC_MASK_DPL | `DESC_MASK_TYPE) :
@@ -925,43 +937,44 @@ assign write_seg_cache =
     (cond_67 && cond_69)? (`TRUE) :
     (cond_70 && cond_71 && cond_72 && ~cond_9)? (`TRUE) :
     (cond_70 && cond_71 && cond_74)? (`TRUE) :
-    (cond_174 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_174 && ~cond_175)? (`TRUE) :
-    (cond_177 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_177 && ~cond_175)? (`TRUE) :
-    (cond_179 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_179 && ~cond_175)? (`TRUE) :
-    (cond_180 && cond_181 && ~cond_9)? (`TRUE) :
-    (cond_180 && ~cond_181)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9)? (`TRUE) :
-    (cond_244 && cond_251)? (`TRUE) :
+    (cond_175 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_175 && ~cond_176)? (`TRUE) :
+    (cond_178 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_178 && ~cond_176)? (`TRUE) :
+    (cond_180 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_180 && ~cond_176)? (`TRUE) :
+    (cond_181 && cond_182 && ~cond_9)? (`TRUE) :
+    (cond_181 && ~cond_182)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9)? (`TRUE) :
+    (cond_245 && cond_252)? (`TRUE) :
     1'd0;
 assign wr_seg_rpl =
     (cond_67 && cond_64)? (      2'd3) :
     (cond_67 && cond_68)? (      2'd0) :
     (cond_67 && cond_69)? ( glob_param_1[1:0]) :
     (cond_70 && cond_71)? (          glob_param_1[1:0]) :
-    (cond_174)? (          (wr_cmd == `CMD_CALL_2 || wr_cmd == `CMD_JMP || wr_cmd == `CMD_JMP_2 || wr_cmd == `CMD_int_2)? cpl : glob_param_1[1:0]) :
-    (cond_177)? (          glob_descriptor[`DESC_BITS_DPL]) :
-    (cond_179)? (          glob_param_1[1:0]) :
+    (cond_175)? (          (wr_cmd == `CMD_CALL_2 || wr_cmd == `CMD_JMP || wr_cmd == `CMD_JMP_2 || wr_cmd == `CMD_int_2)? cpl : glob_param_1[1:0]) :
+    (cond_178)? (          glob_descriptor[`DESC_BITS_DPL]) :
     (cond_180)? (          glob_param_1[1:0]) :
-    (cond_244 && cond_251 && cond_64)? (      2'd3) :
+    (cond_181)? (          glob_param_1[1:0]) :
+    (cond_245 && cond_252 && cond_64)? (      2'd3) :
     2'd0;
 assign wr_debug_trap_clear =
     (cond_57)? (`TRUE) :
-    (cond_225)? (`TRUE) :
+    (cond_226)? (`TRUE) :
     1'd0;
 assign write_length_word =
     (cond_23)? (`TRUE) :
     (cond_39)? (`TRUE) :
     (cond_109)? (`TRUE) :
-    (cond_258 && cond_259)? (`TRUE) :
+    (cond_259 && cond_260)? (`TRUE) :
+    (cond_276 && cond_277 && ~cond_278 && cond_279)? (`TRUE) :
     1'd0;
 assign wr_validate_seg_regs =
-    (cond_182)? (`TRUE) :
+    (cond_183)? (`TRUE) :
     1'd0;
 assign wr_glob_param_3_set =
-    (cond_240)? (`TRUE) :
+    (cond_241)? (`TRUE) :
     1'd0;
 assign wr_waiting =
     (cond_0 && cond_1)? (`TRUE) :
@@ -992,38 +1005,39 @@ assign wr_waiting =
     (cond_139 && cond_140)? (`TRUE) :
     (cond_156 && cond_1)? (`TRUE) :
     (cond_158 && cond_9)? (`TRUE) :
-    (cond_169 && cond_1)? (`TRUE) :
-    (cond_174 && cond_175 && cond_9)? (`TRUE) :
-    (cond_177 && cond_175 && cond_9)? (`TRUE) :
-    (cond_179 && cond_175 && cond_9)? (`TRUE) :
-    (cond_180 && cond_181 && cond_9)? (`TRUE) :
-    (cond_189 && cond_9)? (`TRUE) :
-    (cond_192 && cond_33 && cond_9)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && cond_9)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && cond_201)? (`TRUE) :
-    (cond_202 && cond_9)? (`TRUE) :
-    (cond_210 && cond_211 && cond_201)? (`TRUE) :
-    (cond_212 && cond_1)? (`TRUE) :
-    (cond_227 && cond_228 && cond_9)? (`TRUE) :
-    (cond_230 && cond_9)? (`TRUE) :
+    (cond_170 && cond_1)? (`TRUE) :
+    (cond_175 && cond_176 && cond_9)? (`TRUE) :
+    (cond_178 && cond_176 && cond_9)? (`TRUE) :
+    (cond_180 && cond_176 && cond_9)? (`TRUE) :
+    (cond_181 && cond_182 && cond_9)? (`TRUE) :
+    (cond_190 && cond_9)? (`TRUE) :
+    (cond_193 && cond_33 && cond_9)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && cond_9)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && cond_202)? (`TRUE) :
+    (cond_203 && cond_9)? (`TRUE) :
+    (cond_211 && cond_212 && cond_202)? (`TRUE) :
+    (cond_213 && cond_1)? (`TRUE) :
+    (cond_228 && cond_229 && cond_9)? (`TRUE) :
     (cond_231 && cond_9)? (`TRUE) :
-    (cond_232 && cond_233 && cond_9)? (`TRUE) :
-    (cond_234 && cond_235 && cond_9)? (`TRUE) :
-    (cond_238 && cond_239 && cond_9)? (`TRUE) :
-    (cond_244 && cond_246 && cond_9)? (`TRUE) :
-    (cond_253 && cond_254 && cond_9)? (`TRUE) :
-    (cond_258 && cond_9)? (`TRUE) :
-    (cond_261 && cond_33 && cond_9)? (`TRUE) :
+    (cond_232 && cond_9)? (`TRUE) :
+    (cond_233 && cond_234 && cond_9)? (`TRUE) :
+    (cond_235 && cond_236 && cond_9)? (`TRUE) :
+    (cond_239 && cond_240 && cond_9)? (`TRUE) :
+    (cond_245 && cond_247 && cond_9)? (`TRUE) :
+    (cond_254 && cond_255 && cond_9)? (`TRUE) :
+    (cond_259 && cond_9)? (`TRUE) :
+    (cond_262 && cond_33 && cond_9)? (`TRUE) :
+    (cond_276 && cond_277 && cond_9)? (`TRUE) :
     1'd0;
 assign wr_inhibit_interrupts_and_debug =
     (cond_44 && cond_45)? (`TRUE) :
     (cond_76 && cond_77)? (`TRUE) :
     1'd0;
 assign write_system_word =
-    (cond_230)? (  tr_cache[`DESC_BITS_TYPE] <= 4'd3) :
     (cond_231)? (  tr_cache[`DESC_BITS_TYPE] <= 4'd3) :
-    (cond_232 && cond_233)? (  tr_cache[`DESC_BITS_TYPE] <= 4'd3 || wr_cmdex > `CMDEX_task_switch_2_STEP_7) :
-    (cond_234 && cond_235)? (`TRUE) :
+    (cond_232)? (  tr_cache[`DESC_BITS_TYPE] <= 4'd3) :
+    (cond_233 && cond_234)? (  tr_cache[`DESC_BITS_TYPE] <= 4'd3 || wr_cmdex > `CMDEX_task_switch_2_STEP_7) :
+    (cond_235 && cond_236)? (`TRUE) :
     1'd0;
 assign wr_new_push_ss_fault_check =
     (cond_14)? (`TRUE) :
@@ -1033,9 +1047,9 @@ assign wr_new_push_ss_fault_check =
     (cond_55)? (`TRUE) :
     1'd0;
 assign write_system_dword =
-    (cond_230)? ( tr_cache[`DESC_BITS_TYPE] > 4'd3) :
     (cond_231)? ( tr_cache[`DESC_BITS_TYPE] > 4'd3) :
-    (cond_232 && cond_233)? ( tr_cache[`DESC_BITS_TYPE] > 4'd3  && wr_cmdex <= `CMDEX_task_switch_2_STEP_7) :
+    (cond_232)? ( tr_cache[`DESC_BITS_TYPE] > 4'd3) :
+    (cond_233 && cond_234)? ( tr_cache[`DESC_BITS_TYPE] > 4'd3  && wr_cmdex <= `CMDEX_task_switch_2_STEP_7) :
     1'd0;
 assign wr_req_reset_pr =
     (cond_4 && cond_5)? (`TRUE) :
@@ -1052,10 +1066,10 @@ assign wr_req_reset_pr =
     (cond_113)? (`TRUE) :
     (cond_143 && cond_5)? (`TRUE) :
     (cond_149)? (`TRUE) :
-    (cond_178)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_204)? (`TRUE) :
-    (cond_255)? (`TRUE) :
+    (cond_179)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_205)? (`TRUE) :
+    (cond_256)? (`TRUE) :
     1'd0;
 assign write_seg_sel =
     (cond_67 && cond_64)? (`TRUE) :
@@ -1063,36 +1077,36 @@ assign write_seg_sel =
     (cond_67 && cond_69)? (`TRUE) :
     (cond_70 && cond_71 && cond_72 && ~cond_9)? (`TRUE) :
     (cond_70 && cond_71 && cond_74)? (`TRUE) :
-    (cond_174 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_174 && ~cond_175)? (`TRUE) :
-    (cond_177 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_177 && ~cond_175)? (`TRUE) :
-    (cond_179 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_179 && ~cond_175)? (`TRUE) :
-    (cond_180 && cond_181 && ~cond_9)? (`TRUE) :
-    (cond_180 && ~cond_181)? (`TRUE) :
+    (cond_175 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_175 && ~cond_176)? (`TRUE) :
+    (cond_178 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_178 && ~cond_176)? (`TRUE) :
+    (cond_180 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_180 && ~cond_176)? (`TRUE) :
+    (cond_181 && cond_182 && ~cond_9)? (`TRUE) :
+    (cond_181 && ~cond_182)? (`TRUE) :
     1'd0;
 assign wr_glob_param_1_set =
-    (cond_240)? (`TRUE) :
-    (cond_242)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9 && cond_245)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9 && cond_247)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9 && cond_248)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9 && cond_249)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9 && cond_250)? (`TRUE) :
-    (cond_244 && cond_251 && cond_245)? (`TRUE) :
-    (cond_244 && cond_251 && cond_247)? (`TRUE) :
-    (cond_244 && cond_251 && cond_248)? (`TRUE) :
-    (cond_244 && cond_251 && cond_249)? (`TRUE) :
-    (cond_244 && cond_251 && cond_250)? (`TRUE) :
-    (cond_244 && cond_252 && cond_245)? (`TRUE) :
-    (cond_244 && cond_252 && cond_247)? (`TRUE) :
-    (cond_244 && cond_252 && cond_248)? (`TRUE) :
-    (cond_244 && cond_252 && cond_249)? (`TRUE) :
-    (cond_244 && cond_252 && cond_250)? (`TRUE) :
+    (cond_241)? (`TRUE) :
+    (cond_243)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9 && cond_246)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9 && cond_248)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9 && cond_249)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9 && cond_250)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9 && cond_251)? (`TRUE) :
+    (cond_245 && cond_252 && cond_246)? (`TRUE) :
+    (cond_245 && cond_252 && cond_248)? (`TRUE) :
+    (cond_245 && cond_252 && cond_249)? (`TRUE) :
+    (cond_245 && cond_252 && cond_250)? (`TRUE) :
+    (cond_245 && cond_252 && cond_251)? (`TRUE) :
+    (cond_245 && cond_253 && cond_246)? (`TRUE) :
+    (cond_245 && cond_253 && cond_248)? (`TRUE) :
+    (cond_245 && cond_253 && cond_249)? (`TRUE) :
+    (cond_245 && cond_253 && cond_250)? (`TRUE) :
+    (cond_245 && cond_253 && cond_251)? (`TRUE) :
     1'd0;
 assign wr_glob_param_4_set =
-    (cond_240)? (`TRUE) :
+    (cond_241)? (`TRUE) :
     1'd0;
 assign write_stack_virtual =
     (cond_8 && cond_10)? (`TRUE) :
@@ -1103,18 +1117,18 @@ assign write_stack_virtual =
     (cond_130 && cond_10)? (`TRUE) :
     (cond_132 && cond_10)? (`TRUE) :
     (cond_158 && cond_10)? (`TRUE) :
-    (cond_189 && cond_10)? (`TRUE) :
-    (cond_202 && cond_10)? (`TRUE) :
-    (cond_253 && cond_254 && cond_10)? (`TRUE) :
+    (cond_190 && cond_10)? (`TRUE) :
+    (cond_203 && cond_10)? (`TRUE) :
+    (cond_254 && cond_255 && cond_10)? (`TRUE) :
     1'd0;
 assign wr_exception_external_set =
     (cond_161)? (`TRUE) :
     1'd0;
 assign wr_system_linear =
-    (cond_230)? ( wr_task_switch_linear) :
     (cond_231)? ( wr_task_switch_linear) :
-    (cond_232 && cond_233)? ( wr_task_switch_linear) :
-    (cond_234 && cond_235)? ( glob_desc_base) :
+    (cond_232)? ( wr_task_switch_linear) :
+    (cond_233 && cond_234)? ( wr_task_switch_linear) :
+    (cond_235 && cond_236)? ( glob_desc_base) :
     32'd0;
 assign wr_int_soft_int_ib =
     (cond_159)? (`TRUE) :
@@ -1127,25 +1141,26 @@ assign wr_error_code =
     (cond_55)? ( (glob_param_1[`SELECTOR_BITS_RPL] != cpl)? `SELECTOR_FOR_CODE(glob_param_1) : 16'd0) :
     16'd0;
 assign write_string_es_virtual =
-    (cond_192 && cond_33 && cond_193)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33)? (`TRUE) :
-    (cond_261 && cond_33 && cond_193)? (`TRUE) :
+    (cond_193 && cond_33 && cond_194)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33)? (`TRUE) :
+    (cond_262 && cond_33 && cond_194)? (`TRUE) :
     1'd0;
 assign write_system_touch =
     (cond_70 && cond_71 && cond_72 && ~cond_73)? (`TRUE) :
-    (cond_174 && cond_175)? (`TRUE) :
-    (cond_177 && cond_175)? (`TRUE) :
-    (cond_179 && cond_175)? (`TRUE) :
-    (cond_180 && cond_181)? (`TRUE) :
-    (cond_244 && cond_246)? (`TRUE) :
+    (cond_175 && cond_176)? (`TRUE) :
+    (cond_178 && cond_176)? (`TRUE) :
+    (cond_180 && cond_176)? (`TRUE) :
+    (cond_181 && cond_182)? (`TRUE) :
+    (cond_245 && cond_247)? (`TRUE) :
     1'd0;
 assign write_virtual =
     (cond_23)? (   wr_dst_is_memory) :
     (cond_98)? (   wr_dst_is_memory) :
     (cond_109)? (   wr_dst_is_memory) :
     (cond_128)? (   wr_dst_is_memory) :
-    (cond_212)? (  wr_dst_is_memory) :
-    (cond_258)? (`TRUE) :
+    (cond_213)? (  wr_dst_is_memory) :
+    (cond_259)? (`TRUE) :
+    (cond_276 && cond_277)? (`TRUE) :
     1'd0;
 assign wr_not_finished =
     (cond_0)? (`TRUE) :
@@ -1204,13 +1219,12 @@ assign wr_not_finished =
     (cond_160)? (`TRUE) :
     (cond_161)? (`TRUE) :
     (cond_162 && cond_163)? (`TRUE) :
-    (cond_167 && ~cond_168)? (`TRUE) :
-    (cond_170)? (`TRUE) :
-    (cond_174)? (`TRUE) :
-    (cond_177)? (`TRUE) :
-    (cond_179)? (`TRUE) :
+    (cond_168 && ~cond_169)? (`TRUE) :
+    (cond_171)? (`TRUE) :
+    (cond_175)? (`TRUE) :
+    (cond_178)? (`TRUE) :
     (cond_180)? (`TRUE) :
-    (cond_183)? (`TRUE) :
+    (cond_181)? (`TRUE) :
     (cond_184)? (`TRUE) :
     (cond_185)? (`TRUE) :
     (cond_186)? (`TRUE) :
@@ -1219,38 +1233,40 @@ assign wr_not_finished =
     (cond_189)? (`TRUE) :
     (cond_190)? (`TRUE) :
     (cond_191)? (`TRUE) :
-    (cond_192 && cond_33 && ~cond_9 && ~cond_194 && cond_34)? (`TRUE) :
-    (cond_196 && cond_197)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && ~cond_198)? (`TRUE) :
-    (cond_199 && cond_200)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && ~cond_198)? (`TRUE) :
-    (cond_203)? (`TRUE) :
-    (cond_205)? (`TRUE) :
+    (cond_192)? (`TRUE) :
+    (cond_193 && cond_33 && ~cond_9 && ~cond_195 && cond_34)? (`TRUE) :
+    (cond_197 && cond_198)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && ~cond_199)? (`TRUE) :
+    (cond_200 && cond_201)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && ~cond_199)? (`TRUE) :
+    (cond_204)? (`TRUE) :
     (cond_206)? (`TRUE) :
     (cond_207)? (`TRUE) :
     (cond_208)? (`TRUE) :
     (cond_209)? (`TRUE) :
-    (cond_210 && ~cond_211)? (`TRUE) :
-    (cond_222)? (`TRUE) :
-    (cond_225)? (`TRUE) :
+    (cond_210)? (`TRUE) :
+    (cond_211 && ~cond_212)? (`TRUE) :
+    (cond_223)? (`TRUE) :
     (cond_226)? (`TRUE) :
     (cond_227)? (`TRUE) :
-    (cond_229)? (`TRUE) :
+    (cond_228)? (`TRUE) :
     (cond_230)? (`TRUE) :
     (cond_231)? (`TRUE) :
     (cond_232)? (`TRUE) :
-    (cond_234)? (`TRUE) :
-    (cond_236)? (`TRUE) :
+    (cond_233)? (`TRUE) :
+    (cond_235)? (`TRUE) :
     (cond_237)? (`TRUE) :
     (cond_238)? (`TRUE) :
-    (cond_240)? (`TRUE) :
-    (cond_242)? (`TRUE) :
-    (cond_244)? (`TRUE) :
-    (cond_253)? (`TRUE) :
-    (cond_258 && cond_259)? (`TRUE) :
-    (cond_261 && cond_33 && ~cond_9 && ~cond_194 && cond_34)? (`TRUE) :
-    (cond_263 && ~cond_264)? (`TRUE) :
-    (cond_266)? (`TRUE) :
+    (cond_239)? (`TRUE) :
+    (cond_241)? (`TRUE) :
+    (cond_243)? (`TRUE) :
+    (cond_245)? (`TRUE) :
+    (cond_254)? (`TRUE) :
+    (cond_259 && cond_260)? (`TRUE) :
+    (cond_262 && cond_33 && ~cond_9 && ~cond_195 && cond_34)? (`TRUE) :
+    (cond_264 && ~cond_265)? (`TRUE) :
+    (cond_267)? (`TRUE) :
+    (cond_276 && cond_281)? (`TRUE) :
     1'd0;
 assign wr_int_soft_int =
     (cond_159)? (`TRUE) :
@@ -1264,7 +1280,7 @@ assign wr_int =
     (cond_162 && cond_163)? (`TRUE) :
     1'd0;
 assign wr_debug_task_trigger =
-    (cond_255 && cond_256)? (`TRUE) :
+    (cond_256 && cond_257)? (`TRUE) :
     1'd0;
 assign wr_int_vector =
     (cond_159)? ( wr_decoder[15:8]) :
@@ -1276,10 +1292,10 @@ assign wr_string_in_progress =
     (cond_32 && cond_36)? (`TRUE) :
     (cond_107 && cond_36)? (`TRUE) :
     (cond_152 && cond_154)? (`TRUE) :
-    (cond_192 && cond_33 && ~cond_9 && ~cond_194 && cond_34)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && ~cond_198)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && ~cond_198)? (`TRUE) :
-    (cond_261 && cond_33 && ~cond_9 && ~cond_194 && cond_34)? (`TRUE) :
+    (cond_193 && cond_33 && ~cond_9 && ~cond_195 && cond_34)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && ~cond_199)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && ~cond_199)? (`TRUE) :
+    (cond_262 && cond_33 && ~cond_9 && ~cond_195 && cond_34)? (`TRUE) :
     1'd0;
 assign write_regrm =
     (cond_0)? (             wr_dst_is_rm) :
@@ -1305,13 +1321,13 @@ assign write_regrm =
     (cond_155)? (`TRUE) :
     (cond_156)? (             wr_dst_is_rm) :
     (cond_157)? (`TRUE) :
-    (cond_169)? (         wr_dst_is_rm) :
-    (cond_171 && cond_172)? (`TRUE) :
-    (cond_212)? (    wr_dst_is_reg || wr_dst_is_rm || wr_dst_is_implicit_reg) :
-    (cond_257)? (`TRUE) :
-    (cond_262)? (`TRUE) :
-    (cond_265)? (`TRUE) :
-    (cond_274 && ~cond_5)? (`TRUE) :
+    (cond_170)? (         wr_dst_is_rm) :
+    (cond_172 && cond_173)? (`TRUE) :
+    (cond_213)? (    wr_dst_is_reg || wr_dst_is_rm || wr_dst_is_implicit_reg) :
+    (cond_258)? (`TRUE) :
+    (cond_263)? (`TRUE) :
+    (cond_266)? (`TRUE) :
+    (cond_275 && ~cond_5)? (`TRUE) :
     1'd0;
 assign wr_req_reset_rd =
     (cond_4 && cond_5)? (`TRUE) :
@@ -1341,30 +1357,30 @@ assign wr_req_reset_rd =
     (cond_152 && cond_153)? (`TRUE) :
     (cond_162 && ~cond_163)? (`TRUE) :
     (cond_164)? (`TRUE) :
-    (cond_167 && cond_168)? (`TRUE) :
-    (cond_178)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_192 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_192 && cond_195)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && cond_198)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_195)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && cond_198)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_195)? (`TRUE) :
-    (cond_204)? (`TRUE) :
-    (cond_210 && cond_211 && ~cond_201)? (`TRUE) :
-    (cond_216)? (`TRUE) :
-    (cond_255)? (`TRUE) :
-    (cond_261 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_261 && cond_195)? (`TRUE) :
-    (cond_270)? (`TRUE) :
+    (cond_168 && cond_169)? (`TRUE) :
+    (cond_179)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_193 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_193 && cond_196)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && cond_199)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_196)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && cond_199)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_196)? (`TRUE) :
+    (cond_205)? (`TRUE) :
+    (cond_211 && cond_212 && ~cond_202)? (`TRUE) :
+    (cond_217)? (`TRUE) :
+    (cond_256)? (`TRUE) :
+    (cond_262 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_262 && cond_196)? (`TRUE) :
+    (cond_271)? (`TRUE) :
     1'd0;
 assign wr_string_gp_fault_check =
-    (cond_192)? (`TRUE) :
-    (cond_261)? (`TRUE) :
+    (cond_193)? (`TRUE) :
+    (cond_262)? (`TRUE) :
     1'd0;
 assign write_rmw_system_dword =
-    (cond_227 && cond_228)? (`TRUE) :
-    (cond_238 && cond_239)? (`TRUE) :
+    (cond_228 && cond_229)? (`TRUE) :
+    (cond_239 && cond_240)? (`TRUE) :
     1'd0;
 assign write_seg_cache_valid =
     (cond_67 && cond_64)? (`TRUE) :
@@ -1372,16 +1388,16 @@ assign write_seg_cache_valid =
     (cond_67 && cond_69)? (`TRUE) :
     (cond_70 && cond_71 && cond_72 && ~cond_9)? (`TRUE) :
     (cond_70 && cond_71 && cond_74)? (`TRUE) :
-    (cond_174 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_174 && ~cond_175)? (`TRUE) :
-    (cond_177 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_177 && ~cond_175)? (`TRUE) :
-    (cond_179 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_179 && ~cond_175)? (`TRUE) :
-    (cond_180 && cond_181 && ~cond_9)? (`TRUE) :
-    (cond_180 && ~cond_181)? (`TRUE) :
-    (cond_244 && cond_246 && ~cond_9)? (`TRUE) :
-    (cond_244 && cond_251)? (`TRUE) :
+    (cond_175 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_175 && ~cond_176)? (`TRUE) :
+    (cond_178 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_178 && ~cond_176)? (`TRUE) :
+    (cond_180 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_180 && ~cond_176)? (`TRUE) :
+    (cond_181 && cond_182 && ~cond_9)? (`TRUE) :
+    (cond_181 && ~cond_182)? (`TRUE) :
+    (cond_245 && cond_247 && ~cond_9)? (`TRUE) :
+    (cond_245 && cond_252)? (`TRUE) :
     1'd0;
 assign write_rmw_virtual =
     (cond_0)? (       wr_dst_is_memory) :
@@ -1394,19 +1410,21 @@ assign write_rmw_virtual =
     (cond_136 && cond_103)? (   wr_dst_is_memory) :
     (cond_139 && cond_141)? (  wr_dst_is_memory) :
     (cond_156)? (       wr_dst_is_memory) :
-    (cond_169)? (   wr_dst_is_memory) :
+    (cond_170)? (   wr_dst_is_memory) :
     1'd0;
 assign wr_glob_param_4_value =
-    (cond_240)? ( { task_fs, task_gs }) :
+    (cond_241)? ( { task_fs, task_gs }) :
     32'd0;
 assign write_length_dword =
-    (cond_258 && cond_260)? (`TRUE) :
+    (cond_259 && cond_261)? (`TRUE) :
+    (cond_276 && cond_277 && cond_278)? (`TRUE) :
+    (cond_276 && cond_277 && ~cond_278 && ~cond_279 && cond_280)? (`TRUE) :
     1'd0;
 assign tlbflushall_do =
     (cond_110 && cond_111)? (`TRUE) :
     (cond_113 && cond_114 && cond_115)? (`TRUE) :
     (cond_113 && cond_118)? (`TRUE) :
-    (cond_240 && cond_241)? (`TRUE) :
+    (cond_241 && cond_242)? (`TRUE) :
     1'd0;
 assign wr_push_length_word =
     (cond_18)? (  ~(glob_param_3[19])) :
@@ -1415,30 +1433,30 @@ assign wr_push_length_word =
     (cond_54)? (  ~(glob_param_3[19])) :
     (cond_55)? ( ~(glob_param_3[19])) :
     (cond_65)? (`TRUE) :
-    (cond_189)? (  ~(glob_param_1[19])) :
-    (cond_253)? (  ~(glob_param_3[17])) :
+    (cond_190)? (  ~(glob_param_1[19])) :
+    (cond_254)? (  ~(glob_param_3[17])) :
     1'd0;
 assign wr_system_dword =
-    (cond_227 && cond_228)? ( glob_param_2 & 32'hFFFFFDFF) :
-    (cond_230)? (  (glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT)? exc_eip : eip) :
-    (cond_231)? (  result_push & ((glob_descriptor[`DESC_BITS_TYPE] == `DESC_TSS_BUSY_286 || glob_descriptor[`DESC_BITS_TYPE] == `DESC_TSS_BUSY_386)? 32'hFFFFBFFF : 32'hFFFFFFFF)) :
-    (cond_232 && cond_233)? (  result2) :
-    (cond_234 && cond_235)? (  { 16'd0, tr }) :
-    (cond_238 && cond_239)? ( result2 | 32'h00000200) :
+    (cond_228 && cond_229)? ( glob_param_2 & 32'hFFFFFDFF) :
+    (cond_231)? (  (glob_param_1[`TASK_SWITCH_SOURCE_BITS] == `TASK_SWITCH_FROM_INT)? exc_eip : eip) :
+    (cond_232)? (  result_push & ((glob_descriptor[`DESC_BITS_TYPE] == `DESC_TSS_BUSY_286 || glob_descriptor[`DESC_BITS_TYPE] == `DESC_TSS_BUSY_386)? 32'hFFFFBFFF : 32'hFFFFFFFF)) :
+    (cond_233 && cond_234)? (  result2) :
+    (cond_235 && cond_236)? (  { 16'd0, tr }) :
+    (cond_239 && cond_240)? ( result2 | 32'h00000200) :
     32'd0;
 assign wr_seg_cache_valid =
     (cond_67 && cond_64)? (  `TRUE) :
     (cond_67 && cond_68)? (  `TRUE) :
     (cond_70 && cond_71)? (  `TRUE) :
-    (cond_174)? (  `TRUE) :
-    (cond_177)? (  `TRUE) :
-    (cond_179)? (  `TRUE) :
+    (cond_175)? (  `TRUE) :
+    (cond_178)? (  `TRUE) :
     (cond_180)? (  `TRUE) :
-    (cond_244 && cond_246 && ~cond_9)? (  `TRUE) :
-    (cond_244 && cond_251)? (  `TRUE) :
+    (cond_181)? (  `TRUE) :
+    (cond_245 && cond_247 && ~cond_9)? (  `TRUE) :
+    (cond_245 && cond_252)? (  `TRUE) :
     1'd0;
 assign wr_inhibit_interrupts =
-    (cond_220 && cond_221)? (`TRUE) :
+    (cond_221 && cond_222)? (`TRUE) :
     1'd0;
 assign write_seg_rpl =
     (cond_67 && cond_64)? (`TRUE) :
@@ -1446,15 +1464,15 @@ assign write_seg_rpl =
     (cond_67 && cond_69)? (`TRUE) :
     (cond_70 && cond_71 && cond_72 && ~cond_9)? (`TRUE) :
     (cond_70 && cond_71 && cond_74)? (`TRUE) :
-    (cond_174 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_174 && ~cond_175)? (`TRUE) :
-    (cond_177 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_177 && ~cond_175)? (`TRUE) :
-    (cond_179 && cond_175 && ~cond_9)? (`TRUE) :
-    (cond_179 && ~cond_175)? (`TRUE) :
-    (cond_180 && cond_181 && ~cond_9)? (`TRUE) :
-    (cond_180 && ~cond_181)? (`TRUE) :
-    (cond_244 && cond_251 && cond_64)? (`TRUE) :
+    (cond_175 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_175 && ~cond_176)? (`TRUE) :
+    (cond_178 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_178 && ~cond_176)? (`TRUE) :
+    (cond_180 && cond_176 && ~cond_9)? (`TRUE) :
+    (cond_180 && ~cond_176)? (`TRUE) :
+    (cond_181 && cond_182 && ~cond_9)? (`TRUE) :
+    (cond_181 && ~cond_182)? (`TRUE) :
+    (cond_245 && cond_252 && cond_64)? (`TRUE) :
     1'd0;
 assign wr_req_reset_dec =
     (cond_4 && cond_5)? (`TRUE) :
@@ -1471,10 +1489,10 @@ assign wr_req_reset_dec =
     (cond_113)? (`TRUE) :
     (cond_143 && cond_5)? (`TRUE) :
     (cond_149)? (`TRUE) :
-    (cond_178)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_204)? (`TRUE) :
-    (cond_255)? (`TRUE) :
+    (cond_179)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_205)? (`TRUE) :
+    (cond_256)? (`TRUE) :
     1'd0;
 assign wr_req_reset_exe =
     (cond_4 && cond_5)? (`TRUE) :
@@ -1504,30 +1522,30 @@ assign wr_req_reset_exe =
     (cond_152 && cond_153)? (`TRUE) :
     (cond_162 && ~cond_163)? (`TRUE) :
     (cond_164)? (`TRUE) :
-    (cond_167 && cond_168)? (`TRUE) :
-    (cond_178)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_192 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_192 && cond_195)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && cond_198)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_195)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && cond_198)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_195)? (`TRUE) :
-    (cond_204)? (`TRUE) :
-    (cond_210 && cond_211 && ~cond_201)? (`TRUE) :
-    (cond_216)? (`TRUE) :
-    (cond_255)? (`TRUE) :
-    (cond_261 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_261 && cond_195)? (`TRUE) :
-    (cond_270)? (`TRUE) :
+    (cond_168 && cond_169)? (`TRUE) :
+    (cond_179)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_193 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_193 && cond_196)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && cond_199)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_196)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && cond_199)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_196)? (`TRUE) :
+    (cond_205)? (`TRUE) :
+    (cond_211 && cond_212 && ~cond_202)? (`TRUE) :
+    (cond_217)? (`TRUE) :
+    (cond_256)? (`TRUE) :
+    (cond_262 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_262 && cond_196)? (`TRUE) :
+    (cond_271)? (`TRUE) :
     1'd0;
 assign wr_push_length_dword =
     (cond_18)? ( glob_param_3[19]) :
     (cond_19)? ( glob_param_3[19]) :
     (cond_54)? ( glob_param_3[19]) :
     (cond_55)? ( glob_param_3[19]) :
-    (cond_189)? ( glob_param_1[19]) :
-    (cond_253)? ( glob_param_3[17]) :
+    (cond_190)? ( glob_param_1[19]) :
+    (cond_254)? ( glob_param_3[17]) :
     1'd0;
 assign wr_one_cycle_wait =
     (cond_8)? (`TRUE) :
@@ -1543,24 +1561,24 @@ assign wr_one_cycle_wait =
     (cond_130)? (`TRUE) :
     (cond_132)? (`TRUE) :
     (cond_158)? (`TRUE) :
-    (cond_189)? (`TRUE) :
-    (cond_192 && cond_33)? (`TRUE) :
-    (cond_202)? (`TRUE) :
-    (cond_253 && cond_254)? (`TRUE) :
-    (cond_261 && cond_33)? (`TRUE) :
+    (cond_190)? (`TRUE) :
+    (cond_193 && cond_33)? (`TRUE) :
+    (cond_203)? (`TRUE) :
+    (cond_254 && cond_255)? (`TRUE) :
+    (cond_262 && cond_33)? (`TRUE) :
     1'd0;
 assign wr_regrm_dword =
     (cond_112)? (`TRUE) :
-    (cond_265)? (`TRUE) :
+    (cond_266)? (`TRUE) :
     1'd0;
 assign write_io =
-    (cond_199 && ~cond_200 && cond_33)? (`TRUE) :
-    (cond_210 && cond_211)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33)? (`TRUE) :
+    (cond_211 && cond_212)? (`TRUE) :
     1'd0;
 assign write_eax =
     (cond_139 && cond_141)? (          wr_dst_is_eax) :
-    (cond_212)? (      wr_dst_is_eax) :
-    (cond_271)? (`TRUE) :
+    (cond_213)? (      wr_dst_is_eax) :
+    (cond_272)? (`TRUE) :
     1'd0;
 assign write_new_stack_virtual =
     (cond_14 && cond_15)? (`TRUE) :
@@ -1597,22 +1615,22 @@ assign wr_req_reset_micro =
     (cond_152 && cond_153)? (`TRUE) :
     (cond_162 && ~cond_163)? (`TRUE) :
     (cond_164)? (`TRUE) :
-    (cond_167 && cond_168)? (`TRUE) :
-    (cond_178)? (`TRUE) :
-    (cond_182)? (`TRUE) :
-    (cond_192 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_192 && cond_195)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_33 && ~cond_9 && cond_198)? (`TRUE) :
-    (cond_196 && ~cond_197 && cond_195)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_33 && ~cond_201 && cond_198)? (`TRUE) :
-    (cond_199 && ~cond_200 && cond_195)? (`TRUE) :
-    (cond_204)? (`TRUE) :
-    (cond_210 && cond_211 && ~cond_201)? (`TRUE) :
-    (cond_216)? (`TRUE) :
-    (cond_255)? (`TRUE) :
-    (cond_261 && cond_33 && ~cond_9 && cond_194)? (`TRUE) :
-    (cond_261 && cond_195)? (`TRUE) :
-    (cond_270)? (`TRUE) :
+    (cond_168 && cond_169)? (`TRUE) :
+    (cond_179)? (`TRUE) :
+    (cond_183)? (`TRUE) :
+    (cond_193 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_193 && cond_196)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_33 && ~cond_9 && cond_199)? (`TRUE) :
+    (cond_197 && ~cond_198 && cond_196)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_33 && ~cond_202 && cond_199)? (`TRUE) :
+    (cond_200 && ~cond_201 && cond_196)? (`TRUE) :
+    (cond_205)? (`TRUE) :
+    (cond_211 && cond_212 && ~cond_202)? (`TRUE) :
+    (cond_217)? (`TRUE) :
+    (cond_256)? (`TRUE) :
+    (cond_262 && cond_33 && ~cond_9 && cond_195)? (`TRUE) :
+    (cond_262 && cond_196)? (`TRUE) :
+    (cond_271)? (`TRUE) :
     1'd0;
 assign wr_make_esp_speculative =
     (cond_7)? (`TRUE) :
@@ -1624,12 +1642,15 @@ assign wr_make_esp_speculative =
     (cond_124 && cond_125)? (`TRUE) :
     (cond_130)? (`TRUE) :
     (cond_147)? (`TRUE) :
-    (cond_253 && cond_254)? (`TRUE) :
-    (cond_263 && cond_125)? (`TRUE) :
+    (cond_254 && cond_255)? (`TRUE) :
+    (cond_264 && cond_125)? (`TRUE) :
     1'd0;
 assign write_system_busy_tss =
     (cond_70 && cond_71 && cond_72 && cond_73)? (`TRUE) :
     1'd0;
+assign wr_fpu_commit =
+    (cond_276 && ~cond_281 && cond_282)? (`TRUE) :
+    1'd0;
 assign wr_hlt_in_progress =
     (cond_31)? (`TRUE) :
     1'd0;
@@ -1637,23 +1658,23 @@ assign wr_regrm_word =
     (cond_39)? (`TRUE) :
     1'd0;
 assign wr_glob_param_1_value =
-    (cond_240)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 13'd0, `SEGMENT_LDT, exe_buffer_shifted[47:32] } : { 13'd0, `SEGMENT_LDT, exe_buffer_shifted[15:0] }) :
-    (cond_242)? ( { 13'd0, `SEGMENT_SS, task_ss }) :
-    (cond_244 && cond_246 && ~cond_9 && cond_245)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
-    (cond_244 && cond_246 && ~cond_9 && cond_247)? ( { 13'd0, `SEGMENT_ES, task_es }) :
-    (cond_244 && cond_246 && ~cond_9 && cond_248)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
-    (cond_244 && cond_246 && ~cond_9 && cond_249)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
-    (cond_244 && cond_246 && ~cond_9 && cond_250)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
-    (cond_244 && cond_251 && cond_245)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
-    (cond_244 && cond_251 && cond_247)? ( { 13'd0, `SEGMENT_ES, task_es }) :
-    (cond_244 && cond_251 && cond_248)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
-    (cond_244 && cond_251 && cond_249)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
-    (cond_244 && cond_251 && cond_250)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
-    (cond_244 && cond_252 && cond_245)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
-    (cond_244 && cond_252 && cond_247)? ( { 13'd0, `SEGMENT_ES, task_es }) :
-    (cond_244 && cond_252 && cond_248)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
-    (cond_244 && cond_252 && cond_249)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
-    (cond_244 && cond_252 && cond_250)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
+    (cond_241)? ( (glob_descriptor[`DESC_BITS_TYPE] <= 4'd3)? { 13'd0, `SEGMENT_LDT, exe_buffer_shifted[47:32] } : { 13'd0, `SEGMENT_LDT, exe_buffer_shifted[15:0] }) :
+    (cond_243)? ( { 13'd0, `SEGMENT_SS, task_ss }) :
+    (cond_245 && cond_247 && ~cond_9 && cond_246)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
+    (cond_245 && cond_247 && ~cond_9 && cond_248)? ( { 13'd0, `SEGMENT_ES, task_es }) :
+    (cond_245 && cond_247 && ~cond_9 && cond_249)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
+    (cond_245 && cond_247 && ~cond_9 && cond_250)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
+    (cond_245 && cond_247 && ~cond_9 && cond_251)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
+    (cond_245 && cond_252 && cond_246)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
+    (cond_245 && cond_252 && cond_248)? ( { 13'd0, `SEGMENT_ES, task_es }) :
+    (cond_245 && cond_252 && cond_249)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
+    (cond_245 && cond_252 && cond_250)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
+    (cond_245 && cond_252 && cond_251)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
+    (cond_245 && cond_253 && cond_246)? ( { 13'd0, `SEGMENT_DS, task_ds }) :
+    (cond_245 && cond_253 && cond_248)? ( { 13'd0, `SEGMENT_ES, task_es }) :
+    (cond_245 && cond_253 && cond_249)? ( { 13'd0, `SEGMENT_FS, glob_param_4[31:16] }) :
+    (cond_245 && cond_253 && cond_250)? ( { 13'd0, `SEGMENT_GS, glob_param_4[15:0] }) :
+    (cond_245 && cond_253 && cond_251)? ( { 13'd0, `SEGMENT_CS, task_cs }) :
     32'd0;
 assign wr_push_ss_fault_check =
     (cond_8)? (`TRUE) :
@@ -1664,7 +1685,7 @@ assign wr_push_ss_fault_check =
     (cond_130)? (`TRUE) :
     (cond_132)? (`TRUE) :
     (cond_158)? (`TRUE) :
-    (cond_189)? (`TRUE) :
-    (cond_202)? (`TRUE) :
-    (cond_253 && cond_254)? (`TRUE) :
+    (cond_190)? (`TRUE) :
+    (cond_203)? (`TRUE) :
+    (cond_254 && cond_255)? (`TRUE) :
     1'd0;
@@ -48,6 +48,8 @@
 `define EXCEPTION_SS        8'd12
 `define EXCEPTION_GP        8'd13
 `define EXCEPTION_PF        8'd14
+//floating point error
+`define EXCEPTION_MF        8'd16
 `define EXCEPTION_AC        8'd17
 `define EXCEPTION_MC        8'd18
 
@@ -69,6 +71,12 @@
 
 `define CPUID_MODEL_FAMILY_STEPPING     32'h0000045B
 
+`ifdef AO486_FPU
+`define CPUID_FEATURES                  32'h00000001
+`else
+`define CPUID_FEATURES                  32'h00000000
+`endif
+
 `define MC_PARAM_1_FLAG_NO_WRITE                13'd1
 `define MC_PARAM_1_FLAG_NO_WRITE_BIT            19
 // no write and cpl from param 3
@@ -162,6 +170,28 @@
 
 //------------------------------------------------------------------------------
 
+`define FPU_PRECISION_SINGLE    2'd0
+`define FPU_PRECISION_DOUBLE    2'd2
+
+`define FPU_RC_NEAREST          2'd0
+`define FPU_RC_DOWN             2'd1
+`define FPU_RC_UP               2'd2
+`define FPU_RC_CHOP             2'd3
+
+`define FPU_RANGE_EXTENDED      2'd0
+`define FPU_RANGE_DOUBLE        2'd1
+`define FPU_RANGE_SINGLE        2'd2
+`define FPU_RANGE_INTEGER       2'd3
+
+`define FPU_ARITH_ADD           3'd0
+`define FPU_ARITH_MUL           3'd1
+`define FPU_ARITH_DIV           3'd2
+`define FPU_ARITH_SQRT          3'd3
+`define FPU_ARITH_REM           3'd4
+`define FPU_ARITH_REM1          3'd5
+
+//------------------------------------------------------------------------------
+
 `include "startup_default.v"
 
 //------------------------------------------------------------------------------
@@ -49,6 +49,7 @@ module exception(
     input               exe_trigger_ss_fault,
     input               exe_trigger_np_fault,
     input               exe_trigger_nm_fault,
+    input               exe_trigger_mf_fault,
     input               exe_trigger_db_fault,
     input               exe_trigger_pf_fault,
     input               exe_bound_fault,
@@ -211,7 +212,7 @@ assign active_rd  = (rd_seg_gp_fault || rd_descriptor_gp_fault || rd_seg_ss_faul
                      rd_ss_esp_from_tss_fault || read_ac_fault || read_page_fault) &&
                     rd_is_front  && ~(exc_init);
 assign active_exe = (exe_div_exception || exe_trigger_gp_fault || exe_trigger_ts_fault || exe_trigger_ss_fault ||
-                     exe_trigger_np_fault || exe_trigger_nm_fault || exe_trigger_db_fault || exe_trigger_pf_fault ||
+                     exe_trigger_np_fault || exe_trigger_nm_fault || exe_trigger_mf_fault || exe_trigger_db_fault || exe_trigger_pf_fault ||
                      exe_bound_fault || exe_load_seg_gp_fault || exe_load_seg_ss_fault || exe_load_seg_np_fault) &&
                     exe_is_front && ~(exc_init);
 assign active_wr  = (wr_new_push_ss_fault || wr_string_es_fault || wr_push_ss_fault || write_ac_fault ||
@@ -242,6 +243,7 @@ always @(posedge clk) begin
     else if(active_exe && exe_trigger_ss_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_SS };
     else if(active_exe && exe_trigger_np_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_NP };
     else if(active_exe && exe_trigger_nm_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_NM };
+    else if(active_exe && exe_trigger_mf_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_MF };
     else if(active_exe && exe_trigger_db_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_DB };
     else if(active_exe && exe_trigger_pf_fault)     exc_vector_full <= { 1'b1, `EXCEPTION_PF };
     else if(active_exe && exe_bound_fault)          exc_vector_full <= { 1'b1, `EXCEPTION_BR };
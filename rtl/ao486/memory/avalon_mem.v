@@ -59,6 +59,14 @@ module avalon_mem(
     output      [31:0]  readcode_partial,
     //END
     
+    //RESP:
+    input               readline_do,
+    output              readline_done,
+    
+    input       [31:0]  readline_address,
+    output      [31:0]  readline_partial,
+    //END
+    
     output      [27:2]  snoop_addr,
     output      [31:0]  snoop_data,
     output       [3:0]  snoop_be,
@@ -82,7 +90,8 @@ module avalon_mem(
     input               dma_read,
     output      [15:0]  dma_readdata,
     output              dma_readdatavalid,
-    output              dma_waitrequest
+    output              dma_waitrequest,
+    input               dma_hold
 );
 
 //------------------------------------------------------------------------------
@@ -106,6 +115,7 @@ localparam [2:0] STATE_READ      = 3'd2;
 localparam [2:0] STATE_READ_CODE = 3'd3;
 localparam [2:0] STATE_WRITE_DMA = 3'd4;
 localparam [2:0] STATE_READ_DMA  = 3'd5;
+localparam [2:0] STATE_READ_LINE = 3'd6;
 
 //------------------------------------------------------------------------------
 wire    [1:0]   readburst_dword_length;
@@ -145,6 +155,7 @@ wire [3:0] read_burst_byteenable = len_be[readburst_address[1:0] +:4];
 
 assign readburst_data = {avm_readdata, ~&save_readburst ? avm_readdata : bus_0, ~save_readburst[1] ? avm_readdata : bus_1};
 assign readcode_partial = avm_readdata;
+assign readline_partial = avm_readdata;
 
 //------------------------------------------------------------------------------
 
@@ -194,11 +205,13 @@ assign dma_readdatavalid = state == STATE_READ_DMA  && avm_readdatavalid;
 assign writeburst_done   = state == STATE_IDLE      && writeburst_do && ~avm_waitrequest;
 assign readburst_done    = state == STATE_READ      && counter == 3'd0 && avm_readdatavalid;
 assign readcode_done     = state == STATE_READ_CODE && avm_readdatavalid;
+assign readline_done     = state == STATE_READ_LINE && avm_readdatavalid;
 
 assign avm_address = 
    (state != STATE_IDLE) ? writeaddr_next :
    writeburst_do         ? writeburst_address[31:2] :
    readburst_do          ? readburst_address[31:2] :
+   readline_do           ? readline_address[31:2] :
    readcode_do           ? readcode_address[31:2] :
                            dma_address[23:2];
 
@@ -212,17 +225,19 @@ assign avm_byteenable =
    (state != STATE_IDLE)         ? byteenable_next :
    writeburst_do                 ? writeburst_byteenable_0 : 
    (readburst_do || readcode_do) ? read_burst_byteenable : 
+   readline_do                   ? 4'b1111 :
    dma_16bit                     ? {dma_address[1],dma_address[1],~dma_address[1],~dma_address[1]} :
                                    (4'b0001 << dma_address[1:0]);
 
 assign avm_burstcount = 
    readburst_do ? { 2'b0, readburst_dword_length }  :
+   readline_do  ? 4'd8 :
    readcode_do  ? 4'd8 :
                   4'd1;
 
-wire dma_start = ~(writeburst_do | readburst_do | readcode_do);
+wire dma_start = ~(writeburst_do | readburst_do | readline_do | readcode_do | dma_hold);
 assign avm_write = rst_n && ((state == STATE_IDLE && (writeburst_do || (dma_write && dma_start))) || state == STATE_WRITE);
-assign avm_read  = rst_n && state == STATE_IDLE && ~writeburst_do && (readburst_do || readcode_do || dma_read);
+assign avm_read  = rst_n && state == STATE_IDLE && ~writeburst_do && (readburst_do || readline_do || readcode_do || (dma_read && dma_start));
 
 assign snoop_addr = avm_address[27:2];
 assign snoop_data = avm_writedata;
@@ -257,14 +272,18 @@ always @(posedge clk) begin
                   counter        <= readburst_dword_length - 3'd1;
                   save_readburst <= readburst_dword_length;
                end
+               else if (readline_do) begin
+                  state   <= STATE_READ_LINE;
+                  counter <= 3'd7;
+               end
                else if (readcode_do) begin
                   state   <= STATE_READ_CODE;
                   counter <= 3'd7;
                end
-               else if (dma_write) begin
+               else if (dma_write && ~dma_hold) begin
                   state <= STATE_WRITE_DMA;
                end
-               else if (dma_read) begin
+               else if (dma_read && ~dma_hold) begin
                   state <= STATE_READ_DMA;
                end
             end
@@ -285,7 +304,7 @@ always @(posedge clk) begin
             end
          end
 
-		STATE_READ_CODE:
+		STATE_READ_CODE, STATE_READ_LINE:
          if (avm_readdatavalid) begin
             counter <= counter - 3'd1;     
             if(counter == 3'd0) state <= STATE_IDLE;
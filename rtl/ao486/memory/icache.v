@@ -26,7 +26,14 @@
 
 `include "defines.v"
 
-module icache(
+module icache
+#(
+    parameter LINES         = 128,
+    parameter LINESIZE      = 8,
+    parameter ASSOCIATIVITY = 4,
+    parameter PREFETCH      = 0
+)
+(
     input           clk,
     input           rst_n,
     
@@ -123,6 +130,30 @@ end
 
 //------------------------------------------------------------------------------
 
+// synthesis translate_off
+// simulation counters, read by the Verilator system harness
+reg [63:0] perf_reads        /*verilator public_flat_rd*/; // prefetch reads started
+reg [63:0] perf_read_cycles  /*verilator public_flat_rd*/; // cycles with a prefetch read in flight
+reg [63:0] perf_snoop_resets /*verilator public_flat_rd*/; // prefetch restarts after a write near eip
+
+wire perf_snoop_reset = prefetch_checknext && prefetch_checkaddr >= min_check && prefetch_checkaddr <= max_check;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0) begin
+        perf_reads        <= 64'd0;
+        perf_read_cycles  <= 64'd0;
+        perf_snoop_resets <= 64'd0;
+    end
+    else begin
+        if(readcode_cache_do)       perf_reads        <= perf_reads + 64'd1;
+        if(state == STATE_READ)     perf_read_cycles  <= perf_read_cycles + 64'd1;
+        if(perf_snoop_reset)        perf_snoop_resets <= perf_snoop_resets + 64'd1;
+    end
+end
+// synthesis translate_on
+
+//------------------------------------------------------------------------------
+
 //MIN(partial_length, length_saved)
 assign partial_length_current =
     ({ 2'b0, partial_length[2:0] } > length)? length : { 2'b0, partial_length[2:0] };
@@ -151,7 +182,13 @@ assign prefetchfifo_write_data =
 
 //------------------------------------------------------------------------------
 
-l1_icache l1_icache_inst(
+l1_icache #(
+    .LINES           (LINES),
+    .LINESIZE        (LINESIZE),
+    .ASSOCIATIVITY   (ASSOCIATIVITY),
+    .PREFETCH        (PREFETCH)
+)
+l1_icache_inst(
    
     .CLK             (clk),
     .RESET           (~rst_n),
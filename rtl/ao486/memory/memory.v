@@ -26,7 +26,18 @@
 
 `include "defines.v"
 
-module memory(
+module memory
+#(
+    parameter ICACHE_LINES         = 128,
+    parameter ICACHE_LINESIZE      = 8,
+    parameter ICACHE_ASSOCIATIVITY = 4,
+    parameter ICACHE_PREFETCH      = 0,
+    parameter DCACHE               = 0,   // 0: the dcache links go straight to avalon_mem; 1: through rtl/cache/l1_dcache.v
+    parameter DCACHE_LINES         = 128,
+    parameter DCACHE_ASSOCIATIVITY = 4,
+    parameter DCACHE_WRITEBACK     = 0
+)
+(
     input               clk,
     input               rst_n,
     
@@ -333,27 +344,131 @@ wire            snoop_we;
 
 //------------------------------------------------------------------------------
 
+wire            dcache_readburst_do;
+wire            dcache_readburst_done;
+wire [31:0]     dcache_readburst_address;
+wire [3:0]      dcache_readburst_length;
+wire [95:0]     dcache_readburst_data;
+
+wire            dcache_readline_do;
+wire            dcache_readline_done;
+wire [31:0]     dcache_readline_address;
+wire [31:0]     dcache_readline_partial;
+
+wire            dcache_writeburst_do;
+wire            dcache_writeburst_done;
+wire [31:0]     dcache_writeburst_address;
+wire [2:0]      dcache_writeburst_length;
+wire [31:0]     dcache_writeburst_data;
+
+wire            dma_hold;
+
+generate
+    if (DCACHE != 0) begin : gdcache
+        l1_dcache #(
+            .LINES          (DCACHE_LINES),
+            .ASSOCIATIVITY  (DCACHE_ASSOCIATIVITY),
+            .WRITEBACK      (DCACHE_WRITEBACK)
+        )
+        l1_dcache_inst(
+            .CLK                        (clk),
+            .RESET                      (~rst_n),
+        
+            .DISABLE                    (cache_disable),
+        
+            .CPU_RD_REQ                 (resp_dcacheread_do),               //input
+            .CPU_RD_DONE                (resp_dcacheread_done),             //output
+            .CPU_RD_ADDR                (resp_dcacheread_address),          //input [31:0]
+            .CPU_RD_LENGTH              (resp_dcacheread_length),           //input [3:0]
+            .CPU_RD_CACHE_DISABLE       (resp_dcacheread_cache_disable),    //input
+            .CPU_RD_DATA                (resp_dcacheread_data),             //output [63:0]
+        
+            .CPU_WR_REQ                 (resp_dcachewrite_do),              //input
+            .CPU_WR_DONE                (resp_dcachewrite_done),            //output
+            .CPU_WR_ADDR                (resp_dcachewrite_address),         //input [31:0]
+            .CPU_WR_LENGTH              (resp_dcachewrite_length),          //input [2:0]
+            .CPU_WR_CACHE_DISABLE       (resp_dcachewrite_cache_disable),   //input
+            .CPU_WR_WRITE_THROUGH       (resp_dcachewrite_write_through),   //input
+            .CPU_WR_DATA                (resp_dcachewrite_data),            //input [31:0]
+        
+            .INV_REQ                    (invddata_do || wbinvddata_do),     //input
+            .INV_DONE                   (invddata_done),                    //output
+        
+            .MEM_RD_REQ                 (dcache_readburst_do),              //output
+            .MEM_RD_DONE                (dcache_readburst_done),            //input
+            .MEM_RD_ADDR                (dcache_readburst_address),         //output [31:0]
+            .MEM_RD_LENGTH              (dcache_readburst_length),          //output [3:0]
+            .MEM_RD_DATA                (dcache_readburst_data[63:0]),      //input [63:0]
+        
+            .MEM_LINE_REQ               (dcache_readline_do),               //output
+            .MEM_LINE_ADDR              (dcache_readline_address),          //output [31:0]
+            .MEM_LINE_DONE              (dcache_readline_done),             //input
+            .MEM_LINE_DATA              (dcache_readline_partial),          //input [31:0]
+        
+            .MEM_WR_REQ                 (dcache_writeburst_do),             //output
+            .MEM_WR_DONE                (dcache_writeburst_done),           //input
+            .MEM_WR_ADDR                (dcache_writeburst_address),        //output [31:0]
+            .MEM_WR_LENGTH              (dcache_writeburst_length),         //output [2:0]
+            .MEM_WR_DATA                (dcache_writeburst_data),           //output [31:0]
+        
+            .snoop_addr                 (snoop_addr),
+            .snoop_data                 (snoop_data),
+            .snoop_be                   (snoop_be),
+            .snoop_we                   (snoop_we),
+        
+            .dma_addr                   (dma_address[23:2]),
+            .dma_rd                     (dma_read),
+            .dma_hold                   (dma_hold)
+        );
+        
+        assign wbinvddata_done = invddata_done;
+    end
+    else begin : gnodcache
+        assign dcache_readburst_do       = resp_dcacheread_do;
+        assign resp_dcacheread_done      = dcache_readburst_done;
+        assign dcache_readburst_address  = resp_dcacheread_address;
+        assign dcache_readburst_length   = resp_dcacheread_length;
+        assign resp_dcacheread_data      = dcache_readburst_data[63:0];
+        
+        assign dcache_readline_do        = 1'b0;
+        assign dcache_readline_address   = 32'd0;
+        
+        assign dcache_writeburst_do      = resp_dcachewrite_do;
+        assign resp_dcachewrite_done     = dcache_writeburst_done;
+        assign dcache_writeburst_address = resp_dcachewrite_address;
+        assign dcache_writeburst_length  = resp_dcachewrite_length;
+        assign dcache_writeburst_data    = resp_dcachewrite_data;
+        
+        assign dma_hold                  = 1'b0;
+        
+        assign invddata_done             = 1'b1;
+        assign wbinvddata_done           = 1'b1;
+    end
+endgenerate
+
+//------------------------------------------------------------------------------
+
 avalon_mem avalon_mem_inst(
     // global
     .clk                        (clk),
     .rst_n                      (rst_n),
     
     //RESP:
-    .writeburst_do              (resp_dcachewrite_do),          //input
-    .writeburst_done            (resp_dcachewrite_done),        //output
+    .writeburst_do              (dcache_writeburst_do),         //input
+    .writeburst_done            (dcache_writeburst_done),       //output
     
-    .writeburst_address         (resp_dcachewrite_address),     //input [31:0]
-    .writeburst_length          (resp_dcachewrite_length),      //input [2:0]
-    .writeburst_data_in         (resp_dcachewrite_data),        //input [31:0]
+    .writeburst_address         (dcache_writeburst_address),    //input [31:0]
+    .writeburst_length          (dcache_writeburst_length),     //input [2:0]
+    .writeburst_data_in         (dcache_writeburst_data),       //input [31:0]
     //END
     
     //RESP:
-    .readburst_do               (resp_dcacheread_do),           //input
-    .readburst_done             (resp_dcacheread_done),         //output
+    .readburst_do               (dcache_readburst_do),          //input
+    .readburst_done             (dcache_readburst_done),        //output
     
-    .readburst_address          (resp_dcacheread_address),      //input  [31:0]
-    .readburst_length           (resp_dcacheread_length),       //input  [3:0]
-    .readburst_data_out         (resp_dcacheread_data),         //output [63:0]
+    .readburst_address          (dcache_readburst_address),     //input  [31:0]
+    .readburst_length           (dcache_readburst_length),      //input  [3:0]
+    .readburst_data_out         (dcache_readburst_data),        //output [95:0]
     //END
 
     //RESP:
@@ -364,6 +479,14 @@ avalon_mem avalon_mem_inst(
     .readcode_partial           (req_readcode_partial),        //output [31:0]
     //END
     
+    //RESP:
+    .readline_do                (dcache_readline_do),           //input
+    .readline_done              (dcache_readline_done),         //output
+    
+    .readline_address           (dcache_readline_address),      //input [31:0]
+    .readline_partial           (dcache_readline_partial),      //output [31:0]
+    //END
+    
     .snoop_addr                 (snoop_addr),
     .snoop_data                 (snoop_data),
     .snoop_be                   (snoop_be),  
@@ -387,16 +510,18 @@ avalon_mem avalon_mem_inst(
     .dma_read                   (dma_read),
     .dma_readdata               (dma_readdata),
     .dma_readdatavalid          (dma_readdatavalid),
-    .dma_waitrequest            (dma_waitrequest)
+    .dma_waitrequest            (dma_waitrequest),
+    .dma_hold                   (dma_hold)
 );
 
 //------------------------------------------------------------------------------
-
-assign invddata_done = 1'b1;
-assign wbinvddata_done = 1'b1;
-
-//------------------------------------------------------------------------------
-icache icache_inst(
+icache #(
+    .LINES                      (ICACHE_LINES),
+    .LINESIZE                   (ICACHE_LINESIZE),
+    .ASSOCIATIVITY              (ICACHE_ASSOCIATIVITY),
+    .PREFETCH                   (ICACHE_PREFETCH)
+)
+icache_inst(
     .clk                        (clk),
     .rst_n                      (rst_n),
                                 
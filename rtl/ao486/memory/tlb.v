@@ -402,6 +402,47 @@ wire _unused_ok = &{ 1'b0, cr3[11:5], cr3[2:0], tlbread_lock, tlbwrite_lock, tlb
 
 //------------------------------------------------------------------------------
 
+// synthesis translate_off
+// simulation counters, read by the Verilator system harness; lookups only count with paging on
+reg [63:0] perf_code_lookups /*verilator public_flat_rd*/;
+reg [63:0] perf_code_misses  /*verilator public_flat_rd*/;
+reg [63:0] perf_data_lookups /*verilator public_flat_rd*/;
+reg [63:0] perf_data_misses  /*verilator public_flat_rd*/;
+reg [63:0] perf_walk_cycles  /*verilator public_flat_rd*/; // cycles loading and updating pde/pte
+reg [63:0] perf_flushes      /*verilator public_flat_rd*/; // single and full flushes
+
+reg [4:0] perf_state_last;
+
+wire perf_enter   = state != perf_state_last;
+wire perf_lookup  = perf_enter && cr0_pg && (state == STATE_CODE_CHECK || state == STATE_CHECK_CHECK || state == STATE_WRITE_CHECK || state == STATE_READ_CHECK);
+wire perf_walk    = state == STATE_LOAD_PDE || state == STATE_LOAD_PTE_START || state == STATE_LOAD_PTE || state == STATE_LOAD_PTE_END ||
+                    state == STATE_SAVE_PDE || state == STATE_SAVE_PTE_START || state == STATE_SAVE_PTE;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0) begin
+        perf_state_last   <= STATE_IDLE;
+        perf_code_lookups <= 64'd0;
+        perf_code_misses  <= 64'd0;
+        perf_data_lookups <= 64'd0;
+        perf_data_misses  <= 64'd0;
+        perf_walk_cycles  <= 64'd0;
+        perf_flushes      <= 64'd0;
+    end
+    else begin
+        perf_state_last <= state;
+        
+        if(perf_lookup && state == STATE_CODE_CHECK)                            perf_code_lookups <= perf_code_lookups + 64'd1;
+        if(perf_lookup && state != STATE_CODE_CHECK)                            perf_data_lookups <= perf_data_lookups + 64'd1;
+        if(perf_enter && state == STATE_LOAD_PDE && current_type == TYPE_CODE)  perf_code_misses  <= perf_code_misses + 64'd1;
+        if(perf_enter && state == STATE_LOAD_PDE && current_type != TYPE_CODE)  perf_data_misses  <= perf_data_misses + 64'd1;
+        if(perf_walk)                                                           perf_walk_cycles  <= perf_walk_cycles + 64'd1;
+        if(tlbregs_tlbflushsingle_do || tlbregs_tlbflushall_do)                 perf_flushes      <= perf_flushes + 64'd1;
+    end
+end
+// synthesis translate_on
+
+//------------------------------------------------------------------------------
+
 /*******************************************************************************SCRIPT
 NO_ALWAYS_BLOCK(code_pf);
 NO_ALWAYS_BLOCK(check_pf);
@@ -78,6 +78,16 @@ wire exception_ud;
 
 //------------------------------------------------------------------------------
 
+wire dec_fpu_present;
+
+`ifdef AO486_FPU
+assign dec_fpu_present = `TRUE;
+`else
+assign dec_fpu_present = `FALSE;
+`endif
+
+//------------------------------------------------------------------------------
+
 assign exception_ud_invalid =
     (dec_ready_modregrm_one && (
         (decoder[7:0] == 8'h8F && decoder[13:11] != 3'd0) ||
@@ -31,6 +31,7 @@ module execute(
     input               rst_n,
     
     input               exe_reset,
+    input               wr_reset,
     
     //general input
     input       [31:0]  eax,
@@ -194,6 +195,7 @@ module execute(
     output              exe_trigger_pf_fault,
     output              exe_trigger_db_fault,
     output              exe_trigger_nm_fault,
+    output              exe_trigger_mf_fault,
     output              exe_load_seg_gp_fault,
     output              exe_load_seg_ss_fault,
     output              exe_load_seg_np_fault,
@@ -214,6 +216,7 @@ module execute(
     input               rd_address_32bit,
     input       [1:0]   rd_prefix_group_1_rep,
     input               rd_prefix_group_1_lock,
+    input       [2:0]   rd_prefix_group_2_seg,
     input               rd_prefix_2byte,
     input       [3:0]   rd_consumed,
     input               rd_is_8bit,
@@ -236,6 +239,7 @@ module execute(
     
     //exe pipeline
     input               wr_busy,
+    input               wr_fpu_commit,
     output              exe_ready,
     
     output reg  [39:0]  exe_decoder,
@@ -338,6 +342,7 @@ reg [31:0]  src;
 reg [31:0]  dst;
 reg [31:0]  exe_address_effective;
 reg         exe_prefix_2byte;
+reg [2:0]   exe_prefix_group_2_seg;
 
 always @(posedge clk) begin if(rst_n == 1'b0) exe_decoder              <= 40'd0;     else if(e_load) exe_decoder              <= rd_decoder[39:0];        end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_eip                  <= 32'd0;     else if(e_load) exe_eip                  <= rd_eip;                  end
@@ -346,6 +351,7 @@ always @(posedge clk) begin if(rst_n == 1'b0) exe_address_32bit        <= `FALSE
 always @(posedge clk) begin if(rst_n == 1'b0) exe_prefix_group_1_rep   <= 2'd0;      else if(e_load) exe_prefix_group_1_rep   <= rd_prefix_group_1_rep;   end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_prefix_group_1_lock  <= `FALSE;    else if(e_load) exe_prefix_group_1_lock  <= rd_prefix_group_1_lock;  end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_prefix_2byte         <= `FALSE;    else if(e_load) exe_prefix_2byte         <= rd_prefix_2byte;         end
+always @(posedge clk) begin if(rst_n == 1'b0) exe_prefix_group_2_seg   <= 3'd3;      else if(e_load) exe_prefix_group_2_seg   <= rd_prefix_group_2_seg;   end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_consumed             <= 4'd0;      else if(e_load) exe_consumed             <= rd_consumed;             end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_is_8bit              <= `FALSE;    else if(e_load) exe_is_8bit              <= rd_is_8bit;              end
 always @(posedge clk) begin if(rst_n == 1'b0) exe_cmdex                <= 4'd0;      else if(e_load) exe_cmdex                <= rd_cmdex;                end
@@ -576,6 +582,77 @@ execute_divide execute_divide_inst(
     .div_result_remainder   (div_result_remainder)  //output [31:0]
 );
 
+//------------------------------------------------------------------------------
+wire        fpu_busy;
+wire        fpu_nm_fault;
+wire        fpu_mf_fault;
+wire        fpu_last;
+wire        fpu_store_skip;
+
+wire [31:0] fpu_result;
+
+`ifdef AO486_FPU
+execute_fpu execute_fpu_inst(
+    .clk                    (clk),
+    .rst_n                  (rst_n),
+    
+    .exe_reset              (exe_reset),
+    .wr_reset               (wr_reset),
+    
+    .exe_ready              (exe_ready),
+    
+    .exe_cmd                (exe_cmd),                  //input [6:0]
+    .exe_cmdex              (exe_cmdex),                //input [3:0]
+    .exe_decoder            (exe_decoder[15:0]),        //input [15:0]
+    .exe_operand_32bit      (exe_operand_32bit),        //input
+    
+    .real_mode              (real_mode),                //input
+    .v8086_mode             (v8086_mode),               //input
+    
+    .exe_eip                (exe_eip),                  //input [31:0]
+    .exe_consumed           (exe_consumed),             //input [3:0]
+    
+    .es                     (es),                       //input [15:0]
+    .cs                     (cs),                       //input [15:0]
+    .ss                     (ss),                       //input [15:0]
+    .ds                     (ds),                       //input [15:0]
+    .fs                     (fs),                       //input [15:0]
+    .gs                     (gs),                       //input [15:0]
+    
+    .exe_prefix_group_2_seg (exe_prefix_group_2_seg),   //input [2:0]
+    .exe_address_effective  (exe_address_effective),    //input [31:0]
+    
+    .src                    (src),                      //input [31:0]
+    
+    .cr0_ne                 (cr0_ne),                   //input
+    .cr0_ts                 (cr0_ts),                   //input
+    .cr0_em                 (cr0_em),                   //input
+    .cr0_mp                 (cr0_mp),                   //input
+    
+    .wr_fpu_commit          (wr_fpu_commit),            //input
+    
+    //output
+    .fpu_busy               (fpu_busy),                 //output
+    .fpu_nm_fault           (fpu_nm_fault),             //output
+    .fpu_mf_fault           (fpu_mf_fault),             //output
+    .fpu_last               (fpu_last),                 //output
+    
+    .fpu_result             (fpu_result),               //output [31:0]
+    .fpu_store_skip         (fpu_store_skip)            //output
+);
+`else
+assign fpu_busy         = `FALSE;
+assign fpu_nm_fault     = `FALSE;
+assign fpu_mf_fault     = `FALSE;
+assign fpu_last         = `FALSE;
+assign fpu_store_skip   = `FALSE;
+assign fpu_result       = 32'd0;
+
+// synthesis translate_off
+wire _unused_fpu_ok = &{ 1'b0, wr_reset, wr_fpu_commit, exe_prefix_group_2_seg, 1'b0 };
+// synthesis translate_on
+`endif
+
 //------------------------------------------------------------------------------
 
 execute_commands execute_commands_inst(
@@ -703,6 +780,14 @@ execute_commands execute_commands_inst(
     .div_result_quotient                (div_result_quotient),              //input [31:0]
     .div_result_remainder               (div_result_remainder),             //input [31:0]
     
+    //fpu
+    .fpu_busy                           (fpu_busy),                         //input
+    .fpu_nm_fault                       (fpu_nm_fault),                     //input
+    .fpu_mf_fault                       (fpu_mf_fault),                     //input
+    .fpu_last                           (fpu_last),                         //input
+    .fpu_store_skip                     (fpu_store_skip),                   //input
+    .fpu_result                         (fpu_result),                       //input [31:0]
+    
     //shift
     .e_shift_no_write                   (e_shift_no_write),                 //input
     .e_shift_oszapc_update              (e_shift_oszapc_update),            //input
@@ -806,6 +891,7 @@ execute_commands execute_commands_inst(
     .exe_trigger_pf_fault               (exe_trigger_pf_fault),             //output
     .exe_trigger_db_fault               (exe_trigger_db_fault),             //output
     .exe_trigger_nm_fault               (exe_trigger_nm_fault),             //output
+    .exe_trigger_mf_fault               (exe_trigger_mf_fault),             //output
     .exe_load_seg_gp_fault              (exe_load_seg_gp_fault),            //output
     .exe_load_seg_ss_fault              (exe_load_seg_ss_fault),            //output
     .exe_load_seg_np_fault              (exe_load_seg_np_fault),            //output
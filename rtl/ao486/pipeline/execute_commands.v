@@ -153,6 +153,14 @@ module execute_commands(
     input       [31:0]  div_result_quotient,
     input       [31:0]  div_result_remainder,
     
+    //fpu
+    input               fpu_busy,
+    input               fpu_nm_fault,
+    input               fpu_mf_fault,
+    input               fpu_last,
+    input               fpu_store_skip,
+    input       [31:0]  fpu_result,
+    
     //shift
     input               e_shift_no_write,
     input               e_shift_oszapc_update,
@@ -259,6 +267,7 @@ module execute_commands(
     output              exe_trigger_pf_fault,
     output              exe_trigger_db_fault,
     output              exe_trigger_nm_fault,
+    output              exe_trigger_mf_fault,
     output              exe_load_seg_gp_fault,
     output              exe_load_seg_ss_fault,
     output              exe_load_seg_np_fault,
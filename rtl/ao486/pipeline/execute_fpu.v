@@ -0,0 +1,2483 @@
+/*
+ * Copyright (c) 2014, Aleksander Osman
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * 
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+`include "defines.v"
+
+module execute_fpu(
+    input               clk,
+    input               rst_n,
+    
+    input               exe_reset,
+    input               wr_reset,
+    
+    input               exe_ready,
+    
+    input       [6:0]   exe_cmd,
+    input       [3:0]   exe_cmdex,
+    input       [15:0]  exe_decoder,
+    input               exe_operand_32bit,
+    
+    input               real_mode,
+    input               v8086_mode,
+    
+    input       [31:0]  exe_eip,
+    input       [3:0]   exe_consumed,
+    
+    input       [15:0]  es,
+    input       [15:0]  cs,
+    input       [15:0]  ss,
+    input       [15:0]  ds,
+    input       [15:0]  fs,
+    input       [15:0]  gs,
+    
+    input       [2:0]   exe_prefix_group_2_seg,
+    input       [31:0]  exe_address_effective,
+    
+    input       [31:0]  src,
+    
+    input               cr0_ne,
+    input               cr0_ts,
+    input               cr0_em,
+    input               cr0_mp,
+    
+    input               wr_fpu_commit,
+    
+    //output
+    output              fpu_busy,
+    output              fpu_nm_fault,
+    output              fpu_mf_fault,
+    output              fpu_last,
+    
+    output      [31:0]  fpu_result,
+    output              fpu_store_skip
+);
+
+//------------------------------------------------------------------------------
+// x87 floating point unit.
+//
+// The unit executes the D8-DF escape opcodes decoded as CMD_x87 (loads,
+// arithmetic, register and control instructions), CMD_x87_store (stores to
+// memory) and CMD_x87_env (FLDENV, FRSTOR, FNSTENV, FNSAVE). Memory operands
+// are transferred in dword pieces, one command step per piece: a word, a dword,
+// two dwords for 64-bit formats and dword, dword, word for the 80-bit formats.
+// A load collects the pieces and computes at the last step, a store computes
+// at the first step and hands out one piece per step.
+//
+// The new state of an instruction is held in the o_* registers until the write
+// stage of its last step commits it (wr_fpu_commit); a fault in the write stage
+// (wr_reset) drops it and the instruction is restarted. Every FPU step waits
+// for the commit of the previous instruction. FLDENV and FRSTOR load the state
+// piece by piece; a restarted instruction loads it again.
+//
+// Exceptions are reported as on a 486 with CR0.NE set: a waiting instruction
+// raises #MF when an unmasked exception is pending. With CR0.NE clear the
+// exceptions are ignored (IGNNE#), there is no FERR# interrupt.
+
+//------------------------------------------------------------------------------ decode
+
+wire [2:0]  dec_esc;
+wire        dec_reg;
+wire [2:0]  dec_nnn;
+wire [2:0]  dec_rm;
+
+assign dec_esc = exe_decoder[2:0];
+assign dec_reg = exe_decoder[15:14] == 2'b11;
+assign dec_nnn = exe_decoder[13:11];
+assign dec_rm  = exe_decoder[10:8];
+
+wire fmt_m32;
+wire fmt_m64;
+wire fmt_m80;
+wire fmt_i16;
+wire fmt_i32;
+wire fmt_i64;
+wire fmt_bcd;
+wire fmt_wide64;
+wire fmt_wide80;
+
+assign fmt_m32 = ~(dec_reg) && (dec_esc == 3'd0 || (dec_esc == 3'd1 && ~(dec_nnn[2])));
+assign fmt_m64 = ~(dec_reg) && (dec_esc == 3'd4 || (dec_esc == 3'd5 && ~(dec_nnn[2])));
+assign fmt_m80 = ~(dec_reg) && dec_esc == 3'd3 && (dec_nnn == 3'd5 || dec_nnn == 3'd7);
+assign fmt_i16 = ~(dec_reg) && (dec_esc == 3'd6 || (dec_esc == 3'd7 && ~(dec_nnn[2])));
+assign fmt_i32 = ~(dec_reg) && (dec_esc == 3'd2 || (dec_esc == 3'd3 && ~(dec_nnn[2])));
+assign fmt_i64 = ~(dec_reg) && dec_esc == 3'd7 && (dec_nnn == 3'd5 || dec_nnn == 3'd7);
+assign fmt_bcd = ~(dec_reg) && dec_esc == 3'd7 && (dec_nnn == 3'd4 || dec_nnn == 3'd6);
+
+assign fmt_wide64 = fmt_m64 || fmt_i64;
+assign fmt_wide80 = fmt_m80 || fmt_bcd;
+
+//arithmetic: FADD, FMUL, FSUB, FSUBR, FDIV, FDIVR
+wire ins_arith;
+//compare: FCOM, FCOMP, FCOMPP, FICOM, FICOMP, FUCOM, FUCOMP, FUCOMPP, FTST
+wire ins_compare;
+wire ins_compare_unordered;
+wire ins_ftst;
+//loads: FLD, FILD, FBLD, constants
+wire ins_load;
+wire ins_load_reg;
+wire ins_const;
+//stores: FST, FSTP, FIST, FISTP, FBSTP
+wire ins_store;
+wire ins_store_reg;
+wire ins_fstcw;
+wire ins_fstsw;
+wire ins_fstsw_ax;
+wire ins_fldcw;
+//register operations
+wire ins_fxch;
+wire ins_fchs;
+wire ins_fabs;
+wire ins_fxam;
+wire ins_fnop;
+wire ins_ffree;
+wire ins_fdecstp;
+wire ins_fincstp;
+wire ins_fsqrt;
+wire ins_frndint;
+wire ins_fscale;
+wire ins_fxtract;
+wire ins_fprem;
+wire ins_fprem1;
+wire ins_f2xm1;
+wire ins_fyl2x;
+wire ins_fyl2xp1;
+wire ins_fptan;
+wire ins_fpatan;
+wire ins_fsin;
+wire ins_fcos;
+wire ins_fsincos;
+wire ins_transcendental;
+//control
+wire ins_fnclex;
+wire ins_fninit;
+wire ins_control_nop;
+wire ins_env_load;
+wire ins_env_store;
+wire ins_env_full;
+
+wire ins_pop;
+wire ins_pop2;
+wire ins_control;
+wire ins_no_wait;
+
+assign ins_arith =
+    dec_nnn != 3'd2 && dec_nnn != 3'd3 && (dec_esc == 3'd0 || dec_esc == 3'd4 || dec_esc == 3'd6 || (dec_esc == 3'd2 && ~(dec_reg)));
+
+assign ins_compare_unordered =
+    dec_reg && ((dec_esc == 3'd5 && (dec_nnn == 3'd4 || dec_nnn == 3'd5)) || (dec_esc == 3'd2 && dec_nnn == 3'd5 && dec_rm == 3'd1));
+
+assign ins_ftst = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd4 && dec_rm == 3'd4;
+
+assign ins_compare =
+    ((dec_nnn == 3'd2 || dec_nnn == 3'd3) && (dec_esc == 3'd0 || dec_esc == 3'd4 || dec_esc == 3'd6 || (dec_esc == 3'd2 && ~(dec_reg)))) ||
+    ins_compare_unordered || ins_ftst;
+
+assign ins_load_reg = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd0;
+
+assign ins_const = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd5 && dec_rm != 3'd7;
+
+assign ins_load =
+    ins_load_reg || ins_const ||
+    (~(dec_reg) && dec_nnn == 3'd0 && dec_esc[0]) ||
+    (~(dec_reg) && dec_nnn == 3'd5 && (dec_esc == 3'd3 || dec_esc == 3'd7)) ||
+    (~(dec_reg) && dec_nnn == 3'd4 && dec_esc == 3'd7);
+
+assign ins_fstcw    = ~(dec_reg) && dec_esc == 3'd1 && dec_nnn == 3'd7;
+assign ins_fstsw    = ~(dec_reg) && dec_esc == 3'd5 && dec_nnn == 3'd7;
+assign ins_fstsw_ax = dec_reg && dec_esc == 3'd7 && dec_nnn == 3'd4 && dec_rm == 3'd0;
+assign ins_fldcw    = ~(dec_reg) && dec_esc == 3'd1 && dec_nnn == 3'd5;
+
+assign ins_store =
+    ~(dec_reg) && dec_esc[0] && ~(ins_fstcw) && ~(ins_fstsw) && (
+        dec_nnn == 3'd2 || dec_nnn == 3'd3 ||
+        ((dec_esc == 3'd3 || dec_esc == 3'd7) && dec_nnn == 3'd7) ||
+        (dec_esc == 3'd7 && dec_nnn == 3'd6));
+
+assign ins_store_reg =
+    dec_reg && (
+        (dec_esc == 3'd5 && (dec_nnn == 3'd2 || dec_nnn == 3'd3)) ||
+        (dec_esc == 3'd1 && dec_nnn == 3'd3) ||
+        (dec_esc == 3'd7 && (dec_nnn == 3'd2 || dec_nnn == 3'd3)));
+
+assign ins_fxch     = dec_reg && dec_esc[0] && dec_esc != 3'd3 && dec_nnn == 3'd1;
+assign ins_ffree    = dec_reg && (dec_esc == 3'd5 || dec_esc == 3'd7) && dec_nnn == 3'd0;
+assign ins_fnop     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd2;
+
+assign ins_fchs     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd4 && dec_rm == 3'd0;
+assign ins_fabs     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd4 && dec_rm == 3'd1;
+assign ins_fxam     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd4 && dec_rm == 3'd5;
+
+assign ins_f2xm1    = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd0;
+assign ins_fyl2x    = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd1;
+assign ins_fptan    = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd2;
+assign ins_fpatan   = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd3;
+assign ins_fxtract  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd4;
+assign ins_fprem1   = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd5;
+assign ins_fdecstp  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd6;
+assign ins_fincstp  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd6 && dec_rm == 3'd7;
+assign ins_fprem    = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd0;
+assign ins_fyl2xp1  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd1;
+assign ins_fsqrt    = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd2;
+assign ins_fsincos  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd3;
+assign ins_frndint  = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd4;
+assign ins_fscale   = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd5;
+assign ins_fsin     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd6;
+assign ins_fcos     = dec_reg && dec_esc == 3'd1 && dec_nnn == 3'd7 && dec_rm == 3'd7;
+
+assign ins_transcendental = ins_f2xm1 || ins_fyl2x || ins_fyl2xp1 || ins_fptan || ins_fpatan || ins_fsin || ins_fcos || ins_fsincos;
+
+assign ins_fnclex       = dec_reg && dec_esc == 3'd3 && dec_nnn == 3'd4 && dec_rm == 3'd2;
+assign ins_fninit       = dec_reg && dec_esc == 3'd3 && dec_nnn == 3'd4 && dec_rm == 3'd3;
+assign ins_control_nop  = dec_reg && dec_esc == 3'd3 && dec_nnn == 3'd4 && (dec_rm == 3'd0 || dec_rm == 3'd1 || dec_rm == 3'd4);
+
+assign ins_env_load  = ~(dec_reg) && (dec_esc == 3'd1 || dec_esc == 3'd5) && dec_nnn == 3'd4;
+assign ins_env_store = ~(dec_reg) && (dec_esc == 3'd1 || dec_esc == 3'd5) && dec_nnn == 3'd6;
+assign ins_env_full  = dec_esc == 3'd5;
+
+assign ins_pop =
+    (ins_arith && dec_reg && dec_esc == 3'd6) ||
+    (ins_compare && ~(ins_ftst) && (dec_nnn == 3'd3 || dec_nnn == 3'd5 || (dec_esc == 3'd6 && dec_reg))) ||
+    (ins_store && (dec_nnn == 3'd3 || dec_nnn == 3'd6 || dec_nnn == 3'd7)) ||
+    (ins_store_reg && dec_nnn == 3'd3) ||
+    (ins_store_reg && dec_esc == 3'd7) ||
+    (ins_ffree && dec_esc == 3'd7) ||
+    ins_fyl2x || ins_fyl2xp1 || ins_fpatan;
+
+assign ins_pop2 = ins_compare && dec_reg && ((dec_esc == 3'd6 && dec_nnn == 3'd3) || dec_esc == 3'd2);
+
+assign ins_control = ins_fninit || ins_fnclex || ins_control_nop || ins_fldcw || ins_fstcw || ins_fstsw || ins_fstsw_ax || ins_env_load || ins_env_store;
+
+assign ins_no_wait = ins_fninit || ins_fnclex || ins_control_nop || ins_fstcw || ins_fstsw || ins_fstsw_ax || ins_env_store;
+
+//------------------------------------------------------------------------------ command steps
+
+wire fpu_cmd;
+wire fpu_cmd_wait;
+wire fpu_first;
+wire fpu_compute_step;
+wire fpu_waiting_type;
+
+wire [4:0]  env_piece;
+wire        env_last;
+
+assign fpu_cmd      = exe_cmd == `CMD_x87 || exe_cmd == `CMD_x87_store || exe_cmd == `CMD_x87_env;
+assign fpu_cmd_wait = exe_cmd == `CMD_fpu && exe_cmdex == `CMDEX_WAIT_STEP_0;
+
+assign fpu_first = exe_cmdex == 4'd0;
+
+assign fpu_last =
+    (exe_cmd == `CMD_x87_env)?  env_last :
+    (fmt_wide80)?               exe_cmdex == 4'd2 :
+    (fmt_wide64)?               exe_cmdex == 4'd1 :
+                                exe_cmdex == 4'd0;
+
+assign fpu_compute_step =
+    (exe_cmd == `CMD_x87 && fpu_last) || (exe_cmd == `CMD_x87_store && fpu_first) || (exe_cmd == `CMD_x87_env && env_last);
+
+assign fpu_waiting_type = fpu_cmd_wait || (fpu_cmd && ~(ins_no_wait));
+
+//------------------------------------------------------------------------------ architectural state
+
+reg [79:0]  fpu_r0;
+reg [79:0]  fpu_r1;
+reg [79:0]  fpu_r2;
+reg [79:0]  fpu_r3;
+reg [79:0]  fpu_r4;
+reg [79:0]  fpu_r5;
+reg [79:0]  fpu_r6;
+reg [79:0]  fpu_r7;
+
+reg [7:0]   fpu_empty;
+reg [2:0]   fpu_top;
+
+reg [15:0]  fpu_cw;
+reg [5:0]   fpu_exc;
+reg         fpu_sf;
+reg [3:0]   fpu_cc;         //C3, C2, C1, C0
+
+reg [31:0]  fpu_fip;
+reg [15:0]  fpu_fcs;
+reg [10:0]  fpu_fop;
+reg [31:0]  fpu_fdp;
+reg [15:0]  fpu_fds;
+
+reg         fpu_pending;
+reg         fpu_done;
+
+wire        fpu_es;
+wire [15:0] fpu_sw;
+wire [15:0] fpu_tw;
+
+assign fpu_es = (fpu_exc & ~(fpu_cw[5:0])) != 6'd0;
+
+assign fpu_sw = { fpu_es, fpu_cc[3], fpu_top, fpu_cc[2:0], fpu_es, fpu_sf, fpu_exc };
+
+//------------------------------------------------------------------------------ register read
+
+wire [2:0]  idx_st0;
+wire [2:0]  idx_st1;
+wire [2:0]  idx_sti;
+wire [2:0]  idx_push;
+
+assign idx_st0  = fpu_top;
+assign idx_st1  = fpu_top + 3'd1;
+assign idx_sti  = fpu_top + dec_rm;
+assign idx_push = fpu_top - 3'd1;
+
+wire [79:0] reg_st0;
+wire [79:0] reg_st1;
+wire [79:0] reg_sti;
+
+assign reg_st0 =
+    (idx_st0 == 3'd0)?  fpu_r0 :
+    (idx_st0 == 3'd1)?  fpu_r1 :
+    (idx_st0 == 3'd2)?  fpu_r2 :
+    (idx_st0 == 3'd3)?  fpu_r3 :
+    (idx_st0 == 3'd4)?  fpu_r4 :
+    (idx_st0 == 3'd5)?  fpu_r5 :
+    (idx_st0 == 3'd6)?  fpu_r6 :
+                        fpu_r7;
+
+assign reg_st1 =
+    (idx_st1 == 3'd0)?  fpu_r0 :
+    (idx_st1 == 3'd1)?  fpu_r1 :
+    (idx_st1 == 3'd2)?  fpu_r2 :
+    (idx_st1 == 3'd3)?  fpu_r3 :
+    (idx_st1 == 3'd4)?  fpu_r4 :
+    (idx_st1 == 3'd5)?  fpu_r5 :
+    (idx_st1 == 3'd6)?  fpu_r6 :
+                        fpu_r7;
+
+assign reg_sti =
+    (idx_sti == 3'd0)?  fpu_r0 :
+    (idx_sti == 3'd1)?  fpu_r1 :
+    (idx_sti == 3'd2)?  fpu_r2 :
+    (idx_sti == 3'd3)?  fpu_r3 :
+    (idx_sti == 3'd4)?  fpu_r4 :
+    (idx_sti == 3'd5)?  fpu_r5 :
+    (idx_sti == 3'd6)?  fpu_r6 :
+                        fpu_r7;
+
+wire empty_st0;
+wire empty_st1;
+wire empty_sti;
+wire empty_push;
+
+assign empty_st0  = fpu_empty[idx_st0];
+assign empty_st1  = fpu_empty[idx_st1];
+assign empty_sti  = fpu_empty[idx_sti];
+assign empty_push = fpu_empty[idx_push];
+
+//tag word: empty 3, zero 1, special 2, valid 0
+wire [1:0] tag_0;
+wire [1:0] tag_1;
+wire [1:0] tag_2;
+wire [1:0] tag_3;
+wire [1:0] tag_4;
+wire [1:0] tag_5;
+wire [1:0] tag_6;
+wire [1:0] tag_7;
+
+assign tag_0 = (fpu_empty[0])? 2'd3 : (fpu_r0[78:0] == 79'd0)? 2'd1 : (fpu_r0[78:64] == 15'h7FFF || fpu_r0[78:64] == 15'd0 || ~(fpu_r0[63]))? 2'd2 : 2'd0;
+assign tag_1 = (fpu_empty[1])? 2'd3 : (fpu_r1[78:0] == 79'd0)? 2'd1 : (fpu_r1[78:64] == 15'h7FFF || fpu_r1[78:64] == 15'd0 || ~(fpu_r1[63]))? 2'd2 : 2'd0;
+assign tag_2 = (fpu_empty[2])? 2'd3 : (fpu_r2[78:0] == 79'd0)? 2'd1 : (fpu_r2[78:64] == 15'h7FFF || fpu_r2[78:64] == 15'd0 || ~(fpu_r2[63]))? 2'd2 : 2'd0;
+assign tag_3 = (fpu_empty[3])? 2'd3 : (fpu_r3[78:0] == 79'd0)? 2'd1 : (fpu_r3[78:64] == 15'h7FFF || fpu_r3[78:64] == 15'd0 || ~(fpu_r3[63]))? 2'd2 : 2'd0;
+assign tag_4 = (fpu_empty[4])? 2'd3 : (fpu_r4[78:0] == 79'd0)? 2'd1 : (fpu_r4[78:64] == 15'h7FFF || fpu_r4[78:64] == 15'd0 || ~(fpu_r4[63]))? 2'd2 : 2'd0;
+assign tag_5 = (fpu_empty[5])? 2'd3 : (fpu_r5[78:0] == 79'd0)? 2'd1 : (fpu_r5[78:64] == 15'h7FFF || fpu_r5[78:64] == 15'd0 || ~(fpu_r5[63]))? 2'd2 : 2'd0;
+assign tag_6 = (fpu_empty[6])? 2'd3 : (fpu_r6[78:0] == 79'd0)? 2'd1 : (fpu_r6[78:64] == 15'h7FFF || fpu_r6[78:64] == 15'd0 || ~(fpu_r6[63]))? 2'd2 : 2'd0;
+assign tag_7 = (fpu_empty[7])? 2'd3 : (fpu_r7[78:0] == 79'd0)? 2'd1 : (fpu_r7[78:64] == 15'h7FFF || fpu_r7[78:64] == 15'd0 || ~(fpu_r7[63]))? 2'd2 : 2'd0;
+
+assign fpu_tw = { tag_7, tag_6, tag_5, tag_4, tag_3, tag_2, tag_1, tag_0 };
+
+//------------------------------------------------------------------------------ memory operand
+
+reg [63:0]  fpu_mem_buf;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                           fpu_mem_buf <= 64'd0;
+    else if(exe_ready && exe_cmd == `CMD_x87 && ~(fpu_last))                    fpu_mem_buf <= { src, fpu_mem_buf[63:32] };
+end
+
+wire [31:0] mem_m32;
+wire [63:0] mem_m64;
+wire [79:0] mem_m80;
+wire [63:0] mem_int;
+wire        mem_int_sign;
+wire [63:0] mem_int_abs;
+
+assign mem_m32 = src;
+assign mem_m64 = { src, fpu_mem_buf[63:32] };
+assign mem_m80 = { src[15:0], fpu_mem_buf };
+
+assign mem_int =
+    (fmt_i16)?  { {48{src[15]}}, src[15:0] } :
+    (fmt_i32)?  { {32{src[31]}}, src } :
+                mem_m64;
+
+assign mem_int_sign = mem_int[63];
+assign mem_int_abs  = (mem_int_sign)? -mem_int : mem_int;
+
+//packed BCD: 18 digits, accumulated by FBLD in the BCD load state
+reg  [63:0] bcd_acc;
+reg  [6:0]  bcd_counter;
+reg  [63:0] bcd_bin;
+reg  [71:0] bcd_digits;
+
+wire        mem_m32_denormal;
+wire        mem_m64_denormal;
+
+assign mem_m32_denormal = mem_m32[30:23] == 8'd0  && mem_m32[22:0] != 23'd0;
+assign mem_m64_denormal = mem_m64[62:52] == 11'd0 && mem_m64[51:0] != 52'd0;
+
+wire [66:0] mem_norm_in;
+wire [66:0] mem_norm_out;
+wire [6:0]  mem_norm_shift;
+
+assign mem_norm_in =
+    (fmt_m32)?  { mem_m32[22:0], 44'd0 } :
+    (fmt_m64)?  { mem_m64[51:0], 15'd0 } :
+    (fmt_bcd)?  { bcd_acc, 3'd0 } :
+                { mem_int_abs, 3'd0 };
+
+execute_fpu_normalize mem_normalize_inst(
+    .norm_in        (mem_norm_in),      //input [66:0]
+    .norm_out       (mem_norm_out),     //output [66:0]
+    .norm_shift     (mem_norm_shift)    //output [6:0]
+);
+
+wire [14:0] mem_norm_exp;
+
+assign mem_norm_exp =
+    (fmt_m32)?  15'd16256 - { 8'd0, mem_norm_shift } :
+    (fmt_m64)?  15'd15360 - { 8'd0, mem_norm_shift } :
+                15'd16446 - { 8'd0, mem_norm_shift };
+
+wire [79:0] mem_ext;
+
+assign mem_ext =
+    (fmt_m32 && mem_m32[30:0] == 31'd0)?    { mem_m32[31], 79'd0 } :
+    (fmt_m32 && mem_m32_denormal)?          { mem_m32[31], mem_norm_exp, mem_norm_out[66:3] } :
+    (fmt_m32 && mem_m32[30:23] == 8'hFF)?   { mem_m32[31], 15'h7FFF, 1'b1, mem_m32[22:0], 40'd0 } :
+    (fmt_m32)?                              { mem_m32[31], { 7'd0, mem_m32[30:23] } + 15'd16256, 1'b1, mem_m32[22:0], 40'd0 } :
+    (fmt_m64 && mem_m64[62:0] == 63'd0)?    { mem_m64[63], 79'd0 } :
+    (fmt_m64 && mem_m64_denormal)?          { mem_m64[63], mem_norm_exp, mem_norm_out[66:3] } :
+    (fmt_m64 && mem_m64[62:52] == 11'h7FF)? { mem_m64[63], 15'h7FFF, 1'b1, mem_m64[51:0], 11'd0 } :
+    (fmt_m64)?                              { mem_m64[63], { 4'd0, mem_m64[62:52] } + 15'd15360, 1'b1, mem_m64[51:0], 11'd0 } :
+    (fmt_m80)?                              mem_m80 :
+    (fmt_bcd && bcd_acc == 64'd0)?          { src[15], 79'd0 } :
+    (fmt_bcd)?                              { src[15], mem_norm_exp, mem_norm_out[66:3] } :
+    (mem_int == 64'd0)?                     80'd0 :
+                                            { mem_int_sign, mem_norm_exp, mem_norm_out[66:3] };
+
+//------------------------------------------------------------------------------ operands
+
+localparam [2:0] STATE_IDLE         = 3'd0;
+localparam [2:0] STATE_BCD_LOAD     = 3'd1;
+localparam [2:0] STATE_EXECUTE      = 3'd2;
+localparam [2:0] STATE_ARITH        = 3'd3;
+localparam [2:0] STATE_BCD_STORE    = 3'd4;
+localparam [2:0] STATE_TRANS        = 3'd5;
+
+reg [2:0]   fpu_state;
+
+reg [79:0]  fx;
+reg         fx_empty;
+reg [79:0]  fy;
+reg         fy_empty;
+reg         fy_mem_denormal;
+reg         f_full;
+
+wire fpu_start;
+wire fpu_latch;
+
+assign fpu_start = fpu_state == STATE_IDLE && fpu_cmd && fpu_compute_step && ~(fpu_done) && ~(fpu_pending) && ~(exe_reset) &&
+                   ~(fpu_nm_fault) && ~(fpu_mf_fault);
+
+assign fpu_latch = (fpu_start && ~(fmt_bcd && ins_load)) || (fpu_state == STATE_BCD_LOAD && bcd_counter == 7'd0);
+
+//the second operand: memory, ST(i), ST(1) or +0 for FTST
+wire y_from_st1;
+
+assign y_from_st1 = ins_fscale || ins_fprem || ins_fprem1 || ins_fyl2x || ins_fyl2xp1 || ins_fpatan;
+
+always @(posedge clk) begin if(rst_n == 1'b0) fx       <= 80'd0; else if(fpu_latch) fx       <= reg_st0;   end
+always @(posedge clk) begin if(rst_n == 1'b0) fx_empty <= 1'b0;  else if(fpu_latch) fx_empty <= empty_st0; end
+always @(posedge clk) begin if(rst_n == 1'b0) f_full   <= 1'b0;  else if(fpu_latch) f_full   <= ~(empty_push); end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                       fy <= 80'd0;
+    else if(fpu_latch && ins_ftst)          fy <= 80'd0;
+    else if(fpu_latch && y_from_st1)        fy <= reg_st1;
+    else if(fpu_latch && dec_reg)           fy <= reg_sti;
+    else if(fpu_latch)                      fy <= mem_ext;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                       fy_empty <= 1'b0;
+    else if(fpu_latch && ins_ftst)          fy_empty <= 1'b0;
+    else if(fpu_latch && y_from_st1)        fy_empty <= empty_st1;
+    else if(fpu_latch && dec_reg)           fy_empty <= empty_sti;
+    else if(fpu_latch)                      fy_empty <= 1'b0;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)   fy_mem_denormal <= 1'b0;
+    else if(fpu_latch)  fy_mem_denormal <= ~(dec_reg) && ((fmt_m32 && mem_m32_denormal) || (fmt_m64 && mem_m64_denormal));
+end
+
+//------------------------------------------------------------------------------ BCD load
+
+wire [71:0] bcd_load_shifted;
+wire [63:0] bcd_acc_times_10;
+
+assign bcd_load_shifted = mem_m80[71:0] >> { bcd_counter - 7'd1, 2'd0 };
+assign bcd_acc_times_10 = { bcd_acc[60:0], 3'd0 } + { bcd_acc[62:0], 1'b0 };
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                               bcd_acc <= 64'd0;
+    else if(fpu_start)                                              bcd_acc <= 64'd0;
+    else if(fpu_state == STATE_BCD_LOAD && bcd_counter != 7'd0)     bcd_acc <= bcd_acc_times_10 + { 60'd0, bcd_load_shifted[3:0] };
+end
+
+//------------------------------------------------------------------------------ operand classes
+
+wire        fx_sign;
+wire [14:0] fx_exp;
+wire [63:0] fx_sig;
+wire        fx_zero;
+wire        fx_denormal;
+wire        fx_inf;
+wire        fx_nan;
+wire        fx_snan;
+wire        fx_unsupported;
+
+assign fx_sign          = fx[79];
+assign fx_exp           = fx[78:64];
+assign fx_sig           = fx[63:0];
+assign fx_zero          = fx_exp == 15'd0 && fx_sig == 64'd0;
+assign fx_denormal      = fx_exp == 15'd0 && fx_sig != 64'd0;
+assign fx_inf           = fx_exp == 15'h7FFF && fx_sig == 64'h8000000000000000;
+assign fx_nan           = fx_exp == 15'h7FFF && fx_sig[63] && fx_sig[62:0] != 63'd0;
+assign fx_snan          = fx_nan && ~(fx_sig[62]);
+assign fx_unsupported   = fx_exp != 15'd0 && ~(fx_sig[63]);
+
+wire        fy_sign;
+wire [14:0] fy_exp;
+wire [63:0] fy_sig;
+wire        fy_zero;
+wire        fy_denormal;
+wire        fy_inf;
+wire        fy_nan;
+wire        fy_snan;
+wire        fy_unsupported;
+
+assign fy_sign          = fy[79];
+assign fy_exp           = fy[78:64];
+assign fy_sig           = fy[63:0];
+assign fy_zero          = fy_exp == 15'd0 && fy_sig == 64'd0;
+assign fy_denormal      = fy_exp == 15'd0 && fy_sig != 64'd0;
+assign fy_inf           = fy_exp == 15'h7FFF && fy_sig == 64'h8000000000000000;
+assign fy_nan           = fy_exp == 15'h7FFF && fy_sig[63] && fy_sig[62:0] != 63'd0;
+assign fy_snan          = fy_nan && ~(fy_sig[62]);
+assign fy_unsupported   = fy_exp != 15'd0 && ~(fy_sig[63]);
+
+//denormals normalized, exponent in 20 bits two's complement
+wire [66:0] fx_norm_out;
+wire [6:0]  fx_norm_shift;
+wire [66:0] fy_norm_out;
+wire [6:0]  fy_norm_shift;
+
+execute_fpu_normalize fx_normalize_inst(
+    .norm_in        ({ fx_sig, 3'd0 }), //input [66:0]
+    .norm_out       (fx_norm_out),      //output [66:0]
+    .norm_shift     (fx_norm_shift)     //output [6:0]
+);
+
+execute_fpu_normalize fy_normalize_inst(
+    .norm_in        ({ fy_sig, 3'd0 }), //input [66:0]
+    .norm_out       (fy_norm_out),      //output [66:0]
+    .norm_shift     (fy_norm_shift)     //output [6:0]
+);
+
+wire [19:0] fx_uexp;
+wire [63:0] fx_usig;
+wire [19:0] fy_uexp;
+wire [63:0] fy_usig;
+
+assign fx_uexp = (fx_exp == 15'd0)? 20'd1 - { 13'd0, fx_norm_shift } : { 5'd0, fx_exp };
+assign fx_usig = fx_norm_out[66:3];
+assign fy_uexp = (fy_exp == 15'd0)? 20'd1 - { 13'd0, fy_norm_shift } : { 5'd0, fy_exp };
+assign fy_usig = fy_norm_out[66:3];
+
+//------------------------------------------------------------------------------ NaN results
+
+wire [79:0] nan_indefinite;
+wire [79:0] nan_x;
+wire [79:0] nan_y;
+wire        nan_x_wins;
+wire [79:0] nan_xy;
+
+assign nan_indefinite = 80'hFFFFC000000000000000;
+
+assign nan_x = (fx_unsupported)? nan_indefinite : { fx[79:63], 1'b1, fx[61:0] };
+assign nan_y = (fy_unsupported)? nan_indefinite : { fy[79:63], 1'b1, fy[61:0] };
+
+//of two NaNs the quiet one, then the one with the larger significand
+assign nan_x_wins =
+    (fx_snan != fy_snan)?       fy_snan :
+                                fx_sig[62:0] >= fy_sig[62:0];
+
+assign nan_xy =
+    (fx_unsupported || fy_unsupported)? nan_indefinite :
+    (fx_nan && fy_nan && nan_x_wins)?   nan_x :
+    (fx_nan && fy_nan)?                 nan_y :
+    (fx_nan)?                           nan_x :
+                                        nan_y;
+
+//------------------------------------------------------------------------------ arithmetic: X op Y, X = ST(0), Y = memory or ST(i)
+
+wire [2:0]  ar_op;
+wire        ar_rev;
+wire        ar_sub;
+
+assign ar_op =
+    (dec_nnn == 3'd0)?              `FPU_ARITH_ADD :
+    (dec_nnn == 3'd1)?              `FPU_ARITH_MUL :
+    (dec_nnn[2:1] == 2'b10)?        `FPU_ARITH_ADD :
+                                    `FPU_ARITH_DIV;
+
+//FSUBR, FDIVR: Y op X
+assign ar_rev = dec_nnn == 3'd5 || dec_nnn == 3'd7;
+assign ar_sub = dec_nnn[2:1] == 2'b10;
+
+wire        ar_a_sign;
+wire        ar_a_zero;
+wire        ar_a_inf;
+wire [19:0] ar_a_uexp;
+wire [63:0] ar_a_usig;
+wire        ar_b_sign;
+wire        ar_b_zero;
+wire        ar_b_inf;
+wire [19:0] ar_b_uexp;
+wire [63:0] ar_b_usig;
+
+assign ar_a_sign = (ar_rev)? fy_sign  : fx_sign;
+assign ar_a_zero = (ar_rev)? fy_zero  : fx_zero;
+assign ar_a_inf  = (ar_rev)? fy_inf   : fx_inf;
+assign ar_a_uexp = (ar_rev)? fy_uexp  : fx_uexp;
+assign ar_a_usig = (ar_rev)? fy_usig  : fx_usig;
+assign ar_b_sign = ((ar_rev)? fx_sign : fy_sign) ^ ar_sub;
+assign ar_b_zero = (ar_rev)? fx_zero  : fy_zero;
+assign ar_b_inf  = (ar_rev)? fx_inf   : fy_inf;
+assign ar_b_uexp = (ar_rev)? fx_uexp  : fy_uexp;
+assign ar_b_usig = (ar_rev)? fx_usig  : fy_usig;
+
+wire ar_underflow;
+wire ar_nan;
+wire ar_invalid;
+wire ar_zero_divide;
+wire ar_denormal;
+wire ar_inf;
+wire ar_inf_sign;
+wire ar_zero;
+
+assign ar_underflow = fx_empty || fy_empty;
+
+assign ar_nan = fx_nan || fy_nan || fx_unsupported || fy_unsupported;
+
+assign ar_invalid =
+    fx_snan || fy_snan || fx_unsupported || fy_unsupported ||
+    (~(ar_nan) && ar_op == `FPU_ARITH_ADD && ar_a_inf && ar_b_inf && ar_a_sign != ar_b_sign) ||
+    (~(ar_nan) && ar_op == `FPU_ARITH_MUL && ((ar_a_inf && ar_b_zero) || (ar_a_zero && ar_b_inf))) ||
+    (~(ar_nan) && ar_op == `FPU_ARITH_DIV && ((ar_a_zero && ar_b_zero) || (ar_a_inf && ar_b_inf)));
+
+assign ar_zero_divide = ~(ar_nan) && ar_op == `FPU_ARITH_DIV && ar_b_zero && ~(ar_a_zero) && ~(ar_a_inf);
+
+assign ar_denormal = (fx_denormal || fy_denormal || fy_mem_denormal) && ~(ar_nan) && ~(ar_zero_divide);
+
+assign ar_inf =
+    (ar_op == `FPU_ARITH_DIV)?      ar_a_inf || ar_zero_divide :
+                                    ar_a_inf || ar_b_inf;
+
+assign ar_inf_sign =
+    (ar_op == `FPU_ARITH_ADD && ar_a_inf)?  ar_a_sign :
+    (ar_op == `FPU_ARITH_ADD)?              ar_b_sign :
+                                            ar_a_sign ^ ar_b_sign;
+
+assign ar_zero =
+    (ar_op == `FPU_ARITH_MUL)?      ar_a_zero || ar_b_zero :
+    (ar_op == `FPU_ARITH_DIV)?      ar_a_zero || ar_b_inf :
+                                    `FALSE;
+
+//------------------------------------------------------------------------------ FSQRT, FPREM, FPREM1
+
+wire sq_invalid;
+
+assign sq_invalid = fx_snan || fx_unsupported || (fx_sign && ~(fx_zero) && ~(fx_nan));
+
+wire rem_underflow;
+wire rem_invalid;
+wire rem_unchanged;
+wire rem_denormal;
+
+assign rem_underflow = fx_empty || fy_empty;
+assign rem_invalid   = fx_snan || fy_snan || fx_unsupported || fy_unsupported || (~(ar_nan) && (fy_zero || fx_inf));
+assign rem_unchanged = ~(rem_underflow) && ~(ar_nan) && ~(rem_invalid) && (fx_zero || fy_inf);
+assign rem_denormal  = (fx_denormal || fy_denormal) && ~(ar_nan) && ~(rem_invalid);
+
+//------------------------------------------------------------------------------ compare
+
+wire        cmp_underflow;
+wire        cmp_invalid;
+wire        cmp_denormal;
+wire [84:0] cmp_x_key;
+wire [84:0] cmp_y_key;
+wire        cmp_equal;
+wire        cmp_less;
+wire [3:0]  cmp_cc;
+
+assign cmp_underflow = fx_empty || fy_empty;
+
+assign cmp_invalid =
+    (ins_compare_unordered)?    fx_snan || fy_snan || fx_unsupported || fy_unsupported :
+                                ar_nan;
+
+assign cmp_denormal = (fx_denormal || fy_denormal || fy_mem_denormal) && ~(ar_nan);
+
+assign cmp_x_key = (fx_zero)? 85'd0 : { 1'b1, ~(fx_uexp[19]), fx_uexp[18:0], fx_usig };
+assign cmp_y_key = (fy_zero)? 85'd0 : { 1'b1, ~(fy_uexp[19]), fy_uexp[18:0], fy_usig };
+
+assign cmp_equal = (fx_zero && fy_zero) || (fx_sign == fy_sign && cmp_x_key == cmp_y_key);
+
+assign cmp_less =
+    (fx_sign != fy_sign)?   fx_sign :
+    (fx_sign)?              cmp_x_key > cmp_y_key :
+                            cmp_x_key < cmp_y_key;
+
+assign cmp_cc =
+    (ar_nan || cmp_underflow)?  4'b1101 :
+    (cmp_equal)?                4'b1000 :
+    (cmp_less)?                 4'b0001 :
+                                4'b0000;
+
+//------------------------------------------------------------------------------ FXAM
+
+wire [3:0] xam_cc;
+
+assign xam_cc =
+    (fx_empty)?         { 1'b1, 1'b0, fx_sign, 1'b1 } :
+    (fx_unsupported)?   { 1'b0, 1'b0, fx_sign, 1'b0 } :
+    (fx_nan)?           { 1'b0, 1'b0, fx_sign, 1'b1 } :
+    (fx_inf)?           { 1'b0, 1'b1, fx_sign, 1'b1 } :
+    (fx_zero)?          { 1'b1, 1'b0, fx_sign, 1'b0 } :
+    (fx_denormal)?      { 1'b1, 1'b1, fx_sign, 1'b0 } :
+                        { 1'b0, 1'b1, fx_sign, 1'b0 };
+
+//------------------------------------------------------------------------------ FSCALE
+
+wire [19:0] sc_y_shift;
+wire [63:0] sc_y_shifted;
+wire [15:0] sc_n;
+wire [19:0] sc_exp;
+wire        sc_invalid;
+
+assign sc_y_shift   = 20'd16446 - fy_uexp;
+assign sc_y_shifted = fy_usig >> sc_y_shift[5:0];
+
+assign sc_n =
+    ({ ~(fy_uexp[19]), fy_uexp[18:0] } < { 1'b1, 19'd16383 })?  16'd0 :
+    ({ ~(fy_uexp[19]), fy_uexp[18:0] } > { 1'b1, 19'd16398 })?  16'hFFFF :
+                                                                sc_y_shifted[15:0];
+
+assign sc_exp = (fy_sign)? fx_uexp - { 4'd0, sc_n } : fx_uexp + { 4'd0, sc_n };
+
+assign sc_invalid = fx_snan || fy_snan || fx_unsupported || fy_unsupported ||
+    (~(ar_nan) && ((fx_zero && fy_inf && ~(fy_sign)) || (fx_inf && fy_inf && fy_sign)));
+
+//------------------------------------------------------------------------------ constants
+
+wire [19:0] const_exp;
+wire [66:0] const_sig;
+
+assign const_exp =
+    (dec_rm == 3'd0)?   20'd16383 : //FLD1
+    (dec_rm == 3'd1)?   20'd16384 : //FLDL2T
+    (dec_rm == 3'd2)?   20'd16383 : //FLDL2E
+    (dec_rm == 3'd3)?   20'd16384 : //FLDPI
+    (dec_rm == 3'd4)?   20'd16381 : //FLDLG2
+    (dec_rm == 3'd5)?   20'd16382 : //FLDLN2
+                        20'd0;      //FLDZ
+
+assign const_sig =
+    (dec_rm == 3'd0)?   67'h40000000000000000 :
+    (dec_rm == 3'd1)?   67'h6A4D3C25E68DC57F3 :
+    (dec_rm == 3'd2)?   67'h5C551D94AE0BF85DD :
+    (dec_rm == 3'd3)?   67'h6487ED5110B4611A7 :
+    (dec_rm == 3'd4)?   67'h4D104D427DE7FBCC5 :
+    (dec_rm == 3'd5)?   67'h58B90BFBE8E7BCD5F :
+                        67'd0;
+
+//FPATAN of zero and infinite operands: pi, pi/2, pi/4 and 3pi/4
+wire [19:0] tr_const_exp;
+wire [66:0] tr_const_sig;
+
+assign tr_const_exp =
+    (fy_zero)?                  20'd16384 :
+    (fy_inf && fx_inf)?         ((fx_sign)? 20'd16384 : 20'd16382) :
+    (fy_inf || fx_zero)?        20'd16383 :
+                                20'd16384;
+
+assign tr_const_sig = (fy_inf && fx_inf && fx_sign)? 67'h4B65F1FCCC8748D3D : 67'h6487ED5110B4611A7;
+
+//------------------------------------------------------------------------------ transcendental programs
+// F2XM1, FYL2X, FYL2XP1, FPATAN, FPTAN, FSIN, FCOS and FSINCOS run as short
+// programs of engine operations on four temporaries. Every step is rounded to
+// 64 bits, to nearest, with the exponent unbounded; a FIN step rounds its
+// operand with the control word into the register result.
+//
+// F2XM1:           2^x - 1 = t * P(t), t = x * ln2, P the Taylor series of (e^t - 1) / t
+// FYL2X, FYL2XP1:  log2(z) = e + 2 * log2e * atanh(s), s = (m - 1) / (m + 1) with z = m * 2^e,
+//                  m in [sqrt(1/2), sqrt(2)]; for FYL2XP1 s = x / (x + 2) and e = 0
+// FPATAN:          atan of the ratio r <= 1 of the smaller to the larger magnitude, reduced by
+//                  atan(r) = pi/6 + atan((r * sqrt3 - 1) / (r + sqrt3)) above tan(pi/12)
+// FSIN ... FPTAN:  x reduced by FPREM1 with a 67-bit pi/2, both series evaluated, the quotient
+//                  selects and negates the results
+//
+// The series run in Horner form: INIT loads the highest coefficient and the LOOP step
+// returns to the preceding multiplication until the constant term is added.
+
+localparam [4:0] TRANS_SRC_T0       = 5'd0;
+localparam [4:0] TRANS_SRC_T1       = 5'd1;
+localparam [4:0] TRANS_SRC_T2       = 5'd2;
+localparam [4:0] TRANS_SRC_T3       = 5'd3;
+localparam [4:0] TRANS_SRC_X        = 5'd4;
+localparam [4:0] TRANS_SRC_Y        = 5'd5;
+localparam [4:0] TRANS_SRC_ZERO     = 5'd6;
+localparam [4:0] TRANS_SRC_ONE      = 5'd7;
+localparam [4:0] TRANS_SRC_TWO      = 5'd8;
+localparam [4:0] TRANS_SRC_COEF     = 5'd9;
+localparam [4:0] TRANS_SRC_LN2      = 5'd10;
+localparam [4:0] TRANS_SRC_2LOG2E   = 5'd11;
+localparam [4:0] TRANS_SRC_PIO2     = 5'd12;
+localparam [4:0] TRANS_SRC_PIO6     = 5'd13;
+localparam [4:0] TRANS_SRC_PI       = 5'd14;
+localparam [4:0] TRANS_SRC_SQRT3    = 5'd15;
+localparam [4:0] TRANS_SRC_MIN      = 5'd16;
+localparam [4:0] TRANS_SRC_MAX      = 5'd17;
+localparam [4:0] TRANS_SRC_M        = 5'd18;
+localparam [4:0] TRANS_SRC_E        = 5'd19;
+localparam [4:0] TRANS_SRC_TRIG     = 5'd20;
+localparam [4:0] TRANS_SRC_COS      = 5'd21;
+localparam [4:0] TRANS_SRC_ATAN     = 5'd22;
+
+localparam [2:0] TRANS_COND_ALWAYS  = 3'd0;
+localparam [2:0] TRANS_COND_REDUCE  = 3'd1;
+localparam [2:0] TRANS_COND_SWAP    = 3'd2;
+localparam [2:0] TRANS_COND_XNEG    = 3'd3;
+localparam [2:0] TRANS_COND_EVEN    = 3'd4;
+localparam [2:0] TRANS_COND_ODD     = 3'd5;
+localparam [2:0] TRANS_COND_LOG     = 3'd6;
+localparam [2:0] TRANS_COND_LOGP1   = 3'd7;
+
+localparam [2:0] TRANS_SERIES_EXP   = 3'd0;
+localparam [2:0] TRANS_SERIES_ATANH = 3'd1;
+localparam [2:0] TRANS_SERIES_ATAN  = 3'd2;
+localparam [2:0] TRANS_SERIES_SIN   = 3'd3;
+localparam [2:0] TRANS_SERIES_COS   = 3'd4;
+
+reg [4:0]   trans_step;
+reg [4:0]   trans_k;
+reg         trans_started;
+reg [1:0]   trans_q;
+reg         trans_reduce;
+reg [79:0]  trans_r1;
+reg         trans_pe;
+reg         trans_ue;
+reg         trans_oe;
+
+//temporaries: zero, sign, exponent, significand
+reg [85:0]  trans_t0;
+reg [85:0]  trans_t1;
+reg [85:0]  trans_t2;
+reg [85:0]  trans_t3;
+
+//step: FIN, operation, A, negate A, B, negate B, destination, condition, INIT, LOOP, LAST
+wire [23:0] trans_uop;
+wire [23:0] trans_uop_f2xm1;
+wire [23:0] trans_uop_log;
+wire [23:0] trans_uop_atan;
+wire [23:0] trans_uop_trig;
+
+assign trans_uop_f2xm1 =
+    (trans_step == 5'd0)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_X,    1'b0, TRANS_SRC_LN2,    1'b0, 2'd1, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd1)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b100 } :
+    (trans_step == 5'd2)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T1,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd3)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b010 } :
+    (trans_step == 5'd4)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T1,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+                            { `TRUE,  `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_ZERO,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b001 };
+
+assign trans_uop_log =
+    (trans_step == 5'd0)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_M,      1'b0, 2'd0, TRANS_COND_LOG,    3'b000 } :
+    (trans_step == 5'd1)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_E,      1'b0, 2'd3, TRANS_COND_LOG,    3'b000 } :
+    (trans_step == 5'd2)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_ONE,    1'b1, 2'd1, TRANS_COND_LOG,    3'b000 } :
+    (trans_step == 5'd3)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_ONE,    1'b0, 2'd2, TRANS_COND_LOG,    3'b000 } :
+    (trans_step == 5'd4)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_X,      1'b0, 2'd1, TRANS_COND_LOGP1,  3'b000 } :
+    (trans_step == 5'd5)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_X,    1'b0, TRANS_SRC_TWO,    1'b0, 2'd2, TRANS_COND_LOGP1,  3'b000 } :
+    (trans_step == 5'd6)?   { `FALSE, `FPU_ARITH_DIV, TRANS_SRC_T1,   1'b0, TRANS_SRC_T2,     1'b0, 2'd1, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd7)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T1,   1'b0, TRANS_SRC_T1,     1'b0, 2'd2, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd8)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b100 } :
+    (trans_step == 5'd9)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T2,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd10)?  { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b010 } :
+    (trans_step == 5'd11)?  { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T1,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd12)?  { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_2LOG2E, 1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd13)?  { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_T3,     1'b0, 2'd0, TRANS_COND_LOG,    3'b000 } :
+    (trans_step == 5'd14)?  { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_Y,      1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+                            { `TRUE,  `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_ZERO,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b001 };
+
+assign trans_uop_atan =
+    (trans_step == 5'd0)?   { `FALSE, `FPU_ARITH_DIV, TRANS_SRC_MIN,  1'b0, TRANS_SRC_MAX,    1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd1)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_SQRT3,  1'b0, 2'd1, TRANS_COND_REDUCE, 3'b000 } :
+    (trans_step == 5'd2)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T1,   1'b0, TRANS_SRC_ONE,    1'b1, 2'd1, TRANS_COND_REDUCE, 3'b000 } :
+    (trans_step == 5'd3)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_SQRT3,  1'b0, 2'd2, TRANS_COND_REDUCE, 3'b000 } :
+    (trans_step == 5'd4)?   { `FALSE, `FPU_ARITH_DIV, TRANS_SRC_T1,   1'b0, TRANS_SRC_T2,     1'b0, 2'd0, TRANS_COND_REDUCE, 3'b000 } :
+    (trans_step == 5'd5)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T0,     1'b0, 2'd1, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd6)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_COEF,   1'b0, 2'd2, TRANS_COND_ALWAYS, 3'b100 } :
+    (trans_step == 5'd7)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T2,   1'b0, TRANS_SRC_T1,     1'b0, 2'd2, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd8)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T2,   1'b0, TRANS_SRC_COEF,   1'b0, 2'd2, TRANS_COND_ALWAYS, 3'b010 } :
+    (trans_step == 5'd9)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T2,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd10)?  { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_PIO6,   1'b0, 2'd0, TRANS_COND_REDUCE, 3'b000 } :
+    (trans_step == 5'd11)?  { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b1, TRANS_SRC_PIO2,   1'b0, 2'd0, TRANS_COND_SWAP,   3'b000 } :
+    (trans_step == 5'd12)?  { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b1, TRANS_SRC_PI,     1'b0, 2'd0, TRANS_COND_XNEG,   3'b000 } :
+                            { `TRUE,  `FPU_ARITH_ADD, TRANS_SRC_ATAN, 1'b0, TRANS_SRC_ZERO,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b001 };
+
+assign trans_uop_trig =
+    (trans_step == 5'd0)?   { `FALSE, `FPU_ARITH_REM1, TRANS_SRC_X,   1'b0, TRANS_SRC_PIO2,   1'b0, 2'd1, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd1)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T1,   1'b0, TRANS_SRC_T1,     1'b0, 2'd2, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd2)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b100 } :
+    (trans_step == 5'd3)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T2,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd4)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T0,   1'b0, TRANS_SRC_COEF,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b010 } :
+    (trans_step == 5'd5)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T0,   1'b0, TRANS_SRC_T1,     1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd6)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_ZERO, 1'b0, TRANS_SRC_COEF,   1'b0, 2'd3, TRANS_COND_ALWAYS, 3'b100 } :
+    (trans_step == 5'd7)?   { `FALSE, `FPU_ARITH_MUL, TRANS_SRC_T3,   1'b0, TRANS_SRC_T2,     1'b0, 2'd3, TRANS_COND_ALWAYS, 3'b000 } :
+    (trans_step == 5'd8)?   { `FALSE, `FPU_ARITH_ADD, TRANS_SRC_T3,   1'b0, TRANS_SRC_COEF,   1'b0, 2'd3, TRANS_COND_ALWAYS, 3'b010 } :
+    (trans_step == 5'd9)?   { `FALSE, `FPU_ARITH_DIV, TRANS_SRC_T0,   1'b0, TRANS_SRC_T3,     1'b0, 2'd0, TRANS_COND_EVEN,   3'b000 } :
+    (trans_step == 5'd10)?  { `FALSE, `FPU_ARITH_DIV, TRANS_SRC_T3,   1'b1, TRANS_SRC_T0,     1'b0, 2'd0, TRANS_COND_ODD,    3'b000 } :
+    (trans_step == 5'd11)?  { `TRUE,  `FPU_ARITH_ADD, TRANS_SRC_TRIG, 1'b0, TRANS_SRC_ZERO,   1'b0, 2'd0, TRANS_COND_ALWAYS, 2'b00, ~(ins_fsincos) } :
+                            { `TRUE,  `FPU_ARITH_ADD, TRANS_SRC_COS,  1'b0, TRANS_SRC_ZERO,   1'b0, 2'd0, TRANS_COND_ALWAYS, 3'b001 };
+
+assign trans_uop =
+    (ins_f2xm1)?                    trans_uop_f2xm1 :
+    (ins_fyl2x || ins_fyl2xp1)?     trans_uop_log :
+    (ins_fpatan)?                   trans_uop_atan :
+                                    trans_uop_trig;
+
+wire        u_fin;
+wire [2:0]  u_op;
+wire [4:0]  u_a;
+wire        u_a_neg;
+wire [4:0]  u_b;
+wire        u_b_neg;
+wire [1:0]  u_dest;
+wire [2:0]  u_cond;
+wire        u_init;
+wire        u_loop;
+wire        u_last;
+
+assign { u_fin, u_op, u_a, u_a_neg, u_b, u_b_neg, u_dest, u_cond, u_init, u_loop, u_last } = trans_uop;
+
+wire tr_swap;
+
+//FPATAN: |y| > |x|, the ratio is x / y
+assign tr_swap = { ~(fy_uexp[19]), fy_uexp[18:0], fy_usig } > { ~(fx_uexp[19]), fx_uexp[18:0], fx_usig };
+
+wire u_skip;
+
+assign u_skip =
+    (u_cond == TRANS_COND_REDUCE && ~(trans_reduce)) ||
+    (u_cond == TRANS_COND_SWAP   && ~(tr_swap)) ||
+    (u_cond == TRANS_COND_XNEG   && ~(fx_sign)) ||
+    (u_cond == TRANS_COND_EVEN   && ~(ins_fptan && ~(trans_q[0]))) ||
+    (u_cond == TRANS_COND_ODD    && ~(ins_fptan && trans_q[0])) ||
+    (u_cond == TRANS_COND_LOG    && ~(ins_fyl2x)) ||
+    (u_cond == TRANS_COND_LOGP1  && ~(ins_fyl2xp1));
+
+//------------------------------------------------------------------------------ transcendental operands
+
+wire [2:0]  trans_series;
+wire [4:0]  trans_series_top;
+wire [4:0]  trans_coef_k;
+wire [4:0]  trans_coef_j;
+wire [86:0] trans_coef_fact;
+wire [86:0] trans_coef_odd;
+wire [86:0] trans_coef;
+wire        trans_coef_sign;
+
+assign trans_series =
+    (ins_f2xm1)?                    TRANS_SERIES_EXP :
+    (ins_fyl2x || ins_fyl2xp1)?     TRANS_SERIES_ATANH :
+    (ins_fpatan)?                   TRANS_SERIES_ATAN :
+    (trans_step >= 5'd6)?           TRANS_SERIES_COS :
+                                    TRANS_SERIES_SIN;
+
+assign trans_series_top =
+    (trans_series == TRANS_SERIES_EXP)?     5'd18 :
+    (trans_series == TRANS_SERIES_ATANH)?   5'd13 :
+    (trans_series == TRANS_SERIES_ATAN)?    5'd17 :
+    (trans_series == TRANS_SERIES_SIN)?     5'd10 :
+                                            5'd11;
+
+assign trans_coef_k = (u_init)? trans_series_top : trans_k - 5'd1;
+
+assign trans_coef_j =
+    (trans_series == TRANS_SERIES_EXP)?     trans_coef_k + 5'd1 :
+    (trans_series == TRANS_SERIES_SIN)?     { trans_coef_k[3:0], 1'b1 } :
+                                            { trans_coef_k[3:0], 1'b0 };
+
+assign trans_coef_fact =
+    (trans_coef_j == 5'd0)?   { 20'd16383, 67'h40000000000000000 } : //1/0!
+    (trans_coef_j == 5'd1)?   { 20'd16383, 67'h40000000000000000 } : //1/1!
+    (trans_coef_j == 5'd2)?   { 20'd16382, 67'h40000000000000000 } : //1/2!
+    (trans_coef_j == 5'd3)?   { 20'd16380, 67'h55555555555555555 } : //1/3!
+    (trans_coef_j == 5'd4)?   { 20'd16378, 67'h55555555555555555 } : //1/4!
+    (trans_coef_j == 5'd5)?   { 20'd16376, 67'h44444444444444444 } : //1/5!
+    (trans_coef_j == 5'd6)?   { 20'd16373, 67'h5B05B05B05B05B05B } : //1/6!
+    (trans_coef_j == 5'd7)?   { 20'd16370, 67'h68068068068068068 } : //1/7!
+    (trans_coef_j == 5'd8)?   { 20'd16367, 67'h68068068068068068 } : //1/8!
+    (trans_coef_j == 5'd9)?   { 20'd16364, 67'h5C778E955B1CCE3EB } : //1/9!
+    (trans_coef_j == 5'd10)?  { 20'd16361, 67'h49F93EDDE27D71CBC } : //1/10!
+    (trans_coef_j == 5'd11)?  { 20'd16357, 67'h6B99159FD5138E3FA } : //1/11!
+    (trans_coef_j == 5'd12)?  { 20'd16354, 67'h47BB63BFE3625ED51 } : //1/12!
+    (trans_coef_j == 5'd13)?  { 20'd16350, 67'h5849184EA1B425F29 } : //1/13!
+    (trans_coef_j == 5'd14)?  { 20'd16346, 67'h64E5D2A301F27482F } : //1/14!
+    (trans_coef_j == 5'd15)?  { 20'd16342, 67'h6B9FCF9CCEE07C476 } : //1/15!
+    (trans_coef_j == 5'd16)?  { 20'd16338, 67'h6B9FCF9CCEE07C476 } : //1/16!
+    (trans_coef_j == 5'd17)?  { 20'd16334, 67'h654B1DC0C2B529ACA } : //1/17!
+    (trans_coef_j == 5'd18)?  { 20'd16330, 67'h5A09E18EE5F65DEEC } : //1/18!
+    (trans_coef_j == 5'd19)?  { 20'd16326, 67'h4BD26D1A05055C933 } : //1/19!
+    (trans_coef_j == 5'd20)?  { 20'd16321, 67'h7950AE900808941EA } : //1/20!
+    (trans_coef_j == 5'd21)?  { 20'd16317, 67'h5C6E3BDB73D5C62FC } : //1/21!
+                              { 20'd16313, 67'h4338E5B6DFE14A514 };  //1/22!
+
+assign trans_coef_odd =
+    (trans_coef_k == 5'd0)?   { 20'd16383, 67'h40000000000000000 } : //1/1
+    (trans_coef_k == 5'd1)?   { 20'd16381, 67'h55555555555555555 } : //1/3
+    (trans_coef_k == 5'd2)?   { 20'd16380, 67'h66666666666666666 } : //1/5
+    (trans_coef_k == 5'd3)?   { 20'd16380, 67'h49249249249249249 } : //1/7
+    (trans_coef_k == 5'd4)?   { 20'd16379, 67'h71C71C71C71C71C72 } : //1/9
+    (trans_coef_k == 5'd5)?   { 20'd16379, 67'h5D1745D1745D1745D } : //1/11
+    (trans_coef_k == 5'd6)?   { 20'd16379, 67'h4EC4EC4EC4EC4EC4F } : //1/13
+    (trans_coef_k == 5'd7)?   { 20'd16379, 67'h44444444444444444 } : //1/15
+    (trans_coef_k == 5'd8)?   { 20'd16378, 67'h78787878787878788 } : //1/17
+    (trans_coef_k == 5'd9)?   { 20'd16378, 67'h6BCA1AF286BCA1AF3 } : //1/19
+    (trans_coef_k == 5'd10)?  { 20'd16378, 67'h61861861861861862 } : //1/21
+    (trans_coef_k == 5'd11)?  { 20'd16378, 67'h590B21642C8590B21 } : //1/23
+    (trans_coef_k == 5'd12)?  { 20'd16378, 67'h51EB851EB851EB852 } : //1/25
+    (trans_coef_k == 5'd13)?  { 20'd16378, 67'h4BDA12F684BDA12F7 } : //1/27
+    (trans_coef_k == 5'd14)?  { 20'd16378, 67'h469EE58469EE5846A } : //1/29
+    (trans_coef_k == 5'd15)?  { 20'd16378, 67'h42108421084210842 } : //1/31
+    (trans_coef_k == 5'd16)?  { 20'd16377, 67'h7C1F07C1F07C1F07C } : //1/33
+                              { 20'd16377, 67'h75075075075075075 };  //1/35
+
+assign trans_coef = (trans_series == TRANS_SERIES_ATANH || trans_series == TRANS_SERIES_ATAN)? trans_coef_odd : trans_coef_fact;
+
+assign trans_coef_sign = trans_series != TRANS_SERIES_EXP && trans_series != TRANS_SERIES_ATANH && trans_coef_k[0];
+
+//FYL2X: x = m * 2^e with m in [sqrt(1/2), sqrt(2)]
+wire        lg_half;
+wire [19:0] lg_exp;
+wire [19:0] lg_exp_abs;
+
+wire [66:0] lg_norm_out;
+wire [6:0]  lg_norm_shift;
+
+assign lg_half    = fx_usig > 64'hB504F333F9DE6484;
+assign lg_exp     = fx_uexp - 20'd16383 + { 19'd0, lg_half };
+assign lg_exp_abs = (lg_exp[19])? -lg_exp : lg_exp;
+
+execute_fpu_normalize lg_normalize_inst(
+    .norm_in        ({ lg_exp_abs[15:0], 51'd0 }),  //input [66:0]
+    .norm_out       (lg_norm_out),                  //output [66:0]
+    .norm_shift     (lg_norm_shift)                 //output [6:0]
+);
+
+//trigonometric results selected by the quotient of the reduction
+wire [85:0] trans_sin;
+wire [85:0] trans_cos;
+wire        trans_sin_negate;
+wire        trans_cos_negate;
+
+assign trans_sin_negate = trans_q[1] ^ (trans_q[0] & fx_sign);
+assign trans_cos_negate = trans_q[1] ^ trans_q[0] ^ (trans_q[0] & fx_sign);
+
+assign trans_sin = (trans_q[0])? trans_t3 : trans_t0;
+assign trans_cos = (trans_q[0])? trans_t0 : trans_t3;
+
+//A operand: temporaries and the x87 operands, 64-bit significand
+wire        trans_a_zero;
+wire        trans_a_sign;
+wire [19:0] trans_a_exp;
+wire [63:0] trans_a_sig;
+
+assign { trans_a_zero, trans_a_sign, trans_a_exp, trans_a_sig } =
+    (u_a == TRANS_SRC_T0)?                  trans_t0 :
+    (u_a == TRANS_SRC_T1)?                  trans_t1 :
+    (u_a == TRANS_SRC_T2)?                  trans_t2 :
+    (u_a == TRANS_SRC_T3)?                  trans_t3 :
+    (u_a == TRANS_SRC_X)?                   { fx_zero, fx_sign, fx_uexp, fx_usig } :
+    (u_a == TRANS_SRC_MIN && tr_swap)?      { fx_zero, 1'b0, fx_uexp, fx_usig } :
+    (u_a == TRANS_SRC_MIN)?                 { fy_zero, 1'b0, fy_uexp, fy_usig } :
+    (u_a == TRANS_SRC_TRIG && ins_fptan)?   trans_t0 :
+    (u_a == TRANS_SRC_TRIG && ins_fcos)?    { trans_cos[85], trans_cos[84] ^ trans_cos_negate, trans_cos[83:0] } :
+    (u_a == TRANS_SRC_TRIG)?                { trans_sin[85], trans_sin[84] ^ trans_sin_negate, trans_sin[83:0] } :
+    (u_a == TRANS_SRC_COS)?                 { trans_cos[85], trans_cos[84] ^ trans_cos_negate, trans_cos[83:0] } :
+    (u_a == TRANS_SRC_ATAN)?                { trans_t0[85], fy_sign, trans_t0[83:0] } :
+                                            { 1'b1, 1'b0, 20'd0, 64'd0 };
+
+//B operand: temporaries, the x87 operands and the constants, 67-bit significand
+wire        trans_b_zero;
+wire        trans_b_sign;
+wire [19:0] trans_b_exp;
+wire [66:0] trans_b_sig;
+
+assign { trans_b_zero, trans_b_sign, trans_b_exp, trans_b_sig } =
+    (u_b == TRANS_SRC_T0)?          { trans_t0, 3'd0 } :
+    (u_b == TRANS_SRC_T1)?          { trans_t1, 3'd0 } :
+    (u_b == TRANS_SRC_T2)?          { trans_t2, 3'd0 } :
+    (u_b == TRANS_SRC_T3)?          { trans_t3, 3'd0 } :
+    (u_b == TRANS_SRC_X)?           { fx_zero, fx_sign, fx_uexp, fx_usig, 3'd0 } :
+    (u_b == TRANS_SRC_Y)?           { fy_zero, fy_sign, fy_uexp, fy_usig, 3'd0 } :
+    (u_b == TRANS_SRC_ONE)?         { 2'b00, 20'd16383, 67'h40000000000000000 } :
+    (u_b == TRANS_SRC_TWO)?         { 2'b00, 20'd16384, 67'h40000000000000000 } :
+    (u_b == TRANS_SRC_COEF)?        { 1'b0, trans_coef_sign, trans_coef } :
+    (u_b == TRANS_SRC_LN2)?         { 2'b00, 20'd16382, 67'h58B90BFBE8E7BCD5E } :
+    (u_b == TRANS_SRC_2LOG2E)?      { 2'b00, 20'd16384, 67'h5C551D94AE0BF85DE } :
+    (u_b == TRANS_SRC_PIO2)?        { 2'b00, 20'd16383, 67'h6487ED5110B4611A6 } :
+    (u_b == TRANS_SRC_PIO6)?        { 2'b00, 20'd16382, 67'h430548E0B5CD96119 } :
+    (u_b == TRANS_SRC_PI)?          { 2'b00, 20'd16384, 67'h6487ED5110B4611A6 } :
+    (u_b == TRANS_SRC_SQRT3)?       { 2'b00, 20'd16383, 67'h6ED9EBA16132A9CED } :
+    (u_b == TRANS_SRC_MAX && tr_swap)?  { fy_zero, 1'b0, fy_uexp, fy_usig, 3'd0 } :
+    (u_b == TRANS_SRC_MAX)?         { fx_zero, 1'b0, fx_uexp, fx_usig, 3'd0 } :
+    (u_b == TRANS_SRC_M)?           { 2'b00, (lg_half)? 20'd16382 : 20'd16383, fx_usig, 3'd0 } :
+    (u_b == TRANS_SRC_E)?           { lg_exp == 20'd0, lg_exp[19], 20'd16398 - { 13'd0, lg_norm_shift }, lg_norm_out } :
+                                    { 1'b1, 1'b0, 20'd0, 67'd0 };
+
+//------------------------------------------------------------------------------ engine
+
+wire        arith_start;
+wire [2:0]  arith_op;
+
+wire        arith_busy;
+wire        arith_sign;
+wire [19:0] arith_exp;
+wire [66:0] arith_sig;
+wire        arith_zero;
+wire [2:0]  arith_quotient;
+wire        arith_partial;
+
+wire        eng_a_sign;
+wire [19:0] eng_a_exp;
+wire [63:0] eng_a_sig;
+wire        eng_a_zero;
+wire        eng_b_sign;
+wire [19:0] eng_b_exp;
+wire [66:0] eng_b_sig;
+wire        eng_b_zero;
+
+wire trans_eng;
+
+assign trans_eng = fpu_state == STATE_TRANS;
+
+assign arith_op =
+    (trans_eng)?    u_op :
+    (ins_fsqrt)?    `FPU_ARITH_SQRT :
+    (ins_fprem)?    `FPU_ARITH_REM :
+    (ins_fprem1)?   `FPU_ARITH_REM1 :
+                    ar_op;
+
+assign eng_a_sign = (trans_eng)? trans_a_sign ^ u_a_neg : (ins_arith)? ar_a_sign : fx_sign;
+assign eng_a_exp  = (trans_eng)? trans_a_exp  : (ins_arith)? ar_a_uexp : fx_uexp;
+assign eng_a_sig  = (trans_eng)? trans_a_sig  : (ins_arith)? ar_a_usig : fx_usig;
+assign eng_a_zero = (trans_eng)? trans_a_zero : (ins_arith)? ar_a_zero : fx_zero;
+assign eng_b_sign = (trans_eng)? trans_b_sign ^ u_b_neg : (ins_arith)? ar_b_sign : fy_sign;
+assign eng_b_exp  = (trans_eng)? trans_b_exp  : (ins_arith)? ar_b_uexp : fy_uexp;
+assign eng_b_sig  = (trans_eng)? trans_b_sig  : (ins_arith)? { ar_b_usig, 3'd0 } : { fy_usig, 3'd0 };
+assign eng_b_zero = (trans_eng)? trans_b_zero : (ins_arith)? ar_b_zero : fy_zero;
+
+execute_fpu_arith execute_fpu_arith_inst(
+    .clk                (clk),
+    .rst_n              (rst_n),
+    
+    .exe_reset          (exe_reset),                //input
+    
+    .arith_start        (arith_start),              //input
+    .arith_op           (arith_op),                 //input [2:0]
+    .arith_rc           ((trans_eng)? `FPU_RC_NEAREST : fpu_cw[11:10]),   //input [1:0]
+    
+    .arith_a_sign       (eng_a_sign),               //input
+    .arith_a_exp        (eng_a_exp),                //input [19:0]
+    .arith_a_sig        (eng_a_sig),                //input [63:0]
+    .arith_a_zero       (eng_a_zero),               //input
+    
+    .arith_b_sign       (eng_b_sign),               //input
+    .arith_b_exp        (eng_b_exp),                //input [19:0]
+    .arith_b_sig        (eng_b_sig),                //input [66:0]
+    .arith_b_zero       (eng_b_zero),               //input
+    
+    //output
+    .arith_busy         (arith_busy),               //output
+    
+    .arith_sign         (arith_sign),               //output
+    .arith_exp          (arith_exp),                //output [19:0]
+    .arith_sig          (arith_sig),                //output [66:0]
+    .arith_zero         (arith_zero),               //output
+    
+    .arith_quotient     (arith_quotient),           //output [2:0]
+    .arith_partial      (arith_partial)             //output
+);
+
+//------------------------------------------------------------------------------ rounding
+
+wire        round_sign;
+wire [19:0] round_exp;
+wire [66:0] round_sig;
+wire        round_zero;
+wire [1:0]  round_precision;
+wire [1:0]  round_range;
+
+wire        round_out_sign;
+wire [19:0] round_out_exp;
+wire [63:0] round_out_sig;
+wire        round_out_inf;
+wire        round_out_zero;
+wire        round_out_precision;
+wire        round_out_underflow;
+wire        round_out_tiny;
+wire        round_out_overflow;
+wire        round_out_roundup;
+
+wire store_m32;
+wire store_m64;
+wire store_int;
+
+assign store_m32 = ins_store && fmt_m32;
+assign store_m64 = ins_store && fmt_m64;
+assign store_int = ins_store && (fmt_i16 || fmt_i32 || fmt_i64 || fmt_bcd);
+
+//transcendental steps: the engine result rounded to nearest without exponent limits, the FIN step rounds its operand
+wire round_step;
+wire round_eng;
+wire round_fin;
+
+assign round_step = fpu_state == STATE_TRANS && ~(u_fin);
+assign round_eng  = fpu_state == STATE_ARITH || round_step;
+assign round_fin  = fpu_state == STATE_TRANS && u_fin;
+
+assign round_sign =
+    (round_eng)?                    arith_sign :
+    (round_fin)?                    trans_a_sign :
+    (ins_const)?                    1'b0 :
+    (ins_fpatan)?                   fy_sign :
+                                    fx_sign;
+
+assign round_exp =
+    (round_eng)?                    arith_exp :
+    (round_fin)?                    trans_a_exp :
+    (ins_const)?                    const_exp :
+    (ins_fpatan)?                   tr_const_exp :
+    (ins_fscale)?                   sc_exp :
+                                    fx_uexp;
+
+assign round_sig =
+    (round_eng)?                    arith_sig :
+    (round_fin)?                    { trans_a_sig, 3'd0 } :
+    (ins_const)?                    const_sig :
+    (ins_fpatan)?                   tr_const_sig :
+                                    { fx_usig, 3'd0 };
+
+assign round_zero =
+    (round_eng)?                    arith_zero :
+    (round_fin)?                    trans_a_zero :
+    (ins_const)?                    dec_rm == 3'd6 :
+    (ins_fpatan)?                   `FALSE :
+                                    fx_zero;
+
+assign round_precision =
+    (ins_arith || ins_fsqrt)?       fpu_cw[9:8] :
+    (store_m32)?                    `FPU_PRECISION_SINGLE :
+    (store_m64)?                    `FPU_PRECISION_DOUBLE :
+                                    2'd3;
+
+assign round_range =
+    (store_m32)?                    `FPU_RANGE_SINGLE :
+    (store_m64)?                    `FPU_RANGE_DOUBLE :
+    (store_int || ins_frndint)?     `FPU_RANGE_INTEGER :
+                                    `FPU_RANGE_EXTENDED;
+
+execute_fpu_round execute_fpu_round_inst(
+    .round_sign             (round_sign),               //input
+    .round_exp              (round_exp),                //input [19:0]
+    .round_sig              (round_sig),                //input [66:0]
+    .round_zero             (round_zero),               //input
+    
+    .round_precision        (round_precision),          //input [1:0]
+    .round_range            (round_range),              //input [1:0]
+    .round_rc               ((round_step)? `FPU_RC_NEAREST : fpu_cw[11:10]),  //input [1:0]
+    .round_bounded          (~(round_step)),            //input
+    .round_register         (~(ins_store)),             //input
+    .round_overflow_masked  (fpu_cw[3]),                //input
+    .round_underflow_masked (fpu_cw[4]),                //input
+    
+    //output
+    .round_out_sign         (round_out_sign),           //output
+    .round_out_exp          (round_out_exp),            //output [19:0]
+    .round_out_sig          (round_out_sig),            //output [63:0]
+    .round_out_inf          (round_out_inf),            //output
+    .round_out_zero         (round_out_zero),           //output
+    
+    .round_out_precision    (round_out_precision),      //output
+    .round_out_underflow    (round_out_underflow),      //output
+    .round_out_tiny         (round_out_tiny),           //output
+    .round_out_overflow     (round_out_overflow),       //output
+    .round_out_roundup      (round_out_roundup)         //output
+);
+
+//------------------------------------------------------------------------------ result formats
+
+wire [79:0] rnd_ext;
+wire [14:0] rnd_m32_exp;
+wire [14:0] rnd_m64_exp;
+wire [31:0] rnd_m32;
+wire [63:0] rnd_m64;
+
+assign rnd_ext =
+    (round_out_zero)?   { round_out_sign, 79'd0 } :
+    (round_out_inf)?    { round_out_sign, 15'h7FFF, 64'h8000000000000000 } :
+                        { round_out_sign, (round_out_sig[63])? round_out_exp[14:0] : 15'd0, round_out_sig };
+
+assign rnd_m32_exp = round_out_exp[14:0] - 15'd16256;
+assign rnd_m64_exp = round_out_exp[14:0] - 15'd15360;
+
+assign rnd_m32 =
+    (round_out_zero)?   { round_out_sign, 31'd0 } :
+    (round_out_inf)?    { round_out_sign, 8'hFF, 23'd0 } :
+                        { round_out_sign, (round_out_sig[63])? rnd_m32_exp[7:0] : 8'd0, round_out_sig[62:40] };
+
+assign rnd_m64 =
+    (round_out_zero)?   { round_out_sign, 63'd0 } :
+    (round_out_inf)?    { round_out_sign, 11'h7FF, 52'd0 } :
+                        { round_out_sign, (round_out_sig[63])? rnd_m64_exp[10:0] : 11'd0, round_out_sig[62:11] };
+
+//integers: the rounded value has its LSB at 2^0 unless it does not fit in 64 bits
+wire [63:0] rnd_int_mag;
+wire        rnd_int_overflow;
+wire [63:0] rnd_int;
+
+assign rnd_int_mag = (round_out_zero)? 64'd0 : round_out_sig;
+
+assign rnd_int_overflow =
+    (~(round_out_zero) && round_out_exp != 20'd16446) ||
+    (fmt_i16 && rnd_int_mag > ((round_out_sign)? 64'd32768 : 64'd32767)) ||
+    (fmt_i32 && rnd_int_mag > ((round_out_sign)? 64'd2147483648 : 64'd2147483647)) ||
+    (fmt_i64 && rnd_int_mag > ((round_out_sign)? 64'h8000000000000000 : 64'h7FFFFFFFFFFFFFFF)) ||
+    (fmt_bcd && rnd_int_mag > 64'd999999999999999999);
+
+assign rnd_int = (round_out_sign)? -rnd_int_mag : rnd_int_mag;
+
+//FRNDINT and FXTRACT: integer to extended
+wire [63:0] aux_int;
+wire [66:0] aux_norm_out;
+wire [6:0]  aux_norm_shift;
+
+wire [19:0] xt_exp;
+wire [19:0] xt_exp_abs;
+
+assign xt_exp     = fx_uexp - 20'd16383;
+assign xt_exp_abs = (xt_exp[19])? -xt_exp : xt_exp;
+
+assign aux_int = (ins_fxtract)? { 44'd0, xt_exp_abs } : rnd_int_mag;
+
+execute_fpu_normalize aux_normalize_inst(
+    .norm_in        ({ aux_int, 3'd0 }),    //input [66:0]
+    .norm_out       (aux_norm_out),         //output [66:0]
+    .norm_shift     (aux_norm_shift)        //output [6:0]
+);
+
+wire [19:0] rndint_exp;
+wire [79:0] rndint_ext;
+wire [79:0] xt_exp_ext;
+
+assign rndint_exp = round_out_exp - { 13'd0, aux_norm_shift };
+
+assign rndint_ext =
+    (round_out_zero)?   { round_out_sign, 79'd0 } :
+                        { round_out_sign, rndint_exp[14:0], aux_norm_out[66:3] };
+
+assign xt_exp_ext =
+    (xt_exp == 20'd0)?  80'd0 :
+                        { xt_exp[19], 15'd16446 - { 8'd0, aux_norm_shift }, aux_norm_out[66:3] };
+
+//------------------------------------------------------------------------------ instruction results
+
+wire cw_im;
+wire cw_dm;
+wire cw_zm;
+wire cw_om;
+wire cw_um;
+
+assign cw_im = fpu_cw[0];
+assign cw_dm = fpu_cw[1];
+assign cw_zm = fpu_cw[2];
+assign cw_om = fpu_cw[3];
+assign cw_um = fpu_cw[4];
+
+//exceptions raised before the result is computed: an unmasked one leaves the registers unchanged
+wire ar_ie;
+wire ar_ze;
+wire ar_de;
+wire ar_abort;
+wire ar_special;
+wire [79:0] ar_value;
+
+assign ar_ie = ar_underflow || ar_invalid;
+assign ar_ze = ~(ar_ie) && ar_zero_divide;
+assign ar_de = ~(ar_ie) && ar_denormal;
+
+assign ar_abort   = (ar_ie && ~(cw_im)) || (ar_ze && ~(cw_zm)) || (ar_de && ~(cw_dm));
+assign ar_special = ar_ie || ar_nan || ar_zero_divide || ar_inf || ar_zero || ar_abort;
+
+assign ar_value =
+    (ar_underflow)?             nan_indefinite :
+    (ar_nan)?                   nan_xy :
+    (ar_invalid)?               nan_indefinite :
+    (ar_inf)?                   { ar_inf_sign, 15'h7FFF, 64'h8000000000000000 } :
+    (ar_zero)?                  { ar_a_sign ^ ar_b_sign, 79'd0 } :
+                                rnd_ext;
+
+wire sq_ie;
+wire sq_de;
+wire sq_abort;
+wire sq_special;
+wire [79:0] sq_value;
+
+assign sq_ie = fx_empty || sq_invalid;
+assign sq_de = ~(sq_ie) && fx_denormal;
+
+assign sq_abort   = (sq_ie && ~(cw_im)) || (sq_de && ~(cw_dm));
+assign sq_special = sq_ie || fx_nan || fx_zero || fx_inf || sq_abort;
+
+assign sq_value =
+    (fx_empty)?                 nan_indefinite :
+    (fx_nan || fx_unsupported)? nan_x :
+    (sq_invalid)?               nan_indefinite :
+    (fx_zero || fx_inf)?        fx :
+                                rnd_ext;
+
+wire rem_ie;
+wire rem_de;
+wire rem_abort;
+wire rem_special;
+wire [79:0] rem_value;
+
+assign rem_ie = rem_underflow || rem_invalid;
+assign rem_de = ~(rem_ie) && rem_denormal;
+
+assign rem_abort   = (rem_ie && ~(cw_im)) || (rem_de && ~(cw_dm));
+assign rem_special = rem_ie || ar_nan || rem_unchanged || rem_abort;
+
+assign rem_value =
+    (rem_underflow)?            nan_indefinite :
+    (ar_nan)?                   nan_xy :
+    (rem_invalid)?              nan_indefinite :
+    (rem_unchanged)?            fx :
+                                rnd_ext;
+
+wire cmp_ie;
+wire cmp_de;
+wire cmp_abort;
+
+assign cmp_ie = cmp_underflow || cmp_invalid;
+assign cmp_de = ~(cmp_ie) && cmp_denormal;
+
+assign cmp_abort = (cmp_ie && ~(cw_im)) || (cmp_de && ~(cw_dm));
+
+wire ld_underflow;
+wire ld_overflow;
+wire ld_invalid;
+wire ld_de;
+wire ld_abort;
+wire [79:0] ld_value;
+
+assign ld_underflow = ins_load_reg && fy_empty;
+assign ld_overflow  = ~(ld_underflow) && f_full;
+assign ld_invalid   = ~(ld_underflow) && ~(ld_overflow) && (fmt_m32 || fmt_m64) && fy_snan;
+assign ld_de        = ~(ld_underflow) && ~(ld_overflow) && fy_mem_denormal;
+
+assign ld_abort = (ld_underflow || ld_overflow || ld_invalid) && ~(cw_im);
+
+assign ld_value =
+    (ld_underflow || ld_overflow)?  nan_indefinite :
+    (ld_invalid)?                   { fy[79:63], 1'b1, fy[61:0] } :
+    (ins_const)?                    rnd_ext :
+                                    fy;
+
+//stores to memory
+wire        stm_nan;
+wire        stm_ie;
+wire        stm_post_abort;
+wire        stm_abort;
+wire [79:0] stm_indefinite;
+wire [79:0] stm_value;
+
+assign stm_nan = fx_nan || fx_unsupported || fx_inf;
+
+assign stm_ie =
+    fx_empty ||
+    ((store_m32 || store_m64) && (fx_snan || fx_unsupported)) ||
+    (store_int && (stm_nan || rnd_int_overflow));
+
+//overflow and underflow of the memory format are raised before the store
+assign stm_post_abort = (store_m32 || store_m64) && ~(stm_ie) && ~(stm_nan) && ((round_out_overflow && ~(cw_om)) || (round_out_underflow && ~(cw_um)));
+
+assign stm_abort = (stm_ie && ~(cw_im)) || stm_post_abort;
+
+assign stm_indefinite =
+    (store_m32)?    80'h000000000000FFC00000 :
+    (store_m64)?    80'h0000FFF8000000000000 :
+    (fmt_i16)?      80'h00000000000000008000 :
+    (fmt_i32)?      80'h00000000000080000000 :
+    (fmt_i64)?      80'h00008000000000000000 :
+                    nan_indefinite;
+
+assign stm_value =
+    (stm_ie && (fx_empty || fx_unsupported || store_int))?  stm_indefinite :
+    (fmt_m80)?                                              fx :
+    (store_m32 && fx_nan)?                                  { 48'd0, fx_sign, 8'hFF, 1'b1, fx_sig[61:40] } :
+    (store_m32 && fx_inf)?                                  { 48'd0, fx_sign, 8'hFF, 23'd0 } :
+    (store_m32)?                                            { 48'd0, rnd_m32 } :
+    (store_m64 && fx_nan)?                                  { 16'd0, fx_sign, 11'h7FF, 1'b1, fx_sig[61:11] } :
+    (store_m64 && fx_inf)?                                  { 16'd0, fx_sign, 11'h7FF, 52'd0 } :
+    (store_m64)?                                            { 16'd0, rnd_m64 } :
+    (fmt_i16)?                                              { 64'd0, rnd_int[15:0] } :
+    (fmt_i32)?                                              { 48'd0, rnd_int[31:0] } :
+                                                            { 16'd0, rnd_int };
+
+//FST, FSTP, FXCH, FCHS, FABS: register copies, only the stack faults
+wire        reg_ie;
+wire        reg_abort;
+
+assign reg_ie = fx_empty || (ins_fxch && fy_empty);
+
+assign reg_abort = reg_ie && ~(cw_im);
+
+wire rnd_ie;
+wire rnd_de;
+wire rnd_abort;
+wire rnd_special;
+wire [79:0] rnd_value;
+
+assign rnd_ie = fx_empty || fx_snan || fx_unsupported;
+assign rnd_de = ~(rnd_ie) && fx_denormal;
+
+assign rnd_abort   = (rnd_ie && ~(cw_im)) || (rnd_de && ~(cw_dm));
+assign rnd_special = rnd_ie || fx_nan || fx_inf || fx_zero || rnd_abort;
+
+assign rnd_value =
+    (fx_empty)?                 nan_indefinite :
+    (fx_nan || fx_unsupported)? nan_x :
+    (fx_inf || fx_zero)?        fx :
+                                rndint_ext;
+
+wire sc_ie;
+wire sc_de;
+wire sc_abort;
+wire sc_special;
+wire [79:0] sc_value;
+
+assign sc_ie = fx_empty || fy_empty || sc_invalid;
+assign sc_de = ~(sc_ie) && ~(ar_nan) && (fx_denormal || fy_denormal);
+
+assign sc_abort   = (sc_ie && ~(cw_im)) || (sc_de && ~(cw_dm));
+assign sc_special = sc_ie || ar_nan || fx_zero || fx_inf || fy_inf || sc_abort;
+
+assign sc_value =
+    (fx_empty || fy_empty)?     nan_indefinite :
+    (ar_nan)?                   nan_xy :
+    (sc_invalid)?               nan_indefinite :
+    (fx_zero || fx_inf)?        fx :
+    (fy_inf && ~(fy_sign))?     { fx_sign, 15'h7FFF, 64'h8000000000000000 } :
+    (fy_inf)?                   { fx_sign, 79'd0 } :
+                                rnd_ext;
+
+wire xt_ie;
+wire xt_ze;
+wire xt_de;
+wire xt_abort;
+wire [79:0] xt_value;
+wire [79:0] xt_value2;
+
+assign xt_ie = fx_empty || f_full || fx_snan || fx_unsupported;
+assign xt_ze = ~(xt_ie) && fx_zero;
+assign xt_de = ~(xt_ie) && fx_denormal;
+
+assign xt_abort = (xt_ie && ~(cw_im)) || (xt_ze && ~(cw_zm)) || (xt_de && ~(cw_dm));
+
+//exponent to ST(1), significand pushed
+assign xt_value =
+    (fx_empty || f_full)?       nan_indefinite :
+    (fx_nan || fx_unsupported)? nan_x :
+    (fx_zero)?                  { 1'b1, 15'h7FFF, 64'h8000000000000000 } :
+    (fx_inf)?                   { 1'b0, 15'h7FFF, 64'h8000000000000000 } :
+                                xt_exp_ext;
+
+assign xt_value2 =
+    (fx_empty || f_full)?       nan_indefinite :
+    (fx_nan || fx_unsupported)? nan_x :
+    (fx_zero || fx_inf)?        fx :
+                                { fx_sign, 15'd16383, fx_usig };
+
+//transcendentals: X = ST(0), Y = ST(1)
+wire tr_two;
+wire tr_push;
+wire tr_trig;
+wire tr_x_one;
+wire tr_below_one;
+
+assign tr_two  = ins_fyl2x || ins_fyl2xp1 || ins_fpatan;
+assign tr_push = ins_fptan || ins_fsincos;
+assign tr_trig = ins_fptan || ins_fsin || ins_fcos || ins_fsincos;
+
+assign tr_x_one     = fx == 80'h3FFF8000000000000000;
+assign tr_below_one = fx_exp < 15'd16383;
+
+wire tr_underflow;
+wire tr_overflow;
+wire tr_nan;
+wire tr_invalid;
+wire tr_range;
+wire tr_ie;
+wire tr_ze;
+wire tr_de;
+wire tr_abort;
+
+assign tr_underflow = fx_empty || (tr_two && fy_empty);
+assign tr_overflow  = ~(tr_underflow) && tr_push && f_full;
+
+assign tr_nan = fx_nan || fx_unsupported || (tr_two && (fy_nan || fy_unsupported));
+
+assign tr_invalid = fx_snan || fx_unsupported || (tr_two && (fy_snan || fy_unsupported)) || (~(tr_nan) && (
+    (tr_trig && fx_inf) ||
+    (ins_fyl2x && ((fx_zero && fy_zero) || (fx_sign && ~(fx_zero)) || (tr_x_one && fy_inf) || (fx_inf && fy_zero))) ||
+    (ins_fyl2xp1 && ((fx_inf && (fx_sign || fy_zero)) || (fx_zero && fy_inf)))));
+
+//FSIN, FCOS, FSINCOS, FPTAN: |x| >= 2^63 is left unchanged with C2 set
+assign tr_range = tr_trig && ~(tr_underflow) && ~(tr_overflow) && ~(tr_nan) && ~(fx_inf) && fx_exp >= 15'd16446;
+
+assign tr_ie = tr_underflow || tr_overflow || tr_invalid;
+assign tr_ze = ~(tr_ie) && ~(tr_nan) && ins_fyl2x && fx_zero && ~(fy_zero) && ~(fy_inf);
+assign tr_de = ~(tr_ie) && ~(tr_ze) && ~(tr_nan) && ~(tr_range) && (fx_denormal || (tr_two && fy_denormal));
+
+assign tr_abort = (tr_ie && ~(cw_im)) || (tr_ze && ~(cw_zm)) || (tr_de && ~(cw_dm));
+
+//zero and infinite operands
+wire tr_lg_special;
+wire tr_lp_special;
+wire tr_at_special;
+wire tr_at_zero;
+wire tr_at_const;
+wire tr_special;
+
+assign tr_lg_special = fx_zero || fx_inf || fy_zero || fy_inf || tr_x_one;
+assign tr_lp_special = fx_zero || fx_inf || fy_zero || fy_inf;
+assign tr_at_special = fx_zero || fx_inf || fy_zero || fy_inf;
+assign tr_at_zero    = ~(fy_inf) && ~(fx_sign) && (fy_zero || fx_inf);
+
+assign tr_at_const = ins_fpatan && tr_at_special && ~(tr_at_zero) && ~(tr_ie) && ~(tr_nan) && ~(tr_abort);
+
+assign tr_special = tr_ie || tr_nan || tr_ze || tr_range || tr_abort || fx_zero || fx_inf ||
+    (ins_fyl2x && tr_lg_special) || (ins_fyl2xp1 && tr_lp_special) || (ins_fpatan && tr_at_special);
+
+wire [79:0] tr_one;
+wire [79:0] tr_lg_value;
+wire [79:0] tr_lp_value;
+wire [79:0] tr_value;
+wire [79:0] tr_value2;
+
+assign tr_one = 80'h3FFF8000000000000000;
+
+assign tr_lg_value =
+    (fx_zero)?                  { ~(fy_sign), 15'h7FFF, 64'h8000000000000000 } :
+    (fx_inf || fy_inf)?         { fy_sign ^ tr_below_one, 15'h7FFF, 64'h8000000000000000 } :
+                                { fy_sign ^ tr_below_one, 79'd0 };
+
+assign tr_lp_value =
+    (fx_inf || fy_inf)?         { fy_sign ^ fx_sign, 15'h7FFF, 64'h8000000000000000 } :
+                                { fy_sign ^ fx_sign, 79'd0 };
+
+//FPTAN and FSINCOS: the tangent or sine replaces X, 1 or the cosine is pushed
+assign tr_value =
+    (tr_underflow || tr_overflow)?      nan_indefinite :
+    (tr_nan && tr_two)?                 nan_xy :
+    (tr_nan)?                           nan_x :
+    (tr_invalid)?                       nan_indefinite :
+    (ins_fyl2x && tr_lg_special)?       tr_lg_value :
+    (ins_fyl2xp1 && tr_lp_special)?     tr_lp_value :
+    (ins_fpatan && tr_at_zero)?         { fy_sign, 79'd0 } :
+    (ins_fpatan && tr_at_special)?      rnd_ext :
+    (ins_fcos && fx_zero)?              tr_one :
+    (ins_f2xm1 && fx_inf && fx_sign)?   { 1'b1, 15'd16383, 64'h8000000000000000 } :
+    (fx_zero || fx_inf)?                fx :
+    (ins_fsincos)?                      trans_r1 :
+                                        rnd_ext;
+
+assign tr_value2 =
+    (tr_underflow || tr_overflow)?      nan_indefinite :
+    (tr_nan)?                           nan_x :
+    (tr_invalid)?                       nan_indefinite :
+    (ins_fsincos && ~(fx_zero))?        rnd_ext :
+                                        tr_one;
+
+//the last FIN step rounds in the transcendental state; every nonzero result is inexact, so every tiny one underflows
+wire tr_done;
+wire tr_pe;
+wire tr_ue;
+wire tr_oe;
+
+assign tr_done = fpu_state == STATE_TRANS;
+
+assign tr_pe = (tr_done)? trans_pe || ~(round_out_zero) || round_out_tiny : tr_at_const && round_out_precision;
+assign tr_ue = tr_done && (trans_ue || round_out_tiny);
+assign tr_oe = tr_done && (trans_oe || round_out_overflow);
+
+//------------------------------------------------------------------------------ outcome
+
+wire eng_done;
+
+assign eng_done = fpu_state == STATE_ARITH;
+
+wire g_reg;
+wire g_rem;
+
+assign g_reg = ins_store_reg || ins_fxch || ins_fchs || ins_fabs;
+assign g_rem = ins_fprem || ins_fprem1;
+
+wire g_abort;
+
+assign g_abort =
+    (ins_arith)?        ar_abort :
+    (ins_fsqrt)?        sq_abort :
+    (g_rem)?            rem_abort :
+    (ins_compare)?      cmp_abort :
+    (ins_load)?         ld_abort :
+    (ins_store)?        stm_abort :
+    (g_reg)?            reg_abort :
+    (ins_frndint)?      rnd_abort :
+    (ins_fscale)?       sc_abort :
+    (ins_fxtract)?      xt_abort :
+    (ins_transcendental)?   tr_abort :
+                        `FALSE;
+
+wire        r_write;
+wire [2:0]  r_dest;
+wire [79:0] r_value;
+wire        r_write2;
+wire [2:0]  r_dest2;
+wire [79:0] r_value2;
+wire [1:0]  r_pop;
+wire        r_push;
+wire        r_incstp;
+wire        r_decstp;
+wire        r_free;
+wire [5:0]  r_exc;
+wire        r_sf;
+wire        r_c1;
+wire [3:0]  r_cc;
+wire [3:0]  r_cc_mask;
+wire        r_cw_write;
+wire [15:0] r_cw;
+wire        r_init;
+wire        r_clex;
+wire        r_skip;
+
+assign r_write = ~(g_abort) && (ins_arith || ins_fsqrt || g_rem || ins_load || g_reg || ins_frndint || ins_fscale || ins_fxtract || (ins_transcendental && ~(tr_range)));
+
+assign r_dest =
+    (ins_arith && dec_reg && dec_esc[2])?   dec_rm :
+    (ins_store_reg)?                        dec_rm :
+    (ins_load)?                             3'd7 :
+    (tr_two)?                               3'd1 :
+                                            3'd0;
+
+wire [79:0] reg_x;
+
+assign reg_x = (fx_empty)? nan_indefinite : fx;
+
+assign r_value =
+    (ins_arith)?                ar_value :
+    (ins_fsqrt)?                sq_value :
+    (g_rem)?                    rem_value :
+    (ins_load)?                 ld_value :
+    (ins_store && fmt_bcd && ~(stm_ie))?    { fx_sign, 7'd0, bcd_digits } :
+    (ins_store)?                stm_value :
+    (ins_store_reg)?            reg_x :
+    (ins_fxch)?                 ((fy_empty)? nan_indefinite : fy) :
+    ((ins_fchs || ins_fabs) && fx_empty)?   nan_indefinite :
+    (ins_fchs)?                 { ~(fx[79]), fx[78:0] } :
+    (ins_fabs)?                 { 1'b0, fx[78:0] } :
+    (ins_frndint)?              rnd_value :
+    (ins_fscale)?               sc_value :
+    (ins_fxtract)?              xt_value :
+    (ins_transcendental)?       tr_value :
+    (ins_fstcw)?                { 64'd0, fpu_cw } :
+                                { 64'd0, fpu_sw };
+
+assign r_write2 = ~(g_abort) && (ins_fxch || ins_fxtract || (tr_push && ~(tr_range)));
+assign r_dest2  = (ins_fxch)? dec_rm : 3'd7;
+assign r_value2 = (ins_fxch)? reg_x : (ins_fxtract)? xt_value2 : tr_value2;
+
+assign r_pop =
+    (g_abort)?          2'd0 :
+    (ins_pop2)?         2'd2 :
+    (ins_pop)?          2'd1 :
+                        2'd0;
+
+assign r_push   = ~(g_abort) && (ins_load || ins_fxtract || (tr_push && ~(tr_range)));
+assign r_incstp = ins_fincstp;
+assign r_decstp = ins_fdecstp;
+assign r_free   = ins_ffree;
+
+//PE, UE, OE, ZE, DE, IE
+assign r_exc =
+    (ins_arith)?        { eng_done && round_out_precision, eng_done && round_out_underflow, eng_done && round_out_overflow, ar_ze, ar_de, ar_ie } :
+    (ins_fsqrt)?        { eng_done && round_out_precision, eng_done && round_out_underflow, eng_done && round_out_overflow, 1'b0, sq_de, sq_ie } :
+    (g_rem)?            { eng_done && round_out_precision, eng_done && round_out_underflow, eng_done && round_out_overflow, 1'b0, rem_de, rem_ie } :
+    (ins_compare)?      { 4'd0, cmp_de, cmp_ie } :
+    (ins_load)?         { 4'd0, ld_de, ld_underflow || ld_overflow || ld_invalid } :
+    (ins_store && stm_ie)?                      6'b000001 :
+    (ins_store && stm_post_abort)?              { 1'b0, round_out_underflow, round_out_overflow, 3'd0 } :
+    (ins_store && (fmt_m80 || stm_nan))?        6'd0 :
+    (ins_store)?        { round_out_precision, round_out_underflow, round_out_overflow, 3'd0 } :
+    (g_reg)?            { 5'd0, reg_ie } :
+    (ins_frndint)?      { ~(rnd_special) && round_out_precision, 3'd0, rnd_de, rnd_ie } :
+    (ins_fscale)?       { ~(sc_special) && round_out_precision, ~(sc_special) && round_out_underflow, ~(sc_special) && round_out_overflow, 1'b0, sc_de, sc_ie } :
+    (ins_fxtract)?      { 3'd0, xt_ze, xt_de, xt_ie } :
+    (ins_transcendental)?   { tr_pe, tr_ue, tr_oe, tr_ze, tr_de, tr_ie } :
+                        6'd0;
+
+assign r_sf =
+    (ins_arith)?        ar_underflow :
+    (g_rem)?            rem_underflow :
+    (ins_compare)?      cmp_underflow :
+    (ins_load)?         ld_underflow || ld_overflow :
+    (ins_fscale)?       fx_empty || fy_empty :
+    (ins_fxtract)?      fx_empty || f_full :
+    (ins_transcendental)?   tr_underflow || tr_overflow :
+    (g_reg)?            reg_ie :
+    (ins_fsqrt || ins_store || ins_frndint)?    fx_empty :
+                        `FALSE;
+
+assign r_c1 =
+    (ins_arith || ins_fsqrt)?   eng_done && round_out_roundup :
+    (ins_load)?                 ld_overflow :
+    (ins_store)?                ~(stm_ie) && ~(stm_post_abort) && ~(fmt_m80) && ~(stm_nan) && round_out_roundup :
+    (ins_frndint)?              ~(rnd_special) && round_out_roundup :
+    (ins_fscale)?               ~(sc_special) && round_out_roundup :
+    (ins_fxtract)?              ~(fx_empty) && f_full :
+    (ins_transcendental)?       tr_overflow || ((tr_done || tr_at_const) && round_out_roundup) :
+                                `FALSE;
+
+assign r_cc =
+    (ins_compare)?                  cmp_cc :
+    (ins_fxam)?                     xam_cc :
+    (g_rem && eng_done && arith_partial)?   4'b0100 :
+    (g_rem && eng_done)?            { arith_quotient[1], 1'b0, arith_quotient[0], arith_quotient[2] } :
+    (g_rem)?                        4'd0 :
+    (tr_trig)?                      { 1'b0, tr_range, r_c1, 1'b0 } :
+                                    { 2'd0, r_c1, 1'b0 };
+
+assign r_cc_mask =
+    (ins_compare || ins_fxam)?      4'b1111 :
+    (g_rem && (eng_done || rem_unchanged))? 4'b1111 :
+    (g_rem || tr_trig)?             4'b0110 :
+    (ins_control || ins_fnop)?      4'b0000 :
+                                    4'b0010;
+
+assign r_cw_write = ins_fldcw || (ins_env_store && ~(ins_env_full));
+assign r_cw       = (ins_fldcw)? { 3'd0, src[12:8], 2'b01, src[5:0] } : { fpu_cw[15:6], 6'h3F };
+
+assign r_init = ins_fninit || (ins_env_store && ins_env_full);
+assign r_clex = ins_fnclex;
+assign r_skip = ins_store && stm_abort;
+
+//------------------------------------------------------------------------------ state machine
+
+wire fpu_engine_start;
+wire fpu_bcd_start;
+wire fpu_finish;
+wire trans_advance;
+
+//a transcendental step is done when its engine operation is, FIN and skipped steps take one cycle
+assign trans_advance = fpu_state == STATE_TRANS && (u_fin || u_skip || (trans_started && ~(arith_busy)));
+
+assign fpu_engine_start =
+    (ins_arith && ~(ar_special)) || (ins_fsqrt && ~(sq_special)) || (g_rem && ~(rem_special)) || (ins_transcendental && ~(tr_special));
+
+assign fpu_bcd_start = ins_store && fmt_bcd && ~(stm_ie);
+
+assign arith_start =
+    (fpu_state == STATE_EXECUTE && fpu_engine_start && ~(ins_transcendental)) ||
+    (fpu_state == STATE_TRANS && ~(trans_started) && ~(u_fin) && ~(u_skip));
+
+assign fpu_finish =
+    (fpu_state == STATE_EXECUTE && ~(fpu_engine_start) && ~(fpu_bcd_start)) ||
+    (fpu_state == STATE_ARITH && ~(arith_busy)) ||
+    (trans_advance && u_last) ||
+    (fpu_state == STATE_BCD_STORE && bcd_counter == 7'd0);
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_state <= STATE_IDLE;
+    else if(exe_reset)                                      fpu_state <= STATE_IDLE;
+    else if(fpu_start && fmt_bcd && ins_load)               fpu_state <= STATE_BCD_LOAD;
+    else if(fpu_start)                                      fpu_state <= STATE_EXECUTE;
+    else if(fpu_latch)                                      fpu_state <= STATE_EXECUTE;
+    else if(fpu_finish)                                     fpu_state <= STATE_IDLE;
+    else if(fpu_state == STATE_EXECUTE && fpu_bcd_start)    fpu_state <= STATE_BCD_STORE;
+    else if(fpu_state == STATE_EXECUTE && ins_transcendental)   fpu_state <= STATE_TRANS;
+    else if(fpu_state == STATE_EXECUTE)                     fpu_state <= STATE_ARITH;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_done <= `FALSE;
+    else if(exe_reset)                                      fpu_done <= `FALSE;
+    else if(exe_ready && fpu_cmd && fpu_last)               fpu_done <= `FALSE;
+    else if(fpu_finish)                                     fpu_done <= `TRUE;
+end
+
+//------------------------------------------------------------------------------ transcendental sequencer
+
+wire trans_write;
+
+assign trans_write = trans_advance && trans_started;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_step <= 5'd0;
+    else if(fpu_start)                                          trans_step <= 5'd0;
+    else if(trans_advance && u_loop && trans_k != 5'd1)         trans_step <= trans_step - 5'd1;
+    else if(trans_advance)                                      trans_step <= trans_step + 5'd1;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_k <= 5'd0;
+    else if(trans_advance && u_init)                            trans_k <= trans_series_top;
+    else if(trans_advance && u_loop)                            trans_k <= trans_k - 5'd1;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_started <= `FALSE;
+    else if(exe_reset || trans_advance)                         trans_started <= `FALSE;
+    else if(fpu_state == STATE_TRANS && arith_start)            trans_started <= `TRUE;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_q <= 2'd0;
+    else if(trans_write && trans_step == 5'd0 && tr_trig)       trans_q <= arith_quotient[1:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_reduce <= `FALSE;
+    else if(trans_write && trans_step == 5'd0 && ins_fpatan)    trans_reduce <= { ~(round_out_exp[19]), round_out_exp[18:0], round_out_sig, 3'd0 } > { 1'b1, 19'd16381, 67'h4498517A7B3558C4E };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_t0 <= 86'd0;
+    else if(trans_write && u_dest == 2'd0)                      trans_t0 <= { round_out_zero, round_out_sign, round_out_exp, round_out_sig };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_t1 <= 86'd0;
+    else if(trans_write && u_dest == 2'd1)                      trans_t1 <= { round_out_zero, round_out_sign, round_out_exp, round_out_sig };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_t2 <= 86'd0;
+    else if(trans_write && u_dest == 2'd2)                      trans_t2 <= { round_out_zero, round_out_sign, round_out_exp, round_out_sig };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                           trans_t3 <= 86'd0;
+    else if(trans_write && u_dest == 2'd3)                      trans_t3 <= { round_out_zero, round_out_sign, round_out_exp, round_out_sig };
+end
+
+//FSINCOS: the sine is rounded first and kept until the cosine is done
+always @(posedge clk) begin if(rst_n == 1'b0) trans_r1 <= 80'd0;   else if(trans_advance && u_fin && ~(u_last)) trans_r1 <= rnd_ext;             end
+always @(posedge clk) begin if(rst_n == 1'b0) trans_pe <= `FALSE;  else if(fpu_start) trans_pe <= `FALSE; else if(trans_advance && u_fin && ~(u_last)) trans_pe <= ~(round_out_zero) || round_out_tiny;      end
+always @(posedge clk) begin if(rst_n == 1'b0) trans_ue <= `FALSE;  else if(fpu_start) trans_ue <= `FALSE; else if(trans_advance && u_fin && ~(u_last)) trans_ue <= round_out_tiny;        end
+always @(posedge clk) begin if(rst_n == 1'b0) trans_oe <= `FALSE;  else if(fpu_start) trans_oe <= `FALSE; else if(trans_advance && u_fin && ~(u_last)) trans_oe <= round_out_overflow;    end
+
+//------------------------------------------------------------------------------ BCD store: double dabble
+
+wire [71:0] bcd_adjusted;
+
+assign bcd_adjusted = {
+    (bcd_digits[71:68] >= 4'd5)? bcd_digits[71:68] + 4'd3 : bcd_digits[71:68],
+    (bcd_digits[67:64] >= 4'd5)? bcd_digits[67:64] + 4'd3 : bcd_digits[67:64],
+    (bcd_digits[63:60] >= 4'd5)? bcd_digits[63:60] + 4'd3 : bcd_digits[63:60],
+    (bcd_digits[59:56] >= 4'd5)? bcd_digits[59:56] + 4'd3 : bcd_digits[59:56],
+    (bcd_digits[55:52] >= 4'd5)? bcd_digits[55:52] + 4'd3 : bcd_digits[55:52],
+    (bcd_digits[51:48] >= 4'd5)? bcd_digits[51:48] + 4'd3 : bcd_digits[51:48],
+    (bcd_digits[47:44] >= 4'd5)? bcd_digits[47:44] + 4'd3 : bcd_digits[47:44],
+    (bcd_digits[43:40] >= 4'd5)? bcd_digits[43:40] + 4'd3 : bcd_digits[43:40],
+    (bcd_digits[39:36] >= 4'd5)? bcd_digits[39:36] + 4'd3 : bcd_digits[39:36],
+    (bcd_digits[35:32] >= 4'd5)? bcd_digits[35:32] + 4'd3 : bcd_digits[35:32],
+    (bcd_digits[31:28] >= 4'd5)? bcd_digits[31:28] + 4'd3 : bcd_digits[31:28],
+    (bcd_digits[27:24] >= 4'd5)? bcd_digits[27:24] + 4'd3 : bcd_digits[27:24],
+    (bcd_digits[23:20] >= 4'd5)? bcd_digits[23:20] + 4'd3 : bcd_digits[23:20],
+    (bcd_digits[19:16] >= 4'd5)? bcd_digits[19:16] + 4'd3 : bcd_digits[19:16],
+    (bcd_digits[15:12] >= 4'd5)? bcd_digits[15:12] + 4'd3 : bcd_digits[15:12],
+    (bcd_digits[11:8]  >= 4'd5)? bcd_digits[11:8]  + 4'd3 : bcd_digits[11:8],
+    (bcd_digits[7:4]   >= 4'd5)? bcd_digits[7:4]   + 4'd3 : bcd_digits[7:4],
+    (bcd_digits[3:0]   >= 4'd5)? bcd_digits[3:0]   + 4'd3 : bcd_digits[3:0]
+};
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                               bcd_bin <= 64'd0;
+    else if(fpu_state == STATE_EXECUTE && fpu_bcd_start)            bcd_bin <= rnd_int_mag;
+    else if(fpu_state == STATE_BCD_STORE && bcd_counter != 7'd0)    bcd_bin <= { bcd_bin[62:0], 1'b0 };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                               bcd_digits <= 72'd0;
+    else if(fpu_state == STATE_EXECUTE && fpu_bcd_start)            bcd_digits <= 72'd0;
+    else if(fpu_state == STATE_BCD_STORE && bcd_counter != 7'd0)    bcd_digits <= { bcd_adjusted[70:0], bcd_bin[63] };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                               bcd_counter <= 7'd0;
+    else if(fpu_start && fmt_bcd && ins_load)                       bcd_counter <= 7'd18;
+    else if(fpu_state == STATE_EXECUTE && fpu_bcd_start)            bcd_counter <= 7'd64;
+    else if(bcd_counter != 7'd0)                                    bcd_counter <= bcd_counter - 7'd1;
+end
+
+//------------------------------------------------------------------------------ outcome registers
+
+reg         o_write;
+reg [2:0]   o_dest;
+reg [79:0]  o_value;
+reg         o_write2;
+reg [2:0]   o_dest2;
+reg [79:0]  o_value2;
+reg [1:0]   o_pop;
+reg         o_push;
+reg         o_incstp;
+reg         o_decstp;
+reg         o_free;
+reg [2:0]   o_free_index;
+reg [5:0]   o_exc;
+reg         o_sf;
+reg [3:0]   o_cc;
+reg [3:0]   o_cc_mask;
+reg         o_cw_write;
+reg [15:0]  o_cw;
+reg         o_init;
+reg         o_clex;
+reg         o_skip;
+reg         o_ptr;
+reg         o_ptr_data;
+reg [31:0]  o_fip;
+reg [15:0]  o_fcs;
+reg [10:0]  o_fop;
+reg [31:0]  o_fdp;
+reg [15:0]  o_fds;
+
+always @(posedge clk) begin if(rst_n == 1'b0) o_write      <= `FALSE; else if(fpu_finish) o_write      <= r_write;      end
+always @(posedge clk) begin if(rst_n == 1'b0) o_dest       <= 3'd0;   else if(fpu_finish) o_dest       <= r_dest;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_value      <= 80'd0;  else if(fpu_finish) o_value      <= r_value;      end
+always @(posedge clk) begin if(rst_n == 1'b0) o_write2     <= `FALSE; else if(fpu_finish) o_write2     <= r_write2;     end
+always @(posedge clk) begin if(rst_n == 1'b0) o_dest2      <= 3'd0;   else if(fpu_finish) o_dest2      <= r_dest2;      end
+always @(posedge clk) begin if(rst_n == 1'b0) o_value2     <= 80'd0;  else if(fpu_finish) o_value2     <= r_value2;     end
+always @(posedge clk) begin if(rst_n == 1'b0) o_pop        <= 2'd0;   else if(fpu_finish) o_pop        <= r_pop;        end
+always @(posedge clk) begin if(rst_n == 1'b0) o_push       <= `FALSE; else if(fpu_finish) o_push       <= r_push;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_incstp     <= `FALSE; else if(fpu_finish) o_incstp     <= r_incstp;     end
+always @(posedge clk) begin if(rst_n == 1'b0) o_decstp     <= `FALSE; else if(fpu_finish) o_decstp     <= r_decstp;     end
+always @(posedge clk) begin if(rst_n == 1'b0) o_free       <= `FALSE; else if(fpu_finish) o_free       <= r_free;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_free_index <= 3'd0;   else if(fpu_finish) o_free_index <= dec_rm;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_exc        <= 6'd0;   else if(fpu_finish) o_exc        <= r_exc;        end
+always @(posedge clk) begin if(rst_n == 1'b0) o_sf         <= `FALSE; else if(fpu_finish) o_sf         <= r_sf;         end
+always @(posedge clk) begin if(rst_n == 1'b0) o_cc         <= 4'd0;   else if(fpu_finish) o_cc         <= r_cc;         end
+always @(posedge clk) begin if(rst_n == 1'b0) o_cc_mask    <= 4'd0;   else if(fpu_finish) o_cc_mask    <= r_cc_mask;    end
+always @(posedge clk) begin if(rst_n == 1'b0) o_cw_write   <= `FALSE; else if(fpu_finish) o_cw_write   <= r_cw_write;   end
+always @(posedge clk) begin if(rst_n == 1'b0) o_cw         <= 16'd0;  else if(fpu_finish) o_cw         <= r_cw;         end
+always @(posedge clk) begin if(rst_n == 1'b0) o_init       <= `FALSE; else if(fpu_finish) o_init       <= r_init;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_clex       <= `FALSE; else if(fpu_finish) o_clex       <= r_clex;       end
+always @(posedge clk) begin if(rst_n == 1'b0) o_skip       <= `FALSE; else if(fpu_finish) o_skip       <= r_skip;       end
+
+//------------------------------------------------------------------------------ instruction and data pointers
+
+wire        fpu_real;
+wire [31:0] fpu_ip;
+wire [15:0] fpu_seg;
+wire [31:0] fpu_ea;
+
+reg  [31:0] fpu_ea_first;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_ea_first <= 32'd0;
+    else if(exe_ready && fpu_cmd && fpu_first)          fpu_ea_first <= exe_address_effective;
+end
+
+assign fpu_real = real_mode || v8086_mode;
+
+assign fpu_ip = exe_eip - { 28'd0, exe_consumed };
+
+assign fpu_seg =
+    (exe_prefix_group_2_seg == 3'd0)?   es :
+    (exe_prefix_group_2_seg == 3'd1)?   cs :
+    (exe_prefix_group_2_seg == 3'd2)?   ss :
+    (exe_prefix_group_2_seg == 3'd3)?   ds :
+    (exe_prefix_group_2_seg == 3'd4)?   fs :
+                                        gs;
+
+assign fpu_ea = (fpu_first)? exe_address_effective : fpu_ea_first;
+
+always @(posedge clk) begin if(rst_n == 1'b0) o_ptr      <= `FALSE; else if(fpu_finish) o_ptr      <= ~(ins_control);                end
+always @(posedge clk) begin if(rst_n == 1'b0) o_ptr_data <= `FALSE; else if(fpu_finish) o_ptr_data <= ~(ins_control) && ~(dec_reg); end
+always @(posedge clk) begin if(rst_n == 1'b0) o_fcs      <= 16'd0;  else if(fpu_finish) o_fcs      <= cs;                            end
+always @(posedge clk) begin if(rst_n == 1'b0) o_fop      <= 11'd0;  else if(fpu_finish) o_fop      <= { dec_esc, exe_decoder[15:8] }; end
+always @(posedge clk) begin if(rst_n == 1'b0) o_fds      <= 16'd0;  else if(fpu_finish) o_fds      <= fpu_seg;                       end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)               o_fip <= 32'd0;
+    else if(fpu_finish && fpu_real) o_fip <= { 12'd0, cs, 4'd0 } + fpu_ip;
+    else if(fpu_finish)             o_fip <= fpu_ip;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)               o_fdp <= 32'd0;
+    else if(fpu_finish && fpu_real) o_fdp <= { 12'd0, fpu_seg, 4'd0 } + fpu_ea;
+    else if(fpu_finish)             o_fdp <= fpu_ea;
+end
+
+//------------------------------------------------------------------------------ commit
+
+wire fpu_commit;
+
+assign fpu_commit = wr_fpu_commit && fpu_pending;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_pending <= `FALSE;
+    else if(wr_reset || fpu_commit)                         fpu_pending <= `FALSE;
+    else if(exe_ready && fpu_cmd && fpu_last)               fpu_pending <= `TRUE;
+end
+
+wire [2:0] commit_dest;
+wire [2:0] commit_dest2;
+wire [2:0] commit_free;
+wire [7:0] commit_write_mask;
+wire [7:0] commit_empty_mask;
+wire [2:0] commit_top;
+
+assign commit_dest  = fpu_top + o_dest;
+assign commit_dest2 = fpu_top + o_dest2;
+assign commit_free  = fpu_top + o_free_index;
+
+assign commit_write_mask =
+    ((o_write)?  (8'd1 << commit_dest)  : 8'd0) |
+    ((o_write2)? (8'd1 << commit_dest2) : 8'd0);
+
+assign commit_empty_mask =
+    ((o_free)?          (8'd1 << commit_free) : 8'd0) |
+    ((o_pop != 2'd0)?   (8'd1 << fpu_top) : 8'd0) |
+    ((o_pop == 2'd2)?   (8'd1 << idx_st1) : 8'd0);
+
+assign commit_top = fpu_top - { 2'd0, o_push } + { 1'b0, o_pop } + { 2'd0, o_incstp } - { 2'd0, o_decstp };
+
+//------------------------------------------------------------------------------ environment: FLDENV, FRSTOR, FNSTENV, FNSAVE
+
+// pieces 0 to 6: control, status and tag word, the instruction and data pointers;
+// words with a 16-bit operand size, dwords otherwise
+// pieces 7 to 26: the registers ST(0) to ST(7), 80 bytes in dwords
+
+reg  [4:0]   env_counter;
+reg  [607:0] frstor_buf;
+
+assign env_piece = (fpu_first)? 5'd0 : env_counter;
+assign env_last  = (ins_env_full)? env_piece == 5'd26 : env_piece == 5'd6;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   env_counter <= 5'd0;
+    else if(exe_reset)                                  env_counter <= 5'd0;
+    else if(exe_ready && exe_cmd == `CMD_x87_env)       env_counter <= env_piece + 5'd1;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                               frstor_buf <= 608'd0;
+    else if(exe_ready && exe_cmd == `CMD_x87_env && env_piece >= 5'd7 && ~(env_last))   frstor_buf <= { src, frstor_buf[607:32] };
+end
+
+wire env_load;
+wire env_32p;
+wire env_32r;
+wire env_16r;
+
+assign env_load     = exe_ready && exe_cmd == `CMD_x87_env && ins_env_load;
+assign env_32p = exe_operand_32bit && ~(fpu_real);
+assign env_32r = exe_operand_32bit && fpu_real;
+assign env_16r = ~(exe_operand_32bit) && fpu_real;
+
+wire         frstor_load;
+wire [639:0] frstor_image;
+wire [639:0] frstor_rot;
+
+assign frstor_load  = env_load && ins_env_full && env_last;
+assign frstor_image = { src, frstor_buf };
+
+//ST(i) to the physical register top + i
+assign frstor_rot =
+    (fpu_top == 3'd0)?  frstor_image :
+    (fpu_top == 3'd1)?  { frstor_image[559:0], frstor_image[639:560] } :
+    (fpu_top == 3'd2)?  { frstor_image[479:0], frstor_image[639:480] } :
+    (fpu_top == 3'd3)?  { frstor_image[399:0], frstor_image[639:400] } :
+    (fpu_top == 3'd4)?  { frstor_image[319:0], frstor_image[639:320] } :
+    (fpu_top == 3'd5)?  { frstor_image[239:0], frstor_image[639:240] } :
+    (fpu_top == 3'd6)?  { frstor_image[159:0], frstor_image[639:160] } :
+                        { frstor_image[79:0],  frstor_image[639:80] };
+
+wire [639:0] save_phys;
+wire [639:0] save_image;
+wire [639:0] save_shifted;
+wire [4:0]   save_dword;
+
+assign save_phys = { fpu_r7, fpu_r6, fpu_r5, fpu_r4, fpu_r3, fpu_r2, fpu_r1, fpu_r0 };
+
+assign save_image =
+    (fpu_top == 3'd0)?  save_phys :
+    (fpu_top == 3'd1)?  { save_phys[79:0],  save_phys[639:80] } :
+    (fpu_top == 3'd2)?  { save_phys[159:0], save_phys[639:160] } :
+    (fpu_top == 3'd3)?  { save_phys[239:0], save_phys[639:240] } :
+    (fpu_top == 3'd4)?  { save_phys[319:0], save_phys[639:320] } :
+    (fpu_top == 3'd5)?  { save_phys[399:0], save_phys[639:400] } :
+    (fpu_top == 3'd6)?  { save_phys[479:0], save_phys[639:480] } :
+                        { save_phys[559:0], save_phys[639:560] };
+
+assign save_dword   = env_piece - 5'd7;
+assign save_shifted = save_image >> { save_dword, 5'd0 };
+
+wire [31:0] env_result;
+
+assign env_result =
+    (env_piece >= 5'd7)?                                save_shifted[31:0] :
+    (env_piece == 5'd0)?                                { 16'hFFFF, fpu_cw } :
+    (env_piece == 5'd1)?                                { 16'hFFFF, fpu_sw } :
+    (env_piece == 5'd2)?                                { 16'hFFFF, fpu_tw } :
+    (env_piece == 5'd3 && env_32p)?                fpu_fip :
+    (env_piece == 5'd3)?                                { 16'hFFFF, fpu_fip[15:0] } :
+    (env_piece == 5'd4 && env_32p)?                { 5'd0, fpu_fop, fpu_fcs } :
+    (env_piece == 5'd4 && env_32r)?                { 4'd0, fpu_fip[31:16], 1'b0, fpu_fop } :
+    (env_piece == 5'd4 && env_16r)?                { 16'hFFFF, fpu_fip[19:16], 1'b0, fpu_fop } :
+    (env_piece == 5'd4)?                                { 16'hFFFF, fpu_fcs } :
+    (env_piece == 5'd5 && env_32p)?                fpu_fdp :
+    (env_piece == 5'd5)?                                { 16'hFFFF, fpu_fdp[15:0] } :
+    (env_piece == 5'd6 && env_32r)?                { 4'd0, fpu_fdp[31:16], 12'd0 } :
+    (env_piece == 5'd6 && env_16r)?                { 16'hFFFF, fpu_fdp[19:16], 12'd0 } :
+                                                        { 16'hFFFF, fpu_fds };
+
+//------------------------------------------------------------------------------ architectural state update
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r0 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd0)             fpu_r0 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd0)               fpu_r0 <= o_value;
+    else if(frstor_load)                                                fpu_r0 <= frstor_rot[79:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r1 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd1)             fpu_r1 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd1)               fpu_r1 <= o_value;
+    else if(frstor_load)                                                fpu_r1 <= frstor_rot[159:80];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r2 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd2)             fpu_r2 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd2)               fpu_r2 <= o_value;
+    else if(frstor_load)                                                fpu_r2 <= frstor_rot[239:160];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r3 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd3)             fpu_r3 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd3)               fpu_r3 <= o_value;
+    else if(frstor_load)                                                fpu_r3 <= frstor_rot[319:240];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r4 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd4)             fpu_r4 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd4)               fpu_r4 <= o_value;
+    else if(frstor_load)                                                fpu_r4 <= frstor_rot[399:320];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r5 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd5)             fpu_r5 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd5)               fpu_r5 <= o_value;
+    else if(frstor_load)                                                fpu_r5 <= frstor_rot[479:400];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r6 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd6)             fpu_r6 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd6)               fpu_r6 <= o_value;
+    else if(frstor_load)                                                fpu_r6 <= frstor_rot[559:480];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   fpu_r7 <= 80'd0;
+    else if(fpu_commit && o_write2 && commit_dest2 == 3'd7)             fpu_r7 <= o_value2;
+    else if(fpu_commit && o_write && commit_dest == 3'd7)               fpu_r7 <= o_value;
+    else if(frstor_load)                                                fpu_r7 <= frstor_rot[639:560];
+end
+
+wire [7:0] env_empty;
+
+assign env_empty = {
+    src[15:14] == 2'd3, src[13:12] == 2'd3, src[11:10] == 2'd3, src[9:8] == 2'd3,
+    src[7:6]   == 2'd3, src[5:4]   == 2'd3, src[3:2]   == 2'd3, src[1:0] == 2'd3 };
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_empty <= 8'h00;
+    else if(fpu_commit && o_init)                       fpu_empty <= 8'hFF;
+    else if(fpu_commit)                                 fpu_empty <= (fpu_empty & ~(commit_write_mask)) | commit_empty_mask;
+    else if(env_load && env_piece == 5'd2)              fpu_empty <= env_empty;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_top <= 3'd0;
+    else if(fpu_commit && o_init)                       fpu_top <= 3'd0;
+    else if(fpu_commit)                                 fpu_top <= commit_top;
+    else if(env_load && env_piece == 5'd1)              fpu_top <= src[13:11];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_cw <= 16'h0040;
+    else if(fpu_commit && o_init)                       fpu_cw <= 16'h037F;
+    else if(fpu_commit && o_cw_write)                   fpu_cw <= o_cw;
+    else if(env_load && env_piece == 5'd0)              fpu_cw <= { 3'd0, src[12:8], 2'b01, src[5:0] };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_exc <= 6'd0;
+    else if(fpu_commit && (o_init || o_clex))           fpu_exc <= 6'd0;
+    else if(fpu_commit)                                 fpu_exc <= fpu_exc | o_exc;
+    else if(env_load && env_piece == 5'd1)              fpu_exc <= src[5:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_sf <= `FALSE;
+    else if(fpu_commit && (o_init || o_clex))           fpu_sf <= `FALSE;
+    else if(fpu_commit)                                 fpu_sf <= fpu_sf | o_sf;
+    else if(env_load && env_piece == 5'd1)              fpu_sf <= src[6];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                   fpu_cc <= 4'd0;
+    else if(fpu_commit && o_init)                       fpu_cc <= 4'd0;
+    else if(fpu_commit)                                 fpu_cc <= (fpu_cc & ~(o_cc_mask)) | (o_cc & o_cc_mask);
+    else if(env_load && env_piece == 5'd1)              fpu_cc <= { src[14], src[10:8] };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_fip <= 32'd0;
+    else if(fpu_commit && o_init)                           fpu_fip <= 32'd0;
+    else if(fpu_commit && o_ptr)                            fpu_fip <= o_fip;
+    else if(env_load && env_piece == 5'd3 && env_32p)  fpu_fip <= src;
+    else if(env_load && env_piece == 5'd3)                  fpu_fip <= { 16'd0, src[15:0] };
+    else if(env_load && env_piece == 5'd4 && env_32r)  fpu_fip <= { src[27:12], fpu_fip[15:0] };
+    else if(env_load && env_piece == 5'd4 && env_16r)  fpu_fip <= { 12'd0, src[15:12], fpu_fip[15:0] };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_fcs <= 16'd0;
+    else if(fpu_commit && o_init)                           fpu_fcs <= 16'd0;
+    else if(fpu_commit && o_ptr)                            fpu_fcs <= o_fcs;
+    else if(env_load && env_piece == 5'd4 && ~(fpu_real))   fpu_fcs <= src[15:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_fop <= 11'd0;
+    else if(fpu_commit && o_init)                           fpu_fop <= 11'd0;
+    else if(fpu_commit && o_ptr)                            fpu_fop <= o_fop;
+    else if(env_load && env_piece == 5'd4 && env_32p)  fpu_fop <= src[26:16];
+    else if(env_load && env_piece == 5'd4 && fpu_real)      fpu_fop <= src[10:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_fdp <= 32'd0;
+    else if(fpu_commit && o_init)                           fpu_fdp <= 32'd0;
+    else if(fpu_commit && o_ptr_data)                       fpu_fdp <= o_fdp;
+    else if(env_load && env_piece == 5'd5 && env_32p)  fpu_fdp <= src;
+    else if(env_load && env_piece == 5'd5)                  fpu_fdp <= { 16'd0, src[15:0] };
+    else if(env_load && env_piece == 5'd6 && env_32r)  fpu_fdp <= { src[27:12], fpu_fdp[15:0] };
+    else if(env_load && env_piece == 5'd6 && env_16r)  fpu_fdp <= { 12'd0, src[15:12], fpu_fdp[15:0] };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                       fpu_fds <= 16'd0;
+    else if(fpu_commit && o_init)                           fpu_fds <= 16'd0;
+    else if(fpu_commit && o_ptr_data)                       fpu_fds <= o_fds;
+    else if(env_load && env_piece == 5'd6 && ~(fpu_real))   fpu_fds <= src[15:0];
+end
+
+//------------------------------------------------------------------------------ output
+
+assign fpu_busy = (fpu_cmd || fpu_cmd_wait) && (fpu_pending || (fpu_cmd && fpu_compute_step && ~(fpu_done)));
+
+assign fpu_nm_fault =
+    (fpu_cmd)?      cr0_em || cr0_ts :
+    (fpu_cmd_wait)? cr0_ts && cr0_mp :
+                    `FALSE;
+
+assign fpu_mf_fault = ~(fpu_nm_fault) && fpu_first && fpu_waiting_type && ~(fpu_pending) && fpu_es && cr0_ne;
+
+assign fpu_result =
+    (exe_cmd == `CMD_x87_env)?  env_result :
+    (exe_cmdex == 4'd2)?        { 16'd0, o_value[79:64] } :
+    (exe_cmdex == 4'd1)?        o_value[63:32] :
+                                o_value[31:0];
+
+//the environment stores are never skipped, o_skip is left from the previous instruction
+assign fpu_store_skip = exe_cmd != `CMD_x87_env && o_skip;
+
+//------------------------------------------------------------------------------
+
+// synthesis translate_off
+wire _unused_ok = &{ 1'b0, exe_decoder[7:3], 1'b0 };
+// synthesis translate_on
+
+//------------------------------------------------------------------------------
+
+endmodule
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2014, Aleksander Osman
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * 
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+`include "defines.v"
+
+module execute_fpu_arith(
+    input               clk,
+    input               rst_n,
+    
+    input               exe_reset,
+    
+    input               arith_start,
+    input       [2:0]   arith_op,
+    input       [1:0]   arith_rc,
+    
+    input               arith_a_sign,
+    input       [19:0]  arith_a_exp,
+    input       [63:0]  arith_a_sig,
+    input               arith_a_zero,
+    
+    input               arith_b_sign,
+    input       [19:0]  arith_b_exp,
+    input       [66:0]  arith_b_sig,
+    input               arith_b_zero,
+    
+    //output
+    output              arith_busy,
+    
+    output reg          arith_sign,
+    output reg  [19:0]  arith_exp,
+    output reg  [66:0]  arith_sig,
+    output reg          arith_zero,
+    
+    output reg  [2:0]   arith_quotient,
+    output reg          arith_partial
+);
+
+//------------------------------------------------------------------------------
+// Iterative engine for the x87 arithmetic: ADD (subtraction by the caller
+// flipping arith_b_sign), MUL in four steps over the 67 bit multiplier, DIV
+// and SQRT one bit per clock, REM/REM1 one quotient bit per clock for FPREM
+// and FPREM1.
+//
+// The operands are normalized (significand bit 63 set) or zero; only ADD and
+// MUL accept zero operands, DIV a zero dividend. The second operand may have
+// 67 significant bits, for the constants of the transcendental programs and the
+// reduction of the trigonometric arguments by pi/2.
+//
+// The result has 67 significand bits with the sticky bit folded into bit 0 and
+// is rounded by execute_fpu_round. The exponent is biased by 16383 and kept
+// in 20 bits two's complement.
+
+reg [2:0]   e_op;
+reg [1:0]   e_rc;
+reg         e_a_sign;
+reg [19:0]  e_a_exp;
+reg [63:0]  e_a_sig;
+reg         e_a_zero;
+reg         e_b_sign;
+reg [19:0]  e_b_exp;
+reg [66:0]  e_b_sig;
+reg         e_b_zero;
+
+reg [6:0]   e_counter;
+
+reg [133:0] e_acc;
+reg [69:0]  e_rem;
+reg [66:0]  e_quotient;
+reg [19:0]  e_exp;
+reg         e_first;
+reg         e_rem_small;
+reg         e_rem_half;
+
+assign arith_busy = e_counter != 7'd0;
+
+always @(posedge clk) begin if(rst_n == 1'b0) e_op     <= 3'd0;  else if(arith_start) e_op     <= arith_op;     end
+always @(posedge clk) begin if(rst_n == 1'b0) e_rc     <= 2'd0;  else if(arith_start) e_rc     <= arith_rc;     end
+always @(posedge clk) begin if(rst_n == 1'b0) e_a_sign <= 1'b0;  else if(arith_start) e_a_sign <= arith_a_sign; end
+always @(posedge clk) begin if(rst_n == 1'b0) e_a_exp  <= 20'd0; else if(arith_start) e_a_exp  <= arith_a_exp;  end
+always @(posedge clk) begin if(rst_n == 1'b0) e_a_sig  <= 64'd0; else if(arith_start) e_a_sig  <= arith_a_sig;  end
+always @(posedge clk) begin if(rst_n == 1'b0) e_a_zero <= 1'b0;  else if(arith_start) e_a_zero <= arith_a_zero; end
+always @(posedge clk) begin if(rst_n == 1'b0) e_b_sign <= 1'b0;  else if(arith_start) e_b_sign <= arith_b_sign; end
+always @(posedge clk) begin if(rst_n == 1'b0) e_b_exp  <= 20'd0; else if(arith_start) e_b_exp  <= arith_b_exp;  end
+always @(posedge clk) begin if(rst_n == 1'b0) e_b_zero <= 1'b0;  else if(arith_start) e_b_zero <= arith_b_zero; end
+
+//------------------------------------------------------------------------------ step count
+
+wire [19:0] rem_diff;
+wire        rem_diff_negative;
+wire        rem_small;
+wire        rem_half;
+wire        rem_partial;
+wire [6:0]  rem_steps;
+
+assign rem_diff          = arith_a_exp - arith_b_exp;
+assign rem_diff_negative = rem_diff[19];
+assign rem_small         = rem_diff_negative && rem_diff != 20'hFFFFF;
+assign rem_half          = rem_diff == 20'hFFFFF;
+assign rem_partial       = ~(rem_diff_negative) && rem_diff >= 20'd64;
+
+assign rem_steps =
+    (rem_small)?    7'd0 :
+    (rem_half)?     7'd1 :
+    (rem_partial)?  { 2'd0, rem_diff[4:0] } + 7'd33 :
+                    rem_diff[6:0] + 7'd1;
+
+always @(posedge clk) begin if(rst_n == 1'b0) e_rem_small <= 1'b0; else if(arith_start) e_rem_small <= rem_small; end
+always @(posedge clk) begin if(rst_n == 1'b0) e_rem_half  <= 1'b0; else if(arith_start) e_rem_half  <= rem_half;  end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                       e_counter <= 7'd0;
+    else if(exe_reset)                                                      e_counter <= 7'd0;
+    else if(arith_start && arith_op == `FPU_ARITH_ADD)                      e_counter <= 7'd1;
+    else if(arith_start && arith_op == `FPU_ARITH_MUL)                      e_counter <= 7'd5;
+    else if(arith_start && arith_op == `FPU_ARITH_DIV)                      e_counter <= 7'd68;
+    else if(arith_start && arith_op == `FPU_ARITH_SQRT)                     e_counter <= 7'd68;
+    else if(arith_start)                                                    e_counter <= rem_steps + 7'd1;
+    else if(e_counter != 7'd0)                                              e_counter <= e_counter - 7'd1;
+end
+
+//------------------------------------------------------------------------------ ADD
+
+wire        add_swap;
+wire        add_same_sign;
+wire [66:0] add_big;
+wire [66:0] add_small;
+wire [19:0] add_big_exp;
+wire        add_big_sign;
+wire [19:0] add_diff;
+wire [6:0]  add_shift;
+wire [133:0] add_small_shifted_full;
+wire [66:0] add_small_aligned;
+wire [67:0] add_sum;
+wire [66:0] add_norm_out;
+wire [6:0]  add_norm_shift;
+
+assign add_swap = { ~(e_b_exp[19]), e_b_exp[18:0], e_b_sig } > { ~(e_a_exp[19]), e_a_exp[18:0], e_a_sig, 3'd0 };
+
+assign add_same_sign = e_a_sign == e_b_sign;
+
+assign add_big      = (add_swap)? e_b_sig  : { e_a_sig, 3'd0 };
+assign add_small    = (add_swap)? { e_a_sig, 3'd0 } : e_b_sig;
+assign add_big_exp  = (add_swap)? e_b_exp  : e_a_exp;
+assign add_big_sign = (add_swap)? e_b_sign : e_a_sign;
+
+assign add_diff  = (add_swap)? e_b_exp - e_a_exp : e_a_exp - e_b_exp;
+assign add_shift = (add_diff > 20'd67)? 7'd68 : add_diff[6:0];
+
+assign add_small_shifted_full = { add_small, 67'd0 } >> add_shift;
+
+assign add_small_aligned =
+    (add_shift == 7'd68)?   { 66'd0, add_small != 67'd0 } :
+                            { add_small_shifted_full[133:68], add_small_shifted_full[67] | (add_small_shifted_full[66:0] != 67'd0) };
+
+assign add_sum =
+    (add_same_sign)?        { 1'b0, add_big } + { 1'b0, add_small_aligned } :
+                            { 1'b0, add_big } - { 1'b0, add_small_aligned };
+
+execute_fpu_normalize add_normalize_inst(
+    .norm_in        (add_sum[66:0]),    //input [66:0]
+    .norm_out       (add_norm_out),     //output [66:0]
+    .norm_shift     (add_norm_shift)    //output [6:0]
+);
+
+//------------------------------------------------------------------------------ MUL
+
+wire [82:0]  mul_partial;
+wire [130:0] mul_partial_shifted;
+wire [130:0] mul_product;
+
+assign mul_partial =
+    e_a_sig * (
+    (e_counter == 7'd5)?    e_b_sig[18:0] :
+    (e_counter == 7'd4)?    { 3'd0, e_b_sig[34:19] } :
+    (e_counter == 7'd3)?    { 3'd0, e_b_sig[50:35] } :
+                            { 3'd0, e_b_sig[66:51] });
+
+assign mul_partial_shifted =
+    (e_counter == 7'd5)?    { 48'd0, mul_partial } :
+    (e_counter == 7'd4)?    { 29'd0, mul_partial, 19'd0 } :
+    (e_counter == 7'd3)?    { 16'd0, mul_partial[79:0], 35'd0 } :
+                            { mul_partial[79:0], 51'd0 };
+
+assign mul_product = e_acc[130:0];
+
+//------------------------------------------------------------------------------ DIV
+
+wire [65:0] div_diff;
+
+assign div_diff = { 1'b0, e_rem[64:0] } - { 2'd0, e_b_sig[66:3] };
+
+//------------------------------------------------------------------------------ SQRT
+
+wire [69:0] sqrt_rem_next;
+wire [70:0] sqrt_diff;
+
+assign sqrt_rem_next = { e_rem[67:0], e_acc[133:132] };
+assign sqrt_diff     = { 1'b0, sqrt_rem_next } - { 2'd0, e_quotient, 2'b01 };
+
+//------------------------------------------------------------------------------ REM
+
+wire [68:0] rem_divisor;
+wire [69:0] rem_current;
+wire [70:0] rem_rem_diff;
+wire [69:0] rem_twice;
+wire        rem_round_up;
+wire [66:0] rem_final;
+wire [66:0] rem_norm_out;
+wire [6:0]  rem_norm_shift;
+
+// the divisor is doubled when the dividend exponent is one below: the quotient is then 0 or 1 for FPREM1
+assign rem_divisor = (e_rem_half)? { 1'b0, e_b_sig, 1'b0 } : { 2'd0, e_b_sig };
+
+assign rem_current  = (e_first)? e_rem : { e_rem[68:0], 1'b0 };
+assign rem_rem_diff = { 1'b0, rem_current } - { 2'd0, rem_divisor };
+
+assign rem_twice    = { e_rem[68:0], 1'b0 };
+assign rem_round_up = e_op == `FPU_ARITH_REM1 && ~(arith_partial) && ~(e_rem_small) && (rem_twice > { 1'b0, rem_divisor } || (rem_twice == { 1'b0, rem_divisor } && e_quotient[0]));
+
+assign rem_final = (rem_round_up)? rem_divisor[66:0] - e_rem[66:0] : e_rem[66:0];
+
+execute_fpu_normalize rem_normalize_inst(
+    .norm_in        (rem_final),        //input [66:0]
+    .norm_out       (rem_norm_out),     //output [66:0]
+    .norm_shift     (rem_norm_shift)    //output [6:0]
+);
+
+//------------------------------------------------------------------------------ iteration registers
+
+wire [19:0] div_exp;
+wire [19:0] sqrt_exp;
+
+assign div_exp  = arith_a_exp - arith_b_exp + ((arith_a_sig < arith_b_sig[66:3])? 20'd16382 : 20'd16383);
+assign sqrt_exp = { arith_a_exp[19], arith_a_exp[19:1] } + ((arith_a_exp[0])? 20'd8192 : 20'd8191);
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   e_b_sig <= 67'd0;
+    else if(arith_start)                                                e_b_sig <= arith_b_sig;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   e_exp <= 20'd0;
+    else if(arith_start && arith_op == `FPU_ARITH_DIV)                  e_exp <= div_exp;
+    else if(arith_start && arith_op == `FPU_ARITH_SQRT)                 e_exp <= sqrt_exp;
+    else if(arith_start && rem_half)                                    e_exp <= arith_b_exp - 20'd1;
+    else if(arith_start && rem_partial)                                 e_exp <= arith_a_exp - { 15'd0, rem_diff[4:0] } - 20'd32;
+    else if(arith_start)                                                e_exp <= arith_b_exp;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   e_first <= `FALSE;
+    else if(arith_start)                                                e_first <= `TRUE;
+    else if(e_counter > 7'd1)                                           e_first <= `FALSE;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   e_acc <= 134'd0;
+    else if(arith_start && arith_op == `FPU_ARITH_SQRT && arith_a_exp[0])   e_acc <= { 1'b0, arith_a_sig, 69'd0 };
+    else if(arith_start && arith_op == `FPU_ARITH_SQRT)                 e_acc <= { arith_a_sig, 70'd0 };
+    else if(arith_start)                                                e_acc <= 134'd0;
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_MUL)                 e_acc <= { 3'd0, e_acc[130:0] + mul_partial_shifted };
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_SQRT)                e_acc <= { e_acc[131:0], 2'b00 };
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                                   e_rem <= 70'd0;
+    else if(arith_start && arith_op == `FPU_ARITH_DIV && arith_a_sig < arith_b_sig[66:3])   e_rem <= { 5'd0, arith_a_sig, 1'b0 };
+    else if(arith_start && arith_op == `FPU_ARITH_DIV)                                  e_rem <= { 6'd0, arith_a_sig };
+    else if(arith_start && arith_op == `FPU_ARITH_SQRT)                                 e_rem <= 70'd0;
+    else if(arith_start)                                                                e_rem <= { 3'd0, arith_a_sig, 3'd0 };
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_DIV && ~(div_diff[65]))              e_rem <= { 4'd0, div_diff[64:0], 1'b0 };
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_DIV)                                 e_rem <= { 4'd0, e_rem[64:0], 1'b0 };
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_SQRT && ~(sqrt_diff[70]))            e_rem <= sqrt_diff[69:0];
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_SQRT)                                e_rem <= sqrt_rem_next;
+    else if(e_counter > 7'd1 && ~(rem_rem_diff[70]))                                    e_rem <= rem_rem_diff[69:0];
+    else if(e_counter > 7'd1)                                                           e_rem <= rem_current;
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                                                   e_quotient <= 67'd0;
+    else if(arith_start)                                                e_quotient <= 67'd0;
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_DIV)                 e_quotient <= { e_quotient[65:0], ~(div_diff[65]) };
+    else if(e_counter > 7'd1 && e_op == `FPU_ARITH_SQRT)                e_quotient <= { e_quotient[65:0], ~(sqrt_diff[70]) };
+    else if(e_counter > 7'd1)                                           e_quotient <= { e_quotient[65:0], ~(rem_rem_diff[70]) };
+end
+
+//------------------------------------------------------------------------------ result
+
+wire        result_add_zero;
+wire        result_sign;
+wire [19:0] result_exp;
+wire [66:0] result_sig;
+wire        result_zero;
+
+assign result_add_zero = (e_a_zero && e_b_zero) || (~(add_same_sign) && add_sum == 68'd0);
+
+assign result_sign =
+    (e_op == `FPU_ARITH_ADD && e_a_zero && e_b_zero && add_same_sign)?  e_a_sign :
+    (e_op == `FPU_ARITH_ADD && result_add_zero)?                        e_rc == `FPU_RC_DOWN :
+    (e_op == `FPU_ARITH_ADD && e_a_zero)?                               e_b_sign :
+    (e_op == `FPU_ARITH_ADD && e_b_zero)?                               e_a_sign :
+    (e_op == `FPU_ARITH_ADD)?                                           add_big_sign :
+    (e_op == `FPU_ARITH_SQRT)?                                          e_a_sign :
+    (e_op == `FPU_ARITH_REM || e_op == `FPU_ARITH_REM1)?                e_a_sign ^ (rem_round_up && rem_final != 67'd0) :
+                                                                        e_a_sign ^ e_b_sign;
+
+assign result_exp =
+    (e_op == `FPU_ARITH_ADD && e_a_zero)?                               e_b_exp :
+    (e_op == `FPU_ARITH_ADD && e_b_zero)?                               e_a_exp :
+    (e_op == `FPU_ARITH_ADD && add_sum[67] && add_same_sign)?           add_big_exp + 20'd1 :
+    (e_op == `FPU_ARITH_ADD && add_same_sign)?                          add_big_exp :
+    (e_op == `FPU_ARITH_ADD)?                                           add_big_exp - { 13'd0, add_norm_shift } :
+    (e_op == `FPU_ARITH_MUL && mul_product[130])?                       e_a_exp + e_b_exp - 20'd16382 :
+    (e_op == `FPU_ARITH_MUL)?                                           e_a_exp + e_b_exp - 20'd16383 :
+    (e_op == `FPU_ARITH_DIV || e_op == `FPU_ARITH_SQRT)?                e_exp :
+    (e_rem_small)?                                                      e_a_exp :
+                                                                        e_exp - { 13'd0, rem_norm_shift };
+
+assign result_sig =
+    (e_op == `FPU_ARITH_ADD && e_a_zero)?                               e_b_sig :
+    (e_op == `FPU_ARITH_ADD && e_b_zero)?                               { e_a_sig, 3'd0 } :
+    (e_op == `FPU_ARITH_ADD && add_sum[67])?                            { add_sum[67:2], add_sum[1] | add_sum[0] } :
+    (e_op == `FPU_ARITH_ADD && add_same_sign)?                          add_sum[66:0] :
+    (e_op == `FPU_ARITH_ADD)?                                           add_norm_out :
+    (e_op == `FPU_ARITH_MUL && mul_product[130])?                       { mul_product[130:65], mul_product[64:0] != 65'd0 } :
+    (e_op == `FPU_ARITH_MUL)?                                           { mul_product[129:64], mul_product[63:0] != 64'd0 } :
+    (e_op == `FPU_ARITH_DIV)?                                           { e_quotient[66:1], e_quotient[0] | (e_rem[64:0] != 65'd0) } :
+    (e_op == `FPU_ARITH_SQRT)?                                          { e_quotient[66:1], e_quotient[0] | (e_rem != 70'd0) } :
+    (e_rem_small)?                                                      { e_a_sig, 3'd0 } :
+                                                                        rem_norm_out;
+
+assign result_zero =
+    (e_op == `FPU_ARITH_ADD)?                                           result_add_zero :
+    (e_op == `FPU_ARITH_MUL)?                                           e_a_zero || e_b_zero :
+    (e_op == `FPU_ARITH_DIV)?                                           e_a_zero :
+    (e_op == `FPU_ARITH_REM || e_op == `FPU_ARITH_REM1)?                ~(e_rem_small) && rem_final == 67'd0 :
+                                                                        `FALSE;
+
+always @(posedge clk) begin if(rst_n == 1'b0) arith_sign <= 1'b0;  else if(e_counter == 7'd1) arith_sign <= result_sign; end
+always @(posedge clk) begin if(rst_n == 1'b0) arith_exp  <= 20'd0; else if(e_counter == 7'd1) arith_exp  <= result_exp;  end
+always @(posedge clk) begin if(rst_n == 1'b0) arith_sig  <= 67'd0; else if(e_counter == 7'd1) arith_sig  <= (result_zero)? 67'd0 : result_sig; end
+always @(posedge clk) begin if(rst_n == 1'b0) arith_zero <= 1'b0;  else if(e_counter == 7'd1) arith_zero <= result_zero; end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)                           arith_quotient <= 3'd0;
+    else if(e_counter == 7'd1 && rem_round_up)  arith_quotient <= e_quotient[2:0] + 3'd1;
+    else if(e_counter == 7'd1)                  arith_quotient <= e_quotient[2:0];
+end
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0)   arith_partial <= `FALSE;
+    else if(arith_start) arith_partial <= (arith_op == `FPU_ARITH_REM || arith_op == `FPU_ARITH_REM1) && rem_partial;
+end
+
+//------------------------------------------------------------------------------
+
+endmodule
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2014, Aleksander Osman
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * 
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+`include "defines.v"
+
+module execute_fpu_normalize(
+    input       [66:0]  norm_in,
+    
+    output      [66:0]  norm_out,
+    output      [6:0]   norm_shift
+);
+
+//------------------------------------------------------------------------------ shift left until bit 66 is set
+
+wire [66:0] norm_64;
+wire [66:0] norm_32;
+wire [66:0] norm_16;
+wire [66:0] norm_8;
+wire [66:0] norm_4;
+wire [66:0] norm_2;
+wire [66:0] norm_1;
+
+wire norm_64_do;
+wire norm_32_do;
+wire norm_16_do;
+wire norm_8_do;
+wire norm_4_do;
+wire norm_2_do;
+wire norm_1_do;
+
+assign norm_64_do = norm_in[66:3]  == 64'd0;
+assign norm_32_do = norm_64[66:35] == 32'd0;
+assign norm_16_do = norm_32[66:51] == 16'd0;
+assign norm_8_do  = norm_16[66:59] == 8'd0;
+assign norm_4_do  = norm_8[66:63]  == 4'd0;
+assign norm_2_do  = norm_4[66:65]  == 2'd0;
+assign norm_1_do  = norm_2[66]     == 1'b0;
+
+assign norm_64 = (norm_64_do)? { norm_in[2:0], 64'd0 } : norm_in;
+assign norm_32 = (norm_32_do)? { norm_64[34:0], 32'd0 } : norm_64;
+assign norm_16 = (norm_16_do)? { norm_32[50:0], 16'd0 } : norm_32;
+assign norm_8  = (norm_8_do)?  { norm_16[58:0], 8'd0 }  : norm_16;
+assign norm_4  = (norm_4_do)?  { norm_8[62:0],  4'd0 }  : norm_8;
+assign norm_2  = (norm_2_do)?  { norm_4[64:0],  2'd0 }  : norm_4;
+assign norm_1  = (norm_1_do)?  { norm_2[65:0],  1'd0 }  : norm_2;
+
+assign norm_out   = norm_1;
+assign norm_shift = { norm_64_do, norm_32_do, norm_16_do, norm_8_do, norm_4_do, norm_2_do, norm_1_do };
+
+//------------------------------------------------------------------------------
+
+endmodule
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2014, Aleksander Osman
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * 
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+`include "defines.v"
+
+module execute_fpu_round(
+    input               round_sign,
+    input       [19:0]  round_exp,
+    input       [66:0]  round_sig,
+    input               round_zero,
+    
+    input       [1:0]   round_precision,
+    input       [1:0]   round_range,
+    input       [1:0]   round_rc,
+    input               round_bounded,
+    input               round_register,
+    input               round_overflow_masked,
+    input               round_underflow_masked,
+    
+    //output
+    output              round_out_sign,
+    output      [19:0]  round_out_exp,
+    output      [63:0]  round_out_sig,
+    output              round_out_inf,
+    output              round_out_zero,
+    
+    output              round_out_precision,
+    output              round_out_underflow,
+    output              round_out_tiny,
+    output              round_out_overflow,
+    output              round_out_roundup
+);
+
+//------------------------------------------------------------------------------
+// The exponent is biased by 16383 and kept in 20 bits two's complement, so the
+// results of operations on denormals and of internal steps stay representable.
+// round_range selects the exponent limits of the destination: extended, double,
+// single or integer (LSB of the significand at 2^0, used by FIST and FRNDINT).
+// Tininess is detected before rounding.
+
+wire [19:0] round_emin;
+wire [19:0] round_emax;
+
+assign round_emin =
+    (round_range == `FPU_RANGE_DOUBLE)?     20'd15361 :
+    (round_range == `FPU_RANGE_SINGLE)?     20'd16257 :
+    (round_range == `FPU_RANGE_INTEGER)?    20'd16446 :
+                                            20'd1;
+
+assign round_emax =
+    (round_range == `FPU_RANGE_DOUBLE)?     20'd17406 :
+    (round_range == `FPU_RANGE_SINGLE)?     20'd16510 :
+                                            20'd32766;
+
+//------------------------------------------------------------------------------ denormalize
+
+wire        round_tiny;
+wire        round_denormal;
+wire [19:0] round_shift_full;
+wire [6:0]  round_shift;
+
+wire [133:0] round_shifted_full;
+wire [66:0]  round_shifted;
+wire         round_shifted_sticky;
+wire [66:0]  round_value;
+
+assign round_tiny = round_bounded && ~(round_zero) && ({ ~(round_exp[19]), round_exp[18:0] } < { 1'b1, round_emin[18:0] });
+
+assign round_denormal = round_tiny && (round_range == `FPU_RANGE_INTEGER || ~(round_register) || round_underflow_masked);
+
+assign round_shift_full = round_emin - round_exp;
+
+assign round_shift =
+    (~(round_denormal))?                7'd0 :
+    (round_shift_full > 20'd67)?        7'd68 :
+                                        round_shift_full[6:0];
+
+assign round_shifted_full = { round_sig, 67'd0 } >> round_shift;
+
+assign round_shifted        = (round_shift == 7'd68)? 67'd0                     : round_shifted_full[133:67];
+assign round_shifted_sticky = (round_shift == 7'd68)? round_sig != 67'd0        : round_shifted_full[66:0] != 67'd0;
+
+assign round_value = { round_shifted[66:1], round_shifted[0] | round_shifted_sticky };
+
+//------------------------------------------------------------------------------ round to precision
+
+wire [63:0] round_kept;
+wire        round_bit;
+wire        round_sticky;
+wire        round_inexact;
+wire        round_increment;
+wire [64:0] round_sum;
+wire        round_carry;
+wire [63:0] round_sig_rounded;
+wire [19:0] round_exp_rounded;
+
+assign round_kept =
+    (round_precision == `FPU_PRECISION_SINGLE)?     { 40'd0, round_value[66:43] } :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     { 11'd0, round_value[66:14] } :
+                                                    round_value[66:3];
+
+assign round_bit =
+    (round_precision == `FPU_PRECISION_SINGLE)?     round_value[42] :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     round_value[13] :
+                                                    round_value[2];
+
+assign round_sticky =
+    (round_precision == `FPU_PRECISION_SINGLE)?     round_value[41:0] != 42'd0 :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     round_value[12:0] != 13'd0 :
+                                                    round_value[1:0]  != 2'd0;
+
+assign round_inexact = round_bit || round_sticky;
+
+assign round_increment =
+    (round_rc == `FPU_RC_NEAREST)?  round_bit && (round_sticky || round_kept[0]) :
+    (round_rc == `FPU_RC_UP)?       round_inexact && ~(round_sign) :
+    (round_rc == `FPU_RC_DOWN)?     round_inexact && round_sign :
+                                    1'b0;
+
+assign round_sum = { 1'b0, round_kept } + { 64'd0, round_increment };
+
+assign round_carry =
+    (round_precision == `FPU_PRECISION_SINGLE)?     round_sum[24] :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     round_sum[53] :
+                                                    round_sum[64];
+
+assign round_sig_rounded =
+    (round_carry)?                                  { 1'b1, 63'd0 } :
+    (round_precision == `FPU_PRECISION_SINGLE)?     { round_sum[23:0], 40'd0 } :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     { round_sum[52:0], 11'd0 } :
+                                                    round_sum[63:0];
+
+assign round_exp_rounded = ((round_denormal)? round_emin : round_exp) + { 19'd0, round_carry };
+
+//------------------------------------------------------------------------------ overflow and underflow
+
+wire        round_overflow;
+wire        round_to_infinity;
+wire [63:0] round_max_sig;
+wire [19:0] round_exp_wrapped_down;
+wire [19:0] round_exp_wrapped_up;
+wire        round_wrap_overflow;
+wire        round_wrap_underflow;
+
+assign round_overflow = round_bounded && ~(round_zero) && round_range != `FPU_RANGE_INTEGER &&
+    ({ ~(round_exp_rounded[19]), round_exp_rounded[18:0] } > { 1'b1, round_emax[18:0] });
+
+assign round_to_infinity =
+    round_rc == `FPU_RC_NEAREST || (round_rc == `FPU_RC_UP && ~(round_sign)) || (round_rc == `FPU_RC_DOWN && round_sign);
+
+//unmasked overflow and underflow rebias the exponent by 24576; results still out of range saturate to infinity or zero
+assign round_exp_wrapped_down = round_exp_rounded - 20'd24576;
+assign round_exp_wrapped_up   = round_exp_rounded + 20'd24576;
+
+assign round_wrap_overflow  = round_overflow && ~(round_overflow_masked) && round_register &&
+    ({ ~(round_exp_wrapped_down[19]), round_exp_wrapped_down[18:0] } > { 1'b1, round_emax[18:0] });
+
+assign round_wrap_underflow = round_tiny && ~(round_denormal) && (round_exp_wrapped_up[19] || round_exp_wrapped_up == 20'd0);
+
+assign round_max_sig =
+    (round_precision == `FPU_PRECISION_SINGLE)?     { 24'hFFFFFF, 40'd0 } :
+    (round_precision == `FPU_PRECISION_DOUBLE)?     { 53'h1FFFFFFFFFFFFF, 11'd0 } :
+                                                    64'hFFFFFFFFFFFFFFFF;
+
+assign round_out_sign = round_sign;
+
+assign round_out_exp =
+    (round_zero || round_wrap_underflow)?                               20'd0 :
+    (round_overflow && round_overflow_masked && round_to_infinity)?     20'd32767 :
+    (round_overflow && round_overflow_masked)?                          round_emax :
+    (round_wrap_overflow)?                                              20'd32767 :
+    (round_overflow)?                                                   round_exp_wrapped_down :
+    (round_tiny && ~(round_denormal))?                                  round_exp_wrapped_up :
+                                                                        round_exp_rounded;
+
+assign round_out_sig =
+    (round_zero || round_wrap_underflow)?                               64'd0 :
+    (round_overflow && round_overflow_masked && round_to_infinity)?     { 1'b1, 63'd0 } :
+    (round_wrap_overflow)?                                              { 1'b1, 63'd0 } :
+    (round_overflow && round_overflow_masked)?                          round_max_sig :
+                                                                        round_sig_rounded;
+
+assign round_out_inf  = ~(round_zero) && ((round_overflow && round_overflow_masked && round_to_infinity) || round_wrap_overflow);
+assign round_out_zero = round_zero || round_wrap_underflow || round_sig_rounded == 64'd0;
+
+assign round_out_precision = ~(round_zero) && (round_inexact || (round_overflow && round_overflow_masked) || round_wrap_overflow || round_wrap_underflow);
+assign round_out_underflow = round_tiny && round_range != `FPU_RANGE_INTEGER && (round_inexact || ~(round_underflow_masked));
+assign round_out_tiny      = round_tiny && round_range != `FPU_RANGE_INTEGER;
+assign round_out_overflow  = round_overflow;
+assign round_out_roundup   =
+    (round_zero)?                               1'b0 :
+    (round_overflow && round_overflow_masked)?  round_to_infinity :
+    (round_wrap_overflow)?                      1'b1 :
+    (round_wrap_underflow)?                     1'b0 :
+                                                round_increment;
+
+//------------------------------------------------------------------------------
+
+endmodule
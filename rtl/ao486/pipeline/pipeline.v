@@ -121,6 +121,7 @@ module pipeline(
     output              exe_trigger_pf_fault,
     output              exe_trigger_db_fault,
     output              exe_trigger_nm_fault,
+    output              exe_trigger_mf_fault,
     output              exe_load_seg_gp_fault,
     output              exe_load_seg_ss_fault,
     output              exe_load_seg_np_fault,
@@ -662,6 +663,7 @@ wire        rd_operand_32bit;
 wire        rd_address_32bit;
 wire [1:0]  rd_prefix_group_1_rep;
 wire        rd_prefix_group_1_lock;
+wire [2:0]  rd_prefix_group_2_seg;
 wire        rd_prefix_2byte;
 wire        rd_is_8bit;
 //wire [6:0]  rd_cmd;
@@ -840,6 +842,7 @@ read read_inst(
     .rd_address_32bit              (rd_address_32bit),              //output
     .rd_prefix_group_1_rep         (rd_prefix_group_1_rep),         //output [1:0]
     .rd_prefix_group_1_lock        (rd_prefix_group_1_lock),        //output
+    .rd_prefix_group_2_seg         (rd_prefix_group_2_seg),         //output [2:0]
     .rd_prefix_2byte               (rd_prefix_2byte),               //output
     .rd_consumed                   (rd_consumed),                   //output [3:0]
     .rd_is_8bit                    (rd_is_8bit),                    //output
@@ -872,6 +875,7 @@ wire [31:0]  exe_buffer;
 wire [463:0] exe_buffer_shifted;
 
 wire        wr_busy;
+wire        wr_fpu_commit;
 wire        exe_ready;
 wire [39:0] exe_decoder;
 wire [31:0] exe_eip_final;
@@ -910,6 +914,7 @@ execute execute_inst(
     .rst_n              (rst_n),
     
     .exe_reset          (exe_reset),    //input
+    .wr_reset           (wr_reset),     //input
     
     //general input
     .eax                           (eax),                           //input [31:0]
@@ -1069,6 +1074,7 @@ execute execute_inst(
     .exe_trigger_pf_fault          (exe_trigger_pf_fault),          //output
     .exe_trigger_db_fault          (exe_trigger_db_fault),          //output
     .exe_trigger_nm_fault          (exe_trigger_nm_fault),          //output
+    .exe_trigger_mf_fault          (exe_trigger_mf_fault),          //output
     .exe_load_seg_gp_fault         (exe_load_seg_gp_fault),         //output
     .exe_load_seg_ss_fault         (exe_load_seg_ss_fault),         //output
     .exe_load_seg_np_fault         (exe_load_seg_np_fault),         //output
@@ -1088,6 +1094,7 @@ execute execute_inst(
     .rd_address_32bit              (rd_address_32bit),              //input
     .rd_prefix_group_1_rep         (rd_prefix_group_1_rep),         //input [1:0]
     .rd_prefix_group_1_lock        (rd_prefix_group_1_lock),        //input
+    .rd_prefix_group_2_seg         (rd_prefix_group_2_seg),         //input [2:0]
     .rd_prefix_2byte               (rd_prefix_2byte),               //input
     .rd_consumed                   (rd_consumed),                   //input [3:0]
     .rd_is_8bit                    (rd_is_8bit),                    //input
@@ -1110,6 +1117,7 @@ execute execute_inst(
     
     //exe pipeline
     .wr_busy                       (wr_busy),                       //input
+    .wr_fpu_commit                 (wr_fpu_commit),                 //input
     .exe_ready                     (exe_ready),                     //output
     
     .exe_decoder                   (exe_decoder),                   //output [39:0]
@@ -1255,6 +1263,8 @@ write write_inst(
     .wr_req_reset_micro            (wr_req_reset_micro),            //output
     .wr_req_reset_rd               (wr_req_reset_rd),               //output
     .wr_req_reset_exe              (wr_req_reset_exe),              //output
+    
+    .wr_fpu_commit                 (wr_fpu_commit),                 //output
         
     //memory page fault
     .tlb_code_pf_cr2               (tlb_code_pf_cr2),               //input [31:0]
@@ -194,6 +194,7 @@ module read(
     output reg          rd_address_32bit,
     output reg  [1:0]   rd_prefix_group_1_rep,
     output reg          rd_prefix_group_1_lock,
+    output reg  [2:0]   rd_prefix_group_2_seg,
     output reg          rd_prefix_2byte,
     output reg  [3:0]   rd_consumed,
     output reg          rd_is_8bit,
@@ -337,6 +338,7 @@ wire address_stack_for_iret_to_v86;
 wire address_stack_for_call_param_first;
 wire address_ea_buffer;
 wire address_ea_buffer_plus_2;
+wire address_ea_buffer_plus_4;
 wire address_memoffset;
 
 wire read_virtual;
@@ -384,7 +386,6 @@ assign r_load = micro_ready;
 //------------------------------------------------------------------------------
 
 reg [2:0]   rd_modregrm_len;
-reg [2:0]   rd_prefix_group_2_seg;
 
 always @(posedge clk) begin if(rst_n == 1'b0) rd_decoder              <= 88'd0;     else if(r_load) rd_decoder              <= micro_decoder;              end
 always @(posedge clk) begin if(rst_n == 1'b0) rd_eip                  <= 32'd0;     else if(r_load) rd_eip                  <= micro_eip;                  end
@@ -735,6 +736,7 @@ read_effective_address read_effective_address_inst(
     
     .address_ea_buffer                  (address_ea_buffer),                    //input
     .address_ea_buffer_plus_2           (address_ea_buffer_plus_2),             //input
+    .address_ea_buffer_plus_4           (address_ea_buffer_plus_4),             //input
     
     .address_memoffset                  (address_memoffset),                    //input
     
@@ -900,6 +902,7 @@ read_commands read_commands_inst(
     
     .address_ea_buffer                  (address_ea_buffer),                    //output
     .address_ea_buffer_plus_2           (address_ea_buffer_plus_2),             //output
+    .address_ea_buffer_plus_4           (address_ea_buffer_plus_4),             //output
     
     .address_memoffset                  (address_memoffset),                    //output
    
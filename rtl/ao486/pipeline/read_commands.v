@@ -157,6 +157,7 @@ module read_commands(
     
     output              address_ea_buffer,
     output              address_ea_buffer_plus_2,
+    output              address_ea_buffer_plus_4,
     
     output              address_memoffset,
     
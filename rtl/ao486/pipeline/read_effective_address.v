@@ -91,6 +91,7 @@ module read_effective_address(
     
     input               address_ea_buffer,
     input               address_ea_buffer_plus_2,
+    input               address_ea_buffer_plus_4,
     
     input               address_memoffset,
     
@@ -387,6 +388,7 @@ wire [31:0] ea_buffer_next;
 reg  [31:0] ea_buffer;
                                         
 assign ea_buffer_sum  =
+    (address_ea_buffer_plus_4)?                     rd_address_effective + 32'd4 :
     (rd_operand_16bit || address_ea_buffer_plus_2)? rd_address_effective + 32'd2 :
                                                     rd_address_effective + 32'd4;
 
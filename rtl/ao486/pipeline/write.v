@@ -134,6 +134,9 @@ module write(
     output              wr_req_reset_rd,
     output              wr_req_reset_exe,
     
+    //fpu
+    output              wr_fpu_commit,
+    
     //memory page fault
     input       [31:0]  tlb_code_pf_cr2,
     input       [31:0]  tlb_write_pf_cr2,
@@ -914,6 +917,8 @@ write_commands write_commands_inst(
     .wr_make_esp_speculative       (wr_make_esp_speculative),       //output
     .wr_make_esp_commit            (wr_make_esp_commit),            //output
     
+    .wr_fpu_commit                 (wr_fpu_commit),                 //output
+    
     //string
     .wr_string_ignore              (wr_string_ignore),              //input
     .wr_prefix_group_1_rep         (wr_prefix_group_1_rep),         //input [1:0]
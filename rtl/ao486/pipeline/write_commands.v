@@ -182,6 +182,8 @@ module write_commands(
     output              wr_make_esp_speculative,
     output              wr_make_esp_commit,
     
+    output              wr_fpu_commit,
+    
     //string
     input               wr_string_ignore,
     input       [1:0]   wr_prefix_group_1_rep,
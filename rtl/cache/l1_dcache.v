@@ -0,0 +1,794 @@
+module l1_dcache
+#(
+	parameter LINES         = 128,
+	parameter ASSOCIATIVITY = 4,
+	parameter WRITEBACK     = 0
+)
+(
+	input             CLK,
+	input             RESET,
+
+	input             DISABLE,
+
+	// link_dcacheread
+	input             CPU_RD_REQ,
+	output            CPU_RD_DONE,
+	input      [31:0] CPU_RD_ADDR,
+	input       [3:0] CPU_RD_LENGTH,
+	input             CPU_RD_CACHE_DISABLE,
+	output     [63:0] CPU_RD_DATA,
+
+	// link_dcachewrite
+	input             CPU_WR_REQ,
+	output            CPU_WR_DONE,
+	input      [31:0] CPU_WR_ADDR,
+	input       [2:0] CPU_WR_LENGTH,
+	input             CPU_WR_CACHE_DISABLE,
+	input             CPU_WR_WRITE_THROUGH,
+	input      [31:0] CPU_WR_DATA,
+
+	// INVD, WBINVD
+	input             INV_REQ,
+	output            INV_DONE,
+
+	// avalon_mem readburst: uncached reads
+	output            MEM_RD_REQ,
+	input             MEM_RD_DONE,
+	output     [31:0] MEM_RD_ADDR,
+	output      [3:0] MEM_RD_LENGTH,
+	input      [63:0] MEM_RD_DATA,
+
+	// avalon_mem readline: line fills
+	output reg        MEM_LINE_REQ,
+	output reg [31:0] MEM_LINE_ADDR,
+	input             MEM_LINE_DONE,
+	input      [31:0] MEM_LINE_DATA,
+
+	// avalon_mem writeburst: one dword at a time, write-backs
+	output            MEM_WR_REQ,
+	input             MEM_WR_DONE,
+	output     [31:0] MEM_WR_ADDR,
+	output      [2:0] MEM_WR_LENGTH,
+	output     [31:0] MEM_WR_DATA,
+
+	input      [27:2] snoop_addr,
+	input      [31:0] snoop_data,
+	input       [3:0] snoop_be,
+	input             snoop_we,
+
+	// write-back only: dma reads wait until their dword is not modified in the cache
+	input      [23:2] dma_addr,
+	input             dma_rd,
+	output            dma_hold
+);
+
+// cache settings
+localparam LINESIZE      = 8;  // one readline burst
+localparam ADDRBITS      = 25; // only the 256MB below the snoop limit are cached
+
+// cache control
+localparam ASSO_BITS     = (ASSOCIATIVITY > 1) ? $clog2(ASSOCIATIVITY) : 1;
+localparam LINESIZE_BITS = $clog2(LINESIZE);
+localparam LINE_BITS     = $clog2(LINES);
+localparam RAMSIZEBITS   = $clog2(LINESIZE * LINES);
+localparam LINEMASKLSB   = $clog2(LINESIZE);
+localparam LINEMASKMSB   = LINEMASKLSB + $clog2(LINES) - 1;
+
+reg    [ASSOCIATIVITY-1:0]      tags_dirty_in;
+wire   [ASSOCIATIVITY-1:0]      tags_dirty_out;
+reg    [ASSOCIATIVITY-1:0]      tags_modified_in;
+wire   [ASSOCIATIVITY-1:0]      tags_modified_out;
+wire   [ADDRBITS-RAMSIZEBITS:0] tags_read[0:ASSOCIATIVITY-1];
+reg                             update_tag_we;
+reg    [LINE_BITS-1:0]          update_tag_addr;
+
+reg    [ASSO_BITS-1:0] LRU_in [0:ASSOCIATIVITY-1];
+wire   [ASSO_BITS-1:0] LRU_out[0:ASSOCIATIVITY-1];
+reg                    LRU_we;
+reg    [LINE_BITS-1:0] LRU_addr;
+reg    [LINE_BITS-1:0] LRU_wraddr;
+
+localparam [4:0]
+	START         = 0,
+	IDLE          = 1,
+	WRITEONE      = 2,
+	READONE       = 3,
+	READMEM       = 4,
+	READ_OUT      = 5,
+	FILLCHECK     = 6,
+	FILLCACHE     = 7,
+	READCACHE_OUT = 8,
+	WRITEHIT      = 9,
+	WRITEMEM      = 10,
+	WRITE_OUT     = 11,
+	EVICT_READ    = 12,
+	EVICT         = 13,
+	EVICT_DONE    = 14,
+	DMACHECK      = 15,
+	FLUSH         = 16,
+	INV_OUT       = 17;
+
+// memory
+wire             [31:0] readdata_cache[0:ASSOCIATIVITY-1];
+reg     [ASSO_BITS-1:0] cache_mux;
+
+reg        [ADDRBITS:0] read_addr;
+
+reg   [RAMSIZEBITS-1:0] memory_addr_a;
+wire  [RAMSIZEBITS-1:0] memory_addr_b;
+reg              [31:0] memory_datain;
+reg [0:ASSOCIATIVITY-1] memory_we;
+reg               [3:0] memory_be;
+
+reg [LINESIZE_BITS-1:0] fillcount;
+
+reg   [4:0] state;
+
+// read in progress: up to three dwords, collected in rd_buf
+reg  [31:2] rd_mem_addr;
+reg   [1:0] rd_count;
+reg   [1:0] rd_slot;
+reg         rd_nofill;
+reg         rd_valid;
+reg   [1:0] rd_valid_slot;
+reg  [31:0] rd_buf[0:2];
+reg         rd_bypass_busy;
+reg         hit_valid;
+
+// write in progress: the second dword of a write crossing a dword boundary
+reg         wr_piece;
+
+// write-back of a modified line
+reg                          [4:0] evict_ret;
+reg  [ADDRBITS-RAMSIZEBITS:0]      evict_tag;
+reg            [LINESIZE_BITS-1:0] evict_index;
+
+reg     [LINE_BITS-1:0] flush_set;
+
+reg         dma_clean;
+reg  [23:2] dma_clean_addr;
+
+// fifo for snoop, the own write-backs are not snooped
+wire [61:0] Fifo_dout;
+wire        Fifo_empty;
+
+simple_fifo_mlab #(
+	.widthu(4),
+	.width(62)
+)
+isimple_fifo (
+	.clk(CLK),
+	.rst_n(1'b1),
+	.sclr(RESET),
+
+	.data({snoop_be, snoop_data, snoop_addr}),
+	.wrreq(snoop_we && state != EVICT),
+
+	.q(Fifo_dout),
+	.rdreq((state == IDLE) && !Fifo_empty),
+	.empty(Fifo_empty)
+);
+
+//------------------------------------------------------------------------------ read
+
+wire  [3:0] rd_end       = { 2'd0, CPU_RD_ADDR[1:0] } + CPU_RD_LENGTH - 4'd1;
+wire [31:2] rd_last_addr = CPU_RD_ADDR[31:2] + { 28'd0, rd_end[3:2] };
+
+// above the cached 256MB, the VGA window and the ROM/UMA area at 0xA0000-0xFFFFF
+wire rd_first_uncached = CPU_RD_ADDR[31:28]  != 4'd0 || (CPU_RD_ADDR[27:20]  == 8'd0 && CPU_RD_ADDR[19:17]  >= 3'd5);
+wire rd_last_uncached  = rd_last_addr[31:28] != 4'd0 || (rd_last_addr[27:20] == 8'd0 && rd_last_addr[19:17] >= 3'd5);
+
+wire rd_attr_uncached = DISABLE || CPU_RD_CACHE_DISABLE;
+
+// write-through passes uncached reads straight on, write-back has to look for modified lines first;
+// only a read that lies completely in an uncached region can skip that
+wire rd_bypass_start = CPU_RD_REQ && ~rd_bypass_busy && state == IDLE &&
+	((WRITEBACK == 0)? rd_first_uncached || rd_last_uncached || rd_attr_uncached : rd_first_uncached && rd_last_uncached);
+wire rd_bypass       = rd_bypass_start || rd_bypass_busy;
+
+wire [31:0] rd_cache_data = readdata_cache[cache_mux];
+
+wire [31:0] rd_dword_0 = (rd_valid && rd_valid_slot == 2'd0)? rd_cache_data : rd_buf[0];
+wire [31:0] rd_dword_1 = (rd_valid && rd_valid_slot == 2'd1)? rd_cache_data : rd_buf[1];
+wire [31:0] rd_dword_2 = (rd_valid && rd_valid_slot == 2'd2)? rd_cache_data : rd_buf[2];
+
+wire [95:0] rd_data = { rd_dword_2, rd_dword_1, rd_dword_0 };
+
+wire [63:0] rd_data_out =
+	(CPU_RD_ADDR[1:0] == 2'd0)? rd_data[63:0]  :
+	(CPU_RD_ADDR[1:0] == 2'd1)? rd_data[71:8]  :
+	(CPU_RD_ADDR[1:0] == 2'd2)? rd_data[79:16] :
+	                            rd_data[87:24];
+
+// write-back: uncached dwords are read alone, only the requested bytes
+wire  [1:0] rd_piece_start = (rd_slot  == 2'd0)? CPU_RD_ADDR[1:0] : 2'd0;
+wire  [1:0] rd_piece_end   = (rd_count == 2'd0)? rd_end[1:0]      : 2'd3;
+
+assign MEM_RD_REQ    = rd_bypass || state == READMEM;
+assign MEM_RD_ADDR   = (state == READMEM)? { rd_mem_addr, rd_piece_start }                 : CPU_RD_ADDR;
+assign MEM_RD_LENGTH = (state == READMEM)? { 2'd0, rd_piece_end - rd_piece_start } + 4'd1 : CPU_RD_LENGTH;
+
+assign CPU_RD_DONE   = (rd_bypass)? MEM_RD_DONE : state == READ_OUT;
+assign CPU_RD_DATA   = (rd_bypass)? MEM_RD_DATA : rd_data_out;
+
+always @(posedge CLK) begin
+	if (RESET)                            rd_bypass_busy <= 1'b0;
+	else if (rd_bypass && MEM_RD_DONE)    rd_bypass_busy <= 1'b0;
+	else if (rd_bypass_start)             rd_bypass_busy <= 1'b1;
+end
+
+//------------------------------------------------------------------------------ write
+
+// writes go out one dword at a time, so each one is snooped back before the next request starts
+wire  [2:0] wr_space        = 3'd4 - { 1'b0, CPU_WR_ADDR[1:0] };
+wire        wr_split        = CPU_WR_LENGTH > wr_space;
+wire  [2:0] wr_first_length = (wr_split)? wr_space : CPU_WR_LENGTH;
+
+wire [31:0] wr_piece_addr   = (wr_piece)? { CPU_WR_ADDR[31:2] + 30'd1, 2'd0 }     : CPU_WR_ADDR;
+wire  [2:0] wr_piece_length = (wr_piece)? CPU_WR_LENGTH - wr_first_length         : wr_first_length;
+wire [31:0] wr_piece_data   = (wr_piece)? CPU_WR_DATA >> { wr_first_length, 3'd0 } : CPU_WR_DATA;
+wire        wr_piece_last   = wr_piece || ~wr_split;
+
+wire  [3:0] wr_piece_be =
+	(wr_piece_length == 3'd1)? 4'b0001 << wr_piece_addr[1:0] :
+	(wr_piece_length == 3'd2)? 4'b0011 << wr_piece_addr[1:0] :
+	(wr_piece_length == 3'd3)? 4'b0111 << wr_piece_addr[1:0] :
+	                           4'b1111;
+
+wire [31:0] wr_piece_shifted = wr_piece_data << { wr_piece_addr[1:0], 3'd0 };
+
+wire wr_region_uncached = wr_piece_addr[31:28] != 4'd0 || (wr_piece_addr[27:20] == 8'd0 && wr_piece_addr[19:17] >= 3'd5);
+
+// write-back keeps write hits in the cache, everything else is written through and snooped
+wire wr_cached = WRITEBACK != 0 && ~wr_region_uncached && ~DISABLE && ~CPU_WR_CACHE_DISABLE && ~CPU_WR_WRITE_THROUGH;
+
+assign MEM_WR_REQ    = state == WRITEMEM || state == EVICT;
+assign MEM_WR_ADDR   = (state == EVICT)? { 4'd0, evict_tag, read_addr[LINEMASKMSB:LINEMASKLSB], evict_index, 2'd0 } : wr_piece_addr;
+assign MEM_WR_LENGTH = (state == EVICT)? 3'd4 : wr_piece_length;
+assign MEM_WR_DATA   = (state == EVICT)? readdata_cache[cache_mux] : wr_piece_data;
+
+assign CPU_WR_DONE   = (state == WRITEMEM && MEM_WR_DONE && wr_piece_last) || state == WRITE_OUT;
+
+//------------------------------------------------------------------------------
+
+assign INV_DONE = state == INV_OUT;
+
+wire dma_clean_match = dma_clean && dma_clean_addr == dma_addr;
+
+assign dma_hold = WRITEBACK != 0 && ((dma_rd && ~dma_clean_match) || state == EVICT_READ || state == EVICT);
+
+assign memory_addr_b = (state == EVICT_READ || state == EVICT)? { read_addr[LINEMASKMSB:LINEMASKLSB], evict_index } : read_addr[RAMSIZEBITS - 1:0];
+
+always @(posedge CLK) begin : mainfsm
+	reg [ASSO_BITS:0]   i;
+	reg [ASSO_BITS-1:0] match;
+	reg                 hit;
+	reg [ASSO_BITS-1:0] hit_way;
+	reg [ASSO_BITS-1:0] victim;
+	reg                 modified;
+	reg [ASSO_BITS-1:0] modified_way;
+
+	hit          = 1'b0;
+	hit_way      = {ASSO_BITS{1'b0}};
+	victim       = {ASSO_BITS{1'b0}};
+	modified     = 1'b0;
+	modified_way = {ASSO_BITS{1'b0}};
+	for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+		if (~tags_dirty_out[i] && tags_read[i] == read_addr[ADDRBITS:RAMSIZEBITS]) begin
+			hit     = 1'b1;
+			hit_way = i[ASSO_BITS-1:0];
+		end
+		if (~tags_dirty_out[i] && tags_modified_out[i]) begin
+			modified     = 1'b1;
+			modified_way = i[ASSO_BITS-1:0];
+		end
+		if (LRU_out[i] == ASSOCIATIVITY - 1) victim = i[ASSO_BITS-1:0];
+	end
+
+	memory_we     <= {ASSOCIATIVITY{1'b0}};
+	update_tag_we <= 1'b0;
+	rd_valid      <= 1'b0;
+	hit_valid     <= 1'b0;
+
+	if (rd_valid) rd_buf[rd_valid_slot] <= rd_cache_data;
+
+	if (RESET) begin
+		state            <= START;
+		update_tag_addr  <= {LINE_BITS{1'b0}};
+		update_tag_we    <= 1'b1;
+		tags_dirty_in    <= {ASSOCIATIVITY{1'b1}};
+		tags_modified_in <= {ASSOCIATIVITY{1'b0}};
+
+		MEM_LINE_REQ     <= 1'b0;
+		wr_piece         <= 1'b0;
+		flush_set        <= {LINE_BITS{1'b0}};
+		dma_clean        <= 1'b0;
+	end
+	else begin
+		// LRU update after a hit
+		LRU_we     <= hit_valid && ~LRU_we;
+		LRU_wraddr <= LRU_addr;
+		for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+			LRU_in[i] <= LRU_out[i];
+			if (cache_mux == i[ASSO_BITS-1:0]) begin
+				match     = LRU_out[i];
+				LRU_in[i] <= {ASSO_BITS{1'b0}};
+			end
+		end
+		for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+			if (LRU_out[i] < match) begin
+				LRU_in[i] <= LRU_out[i] + 1'd1;
+			end
+		end
+
+		case (state)
+			START:
+			begin
+				update_tag_addr <= update_tag_addr + 1'd1;
+
+				for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+					LRU_in[i]    <= i[ASSO_BITS-1:0];
+				end
+				LRU_wraddr      <= update_tag_addr;
+				LRU_we          <= 1'b1;
+
+				if (update_tag_addr == {LINE_BITS{1'b1}}) state         <= IDLE;
+				else                                      update_tag_we <= 1'b1;
+			end
+
+			IDLE:
+				begin
+					if (!Fifo_empty) begin
+						state         <= WRITEONE;
+						read_addr     <= Fifo_dout[25:0];
+						memory_addr_a <= Fifo_dout[RAMSIZEBITS - 1:0];
+						memory_datain <= Fifo_dout[57:26];
+						memory_be     <= Fifo_dout[61:58];
+					end
+					else if (WRITEBACK != 0 && dma_rd && ~dma_clean_match) begin
+						state         <= DMACHECK;
+						read_addr     <= { 4'd0, dma_addr };
+					end
+					else if (INV_REQ) begin
+						state         <= FLUSH;
+						read_addr     <= { {ADDRBITS-LINEMASKMSB{1'b0}}, flush_set, {LINEMASKLSB{1'b0}} };
+					end
+					else if (CPU_WR_REQ) begin
+						state         <= (wr_cached)? WRITEHIT : WRITEMEM;
+						read_addr     <= wr_piece_addr[27:2];
+					end
+					else if (CPU_RD_REQ && ~rd_bypass) begin
+						state         <= READONE;
+						read_addr     <= CPU_RD_ADDR[27:2];
+						rd_mem_addr   <= CPU_RD_ADDR[31:2];
+						rd_count      <= rd_end[3:2];
+						rd_slot       <= 2'd0;
+						rd_nofill     <= rd_attr_uncached || rd_first_uncached || rd_last_uncached;
+					end
+				end
+
+			WRITEONE:
+				begin
+					state <= IDLE;
+					if (hit) memory_we[hit_way] <= 1'b1;
+				end
+
+			READONE:
+				begin
+					LRU_addr <= read_addr[LINEMASKMSB:LINEMASKLSB];
+
+					if (hit && rd_mem_addr[31:28] == 4'd0) begin
+						cache_mux     <= hit_way;
+						rd_valid      <= 1'b1;
+						rd_valid_slot <= rd_slot;
+						hit_valid     <= 1'b1;
+						if (rd_count == 2'd0) state <= READ_OUT;
+						else begin
+							rd_count    <= rd_count - 1'd1;
+							rd_slot     <= rd_slot + 1'd1;
+							read_addr   <= read_addr + 1'd1;
+							rd_mem_addr <= rd_mem_addr + 1'd1;
+						end
+					end
+					else if (rd_nofill) state <= READMEM;
+					else                state <= FILLCHECK;
+				end
+
+			READMEM:
+				if (MEM_RD_DONE) begin
+					rd_buf[rd_slot] <= MEM_RD_DATA[31:0] << { rd_piece_start, 3'd0 };
+					if (rd_count == 2'd0) state <= READ_OUT;
+					else begin
+						state       <= READONE;
+						rd_count    <= rd_count - 1'd1;
+						rd_slot     <= rd_slot + 1'd1;
+						read_addr   <= read_addr + 1'd1;
+						rd_mem_addr <= rd_mem_addr + 1'd1;
+					end
+				end
+
+			READ_OUT:
+				state <= IDLE;
+
+			FILLCHECK:
+				begin
+					cache_mux <= victim;
+
+					if (WRITEBACK != 0 && ~tags_dirty_out[victim] && tags_modified_out[victim]) begin
+						state       <= EVICT_READ;
+						evict_tag   <= tags_read[victim];
+						evict_index <= {LINESIZE_BITS{1'b0}};
+						evict_ret   <= FILLCHECK;
+					end
+					else begin
+						state            <= FILLCACHE;
+						MEM_LINE_REQ     <= 1'b1;
+						MEM_LINE_ADDR    <= { 4'd0, read_addr[ADDRBITS:LINESIZE_BITS], {LINESIZE_BITS{1'b0}}, 2'b00 };
+						fillcount        <= 0;
+						memory_addr_a    <= { read_addr[RAMSIZEBITS - 1:LINESIZE_BITS], {LINESIZE_BITS{1'b0}} };
+						tags_dirty_in    <= tags_dirty_out;
+						tags_modified_in <= tags_modified_out;
+						update_tag_addr  <= read_addr[LINEMASKMSB:LINEMASKLSB];
+					end
+				end
+
+			FILLCACHE:
+				begin
+					if (MEM_LINE_DONE) begin
+						MEM_LINE_REQ                <= 1'b0;
+						memory_datain               <= MEM_LINE_DATA;
+						memory_we[cache_mux]        <= 1'b1;
+						memory_be                   <= 4'hF;
+
+						tags_dirty_in[cache_mux]    <= 1'b0;
+						tags_modified_in[cache_mux] <= 1'b0;
+
+						if (fillcount > 0) memory_addr_a <= memory_addr_a + 1'd1;
+						if (fillcount < LINESIZE - 1) fillcount <= fillcount + 1'd1;
+						else begin
+						   state         <= READCACHE_OUT;
+						   update_tag_we <= 1'b1;
+						end
+					end
+				end
+
+			READCACHE_OUT:
+				state <= READONE;
+
+			// write-back: a write hit only updates the line, older snoops have to be applied first
+			WRITEHIT:
+				if (!Fifo_empty) state <= IDLE;
+				else if (hit) begin
+					memory_addr_a             <= read_addr[RAMSIZEBITS - 1:0];
+					memory_datain             <= wr_piece_shifted;
+					memory_be                 <= wr_piece_be;
+					memory_we[hit_way]        <= 1'b1;
+
+					cache_mux                 <= hit_way;
+					hit_valid                 <= 1'b1;
+					LRU_addr                  <= read_addr[LINEMASKMSB:LINEMASKLSB];
+
+					tags_dirty_in             <= tags_dirty_out;
+					tags_modified_in          <= tags_modified_out;
+					tags_modified_in[hit_way] <= 1'b1;
+					update_tag_addr           <= read_addr[LINEMASKMSB:LINEMASKLSB];
+					update_tag_we             <= 1'b1;
+
+					dma_clean                 <= 1'b0;
+
+					wr_piece                  <= ~wr_piece_last;
+					state                     <= (wr_piece_last)? WRITE_OUT : IDLE;
+				end
+				else state <= WRITEMEM;
+
+			WRITEMEM:
+				if (MEM_WR_DONE) begin
+					wr_piece <= ~wr_piece_last;
+					state    <= IDLE;
+				end
+
+			WRITE_OUT:
+				state <= IDLE;
+
+			// write-back of the line in cache_mux, one dword per write; dma is held meanwhile
+			EVICT_READ:
+				if (evict_index == 0 && !Fifo_empty) state <= IDLE;
+				else                                 state <= EVICT;
+
+			EVICT:
+				if (MEM_WR_DONE) begin
+					evict_index <= evict_index + 1'd1;
+					if (evict_index == LINESIZE - 1) begin
+						tags_dirty_in               <= tags_dirty_out;
+						tags_modified_in            <= tags_modified_out;
+						tags_modified_in[cache_mux] <= 1'b0;
+						update_tag_addr             <= read_addr[LINEMASKMSB:LINEMASKLSB];
+						update_tag_we               <= 1'b1;
+						state                       <= EVICT_DONE;
+					end
+					else state <= EVICT_READ;
+				end
+
+			EVICT_DONE:
+				state <= evict_ret;
+
+			DMACHECK:
+				if (hit && tags_modified_out[hit_way]) begin
+					state       <= EVICT_READ;
+					cache_mux   <= hit_way;
+					evict_tag   <= tags_read[hit_way];
+					evict_index <= {LINESIZE_BITS{1'b0}};
+					evict_ret   <= IDLE;
+				end
+				else begin
+					state          <= IDLE;
+					dma_clean      <= 1'b1;
+					dma_clean_addr <= read_addr[21:0];
+				end
+
+			// INVD and WBINVD: modified lines are written back in both cases
+			FLUSH:
+				if (!Fifo_empty) state <= IDLE;
+				else if (modified) begin
+					state       <= EVICT_READ;
+					cache_mux   <= modified_way;
+					evict_tag   <= tags_read[modified_way];
+					evict_index <= {LINESIZE_BITS{1'b0}};
+					evict_ret   <= FLUSH;
+				end
+				else begin
+					tags_dirty_in    <= {ASSOCIATIVITY{1'b1}};
+					tags_modified_in <= {ASSOCIATIVITY{1'b0}};
+					update_tag_addr  <= read_addr[LINEMASKMSB:LINEMASKLSB];
+					update_tag_we    <= 1'b1;
+
+					flush_set        <= flush_set + 1'd1;
+					read_addr[LINEMASKMSB:LINEMASKLSB] <= flush_set + 1'd1;
+
+					if (flush_set == {LINE_BITS{1'b1}}) state <= INV_OUT;
+				end
+
+			INV_OUT:
+				state <= IDLE;
+
+			default:
+				state <= IDLE;
+		endcase
+	end
+end
+
+// synthesis translate_off
+// simulation counters, read by the Verilator system harness
+reg [63:0] perf_reads      /*verilator public_flat_rd*/; // cached read requests
+reg [63:0] perf_fills      /*verilator public_flat_rd*/; // line fills from memory
+reg [63:0] perf_uncached   /*verilator public_flat_rd*/; // reads passed on: VGA window, ROM area, cache disable
+reg [63:0] perf_writes     /*verilator public_flat_rd*/; // write requests
+reg [63:0] perf_write_hits /*verilator public_flat_rd*/; // write-back: writes kept in the cache
+reg [63:0] perf_writebacks /*verilator public_flat_rd*/; // write-back: modified lines written to memory
+reg [63:0] perf_snoops     /*verilator public_flat_rd*/; // snooped writes
+reg [63:0] perf_snoop_hit  /*verilator public_flat_rd*/; // snooped writes updating a cached line
+
+always @(posedge CLK) begin : perf
+	integer k;
+	reg     tag_hit;
+
+	tag_hit = 1'b0;
+	for (k = 0; k < ASSOCIATIVITY; k = k + 1) begin
+		if (~tags_dirty_out[k] && tags_read[k] == read_addr[ADDRBITS:RAMSIZEBITS]) tag_hit = 1'b1;
+	end
+
+	if (RESET) begin
+		perf_reads      <= 64'd0;
+		perf_fills      <= 64'd0;
+		perf_uncached   <= 64'd0;
+		perf_writes     <= 64'd0;
+		perf_write_hits <= 64'd0;
+		perf_writebacks <= 64'd0;
+		perf_snoops     <= 64'd0;
+		perf_snoop_hit  <= 64'd0;
+	end
+	else begin
+		if (state == IDLE && Fifo_empty && ~(WRITEBACK != 0 && dma_rd && ~dma_clean_match) && ~INV_REQ && ~CPU_WR_REQ && CPU_RD_REQ && ~rd_bypass) perf_reads <= perf_reads + 1'd1;
+		if (rd_bypass_start || (state == READMEM && MEM_RD_DONE))            perf_uncached   <= perf_uncached + 1'd1;
+		if (state == FILLCACHE && MEM_LINE_DONE && fillcount == 0)          perf_fills      <= perf_fills + 1'd1;
+		if (CPU_WR_DONE)                                                     perf_writes     <= perf_writes + 1'd1;
+		if (state == WRITEHIT && Fifo_empty && tag_hit)                      perf_write_hits <= perf_write_hits + 1'd1;
+		if (state == EVICT && MEM_WR_DONE && evict_index == LINESIZE - 1)    perf_writebacks <= perf_writebacks + 1'd1;
+		if (state == IDLE && !Fifo_empty)                                    perf_snoops     <= perf_snoops + 1'd1;
+		if (state == WRITEONE && tag_hit)                                    perf_snoop_hit  <= perf_snoop_hit + 1'd1;
+	end
+end
+// synthesis translate_on
+
+altdpram #(
+	.indata_aclr("OFF"),
+	.indata_reg("INCLOCK"),
+	.intended_device_family("Cyclone V"),
+	.lpm_type("altdpram"),
+	.outdata_aclr("OFF"),
+	.outdata_reg("UNREGISTERED"),
+	.ram_block_type("MLAB"),
+	.rdaddress_aclr("OFF"),
+	.rdaddress_reg("UNREGISTERED"),
+	.rdcontrol_aclr("OFF"),
+	.rdcontrol_reg("UNREGISTERED"),
+	.read_during_write_mode_mixed_ports("CONSTRAINED_DONT_CARE"),
+	.width(ASSOCIATIVITY),
+	.widthad(LINE_BITS),
+	.width_byteena(1),
+	.wraddress_aclr("OFF"),
+	.wraddress_reg("INCLOCK"),
+	.wrcontrol_aclr("OFF"),
+	.wrcontrol_reg("INCLOCK")
+)
+dirtyram (
+	.inclock(CLK),
+	.outclock(CLK),
+
+	.data(tags_dirty_in),
+	.rdaddress(read_addr[LINEMASKMSB:LINEMASKLSB]),
+	.wraddress(update_tag_addr),
+	.wren(update_tag_we),
+	.q(tags_dirty_out)
+);
+
+generate
+	if (WRITEBACK != 0) begin : gmodified
+		altdpram #(
+			.indata_aclr("OFF"),
+			.indata_reg("INCLOCK"),
+			.intended_device_family("Cyclone V"),
+			.lpm_type("altdpram"),
+			.outdata_aclr("OFF"),
+			.outdata_reg("UNREGISTERED"),
+			.ram_block_type("MLAB"),
+			.rdaddress_aclr("OFF"),
+			.rdaddress_reg("UNREGISTERED"),
+			.rdcontrol_aclr("OFF"),
+			.rdcontrol_reg("UNREGISTERED"),
+			.read_during_write_mode_mixed_ports("CONSTRAINED_DONT_CARE"),
+			.width(ASSOCIATIVITY),
+			.widthad(LINE_BITS),
+			.width_byteena(1),
+			.wraddress_aclr("OFF"),
+			.wraddress_reg("INCLOCK"),
+			.wrcontrol_aclr("OFF"),
+			.wrcontrol_reg("INCLOCK")
+		)
+		modifiedram (
+			.inclock(CLK),
+			.outclock(CLK),
+
+			.data(tags_modified_in),
+			.rdaddress(read_addr[LINEMASKMSB:LINEMASKLSB]),
+			.wraddress(update_tag_addr),
+			.wren(update_tag_we),
+			.q(tags_modified_out)
+		);
+	end
+	else begin : gnomodified
+		assign tags_modified_out = {ASSOCIATIVITY{1'b0}};
+	end
+endgenerate
+
+generate
+	genvar i;
+	for (i = 0; i < ASSOCIATIVITY; i = i + 1) begin : gcache
+		altdpram #(
+			.indata_aclr("OFF"),
+			.indata_reg("INCLOCK"),
+			.intended_device_family("Cyclone V"),
+			.lpm_type("altdpram"),
+			.outdata_aclr("OFF"),
+			.outdata_reg("UNREGISTERED"),
+			.ram_block_type("MLAB"),
+			.rdaddress_aclr("OFF"),
+			.rdaddress_reg("UNREGISTERED"),
+			.rdcontrol_aclr("OFF"),
+			.rdcontrol_reg("UNREGISTERED"),
+			.read_during_write_mode_mixed_ports("CONSTRAINED_DONT_CARE"),
+			.width(ADDRBITS - RAMSIZEBITS + 1),
+			.widthad(LINE_BITS),
+			.width_byteena(1),
+			.wraddress_aclr("OFF"),
+			.wraddress_reg("INCLOCK"),
+			.wrcontrol_aclr("OFF"),
+			.wrcontrol_reg("INCLOCK")
+		)
+		tagram (
+			.inclock(CLK),
+			.outclock(CLK),
+
+			.data(read_addr[ADDRBITS:RAMSIZEBITS]),
+			.rdaddress(read_addr[LINEMASKMSB:LINEMASKLSB]),
+			.wraddress(read_addr[LINEMASKMSB:LINEMASKLSB]),
+			.wren((state == READCACHE_OUT) && (cache_mux == i)),
+			.q(tags_read[i])
+		);
+
+		altdpram #(
+			.indata_aclr("OFF"),
+			.indata_reg("INCLOCK"),
+			.intended_device_family("Cyclone V"),
+			.lpm_type("altdpram"),
+			.outdata_aclr("OFF"),
+			.outdata_reg("UNREGISTERED"),
+			.ram_block_type("MLAB"),
+			.rdaddress_aclr("OFF"),
+			.rdaddress_reg("UNREGISTERED"),
+			.rdcontrol_aclr("OFF"),
+			.rdcontrol_reg("UNREGISTERED"),
+			.read_during_write_mode_mixed_ports("CONSTRAINED_DONT_CARE"),
+			.width(ASSO_BITS),
+			.widthad(LINE_BITS),
+			.width_byteena(1),
+			.wraddress_aclr("OFF"),
+			.wraddress_reg("INCLOCK"),
+			.wrcontrol_aclr("OFF"),
+			.wrcontrol_reg("INCLOCK")
+		)
+		LRUram (
+			.inclock(CLK),
+			.outclock(CLK),
+
+			.data(LRU_in[i]),
+			.rdaddress(LRU_addr),
+			.wraddress(LRU_wraddr),
+			.wren(LRU_we),
+			.q(LRU_out[i])
+		);
+
+		altsyncram #(
+			.address_aclr_b("NONE"),
+			.address_reg_b("CLOCK0"),
+			.byte_size(8),
+			.clock_enable_input_a("BYPASS"),
+			.clock_enable_input_b("BYPASS"),
+			.clock_enable_output_b("BYPASS"),
+			.intended_device_family("Cyclone V"),
+			.lpm_type("altsyncram"),
+			.numwords_a(2**RAMSIZEBITS),
+			.numwords_b(2**RAMSIZEBITS),
+			.operation_mode("DUAL_PORT"),
+			.outdata_aclr_b("NONE"),
+			.outdata_reg_b("UNREGISTERED"),
+			.power_up_uninitialized("FALSE"),
+			.read_during_write_mode_mixed_ports("DONT_CARE"),
+			.widthad_a(RAMSIZEBITS),
+			.widthad_b(RAMSIZEBITS),
+			.width_a(32),
+			.width_b(32),
+			.width_byteena_a(4)
+		)
+		ram (
+			.clock0 (CLK),
+
+			.address_a(memory_addr_a),
+			.byteena_a(memory_be),
+			.data_a(memory_datain),
+			.wren_a(memory_we[i]),
+
+			.address_b(memory_addr_b),
+			.q_b(readdata_cache[i]),
+
+			.aclr0(1'b0),
+			.aclr1(1'b0),
+			.addressstall_a(1'b0),
+			.addressstall_b(1'b0),
+			.byteena_b(1'b1),
+			.clock1(1'b1),
+			.clocken0(1'b1),
+			.clocken1(1'b1),
+			.clocken2(1'b1),
+			.clocken3(1'b1),
+			.data_b(32'b0),
+			.eccstatus(),
+			.q_a(),
+			.rden_a(1'b1),
+			.rden_b(1'b1),
+			.wren_b(1'b0)
+		);
+	end
+endgenerate
+
+endmodule
@@ -1,5 +1,11 @@
 
 module l1_icache
+#(
+	parameter LINES         = 128, // sets
+	parameter LINESIZE      = 8,   // dwords, a multiple of the 8 dword readcode burst
+	parameter ASSOCIATIVITY = 4,   // ways: 1, 2, 4 or 8
+	parameter PREFETCH      = 0    // fetch the line after the one the cpu reads while idle
+)
 (
 	input             CLK,
 	input             RESET,
@@ -25,14 +31,11 @@ module l1_icache
 );
 
 // cache settings
-localparam LINES         = 128;
-localparam LINESIZE      = 8;
-localparam ASSOCIATIVITY = 4;
 localparam ADDRBITS      = 29;
 localparam CACHEBURST    = 4;
 
 // cache control
-localparam ASSO_BITS       = $clog2(ASSOCIATIVITY);
+localparam ASSO_BITS       = (ASSOCIATIVITY > 1) ? $clog2(ASSOCIATIVITY) : 1;
 localparam LINESIZE_BITS   = $clog2(LINESIZE);
 localparam LINE_BITS       = $clog2(LINES);
 localparam CACHEBURST_BITS = $clog2(CACHEBURST);
@@ -50,6 +53,7 @@ reg    [ASSO_BITS-1:0] LRU_in [0:ASSOCIATIVITY-1];
 reg    [ASSO_BITS-1:0] LRU_out[0:ASSOCIATIVITY-1];
 reg                             LRU_we;
 reg    [LINE_BITS-1:0]          LRU_addr;
+reg    [LINE_BITS-1:0]          LRU_wraddr;
 
 localparam [2:0]
 	START         = 0,
@@ -57,7 +61,8 @@ localparam [2:0]
 	WRITEONE      = 2,
 	READONE       = 3,
 	FILLCACHE     = 4,
-	READCACHE_OUT = 5;
+	READCACHE_OUT = 5,
+	PREFETCHCHECK = 6;
 	
 // memory
 wire             [31:0] readdata_cache[0:ASSOCIATIVITY-1];
@@ -76,6 +81,16 @@ reg [CACHEBURST_BITS-1:0] burstleft;
 reg   [2:0] state;
 reg         CPU_REQ_hold;
 
+// next line prefetch
+reg [ADDRBITS:LINESIZE_BITS] pf_line;
+reg                          pf_pending;
+reg                          prefetching;
+reg                          pf_cancel;
+reg                    [2:0] pf_drain; // words of a cancelled prefetch burst still to come, dropped
+
+// a word for the fill, not one of a cancelled prefetch
+wire mem_word = MEM_DONE && pf_drain == 3'd0;
+
 // fifo for snoop
 wire [61:0] Fifo_dout;
 wire        Fifo_empty;
@@ -118,12 +133,28 @@ always @(posedge CLK) begin : mainfsm
 
 		MEM_REQ         <= 1'b0;
 		CPU_REQ_hold    <= 1'b0;
+
+		pf_pending      <= 1'b0;
+		prefetching     <= 1'b0;
+		pf_cancel       <= 1'b0;
+		pf_drain        <= 3'd0;
 	end
 	else begin
 		if (CPU_REQ) CPU_REQ_hold <= 1'b1;
 
+		// a taken branch drops the next line, a prefetch already on the bus stops with the next word,
+		// so does one the cpu does not want next
+		if (MEM_DONE && pf_drain != 3'd0) pf_drain <= pf_drain - 1'd1;
+		if (pr_reset) begin
+			pf_pending <= 1'b0;
+			if (prefetching) pf_cancel <= 1'b1;
+		end
+		if (prefetching && CPU_REQ && CPU_ADDR[ADDRBITS+2:LINESIZE_BITS+2] != read_addr[ADDRBITS:LINESIZE_BITS]) pf_cancel <= 1'b1;
+
 		// LRU update after read
-		LRU_we <= CPU_VALID && ~LRU_we;
+		// the set of the read, LRU_addr may already move on to the next one
+		LRU_we     <= CPU_VALID && ~LRU_we;
+		LRU_wraddr <= LRU_addr;
 		for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
 			LRU_in[i] <= LRU_out[i];
 			if (cache_mux == i[ASSO_BITS-1:0]) begin
@@ -146,6 +177,7 @@ always @(posedge CLK) begin : mainfsm
 					LRU_in[i]    <= i[ASSO_BITS-1:0]; 
 				end
 				LRU_addr        <= update_tag_addr;
+				LRU_wraddr      <= update_tag_addr;
 				LRU_we          <= 1'b1; 
 				
 				if (update_tag_addr == {LINE_BITS{1'b1}}) begin
@@ -171,6 +203,11 @@ always @(posedge CLK) begin : mainfsm
 						CPU_REQ_hold  <= 1'b0;
 						burstleft     <= CACHEBURST[CACHEBURST_BITS-1:0] - 1'd1;
 					end
+					else if (pf_pending && ~DISABLE) begin
+						state         <= PREFETCHCHECK;
+						read_addr     <= { pf_line, {LINESIZE_BITS{1'b0}} };
+						pf_pending    <= 1'b0;
+					end
 				end
 			
 			WRITEONE:
@@ -189,6 +226,9 @@ always @(posedge CLK) begin : mainfsm
 						state     <= IDLE;
 						CPU_DONE  <= 1'b1;
 					end else begin
+						pf_line         <= read_addr[ADDRBITS:LINESIZE_BITS] + 1'd1;
+						pf_pending      <= (PREFETCH != 0) && ~force_fetch;
+
 						state           <= FILLCACHE;
 						MEM_REQ         <= 1'b1;
 						MEM_ADDR        <= {read_addr[ADDRBITS:LINESIZE_BITS], {LINESIZE_BITS{1'b0}}, 2'b00};
@@ -228,11 +268,14 @@ always @(posedge CLK) begin : mainfsm
 			
 			FILLCACHE:
 				begin
-					for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
-						if (LRU_out[i] == {ASSO_BITS{1'b1}} ) cache_mux <= i[ASSO_BITS-1:0]; 
+					// the way is fixed with the first word, a late LRU write must not move the rest of the line
+					if (fillcount == 0 && ~mem_word) begin
+						for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+							if (LRU_out[i] == ASSOCIATIVITY - 1) cache_mux <= i[ASSO_BITS-1:0];
+						end
 					end
 
-					if (MEM_DONE) begin
+					if (mem_word) begin
 						MEM_REQ              <= 1'b0;
 						memory_datain        <= MEM_DATA;
 						memory_we[cache_mux] <= 1'b1;
@@ -241,7 +284,24 @@ always @(posedge CLK) begin : mainfsm
 						tags_dirty_in[cache_mux] <= 1'b0;
 
 						if (fillcount > 0) memory_addr_a <= memory_addr_a + 1'd1;
-						if (fillcount < LINESIZE - 1) fillcount <= fillcount + 1'd1;
+						if (fillcount < LINESIZE - 1) begin
+							fillcount <= fillcount + 1'd1;
+							// longer lines are filled with one readcode burst after the other
+							if (fillcount[2:0] == 3'd7) begin
+								MEM_REQ  <= 1'b1;
+								MEM_ADDR <= MEM_ADDR + 32'd32;
+							end
+							// a cancelled prefetch stops here and the way is left invalid. The readcode burst
+							// can not be cut short: its last words are dropped as they come, while the cpu
+							// goes on with hits and its own miss waits only for the end of that burst
+							if (prefetching && (pf_cancel || pr_reset)) begin
+								MEM_REQ                  <= 1'b0;
+								tags_dirty_in[cache_mux] <= 1'b1;
+								state                    <= READCACHE_OUT;
+								update_tag_we            <= 1'b1;
+								pf_drain                 <= 3'd7 - fillcount[2:0];
+							end
+						end
 						else begin 
 						   state         <= READCACHE_OUT;
 						   update_tag_we <= 1'b1;
@@ -251,13 +311,113 @@ always @(posedge CLK) begin : mainfsm
 			
 			READCACHE_OUT :
 				begin
-					state         <= READONE;
+					state         <= prefetching ? IDLE : READONE;
 					update_tag_we <= 1'b0;
+					prefetching   <= 1'b0;
+					pf_cancel     <= 1'b0;
+				end
+
+			// the line is filled like a miss, but the cpu does not wait for it and the
+			// LRU is left alone: an unused prefetch is the first to be replaced
+			PREFETCHCHECK:
+				begin
+					state <= IDLE;
+					if (~CPU_REQ && ~pr_reset) begin
+						state           <= FILLCACHE;
+						prefetching     <= 1'b1;
+						MEM_REQ         <= 1'b1;
+						MEM_ADDR        <= {read_addr[ADDRBITS:LINESIZE_BITS], {LINESIZE_BITS{1'b0}}, 2'b00};
+						fillcount       <= 0;
+						memory_addr_a   <= {read_addr[RAMSIZEBITS - 1:LINESIZE_BITS], {LINESIZE_BITS{1'b0}}};
+						tags_dirty_in   <= tags_dirty_out;
+						update_tag_addr <= read_addr[LINEMASKMSB:LINEMASKLSB];
+						LRU_addr        <= read_addr[LINEMASKMSB:LINEMASKLSB];
+
+						for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
+							if (~tags_dirty_out[i]) begin
+								if (tags_read[i] == read_addr[ADDRBITS:RAMSIZEBITS]) begin
+									state       <= IDLE;
+									prefetching <= 1'b0;
+									MEM_REQ     <= 1'b0;
+								end
+							end
+						end
+					end
 				end
 		endcase
 	end
 end
 
+// synthesis translate_off
+// simulation counters, read by the Verilator system harness
+reg [63:0] perf_requests  /*verilator public_flat_rd*/; // cpu read requests
+reg [63:0] perf_fills     /*verilator public_flat_rd*/; // line fills from memory, misses and disabled reads
+reg [63:0] perf_evictions /*verilator public_flat_rd*/; // fills replacing a valid line
+reg [63:0] perf_snoops    /*verilator public_flat_rd*/; // snooped data writes
+reg [63:0] perf_snoop_hit /*verilator public_flat_rd*/; // snooped writes updating a cached line
+reg [63:0] perf_prefetches      /*verilator public_flat_rd*/; // next line fills started
+reg [63:0] perf_prefetch_useful /*verilator public_flat_rd*/; // prefetched lines the cpu read later
+reg [63:0] perf_prefetch_wasted /*verilator public_flat_rd*/; // prefetched lines cancelled or dropped unread;
+                                                               // a cancelled one still ends its 8 dword burst on the bus
+
+reg [ASSOCIATIVITY-1:0] perf_pf_unread[0:LINES-1];
+
+always @(posedge CLK) begin : perf
+	integer k;
+	integer wasted;
+	reg     tag_hit;
+	reg [ASSO_BITS-1:0] hit_way;
+
+	tag_hit = 1'b0;
+	hit_way = 0;
+	for (k = 0; k < ASSOCIATIVITY; k = k + 1) begin
+		if (~tags_dirty_out[k] && tags_read[k] == read_addr[ADDRBITS:RAMSIZEBITS]) begin
+			tag_hit = 1'b1;
+			hit_way = k;
+		end
+	end
+
+	if (RESET) begin
+		perf_requests  <= 64'd0;
+		perf_fills     <= 64'd0;
+		perf_evictions <= 64'd0;
+		perf_snoops    <= 64'd0;
+		perf_snoop_hit <= 64'd0;
+
+		perf_prefetches      <= 64'd0;
+		perf_prefetch_useful <= 64'd0;
+		perf_prefetch_wasted <= 64'd0;
+		for (k = 0; k < LINES; k = k + 1) perf_pf_unread[k] <= {ASSOCIATIVITY{1'b0}};
+	end
+	else begin
+		// a prefetched line is useful when a cpu read hits it, wasted when it is replaced,
+		// invalidated or cancelled first
+		wasted = 0;
+		if (state == PREFETCHCHECK && ~CPU_REQ && ~pr_reset && ~tag_hit) perf_prefetches <= perf_prefetches + 1'd1;
+		if (state == READONE && ~pr_reset && ~force_next && tag_hit && perf_pf_unread[read_addr[LINEMASKMSB:LINEMASKLSB]][hit_way]) begin
+			perf_prefetch_useful <= perf_prefetch_useful + 1'd1;
+			perf_pf_unread[read_addr[LINEMASKMSB:LINEMASKLSB]][hit_way] <= 1'b0;
+		end
+		if (state == READONE && ~pr_reset && force_next) begin
+			for (k = 0; k < ASSOCIATIVITY; k = k + 1) wasted = wasted + perf_pf_unread[read_addr[LINEMASKMSB:LINEMASKLSB]][k];
+			perf_pf_unread[read_addr[LINEMASKMSB:LINEMASKLSB]] <= {ASSOCIATIVITY{1'b0}};
+		end
+		if (state == READCACHE_OUT) begin
+			if (perf_pf_unread[update_tag_addr][cache_mux])  wasted = wasted + 1;
+			if (prefetching && tags_dirty_in[cache_mux])     wasted = wasted + 1;
+			perf_pf_unread[update_tag_addr][cache_mux] <= prefetching && ~tags_dirty_in[cache_mux];
+		end
+		perf_prefetch_wasted <= perf_prefetch_wasted + wasted;
+
+		if (state == IDLE && Fifo_empty && (CPU_REQ || CPU_REQ_hold))  perf_requests  <= perf_requests + 1'd1;
+		if (state == IDLE && !Fifo_empty)                              perf_snoops    <= perf_snoops + 1'd1;
+		if (state == WRITEONE && tag_hit)                              perf_snoop_hit <= perf_snoop_hit + 1'd1;
+		if (state == READONE && ~pr_reset && (force_next || ~tag_hit)) perf_fills     <= perf_fills + 1'd1;
+		if (state == FILLCACHE && mem_word && fillcount == 0 && ~tags_dirty_in[cache_mux]) perf_evictions <= perf_evictions + 1'd1;
+	end
+end
+// synthesis translate_on
+
 altdpram #(
 	.indata_aclr("OFF"),
 	.indata_reg("INCLOCK"),
@@ -352,7 +512,7 @@ generate
 			
 			.data(LRU_in[i]),
 			.rdaddress(LRU_addr),
-			.wraddress(LRU_addr),
+			.wraddress(LRU_wraddr),
 			.wren(LRU_we),
 			.q(LRU_out[i])
 		);
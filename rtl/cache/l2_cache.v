@@ -1,5 +1,11 @@
 
-module l2_cache #(parameter ADDRBITS = 24)
+module l2_cache
+#(
+	parameter ADDRBITS      = 24,
+	parameter LINES         = 128, // sets
+	parameter LINESIZE      = 8,   // 64 bit words, one DDRAM burst of up to 128
+	parameter ASSOCIATIVITY = 4    // ways: 1, 2, 4 or 8
+)
 (
 	input         CLK,
 	input         RESET,
@@ -43,14 +49,8 @@ module l2_cache #(parameter ADDRBITS = 24)
 	input         uma_ram
 );
 
-
-// cache settings
-localparam LINES         = 128;
-localparam LINESIZE      = 8;
-localparam ASSOCIATIVITY = 4;	
-
 // cache control
-localparam ASSO_BITS     = $clog2(ASSOCIATIVITY);
+localparam ASSO_BITS     = (ASSOCIATIVITY > 1) ? $clog2(ASSOCIATIVITY) : 1;
 localparam LINESIZE_BITS = $clog2(LINESIZE);
 localparam LINE_BITS     = $clog2(LINES);
 localparam RAMSIZEBITS   = $clog2(LINESIZE * LINES);
@@ -68,6 +68,7 @@ reg    [ASSO_BITS-1:0] LRU_in [0:ASSOCIATIVITY-1];
 reg    [ASSO_BITS-1:0] LRU_out[0:ASSOCIATIVITY-1];
 reg                             LRU_we;
 reg    [LINE_BITS-1:0]          LRU_addr;
+reg    [LINE_BITS-1:0]          LRU_wraddr;
 
 localparam [3:0]
    START         = 0,
@@ -219,7 +220,9 @@ always @(posedge CLK) begin
 		end
 
 		// LRU update after read
-		LRU_we <= ram_dout_ready && ~LRU_we;
+		// the set of the read, LRU_addr may already move on to the next one
+		LRU_we     <= ram_dout_ready && ~LRU_we;
+		LRU_wraddr <= LRU_addr;
 		for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
 			LRU_in[i] <= LRU_out[i];
 			if (cache_mux == i[ASSO_BITS-1:0]) begin
@@ -245,6 +248,7 @@ always @(posedge CLK) begin
 						LRU_in[i]    <= i[ASSO_BITS-1:0]; 
 					end
 					LRU_addr        <= update_tag_addr;
+					LRU_wraddr      <= update_tag_addr;
 					LRU_we          <= 1'b1; 
 
 					if (update_tag_addr == {LINE_BITS{1'b1}}) begin
@@ -379,7 +383,7 @@ always @(posedge CLK) begin
 			FILLCACHE:
 				begin
 					for (i = 0; i < ASSOCIATIVITY; i = i + 1'd1) begin
-						if (LRU_out[i] == {ASSO_BITS{1'b1}} ) cache_mux <= i[ASSO_BITS-1:0]; 
+						if (LRU_out[i] == ASSOCIATIVITY - 1) cache_mux <= i[ASSO_BITS-1:0]; 
 					end
 
 					if (DDRAM_DOUT_READY) begin
@@ -473,6 +477,54 @@ always @(posedge CLK) begin
 	end
 end
 
+// synthesis translate_off
+// simulation counters, read by the Verilator system harness
+reg [63:0] perf_reads       /*verilator public_flat_rd*/; // cached read requests
+reg [63:0] perf_fills       /*verilator public_flat_rd*/; // line fills from DDRAM, misses and uncached reads
+reg [63:0] perf_uncached    /*verilator public_flat_rd*/; // fills forced by DISABLE or the shared folder region
+reg [63:0] perf_evictions   /*verilator public_flat_rd*/; // fills replacing a valid line
+reg [63:0] perf_writes      /*verilator public_flat_rd*/; // writes through to DDRAM
+reg [63:0] perf_write_hits  /*verilator public_flat_rd*/; // writes that also updated a cached line
+reg [63:0] perf_vga_reads   /*verilator public_flat_rd*/; // reads passed to the VGA window
+reg [63:0] perf_vga_writes  /*verilator public_flat_rd*/; // writes passed to the VGA window
+
+wire perf_request = state == IDLE && ~DDRAM_BUSY;
+wire perf_vga     = vga_rgn && ram_rgn && ~VGA_FB_EN;
+
+always @(posedge CLK) begin : perf
+	integer k;
+	reg     tag_hit;
+
+	tag_hit = 1'b0;
+	for (k = 0; k < ASSOCIATIVITY; k = k + 1) begin
+		if (~tags_dirty_out[k] && tags_read[k] == read_addr[ADDRBITS:RAMSIZEBITS]) tag_hit = 1'b1;
+	end
+
+	if (RESET) begin
+		perf_reads      <= 64'd0;
+		perf_fills      <= 64'd0;
+		perf_uncached   <= 64'd0;
+		perf_evictions  <= 64'd0;
+		perf_writes     <= 64'd0;
+		perf_write_hits <= 64'd0;
+		perf_vga_reads  <= 64'd0;
+		perf_vga_writes <= 64'd0;
+	end
+	else begin
+		if (perf_request && CPU_RD && ~perf_vga)                                        perf_reads      <= perf_reads + 1'd1;
+		if (perf_request && CPU_RD && perf_vga)                                         perf_vga_reads  <= perf_vga_reads + 1'd1;
+		if (perf_request && ~CPU_RD && CPU_WE && (~rom_rgn | shr_rgn) && ram_rgn) begin
+			if (vga_rgn && ~VGA_FB_EN)                                                  perf_vga_writes <= perf_vga_writes + 1'd1;
+			else                                                                        perf_writes     <= perf_writes + 1'd1;
+		end
+		if (state == WRITEONE && tag_hit)                                               perf_write_hits <= perf_write_hits + 1'd1;
+		if (state == READONE && (force_next || ~tag_hit))                               perf_fills      <= perf_fills + 1'd1;
+		if (state == READONE && force_next)                                             perf_uncached   <= perf_uncached + 1'd1;
+		if (state == FILLCACHE && DDRAM_DOUT_READY && fillcount == 0 && ~tags_dirty_in[cache_mux]) perf_evictions <= perf_evictions + 1'd1;
+	end
+end
+// synthesis translate_on
+
 altdpram #(
 	.indata_aclr("OFF"),
 	.indata_reg("INCLOCK"),
@@ -567,7 +619,7 @@ generate
 			
 			.data(LRU_in[i]),
 			.rdaddress(LRU_addr),
-			.wraddress(LRU_addr),
+			.wraddress(LRU_wraddr),
 			.wren(LRU_we),
 			.q(LRU_out[i])
 		);
@@ -71,7 +71,7 @@ module floppy
 	output      [1:0] request
 );
 
-reg [27:0] clk_rate;
+reg [27:0] clk_rate /*verilator public_flat_rd*/;
 always @(posedge clk) clk_rate <= clock_rate;
 
 //------------------------------------------------------------------------------ media management
@@ -490,7 +490,7 @@ always @(posedge clk) pending_interrupt_last <= pending_interrupt;
 
 //------------------------------------------------------------------------------ cmd: recalibrate / seek
 
-reg [7:0] delay_steps;
+reg [7:0] delay_steps /*verilator public_flat_rd*/;
 always @(posedge clk) begin
 	if(~rst_n)                                        delay_steps <= 8'd0;
 	else if(cmd_recalibrate_start)                    delay_steps <= (cylinder[selected_drive[0]] == 8'd0)? 8'd0 : cylinder[selected_drive[0]] - 8'd1;
@@ -498,7 +498,7 @@ always @(posedge clk) begin
 	else if(!delay_rate && !delay_srt && delay_steps) delay_steps <= delay_steps - 8'd1;
 end
 
-reg [3:0] delay_srt;
+reg [3:0] delay_srt /*verilator public_flat_rd*/;
 always @(posedge clk) begin
 	if(~rst_n)                          delay_srt <= 4'd0;
 	else if(cmd_recalibrate_start)      delay_srt <= specify_srt;
@@ -509,14 +509,14 @@ end
 
 wire [27:0] delay_adder = (data_rate == 2'd0)? 28'd1000 : (data_rate == 2'd1)? 28'd600 : (data_rate == 2'd2)? 28'd500 : 28'd2000;
 
-reg [27:0] delay_adder_r;
+reg [27:0] delay_adder_r /*verilator public_flat_rd*/;
 always @(posedge clk) begin
 	if(cmd_recalibrate_start)         delay_adder_r <= delay_adder;
 	else if(cmd_seek_start)           delay_adder_r <= delay_adder;
 	else if(delay_srt || delay_steps) delay_adder_r <= delay_adder;
 end
 
-reg [27:0] delay_rate;
+reg [27:0] delay_rate /*verilator public_flat_rd*/;
 always @(posedge clk) begin
 	if(~rst_n)                        delay_rate <= 0;
 	else if(cmd_recalibrate_start)    delay_rate <= delay_adder;
@@ -679,7 +679,7 @@ localparam [3:0] S_SD_WRITE_WAIT_FOR_EMPTY_FIFO = 11;
 localparam [3:0] S_WAIT_FOR_FORMAT_INPUT        = 12;
 localparam [3:0] S_SD_FORMAT_WAIT_FOR_FILL      = 13;
 
-reg [3:0] state;
+reg [3:0] state /*verilator public_flat_rd*/;
 always @(posedge clk) begin
 	if(~rst_n)                                                                    state <= S_IDLE;
 
@@ -53,7 +53,7 @@ module pit(
 // 315/22 * 1/12 = PIT frequency              = 105/88 MHz =  1.193181818... MHz = 13125000 / 11 Hz
 
 localparam INCREMENT = 32'd26250000; // = 11 * (2 * PIT_frequency)
-reg [31:0] clk_rate;                 // = 11 * (clock_rate)
+reg [31:0] clk_rate /*verilator public_flat_rd*/; // = 11 * (clock_rate)
 always @(posedge clk) begin
     clk_rate <= ({4'b0, clock_rate} << 3) + ({4'b0, clock_rate} << 1) + {4'b0, clock_rate};
 end
@@ -70,7 +70,7 @@ always @(posedge clk) read_last <= read;
 
 // BCD 0: Binary counter 16-bits
 // BCD 1: Binary coded decimal (BCD) counter (4 decades)
-reg bcd;
+reg bcd /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(!rst_n)                bcd <= 1'd0;
     else if(set_control_mode) bcd <= data_in[0];
@@ -82,7 +82,7 @@ end
 // Mode 3: Square wave mode
 // Mode 4: Software triggered strobe
 // Mode 5: Hardware triggered strobe (retriggerable)
-reg [2:0] mode;
+reg [2:0] mode /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(!rst_n)                mode <= 3'd2;
     else if(set_control_mode) mode <= data_in[3:1];
@@ -429,7 +429,8 @@ wire [15:0] counter_minus_1 =
 // On the falling edge of clock the counter can be:
 // - Reset to the (re)load value
 // - Decremented
-reg [15:0] counter;
+// counter, mode and bcd give the idle skip of the Verilator harness its next event
+reg [15:0] counter /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(!rst_n)               counter <= 16'd0;
     else if(load_counter)    counter <= { counter_m, counter_l[7:1], counter_l[0] & (mode[1:0] != 2'd3) };
@@ -639,7 +639,7 @@ localparam [3:0] PS2_WAIT                   = 4'd14;  // Waiting
 localparam [3:0] PS2_WAIT_FINISH            = 4'd15;  // End wait period
 
 // Keyboard state machine
-reg [3:0] keyb_state;
+reg [3:0] keyb_state /*verilator public_flat_rd*/;
 
 always @(posedge clk) begin
     if(rst_n == 1'b0)                                                                                               keyb_state <= PS2_IDLE;
@@ -857,7 +857,7 @@ end
 wire mouse_recv_final = mouse_state == PS2_RECV_WAIT_FOR_IDLE && mouse_mouseclk == 1'b1 && mouse_mousedat == 1'b1 && mouse_recv_result;
 
 // Mouse state machine
-reg [3:0] mouse_state;
+reg [3:0] mouse_state /*verilator public_flat_rd*/;
 
 always @(posedge clk) begin
     if(rst_n == 1'b0)                                                                                                       mouse_state <= PS2_IDLE;
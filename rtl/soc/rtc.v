@@ -51,7 +51,7 @@ module rtc(
 	input      [27:0] clock_rate
 );
 
-reg [27:0] clk_rate;
+reg [27:0] clk_rate /*verilator public_flat_rd*/;
 always @(posedge clk) clk_rate <= clock_rate;
 
 reg ce_800hz;
@@ -132,7 +132,7 @@ localparam [2:0] SEC_SECOND_START       = 3'd2;
 localparam [2:0] SEC_SECOND_IN_PROGRESS = 3'd3;
 localparam [2:0] SEC_STOPPED            = 3'd4;
 
-reg [2:0] sec_state;
+reg [2:0] sec_state /*verilator public_flat_rd*/;
 
 always @(posedge clk) begin
     if(rst_n == 1'b0)                                                sec_state <= SEC_UPDATE_START;
@@ -146,7 +146,7 @@ always @(posedge clk) begin
     else if(sec_state == SEC_SECOND_IN_PROGRESS && sec_timeout == 1) sec_state <= SEC_UPDATE_START;
 end
 
-reg [10:0] sec_timeout;
+reg [10:0] sec_timeout /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(rst_n == 1'b0)                               sec_timeout <= 4;
     else if(crb_freeze || divider[2:1] == 2'b11)    sec_timeout <= 4;
@@ -391,19 +391,19 @@ always @(posedge clk) begin
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0B)     crb_freeze <= io_writedata[7];
 end
 
-reg crb_int_periodic_ena;
+reg crb_int_periodic_ena /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(mgmt_write && mgmt_address == 8'h0B)                             crb_int_periodic_ena <= mgmt_writedata[6];
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0B)     crb_int_periodic_ena <= io_writedata[6];
 end
 
-reg crb_int_alarm_ena;
+reg crb_int_alarm_ena /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(mgmt_write && mgmt_address == 8'h0B)                             crb_int_alarm_ena <= mgmt_writedata[5];
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0B)     crb_int_alarm_ena <= io_writedata[5];
 end
 
-reg crb_int_update_ena;
+reg crb_int_update_ena /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(mgmt_write && mgmt_address == 8'h0B)                             crb_int_update_ena <= ~(mgmt_writedata[7]) & mgmt_writedata[4];
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0B)     crb_int_update_ena <= ~(io_writedata[7]) & io_writedata[4];
@@ -434,13 +434,13 @@ divider 00x : no periodic
 divider 11x : no update, no alarm
 */
 
-reg [2:0] divider;
+reg [2:0] divider /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(mgmt_write && mgmt_address == 8'h0A)                             divider <= mgmt_writedata[6:4];
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0A)     divider <= io_writedata[6:4];
 end
 
-reg [3:0] periodic_rate;
+reg [3:0] periodic_rate /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(mgmt_write && mgmt_address == 8'h0A)                             periodic_rate <= mgmt_writedata[3:0];
     else if(io_write && io_address == 1'b1 && ram_address == 7'h0A)     periodic_rate <= io_writedata[3:0];
@@ -457,7 +457,7 @@ wire [12:0] periodic_major_initial = {
     periodic_rate == 4'd7,  periodic_rate == 4'd6,  periodic_rate == 4'd5,  periodic_rate == 4'd4,
     periodic_rate == 4'd3 };
 
-reg [12:0] periodic_major;
+reg [12:0] periodic_major /*verilator public_flat_rd*/;
 always @(posedge clk) begin
     if(rst_n == 1'b0)                                         periodic_major <= 13'd0;
     else if(~periodic_enabled)                                periodic_major <= 13'd0;
@@ -1,5 +1,18 @@
 
 module system
+#(
+	parameter L1I_LINES            = 128, // rtl/cache/l1_icache.v
+	parameter L1I_LINESIZE         = 8,   // dwords
+	parameter L1I_ASSOCIATIVITY    = 4,
+	parameter L1I_PREFETCH         = 0,   // next line prefetch
+	parameter DCACHE               = 0,   // rtl/cache/l1_dcache.v, 1 builds it in
+	parameter DCACHE_LINES         = 128,
+	parameter DCACHE_ASSOCIATIVITY = 4,
+	parameter DCACHE_WRITEBACK     = 0,
+	parameter L2_LINES             = 128, // rtl/cache/l2_cache.v
+	parameter L2_LINESIZE          = 8,   // 64 bit words
+	parameter L2_ASSOCIATIVITY     = 4
+)
 (
 	input         reset,
 
@@ -240,7 +253,13 @@ wire  [5:0] video_rd_seg;
 
 assign      DDRAM_CLK = clk_sys;
 
-l2_cache cache
+l2_cache
+#(
+	.LINES             (L2_LINES),
+	.LINESIZE          (L2_LINESIZE),
+	.ASSOCIATIVITY     (L2_ASSOCIATIVITY)
+)
+cache
 (
 	.CLK               (clk_sys),
 	.RESET             (reset),
@@ -281,7 +300,18 @@ l2_cache cache
 	.uma_ram           (uma_ram)
 );
 
-ao486 ao486
+ao486
+#(
+	.ICACHE_LINES         (L1I_LINES),
+	.ICACHE_LINESIZE      (L1I_LINESIZE),
+	.ICACHE_ASSOCIATIVITY (L1I_ASSOCIATIVITY),
+	.ICACHE_PREFETCH      (L1I_PREFETCH),
+	.DCACHE               (DCACHE),
+	.DCACHE_LINES         (DCACHE_LINES),
+	.DCACHE_ASSOCIATIVITY (DCACHE_ASSOCIATIVITY),
+	.DCACHE_WRITEBACK     (DCACHE_WRITEBACK)
+)
+ao486
 (
 	.clk               (clk_sys),
 	.rst_n             (~reset),
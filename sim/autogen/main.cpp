@@ -0,0 +1,1545 @@
+/*
+ * Generator for the files in rtl/ao486/autogen.
+ *
+ * Inputs:
+ *   - the rtl/ao486/commands files, sections <defines>, <decode>, <microcode>,
+ *     <read>, <execute>, <write> and the verbatim <read_local> etc. sections,
+ *   - the SCRIPT comment blocks of the files that include an autogen file
+ *     (exception.v, the memory files, pipeline/write_commands.v); these files
+ *     also give the widths of the generated signals from their declarations.
+ *
+ * The output follows the original generator: command files in its order
+ * (command_order below), signals and defines in the iteration order of its
+ * hash maps, multi-line text folded the same way. The checked-in files are
+ * given back byte for byte, so a regeneration only shows the real changes.
+ * The entries of a signal follow the command file order, which sets their
+ * priority where the conditions of two command files overlap.
+ *
+ * Besides the autogen files a report is written with, per decoded command:
+ * how dec_is_complex is set and a static estimate of its microcode length
+ * (the longest path of micro-operations from the decoded cmdex, subroutines
+ * included).
+ *
+ * usage: autogen [-o output_dir] [-r report_file] [ao486_dir]
+ */
+
+#include <cctype>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------ text helpers
+
+static bool read_file(const std::string &name, std::string &text) {
+    FILE *fp = fopen(name.c_str(), "rb");
+    if(fp == NULL) return false;
+
+    text.clear();
+    char buf[65536];
+    size_t rd;
+    while((rd = fread(buf, 1, sizeof(buf), fp)) > 0) text.append(buf, rd);
+    fclose(fp);
+
+    //the command files have dos line endings in places
+    text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+    return true;
+}
+
+static bool write_file(const std::string &name, const std::string &text) {
+    FILE *fp = fopen(name.c_str(), "wb");
+    if(fp == NULL) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    fclose(fp);
+    return ok;
+}
+
+static std::string trim(const std::string &str) {
+    size_t start = str.find_first_not_of(" \t\n");
+    if(start == std::string::npos) return "";
+    size_t end = str.find_last_not_of(" \t\n");
+    return str.substr(start, end - start + 1);
+}
+
+static bool starts_with(const std::string &str, const char *prefix) {
+    return str.compare(0, strlen(prefix), prefix) == 0;
+}
+
+//multi-line text is written on one line: line breaks, with the blank lines and indentation after them, become one space
+static std::string join_lines(const std::string &str) {
+    std::string result;
+    for(size_t i=0; i<str.size(); i++) {
+        if(str[i] != '\n') {
+            result += str[i];
+            continue;
+        }
+        while(i + 1 < str.size() && isspace((unsigned char)str[i + 1])) i++;
+        result += ' ';
+    }
+    return result;
+}
+
+static bool is_ident(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+//all `NAME macro references starting with 'prefix' ("`CMD_", "`CMDEX_"), without the backtick
+static std::vector<std::string> find_macros(const std::string &text, const char *prefix) {
+    std::vector<std::string> result;
+    size_t length = strlen(prefix);
+    for(size_t pos = text.find(prefix); pos != std::string::npos; pos = text.find(prefix, pos + 1)) {
+        size_t end = pos + length;
+        while(end < text.size() && is_ident(text[end])) end++;
+        if(end < text.size() || end > pos + length) result.push_back(text.substr(pos + 1, end - pos - 1));
+    }
+    return result;
+}
+
+static std::string format_text(const char *format, ...) __attribute__((format(printf, 1, 2)));
+static std::string format_text(const char *format, ...) {
+    char buf[4096];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return buf;
+}
+
+static int errors = 0;
+
+static void error(const std::string &where, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static void error(const std::string &where, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s: ", where.c_str());
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    errors++;
+}
+
+//------------------------------------------------------------------------------ script statements
+
+/* KEYWORD(arguments); statements; comments are skipped between statements, the
+ * arguments are kept as written (on one line with one_line, for the command
+ * files). A line starting with a `macro is a statement of its own (keyword
+ * "`", the macro as argument), used by <microcode>.
+ */
+struct statement_t {
+    std::string keyword;
+    std::string args;
+    int         line;
+};
+
+static bool parse_statements(const std::string &text, const std::string &where, int first_line, bool one_line, std::vector<statement_t> &result) {
+    size_t pos  = 0;
+    int    line = first_line;
+
+    while(pos < text.size()) {
+        char c = text[pos];
+
+        if(c == '\n') { line++; pos++; continue; }
+        if(isspace((unsigned char)c)) { pos++; continue; }
+
+        if(text.compare(pos, 2, "//") == 0) {
+            pos = text.find('\n', pos);
+            if(pos == std::string::npos) pos = text.size();
+            continue;
+        }
+        if(text.compare(pos, 2, "/*") == 0) {
+            size_t end = text.find("*/", pos + 2);
+            if(end == std::string::npos) end = text.size();
+            line += std::count(text.begin() + pos, text.begin() + std::min(end, text.size()), '\n');
+            pos = std::min(end + 2, text.size());
+            continue;
+        }
+
+        statement_t statement;
+        statement.line = line;
+
+        if(c == '`') {
+            size_t end = pos + 1;
+            while(end < text.size() && is_ident(text[end])) end++;
+            statement.keyword = "`";
+            statement.args    = text.substr(pos, end - pos);
+            result.push_back(statement);
+            pos = end;
+            continue;
+        }
+
+        size_t end = pos;
+        while(end < text.size() && is_ident(text[end])) end++;
+        if(end == pos || end >= text.size() || text[end] != '(') {
+            error(where, "line %d: statement expected", line);
+            return false;
+        }
+        statement.keyword = text.substr(pos, end - pos);
+
+        int depth = 0;
+        size_t args_start = end + 1;
+        for(pos = end; pos < text.size(); pos++) {
+            if(text[pos] == '(') depth++;
+            if(text[pos] == ')') depth--;
+            if(text[pos] == '\n') line++;
+            if(depth == 0) break;
+        }
+        if(pos >= text.size()) {
+            error(where, "line %d: unbalanced parentheses in %s", statement.line, statement.keyword.c_str());
+            return false;
+        }
+        //comments inside multi-line arguments are dropped
+        for(size_t i=args_start; i<pos; i++) {
+            if(text.compare(i, 2, "//") == 0) {
+                while(i < pos && text[i] != '\n') i++;
+            }
+            if(i < pos) statement.args += text[i];
+        }
+        if(one_line) statement.args = join_lines(statement.args);
+        pos++;
+
+        while(pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) pos++;
+        if(pos >= text.size() || text[pos] != ';') {
+            error(where, "line %d: ';' expected after %s", statement.line, statement.keyword.c_str());
+            return false;
+        }
+        pos++;
+        result.push_back(statement);
+    }
+    return true;
+}
+
+//split at the first top level comma: the name is trimmed, the value kept as written
+static bool split_args(const std::string &args, std::string &name, std::string &value) {
+    int depth = 0;
+    for(size_t i=0; i<args.size(); i++) {
+        char c = args[i];
+        if(c == '(' || c == '{' || c == '[') depth++;
+        if(c == ')' || c == '}' || c == ']') depth--;
+        if(c == ',' && depth == 0) {
+            name  = trim(args.substr(0, i));
+            value = args.substr(i + 1);
+            return true;
+        }
+    }
+    name = trim(args);
+    value.clear();
+    return false;
+}
+
+//------------------------------------------------------------------------------ declarations
+
+/* Widths of the signals declared in a host file: input/output/wire/reg with an
+ * optional numeric [msb:lsb] range, ANSI port lists and 'wire a, b;' lists.
+ */
+static void parse_declarations(const std::string &raw, std::map<std::string, int> &widths, std::set<std::string> &inputs) {
+    std::string text;
+    for(size_t i=0; i<raw.size(); i++) {
+        if(raw.compare(i, 2, "//") == 0) {
+            while(i < raw.size() && raw[i] != '\n') i++;
+        }
+        else if(raw.compare(i, 2, "/*") == 0) {
+            size_t end = raw.find("*/", i + 2);
+            i = (end == std::string::npos)? raw.size() : end + 1;
+            text += ' ';
+            continue;
+        }
+        if(i < raw.size()) text += raw[i];
+    }
+
+    std::vector<std::string> tokens;
+    for(size_t i=0; i<text.size(); ) {
+        if(isspace((unsigned char)text[i])) { i++; continue; }
+        size_t end = i;
+        if(is_ident(text[i])) while(end < text.size() && is_ident(text[end])) end++;
+        else end++;
+        tokens.push_back(text.substr(i, end - i));
+        i = end;
+    }
+
+    static const std::set<std::string> kinds     = { "input", "output", "inout", "wire", "reg" };
+    static const std::set<std::string> modifiers = { "wire", "reg", "signed" };
+
+    for(size_t i=0; i<tokens.size(); i++) {
+        if(kinds.count(tokens[i]) == 0) continue;
+
+        size_t j = i + 1;
+        while(j < tokens.size() && modifiers.count(tokens[j])) j++;
+
+        int width = 1;
+        if(j < tokens.size() && tokens[j] == "[") {
+            //[ msb : lsb ]
+            if(j + 4 < tokens.size() && tokens[j+2] == ":" && tokens[j+4] == "]" && isdigit((unsigned char)tokens[j+1][0]) && isdigit((unsigned char)tokens[j+3][0])) {
+                width = abs(atoi(tokens[j+1].c_str()) - atoi(tokens[j+3].c_str())) + 1;
+                j += 5;
+            }
+            else {
+                width = 0;
+                while(j < tokens.size() && tokens[j] != "]") j++;
+                j++;
+            }
+        }
+
+        while(j < tokens.size() && is_ident(tokens[j][0]) && !isdigit((unsigned char)tokens[j][0]) && kinds.count(tokens[j]) == 0) {
+            if(widths.count(tokens[j]) == 0) widths[tokens[j]] = width;
+            if(tokens[i] == "input")         inputs.insert(tokens[j]);
+            j++;
+            //memories: name [a:b]
+            if(j < tokens.size() && tokens[j] == "[") {
+                while(j < tokens.size() && tokens[j] != "]") j++;
+                j++;
+            }
+            if(j + 1 < tokens.size() && tokens[j] == ",") j++;
+            else break;
+        }
+        i = j - 1;
+    }
+}
+
+//------------------------------------------------------------------------------ generated file
+
+/* The checked-in autogen files were written by the original generator, which
+ * kept the signals of a file in a Java HashMap. They are written here in the
+ * iteration order of that map (String.hashCode, the JDK 7 supplemental hash,
+ * power of two tables resized at 3/4 load), so that unchanged input gives the
+ * checked-in files back byte for byte.
+ */
+static uint32_t java_hash(const std::string &str) {
+    uint32_t hash = 0;
+    for(char c : str) hash = 31 * hash + (uint8_t)c;
+
+    hash ^= (hash >> 20) ^ (hash >> 12);
+    return hash ^ (hash >> 7) ^ (hash >> 4);
+}
+
+static std::vector<std::string> hash_order(const std::vector<std::string> &keys) {
+    //each bucket holds its newest entry first
+    std::vector<std::vector<std::string>> table(16);
+
+    size_t size = 0;
+    for(auto &key : keys) {
+        size_t index = java_hash(key) & (table.size() - 1);
+
+        if(size >= table.size() * 3 / 4 && table[index].empty() == false) {
+            //the transfer inserts at the head, reversing the entries that share a bucket
+            std::vector<std::vector<std::string>> bigger(table.size() * 2);
+            for(auto &bucket : table) {
+                for(auto &entry : bucket) {
+                    auto &target = bigger[java_hash(entry) & (bigger.size() - 1)];
+                    target.insert(target.begin(), entry);
+                }
+            }
+            table.swap(bigger);
+            index = java_hash(key) & (table.size() - 1);
+        }
+        table[index].insert(table[index].begin(), key);
+        size++;
+    }
+
+    std::vector<std::string> result;
+    for(auto &bucket : table) result.insert(result.end(), bucket.begin(), bucket.end());
+    return result;
+}
+
+/* One autogen file: numbered conditions and, per driven signal, an ordered list
+ * of (condition, value) pairs. A SAVE becomes a register with a next state mux,
+ * a SET a combinational mux defaulting to zero.
+ */
+struct entry_t {
+    std::string condition;
+    std::string value;
+};
+
+struct signal_t {
+    std::string          name;
+    std::vector<entry_t> entries;
+};
+
+struct signals_t {
+    std::vector<signal_t>         list;
+    std::map<std::string, size_t> index;
+
+    void add(const std::string &name, const std::string &condition, const std::string &value) {
+        auto it = index.find(name);
+        if(it == index.end()) {
+            index[name] = list.size();
+            list.push_back(signal_t{ name, {} });
+            it = index.find(name);
+        }
+        list[it->second].entries.push_back(entry_t{ condition, value });
+    }
+
+    std::vector<std::string> order() const {
+        std::vector<std::string> names;
+        for(auto &signal : list) names.push_back(signal.name);
+        return hash_order(names);
+    }
+};
+
+struct output_t {
+    std::string name;
+    std::string host;
+
+    std::string locals;
+
+    std::vector<std::string>   conditions;
+    std::map<std::string, int> condition_index;
+
+    signals_t             saves;
+    signals_t             sets;
+    std::set<std::string> no_always;
+
+    std::map<std::string, int> widths;
+    std::set<std::string>      inputs;
+
+    std::string condition(const std::string &text) {
+        auto it = condition_index.find(text);
+        if(it != condition_index.end()) return format_text("cond_%d", it->second);
+
+        int index = conditions.size();
+        condition_index[text] = index;
+        conditions.push_back(text);
+        return format_text("cond_%d", index);
+    }
+};
+
+static std::string width_range(int width) {
+    return (width <= 1)? "" : format_text("[%d:0]", width - 1);
+}
+
+static std::string emit(output_t &out) {
+    std::string text = out.locals;
+
+    text += "//======================================================== conditions\n";
+    for(size_t i=0; i<out.conditions.size(); i++) {
+        text += format_text("wire cond_%d = ", (int)i) + out.conditions[i] + ";\n";
+    }
+
+    auto width_of = [&](const std::string &name) {
+        auto it = out.widths.find(name);
+        if(it == out.widths.end() || it->second == 0) {
+            error(out.host, "no declaration with a numeric width for '%s'", name.c_str());
+            return 1;
+        }
+        return it->second;
+    };
+
+    std::vector<const signal_t *> saves, sets;
+    for(auto &name : out.saves.order()) saves.push_back(&out.saves.list[out.saves.index.at(name)]);
+    for(auto &name : out.sets.order())  sets.push_back(&out.sets.list[out.sets.index.at(name)]);
+
+    //a one bit register of the host without always block is written "assign  x_to_reg", an input "assign x_to_reg"
+    text += "//======================================================== saves\n";
+    for(auto save : saves) {
+        int width = width_of(save->name);
+        if(out.no_always.count(save->name)) text += "assign " + std::string((width <= 1 && out.inputs.count(save->name) == 0)? " " : "") + save->name + "_to_reg =\n";
+        else                                text += "wire " + width_range(width) + " " + save->name + "_to_reg =\n";
+
+        for(auto &entry : save->entries) text += "    (" + entry.condition + ")? (" + entry.value + ") :\n";
+        text += "    " + save->name + ";\n";
+    }
+
+    text += "//======================================================== always\n";
+    for(auto save : saves) {
+        if(out.no_always.count(save->name)) continue;
+        text += "always @(posedge clk) begin\n";
+        text += format_text("    if(rst_n == 1'b0) %s <= %d'd0;\n", save->name.c_str(), width_of(save->name));
+        text += "    else              " + save->name + " <= " + save->name + "_to_reg;\n";
+        text += "end\n";
+    }
+
+    text += "//======================================================== sets\n";
+    for(auto set : sets) {
+        text += "assign " + set->name + " =\n";
+        for(auto &entry : set->entries) text += "    (" + entry.condition + ")? (" + entry.value + ") :\n";
+        text += format_text("    %d'd0;\n", width_of(set->name));
+    }
+    return text;
+}
+
+//------------------------------------------------------------------------------ IF/ELSE/SET/SAVE scripts
+
+/* Nested IF(c); ELSE_IF(c); ELSE(); ENDIF(); blocks; each SET/SAVE is guarded by
+ * the conjunction of the enclosing conditions, the ELSE branches by the negated
+ * earlier conditions of their IF.
+ */
+struct if_frame_t {
+    std::vector<std::string> outer;
+    std::vector<std::string> previous;
+    std::string              current;
+};
+
+struct complex_t {
+    std::string cmd;
+    std::string condition;  //empty: always complex
+};
+
+static std::string join_terms(const std::vector<std::string> &terms) {
+    std::string result;
+    for(auto &term : terms) result += (result.empty()? "" : " && ") + term;
+    return result.empty()? "`TRUE" : result;
+}
+
+static bool run_script(output_t &out, const std::vector<statement_t> &statements, const std::vector<std::string> &base, const std::string &where,
+    std::vector<std::string> *raw_conditions = NULL, std::vector<std::string> *complex_conditions = NULL, std::vector<std::string> *cmdex_values = NULL)
+{
+    std::vector<if_frame_t>  frames;
+    std::vector<std::string> terms = base;
+    std::vector<std::string> raw;
+
+    for(auto &statement : statements) {
+        std::string where_line = format_text("%s:%d", where.c_str(), statement.line);
+
+        if(statement.keyword == "IF") {
+            if_frame_t frame;
+            frame.outer   = terms;
+            frame.current = out.condition(statement.args);
+            frames.push_back(frame);
+            terms.push_back(frame.current);
+            raw.push_back(trim(statement.args));
+        }
+        else if(statement.keyword == "ELSE_IF" || statement.keyword == "ELSE") {
+            if(frames.empty() || frames.back().current.empty()) {
+                error(where_line, "%s without IF", statement.keyword.c_str());
+                return false;
+            }
+            if_frame_t &frame = frames.back();
+            frame.previous.push_back(frame.current);
+            frame.current.clear();
+
+            terms = frame.outer;
+            std::string negated;
+            for(auto &previous : frame.previous) {
+                terms.push_back("~" + previous);
+                negated += (negated.empty()? "" : " && ") + std::string("~(") + out.conditions[atoi(previous.c_str() + 5)] + ")";
+            }
+            if(statement.keyword == "ELSE_IF") {
+                frame.current = out.condition(statement.args);
+                terms.push_back(frame.current);
+                negated += " && " + trim(statement.args);
+            }
+            raw.back() = negated;
+        }
+        else if(statement.keyword == "ENDIF") {
+            if(frames.empty()) {
+                error(where_line, "ENDIF without IF");
+                return false;
+            }
+            terms = frames.back().outer;
+            frames.pop_back();
+            raw.pop_back();
+        }
+        else if(statement.keyword == "SET" || statement.keyword == "SAVE") {
+            std::string name, value;
+            bool has_value = split_args(statement.args, name, value);
+
+            if(statement.keyword == "SAVE" && has_value == false) {
+                error(where_line, "SAVE needs a value");
+                return false;
+            }
+            if(has_value == false) value = "`TRUE";
+            value = join_lines(value);
+
+            if(statement.keyword == "SET") out.sets.add(name, join_terms(terms), value);
+            else                           out.saves.add(name, join_terms(terms), value);
+
+            if(complex_conditions != NULL && name == "dec_is_complex") {
+                std::string condition;
+                for(auto &text : raw) condition += (condition.empty()? "" : " && ") + text;
+                complex_conditions->push_back(condition);
+            }
+            if(cmdex_values != NULL && name == "dec_cmdex") {
+                for(auto &macro : find_macros(value, "`CMDEX_")) cmdex_values->push_back(macro);
+            }
+        }
+        else if(statement.keyword == "NO_ALWAYS_BLOCK") {
+            out.no_always.insert(trim(statement.args));
+        }
+        else {
+            error(where_line, "unknown statement %s", statement.keyword.c_str());
+            return false;
+        }
+    }
+    if(frames.empty() == false) {
+        error(where, "missing ENDIF");
+        return false;
+    }
+    if(raw_conditions != NULL) *raw_conditions = raw;
+    return true;
+}
+
+//------------------------------------------------------------------------------ command files
+
+struct section_t {
+    std::string tag;
+    std::string text;
+    int         line;
+};
+
+struct command_file_t {
+    std::string            name;
+    std::vector<section_t> sections;
+};
+
+static bool parse_command_file(const std::string &path, const std::string &name, command_file_t &file) {
+    std::string text;
+    if(read_file(path, text) == false) {
+        error(path, "can not read");
+        return false;
+    }
+    file.name = name;
+
+    size_t pos  = 0;
+    int    line = 1;
+    while(true) {
+        size_t open = text.find('<', pos);
+        if(open == std::string::npos) break;
+        line += std::count(text.begin() + pos, text.begin() + open, '\n');
+
+        size_t close = text.find('>', open);
+        std::string tag = (close == std::string::npos)? "" : text.substr(open + 1, close - open - 1);
+        if(tag.empty() || tag.find_first_not_of("abcdefghijklmnopqrstuvwxyz_") != std::string::npos) {
+            error(path, "line %d: section tag expected", line);
+            return false;
+        }
+
+        std::string end_tag = "</" + tag + ">";
+        size_t end = text.find(end_tag, close);
+        if(end == std::string::npos) {
+            error(path, "line %d: missing %s", line, end_tag.c_str());
+            return false;
+        }
+
+        section_t section;
+        section.tag  = tag;
+        section.text = text.substr(close + 1, end - close - 1);
+        section.line = line;
+        file.sections.push_back(section);
+
+        line += std::count(text.begin() + open, text.begin() + end, '\n');
+        pos = end + end_tag.size();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------ defines
+
+struct defines_t {
+    std::string text;
+
+    std::map<std::string, int>         cmd_value;
+    std::map<std::string, std::string> cmdex_owner;   //CMDEX name -> CMD name
+    std::map<std::string, int>         cmdex_value;
+    std::map<std::string, std::string> group;         //CMD/CMDEX name -> command file
+    std::vector<std::string>           cmds;
+};
+
+/* `define CMD_x #AUTOGEN_NEXT_CMD            lowest free number, or the next
+ *                                            number of the file's _MODn group
+ * `define CMD_x #AUTOGEN_NEXT_CMD_MODn       first free group of n numbers
+ *                                            aligned to n, for commands decoded
+ *                                            by their low bits; the group is
+ *                                            kept for the CMDs after it in the
+ *                                            file, the numbers skipped to align
+ *                                            go to the next files
+ * `define CMD_x #AUTOGEN_NEXT_CMD_LIKE_PREV  same number as the previous CMD
+ * A CMDEX belongs to the CMD of its file with the longest matching name
+ * (CMDEX_CALL_2_x to CMD_CALL_2), else to the first CMD of the file.
+ */
+static void generate_defines(const std::vector<command_file_t> &files, defines_t &defines) {
+    std::vector<bool> used(128, false);
+    int last = -1;
+
+    std::vector<std::string>           names;
+    std::map<std::string, std::string> lines;
+
+    auto lowest_free = [&]() {
+        int number = 1;
+        while(number < 128 && used[number]) number++;
+        return number;
+    };
+    auto group_free = [&](int number, int count) {
+        for(int i=number; i<number + count; i++) if(i >= 128 || used[i]) return false;
+        return true;
+    };
+
+    for(auto &file : files) {
+        std::vector<std::string> owners;
+        int group_next = 0;
+        int group_end  = 0;
+
+        for(auto &section : file.sections) {
+            if(section.tag != "defines") continue;
+
+            int line = section.line;
+            size_t pos = 0;
+            while(pos <= section.text.size()) {
+                size_t end = section.text.find('\n', pos);
+                if(end == std::string::npos) end = section.text.size();
+                std::string row = trim(section.text.substr(pos, end - pos));
+                pos = end + 1;
+                line++;
+
+                if(row.empty() || starts_with(row, "//")) continue;
+
+                std::vector<std::string> words;
+                for(size_t i=0; i<row.size(); ) {
+                    if(starts_with(row.substr(i), "//")) break;
+                    if(isspace((unsigned char)row[i])) { i++; continue; }
+                    size_t word_end = i;
+                    while(word_end < row.size() && !isspace((unsigned char)row[word_end])) word_end++;
+                    words.push_back(row.substr(i, word_end - i));
+                    i = word_end;
+                }
+                if(words.size() < 2 || words[0] != "`define") {
+                    error(file.name, "line %d: `define expected", line - 1);
+                    continue;
+                }
+
+                std::string name = words[1];
+                std::string value;
+                for(size_t i=2; i<words.size(); i++) value += (i > 2? " " : "") + words[i];
+
+                if(starts_with(value, "#AUTOGEN_NEXT_CMD")) {
+                    int number;
+                    if(value == "#AUTOGEN_NEXT_CMD") {
+                        number = (group_next < group_end)? group_next++ : lowest_free();
+                    }
+                    else if(value == "#AUTOGEN_NEXT_CMD_LIKE_PREV" && last >= 0) {
+                        number = last;
+                    }
+                    else if(starts_with(value, "#AUTOGEN_NEXT_CMD_MOD")) {
+                        int modulo = atoi(value.c_str() + strlen("#AUTOGEN_NEXT_CMD_MOD"));
+                        if(modulo <= 0) { error(file.name, "line %d: bad %s", line - 1, value.c_str()); continue; }
+
+                        number = (lowest_free() + modulo - 1) / modulo * modulo;
+                        while(number < 128 && group_free(number, modulo) == false) number += modulo;
+                        for(int i=number; i<number + modulo && i < 128; i++) used[i] = true;
+                        group_next = number + 1;
+                        group_end  = number + modulo;
+                    }
+                    else {
+                        error(file.name, "line %d: bad %s", line - 1, value.c_str());
+                        continue;
+                    }
+                    if(number > 127) error(file.name, "line %d: more than 7 bits of commands", line - 1);
+                    else             used[number] = true;
+
+                    last  = number;
+                    value = format_text("7'd%d", number);
+
+                    if(starts_with(name, "CMD_")) {
+                        owners.push_back(name);
+                        defines.cmd_value[name] = number;
+                        defines.cmds.push_back(name);
+                        defines.group[name] = file.name;
+                    }
+                }
+                else if(starts_with(name, "CMDEX_")) {
+                    if(owners.empty()) error(file.name, "line %d: %s before any CMD", line - 1, name.c_str());
+
+                    std::string owner = owners.empty()? "" : owners[0];
+                    size_t      match = 0;
+                    for(auto &cmd : owners) {
+                        std::string prefix = "CMDEX_" + cmd.substr(4) + "_";
+                        if(starts_with(name, prefix.c_str()) && prefix.size() > match) {
+                            owner = cmd;
+                            match = prefix.size();
+                        }
+                    }
+                    defines.cmdex_owner[name] = owner;
+                    defines.group[name]       = file.name;
+
+                    size_t tick = value.find("'d");
+                    defines.cmdex_value[name] = (tick == std::string::npos)? -1 : atoi(value.c_str() + tick + 2);
+                }
+                if(lines.count(name) == 0) names.push_back(name);
+                else                       error(file.name, "line %d: %s defined again", line - 1, name.c_str());
+                lines[name] = "`define " + name + " " + value + "\n";
+            }
+        }
+    }
+
+    for(auto &name : hash_order(names)) defines.text += lines[name];
+}
+
+//------------------------------------------------------------------------------ decode
+
+struct decode_rule_t {
+    std::string              cmd;
+    std::vector<std::string> complex_conditions;
+    std::vector<std::string> cmdex_values;
+};
+
+/* <decode>: the match condition, optionally a line with the lock/#UD condition
+ * (always including prefix_group_1_lock), the command value, then the body.
+ */
+static void generate_decode(const std::vector<command_file_t> &files, output_t &out, std::vector<decode_rule_t> &rules) {
+    for(auto &file : files) {
+        for(auto &section : file.sections) {
+            if(section.tag != "decode") continue;
+
+            std::string where = format_text("%s:%d", file.name.c_str(), section.line);
+
+            //header lines
+            std::vector<std::string> header;
+            size_t pos = 0;
+            int    body_line = section.line;
+            while(header.size() < 3 && pos < section.text.size()) {
+                size_t end = section.text.find('\n', pos);
+                if(end == std::string::npos) end = section.text.size();
+                std::string row = trim(section.text.substr(pos, end - pos));
+                pos = end + 1;
+                body_line++;
+
+                if(row.empty()) continue;
+                header.push_back(row);
+                if(header.size() == 2 && starts_with(row, "prefix_group_1_lock") == false) break;
+            }
+            if(header.size() < 2) {
+                error(where, "decode header expected");
+                continue;
+            }
+
+            std::string lock = "prefix_group_1_lock ";
+            if(header.size() == 3) lock += header[1].substr(strlen("prefix_group_1_lock"));
+            std::string cmd_value = header.back();
+
+            std::string match = out.condition(header[0]);
+            std::string lock_condition = out.condition(lock);
+
+            out.sets.add("exception_ud", match + " && " + lock_condition, "`TRUE");
+
+            std::vector<statement_t> statements;
+            if(parse_statements(pos < section.text.size()? section.text.substr(pos) : "", file.name, body_line, true, statements) == false) continue;
+
+            decode_rule_t rule;
+            std::vector<std::string> cmds = find_macros(cmd_value, "`CMD_");
+            rule.cmd = cmds.empty()? cmd_value : cmds[0];
+
+            run_script(out, statements, { match, "~" + lock_condition }, where, NULL, &rule.complex_conditions, &rule.cmdex_values);
+            rules.push_back(rule);
+
+            //after the body, as the original generator did: this sets the place of dec_cmd in the file
+            out.sets.add("dec_cmd", match + " && ~" + lock_condition, " " + cmd_value);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------ microcode
+
+/* <microcode> describes the cmdex sequence of complex instructions. A state is
+ * a `CMDEX line or an IF(): IF(`CMDEX_x && c) stands for
+ * "mc_cmd == `CMD_owner && mc_cmdex_last == `CMDEX_x && c", any other IF is
+ * used as written. From the current state:
+ *
+ *   `CMDEX_y            go to y (y is the new state)
+ *   LOOP(`CMDEX_y)      go to y, then repeat y until the instruction ends
+ *   JMP(`CMDEX_y)       go to y, in another command's sequence
+ *   LAST(`CMDEX_y)      y is the last micro-operation
+ *   DIRECT(cmd, cmdex)  go to an explicit command and cmdex expression
+ *   LAST_DIRECT(c, e)   as DIRECT, as last micro-operation
+ *   CALL(`CMDEX_y)      go to subroutine y; the next statement gives the
+ *                       return state, saved in mc_saved_command/cmdex
+ *   RETURN()            go to the saved state
+ *
+ * Nested IFs do not combine, each IF names a state of its own.
+ */
+
+struct mc_edge_t {
+    std::vector<std::string> from;          //source cmdex
+    std::string              from_group;    //any state of this command file
+
+    enum kind_t { STEP, LAST, CALL, RETURN } kind;
+
+    std::vector<std::string> to;
+    bool                     to_next;       //mc_cmdex_last + 1
+    bool                     to_variable;   //computed cmdex (mc_step ...)
+
+    std::vector<std::string> ret;           //CALL: return states
+    bool                     ret_variable;
+};
+
+struct mc_analysis_t {
+    std::vector<mc_edge_t> edges;
+    std::set<std::string>  loops;
+};
+
+struct mc_state_t {
+    bool        valid;
+    std::string condition;
+
+    std::vector<std::string> from;
+    std::string              from_group;
+};
+
+struct mc_context_t {
+    output_t        &out;
+    const defines_t &defines;
+    mc_analysis_t   &analysis;
+
+    std::vector<std::string> loop_conditions;
+    std::set<std::string>    loop_seen;
+
+    std::string where;
+    std::string group;
+};
+
+static bool mc_owner(mc_context_t &ctx, const std::string &cmdex_macro, std::string &cmd) {
+    std::string name = cmdex_macro.substr(1);
+    auto it = ctx.defines.cmdex_owner.find(name);
+    if(it == ctx.defines.cmdex_owner.end()) {
+        error(ctx.where, "undefined %s", cmdex_macro.c_str());
+        return false;
+    }
+    cmd = "`" + it->second;
+    return true;
+}
+
+//the states a raw condition selects: mc_cmdex_last comparisons, else the mentioned commands
+static void mc_sources(mc_context_t &ctx, const std::string &condition, mc_state_t &state) {
+    std::vector<std::string> equal;
+    int low = -1, high = 1 << 30;
+    std::string range_owner;
+
+    for(size_t pos = condition.find("mc_cmdex_last"); pos != std::string::npos; pos = condition.find("mc_cmdex_last", pos + 1)) {
+        size_t i = pos + strlen("mc_cmdex_last");
+        while(i < condition.size() && condition[i] == ' ') i++;
+        std::string op;
+        while(i < condition.size() && strchr("=<>!", condition[i])) op += condition[i++];
+        while(i < condition.size() && condition[i] == ' ') i++;
+        if(condition.compare(i, 7, "`CMDEX_") != 0) continue;
+
+        size_t end = i + 1;
+        while(end < condition.size() && is_ident(condition[end])) end++;
+        std::string name = condition.substr(i + 1, end - i - 1);
+
+        auto value = ctx.defines.cmdex_value.find(name);
+        if(value == ctx.defines.cmdex_value.end()) continue;
+
+        if(op == "==")      equal.push_back(name);
+        else if(op == ">=") low  = std::max(low,  value->second);
+        else if(op == ">")  low  = std::max(low,  value->second + 1);
+        else if(op == "<=") high = std::min(high, value->second);
+        else if(op == "<")  high = std::min(high, value->second - 1);
+        else continue;
+
+        if(op != "==") range_owner = ctx.defines.cmdex_owner.at(name);
+    }
+
+    if(equal.empty() == false) {
+        state.from = equal;
+    }
+    else if(range_owner.empty() == false) {
+        for(auto &cmdex : ctx.defines.cmdex_owner) {
+            int value = ctx.defines.cmdex_value.at(cmdex.first);
+            if(cmdex.second == range_owner && value >= std::max(low, 0) && value <= high) state.from.push_back(cmdex.first);
+        }
+    }
+    else {
+        std::vector<std::string> cmds = find_macros(condition, "`CMD_");
+        state.from_group = cmds.empty()? ctx.group : ctx.defines.group.at(cmds[0]);
+    }
+}
+
+static mc_state_t mc_state_of(mc_context_t &ctx, const std::string &cmdex_macro, const std::string &rest) {
+    mc_state_t state;
+    state.valid = false;
+
+    std::string cmd;
+    if(mc_owner(ctx, cmdex_macro, cmd) == false) return state;
+
+    state.valid     = true;
+    state.condition = "mc_cmd == " + cmd + " && mc_cmdex_last == " + cmdex_macro + rest;
+    state.from.push_back(cmdex_macro.substr(1));
+    return state;
+}
+
+static void mc_targets(mc_context_t &ctx, const std::string &value, std::vector<std::string> &to, bool &next, bool &variable) {
+    for(auto &macro : find_macros(value, "`CMDEX_")) {
+        if(ctx.defines.cmdex_owner.count(macro)) to.push_back(macro);
+    }
+    if(value.find("mc_cmdex_last") != std::string::npos) next = true;
+    else if(to.empty()) variable = true;
+}
+
+static void mc_transition(mc_context_t &ctx, const mc_state_t &state, const char *cmd_next, const std::string &cmdex, const std::string &cmd_current) {
+    std::string condition = ctx.out.condition(state.condition);
+
+    if(cmd_next != NULL) ctx.out.sets.add("mc_cmd_next", condition, cmd_next);
+    ctx.out.sets.add("mc_cmdex_current", condition, cmdex);
+    ctx.out.sets.add("mc_cmd_current",   condition, cmd_current);
+}
+
+static bool run_microcode(mc_context_t &ctx, const std::vector<statement_t> &statements) {
+    mc_state_t state;
+    state.valid = false;
+
+    bool        call_pending = false;
+    std::string call_condition;
+    size_t      call_edge = 0;
+
+    auto new_edge = [&](mc_edge_t::kind_t kind) -> mc_edge_t & {
+        mc_edge_t edge;
+        edge.from         = state.from;
+        edge.from_group   = state.from_group;
+        edge.kind         = kind;
+        edge.to_next      = false;
+        edge.to_variable  = false;
+        edge.ret_variable = false;
+        ctx.analysis.edges.push_back(edge);
+        return ctx.analysis.edges.back();
+    };
+
+    //the statement after a CALL is the return state
+    auto take_return = [&](const std::string &cmd, const std::string &cmdex) {
+        ctx.out.saves.add("mc_saved_command", call_condition, " " + cmd);
+        ctx.out.saves.add("mc_saved_cmdex",   call_condition, "   " + cmdex);
+        call_pending = false;
+
+        mc_edge_t &edge = ctx.analysis.edges[call_edge];
+        mc_targets(ctx, cmdex, edge.ret, edge.to_next, edge.ret_variable);
+    };
+
+    for(auto &statement : statements) {
+        ctx.where = format_text("%s:%d", ctx.group.c_str(), statement.line);
+        const std::string &keyword = statement.keyword;
+
+        std::string target, value;
+        bool has_value = split_args(statement.args, target, value);
+
+        if(keyword == "IF") {
+            if(call_pending) error(ctx.where, "IF after CALL, return state expected");
+
+            std::string args = trim(statement.args);
+            if(starts_with(args, "`CMDEX_")) {
+                size_t end = 1;
+                while(end < args.size() && is_ident(args[end])) end++;
+                state = mc_state_of(ctx, args.substr(0, end), args.substr(end));
+            }
+            else {
+                state = mc_state_t();
+                state.valid     = true;
+                state.condition = args;
+                mc_sources(ctx, args, state);
+            }
+            if(state.valid == false) return false;
+        }
+        else if(keyword == "ENDIF") {
+            //the state is kept: a `CMDEX after ENDIF follows the last state of the block
+            if(call_pending) error(ctx.where, "ENDIF after CALL, return state expected");
+        }
+        else if(keyword == "`" || keyword == "LOOP" || keyword == "JMP" || keyword == "LAST" || keyword == "CALL") {
+            std::string cmdex = (keyword == "`")? statement.args : target;
+            std::string cmd;
+            if(mc_owner(ctx, cmdex, cmd) == false) return false;
+
+            if(call_pending) {
+                if(keyword != "`" && keyword != "LOOP") error(ctx.where, "%s after CALL", keyword.c_str());
+                take_return(cmd, cmdex);
+            }
+            else if(state.valid) {
+                const char *cmd_next = (keyword == "LAST")? NULL : cmd.c_str();
+                std::string next_text = format_text("      %s", cmd.c_str());
+                mc_transition(ctx, state, (cmd_next == NULL)? NULL : next_text.c_str(), " " + cmdex, "   " + cmd);
+
+                mc_edge_t &edge = new_edge((keyword == "LAST")? mc_edge_t::LAST : (keyword == "CALL")? mc_edge_t::CALL : mc_edge_t::STEP);
+                edge.to.push_back(cmdex.substr(1));
+
+                if(keyword == "CALL") {
+                    call_pending   = true;
+                    call_condition = ctx.out.condition(state.condition);
+                    call_edge      = ctx.analysis.edges.size() - 1;
+                }
+            }
+            else if(keyword != "`" && keyword != "LOOP") {
+                error(ctx.where, "%s without a state", keyword.c_str());
+                return false;
+            }
+
+            if(keyword == "LOOP" && ctx.loop_seen.insert(cmdex).second) {
+                ctx.loop_conditions.push_back("(mc_cmd == " + cmd + " && mc_cmdex_last == " + cmdex + ")");
+                ctx.analysis.loops.insert(cmdex.substr(1));
+            }
+
+            if(keyword == "`") state = mc_state_of(ctx, cmdex, "");
+            else               state.valid = false;
+        }
+        else if(keyword == "DIRECT" || keyword == "LAST_DIRECT") {
+            if(has_value == false) {
+                error(ctx.where, "%s needs a command and a cmdex", keyword.c_str());
+                return false;
+            }
+            if(call_pending) {
+                if(keyword != "DIRECT") error(ctx.where, "%s after CALL", keyword.c_str());
+                take_return(target, value);
+            }
+            else if(state.valid) {
+                std::string next_text = "      " + target;
+                mc_transition(ctx, state, (keyword == "DIRECT")? next_text.c_str() : NULL, " " + value, "   " + target);
+
+                mc_edge_t &edge = new_edge((keyword == "DIRECT")? mc_edge_t::STEP : mc_edge_t::LAST);
+                mc_targets(ctx, value, edge.to, edge.to_next, edge.to_variable);
+            }
+            else {
+                error(ctx.where, "%s without a state", keyword.c_str());
+                return false;
+            }
+            state.valid = false;
+        }
+        else if(keyword == "RETURN") {
+            if(state.valid == false) {
+                error(ctx.where, "RETURN without a state");
+                return false;
+            }
+            mc_transition(ctx, state, "      mc_saved_command", " mc_saved_cmdex", "   mc_saved_command");
+            new_edge(mc_edge_t::RETURN);
+            state.valid = false;
+        }
+        else {
+            error(ctx.where, "unknown statement %s", keyword.c_str());
+            return false;
+        }
+    }
+    if(call_pending) error(ctx.where, "CALL without return state");
+    return true;
+}
+
+static void generate_microcode(const std::vector<command_file_t> &files, const defines_t &defines, output_t &out, mc_analysis_t &analysis) {
+    mc_context_t ctx = { out, defines, analysis, {}, {}, "", "" };
+
+    for(auto &file : files) {
+        for(auto &section : file.sections) {
+            if(section.tag != "microcode") continue;
+
+            ctx.group = file.name;
+            std::vector<statement_t> statements;
+            if(parse_statements(section.text, file.name, section.line, true, statements) == false) continue;
+            run_microcode(ctx, statements);
+        }
+    }
+
+    //states repeated until the instruction ends
+    if(ctx.loop_conditions.empty() == false) {
+        std::string text = "\n";
+        for(size_t i=0; i<ctx.loop_conditions.size(); i++) text += ctx.loop_conditions[i] + ((i + 1 < ctx.loop_conditions.size())? " ||\n" : "\n");
+
+        std::string condition = out.condition(text);
+        out.sets.add("mc_cmd_next",      condition, "      mc_cmd");
+        out.sets.add("mc_cmdex_current", condition, " mc_cmdex_last");
+        out.sets.add("mc_cmd_current",   condition, "   mc_cmd");
+    }
+}
+
+//------------------------------------------------------------------------------ report
+
+/* Static microcode length: micro-operations on the longest path from a state,
+ * the state itself included. A CALL adds the subroutine up to its RETURN; the
+ * LOOP states, cycles and computed cmdex values are flagged, not followed.
+ */
+struct mc_walk_t {
+    const defines_t     &defines;
+    const mc_analysis_t &analysis;
+
+    std::map<std::string, std::vector<size_t>> edges_from;
+    std::map<std::string, std::vector<size_t>> edges_group;
+
+    std::set<std::string> on_path;
+    std::set<size_t>      reached;
+
+    bool loops;
+    bool variable;
+    bool calls;
+};
+
+static std::string mc_next_state(const defines_t &defines, const std::string &cmdex) {
+    auto owner = defines.cmdex_owner.find(cmdex);
+    if(owner == defines.cmdex_owner.end()) return "";
+    int value = defines.cmdex_value.at(cmdex) + 1;
+    for(auto &other : defines.cmdex_owner) {
+        if(other.second == owner->second && defines.cmdex_value.at(other.first) == value) return other.first;
+    }
+    return "";
+}
+
+static int mc_longest(mc_walk_t &walk, const std::string &state) {
+    if(walk.on_path.count(state)) {
+        walk.loops = true;
+        return 0;
+    }
+    if(walk.analysis.loops.count(state)) walk.loops = true;
+
+    walk.on_path.insert(state);
+
+    std::vector<size_t> edges;
+    if(walk.edges_from.count(state)) edges = walk.edges_from.at(state);
+    auto group = walk.defines.group.find(state);
+    if(group != walk.defines.group.end() && walk.edges_group.count(group->second)) {
+        for(size_t edge : walk.edges_group.at(group->second)) edges.push_back(edge);
+    }
+
+    int best = 0;
+    for(size_t index : edges) {
+        const mc_edge_t &edge = walk.analysis.edges[index];
+        walk.reached.insert(index);
+
+        std::vector<std::string> to = edge.to;
+        if(edge.to_next) {
+            std::string next = mc_next_state(walk.defines, state);
+            if(next.empty() == false) to.push_back(next);
+        }
+        if(edge.to_variable) walk.variable = true;
+
+        int length = 0;
+        if(edge.kind == mc_edge_t::LAST) {
+            length = 1;
+        }
+        else if(edge.kind == mc_edge_t::STEP) {
+            for(auto &target : to) length = std::max(length, mc_longest(walk, target));
+            if(to.empty()) length = 1;
+        }
+        else if(edge.kind == mc_edge_t::CALL) {
+            walk.calls = true;
+            int sub = 0;
+            for(auto &target : to) sub = std::max(sub, mc_longest(walk, target));
+
+            std::vector<std::string> ret = edge.ret;
+            if(edge.ret_variable) walk.variable = true;
+            if(edge.to_next) {
+                //CALL followed by DIRECT(..., mc_cmdex_last + 1)
+                std::string next = mc_next_state(walk.defines, state);
+                if(next.empty() == false) ret.push_back(next);
+            }
+            int after = 0;
+            for(auto &target : ret) after = std::max(after, mc_longest(walk, target));
+            length = sub + after;
+        }
+        best = std::max(best, length);
+    }
+
+    walk.on_path.erase(state);
+    return 1 + best;
+}
+
+struct report_row_t {
+    std::string cmd;
+    std::string group;
+    int         rules;
+    std::string complex;
+    int         operations;
+    int         transitions;
+    std::string flags;
+};
+
+static std::string generate_report(const std::vector<decode_rule_t> &rules, const defines_t &defines, const mc_analysis_t &analysis) {
+    mc_walk_t walk = { defines, analysis, {}, {}, {}, {}, false, false, false };
+
+    for(size_t i=0; i<analysis.edges.size(); i++) {
+        const mc_edge_t &edge = analysis.edges[i];
+        for(auto &from : edge.from) walk.edges_from[from].push_back(i);
+        if(edge.from_group.empty() == false) walk.edges_group[edge.from_group].push_back(i);
+    }
+
+    //decode rules per command, in command number order
+    std::map<std::string, std::vector<const decode_rule_t *>> by_cmd;
+    for(auto &rule : rules) by_cmd[rule.cmd].push_back(&rule);
+
+    std::vector<report_row_t> rows;
+    std::string conditional;
+
+    for(auto &cmd : defines.cmds) {
+        if(by_cmd.count(cmd) == 0) continue;
+        auto &cmd_rules = by_cmd[cmd];
+
+        report_row_t row;
+        row.cmd   = cmd;
+        row.group = defines.group.at(cmd);
+        row.rules = cmd_rules.size();
+
+        int complex_rules = 0;
+        bool complex_conditional = false;
+        std::set<std::string> entries;
+
+        for(auto rule : cmd_rules) {
+            bool always = false;
+            for(auto &condition : rule->complex_conditions) {
+                if(condition.empty()) always = true;
+                else conditional += format_text("%-20s %s\n", cmd.c_str(), condition.c_str());
+            }
+            if(rule->complex_conditions.empty() == false) complex_rules++;
+            if(rule->complex_conditions.empty() == false && always == false) complex_conditional = true;
+
+            for(auto &cmdex : rule->cmdex_values) entries.insert(cmdex);
+        }
+        row.complex = (complex_rules == 0)? "no" : complex_conditional? "cond" : (complex_rules == row.rules)? "yes" : "some";
+
+        //no dec_cmdex: cmdex 0 of the command
+        if(entries.empty()) {
+            for(auto &cmdex : defines.cmdex_owner) {
+                if(cmdex.second == cmd && defines.cmdex_value.at(cmdex.first) == 0) entries.insert(cmdex.first);
+            }
+        }
+
+        walk.reached.clear();
+        walk.loops = walk.variable = walk.calls = false;
+
+        row.operations = 1;
+        for(auto &entry : entries) row.operations = std::max(row.operations, mc_longest(walk, entry));
+        row.transitions = walk.reached.size();
+
+        row.flags = std::string(walk.loops? "L" : "") + (walk.variable? "V" : "") + (walk.calls? "C" : "");
+        rows.push_back(row);
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const report_row_t &a, const report_row_t &b) {
+        if(a.operations != b.operations) return a.operations > b.operations;
+        return a.cmd < b.cmd;
+    });
+
+    std::string text;
+    text += "Static microcode cost per decoded command, longest first.\n";
+    text += "\n";
+    text += "  rules  decode rules of the command\n";
+    text += "  complex dec_is_complex: no, yes, some (of the rules), cond (under a condition, below)\n";
+    text += "  uops   micro-operations on the longest path from the decoded cmdex, CALLed subroutines included\n";
+    text += "  steps  microcode transitions reachable from the decoded cmdex\n";
+    text += "  flags  L: repeats (LOOP states, cycles), V: computed cmdex (mc_step, expressions), C: calls a subroutine\n";
+    text += "\n";
+    text += format_text("%-20s %-34s %5s %-7s %5s %5s  %s\n", "command", "file", "rules", "complex", "uops", "steps", "flags");
+
+    for(auto &row : rows) {
+        text += format_text("%-20s %-34s %5d %-7s %5d %5d  %s\n", row.cmd.c_str(), row.group.c_str(), row.rules, row.complex.c_str(), row.operations, row.transitions, row.flags.c_str());
+    }
+
+    text += "\nConditional dec_is_complex:\n";
+    text += conditional;
+    return text;
+}
+
+//------------------------------------------------------------------------------ host files
+
+static bool load_host(output_t &out, std::vector<std::string> &scripts, std::vector<int> &lines) {
+    std::string text;
+    if(read_file(out.host, text) == false) {
+        error(out.host, "can not read");
+        return false;
+    }
+    parse_declarations(text, out.widths, out.inputs);
+
+    //comment blocks starting with a "/****...SCRIPT" line
+    size_t pos = 0;
+    while(true) {
+        size_t start = text.find("SCRIPT\n", pos);
+        if(start == std::string::npos) break;
+
+        size_t line_start = text.rfind('\n', start);
+        line_start = (line_start == std::string::npos)? 0 : line_start + 1;
+        pos = start + 7;
+        if(text.compare(line_start, 2, "/*") != 0) continue;
+
+        size_t end = text.find("\n*/", pos);
+        if(end == std::string::npos) {
+            error(out.host, "unterminated SCRIPT block");
+            return false;
+        }
+        scripts.push_back(text.substr(pos, end - pos + 1));
+        lines.push_back(std::count(text.begin(), text.begin() + pos, '\n') + 1);
+        pos = end + 3;
+    }
+    return true;
+}
+
+//<tag_local> sections: one line per declaration, indented lines continue the previous one, comments dropped
+static std::string local_text(const std::string &text) {
+    std::vector<std::string> rows;
+    size_t pos = 0;
+    while(pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if(end == std::string::npos) end = text.size();
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t comment = line.find("//");
+        if(comment != std::string::npos) line.erase(comment);
+
+        size_t start = line.find_first_not_of(" \t");
+        if(start == std::string::npos) continue;
+
+        if(start > 0 && rows.empty() == false) rows.back() += " " + line.substr(start);
+        else                                   rows.push_back(line.substr(start));
+    }
+
+    std::string result;
+    for(auto &row : rows) result += row.substr(0, row.find_last_not_of(" \t") + 1) + "\n";
+    return result;
+}
+
+//commands <tag> sections, then the SCRIPT blocks of the host
+static void generate_scripts(const std::vector<command_file_t> &files, const char *tag, output_t &out) {
+    std::string local_tag = std::string(tag) + "_local";
+
+    for(auto &file : files) {
+        for(auto &section : file.sections) {
+            if(section.tag == local_tag) {
+                std::string text = local_text(section.text);
+                if(text.empty() == false) out.locals += text + "\n";
+            }
+            if(section.tag != tag) continue;
+
+            std::vector<statement_t> statements;
+            if(parse_statements(section.text, file.name, section.line, true, statements) == false) continue;
+            run_script(out, statements, {}, format_text("%s:%d", file.name.c_str(), section.line));
+        }
+    }
+
+    std::vector<std::string> scripts;
+    std::vector<int>         lines;
+    if(load_host(out, scripts, lines) == false) return;
+
+    for(size_t i=0; i<scripts.size(); i++) {
+        std::vector<statement_t> statements;
+        if(parse_statements(scripts[i], out.host, lines[i], false, statements) == false) continue;
+        run_script(out, statements, {}, format_text("%s:%d", out.host.c_str(), lines[i]));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/* Command files in the order the original generator read them (its directory
+ * listing). The order sets the command numbers and the priority of entries
+ * whose conditions overlap across files; files not listed follow in name order.
+ */
+static const char *command_order[] = {
+    "CMD_XADD", "CMD_JCXZ", "CMD_CALL", "CMD_PUSH_MOV_SEG", "CMD_NEG", "CMD_Jcc", "CMD_INVD", "CMD_INVLPG",
+    "CMD_io_allow", "CMD_HLT", "CMD_SCAS", "CMD_INC_DEC", "CMD_RET_near", "CMD_ARPL", "CMD_BSWAP", "CMD_LxS",
+    "CMD_MOV_to_seg_LLDT_LTR", "CMD_CLC_CMC_CLD_STC_STD_SAHF", "CMD_int", "CMD_AAD_AAM", "CMD_load_seg",
+    "CMD_POP_seg", "CMD_BTx", "CMD_IRET", "CMD_POP", "CMD_DIV_IDIV", "CMD_Shift", "CMD_CMPS",
+    "CMD_control_reg", "CMD_LGDT_LIDT", "CMD_PUSHA", "CMD_fpu", "CMD_SETcc", "CMD_CMPXCHG", "CMD_ENTER",
+    "CMD_IMUL", "CMD_LEAVE", "CMD_SHxD", "CMD_WBINVD", "CMD_Arith", "CMD_MUL", "CMD_LOOP", "CMD_TEST",
+    "CMD_CLTS", "CMD_RET_far", "CMD_LODS", "CMD_XCHG", "CMD_PUSH", "CMD_INT_INTO", "CMD_CPUID", "CMD_IN",
+    "CMD_NOT", "CMD_LAR_LSL_VERR_VERW", "common_CALL_JMP_int_RET", "CMD_STOS", "CMD_INS", "CMD_OUTS",
+    "CMD_PUSHF", "CMD_JMP", "CMD_OUT", "CMD_MOV", "CMD_LAHF_CBW_CWD", "CMD_POPF", "CMD_CLI_STI", "CMD_BOUND",
+    "CMD_SALC", "CMD_task_switch", "CMD_LEA", "CMD_SGDT_SIDT", "CMD_MOVS", "CMD_MOVSX_MOVZX", "CMD_POPA",
+    "CMD_debug_reg", "CMD_XLAT", "CMD_AAA_AAS_DAA_DAS", "CMD_BSF_BSR",
+};
+
+int main(int argc, char **argv) {
+    std::string ao486_dir   = "../../rtl/ao486";
+    std::string output_dir;
+    std::string report_name = "autogen_report.txt";
+
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)      output_dir  = argv[++i];
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc) report_name = argv[++i];
+        else if(argv[i][0] != '-')                          ao486_dir   = argv[i];
+        else {
+            printf("usage: %s [-o output_dir] [-r report_file] [ao486_dir]\n", argv[0]);
+            printf("  ao486_dir    default ../../rtl/ao486\n");
+            printf("  output_dir   default <ao486_dir>/autogen\n");
+            printf("  report_file  default autogen_report.txt\n");
+            return 1;
+        }
+    }
+    if(output_dir.empty()) output_dir = ao486_dir + "/autogen";
+
+    //command files
+    std::string commands_dir = ao486_dir + "/commands";
+    DIR *dir = opendir(commands_dir.c_str());
+    if(dir == NULL) {
+        printf("Error: can not open %s\n", commands_dir.c_str());
+        return 1;
+    }
+    std::vector<std::string> names;
+    for(struct dirent *entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if(name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0) names.push_back(name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    auto rank = [](const std::string &name) {
+        size_t count = sizeof(command_order) / sizeof(command_order[0]);
+        for(size_t i=0; i<count; i++) if(name == std::string(command_order[i]) + ".txt") return i;
+        return count;
+    };
+    std::stable_sort(names.begin(), names.end(), [&](const std::string &a, const std::string &b) { return rank(a) < rank(b); });
+
+    std::vector<command_file_t> files(names.size());
+    for(size_t i=0; i<names.size(); i++) parse_command_file(commands_dir + "/" + names[i], names[i], files[i]);
+
+    defines_t defines;
+    generate_defines(files, defines);
+
+    std::map<std::string, std::string> outputs;
+    outputs["defines.v"] = defines.text;
+
+    std::vector<decode_rule_t> rules;
+    {
+        output_t out;
+        out.name = "decode_commands.v";
+        out.host = ao486_dir + "/pipeline/decode_commands.v";
+        std::vector<std::string> scripts;
+        std::vector<int> lines;
+        load_host(out, scripts, lines);
+        generate_decode(files, out, rules);
+        outputs[out.name] = emit(out);
+    }
+
+    mc_analysis_t analysis;
+    {
+        output_t out;
+        out.name = "microcode_commands.v";
+        out.host = ao486_dir + "/pipeline/microcode_commands.v";
+        std::vector<std::string> scripts;
+        std::vector<int> lines;
+        load_host(out, scripts, lines);
+        generate_microcode(files, defines, out, analysis);
+        outputs[out.name] = emit(out);
+    }
+
+    static const struct { const char *tag; const char *name; const char *host; } scripted[] = {
+        { "read",    "read_commands.v",    "pipeline/read_commands.v" },
+        { "execute", "execute_commands.v", "pipeline/execute_commands.v" },
+        { "write",   "write_commands.v",   "pipeline/write_commands.v" },
+        { "",        "exception.v",        "exception.v" },
+        { "",        "memory_write.v",     "memory/memory_write.v" },
+        { "",        "prefetch_control.v", "memory/prefetch_control.v" },
+    };
+    for(auto &entry : scripted) {
+        output_t out;
+        out.name = entry.name;
+        out.host = ao486_dir + "/" + entry.host;
+        generate_scripts(files, entry.tag, out);
+        outputs[out.name] = emit(out);
+    }
+
+    if(errors > 0) {
+        printf("Error: %d errors, nothing written\n", errors);
+        return 1;
+    }
+
+    for(auto &output : outputs) {
+        std::string name = output_dir + "/" + output.first;
+        if(write_file(name, output.second) == false) {
+            printf("Error: can not write %s\n", name.c_str());
+            return 1;
+        }
+    }
+
+    std::string report = generate_report(rules, defines, analysis);
+    if(write_file(report_name, report) == false) {
+        printf("Error: can not write %s\n", report_name.c_str());
+        return 1;
+    }
+
+    printf("%d commands, %d files written to %s, report in %s\n", (int)defines.cmds.size(), (int)outputs.size(), output_dir.c_str(), report_name.c_str());
+    return 0;
+}
@@ -33,6 +33,10 @@ vlog -O0 +incdir+./../../../rtl/ao486/ ../../../rtl/ao486/pipeline/condition.v ^
 ../../../rtl/ao486/pipeline/execute.v ^
 ../../../rtl/ao486/pipeline/execute_commands.v ^
 ../../../rtl/ao486/pipeline/execute_divide.v ^
+../../../rtl/ao486/pipeline/execute_fpu.v ^
+../../../rtl/ao486/pipeline/execute_fpu_arith.v ^
+../../../rtl/ao486/pipeline/execute_fpu_normalize.v ^
+../../../rtl/ao486/pipeline/execute_fpu_round.v ^
 ../../../rtl/ao486/pipeline/execute_multiply.v ^
 ../../../rtl/ao486/pipeline/execute_offset.v ^
 ../../../rtl/ao486/pipeline/execute_shift.v ^
@@ -54,7 +58,8 @@ vlog -O0 +incdir+./../../../rtl/ao486/ ../../../rtl/ao486/pipeline/condition.v ^
 ../../../rtl/ao486/pipeline/write_string.v
 
 vlog -sv -O0 ../../../rtl/cache/l2_cache.v ^
-../../../rtl/cache/l1_icache.v
+../../../rtl/cache/l1_icache.v ^
+../../../rtl/cache/l1_dcache.v
 
 vlog -vlog01compat -O0 ^
 ../../../rtl/ao486/exception.v ^
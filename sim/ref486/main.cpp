@@ -0,0 +1,252 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "shared_mem.h"
+#include "ref486.h"
+
+/* Reference side of a co-simulation: runs ref486 in the bochs486_pc slot of
+ * the hub (sim_pc). Every bus transaction that leaves the model goes through
+ * the bochs486_pc mailbox; with 'sim_pc --lockstep' the hub compares them
+ * with the ones of ao486 and stops at the first difference.
+ *
+ * Interrupts are taken from the pic here, and published in interrupt_vector
+ * and interrupt_at_counter for the lockstep harness (verilator/ao486/main.cpp),
+ * which replays them at the same instruction.
+ *
+ * Fast-forward: with --handoff-at N (instructions) or --handoff-eip X (linear
+ * address of the next instruction) the state at that boundary is published in
+ * shared_mem_t::handoff, and ao486 is started on it (sim_pc --fast-forward).
+ * The model then exits, or keeps running in lockstep with ao486.
+ */
+
+//------------------------------------------------------------------------------
+
+volatile shared_mem_t *shared_ptr = NULL;
+
+//synchronous transactions through the bochs486_pc mailbox; the hub acks them
+static uint32 mailbox_mem(uint32 address, uint32 data, uint32 byteenable, uint32 is_write) {
+    volatile processor_t *p = &shared_ptr->bochs486_pc;
+
+    p->mem_address    = address;
+    p->mem_data       = data;
+    p->mem_byteenable = byteenable;
+    p->mem_is_write   = is_write;
+    p->mem_step       = STEP_REQ;
+
+    uint32 spins = 0;
+    while(p->mem_step != STEP_ACK) ring_backoff(spins);
+
+    data = p->mem_data;
+    p->mem_step = STEP_IDLE;
+    return data;
+}
+
+static uint32 mailbox_io(uint32 address, uint32 data, uint32 byteenable, uint32 is_write) {
+    volatile processor_t *p = &shared_ptr->bochs486_pc;
+
+    p->io_address    = address;
+    p->io_data       = data;
+    p->io_byteenable = byteenable;
+    p->io_is_write   = is_write;
+    p->io_step       = STEP_REQ;
+
+    uint32 spins = 0;
+    while(p->io_step != STEP_ACK) ring_backoff(spins);
+
+    data = p->io_data;
+    p->io_step = STEP_IDLE;
+    return data;
+}
+
+static uint32 bus_mem_read(void *, uint32 address, uint32 byteenable) {
+    return mailbox_mem(address, 0, byteenable, 0);
+}
+
+static void bus_mem_write(void *, uint32 address, uint32 data, uint32 byteenable) {
+    mailbox_mem(address, data, byteenable, 1);
+}
+
+static uint32 bus_io_read(void *, uint32 address, uint32 byteenable) {
+    return mailbox_io(address, 0, byteenable, 0);
+}
+
+static void bus_io_write(void *, uint32 address, uint32 data, uint32 byteenable) {
+    mailbox_io(address, data, byteenable, 1);
+}
+
+//------------------------------------------------------------------------------
+
+/* Take the interrupt the pic offers, with the handshake of the ao486 harness.
+ * While ao486 runs, an interrupt it has not reached yet is still published,
+ * so the next one waits.
+ */
+static bool take_interrupt(ref486_t &cpu, FILE *fp) {
+    if(shared_ptr->irq_do != STEP_REQ || shared_ptr->irq_done != STEP_IDLE) return false;
+    if(ref486_interrupts_enabled(cpu) == false) return false;
+
+    bool ao486_running = shared_ptr->ao486.starting == STEP_ACK;
+    if(ao486_running && shared_ptr->interrupt_at_counter != 0 && shared_ptr->ao486.instr_counter < shared_ptr->interrupt_at_counter) return false;
+
+    uint32 vector = shared_ptr->irq_do_vector;
+
+    shared_ptr->irq_done_vector = vector;
+    shared_ptr->irq_done        = STEP_REQ;
+    shared_ptr->irq_do          = STEP_ACK;
+
+    shared_ptr->interrupt_vector     = vector;
+    shared_ptr->interrupt_at_counter = cpu.instr_counter;
+
+    if(fp != NULL) {
+        fprintf(fp, "IAC 0x%02x at %d\n", vector, cpu.instr_counter);
+        fflush(fp);
+    }
+
+    ref486_status_t status = ref486_interrupt(cpu, vector);
+    if(status != REF486_OK) {
+        printf("interrupt 0x%02x at %u: %s\n", vector, cpu.instr_counter, (status == REF486_SHUTDOWN)? "shutdown" : cpu.unsupported);
+        return false;
+    }
+    return true;
+}
+
+//publish the state and wait until ao486 runs on it; true when the model stays on in lockstep
+static bool handoff(ref486_t &cpu) {
+    ref486_export(cpu, *const_cast<arch_state_t *>(&shared_ptr->handoff));
+    shared_ptr->handoff_step = STEP_REQ;
+
+    printf("handoff at %u, eip %08x\n", cpu.instr_counter, ref486_linear_eip(cpu));
+    fflush(stdout);
+
+    while(shared_ptr->handoff_step != STEP_ACK) {
+        usleep(1000);
+    }
+    return shared_ptr->handoff_lockstep != 0;
+}
+
+int main(int argc, char **argv) {
+    uint32 max_instr   = 0;
+    uint32 handoff_at  = 0;
+    uint32 handoff_eip = 0;
+    bool   handoff_pending = false;
+
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--max-instr") == 0 && i+1 < argc)        max_instr   = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--handoff-at") == 0 && i+1 < argc)  { handoff_at  = strtoul(argv[++i], NULL, 0); handoff_pending = true; }
+        else if(strcmp(argv[i], "--handoff-eip") == 0 && i+1 < argc) { handoff_eip = strtoul(argv[++i], NULL, 0); handoff_pending = true; }
+    }
+
+    //map shared memory
+    int fd = open(instance_path("shared_mem.dat", "./../sim_pc/shared_mem.dat"), O_RDWR, S_IRUSR | S_IWUSR);
+
+    if(fd == -1) {
+        perror("open() failed for shared_mem.dat");
+        return -1;
+    }
+
+    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if(shared_ptr == MAP_FAILED) {
+        perror("mmap() failed");
+        close(fd);
+        return -2;
+    }
+
+    //wait for ack
+    shared_ptr->bochs486_pc.starting = STEP_REQ;
+    printf("Waiting for startup ack...");
+    fflush(stdout);
+    while(shared_ptr->bochs486_pc.starting != STEP_ACK) {
+        usleep(100000);
+    }
+    printf("done.\n");
+
+    FILE *irq_fp = fopen(instance_path("ref486_interrupt.txt", "ref486_interrupt.txt"), "w");
+
+    //--------------------------------------------------------------------------
+
+    static ref486_t cpu;
+    memset(&cpu, 0, sizeof(cpu));
+
+    cpu.bus.ctx       = NULL;
+    cpu.bus.ram       = const_cast<const uint8 *>(shared_ptr->mem.bytes);
+    cpu.bus.ram_size  = shared_ptr->mem_size;
+    cpu.bus.mem_read  = bus_mem_read;
+    cpu.bus.mem_write = bus_mem_write;
+    cpu.bus.io_read   = bus_io_read;
+    cpu.bus.io_write  = bus_io_write;
+
+    ref486_reset(cpu);
+
+    uint32 exception_counter = 0;
+    uint32 idle_spins        = 0;
+    int    result            = 0;
+
+    while(max_instr == 0 || cpu.instr_counter < max_instr) {
+
+        //---------------------------------------------------------------------- stop control
+
+        if(shared_ptr->bochs486_pc.stop == STEP_REQ) {
+            shared_ptr->bochs486_pc.stop = STEP_ACK;
+            while(shared_ptr->bochs486_pc.stop != STEP_IDLE) {
+                usleep(500);
+            }
+        }
+
+        //---------------------------------------------------------------------- fast-forward
+
+        //ao486 can not take over inside an interrupt shadow or in hlt
+        if(handoff_pending && cpu.halted == false && cpu.inhibit_interrupts == false) {
+            bool reached = (handoff_at != 0)? cpu.instr_counter >= handoff_at : ref486_linear_eip(cpu) == handoff_eip;
+
+            if(reached) {
+                handoff_pending = false;
+                if(handoff(cpu) == false) break;
+            }
+        }
+
+        //---------------------------------------------------------------------- interrupt
+
+        take_interrupt(cpu, irq_fp);
+
+        //---------------------------------------------------------------------- instruction
+
+        ref486_status_t status = ref486_step(cpu);
+        shared_ptr->bochs486_pc.instr_counter = cpu.instr_counter;
+
+        if(cpu.exception_counter != exception_counter) {
+            exception_counter = cpu.exception_counter;
+            if(shared_ptr->dump_enabled) printf("exception %d at %u\n", cpu.exception_vector, cpu.instr_counter);
+        }
+
+        if(status == REF486_HALTED) {
+            ring_backoff(idle_spins);
+            continue;
+        }
+        idle_spins = 0;
+
+        if(status == REF486_SHUTDOWN) {
+            printf("shutdown at %u\n", cpu.instr_counter);
+            result = -3;
+            break;
+        }
+        if(status == REF486_UNSUPPORTED) {
+            printf("unsupported at %u: %s\n", cpu.instr_counter, cpu.unsupported);
+            result = -4;
+            break;
+        }
+    }
+
+    ref486_print(cpu, stdout);
+
+    if(irq_fp != NULL) fclose(irq_fp);
+    munmap((void *)shared_ptr, sizeof(shared_mem_t));
+    close(fd);
+    return result;
+}
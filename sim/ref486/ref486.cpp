@@ -0,0 +1,2808 @@
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+#include "ref486.h"
+
+//------------------------------------------------------------------------------ constants
+
+#define FLAG_CF     0x00000001
+#define FLAG_PF     0x00000004
+#define FLAG_AF     0x00000010
+#define FLAG_ZF     0x00000040
+#define FLAG_SF     0x00000080
+#define FLAG_TF     0x00000100
+#define FLAG_IF     0x00000200
+#define FLAG_DF     0x00000400
+#define FLAG_OF     0x00000800
+#define FLAG_IOPL   0x00003000
+#define FLAG_NT     0x00004000
+#define FLAG_RF     0x00010000
+#define FLAG_VM     0x00020000
+#define FLAG_AC     0x00040000
+#define FLAG_ID     0x00200000
+
+#define FLAGS_ARITH (FLAG_CF | FLAG_PF | FLAG_AF | FLAG_ZF | FLAG_SF | FLAG_OF)
+
+#define CR0_PE      0x00000001
+#define CR0_MP      0x00000002
+#define CR0_EM      0x00000004
+#define CR0_TS      0x00000008
+#define CR0_ET      0x00000010
+#define CR0_NE      0x00000020
+#define CR0_WP      0x00010000
+#define CR0_AM      0x00040000
+#define CR0_NW      0x20000000
+#define CR0_CD      0x40000000
+#define CR0_PG      0x80000000
+
+//bits kept by ao486, ET reads as one
+#define CR0_MASK    0xE005003F
+
+//descriptor byte 5
+#define DESC_P          0x80
+#define DESC_S          0x10
+#define DESC_CODE       0x08
+#define DESC_CONFORMING 0x04    //code
+#define DESC_EXPAND     0x04    //data
+#define DESC_RW         0x02    //readable code, writable data
+#define DESC_ACCESSED   0x01
+
+//descriptor byte 6, bits 7:4
+#define DESC_G          0x80
+#define DESC_D_B        0x40
+
+#define EXCEPTION_DE    0
+#define EXCEPTION_DB    1
+#define EXCEPTION_BP    3
+#define EXCEPTION_OF    4
+#define EXCEPTION_BR    5
+#define EXCEPTION_UD    6
+#define EXCEPTION_NM    7
+#define EXCEPTION_DF    8
+#define EXCEPTION_TS    10
+#define EXCEPTION_NP    11
+#define EXCEPTION_SS    12
+#define EXCEPTION_GP    13
+#define EXCEPTION_PF    14
+#define EXCEPTION_AC    17
+
+#define CPUID_MODEL_FAMILY_STEPPING 0x0000045B
+
+//------------------------------------------------------------------------------ faults
+
+/* A fault unwinds the instruction with a C++ exception; ref486_step() puts the
+ * registers back as they were before the instruction and delivers it. Memory
+ * written before the fault stays written, as on the hardware.
+ */
+
+struct fault_t {
+    uint8  vector;
+    uint32 error_code;
+};
+
+struct unsupported_t {
+    const char *what;
+};
+
+[[noreturn]] static void fault(uint8 vector, uint32 error_code) {
+    fault_t value = { vector, error_code };
+    throw value;
+}
+
+[[noreturn]] static void unsupported(const char *what) {
+    unsupported_t value = { what };
+    throw value;
+}
+
+static inline bool has_error_code(uint8 vector) {
+    return vector == EXCEPTION_DF || (vector >= EXCEPTION_TS && vector <= EXCEPTION_PF) || vector == EXCEPTION_AC;
+}
+
+static inline bool contributory(uint8 vector) {
+    return vector == EXCEPTION_DE || (vector >= EXCEPTION_TS && vector <= EXCEPTION_GP);
+}
+
+//------------------------------------------------------------------------------ modes
+
+static inline bool real_mode(const ref486_t &cpu) {
+    return (cpu.cr0 & CR0_PE) == 0;
+}
+
+static inline bool v86_mode(const ref486_t &cpu) {
+    return (cpu.cr0 & CR0_PE) != 0 && (cpu.eflags & FLAG_VM) != 0;
+}
+
+static inline bool protected_mode(const ref486_t &cpu) {
+    return (cpu.cr0 & CR0_PE) != 0 && (cpu.eflags & FLAG_VM) == 0;
+}
+
+static inline uint32 iopl(const ref486_t &cpu) {
+    return (cpu.eflags >> 12) & 3;
+}
+
+static inline uint32 dpl_of(uint8 rights) {
+    return (rights >> 5) & 3;
+}
+
+//------------------------------------------------------------------------------ physical bus
+
+static inline bool is_ram(uint32 address) {
+    return address < 0xA0000 || address >= 0xC0000;
+}
+
+static inline uint32 bus_address(const ref486_t &cpu, uint32 address) {
+    if(is_ram(address) && cpu.bus.ram_size != 0) address &= cpu.bus.ram_size - 1;
+    return address & 0xFFFFFFFC;
+}
+
+//one dword of the bus; ram comes from the mapping, the rest through mem_read
+static uint32 bus_read(ref486_t &cpu, uint32 address, uint32 byteenable) {
+    address = bus_address(cpu, address);
+
+    if(cpu.bus.ram != NULL && is_ram(address)) {
+        uint32 value;
+        memcpy(&value, cpu.bus.ram + address, 4);
+        return value;
+    }
+    return cpu.bus.mem_read(cpu.bus.ctx, address, byteenable);
+}
+
+//length 1 to 4, the caller keeps it inside one page
+static uint32 phys_read(ref486_t &cpu, uint32 address, uint32 length) {
+    if(cpu.bus.ram != NULL && is_ram(address)) {
+        uint32 offset = address & (cpu.bus.ram_size - 1);
+        if(offset + length <= cpu.bus.ram_size) {
+            uint32 value = 0;
+            memcpy(&value, cpu.bus.ram + offset, length);
+            return value;
+        }
+    }
+
+    uint32 value = 0;
+    for(uint32 done=0; done<length; ) {
+        uint32 lane  = (address + done) & 3;
+        uint32 count = (4 - lane < length - done)? 4 - lane : length - done;
+        uint32 mask  = (count == 4)? 0xFFFFFFFF : (1u << (count * 8)) - 1;
+
+        uint32 data = bus_read(cpu, address + done, ((1u << count) - 1) << lane);
+        value |= ((data >> (lane * 8)) & mask) << (done * 8);
+        done  += count;
+    }
+    return value;
+}
+
+//split in dwords with a byteenable, as ao486 writes them
+static void phys_write(ref486_t &cpu, uint32 address, uint32 length, uint32 value) {
+    for(uint32 done=0; done<length; ) {
+        uint32 lane  = (address + done) & 3;
+        uint32 count = (4 - lane < length - done)? 4 - lane : length - done;
+        uint32 mask  = (count == 4)? 0xFFFFFFFF : (1u << (count * 8)) - 1;
+
+        uint32 data = ((value >> (done * 8)) & mask) << (lane * 8);
+        cpu.bus.mem_write(cpu.bus.ctx, bus_address(cpu, address + done), data, ((1u << count) - 1) << lane);
+        done += count;
+    }
+}
+
+//------------------------------------------------------------------------------ paging
+
+static void tlb_flush(ref486_t &cpu) {
+    memset(cpu.tlb, 0, sizeof(cpu.tlb));
+}
+
+static void tlb_flush_page(ref486_t &cpu, uint32 linear) {
+    ref486_tlb_t &entry = cpu.tlb[(linear >> 12) % REF486_TLB_SIZE];
+    if((entry.linear & 0xFFFFF000) == (linear & 0xFFFFF000)) entry.linear = 0;
+}
+
+[[noreturn]] static void page_fault(ref486_t &cpu, uint32 linear, uint32 error_code) {
+    cpu.cr2 = linear;
+    fault(EXCEPTION_PF, error_code);
+}
+
+static inline bool page_allowed(const ref486_t &cpu, bool entry_user, bool entry_writable, bool write, bool user) {
+    if(user && entry_user == false) return false;
+    if(write && entry_writable == false && (user || (cpu.cr0 & CR0_WP))) return false;
+    return true;
+}
+
+/* Two level walk. The accessed and dirty bits are written back the way the
+ * ao486 tlb does it: the whole pde, then the whole pte, each only when a bit
+ * changes.
+ */
+static uint32 translate(ref486_t &cpu, uint32 linear, bool write, bool user) {
+    if((cpu.cr0 & CR0_PG) == 0) return linear;
+
+    ref486_tlb_t &entry = cpu.tlb[(linear >> 12) % REF486_TLB_SIZE];
+    if(entry.linear == ((linear & 0xFFFFF000) | 1) && page_allowed(cpu, entry.user, entry.writable, write, user) && (write == false || entry.dirty)) {
+        return entry.physical | (linear & 0xFFF);
+    }
+
+    uint32 error_code = (user? 4 : 0) | (write? 2 : 0);
+
+    uint32 pde_address = (cpu.cr3 & 0xFFFFF000) | ((linear >> 20) & 0xFFC);
+    uint32 pde = phys_read(cpu, pde_address, 4);
+    if((pde & 1) == 0) page_fault(cpu, linear, error_code);
+
+    uint32 pte_address = (pde & 0xFFFFF000) | ((linear >> 10) & 0xFFC);
+    uint32 pte = phys_read(cpu, pte_address, 4);
+    if((pte & 1) == 0) page_fault(cpu, linear, error_code);
+
+    bool entry_user     = (pde & pte & 4) != 0;
+    bool entry_writable = (pde & pte & 2) != 0;
+    if(page_allowed(cpu, entry_user, entry_writable, write, user) == false) page_fault(cpu, linear, error_code | 1);
+
+    if((pde & 0x20) == 0) phys_write(cpu, pde_address, 4, pde | 0x20);
+    if((pte & 0x20) == 0 || (write && (pte & 0x40) == 0)) {
+        pte |= 0x20 | (write? 0x40 : 0);
+        phys_write(cpu, pte_address, 4, pte);
+    }
+
+    entry.linear   = (linear & 0xFFFFF000) | 1;
+    entry.physical = pte & 0xFFFFF000;
+    entry.user     = entry_user;
+    entry.writable = entry_writable;
+    entry.dirty    = (pte & 0x40) != 0;
+
+    return entry.physical | (linear & 0xFFF);
+}
+
+//------------------------------------------------------------------------------ linear memory
+
+/* 'write' selects the translation: a read-modify-write operand is read with
+ * the write translation, so the dirty bit is set by the read like in ao486.
+ * Both pages of a split access are translated before any byte moves.
+ */
+static uint32 linear_read(ref486_t &cpu, uint32 linear, uint32 length, bool write, bool user) {
+    uint32 first = 0x1000 - (linear & 0xFFF);
+    if(length <= first) return phys_read(cpu, translate(cpu, linear, write, user), length);
+
+    uint32 low  = translate(cpu, linear, write, user);
+    uint32 high = translate(cpu, linear + first, write, user);
+    return phys_read(cpu, low, first) | (phys_read(cpu, high, length - first) << (first * 8));
+}
+
+static void linear_write(ref486_t &cpu, uint32 linear, uint32 length, uint32 value, bool user) {
+    uint32 first = 0x1000 - (linear & 0xFFF);
+    if(length <= first) {
+        phys_write(cpu, translate(cpu, linear, true, user), length, value);
+        return;
+    }
+
+    uint32 low  = translate(cpu, linear, true, user);
+    uint32 high = translate(cpu, linear + first, true, user);
+    phys_write(cpu, low,  first,          value);
+    phys_write(cpu, high, length - first, value >> (first * 8));
+}
+
+//descriptor tables, tss: supervisor accesses whatever the cpl
+static inline uint32 system_read(ref486_t &cpu, uint32 linear, uint32 length) {
+    return linear_read(cpu, linear, length, false, false);
+}
+
+static inline void system_write(ref486_t &cpu, uint32 linear, uint32 length, uint32 value) {
+    linear_write(cpu, linear, length, value, false);
+}
+
+//------------------------------------------------------------------------------ segments
+
+static inline bool segment_fits(const ref486_seg_t &seg, uint32 offset, uint32 length) {
+    uint32 last = offset + length - 1;
+    if(last < offset) return false;
+
+    //expand-down data
+    if((seg.rights & (DESC_S | DESC_CODE | DESC_EXPAND)) == (DESC_S | DESC_EXPAND)) {
+        uint32 upper = (seg.flags & DESC_D_B)? 0xFFFFFFFF : 0xFFFF;
+        return offset > seg.limit && last <= upper;
+    }
+    return last <= seg.limit;
+}
+
+static inline uint32 stack_mask(const ref486_seg_t &ss) {
+    return (ss.flags & DESC_D_B)? 0xFFFFFFFF : 0x0000FFFF;
+}
+
+static inline void alignment_check(const ref486_t &cpu, uint32 linear, uint32 length) {
+    if(length > 1 && (linear & (length - 1)) != 0 && cpu.cpl == 3 && (cpu.cr0 & CR0_AM) && (cpu.eflags & FLAG_AC)) fault(EXCEPTION_AC, 0);
+}
+
+//segment checks of a data access; returns the linear address
+static uint32 segment_check(ref486_t &cpu, uint32 s, uint32 offset, uint32 length, bool write) {
+    const ref486_seg_t &seg = cpu.seg[s];
+    uint8 vector = (s == REF486_SS)? EXCEPTION_SS : EXCEPTION_GP;
+
+    if(protected_mode(cpu)) {
+        if(seg.valid == false) fault(vector, 0);
+
+        if(write && (seg.rights & (DESC_CODE | DESC_RW)) != DESC_RW)          fault(vector, 0);
+        if(write == false && (seg.rights & (DESC_CODE | DESC_RW)) == DESC_CODE) fault(vector, 0);
+    }
+    if(segment_fits(seg, offset, length) == false) fault(vector, 0);
+
+    uint32 linear = seg.base + offset;
+    alignment_check(cpu, linear, length);
+    return linear;
+}
+
+static uint32 read_mem(ref486_t &cpu, uint32 s, uint32 offset, uint32 length) {
+    uint32 linear = segment_check(cpu, s, offset, length, false);
+    return linear_read(cpu, linear, length, false, cpu.cpl == 3);
+}
+
+//read of a read-modify-write operand
+static uint32 read_mem_rmw(ref486_t &cpu, uint32 s, uint32 offset, uint32 length) {
+    uint32 linear = segment_check(cpu, s, offset, length, true);
+    return linear_read(cpu, linear, length, true, cpu.cpl == 3);
+}
+
+static void write_mem(ref486_t &cpu, uint32 s, uint32 offset, uint32 length, uint32 value) {
+    uint32 linear = segment_check(cpu, s, offset, length, true);
+    linear_write(cpu, linear, length, value, cpu.cpl == 3);
+}
+
+//------------------------------------------------------------------------------ descriptors
+
+static ref486_seg_t descriptor_cache(uint16 selector, uint32 low, uint32 high) {
+    ref486_seg_t seg;
+
+    seg.selector = selector;
+    seg.base     = (low >> 16) | ((high & 0xFF) << 16) | (high & 0xFF000000);
+    seg.limit    = (low & 0xFFFF) | (high & 0x000F0000);
+    seg.rights   = (high >> 8) & 0xFF;
+    seg.flags    = (high >> 16) & 0xF0;
+    seg.valid    = true;
+
+    if(seg.flags & DESC_G) seg.limit = (seg.limit << 12) | 0xFFF;
+    return seg;
+}
+
+//linear address of the descriptor, or faults with 'vector'
+static uint32 descriptor_address(ref486_t &cpu, uint16 selector, uint8 vector) {
+    uint32 base  = cpu.gdtr_base;
+    uint32 limit = cpu.gdtr_limit;
+
+    if(selector & 4) {
+        if(cpu.seg[REF486_LDTR].valid == false) fault(vector, selector & 0xFFFC);
+        base  = cpu.seg[REF486_LDTR].base;
+        limit = cpu.seg[REF486_LDTR].limit;
+    }
+    if((uint32)(selector | 7) > limit) fault(vector, selector & 0xFFFC);
+
+    return base + (selector & 0xFFF8);
+}
+
+static ref486_seg_t read_descriptor(ref486_t &cpu, uint16 selector, uint8 vector, uint32 *low_ptr = NULL, uint32 *high_ptr = NULL) {
+    uint32 address = descriptor_address(cpu, selector, vector);
+
+    uint32 low  = system_read(cpu, address,     4);
+    uint32 high = system_read(cpu, address + 4, 4);
+
+    if(low_ptr  != NULL) *low_ptr  = low;
+    if(high_ptr != NULL) *high_ptr = high;
+    return descriptor_cache(selector, low, high);
+}
+
+//set the accessed bit: one byte write of descriptor byte 5
+static void touch_descriptor(ref486_t &cpu, ref486_seg_t &seg) {
+    if(seg.rights & DESC_ACCESSED) return;
+
+    seg.rights |= DESC_ACCESSED;
+    system_write(cpu, descriptor_address(cpu, seg.selector, EXCEPTION_GP) + 5, 1, seg.rights);
+}
+
+//real mode keeps limit and type, virtual 8086 mode gets a fixed 64k ring 3 data segment
+static void load_segment_real(ref486_t &cpu, uint32 s, uint16 selector) {
+    ref486_seg_t &seg = cpu.seg[s];
+
+    seg.selector = selector;
+    seg.base     = (uint32)selector << 4;
+    seg.valid    = true;
+
+    if(v86_mode(cpu)) {
+        seg.limit  = 0xFFFF;
+        seg.rights = DESC_P | (3 << 5) | DESC_S | DESC_RW | DESC_ACCESSED;
+        seg.flags  = 0;
+    }
+    else {
+        seg.rights |= DESC_P | DESC_S;
+    }
+}
+
+//ES, SS, DS, FS, GS
+static void load_segment(ref486_t &cpu, uint32 s, uint16 selector) {
+    if(protected_mode(cpu) == false) {
+        load_segment_real(cpu, s, selector);
+        return;
+    }
+
+    if((selector & 0xFFFC) == 0) {
+        if(s == REF486_SS) fault(EXCEPTION_GP, 0);
+
+        ref486_seg_t &seg = cpu.seg[s];
+        seg.selector = selector;
+        seg.valid    = false;
+        seg.rights   = 0;
+        return;
+    }
+
+    ref486_seg_t seg = read_descriptor(cpu, selector, EXCEPTION_GP);
+    uint32 error_code = selector & 0xFFFC;
+    uint32 rpl        = selector & 3;
+    uint32 dpl        = dpl_of(seg.rights);
+
+    if((seg.rights & DESC_S) == 0) fault(EXCEPTION_GP, error_code);
+
+    if(s == REF486_SS) {
+        if(rpl != cpu.cpl || (seg.rights & (DESC_CODE | DESC_RW)) != DESC_RW || dpl != cpu.cpl) fault(EXCEPTION_GP, error_code);
+        if((seg.rights & DESC_P) == 0) fault(EXCEPTION_SS, error_code);
+    }
+    else {
+        if((seg.rights & (DESC_CODE | DESC_RW)) == DESC_CODE) fault(EXCEPTION_GP, error_code);
+
+        bool conforming_code = (seg.rights & (DESC_CODE | DESC_CONFORMING)) == (DESC_CODE | DESC_CONFORMING);
+        if(conforming_code == false && (dpl < cpu.cpl || dpl < rpl)) fault(EXCEPTION_GP, error_code);
+
+        if((seg.rights & DESC_P) == 0) fault(EXCEPTION_NP, error_code);
+    }
+
+    touch_descriptor(cpu, seg);
+    cpu.seg[s] = seg;
+}
+
+//after a return to an outer level: data segments the new level may not use become null
+static void invalidate_segments(ref486_t &cpu) {
+    static const uint32 list[4] = { REF486_ES, REF486_DS, REF486_FS, REF486_GS };
+
+    for(uint32 i=0; i<4; i++) {
+        ref486_seg_t &seg = cpu.seg[list[i]];
+        if(seg.valid == false) continue;
+
+        bool conforming_code = (seg.rights & (DESC_CODE | DESC_CONFORMING)) == (DESC_CODE | DESC_CONFORMING);
+        if(conforming_code == false && dpl_of(seg.rights) < cpu.cpl) {
+            seg.selector = 0;
+            seg.valid    = false;
+            seg.rights   = 0;
+        }
+    }
+}
+
+//new CS from a checked descriptor; its RPL becomes the cpl
+static void set_cs(ref486_t &cpu, ref486_seg_t &cs, uint32 new_cpl) {
+    touch_descriptor(cpu, cs);
+
+    cs.selector = (cs.selector & 0xFFFC) | new_cpl;
+    cpu.seg[REF486_CS] = cs;
+    cpu.cpl = new_cpl;
+}
+
+static void set_cs_real(ref486_t &cpu, uint16 selector) {
+    load_segment_real(cpu, REF486_CS, selector);
+    cpu.cpl = v86_mode(cpu)? 3 : 0;
+}
+
+//------------------------------------------------------------------------------ stack
+
+static void push_on(ref486_t &cpu, const ref486_seg_t &ss, uint32 &esp, uint32 length, uint32 value, bool user, uint32 error_code) {
+    uint32 mask = stack_mask(ss);
+    uint32 next = (esp & ~mask) | ((esp - length) & mask);
+
+    if(segment_fits(ss, next & mask, length) == false) fault(EXCEPTION_SS, error_code);
+
+    uint32 linear = ss.base + (next & mask);
+    if(user) alignment_check(cpu, linear, length);
+
+    linear_write(cpu, linear, length, value, user);
+    esp = next;
+}
+
+static void push(ref486_t &cpu, uint32 length, uint32 value) {
+    push_on(cpu, cpu.seg[REF486_SS], cpu.regs[REF486_ESP], length, value, cpu.cpl == 3, 0);
+}
+
+//push of a segment register: the stack moves by 'length', 16 bits are written
+static void push_selector(ref486_t &cpu, uint32 length, uint16 selector) {
+    const ref486_seg_t &ss = cpu.seg[REF486_SS];
+    uint32 mask = stack_mask(ss);
+    uint32 esp  = cpu.regs[REF486_ESP];
+    uint32 next = (esp & ~mask) | ((esp - length) & mask);
+
+    if(segment_fits(ss, next & mask, length) == false) fault(EXCEPTION_SS, 0);
+
+    uint32 linear = ss.base + (next & mask);
+    alignment_check(cpu, linear, length);
+
+    linear_write(cpu, linear, 2, selector, cpu.cpl == 3);
+    cpu.regs[REF486_ESP] = next;
+}
+
+//value at ESP + 'offset', without moving the stack
+static uint32 stack_read(ref486_t &cpu, uint32 offset, uint32 length) {
+    const ref486_seg_t &ss = cpu.seg[REF486_SS];
+    uint32 mask = stack_mask(ss);
+    uint32 at   = (cpu.regs[REF486_ESP] + offset) & mask;
+
+    if(segment_fits(ss, at, length) == false) fault(EXCEPTION_SS, 0);
+
+    uint32 linear = ss.base + at;
+    alignment_check(cpu, linear, length);
+    return linear_read(cpu, linear, length, false, cpu.cpl == 3);
+}
+
+static void stack_add(ref486_t &cpu, uint32 value) {
+    uint32 mask = stack_mask(cpu.seg[REF486_SS]);
+    uint32 esp  = cpu.regs[REF486_ESP];
+    cpu.regs[REF486_ESP] = (esp & ~mask) | ((esp + value) & mask);
+}
+
+static uint32 pop(ref486_t &cpu, uint32 length) {
+    uint32 value = stack_read(cpu, 0, length);
+    stack_add(cpu, length);
+    return value;
+}
+
+//------------------------------------------------------------------------------ io
+
+//ports are moved in dwords with a byteenable, like the avalon io bus of ao486
+static uint32 io_read(ref486_t &cpu, uint32 port, uint32 length) {
+    uint32 value = 0;
+    for(uint32 done=0; done<length; ) {
+        uint32 lane  = (port + done) & 3;
+        uint32 count = (4 - lane < length - done)? 4 - lane : length - done;
+        uint32 mask  = (count == 4)? 0xFFFFFFFF : (1u << (count * 8)) - 1;
+
+        uint32 data = cpu.bus.io_read(cpu.bus.ctx, (port + done) & 0xFFFC, ((1u << count) - 1) << lane);
+        value |= ((data >> (lane * 8)) & mask) << (done * 8);
+        done  += count;
+    }
+    return value;
+}
+
+static void io_write(ref486_t &cpu, uint32 port, uint32 length, uint32 value) {
+    for(uint32 done=0; done<length; ) {
+        uint32 lane  = (port + done) & 3;
+        uint32 count = (4 - lane < length - done)? 4 - lane : length - done;
+        uint32 mask  = (count == 4)? 0xFFFFFFFF : (1u << (count * 8)) - 1;
+
+        uint32 data = ((value >> (done * 8)) & mask) << (lane * 8);
+        cpu.bus.io_write(cpu.bus.ctx, (port + done) & 0xFFFC, data, ((1u << count) - 1) << lane);
+        done += count;
+    }
+}
+
+//cpl above iopl, or virtual 8086 mode: the io permission bitmap of the 386 tss decides
+static void io_allowed(ref486_t &cpu, uint32 port, uint32 length) {
+    if(real_mode(cpu)) return;
+    if(protected_mode(cpu) && cpu.cpl <= iopl(cpu)) return;
+
+    const ref486_seg_t &tr = cpu.seg[REF486_TR];
+    uint32 type = tr.rights & 0x0F;
+    if(tr.valid == false || (type != 0x9 && type != 0xB) || tr.limit < 0x67) fault(EXCEPTION_GP, 0);
+
+    uint32 bitmap = system_read(cpu, tr.base + 0x66, 2) + (port >> 3);
+    if(bitmap + 1 > tr.limit) fault(EXCEPTION_GP, 0);
+
+    uint32 bits = system_read(cpu, tr.base + bitmap, 2);
+    uint32 mask = ((1u << length) - 1) << (port & 7);
+    if(bits & mask) fault(EXCEPTION_GP, 0);
+}
+
+//------------------------------------------------------------------------------ privilege change
+
+//SS:ESP of level 'dpl' from the current tss
+static void tss_stack(ref486_t &cpu, uint32 dpl, uint16 &ss, uint32 &esp) {
+    const ref486_seg_t &tr = cpu.seg[REF486_TR];
+    bool   tss386 = (tr.rights & 0x08) != 0;
+    uint32 offset = (tss386)? 4 + dpl * 8 : 2 + dpl * 4;
+    uint32 length = (tss386)? 4 : 2;
+
+    if(offset + length * 2 - 1 > tr.limit) fault(EXCEPTION_TS, tr.selector & 0xFFFC);
+
+    esp = system_read(cpu, tr.base + offset, length);
+    ss  = system_read(cpu, tr.base + offset + length, 2);
+}
+
+//stack segment taken from the tss on a switch to level 'dpl'
+static ref486_seg_t inner_stack(ref486_t &cpu, uint16 selector, uint32 dpl) {
+    if((selector & 0xFFFC) == 0) fault(EXCEPTION_TS, 0);
+
+    ref486_seg_t ss = read_descriptor(cpu, selector, EXCEPTION_TS);
+    uint32 error_code = selector & 0xFFFC;
+
+    if((selector & 3) != dpl || dpl_of(ss.rights) != dpl) fault(EXCEPTION_TS, error_code);
+    if((ss.rights & (DESC_S | DESC_CODE | DESC_RW)) != (DESC_S | DESC_RW))       fault(EXCEPTION_TS, error_code);
+    if((ss.rights & DESC_P) == 0) fault(EXCEPTION_SS, error_code);
+
+    touch_descriptor(cpu, ss);
+    return ss;
+}
+
+//stack segment popped by a return to an outer level 'rpl'
+static ref486_seg_t outer_stack(ref486_t &cpu, uint16 selector, uint32 rpl) {
+    if((selector & 0xFFFC) == 0) fault(EXCEPTION_GP, 0);
+
+    ref486_seg_t ss = read_descriptor(cpu, selector, EXCEPTION_GP);
+    uint32 error_code = selector & 0xFFFC;
+
+    if((selector & 3) != rpl || dpl_of(ss.rights) != rpl)                  fault(EXCEPTION_GP, error_code);
+    if((ss.rights & (DESC_S | DESC_CODE | DESC_RW)) != (DESC_S | DESC_RW)) fault(EXCEPTION_GP, error_code);
+    if((ss.rights & DESC_P) == 0) fault(EXCEPTION_SS, error_code);
+
+    touch_descriptor(cpu, ss);
+    return ss;
+}
+
+static void set_esp(ref486_t &cpu, const ref486_seg_t &ss, uint32 esp) {
+    if(ss.flags & DESC_D_B) cpu.regs[REF486_ESP] = esp;
+    else                    cpu.regs[REF486_ESP] = (cpu.regs[REF486_ESP] & 0xFFFF0000) | (esp & 0xFFFF);
+}
+
+//------------------------------------------------------------------------------ interrupts
+
+/* Delivery through the ivt or the idt. 'software' is int n, int3 and into:
+ * they check the gate dpl and do not set the EXT bit of error codes.
+ */
+static void deliver(ref486_t &cpu, uint8 vector, bool push_error, uint32 error_code, bool software) {
+    uint32 ext = (software)? 0 : 1;
+
+    if(real_mode(cpu)) {
+        if(vector * 4u + 3 > cpu.idtr_limit) fault(EXCEPTION_GP, 0);
+
+        uint32 entry = system_read(cpu, cpu.idtr_base + vector * 4, 4);
+
+        push(cpu, 2, cpu.eflags);
+        push(cpu, 2, cpu.seg[REF486_CS].selector);
+        push(cpu, 2, cpu.eip);
+
+        cpu.eflags &= ~(FLAG_IF | FLAG_TF | FLAG_AC);
+        set_cs_real(cpu, entry >> 16);
+        cpu.eip = entry & 0xFFFF;
+        return;
+    }
+
+    uint32 gate_error = vector * 8 + 2 + ext;
+    if(vector * 8u + 7 > cpu.idtr_limit) fault(EXCEPTION_GP, gate_error);
+
+    uint32 low  = system_read(cpu, cpu.idtr_base + vector * 8,     4);
+    uint32 high = system_read(cpu, cpu.idtr_base + vector * 8 + 4, 4);
+
+    uint32 type = (high >> 8) & 0x1F;
+    if(type != 0x05 && type != 0x06 && type != 0x07 && type != 0x0E && type != 0x0F) fault(EXCEPTION_GP, gate_error);
+
+    if(software && dpl_of(high >> 8) < cpu.cpl) fault(EXCEPTION_GP, vector * 8 + 2);
+    if((high & 0x8000) == 0) fault(EXCEPTION_NP, gate_error);
+
+    if(type == 0x05) unsupported("task gate in the idt");
+
+    bool   gate32   = (type & 0x08) != 0;
+    uint32 length   = (gate32)? 4 : 2;
+    uint16 selector = low >> 16;
+    uint32 offset   = (gate32)? (high & 0xFFFF0000) | (low & 0xFFFF) : (low & 0xFFFF);
+
+    if((selector & 0xFFFC) == 0) fault(EXCEPTION_GP, ext);
+
+    ref486_seg_t cs = read_descriptor(cpu, selector, EXCEPTION_GP);
+    uint32 cs_error = (selector & 0xFFFC) + ext;
+    uint32 dpl      = dpl_of(cs.rights);
+
+    if((cs.rights & (DESC_S | DESC_CODE)) != (DESC_S | DESC_CODE) || dpl > cpu.cpl) fault(EXCEPTION_GP, cs_error);
+    if((cs.rights & DESC_P) == 0) fault(EXCEPTION_NP, cs_error);
+
+    bool   from_v86 = v86_mode(cpu);
+    uint32 eflags   = cpu.eflags;
+    uint32 new_cpl  = cpu.cpl;
+
+    if((cs.rights & DESC_CONFORMING) == 0 && dpl < cpu.cpl) {
+        if(from_v86 && dpl != 0) fault(EXCEPTION_GP, cs_error);
+
+        uint16 ss_selector;
+        uint32 esp;
+        tss_stack(cpu, dpl, ss_selector, esp);
+
+        ref486_seg_t ss = inner_stack(cpu, ss_selector, dpl);
+        uint32 ss_error = ss_selector & 0xFFFC;
+
+        if(from_v86) {
+            push_on(cpu, ss, esp, length, cpu.seg[REF486_GS].selector, false, ss_error);
+            push_on(cpu, ss, esp, length, cpu.seg[REF486_FS].selector, false, ss_error);
+            push_on(cpu, ss, esp, length, cpu.seg[REF486_DS].selector, false, ss_error);
+            push_on(cpu, ss, esp, length, cpu.seg[REF486_ES].selector, false, ss_error);
+        }
+        push_on(cpu, ss, esp, length, cpu.seg[REF486_SS].selector, false, ss_error);
+        push_on(cpu, ss, esp, length, cpu.regs[REF486_ESP],        false, ss_error);
+        push_on(cpu, ss, esp, length, eflags,                      false, ss_error);
+        push_on(cpu, ss, esp, length, cpu.seg[REF486_CS].selector, false, ss_error);
+        push_on(cpu, ss, esp, length, cpu.eip,                     false, ss_error);
+        if(push_error) push_on(cpu, ss, esp, length, error_code,   false, ss_error);
+
+        if(offset > cs.limit) fault(EXCEPTION_GP, 0);
+
+        if(from_v86) {
+            static const uint32 list[4] = { REF486_ES, REF486_DS, REF486_FS, REF486_GS };
+            for(uint32 i=0; i<4; i++) {
+                cpu.seg[list[i]].selector = 0;
+                cpu.seg[list[i]].valid    = false;
+                cpu.seg[list[i]].rights   = 0;
+            }
+        }
+
+        ss.selector = (ss.selector & 0xFFFC) | dpl;
+        cpu.seg[REF486_SS] = ss;
+        set_esp(cpu, ss, esp);
+        new_cpl = dpl;
+    }
+    else {
+        if(from_v86) fault(EXCEPTION_GP, cs_error);
+
+        uint32 esp = cpu.regs[REF486_ESP];
+        bool   user = cpu.cpl == 3;
+
+        push_on(cpu, cpu.seg[REF486_SS], esp, length, eflags,                      user, 0);
+        push_on(cpu, cpu.seg[REF486_SS], esp, length, cpu.seg[REF486_CS].selector, user, 0);
+        push_on(cpu, cpu.seg[REF486_SS], esp, length, cpu.eip,                     user, 0);
+        if(push_error) push_on(cpu, cpu.seg[REF486_SS], esp, length, error_code,   user, 0);
+
+        if(offset > cs.limit) fault(EXCEPTION_GP, 0);
+        cpu.regs[REF486_ESP] = esp;
+    }
+
+    cpu.eflags &= ~(FLAG_TF | FLAG_NT | FLAG_VM | FLAG_RF);
+    if((type & 1) == 0) cpu.eflags &= ~FLAG_IF;
+
+    set_cs(cpu, cs, new_cpl);
+    cpu.eip = offset;
+}
+
+//------------------------------------------------------------------------------ far transfers
+
+//direct jmp/call target: a code segment at the current level
+static void check_code_direct(ref486_t &cpu, ref486_seg_t &cs, uint16 selector) {
+    uint32 error_code = selector & 0xFFFC;
+    uint32 dpl        = dpl_of(cs.rights);
+
+    if((cs.rights & (DESC_S | DESC_CODE)) != (DESC_S | DESC_CODE)) fault(EXCEPTION_GP, error_code);
+
+    if(cs.rights & DESC_CONFORMING) {
+        if(dpl > cpu.cpl) fault(EXCEPTION_GP, error_code);
+    }
+    else {
+        if((selector & 3) > cpu.cpl || dpl != cpu.cpl) fault(EXCEPTION_GP, error_code);
+    }
+    if((cs.rights & DESC_P) == 0) fault(EXCEPTION_NP, error_code);
+}
+
+//jmp far and call far; 'length' is the operand size, the size of the pushes
+static void far_transfer(ref486_t &cpu, uint16 selector, uint32 offset, uint32 length, bool call, uint32 next_eip) {
+    if(protected_mode(cpu) == false) {
+        if(call) {
+            push(cpu, length, cpu.seg[REF486_CS].selector);
+            push(cpu, length, next_eip);
+        }
+        set_cs_real(cpu, selector);
+        cpu.eip = (length == 4)? offset : (offset & 0xFFFF);
+        return;
+    }
+
+    if((selector & 0xFFFC) == 0) fault(EXCEPTION_GP, 0);
+
+    uint32 low, high;
+    ref486_seg_t desc = read_descriptor(cpu, selector, EXCEPTION_GP, &low, &high);
+    uint32 error_code = selector & 0xFFFC;
+
+    if(desc.rights & DESC_S) {
+        check_code_direct(cpu, desc, selector);
+
+        if(call) {
+            uint32 esp  = cpu.regs[REF486_ESP];
+            bool   user = cpu.cpl == 3;
+            push_on(cpu, cpu.seg[REF486_SS], esp, length, cpu.seg[REF486_CS].selector, user, 0);
+            push_on(cpu, cpu.seg[REF486_SS], esp, length, next_eip,                    user, 0);
+            if(offset > desc.limit) fault(EXCEPTION_GP, 0);
+            cpu.regs[REF486_ESP] = esp;
+        }
+        else if(offset > desc.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, desc, cpu.cpl);
+        cpu.eip = offset;
+        return;
+    }
+
+    uint32 type = desc.rights & 0x0F;
+    uint32 dpl  = dpl_of(desc.rights);
+
+    if(type == 0x01 || type == 0x09 || type == 0x05) {
+        if(dpl < cpu.cpl || dpl < (selector & 3)) fault(EXCEPTION_GP, error_code);
+        unsupported("task switch through jmp or call");
+    }
+    if(type != 0x04 && type != 0x0C) fault(EXCEPTION_GP, error_code);
+
+    //call gate
+    if(dpl < cpu.cpl || dpl < (selector & 3)) fault(EXCEPTION_GP, error_code);
+    if((desc.rights & DESC_P) == 0) fault(EXCEPTION_NP, error_code);
+
+    bool   gate32      = (type & 0x08) != 0;
+    uint32 gate_length = (gate32)? 4 : 2;
+    uint16 target      = low >> 16;
+    uint32 target_eip  = (gate32)? (high & 0xFFFF0000) | (low & 0xFFFF) : (low & 0xFFFF);
+    uint32 parameters  = high & 0x1F;
+
+    if((target & 0xFFFC) == 0) fault(EXCEPTION_GP, 0);
+
+    ref486_seg_t cs = read_descriptor(cpu, target, EXCEPTION_GP);
+    uint32 cs_error = target & 0xFFFC;
+    uint32 cs_dpl   = dpl_of(cs.rights);
+
+    if((cs.rights & (DESC_S | DESC_CODE)) != (DESC_S | DESC_CODE) || cs_dpl > cpu.cpl) fault(EXCEPTION_GP, cs_error);
+    if(call == false && (cs.rights & DESC_CONFORMING) == 0 && cs_dpl != cpu.cpl)    fault(EXCEPTION_GP, cs_error);
+    if((cs.rights & DESC_P) == 0) fault(EXCEPTION_NP, cs_error);
+
+    if(call && (cs.rights & DESC_CONFORMING) == 0 && cs_dpl < cpu.cpl) {
+        uint16 ss_selector;
+        uint32 esp;
+        tss_stack(cpu, cs_dpl, ss_selector, esp);
+
+        ref486_seg_t ss = inner_stack(cpu, ss_selector, cs_dpl);
+        uint32 ss_error = ss_selector & 0xFFFC;
+
+        push_on(cpu, ss, esp, gate_length, cpu.seg[REF486_SS].selector, false, ss_error);
+        push_on(cpu, ss, esp, gate_length, cpu.regs[REF486_ESP],        false, ss_error);
+        for(uint32 i=parameters; i>0; i--) {
+            uint32 value = stack_read(cpu, (i - 1) * gate_length, gate_length);
+            push_on(cpu, ss, esp, gate_length, value, false, ss_error);
+        }
+        push_on(cpu, ss, esp, gate_length, cpu.seg[REF486_CS].selector, false, ss_error);
+        push_on(cpu, ss, esp, gate_length, next_eip,                    false, ss_error);
+
+        if(target_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        ss.selector = (ss.selector & 0xFFFC) | cs_dpl;
+        cpu.seg[REF486_SS] = ss;
+        set_esp(cpu, ss, esp);
+        set_cs(cpu, cs, cs_dpl);
+    }
+    else {
+        if(call) {
+            uint32 esp  = cpu.regs[REF486_ESP];
+            bool   user = cpu.cpl == 3;
+            push_on(cpu, cpu.seg[REF486_SS], esp, gate_length, cpu.seg[REF486_CS].selector, user, 0);
+            push_on(cpu, cpu.seg[REF486_SS], esp, gate_length, next_eip,                    user, 0);
+            if(target_eip > cs.limit) fault(EXCEPTION_GP, 0);
+            cpu.regs[REF486_ESP] = esp;
+        }
+        else if(target_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, cs, cpu.cpl);
+    }
+    cpu.eip = target_eip;
+}
+
+//code segment of a far return or iret to level 'rpl' of its selector
+static ref486_seg_t return_code_segment(ref486_t &cpu, uint16 selector) {
+    if((selector & 0xFFFC) == 0) fault(EXCEPTION_GP, 0);
+
+    ref486_seg_t cs = read_descriptor(cpu, selector, EXCEPTION_GP);
+    uint32 error_code = selector & 0xFFFC;
+    uint32 rpl        = selector & 3;
+    uint32 dpl        = dpl_of(cs.rights);
+
+    if(rpl < cpu.cpl) fault(EXCEPTION_GP, error_code);
+    if((cs.rights & (DESC_S | DESC_CODE)) != (DESC_S | DESC_CODE)) fault(EXCEPTION_GP, error_code);
+
+    if(cs.rights & DESC_CONFORMING) {
+        if(dpl > rpl) fault(EXCEPTION_GP, error_code);
+    }
+    else {
+        if(dpl != rpl) fault(EXCEPTION_GP, error_code);
+    }
+    if((cs.rights & DESC_P) == 0) fault(EXCEPTION_NP, error_code);
+    return cs;
+}
+
+static void far_return(ref486_t &cpu, uint32 length, uint32 release) {
+    uint32 new_eip = pop(cpu, length);
+    uint16 new_cs  = pop(cpu, length);
+
+    if(protected_mode(cpu) == false) {
+        if(length == 2) new_eip &= 0xFFFF;
+        if(v86_mode(cpu) && new_eip > 0xFFFF) fault(EXCEPTION_GP, 0);
+
+        set_cs_real(cpu, new_cs);
+        cpu.eip = new_eip;
+        stack_add(cpu, release);
+        return;
+    }
+
+    if(length == 2) new_eip &= 0xFFFF;
+
+    ref486_seg_t cs = return_code_segment(cpu, new_cs);
+    uint32 rpl = new_cs & 3;
+
+    if(rpl > cpu.cpl) {
+        stack_add(cpu, release);
+
+        uint32 new_esp = pop(cpu, length);
+        uint16 new_ss  = pop(cpu, length);
+
+        ref486_seg_t ss = outer_stack(cpu, new_ss, rpl);
+        if(new_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, cs, rpl);
+        cpu.seg[REF486_SS] = ss;
+        set_esp(cpu, ss, new_esp);
+        stack_add(cpu, release);
+
+        invalidate_segments(cpu);
+    }
+    else {
+        if(new_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, cs, cpu.cpl);
+        stack_add(cpu, release);
+    }
+    cpu.eip = new_eip;
+}
+
+//flags an iret or popf may change, by level and operand size
+static uint32 flags_writable(const ref486_t &cpu, uint32 length) {
+    uint32 mask = FLAG_CF | FLAG_PF | FLAG_AF | FLAG_ZF | FLAG_SF | FLAG_TF | FLAG_DF | FLAG_OF | FLAG_NT;
+
+    if(length == 4)                 mask |= FLAG_AC | FLAG_ID;
+    if(cpu.cpl == 0 && v86_mode(cpu) == false) mask |= FLAG_IOPL;
+    if(cpu.cpl <= iopl(cpu))        mask |= FLAG_IF;
+
+    return mask;
+}
+
+static void interrupt_return(ref486_t &cpu, uint32 length) {
+    if(real_mode(cpu) || v86_mode(cpu)) {
+        if(v86_mode(cpu) && iopl(cpu) < 3) fault(EXCEPTION_GP, 0);
+
+        uint32 new_eip   = pop(cpu, length);
+        uint16 new_cs    = pop(cpu, length);
+        uint32 new_flags = pop(cpu, length);
+
+        if(length == 2) new_eip &= 0xFFFF;
+        if(v86_mode(cpu) && new_eip > 0xFFFF) fault(EXCEPTION_GP, 0);
+
+        uint32 mask = flags_writable(cpu, length) | ((length == 4)? FLAG_RF : 0);
+        cpu.eflags = ((cpu.eflags & ~mask) | (new_flags & mask)) | 2;
+
+        set_cs_real(cpu, new_cs);
+        cpu.eip = new_eip;
+        return;
+    }
+
+    if(cpu.eflags & FLAG_NT) unsupported("task return through iret");
+
+    uint32 new_eip   = pop(cpu, length);
+    uint16 new_cs    = pop(cpu, length);
+    uint32 new_flags = pop(cpu, length);
+
+    //back to virtual 8086 mode
+    if(length == 4 && (new_flags & FLAG_VM) && cpu.cpl == 0) {
+        uint32 new_esp = pop(cpu, 4);
+        uint16 new_ss  = pop(cpu, 4);
+        uint16 new_es  = pop(cpu, 4);
+        uint16 new_ds  = pop(cpu, 4);
+        uint16 new_fs  = pop(cpu, 4);
+        uint16 new_gs  = pop(cpu, 4);
+
+        cpu.eflags = (new_flags & 0x003F7FD5) | 2;
+
+        load_segment_real(cpu, REF486_ES, new_es);
+        load_segment_real(cpu, REF486_DS, new_ds);
+        load_segment_real(cpu, REF486_FS, new_fs);
+        load_segment_real(cpu, REF486_GS, new_gs);
+        load_segment_real(cpu, REF486_SS, new_ss);
+        set_cs_real(cpu, new_cs);
+
+        cpu.regs[REF486_ESP] = new_esp;
+        cpu.eip = new_eip & 0xFFFF;
+        return;
+    }
+
+    if(length == 2) new_eip &= 0xFFFF;
+
+    ref486_seg_t cs = return_code_segment(cpu, new_cs);
+    uint32 rpl  = new_cs & 3;
+    uint32 mask = flags_writable(cpu, length) | ((length == 4)? FLAG_RF : 0);
+
+    if(rpl > cpu.cpl) {
+        uint32 new_esp = pop(cpu, length);
+        uint16 new_ss  = pop(cpu, length);
+
+        ref486_seg_t ss = outer_stack(cpu, new_ss, rpl);
+        if(new_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, cs, rpl);
+        cpu.seg[REF486_SS] = ss;
+        set_esp(cpu, ss, new_esp);
+
+        invalidate_segments(cpu);
+    }
+    else {
+        if(new_eip > cs.limit) fault(EXCEPTION_GP, 0);
+
+        set_cs(cpu, cs, cpu.cpl);
+    }
+
+    cpu.eflags = ((cpu.eflags & ~mask) | (new_flags & mask)) | 2;
+    cpu.eip = new_eip;
+}
+
+//------------------------------------------------------------------------------ flags
+
+static inline uint32 size_mask(uint32 length) {
+    return (length == 4)? 0xFFFFFFFF : (1u << (length * 8)) - 1;
+}
+
+static inline uint32 sign_bit(uint32 length) {
+    return 1u << (length * 8 - 1);
+}
+
+static inline uint32 sign_extend(uint32 value, uint32 length) {
+    if(length == 1) return (uint32)(int32_t)(int8_t)value;
+    if(length == 2) return (uint32)(int32_t)(int16_t)value;
+    return value;
+}
+
+static inline uint32 flags_szp(uint32 result, uint32 length) {
+    uint32 flags = 0;
+
+    result &= size_mask(length);
+    if(result == 0)                         flags |= FLAG_ZF;
+    if(result & sign_bit(length))           flags |= FLAG_SF;
+    if(__builtin_parity(result & 0xFF) == 0) flags |= FLAG_PF;
+    return flags;
+}
+
+static inline void set_flags(ref486_t &cpu, uint32 mask, uint32 flags) {
+    cpu.eflags = (cpu.eflags & ~mask) | (flags & mask);
+}
+
+enum alu_op_t {
+    ALU_ADD = 0,
+    ALU_OR  = 1,
+    ALU_ADC = 2,
+    ALU_SBB = 3,
+    ALU_AND = 4,
+    ALU_SUB = 5,
+    ALU_XOR = 6,
+    ALU_CMP = 7
+};
+
+static uint32 alu(ref486_t &cpu, uint32 op, uint32 a, uint32 b, uint32 length) {
+    uint32 mask  = size_mask(length);
+    uint32 sign  = sign_bit(length);
+    uint32 carry = cpu.eflags & FLAG_CF;
+    uint32 result;
+    uint32 flags = 0;
+
+    a &= mask;
+    b &= mask;
+
+    if(op == ALU_ADD || op == ALU_ADC) {
+        uint64 sum = (uint64)a + b + ((op == ALU_ADC)? carry : 0);
+        result = sum & mask;
+
+        if(sum > mask)                       flags |= FLAG_CF;
+        if((a ^ result) & (b ^ result) & sign) flags |= FLAG_OF;
+        if((a ^ b ^ result) & 0x10)          flags |= FLAG_AF;
+    }
+    else if(op == ALU_SUB || op == ALU_SBB || op == ALU_CMP) {
+        uint64 subtrahend = (uint64)b + ((op == ALU_SBB)? carry : 0);
+        result = (uint32)(a - subtrahend) & mask;
+
+        if((uint64)a < subtrahend)           flags |= FLAG_CF;
+        if((a ^ b) & (a ^ result) & sign)    flags |= FLAG_OF;
+        if((a ^ b ^ result) & 0x10)          flags |= FLAG_AF;
+    }
+    else {
+        //logic: CF, OF and AF cleared, as ao486 does
+        result = (op == ALU_OR)? (a | b) : (op == ALU_AND)? (a & b) : (a ^ b);
+    }
+
+    set_flags(cpu, FLAGS_ARITH, flags | flags_szp(result, length));
+    return result;
+}
+
+//inc and dec keep CF
+static uint32 inc_dec(ref486_t &cpu, bool dec, uint32 value, uint32 length) {
+    uint32 carry  = cpu.eflags & FLAG_CF;
+    uint32 result = alu(cpu, (dec)? ALU_SUB : ALU_ADD, value, 1, length);
+    cpu.eflags = (cpu.eflags & ~FLAG_CF) | carry;
+    return result;
+}
+
+static bool condition(const ref486_t &cpu, uint32 code) {
+    uint32 f = cpu.eflags;
+    bool   value;
+
+    switch(code >> 1) {
+        case 0:  value = (f & FLAG_OF) != 0;                                  break;
+        case 1:  value = (f & FLAG_CF) != 0;                                  break;
+        case 2:  value = (f & FLAG_ZF) != 0;                                  break;
+        case 3:  value = (f & (FLAG_CF | FLAG_ZF)) != 0;                      break;
+        case 4:  value = (f & FLAG_SF) != 0;                                  break;
+        case 5:  value = (f & FLAG_PF) != 0;                                  break;
+        case 6:  value = ((f & FLAG_SF) != 0) != ((f & FLAG_OF) != 0);        break;
+        default: value = (f & FLAG_ZF) || ((f & FLAG_SF) != 0) != ((f & FLAG_OF) != 0); break;
+    }
+    return (code & 1)? !value : value;
+}
+
+//------------------------------------------------------------------------------ shifts
+
+/* Returns false when ao486 leaves the destination unwritten: a zero count,
+ * and rotates by a multiple of the operand width. CF and OF follow the
+ * e_shift_* logic of execute_shift.v for every count, AF is taken like its
+ * aflag_arith.
+ */
+static bool shift(ref486_t &cpu, uint32 op, uint32 &value, uint32 count, uint32 length) {
+    uint32 bits  = length * 8;
+    uint32 mask  = size_mask(length);
+    uint32 sign  = sign_bit(length);
+    uint32 v     = value & mask;
+    uint32 carry = cpu.eflags & FLAG_CF;
+
+    count &= 31;
+
+    uint32 result;
+    uint32 cf;
+    uint32 of;
+
+    if(op == 0 || op == 1) {
+        uint32 n = count % bits;
+        if(count == 0) return false;
+
+        if(op == 0) {
+            result = (n == 0)? v : ((v << n) | (v >> (bits - n))) & mask;
+            cf = result & 1;
+            of = ((result & sign) != 0) ^ cf;
+        }
+        else {
+            result = (n == 0)? v : ((v >> n) | (v << (bits - n))) & mask;
+            cf = (result & sign) != 0;
+            of = cf ^ ((result >> (bits - 2)) & 1);
+        }
+        set_flags(cpu, FLAG_CF | FLAG_OF, (cf? FLAG_CF : 0) | (of? FLAG_OF : 0));
+
+        value = result;
+        return n != 0;
+    }
+
+    if(op == 2 || op == 3) {
+        uint32 n = (length == 4)? count : count % (bits + 1);
+        if(n == 0) return false;
+
+        uint64 wide_mask = (1ull << (bits + 1)) - 1;
+        uint64 wide      = ((uint64)carry << bits) | v;
+
+        if(op == 2) wide = ((wide << n) | (wide >> (bits + 1 - n))) & wide_mask;
+        else        wide = ((wide >> n) | (wide << (bits + 1 - n))) & wide_mask;
+
+        result = wide & mask;
+        cf     = (wide >> bits) & 1;
+        of     = (op == 2)? ((result & sign) != 0) ^ cf : ((result >> (bits - 1)) ^ (result >> (bits - 2))) & 1;
+
+        set_flags(cpu, FLAG_CF | FLAG_OF, (cf? FLAG_CF : 0) | (of? FLAG_OF : 0));
+
+        value = result;
+        return true;
+    }
+
+    if(count == 0) return false;
+
+    if(op == 4 || op == 6) {
+        result = (count < 32)? (v << count) & mask : 0;
+        cf     = (count <= bits)? (v >> (bits - count)) & 1 : 0;
+        of     = ((result & sign) != 0) ^ cf;
+    }
+    else if(op == 5) {
+        result = (count < 32)? v >> count : 0;
+        cf     = (count <= bits)? (v >> (count - 1)) & 1 : 0;
+        of     = ((result >> (bits - 1)) ^ (result >> (bits - 2))) & 1;
+    }
+    else {
+        int32_t signed_value = (int32_t)sign_extend(v, length);
+        result = (uint32)(signed_value >> ((count < bits)? count : 31)) & mask;
+        cf     = (count <= bits)? (signed_value >> (count - 1)) & 1 : (signed_value < 0);
+        of     = 0;
+    }
+
+    uint32 flags = flags_szp(result, length) | (cf? FLAG_CF : 0) | (of? FLAG_OF : 0) | ((count ^ v ^ result) & FLAG_AF);
+    set_flags(cpu, FLAGS_ARITH, flags);
+
+    value = result;
+    return true;
+}
+
+//shld and shrd; 16 bit operands shift dst:src:dst as one 48 bit value
+static bool shift_double(ref486_t &cpu, bool left, uint32 &value, uint32 source, uint32 count, uint32 length) {
+    uint32 bits = length * 8;
+    uint32 mask = size_mask(length);
+    uint32 sign = sign_bit(length);
+    uint32 v    = value & mask;
+
+    count &= 31;
+    if(count == 0) return false;
+
+    uint32 result;
+    uint32 cf;
+
+    if(length == 4) {
+        if(left) {
+            result = (v << count) | (source >> (32 - count));
+            cf     = (v >> (32 - count)) & 1;
+        }
+        else {
+            result = (v >> count) | (source << (32 - count));
+            cf     = (v >> (count - 1)) & 1;
+        }
+    }
+    else {
+        uint64 wide = ((uint64)v << 32) | ((uint64)(source & 0xFFFF) << 16) | v;
+
+        if(left) {
+            result = (wide << count) >> 32 & 0xFFFF;
+            cf     = (wide << (count - 1)) >> 47 & 1;
+        }
+        else {
+            result = (wide >> count) & 0xFFFF;
+            cf     = (count >= 17)? 0 : (wide >> (count - 1)) & 1;
+        }
+    }
+    result &= mask;
+
+    uint32 of = (left)? ((result & sign) != 0) ^ cf : ((result >> (bits - 1)) ^ (result >> (bits - 2))) & 1;
+
+    uint32 flags = flags_szp(result, length) | (cf? FLAG_CF : 0) | (of? FLAG_OF : 0) | ((count ^ v ^ result) & FLAG_AF);
+    set_flags(cpu, FLAGS_ARITH, flags);
+
+    value = result;
+    return true;
+}
+
+//------------------------------------------------------------------------------ decode
+
+struct instr_t {
+    uint32 start;
+    uint32 next;
+    int    seg;         //override, -1 when none
+    bool   os32;
+    bool   as32;
+    uint32 rep;         //0, 0xF2 or 0xF3
+    bool   jumped;      //eip already set
+
+    uint32 modrm_at;
+    uint32 mod;
+    uint32 reg;
+    uint32 rm;
+    uint32 ea;
+    uint32 ea_seg;
+};
+
+static uint8 fetch8(ref486_t &cpu, instr_t &in) {
+    if(in.next - in.start >= 15) fault(EXCEPTION_GP, 0);
+
+    const ref486_seg_t &cs = cpu.seg[REF486_CS];
+    if(in.next > cs.limit) fault(EXCEPTION_GP, 0);
+
+    uint32 value = linear_read(cpu, cs.base + in.next, 1, false, cpu.cpl == 3);
+    in.next++;
+    return value;
+}
+
+static uint32 fetch16(ref486_t &cpu, instr_t &in) {
+    uint32 value = fetch8(cpu, in);
+    return value | (fetch8(cpu, in) << 8);
+}
+
+static uint32 fetch32(ref486_t &cpu, instr_t &in) {
+    uint32 value = fetch16(cpu, in);
+    return value | (fetch16(cpu, in) << 16);
+}
+
+static uint32 fetch_imm(ref486_t &cpu, instr_t &in, uint32 length) {
+    if(length == 1) return fetch8(cpu, in);
+    if(length == 2) return fetch16(cpu, in);
+    return fetch32(cpu, in);
+}
+
+static inline uint32 data_seg(const instr_t &in) {
+    return (in.seg >= 0)? in.seg : REF486_DS;
+}
+
+static void decode_modrm(ref486_t &cpu, instr_t &in) {
+    in.modrm_at = in.next;
+
+    uint8 modrm = fetch8(cpu, in);
+    in.mod = modrm >> 6;
+    in.reg = (modrm >> 3) & 7;
+    in.rm  = modrm & 7;
+
+    if(in.mod == 3) return;
+
+    uint32 *r   = cpu.regs;
+    uint32  seg = REF486_DS;
+    uint32  ea  = 0;
+
+    if(in.as32 == false) {
+        switch(in.rm) {
+            case 0: ea = (r[REF486_EBX] & 0xFFFF) + (r[REF486_ESI] & 0xFFFF);                  break;
+            case 1: ea = (r[REF486_EBX] & 0xFFFF) + (r[REF486_EDI] & 0xFFFF);                  break;
+            case 2: ea = (r[REF486_EBP] & 0xFFFF) + (r[REF486_ESI] & 0xFFFF); seg = REF486_SS; break;
+            case 3: ea = (r[REF486_EBP] & 0xFFFF) + (r[REF486_EDI] & 0xFFFF); seg = REF486_SS; break;
+            case 4: ea = r[REF486_ESI];                                       break;
+            case 5: ea = r[REF486_EDI];                                       break;
+            case 6:
+                if(in.mod == 0) ea = fetch16(cpu, in);
+                else {          ea = r[REF486_EBP]; seg = REF486_SS; }
+                break;
+            default: ea = r[REF486_EBX];                                      break;
+        }
+
+        if(in.mod == 1)      ea += sign_extend(fetch8(cpu, in), 1);
+        else if(in.mod == 2) ea += fetch16(cpu, in);
+        ea &= 0xFFFF;
+    }
+    else {
+        if(in.rm == 4) {
+            uint8  sib   = fetch8(cpu, in);
+            uint32 index = (sib >> 3) & 7;
+            uint32 base  = sib & 7;
+
+            if(index != 4) ea = r[index] << (sib >> 6);
+
+            if(base == 5 && in.mod == 0) ea += fetch32(cpu, in);
+            else {
+                ea += r[base];
+                if(base == REF486_ESP || base == REF486_EBP) seg = REF486_SS;
+            }
+        }
+        else if(in.rm == 5 && in.mod == 0) {
+            ea = fetch32(cpu, in);
+        }
+        else {
+            ea = r[in.rm];
+            if(in.rm == REF486_EBP) seg = REF486_SS;
+        }
+
+        if(in.mod == 1)      ea += sign_extend(fetch8(cpu, in), 1);
+        else if(in.mod == 2) ea += fetch32(cpu, in);
+    }
+
+    in.ea     = ea;
+    in.ea_seg = (in.seg >= 0)? (uint32)in.seg : seg;
+}
+
+//------------------------------------------------------------------------------ operands
+
+static inline uint32 get_reg(const ref486_t &cpu, uint32 index, uint32 length) {
+    if(length == 1) return (index < 4)? (cpu.regs[index] & 0xFF) : ((cpu.regs[index - 4] >> 8) & 0xFF);
+    if(length == 2) return cpu.regs[index] & 0xFFFF;
+    return cpu.regs[index];
+}
+
+static inline void set_reg(ref486_t &cpu, uint32 index, uint32 length, uint32 value) {
+    if(length == 1) {
+        if(index < 4) cpu.regs[index]     = (cpu.regs[index]     & 0xFFFFFF00) | (value & 0xFF);
+        else          cpu.regs[index - 4] = (cpu.regs[index - 4] & 0xFFFF00FF) | ((value & 0xFF) << 8);
+    }
+    else if(length == 2) cpu.regs[index] = (cpu.regs[index] & 0xFFFF0000) | (value & 0xFFFF);
+    else                 cpu.regs[index] = value;
+}
+
+static uint32 rm_read(ref486_t &cpu, const instr_t &in, uint32 length) {
+    if(in.mod == 3) return get_reg(cpu, in.rm, length);
+    return read_mem(cpu, in.ea_seg, in.ea, length);
+}
+
+static uint32 rm_read_rmw(ref486_t &cpu, const instr_t &in, uint32 length) {
+    if(in.mod == 3) return get_reg(cpu, in.rm, length);
+    return read_mem_rmw(cpu, in.ea_seg, in.ea, length);
+}
+
+static void rm_write(ref486_t &cpu, const instr_t &in, uint32 length, uint32 value) {
+    if(in.mod == 3) set_reg(cpu, in.rm, length, value);
+    else            write_mem(cpu, in.ea_seg, in.ea, length, value);
+}
+
+static inline uint32 offset_mask(const instr_t &in) {
+    return (in.as32)? 0xFFFFFFFF : 0xFFFF;
+}
+
+//memory operand only: lea, far pointers, bound, descriptor tables
+static void require_memory(const instr_t &in) {
+    if(in.mod == 3) fault(EXCEPTION_UD, 0);
+}
+
+static void jump_near(ref486_t &cpu, instr_t &in, uint32 target) {
+    if(in.os32 == false) target &= 0xFFFF;
+    if(target > cpu.seg[REF486_CS].limit) fault(EXCEPTION_GP, 0);
+
+    cpu.eip   = target;
+    in.jumped = true;
+}
+
+static inline uint32 next_eip(const ref486_t &cpu, const instr_t &in) {
+    return (cpu.seg[REF486_CS].flags & DESC_D_B)? in.next : (in.next & 0xFFFF);
+}
+
+static void require_cpl0(const ref486_t &cpu) {
+    if(cpu.cpl != 0) fault(EXCEPTION_GP, 0);
+}
+
+//int n, int3, into
+static void software_interrupt(ref486_t &cpu, instr_t &in, uint8 vector) {
+    if(v86_mode(cpu) && iopl(cpu) < 3) fault(EXCEPTION_GP, 0);
+
+    cpu.eip = next_eip(cpu, in);
+    deliver(cpu, vector, false, 0, true);
+    in.jumped = true;
+}
+
+//------------------------------------------------------------------------------ multiply and divide
+
+//mul, imul: CF = OF = upper half significant, AF cleared, SZP of the low half
+static void multiply_flags(ref486_t &cpu, uint32 low, bool overflow, uint32 length) {
+    uint32 flags = flags_szp(low, length) | ((overflow)? FLAG_CF | FLAG_OF : 0);
+    set_flags(cpu, FLAGS_ARITH, flags);
+}
+
+//one operand mul and imul into AX, DX:AX or EDX:EAX
+static void multiply(ref486_t &cpu, bool is_signed, uint32 source, uint32 length) {
+    uint32 mask = size_mask(length);
+    uint32 bits = length * 8;
+    uint64 product;
+    bool   overflow;
+
+    if(is_signed) {
+        int64_t result = (int64_t)(int32_t)sign_extend(get_reg(cpu, REF486_EAX, length), length) * (int32_t)sign_extend(source, length);
+        product  = (uint64)result;
+        overflow = result != (int64_t)(int32_t)sign_extend((uint32)result & mask, length);
+    }
+    else {
+        product  = (uint64)get_reg(cpu, REF486_EAX, length) * (source & mask);
+        overflow = (product >> bits) != 0;
+    }
+
+    if(length == 1) {
+        set_reg(cpu, REF486_EAX, 2, product);
+    }
+    else {
+        set_reg(cpu, REF486_EAX, length, product);
+        set_reg(cpu, REF486_EDX, length, product >> bits);
+    }
+    multiply_flags(cpu, product, overflow, length);
+}
+
+//two and three operand imul
+static uint32 multiply_signed(ref486_t &cpu, uint32 a, uint32 b, uint32 length) {
+    int64_t  result = (int64_t)(int32_t)sign_extend(a, length) * (int32_t)sign_extend(b, length);
+    uint32 low    = (uint32)result & size_mask(length);
+
+    multiply_flags(cpu, low, result != (int64_t)(int32_t)sign_extend(low, length), length);
+    return low;
+}
+
+//div, idiv: flags are left as they are
+static void divide(ref486_t &cpu, bool is_signed, uint32 source, uint32 length) {
+    uint32 mask = size_mask(length);
+    uint32 bits = length * 8;
+
+    uint64 dividend = (length == 1)? get_reg(cpu, REF486_EAX, 2) : ((uint64)get_reg(cpu, REF486_EDX, length) << bits) | get_reg(cpu, REF486_EAX, length);
+    source &= mask;
+
+    if(source == 0) fault(EXCEPTION_DE, 0);
+
+    uint32 quotient, remainder;
+
+    if(is_signed) {
+        int64_t signed_dividend = (int64_t)(dividend << (64 - 2 * bits)) >> (64 - 2 * bits);
+        int64_t divisor         = (int32_t)sign_extend(source, length);
+
+        if(signed_dividend == INT64_MIN && divisor == -1) fault(EXCEPTION_DE, 0);
+
+        int64_t q = signed_dividend / divisor;
+        int64_t r = signed_dividend % divisor;
+
+        if(q != (int64_t)(int32_t)sign_extend((uint32)q & mask, length)) fault(EXCEPTION_DE, 0);
+        quotient  = (uint32)q & mask;
+        remainder = (uint32)r & mask;
+    }
+    else {
+        uint64 q = dividend / source;
+        if(q > mask) fault(EXCEPTION_DE, 0);
+
+        quotient  = q;
+        remainder = dividend % source;
+    }
+
+    if(length == 1) {
+        set_reg(cpu, REF486_EAX, 2, quotient | (remainder << 8));
+    }
+    else {
+        set_reg(cpu, REF486_EAX, length, quotient);
+        set_reg(cpu, REF486_EDX, length, remainder);
+    }
+}
+
+//------------------------------------------------------------------------------ bcd
+
+static void decimal_adjust(ref486_t &cpu, bool subtract) {
+    uint32 al     = get_reg(cpu, REF486_EAX, 1);
+    bool   old_cf = (cpu.eflags & FLAG_CF) != 0;
+    bool   cf     = false;
+    bool   af     = false;
+    uint32 result = al;
+
+    if((al & 0x0F) > 9 || (cpu.eflags & FLAG_AF)) {
+        cf     = old_cf || ((subtract)? al < 6 : al + 6 > 0xFF);
+        result = (subtract)? result - 6 : result + 6;
+        af     = true;
+    }
+    if(al > 0x99 || old_cf) {
+        result = (subtract)? result - 0x60 : result + 0x60;
+        cf     = true;
+    }
+    else if(subtract == false) {
+        cf = false;
+    }
+
+    set_reg(cpu, REF486_EAX, 1, result);
+    set_flags(cpu, FLAGS_ARITH, flags_szp(result, 1) | ((cf)? FLAG_CF : 0) | ((af)? FLAG_AF : 0));
+}
+
+static void ascii_adjust(ref486_t &cpu, bool subtract) {
+    uint32 ax     = get_reg(cpu, REF486_EAX, 2);
+    bool   adjust = (ax & 0x0F) > 9 || (cpu.eflags & FLAG_AF);
+
+    if(adjust) {
+        if(subtract) ax = (((ax - 6) & 0x00FF) | ((ax - 0x100) & 0xFF00)) & 0xFFFF;
+        else         ax = (ax + 0x106) & 0xFFFF;
+    }
+    ax &= 0xFF0F;
+
+    set_reg(cpu, REF486_EAX, 2, ax);
+    set_flags(cpu, FLAGS_ARITH, flags_szp(ax, 1) | ((adjust)? FLAG_CF | FLAG_AF : 0));
+}
+
+//------------------------------------------------------------------------------ string
+
+//one iteration; a rep prefix with more to do leaves EIP on the instruction
+static void string_op(ref486_t &cpu, instr_t &in, uint8 opcode) {
+    uint32 length = (opcode & 1)? ((in.os32)? 4 : 2) : 1;
+    uint32 amask  = offset_mask(in);
+    uint32 &ecx   = cpu.regs[REF486_ECX];
+
+    if(in.rep && (ecx & amask) == 0) return;
+
+    uint32 delta = (cpu.eflags & FLAG_DF)? (uint32)-length : length;
+    uint32 esi   = cpu.regs[REF486_ESI] & amask;
+    uint32 edi   = cpu.regs[REF486_EDI] & amask;
+    uint32 port  = get_reg(cpu, REF486_EDX, 2);
+    bool   src   = false;
+    bool   dst   = false;
+    bool   test  = false;
+
+    switch(opcode & 0xFE) {
+        case 0xA4: write_mem(cpu, REF486_ES, edi, length, read_mem(cpu, data_seg(in), esi, length)); src = dst = true; break;
+        case 0xA6: {
+            uint32 a = read_mem(cpu, data_seg(in), esi, length);
+            uint32 b = read_mem(cpu, REF486_ES, edi, length);
+            alu(cpu, ALU_CMP, a, b, length);
+            src = dst = test = true;
+            break;
+        }
+        case 0xAA: write_mem(cpu, REF486_ES, edi, length, get_reg(cpu, REF486_EAX, length)); dst = true; break;
+        case 0xAC: set_reg(cpu, REF486_EAX, length, read_mem(cpu, data_seg(in), esi, length)); src = true; break;
+        case 0xAE: alu(cpu, ALU_CMP, get_reg(cpu, REF486_EAX, length), read_mem(cpu, REF486_ES, edi, length), length); dst = test = true; break;
+        case 0x6C:
+            io_allowed(cpu, port, length);
+            segment_check(cpu, REF486_ES, edi, length, true);
+            write_mem(cpu, REF486_ES, edi, length, io_read(cpu, port, length));
+            dst = true;
+            break;
+        default:
+            io_allowed(cpu, port, length);
+            io_write(cpu, port, length, read_mem(cpu, data_seg(in), esi, length));
+            src = true;
+            break;
+    }
+
+    if(src) cpu.regs[REF486_ESI] = (cpu.regs[REF486_ESI] & ~amask) | ((esi + delta) & amask);
+    if(dst) cpu.regs[REF486_EDI] = (cpu.regs[REF486_EDI] & ~amask) | ((edi + delta) & amask);
+
+    if(in.rep == 0) return;
+
+    ecx = (ecx & ~amask) | ((ecx - 1) & amask);
+
+    bool more = (ecx & amask) != 0;
+    if(test && in.rep == 0xF3 && (cpu.eflags & FLAG_ZF) == 0) more = false;
+    if(test && in.rep == 0xF2 && (cpu.eflags & FLAG_ZF) != 0) more = false;
+
+    if(more) {
+        cpu.eip   = in.start;
+        in.jumped = true;
+    }
+}
+
+//------------------------------------------------------------------------------ system
+
+static void write_cr0(ref486_t &cpu, uint32 value) {
+    uint32 old = cpu.cr0;
+
+    if((value & CR0_PG) && (value & CR0_PE) == 0) fault(EXCEPTION_GP, 0);
+    if((value & CR0_NW) && (value & CR0_CD) == 0) fault(EXCEPTION_GP, 0);
+
+    cpu.cr0 = (value & CR0_MASK) | CR0_ET;
+
+    if((old ^ cpu.cr0) & (CR0_PE | CR0_PG | CR0_WP)) tlb_flush(cpu);
+
+    //back to real mode: CS keeps base and limit, its rights become those ao486 gives it (present, type 3)
+    if((old & CR0_PE) && (cpu.cr0 & CR0_PE) == 0) {
+        cpu.seg[REF486_CS].rights = DESC_P | DESC_S | DESC_RW | DESC_ACCESSED;
+        cpu.cpl = 0;
+    }
+}
+
+//descriptor for lar, lsl, verr and verw: false instead of a fault when outside of the table
+static bool descriptor_peek(ref486_t &cpu, uint16 selector, ref486_seg_t &desc) {
+    if((selector & 0xFFFC) == 0) return false;
+
+    uint32 base  = cpu.gdtr_base;
+    uint32 limit = cpu.gdtr_limit;
+
+    if(selector & 4) {
+        if(cpu.seg[REF486_LDTR].valid == false) return false;
+        base  = cpu.seg[REF486_LDTR].base;
+        limit = cpu.seg[REF486_LDTR].limit;
+    }
+    if((uint32)(selector | 7) > limit) return false;
+
+    uint32 address = base + (selector & 0xFFF8);
+    desc = descriptor_cache(selector, system_read(cpu, address, 4), system_read(cpu, address + 4, 4));
+    return true;
+}
+
+//the privilege rule shared by lar, lsl, verr and verw
+static bool descriptor_visible(const ref486_t &cpu, const ref486_seg_t &desc) {
+    bool conforming_code = (desc.rights & (DESC_S | DESC_CODE | DESC_CONFORMING)) == (DESC_S | DESC_CODE | DESC_CONFORMING);
+    if(conforming_code) return true;
+
+    uint32 dpl = dpl_of(desc.rights);
+    return dpl >= cpu.cpl && dpl >= (desc.selector & 3u);
+}
+
+static inline void set_zf(ref486_t &cpu, bool value) {
+    set_flags(cpu, FLAG_ZF, (value)? FLAG_ZF : 0);
+}
+
+//les, lds, lss, lfs, lgs
+static void load_far_pointer(ref486_t &cpu, const instr_t &in, uint32 s) {
+    require_memory(in);
+
+    uint32 length   = (in.os32)? 4 : 2;
+    uint32 offset   = read_mem(cpu, in.ea_seg, in.ea, length);
+    uint16 selector = read_mem(cpu, in.ea_seg, (in.ea + length) & offset_mask(in), 2);
+
+    load_segment(cpu, s, selector);
+    set_reg(cpu, in.reg, length, offset);
+    if(s == REF486_SS) cpu.inhibit_interrupts = true;
+}
+
+//pop es, ss, ds, fs, gs: the stack moves only once the load succeeded
+static void pop_segment(ref486_t &cpu, uint32 s, uint32 length) {
+    uint16 selector = stack_read(cpu, 0, length);
+
+    load_segment(cpu, s, selector);
+    stack_add(cpu, length);
+    if(s == REF486_SS) cpu.inhibit_interrupts = true;
+}
+
+//------------------------------------------------------------------------------ one byte opcodes
+
+static void execute_group1(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize) {
+    uint32 length = (opcode == 0x81 || opcode == 0x83)? osize : 1;
+
+    decode_modrm(cpu, in);
+
+    uint32 imm = (opcode == 0x81)? fetch_imm(cpu, in, osize) : fetch8(cpu, in);
+    if(opcode == 0x83) imm = sign_extend(imm, 1);
+
+    if(in.reg == ALU_CMP) {
+        alu(cpu, ALU_CMP, rm_read(cpu, in, length), imm, length);
+        return;
+    }
+    uint32 result = alu(cpu, in.reg, rm_read_rmw(cpu, in, length), imm, length);
+    rm_write(cpu, in, length, result);
+}
+
+static void execute_group2(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize) {
+    uint32 length = (opcode & 1)? osize : 1;
+
+    decode_modrm(cpu, in);
+
+    uint32 count;
+    if(opcode == 0xC0 || opcode == 0xC1)      count = fetch8(cpu, in);
+    else if(opcode == 0xD0 || opcode == 0xD1) count = 1;
+    else                                      count = get_reg(cpu, REF486_ECX, 1);
+
+    uint32 value = rm_read_rmw(cpu, in, length);
+    if(shift(cpu, in.reg, value, count, length)) rm_write(cpu, in, length, value);
+}
+
+static void execute_group3(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize) {
+    uint32 length = (opcode & 1)? osize : 1;
+
+    decode_modrm(cpu, in);
+
+    switch(in.reg) {
+        case 0:
+        case 1: {
+            uint32 imm = fetch_imm(cpu, in, length);
+            alu(cpu, ALU_AND, rm_read(cpu, in, length), imm, length);
+            break;
+        }
+        case 2: rm_write(cpu, in, length, ~rm_read_rmw(cpu, in, length)); break;
+        case 3: {
+            uint32 value  = rm_read_rmw(cpu, in, length);
+            uint32 result = alu(cpu, ALU_SUB, 0, value, length);
+            rm_write(cpu, in, length, result);
+            break;
+        }
+        case 4: multiply(cpu, false, rm_read(cpu, in, length), length); break;
+        case 5: multiply(cpu, true,  rm_read(cpu, in, length), length); break;
+        case 6: divide(cpu, false, rm_read(cpu, in, length), length);   break;
+        default: divide(cpu, true, rm_read(cpu, in, length), length);   break;
+    }
+}
+
+static void execute_group5(ref486_t &cpu, instr_t &in, uint32 osize) {
+    decode_modrm(cpu, in);
+
+    switch(in.reg) {
+        case 0:
+        case 1: rm_write(cpu, in, osize, inc_dec(cpu, in.reg == 1, rm_read_rmw(cpu, in, osize), osize)); break;
+        case 2: {
+            uint32 target = rm_read(cpu, in, osize);
+            push(cpu, osize, next_eip(cpu, in));
+            jump_near(cpu, in, target);
+            break;
+        }
+        case 4: jump_near(cpu, in, rm_read(cpu, in, osize)); break;
+        case 3:
+        case 5: {
+            require_memory(in);
+            uint32 offset   = read_mem(cpu, in.ea_seg, in.ea, osize);
+            uint16 selector = read_mem(cpu, in.ea_seg, (in.ea + osize) & offset_mask(in), 2);
+
+            far_transfer(cpu, selector, offset, osize, in.reg == 3, next_eip(cpu, in));
+            in.jumped = true;
+            break;
+        }
+        case 6: push(cpu, osize, rm_read(cpu, in, osize)); break;
+        default: fault(EXCEPTION_UD, 0);
+    }
+}
+
+static void enter(ref486_t &cpu, instr_t &in, uint32 osize) {
+    uint32 size  = fetch16(cpu, in);
+    uint32 level = fetch8(cpu, in) & 31;
+    uint32 mask  = stack_mask(cpu.seg[REF486_SS]);
+
+    push(cpu, osize, get_reg(cpu, REF486_EBP, osize));
+    uint32 frame = cpu.regs[REF486_ESP];
+
+    if(level > 0) {
+        uint32 ebp = cpu.regs[REF486_EBP];
+        for(uint32 i=1; i<level; i++) {
+            ebp -= osize;
+            push(cpu, osize, read_mem(cpu, REF486_SS, ebp & mask, osize));
+        }
+        push(cpu, osize, frame);
+    }
+
+    set_reg(cpu, REF486_EBP, osize, frame);
+    stack_add(cpu, (uint32)-size);
+}
+
+static void leave(ref486_t &cpu, uint32 osize) {
+    uint32 mask = stack_mask(cpu.seg[REF486_SS]);
+    cpu.regs[REF486_ESP] = (cpu.regs[REF486_ESP] & ~mask) | (cpu.regs[REF486_EBP] & mask);
+
+    set_reg(cpu, REF486_EBP, osize, pop(cpu, osize));
+}
+
+static void loop(ref486_t &cpu, instr_t &in, uint8 opcode) {
+    uint32 rel    = sign_extend(fetch8(cpu, in), 1);
+    uint32 amask  = offset_mask(in);
+    uint32 &ecx   = cpu.regs[REF486_ECX];
+    bool   taken;
+
+    if(opcode == 0xE3) {
+        taken = (ecx & amask) == 0;
+    }
+    else {
+        ecx   = (ecx & ~amask) | ((ecx - 1) & amask);
+        taken = (ecx & amask) != 0;
+
+        if(opcode == 0xE0) taken = taken && (cpu.eflags & FLAG_ZF) == 0;
+        if(opcode == 0xE1) taken = taken && (cpu.eflags & FLAG_ZF) != 0;
+    }
+    if(taken) jump_near(cpu, in, in.next + rel);
+}
+
+static void execute_0f(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize);
+
+static void execute_one(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize) {
+
+    //add, or, adc, sbb, and, sub, xor, cmp
+    if(opcode < 0x40 && (opcode & 7) < 6) {
+        uint32 op     = opcode >> 3;
+        uint32 length = (opcode & 1)? osize : 1;
+
+        if((opcode & 7) < 2) {
+            decode_modrm(cpu, in);
+            uint32 src = get_reg(cpu, in.reg, length);
+
+            if(op == ALU_CMP) alu(cpu, op, rm_read(cpu, in, length), src, length);
+            else              rm_write(cpu, in, length, alu(cpu, op, rm_read_rmw(cpu, in, length), src, length));
+        }
+        else if((opcode & 7) < 4) {
+            decode_modrm(cpu, in);
+            uint32 result = alu(cpu, op, get_reg(cpu, in.reg, length), rm_read(cpu, in, length), length);
+            if(op != ALU_CMP) set_reg(cpu, in.reg, length, result);
+        }
+        else {
+            uint32 imm    = fetch_imm(cpu, in, length);
+            uint32 result = alu(cpu, op, get_reg(cpu, REF486_EAX, length), imm, length);
+            if(op != ALU_CMP) set_reg(cpu, REF486_EAX, length, result);
+        }
+        return;
+    }
+
+    if(opcode >= 0x40 && opcode <= 0x4F) {
+        uint32 r = opcode & 7;
+        set_reg(cpu, r, osize, inc_dec(cpu, opcode >= 0x48, get_reg(cpu, r, osize), osize));
+        return;
+    }
+    if(opcode >= 0x50 && opcode <= 0x57) {
+        push(cpu, osize, get_reg(cpu, opcode & 7, osize));
+        return;
+    }
+    if(opcode >= 0x58 && opcode <= 0x5F) {
+        uint32 value = pop(cpu, osize);
+        set_reg(cpu, opcode & 7, osize, value);
+        return;
+    }
+    if(opcode >= 0x70 && opcode <= 0x7F) {
+        uint32 rel = sign_extend(fetch8(cpu, in), 1);
+        if(condition(cpu, opcode & 0x0F)) jump_near(cpu, in, in.next + rel);
+        return;
+    }
+    if(opcode >= 0x91 && opcode <= 0x97) {
+        uint32 r     = opcode & 7;
+        uint32 value = get_reg(cpu, r, osize);
+        set_reg(cpu, r, osize, get_reg(cpu, REF486_EAX, osize));
+        set_reg(cpu, REF486_EAX, osize, value);
+        return;
+    }
+    if(opcode >= 0xB0 && opcode <= 0xB7) {
+        set_reg(cpu, opcode & 7, 1, fetch8(cpu, in));
+        return;
+    }
+    if(opcode >= 0xB8 && opcode <= 0xBF) {
+        set_reg(cpu, opcode & 7, osize, fetch_imm(cpu, in, osize));
+        return;
+    }
+    if(opcode >= 0xD8 && opcode <= 0xDF) {
+        //no fpu: the operand is decoded for the length only
+        decode_modrm(cpu, in);
+        if(cpu.cr0 & (CR0_EM | CR0_TS)) fault(EXCEPTION_NM, 0);
+        return;
+    }
+    if((opcode >= 0xA4 && opcode <= 0xA7) || (opcode >= 0xAA && opcode <= 0xAF) || (opcode >= 0x6C && opcode <= 0x6F)) {
+        string_op(cpu, in, opcode);
+        return;
+    }
+
+    switch(opcode) {
+        case 0x06: push_selector(cpu, osize, cpu.seg[REF486_ES].selector); break;
+        case 0x0E: push_selector(cpu, osize, cpu.seg[REF486_CS].selector); break;
+        case 0x16: push_selector(cpu, osize, cpu.seg[REF486_SS].selector); break;
+        case 0x1E: push_selector(cpu, osize, cpu.seg[REF486_DS].selector); break;
+        case 0x07: pop_segment(cpu, REF486_ES, osize); break;
+        case 0x17: pop_segment(cpu, REF486_SS, osize); break;
+        case 0x1F: pop_segment(cpu, REF486_DS, osize); break;
+
+        case 0x0F: execute_0f(cpu, in, fetch8(cpu, in), osize); break;
+
+        case 0x27: decimal_adjust(cpu, false); break;
+        case 0x2F: decimal_adjust(cpu, true);  break;
+        case 0x37: ascii_adjust(cpu, false);   break;
+        case 0x3F: ascii_adjust(cpu, true);    break;
+
+        case 0x60: {
+            uint32 esp = get_reg(cpu, REF486_ESP, osize);
+            for(uint32 r=0; r<8; r++) push(cpu, osize, (r == REF486_ESP)? esp : get_reg(cpu, r, osize));
+            break;
+        }
+        case 0x61: {
+            uint32 values[8];
+            for(uint32 r=0; r<8; r++) values[r] = stack_read(cpu, (7 - r) * osize, osize);
+            for(uint32 r=0; r<8; r++) if(r != REF486_ESP) set_reg(cpu, r, osize, values[r]);
+            stack_add(cpu, 8 * osize);
+            break;
+        }
+        case 0x62: {
+            decode_modrm(cpu, in);
+            require_memory(in);
+
+            int32_t index = sign_extend(get_reg(cpu, in.reg, osize), osize);
+            int32_t lower = sign_extend(read_mem(cpu, in.ea_seg, in.ea, osize), osize);
+            int32_t upper = sign_extend(read_mem(cpu, in.ea_seg, (in.ea + osize) & offset_mask(in), osize), osize);
+
+            if(index < lower || index > upper) fault(EXCEPTION_BR, 0);
+            break;
+        }
+        case 0x63: {
+            if(protected_mode(cpu) == false) fault(EXCEPTION_UD, 0);
+            decode_modrm(cpu, in);
+
+            uint32 dst = rm_read_rmw(cpu, in, 2);
+            uint32 src = get_reg(cpu, in.reg, 2);
+
+            if((dst & 3) < (src & 3)) {
+                rm_write(cpu, in, 2, (dst & ~3u) | (src & 3));
+                set_zf(cpu, true);
+            }
+            else set_zf(cpu, false);
+            break;
+        }
+        case 0x68: push(cpu, osize, fetch_imm(cpu, in, osize)); break;
+        case 0x6A: push(cpu, osize, sign_extend(fetch8(cpu, in), 1)); break;
+        case 0x69:
+        case 0x6B: {
+            decode_modrm(cpu, in);
+            uint32 imm = (opcode == 0x69)? fetch_imm(cpu, in, osize) : sign_extend(fetch8(cpu, in), 1);
+            set_reg(cpu, in.reg, osize, multiply_signed(cpu, rm_read(cpu, in, osize), imm, osize));
+            break;
+        }
+
+        case 0x80:
+        case 0x81:
+        case 0x82:
+        case 0x83: execute_group1(cpu, in, opcode, osize); break;
+
+        case 0x84:
+        case 0x85: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+            alu(cpu, ALU_AND, rm_read(cpu, in, length), get_reg(cpu, in.reg, length), length);
+            break;
+        }
+        case 0x86:
+        case 0x87: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+
+            uint32 value = rm_read_rmw(cpu, in, length);
+            rm_write(cpu, in, length, get_reg(cpu, in.reg, length));
+            set_reg(cpu, in.reg, length, value);
+            break;
+        }
+        case 0x88:
+        case 0x89: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+            rm_write(cpu, in, length, get_reg(cpu, in.reg, length));
+            break;
+        }
+        case 0x8A:
+        case 0x8B: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+            set_reg(cpu, in.reg, length, rm_read(cpu, in, length));
+            break;
+        }
+        case 0x8C: {
+            decode_modrm(cpu, in);
+            if(in.reg > REF486_GS) fault(EXCEPTION_UD, 0);
+
+            //a register destination takes the operand size, zero extended
+            rm_write(cpu, in, (in.mod == 3)? osize : 2, cpu.seg[in.reg].selector);
+            break;
+        }
+        case 0x8D:
+            decode_modrm(cpu, in);
+            require_memory(in);
+            set_reg(cpu, in.reg, osize, in.ea);
+            break;
+        case 0x8E: {
+            decode_modrm(cpu, in);
+            if(in.reg > REF486_GS || in.reg == REF486_CS) fault(EXCEPTION_UD, 0);
+
+            load_segment(cpu, in.reg, rm_read(cpu, in, 2));
+            if(in.reg == REF486_SS) cpu.inhibit_interrupts = true;
+            break;
+        }
+        case 0x8F: {
+            //the address is computed with ESP after the pop
+            decode_modrm(cpu, in);
+            if(in.reg != 0) fault(EXCEPTION_UD, 0);
+
+            uint32 value = pop(cpu, osize);
+            in.next = in.modrm_at;
+            decode_modrm(cpu, in);
+            rm_write(cpu, in, osize, value);
+            break;
+        }
+        case 0x90: break;
+
+        case 0x98:
+            if(osize == 4) cpu.regs[REF486_EAX] = sign_extend(get_reg(cpu, REF486_EAX, 2), 2);
+            else           set_reg(cpu, REF486_EAX, 2, sign_extend(get_reg(cpu, REF486_EAX, 1), 1));
+            break;
+        case 0x99:
+            set_reg(cpu, REF486_EDX, osize, (get_reg(cpu, REF486_EAX, osize) & sign_bit(osize))? 0xFFFFFFFF : 0);
+            break;
+        case 0x9A: {
+            uint32 offset   = fetch_imm(cpu, in, osize);
+            uint16 selector = fetch16(cpu, in);
+
+            far_transfer(cpu, selector, offset, osize, true, next_eip(cpu, in));
+            in.jumped = true;
+            break;
+        }
+        case 0x9B: break;
+        case 0x9C:
+            if(v86_mode(cpu) && iopl(cpu) < 3) fault(EXCEPTION_GP, 0);
+            push(cpu, osize, cpu.eflags & ~(FLAG_VM | FLAG_RF));
+            break;
+        case 0x9D: {
+            if(v86_mode(cpu) && iopl(cpu) < 3) fault(EXCEPTION_GP, 0);
+
+            uint32 value = pop(cpu, osize);
+            uint32 mask  = flags_writable(cpu, osize);
+            cpu.eflags = (cpu.eflags & ~mask) | (value & mask) | 2;
+            break;
+        }
+        case 0x9E: set_flags(cpu, FLAG_SF | FLAG_ZF | FLAG_AF | FLAG_PF | FLAG_CF, get_reg(cpu, REF486_EAX + 4, 1)); break;
+        case 0x9F: set_reg(cpu, REF486_EAX + 4, 1, cpu.eflags & 0xFF); break;
+
+        case 0xA0:
+        case 0xA1:
+        case 0xA2:
+        case 0xA3: {
+            uint32 length = (opcode & 1)? osize : 1;
+            uint32 offset = fetch_imm(cpu, in, (in.as32)? 4 : 2);
+
+            if(opcode < 0xA2) set_reg(cpu, REF486_EAX, length, read_mem(cpu, data_seg(in), offset, length));
+            else              write_mem(cpu, data_seg(in), offset, length, get_reg(cpu, REF486_EAX, length));
+            break;
+        }
+        case 0xA8:
+        case 0xA9: {
+            uint32 length = (opcode & 1)? osize : 1;
+            alu(cpu, ALU_AND, get_reg(cpu, REF486_EAX, length), fetch_imm(cpu, in, length), length);
+            break;
+        }
+
+        case 0xC0:
+        case 0xC1:
+        case 0xD0:
+        case 0xD1:
+        case 0xD2:
+        case 0xD3: execute_group2(cpu, in, opcode, osize); break;
+
+        case 0xC2:
+        case 0xC3: {
+            uint32 release = (opcode == 0xC2)? fetch16(cpu, in) : 0;
+            jump_near(cpu, in, pop(cpu, osize));
+            stack_add(cpu, release);
+            break;
+        }
+        case 0xC4: decode_modrm(cpu, in); load_far_pointer(cpu, in, REF486_ES); break;
+        case 0xC5: decode_modrm(cpu, in); load_far_pointer(cpu, in, REF486_DS); break;
+        case 0xC6:
+        case 0xC7: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+            if(in.reg != 0) fault(EXCEPTION_UD, 0);
+            rm_write(cpu, in, length, fetch_imm(cpu, in, length));
+            break;
+        }
+        case 0xC8: enter(cpu, in, osize); break;
+        case 0xC9: leave(cpu, osize);     break;
+        case 0xCA:
+        case 0xCB: {
+            uint32 release = (opcode == 0xCA)? fetch16(cpu, in) : 0;
+            far_return(cpu, osize, release);
+            in.jumped = true;
+            break;
+        }
+        case 0xCC: software_interrupt(cpu, in, EXCEPTION_BP); break;
+        case 0xCD: {
+            uint8 vector = fetch8(cpu, in);
+            software_interrupt(cpu, in, vector);
+            break;
+        }
+        case 0xCE: if(cpu.eflags & FLAG_OF) software_interrupt(cpu, in, EXCEPTION_OF); break;
+        case 0xCF:
+            interrupt_return(cpu, osize);
+            in.jumped = true;
+            break;
+
+        case 0xD4: {
+            uint32 base = fetch8(cpu, in);
+            if(base == 0) fault(EXCEPTION_DE, 0);
+
+            uint32 al = get_reg(cpu, REF486_EAX, 1);
+            set_reg(cpu, REF486_EAX, 2, ((al / base) << 8) | (al % base));
+            set_flags(cpu, FLAGS_ARITH, flags_szp(al % base, 1));
+            break;
+        }
+        case 0xD5: {
+            uint32 base = fetch8(cpu, in);
+            uint32 al   = alu(cpu, ALU_ADD, get_reg(cpu, REF486_EAX, 1), get_reg(cpu, REF486_EAX + 4, 1) * base, 1);
+            set_reg(cpu, REF486_EAX, 2, al);
+            break;
+        }
+        case 0xD6: set_reg(cpu, REF486_EAX, 1, (cpu.eflags & FLAG_CF)? 0xFF : 0x00); break;
+        case 0xD7: {
+            uint32 offset = (cpu.regs[REF486_EBX] + get_reg(cpu, REF486_EAX, 1)) & offset_mask(in);
+            set_reg(cpu, REF486_EAX, 1, read_mem(cpu, data_seg(in), offset, 1));
+            break;
+        }
+
+        case 0xE0:
+        case 0xE1:
+        case 0xE2:
+        case 0xE3: loop(cpu, in, opcode); break;
+
+        case 0xE4:
+        case 0xE5:
+        case 0xEC:
+        case 0xED: {
+            uint32 length = (opcode & 1)? osize : 1;
+            uint32 port   = (opcode < 0xEC)? fetch8(cpu, in) : get_reg(cpu, REF486_EDX, 2);
+
+            io_allowed(cpu, port, length);
+            set_reg(cpu, REF486_EAX, length, io_read(cpu, port, length));
+            break;
+        }
+        case 0xE6:
+        case 0xE7:
+        case 0xEE:
+        case 0xEF: {
+            uint32 length = (opcode & 1)? osize : 1;
+            uint32 port   = (opcode < 0xEE)? fetch8(cpu, in) : get_reg(cpu, REF486_EDX, 2);
+
+            io_allowed(cpu, port, length);
+            io_write(cpu, port, length, get_reg(cpu, REF486_EAX, length));
+            break;
+        }
+
+        case 0xE8: {
+            uint32 rel = fetch_imm(cpu, in, osize);
+            push(cpu, osize, next_eip(cpu, in));
+            jump_near(cpu, in, in.next + rel);
+            break;
+        }
+        case 0xE9: {
+            uint32 rel = fetch_imm(cpu, in, osize);
+            jump_near(cpu, in, in.next + rel);
+            break;
+        }
+        case 0xEA: {
+            uint32 offset   = fetch_imm(cpu, in, osize);
+            uint16 selector = fetch16(cpu, in);
+
+            far_transfer(cpu, selector, offset, osize, false, 0);
+            in.jumped = true;
+            break;
+        }
+        case 0xEB: {
+            uint32 rel = sign_extend(fetch8(cpu, in), 1);
+            jump_near(cpu, in, in.next + rel);
+            break;
+        }
+
+        case 0xF1:
+            cpu.eip = next_eip(cpu, in);
+            deliver(cpu, EXCEPTION_DB, false, 0, false);
+            in.jumped = true;
+            break;
+        case 0xF4:
+            require_cpl0(cpu);
+            cpu.halted = true;
+            break;
+        case 0xF5: cpu.eflags ^= FLAG_CF; break;
+        case 0xF6:
+        case 0xF7: execute_group3(cpu, in, opcode, osize); break;
+        case 0xF8: cpu.eflags &= ~FLAG_CF; break;
+        case 0xF9: cpu.eflags |= FLAG_CF;  break;
+        case 0xFA:
+            if(real_mode(cpu) == false && cpu.cpl > iopl(cpu)) fault(EXCEPTION_GP, 0);
+            cpu.eflags &= ~FLAG_IF;
+            break;
+        case 0xFB:
+            if(real_mode(cpu) == false && cpu.cpl > iopl(cpu)) fault(EXCEPTION_GP, 0);
+            if((cpu.eflags & FLAG_IF) == 0) cpu.inhibit_interrupts = true;
+            cpu.eflags |= FLAG_IF;
+            break;
+        case 0xFC: cpu.eflags &= ~FLAG_DF; break;
+        case 0xFD: cpu.eflags |= FLAG_DF;  break;
+        case 0xFE:
+            decode_modrm(cpu, in);
+            if(in.reg > 1) fault(EXCEPTION_UD, 0);
+            rm_write(cpu, in, 1, inc_dec(cpu, in.reg == 1, rm_read_rmw(cpu, in, 1), 1));
+            break;
+        case 0xFF: execute_group5(cpu, in, osize); break;
+
+        default: fault(EXCEPTION_UD, 0);
+    }
+}
+
+//------------------------------------------------------------------------------ two byte opcodes
+
+static void execute_group6(ref486_t &cpu, instr_t &in, uint32 osize) {
+    decode_modrm(cpu, in);
+    if(protected_mode(cpu) == false) fault(EXCEPTION_UD, 0);
+
+    uint32 store_length = (in.mod == 3)? osize : 2;
+
+    switch(in.reg) {
+        case 0: rm_write(cpu, in, store_length, cpu.seg[REF486_LDTR].selector); break;
+        case 1: rm_write(cpu, in, store_length, cpu.seg[REF486_TR].selector);   break;
+        case 2: {
+            require_cpl0(cpu);
+            uint16 selector = rm_read(cpu, in, 2);
+
+            if((selector & 0xFFFC) == 0) {
+                cpu.seg[REF486_LDTR].selector = selector;
+                cpu.seg[REF486_LDTR].valid    = false;
+                break;
+            }
+            if(selector & 4) fault(EXCEPTION_GP, selector & 0xFFFC);
+
+            ref486_seg_t ldt = read_descriptor(cpu, selector, EXCEPTION_GP);
+            if((ldt.rights & 0x1F) != 0x02)  fault(EXCEPTION_GP, selector & 0xFFFC);
+            if((ldt.rights & DESC_P) == 0)   fault(EXCEPTION_NP, selector & 0xFFFC);
+
+            cpu.seg[REF486_LDTR] = ldt;
+            break;
+        }
+        case 3: {
+            require_cpl0(cpu);
+            uint16 selector = rm_read(cpu, in, 2);
+
+            if((selector & 0xFFFC) == 0) fault(EXCEPTION_GP, 0);
+            if(selector & 4)             fault(EXCEPTION_GP, selector & 0xFFFC);
+
+            uint32 low, high;
+            ref486_seg_t tss = read_descriptor(cpu, selector, EXCEPTION_GP, &low, &high);
+            uint32 type = tss.rights & 0x1F;
+
+            if(type != 0x01 && type != 0x09) fault(EXCEPTION_GP, selector & 0xFFFC);
+            if((tss.rights & DESC_P) == 0)   fault(EXCEPTION_NP, selector & 0xFFFC);
+
+            //busy bit: one dword write of the upper half, as ao486 does it
+            system_write(cpu, descriptor_address(cpu, selector, EXCEPTION_GP) + 4, 4, high | 0x200);
+
+            tss.rights |= 0x02;
+            cpu.seg[REF486_TR] = tss;
+            break;
+        }
+        case 4:
+        case 5: {
+            ref486_seg_t desc;
+            bool ok = descriptor_peek(cpu, rm_read(cpu, in, 2), desc) && (desc.rights & DESC_S) && descriptor_visible(cpu, desc);
+
+            if(ok && in.reg == 4) ok = (desc.rights & (DESC_CODE | DESC_RW)) != DESC_CODE;
+            if(ok && in.reg == 5) ok = (desc.rights & (DESC_CODE | DESC_RW)) == DESC_RW;
+            if(ok && in.reg == 4 && (desc.rights & (DESC_CODE | DESC_CONFORMING)) == (DESC_CODE | DESC_CONFORMING)) ok = true;
+
+            set_zf(cpu, ok);
+            break;
+        }
+        default: fault(EXCEPTION_UD, 0);
+    }
+}
+
+static void execute_group7(ref486_t &cpu, instr_t &in, uint32 osize) {
+    decode_modrm(cpu, in);
+
+    switch(in.reg) {
+        case 0:
+        case 1: {
+            require_memory(in);
+            uint32 limit = (in.reg == 0)? cpu.gdtr_limit : cpu.idtr_limit;
+            uint32 base  = (in.reg == 0)? cpu.gdtr_base  : cpu.idtr_base;
+
+            //the top byte of the base is stored as zero by a 16 bit operand
+            if(osize == 2) base &= 0x00FFFFFF;
+
+            write_mem(cpu, in.ea_seg, in.ea, 2, limit);
+            write_mem(cpu, in.ea_seg, (in.ea + 2) & offset_mask(in), 4, base);
+            break;
+        }
+        case 2:
+        case 3: {
+            require_memory(in);
+            require_cpl0(cpu);
+
+            uint32 limit = read_mem(cpu, in.ea_seg, in.ea, 2);
+            uint32 base  = read_mem(cpu, in.ea_seg, (in.ea + 2) & offset_mask(in), 4);
+            if(osize == 2) base &= 0x00FFFFFF;
+
+            if(in.reg == 2) { cpu.gdtr_limit = limit; cpu.gdtr_base = base; }
+            else            { cpu.idtr_limit = limit; cpu.idtr_base = base; }
+            break;
+        }
+        case 4: rm_write(cpu, in, (in.mod == 3)? osize : 2, cpu.cr0); break;
+        case 6: {
+            require_cpl0(cpu);
+
+            //lmsw sets PE but never clears it
+            uint32 value = rm_read(cpu, in, 2) & 0x0F;
+            write_cr0(cpu, (cpu.cr0 & ~0x0Eu) | value | (cpu.cr0 & CR0_PE));
+            break;
+        }
+        case 7:
+            require_memory(in);
+            require_cpl0(cpu);
+            tlb_flush_page(cpu, cpu.seg[in.ea_seg].base + in.ea);
+            break;
+        default: fault(EXCEPTION_UD, 0);
+    }
+}
+
+//lar and lsl
+static void load_access(ref486_t &cpu, instr_t &in, bool limit, uint32 osize) {
+    decode_modrm(cpu, in);
+    if(protected_mode(cpu) == false) fault(EXCEPTION_UD, 0);
+
+    ref486_seg_t desc;
+    uint32 low, high;
+    bool   ok = false;
+
+    uint16 selector = rm_read(cpu, in, 2);
+    if(descriptor_peek(cpu, selector, desc)) {
+        uint32 address = ((selector & 4)? cpu.seg[REF486_LDTR].base : cpu.gdtr_base) + (selector & 0xFFF8);
+        low  = system_read(cpu, address,     4);
+        high = system_read(cpu, address + 4, 4);
+
+        uint32 type = desc.rights & 0x0F;
+        if(desc.rights & DESC_S) ok = true;
+        else if(limit)           ok = type == 0x1 || type == 0x2 || type == 0x3 || type == 0x9 || type == 0xB;
+        else                     ok = type == 0x1 || type == 0x2 || type == 0x3 || type == 0x4 || type == 0x5 || type == 0x9 || type == 0xB || type == 0xC;
+
+        ok = ok && descriptor_visible(cpu, desc);
+
+        if(ok && limit) set_reg(cpu, in.reg, osize, desc.limit);
+        if(ok && limit == false) set_reg(cpu, in.reg, osize, high & ((osize == 4)? 0x00FFFF00 : 0xFF00));
+        (void)low;
+    }
+    set_zf(cpu, ok);
+}
+
+//bt, bts, btr, btc; a register bit offset may address outside of the operand
+static void bit_test(ref486_t &cpu, instr_t &in, uint32 op, uint32 offset, bool from_register, uint32 osize) {
+    uint32 bits = osize * 8;
+
+    if(in.mod != 3 && from_register) {
+        int32_t displacement = (int32_t)sign_extend(offset, osize) >> ((osize == 4)? 5 : 4);
+        in.ea = (in.ea + displacement * (int32_t)osize) & offset_mask(in);
+    }
+    offset &= bits - 1;
+
+    uint32 value = (op == 0)? rm_read(cpu, in, osize) : rm_read_rmw(cpu, in, osize);
+    bool   bit   = (value >> offset) & 1;
+
+    set_flags(cpu, FLAG_CF, (bit)? FLAG_CF : 0);
+
+    if(op == 1) rm_write(cpu, in, osize, value |  (1u << offset));
+    if(op == 2) rm_write(cpu, in, osize, value & ~(1u << offset));
+    if(op == 3) rm_write(cpu, in, osize, value ^  (1u << offset));
+}
+
+static void move_control(ref486_t &cpu, instr_t &in, uint8 opcode) {
+    decode_modrm(cpu, in);
+    if(v86_mode(cpu)) fault(EXCEPTION_GP, 0);
+    require_cpl0(cpu);
+
+    //the register operand is always the r/m field, whatever the mod
+    uint32 r = in.rm;
+
+    if(opcode == 0x20) {
+        if(in.reg == 0)      cpu.regs[r] = cpu.cr0;
+        else if(in.reg == 2) cpu.regs[r] = cpu.cr2;
+        else if(in.reg == 3) cpu.regs[r] = cpu.cr3;
+        else fault(EXCEPTION_UD, 0);
+    }
+    else if(opcode == 0x22) {
+        uint32 value = cpu.regs[r];
+
+        if(in.reg == 0)      write_cr0(cpu, value);
+        else if(in.reg == 2) cpu.cr2 = value;
+        else if(in.reg == 3) { cpu.cr3 = value & 0xFFFFF018; tlb_flush(cpu); }
+        else fault(EXCEPTION_UD, 0);
+    }
+    else if(opcode == 0x21) cpu.regs[r] = cpu.dr[in.reg];
+    else                    cpu.dr[in.reg] = cpu.regs[r];
+}
+
+static void execute_0f(ref486_t &cpu, instr_t &in, uint8 opcode, uint32 osize) {
+    if(opcode >= 0x80 && opcode <= 0x8F) {
+        uint32 rel = fetch_imm(cpu, in, osize);
+        if(condition(cpu, opcode & 0x0F)) jump_near(cpu, in, in.next + rel);
+        return;
+    }
+    if(opcode >= 0x90 && opcode <= 0x9F) {
+        decode_modrm(cpu, in);
+        rm_write(cpu, in, 1, condition(cpu, opcode & 0x0F)? 1 : 0);
+        return;
+    }
+    if(opcode >= 0xC8) {
+        uint32 value = cpu.regs[opcode & 7];
+        cpu.regs[opcode & 7] = __builtin_bswap32(value);
+        return;
+    }
+
+    switch(opcode) {
+        case 0x00: execute_group6(cpu, in, osize); break;
+        case 0x01: execute_group7(cpu, in, osize); break;
+        case 0x02: load_access(cpu, in, false, osize); break;
+        case 0x03: load_access(cpu, in, true,  osize); break;
+        case 0x06:
+            require_cpl0(cpu);
+            cpu.cr0 &= ~CR0_TS;
+            break;
+        case 0x08:
+        case 0x09: require_cpl0(cpu); break;
+
+        case 0x20:
+        case 0x21:
+        case 0x22:
+        case 0x23: move_control(cpu, in, opcode); break;
+
+        case 0xA0: push_selector(cpu, osize, cpu.seg[REF486_FS].selector); break;
+        case 0xA8: push_selector(cpu, osize, cpu.seg[REF486_GS].selector); break;
+        case 0xA1: pop_segment(cpu, REF486_FS, osize); break;
+        case 0xA9: pop_segment(cpu, REF486_GS, osize); break;
+
+        case 0xA2: {
+            uint32 leaf = cpu.regs[REF486_EAX];
+            cpu.regs[REF486_EAX] = 0;
+            cpu.regs[REF486_EBX] = 0;
+            cpu.regs[REF486_ECX] = 0;
+            cpu.regs[REF486_EDX] = 0;
+
+            if(leaf == 0) {
+                cpu.regs[REF486_EAX] = 1;
+                cpu.regs[REF486_EBX] = 0x756E6547;     //"Genu"
+                cpu.regs[REF486_EDX] = 0x49656E69;     //"ineI"
+                cpu.regs[REF486_ECX] = 0x6C65746E;     //"ntel"
+            }
+            else if(leaf == 1) {
+                cpu.regs[REF486_EAX] = CPUID_MODEL_FAMILY_STEPPING;
+            }
+            break;
+        }
+
+        case 0xA3:
+        case 0xAB:
+        case 0xB3:
+        case 0xBB:
+            decode_modrm(cpu, in);
+            bit_test(cpu, in, (opcode >> 3) & 3, get_reg(cpu, in.reg, osize), true, osize);
+            break;
+        case 0xBA: {
+            decode_modrm(cpu, in);
+            if(in.reg < 4) fault(EXCEPTION_UD, 0);
+
+            uint32 imm = fetch8(cpu, in);
+            bit_test(cpu, in, in.reg & 3, imm, false, osize);
+            break;
+        }
+
+        case 0xA4:
+        case 0xA5:
+        case 0xAC:
+        case 0xAD: {
+            decode_modrm(cpu, in);
+            uint32 count = (opcode & 1)? get_reg(cpu, REF486_ECX, 1) : fetch8(cpu, in);
+            uint32 value = rm_read_rmw(cpu, in, osize);
+
+            if(shift_double(cpu, opcode < 0xAC, value, get_reg(cpu, in.reg, osize), count, osize)) rm_write(cpu, in, osize, value);
+            break;
+        }
+
+        case 0xAF:
+            decode_modrm(cpu, in);
+            set_reg(cpu, in.reg, osize, multiply_signed(cpu, get_reg(cpu, in.reg, osize), rm_read(cpu, in, osize), osize));
+            break;
+
+        case 0xB0:
+        case 0xB1: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+
+            //ao486 leaves the destination unwritten when it differs
+            uint32 dst = rm_read_rmw(cpu, in, length);
+            uint32 acc = get_reg(cpu, REF486_EAX, length);
+
+            alu(cpu, ALU_CMP, acc, dst, length);
+            if(acc == dst) rm_write(cpu, in, length, get_reg(cpu, in.reg, length));
+            else           set_reg(cpu, REF486_EAX, length, dst);
+            break;
+        }
+
+        case 0xB2: decode_modrm(cpu, in); load_far_pointer(cpu, in, REF486_SS); break;
+        case 0xB4: decode_modrm(cpu, in); load_far_pointer(cpu, in, REF486_FS); break;
+        case 0xB5: decode_modrm(cpu, in); load_far_pointer(cpu, in, REF486_GS); break;
+
+        case 0xB6:
+        case 0xB7:
+        case 0xBE:
+        case 0xBF: {
+            uint32 length = (opcode & 1)? 2 : 1;
+            decode_modrm(cpu, in);
+
+            uint32 value = rm_read(cpu, in, length);
+            if(opcode >= 0xBE) value = sign_extend(value, length);
+            set_reg(cpu, in.reg, osize, value);
+            break;
+        }
+
+        case 0xBC:
+        case 0xBD: {
+            decode_modrm(cpu, in);
+            uint32 value = rm_read(cpu, in, osize);
+
+            //a zero source sets ZF only, the destination is unchanged
+            if(value == 0) {
+                set_zf(cpu, true);
+                break;
+            }
+            set_zf(cpu, false);
+            set_reg(cpu, in.reg, osize, (opcode == 0xBC)? __builtin_ctz(value) : 31 - __builtin_clz(value));
+            break;
+        }
+
+        case 0xC0:
+        case 0xC1: {
+            uint32 length = (opcode & 1)? osize : 1;
+            decode_modrm(cpu, in);
+
+            uint32 dst = rm_read_rmw(cpu, in, length);
+            uint32 sum = alu(cpu, ALU_ADD, dst, get_reg(cpu, in.reg, length), length);
+
+            set_reg(cpu, in.reg, length, dst);
+            rm_write(cpu, in, length, sum);
+            break;
+        }
+
+        default: fault(EXCEPTION_UD, 0);
+    }
+}
+
+//------------------------------------------------------------------------------ instruction
+
+static void execute(ref486_t &cpu) {
+    bool cs32 = (cpu.seg[REF486_CS].flags & DESC_D_B) != 0;
+
+    instr_t in;
+    memset(&in, 0, sizeof(in));
+    in.start = cpu.eip;
+    in.next  = cpu.eip;
+    in.seg   = -1;
+    in.os32  = cs32;
+    in.as32  = cs32;
+
+    uint8 opcode;
+    bool  prefix = true;
+
+    while(prefix) {
+        opcode = fetch8(cpu, in);
+
+        switch(opcode) {
+            case 0x26: in.seg = REF486_ES; break;
+            case 0x2E: in.seg = REF486_CS; break;
+            case 0x36: in.seg = REF486_SS; break;
+            case 0x3E: in.seg = REF486_DS; break;
+            case 0x64: in.seg = REF486_FS; break;
+            case 0x65: in.seg = REF486_GS; break;
+            case 0x66: in.os32 = !cs32;    break;
+            case 0x67: in.as32 = !cs32;    break;
+            case 0xF0:                     break;
+            case 0xF2:
+            case 0xF3: in.rep = opcode;    break;
+            default:   prefix = false;     break;
+        }
+    }
+
+    execute_one(cpu, in, opcode, (in.os32)? 4 : 2);
+
+    if(in.jumped == false) cpu.eip = next_eip(cpu, in);
+}
+
+//------------------------------------------------------------------------------ api
+
+void ref486_reset(ref486_t &cpu) {
+    ref486_bus_t bus = cpu.bus;
+
+    memset(&cpu, 0, sizeof(ref486_t));
+    cpu.bus = bus;
+
+    cpu.regs[REF486_EDX] = CPUID_MODEL_FAMILY_STEPPING;
+    cpu.eip    = 0xFFF0;
+    cpu.eflags = 0x00000002;
+    cpu.cr0    = CR0_CD | CR0_NW | CR0_ET;
+
+    for(uint32 s=0; s<8; s++) {
+        ref486_seg_t &seg = cpu.seg[s];
+        seg.limit  = 0xFFFF;
+        seg.rights = DESC_P | DESC_S | DESC_RW | DESC_ACCESSED;
+        seg.valid  = true;
+    }
+    cpu.seg[REF486_CS].selector = 0xF000;
+    cpu.seg[REF486_CS].base     = 0xF0000;
+    cpu.seg[REF486_CS].rights   = DESC_P | DESC_S | DESC_CODE | DESC_RW | DESC_ACCESSED;
+
+    cpu.seg[REF486_LDTR].rights = DESC_P | 0x02;
+    cpu.seg[REF486_TR].rights   = DESC_P | 0x0B;
+
+    cpu.gdtr_limit = 0xFFFF;
+    cpu.idtr_limit = 0xFFFF;
+
+    cpu.dr[6] = 0xFFFF0FF0 | 0x1000;
+    cpu.dr[7] = 0x00000400;
+}
+
+//the exception an instruction raised, with the double fault rules
+static ref486_status_t exception(ref486_t &cpu, fault_t value) {
+    uint8  vector     = value.vector;
+    uint32 error_code = value.error_code;
+
+    for(uint32 nested=0; ; nested++) {
+        cpu.exception_counter++;
+        cpu.exception_vector = vector;
+        cpu.halted           = false;
+
+        try {
+            deliver(cpu, vector, has_error_code(vector), error_code, false);
+            return REF486_OK;
+        }
+        catch(fault_t next) {
+            if(vector == EXCEPTION_DF || nested >= 2) return REF486_SHUTDOWN;
+
+            bool promote = (contributory(vector) && contributory(next.vector)) ||
+                           (vector == EXCEPTION_PF && (next.vector == EXCEPTION_PF || contributory(next.vector)));
+
+            vector     = (promote)? EXCEPTION_DF : next.vector;
+            error_code = (promote)? 0 : next.error_code;
+        }
+    }
+}
+
+ref486_status_t ref486_step(ref486_t &cpu) {
+    if(cpu.halted) return REF486_HALTED;
+
+    uint32       regs[8];
+    uint32       eip    = cpu.eip;
+    uint32       eflags = cpu.eflags;
+    uint8        cpl    = cpu.cpl;
+    ref486_seg_t seg[8];
+
+    memcpy(regs, cpu.regs, sizeof(regs));
+    memcpy(seg,  cpu.seg,  sizeof(seg));
+
+    bool trap = (eflags & FLAG_TF) != 0;
+    cpu.inhibit_interrupts = false;
+
+    try {
+        execute(cpu);
+        cpu.instr_counter++;
+        cpu.eflags &= ~FLAG_RF;
+
+        if(trap) {
+            cpu.dr[6] |= 0x4000;
+            return exception(cpu, fault_t{ EXCEPTION_DB, 0 });
+        }
+        return (cpu.halted)? REF486_HALTED : REF486_OK;
+    }
+    catch(fault_t value) {
+        memcpy(cpu.regs, regs, sizeof(regs));
+        memcpy(cpu.seg,  seg,  sizeof(seg));
+        cpu.eip    = eip;
+        cpu.eflags = eflags;
+        cpu.cpl    = cpl;
+        cpu.halted = false;
+
+        return exception(cpu, value);
+    }
+    catch(unsupported_t value) {
+        memcpy(cpu.regs, regs, sizeof(regs));
+        memcpy(cpu.seg,  seg,  sizeof(seg));
+        cpu.eip    = eip;
+        cpu.eflags = eflags;
+        cpu.cpl    = cpl;
+
+        cpu.unsupported = value.what;
+        return REF486_UNSUPPORTED;
+    }
+}
+
+ref486_status_t ref486_interrupt(ref486_t &cpu, uint8 vector) {
+    cpu.halted = false;
+
+    try {
+        deliver(cpu, vector, false, 0, false);
+        return REF486_OK;
+    }
+    catch(fault_t value) {
+        return exception(cpu, value);
+    }
+    catch(unsupported_t value) {
+        cpu.unsupported = value.what;
+        return REF486_UNSUPPORTED;
+    }
+}
+
+//descriptor cache the way ao486 holds it: the raw descriptor, limit with its granularity undone
+static uint64 descriptor_bits(const ref486_seg_t &seg) {
+    uint32 limit = (seg.flags & DESC_G)? (seg.limit >> 12) : seg.limit;
+
+    uint32 low  = (limit & 0xFFFF) | (seg.base << 16);
+    uint32 high = ((seg.base >> 16) & 0xFF) | ((uint32)seg.rights << 8) | (limit & 0x000F0000) | ((uint32)(seg.flags & 0xF0) << 16) | (seg.base & 0xFF000000);
+
+    return ((uint64)high << 32) | low;
+}
+
+void ref486_export(const ref486_t &cpu, arch_state_t &state) {
+    memset(&state, 0, sizeof(state));
+
+    state.instr_counter = cpu.instr_counter;
+
+    memcpy(state.regs, cpu.regs, sizeof(state.regs));
+    state.eip    = cpu.eip;
+    state.eflags = cpu.eflags;
+
+    state.cr0 = cpu.cr0;
+    state.cr2 = cpu.cr2;
+    state.cr3 = cpu.cr3;
+
+    state.gdtr_base  = cpu.gdtr_base;
+    state.gdtr_limit = cpu.gdtr_limit;
+    state.idtr_base  = cpu.idtr_base;
+    state.idtr_limit = cpu.idtr_limit;
+
+    memcpy(state.dr, cpu.dr, sizeof(state.dr));
+
+    //ao486 keeps rpl 0 for real mode loads and 3 for virtual 8086 mode loads; ldtr and tr only load in protected mode
+    for(uint32 s=0; s<8; s++) {
+        const ref486_seg_t &seg = cpu.seg[s];
+
+        state.seg_selector[s] = seg.selector;
+        state.seg_rpl[s]      = (s >= REF486_LDTR)? (seg.selector & 3) : (real_mode(cpu))? 0 : (v86_mode(cpu))? 3 : (s == REF486_CS)? cpu.cpl : (seg.selector & 3);
+        state.seg_valid[s]    = seg.valid;
+        state.seg_cache[s]    = descriptor_bits(seg);
+    }
+}
+
+void ref486_print(const ref486_t &cpu, FILE *fp) {
+    static const char *reg_names[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+    static const char *seg_names[8] = { "es", "cs", "ss", "ds", "fs", "gs", "ldtr", "tr" };
+
+    fprintf(fp, "instr: %u eip: %08x eflags: %08x cpl: %u\n", cpu.instr_counter, cpu.eip, cpu.eflags, cpu.cpl);
+    for(int i=0; i<8; i++) fprintf(fp, "%s: %08x%s", reg_names[i], cpu.regs[i], (i == 3 || i == 7)? "\n" : " ");
+    for(int i=0; i<8; i++) {
+        const ref486_seg_t &seg = cpu.seg[i];
+        fprintf(fp, "%-4s: %04x base: %08x limit: %08x rights: %02x flags: %02x%s\n", seg_names[i], seg.selector, seg.base, seg.limit, seg.rights, seg.flags, (seg.valid)? "" : " invalid");
+    }
+    fprintf(fp, "cr0: %08x cr2: %08x cr3: %08x gdtr: %08x/%04x idtr: %08x/%04x\n", cpu.cr0, cpu.cr2, cpu.cr3, cpu.gdtr_base, cpu.gdtr_limit, cpu.idtr_base, cpu.idtr_limit);
+}
@@ -0,0 +1,143 @@
+#ifndef __REF486_H
+#define __REF486_H
+
+#include "shared_mem.h"
+
+/* Functional 486 model used as the reference side of a lockstep run, in the
+ * place the patched bochs used to take (shared_mem_t::bochs486_pc).
+ *
+ * It executes whole instructions and keeps no timing. All stores, io and
+ * reads outside of ram go through the bus callbacks one dword at a time with
+ * a byteenable, the way ao486 puts them on its avalon buses, so the
+ * transactions can be matched one for one with the ones of the RTL. Plain ram
+ * is read straight from 'ram', as the ao486 harness does.
+ *
+ * Coverage: the 486 integer instruction set in real, protected and virtual
+ * 8086 mode, with paging, privilege changes through gates and the io
+ * permission bitmap. The FPU is absent (ESC raises #NM when CR0.EM or CR0.TS
+ * is set, otherwise it is skipped), as in ao486 without its FPU. Task
+ * switches and the debug register breakpoints are not modelled: a task switch
+ * stops the model with REF486_UNSUPPORTED.
+ */
+
+enum ref486_segment_t {
+    REF486_ES   = 0,
+    REF486_CS   = 1,
+    REF486_SS   = 2,
+    REF486_DS   = 3,
+    REF486_FS   = 4,
+    REF486_GS   = 5,
+    REF486_LDTR = 6,
+    REF486_TR   = 7
+};
+
+enum ref486_register_t {
+    REF486_EAX = 0,
+    REF486_ECX = 1,
+    REF486_EDX = 2,
+    REF486_EBX = 3,
+    REF486_ESP = 4,
+    REF486_EBP = 5,
+    REF486_ESI = 6,
+    REF486_EDI = 7
+};
+
+enum ref486_status_t {
+    REF486_OK          = 0,
+    REF486_HALTED      = 1,     //hlt: waits for an interrupt
+    REF486_SHUTDOWN    = 2,     //triple fault
+    REF486_UNSUPPORTED = 3      //see ref486_t::unsupported
+};
+
+//segment register with its descriptor cache
+struct ref486_seg_t {
+    uint16 selector;
+    uint32 base;
+    uint32 limit;       //in bytes, granularity applied
+    uint8  rights;      //descriptor byte 5: P, DPL, S, type
+    uint8  flags;       //descriptor byte 6, bits 7:4: G, D/B, AVL
+    bool   valid;
+};
+
+struct ref486_bus_t {
+    void  *ctx;
+
+    //direct read path for ram, NULL reads everything through mem_read
+    const uint8 *ram;
+    uint32       ram_size;  //power of two; physical addresses wrap at it
+
+    //dword aligned address, data in its byte lanes
+    uint32 (*mem_read) (void *ctx, uint32 address, uint32 byteenable);
+    void   (*mem_write)(void *ctx, uint32 address, uint32 data, uint32 byteenable);
+    uint32 (*io_read)  (void *ctx, uint32 address, uint32 byteenable);
+    void   (*io_write) (void *ctx, uint32 address, uint32 data, uint32 byteenable);
+};
+
+#define REF486_TLB_SIZE 256
+
+struct ref486_tlb_t {
+    uint32 linear;      //page | 1 when valid
+    uint32 physical;
+    bool   user;        //pde.us & pte.us
+    bool   writable;    //pde.rw & pte.rw
+    bool   dirty;
+};
+
+struct ref486_t {
+    uint32 regs[8];
+    uint32 eip;
+    uint32 eflags;
+
+    ref486_seg_t seg[8];
+    uint8        cpl;       //RPL of CS as last loaded: 0 after real mode loads, 3 in virtual 8086 mode
+
+    uint32 gdtr_base;
+    uint32 gdtr_limit;
+    uint32 idtr_base;
+    uint32 idtr_limit;
+
+    uint32 cr0;
+    uint32 cr2;
+    uint32 cr3;
+    uint32 dr[8];
+
+    bool halted;
+    bool inhibit_interrupts;    //for one instruction after sti, mov ss and pop ss
+
+    //retired instructions; every iteration of a rep string instruction counts
+    uint32 instr_counter;
+
+    //last exception, for the log of the caller
+    uint32 exception_counter;
+    uint8  exception_vector;
+
+    const char *unsupported;
+
+    ref486_bus_t bus;
+
+    ref486_tlb_t tlb[REF486_TLB_SIZE];
+};
+
+void ref486_reset(ref486_t &cpu);
+
+//one instruction, or one iteration of a rep string instruction, with the exception it raises
+ref486_status_t ref486_step(ref486_t &cpu);
+
+//external interrupt at the current instruction boundary; wakes from hlt
+ref486_status_t ref486_interrupt(ref486_t &cpu, uint8 vector);
+
+static inline bool ref486_interrupts_enabled(const ref486_t &cpu) {
+    return (cpu.eflags & 0x200) != 0 && cpu.inhibit_interrupts == false;
+}
+
+//CS base + EIP of the next instruction
+static inline uint32 ref486_linear_eip(const ref486_t &cpu) {
+    return cpu.seg[REF486_CS].base + cpu.eip;
+}
+
+//state for the fast-forward handoff to ao486; meaningful at an instruction boundary
+void ref486_export(const ref486_t &cpu, arch_state_t &state);
+
+void ref486_print(const ref486_t &cpu, FILE *fp);
+
+#endif //__REF486_H
@@ -1,5 +1,7 @@
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <csignal>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -11,6 +13,94 @@
 
 volatile shared_mem_t *shared_ptr = NULL;
 
+//device plugins of sim/verilator/soc started by a full run: pic, pit, rtc, ps2, floppy, hdd, pc_dma, vga
+#define IO_DEVICES_DEFAULT 8
+
+volatile sig_atomic_t stop_requested = 0;
+
+void stop_handler(int) {
+    stop_requested = 1;
+}
+
+//hand the access in combined.io to the device that claimed the port; an unclaimed port floats and is answered at once
+volatile io_slot_t *io_dispatch() {
+    uint8 owner = shared_ptr->io_map[io_port(shared_ptr->combined.io_address, shared_ptr->combined.io_byteenable)];
+    
+    if(owner == 0) {
+        if(shared_ptr->combined.io_is_write == 0) shared_ptr->combined.io_data = 0xFFFFFFFF;
+        shared_ptr->combined.io_step = STEP_ACK;
+        return NULL;
+    }
+    
+    volatile io_slot_t *slot = &shared_ptr->io_slots[owner - 1];
+    slot->io_address    = shared_ptr->combined.io_address;
+    slot->io_data       = shared_ptr->combined.io_data;
+    slot->io_byteenable = shared_ptr->combined.io_byteenable;
+    slot->io_is_write   = shared_ptr->combined.io_is_write;
+    slot->io_step       = STEP_REQ;
+    io_wake(slot);
+    return slot;
+}
+
+//the owning slot answered: move the result back into combined.io
+bool io_dispatch_done(volatile io_slot_t *slot) {
+    if(slot == NULL || slot->io_step != STEP_ACK) return false;
+    
+    shared_ptr->combined.io_data = slot->io_data;
+    shared_ptr->combined.io_step = STEP_ACK;
+    slot->io_step = STEP_IDLE;
+    return true;
+}
+
+/* Backing for shared_mem.dat, sized to the configured ram. Untouched pages are
+ * never allocated, so startup costs no zero-fill and no disk writes.
+ *
+ * Preferred is a memfd, published to the other processes by making
+ * shared_mem.dat a symlink to /proc/<pid>/fd/<fd>: they keep opening the same
+ * path. Without memfd a sparse regular file is used.
+ */
+int shared_mem_create(const char *name, uint64 size, bool hugepages) {
+    unlink(name);
+    
+    int fd = -1;
+    if(hugepages) {
+        uint64 huge_size = (size + (2 << 20) - 1) & ~(uint64)((2 << 20) - 1);
+        fd = memfd_create("ao486_shared_mem", MFD_HUGETLB);
+        if(fd != -1 && ftruncate(fd, huge_size) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        if(fd == -1) printf("hugetlb memfd not available, using transparent huge pages\n");
+    }
+    if(fd == -1) {
+        fd = memfd_create("ao486_shared_mem", 0);
+        if(fd != -1 && ftruncate(fd, size) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    
+    if(fd != -1) {
+        char target[64];
+        snprintf(target, sizeof(target), "/proc/%d/fd/%d", getpid(), fd);
+        if(symlink(target, name) == 0) return fd;
+        
+        close(fd);
+    }
+    
+    fd = open(name, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if(fd == -1) {
+        perror("Can not create file shared_mem.dat");
+        return -1;
+    }
+    if(ftruncate(fd, size) != 0) {
+        perror("Can not size file shared_mem.dat");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
 int load_file(const char *name, int byte_location) {
     FILE *fp = fopen(name, "rb");
     if(fp == NULL) {
@@ -36,34 +126,72 @@ int load_file(const char *name, int byte_location) {
     return 0;
 }
 
+void print_transaction(const char *name, volatile processor_t *p) {
+    if(p->mem_step == STEP_REQ) printf("%-12s mem %s address: %08x data: %08x byteenable: %x at %u\n", name, (p->mem_is_write)? "write" : "read ", p->mem_address, p->mem_data, p->mem_byteenable, p->instr_counter);
+    if(p->io_step  == STEP_REQ) printf("%-12s io  %s address: %08x data: %08x byteenable: %x at %u\n", name, (p->io_is_write)?  "write" : "read ", p->io_address,  p->io_data,  p->io_byteenable,  p->instr_counter);
+}
+
+/* In lockstep both cpus wait on their mailbox with one transaction each. The
+ * control steps pair them up when they are equal; two pending transactions
+ * that differ never will be.
+ */
+bool lockstep_diverged() {
+    volatile processor_t *a = &shared_ptr->ao486;
+    volatile processor_t *b = &shared_ptr->bochs486_pc;
+    
+    bool a_mem = a->mem_step == STEP_REQ, a_io = a->io_step == STEP_REQ;
+    bool b_mem = b->mem_step == STEP_REQ, b_io = b->io_step == STEP_REQ;
+    
+    if((a_mem || a_io) == false || (b_mem || b_io) == false) return false;
+    if(a_mem != b_mem) return true;
+    
+    if(a_mem) {
+        if(a->mem_address != b->mem_address || a->mem_byteenable != b->mem_byteenable || a->mem_is_write != b->mem_is_write) return true;
+        return a->mem_is_write && a->mem_data != b->mem_data;
+    }
+    if(a->io_address != b->io_address || a->io_byteenable != b->io_byteenable || a->io_is_write != b->io_is_write) return true;
+    return a->io_is_write && a->io_data != b->io_data;
+}
+
 int main(int argc, char **argv) {
     
     int int_ret;
     
-    //open file with truncate
-    FILE *fp = fopen("shared_mem.dat", "wb");
-    if(fp == NULL) {
-        perror("Can not truncate file shared_mem.dat");
-        return -1;
-    }
-    uint8 *buf = new uint8[sizeof(shared_mem_t)];
-    memset(buf, 0, sizeof(shared_mem_t));
+    uint32 mem_mb     = MEMORY_DEFAULT_SIZE >> 20;
+    bool   hugepages  = false;
+    uint32 devices    = IO_DEVICES_DEFAULT;
+    uint32 io_pace_ns = 0;     //sleep of the running devices between two clocks, --io-pace
     
-    int_ret = fwrite(buf, sizeof(shared_mem_t), 1, fp);
-    delete buf;
-    if(int_ret != 1) {
-        perror("Can not zero-fill file shared_mem.dat");
-        fclose(fp);
-        return -2;
-    }
-    fclose(fp);
+    //which cpus take part: ao486 alone, the reference alone, or both in lockstep
+    uint32 bochs486_pc_only = 0;
+    uint32 ao486_only = 1;
     
-    int fd = open("shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
+    //fast-forward: the reference runs alone up to its handoff, then ao486 takes over, alone or in lockstep
+    bool   fast_forward     = false;
+    uint32 handoff_lockstep = 0;
     
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--mem-mb") == 0 && i+1 < argc) mem_mb    = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--hugepages") == 0)         hugepages = true;
+        else if(strcmp(argv[i], "--devices") == 0 && i+1 < argc) devices = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--io-pace") == 0 && i+1 < argc) io_pace_ns = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--lockstep") == 0)          { ao486_only = 0; bochs486_pc_only = 0; }
+        else if(strcmp(argv[i], "--ref-only") == 0)          { ao486_only = 0; bochs486_pc_only = 1; }
+        else if(strcmp(argv[i], "--fast-forward") == 0)      { ao486_only = 0; bochs486_pc_only = 1; fast_forward = true; }
+        else if(strcmp(argv[i], "--fast-forward-lockstep") == 0) { ao486_only = 0; bochs486_pc_only = 1; fast_forward = true; handoff_lockstep = 1; }
+    }
+    //mem_mask() aliases anything else; checked before the shift, which would wrap
+    if(mem_mb < 1 || mem_mb > (MEMORY_MAX_SIZE >> 20) || (mem_mb & (mem_mb - 1)) != 0) {
+        fprintf(stderr, "--mem-mb %u: must be a power of two between 1 and %u\n", mem_mb, MEMORY_MAX_SIZE >> 20);
         return -1;
     }
+    uint32 mem_size = mem_mb << 20;
+    
+    const char *instance = getenv("AO486_INSTANCE");
+    if(instance != NULL && instance[0] != 0) mkdir(instance, 0755);
+    
+    int fd = shared_mem_create(instance_path("shared_mem.dat", "shared_mem.dat"), shared_mem_file_size(mem_size), hugepages);
+    if(fd == -1) return -1;
     
     shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     
@@ -72,6 +200,15 @@ int main(int argc, char **argv) {
         close(fd);
         return -2;
     }
+    if(hugepages) madvise((void *)shared_ptr, shared_mem_file_size(mem_size), MADV_HUGEPAGE);
+    
+    shared_ptr->mem_size   = mem_size;
+    shared_ptr->io_pace_ns = io_pace_ns;
+    
+    shared_ptr->handoff_step     = STEP_IDLE;
+    shared_ptr->handoff_lockstep = handoff_lockstep;
+    shared_ptr->lockstep         = (ao486_only == 0 && bochs486_pc_only == 0) || handoff_lockstep;
+    printf("guest ram: %u MB\n", mem_size >> 20);
     
     //load bios
     int_ret = load_file("./../../sd/bios/bochs_legacy", 0xF0000);
@@ -89,16 +226,26 @@ int main(int argc, char **argv) {
     
     //--------------------------------------------------------------------------
     
-/*
-    while(true) {
+    signal(SIGINT,  stop_handler);
+    signal(SIGTERM, stop_handler);
+    
+    //every device claims its ports before the first access; --devices 0 runs without them
+    if(devices > 0) printf("Waiting for %u devices...", devices);
+    fflush(stdout);
+    while(shared_ptr->io_ready_count < devices && stop_requested == 0) {
+        usleep(1000);
+    }
+    if(devices > 0) printf("done.\n");
+    
+    while(ao486_only == 0) {
         if(shared_ptr->bochs486_pc.starting == STEP_REQ) {
             printf("Starting bochs486_pc.\n");
             shared_ptr->bochs486_pc.starting = STEP_ACK;
             break;
         }
-    }  
-*/
-    while(true) {
+    }
+    
+    while(bochs486_pc_only == 0) {
         if(shared_ptr->ao486.starting == STEP_REQ) {
             printf("Starting ao486.\n");
             shared_ptr->ao486.starting = STEP_ACK;
@@ -123,20 +270,70 @@ int main(int argc, char **argv) {
     uint32 ctrl_mem_read  = 0;
     uint32 ctrl_mem_write = 0;
     
-    uint32 bochs486_pc_only = 0;
-    uint32 ao486_only = 1;
+    volatile io_slot_t *ctrl_io_slot = NULL;
     
     FILE *fp_stop = NULL;
     uint32 bochs486_stopped = 0;
     
-    FILE *debug_fp = fopen("output.txt", "w");
+    FILE *debug_fp = fopen(instance_path("output.txt", "output.txt"), "w");
     
-    while(true) {
+    volatile transport_t *transport = &shared_ptr->ao486_transport;
+    
+    transaction_t ao486_pending;
+    bool          ao486_pending_valid = false;
+    bool          ao486_pending_is_io = false;
+    
+    uint32 idle_spins = 0;
+    int    result     = 0;
+    
+    while(stop_requested == 0) {
+        
+        //---------------------------------------------------------------------- transport -> ao486 mailbox
+        
+        //both rings merged back into program order; a request whose turn has not come waits for the next pass
+        if(ao486_pending_valid == false && transport_next(transport, ao486_pending, ao486_pending_is_io)) {
+            ao486_pending_valid = true;
+            
+            if(ao486_pending_is_io == false) {
+                shared_ptr->ao486.mem_address    = ao486_pending.address;
+                shared_ptr->ao486.mem_data       = ao486_pending.data;
+                shared_ptr->ao486.mem_byteenable = ao486_pending.byteenable;
+                shared_ptr->ao486.mem_is_write   = ao486_pending.is_write;
+                shared_ptr->ao486.mem_step       = STEP_REQ;
+            }
+            else {
+                shared_ptr->ao486.io_address    = ao486_pending.address;
+                shared_ptr->ao486.io_data       = ao486_pending.data;
+                shared_ptr->ao486.io_byteenable = ao486_pending.byteenable;
+                shared_ptr->ao486.io_is_write   = ao486_pending.is_write;
+                shared_ptr->ao486.io_step       = STEP_REQ;
+            }
+        }
+        
+        //---------------------------------------------------------------------- fast-forward handoff
+        
+        if(fast_forward && bochs486_pc_only && shared_ptr->handoff_step == STEP_REQ) {
+            shared_ptr->ao486.instr_counter = shared_ptr->handoff.instr_counter;
+            
+            //ao486 loads the handoff state after its reset
+            while(true) {
+                if(shared_ptr->ao486.starting == STEP_REQ) {
+                    printf("Starting ao486 at %u.\n", shared_ptr->handoff.instr_counter);
+                    shared_ptr->ao486.starting = STEP_ACK;
+                    break;
+                }
+            }
+            
+            bochs486_pc_only = 0;
+            ao486_only       = (handoff_lockstep)? 0 : 1;
+            
+            shared_ptr->handoff_step = STEP_ACK;
+        }
         
         //---------------------------------------------------------------------- stop control
         
         if(bochs486_stopped == 0) {
-            if(fp_stop == NULL) fp_stop = fopen("ctrl_stop.do", "rb");
+            if(fp_stop == NULL) fp_stop = fopen(instance_path("ctrl_stop.do", "ctrl_stop.do"), "rb");
             if(fp_stop != NULL) {
                 
                 if(shared_ptr->bochs486_pc.stop == STEP_IDLE) {
@@ -159,7 +356,7 @@ int main(int argc, char **argv) {
             }
         }
         if(bochs486_stopped == 1) {
-            if(fp_stop == NULL) fp_stop = fopen("ctrl_stop.do", "rb");
+            if(fp_stop == NULL) fp_stop = fopen(instance_path("ctrl_stop.do", "ctrl_stop.do"), "rb");
             if(fp_stop != NULL) {
                 fclose(fp_stop);
                 fp_stop = NULL;
@@ -201,7 +398,7 @@ int main(int argc, char **argv) {
                 shared_ptr->combined.io_address    = (ao486_only)? shared_ptr->ao486.io_address : shared_ptr->bochs486_pc.io_address;
                 shared_ptr->combined.io_byteenable = (ao486_only)? shared_ptr->ao486.io_byteenable : shared_ptr->bochs486_pc.io_byteenable;
                 shared_ptr->combined.io_is_write   = 0;
-                shared_ptr->combined.io_step       = STEP_REQ;
+                ctrl_io_slot = io_dispatch();
             }
         }
         
@@ -218,7 +415,7 @@ int main(int argc, char **argv) {
                     shared_ptr->bochs486_pc.io_step = STEP_ACK;
                 }
             }
-            else if(shared_ptr->combined.io_step == STEP_ACK && shared_ptr->combined.io_is_write == 0) {
+            else if(io_dispatch_done(ctrl_io_slot) || (ctrl_io_slot == NULL && shared_ptr->combined.io_step == STEP_ACK && shared_ptr->combined.io_is_write == 0)) {
                 ctrl_io_read = 0;
                 
                 if(bochs486_pc_only == 0) {
@@ -250,7 +447,7 @@ int main(int argc, char **argv) {
                 shared_ptr->combined.io_data       = (ao486_only)? shared_ptr->ao486.io_data : shared_ptr->bochs486_pc.io_data;
                 shared_ptr->combined.io_byteenable = (ao486_only)? shared_ptr->ao486.io_byteenable : shared_ptr->bochs486_pc.io_byteenable;
                 shared_ptr->combined.io_is_write   = 1;
-                shared_ptr->combined.io_step       = STEP_REQ;
+                ctrl_io_slot = io_dispatch();
             }
         }
         
@@ -264,7 +461,7 @@ int main(int argc, char **argv) {
                 if(bochs486_pc_only == 0) shared_ptr->ao486.io_step = STEP_ACK;
                 if(ao486_only == 0)       shared_ptr->bochs486_pc.io_step = STEP_ACK;
             }
-            else if(shared_ptr->combined.io_step == STEP_ACK && shared_ptr->combined.io_is_write == 1) {
+            else if(io_dispatch_done(ctrl_io_slot) || (ctrl_io_slot == NULL && shared_ptr->combined.io_step == STEP_ACK && shared_ptr->combined.io_is_write == 1)) {
                 ctrl_io_write = 0;
                 
                 if(bochs486_pc_only == 0) shared_ptr->ao486.io_step = STEP_ACK;
@@ -338,6 +535,17 @@ int main(int argc, char **argv) {
             }
         }
         
+        //---------------------------------------------------------------------- lockstep check
+        
+        if(ao486_only == 0 && bochs486_pc_only == 0 && ctrl_io_read == 0 && ctrl_io_write == 0 && ctrl_mem_read == 0 && ctrl_mem_write == 0 && lockstep_diverged()) {
+            printf("Lockstep mismatch:\n");
+            print_transaction("ao486",       &shared_ptr->ao486);
+            print_transaction("bochs486_pc", &shared_ptr->bochs486_pc);
+            
+            result = -4;
+            break;
+        }
+        
         //---------------------------------------------------------------------- combined mem write
         
         if(shared_ptr->combined.mem_step == STEP_REQ && shared_ptr->combined.mem_is_write) {
@@ -355,13 +563,45 @@ int main(int argc, char **argv) {
             }
         }
         
+        //---------------------------------------------------------------------- ao486 mailbox -> transport
+        
+        bool progress = false;
+        
+        if(ao486_pending_valid && ao486_pending_is_io == false && shared_ptr->ao486.mem_step == STEP_ACK) {
+            //memory writes are posted; only reads are answered
+            if(ao486_pending.is_write == 0) {
+                ao486_pending.data = shared_ptr->ao486.mem_data;
+                transport_post(&transport->mem_resp, ao486_pending.sequence, ao486_pending.address, ao486_pending.data, ao486_pending.byteenable, 0);
+            }
+            shared_ptr->ao486.mem_step = STEP_IDLE;
+            ring_pop(&transport->mem_req);
+            
+            ao486_pending_valid = false;
+            progress = true;
+        }
+        if(ao486_pending_valid && ao486_pending_is_io && shared_ptr->ao486.io_step == STEP_ACK) {
+            //io writes are answered too, so the cpu side keeps them synchronous
+            if(ao486_pending.is_write == 0) ao486_pending.data = shared_ptr->ao486.io_data;
+            transport_post(&transport->io_resp, ao486_pending.sequence, ao486_pending.address, ao486_pending.data, ao486_pending.byteenable, ao486_pending.is_write);
+            
+            shared_ptr->ao486.io_step = STEP_IDLE;
+            ring_pop(&transport->io_req);
+            
+            ao486_pending_valid = false;
+            progress = true;
+        }
+        
         //----------------------------------------------------------------------
         
-        usleep(10);
+        if(progress) idle_spins = 0;
+        else         ring_backoff(idle_spins);
     }
     
+    io_wake_all(shared_ptr);
+    
     munmap((void *)shared_ptr, sizeof(shared_mem_t));
     close(fd);
+    unlink(instance_path("shared_mem.dat", "shared_mem.dat"));
     
-    return 0;
+    return result;
 }
@@ -2,15 +2,33 @@
 #ifndef __SHARED_MEM_H
 #define __SHARED_MEM_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <sched.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
 typedef unsigned char  uint8;
 typedef unsigned short uint16;
 typedef unsigned int   uint32;
 typedef unsigned long  uint64;
 
+/* memory_t is declared at the largest supported size; the backing file only
+ * covers shared_mem_t::mem_size bytes of it (see shared_mem_file_size()).
+ */
+#define MEMORY_DEFAULT_SIZE (128u << 20)
+#define MEMORY_MAX_SIZE     (256u << 20)
+
 union memory_t {
-    uint8  bytes [134217728];
-    uint16 shorts[67108864];
-    uint32 ints  [33554432];
+    uint8  bytes [MEMORY_MAX_SIZE];
+    uint16 shorts[MEMORY_MAX_SIZE / 2];
+    uint32 ints  [MEMORY_MAX_SIZE / 4];
 };
 
 enum step_t {
@@ -38,6 +56,224 @@ struct processor_t {
     step_t mem_step;
 };
 
+//------------------------------------------------------------------------------ instances
+
+/* AO486_INSTANCE names a directory holding one co-simulation: shared_mem.dat,
+ * the control files and every output file. Several instances can then run
+ * from one checkout. When it is unset each process keeps its historical path,
+ * given as 'fallback'.
+ *
+ * The result lives in a small rotating static buffer: copy it if it is kept.
+ */
+static inline const char *instance_path(const char *name, const char *fallback) {
+    const char *dir = getenv("AO486_INSTANCE");
+    if(dir == NULL || dir[0] == 0) return fallback;
+    
+    static char buffers[8][512];
+    static uint32 next = 0;
+    
+    char *buffer = buffers[next++ % 8];
+    snprintf(buffer, sizeof(buffers[0]), "%s/%s", dir, name);
+    return buffer;
+}
+
+//------------------------------------------------------------------------------ lock-free transport
+
+/* Single-producer/single-consumer rings living in the shared mapping.
+ * The producer owns 'head', the consumer owns 'tail'; entries are published
+ * with a release store of 'head' and retired with a release store of 'tail'.
+ * The file is zero-filled on creation, which is a valid empty ring.
+ *
+ * 'sequence' is assigned by the producer from one counter shared by all of
+ * its request rings, so the consumer can merge the mem and io rings back
+ * into program order (transport_next()).
+ */
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "uint32 atomics must be lock-free to live in shared memory");
+
+#define RING_SIZE 1024
+
+struct transaction_t {
+    uint32 sequence;
+    uint32 address;
+    uint32 data;
+    uint32 byteenable;
+    uint32 is_write;
+};
+
+struct ring_t {
+    alignas(64) std::atomic<uint32> head;
+    alignas(64) std::atomic<uint32> tail;
+    alignas(64) transaction_t entries[RING_SIZE];
+};
+
+struct transport_t {
+    //cpu -> hub
+    ring_t mem_req;
+    ring_t io_req;
+
+    //hub -> cpu; io_resp carries read data and write completions
+    ring_t mem_resp;
+    ring_t io_resp;
+
+    //owned by the hub: the sequence of the next request it takes
+    alignas(64) std::atomic<uint32> next_sequence;
+};
+
+static inline ring_t *ring_cast(volatile ring_t *ring) {
+    return const_cast<ring_t *>(ring);
+}
+
+static inline bool ring_empty(volatile ring_t *vring) {
+    ring_t *ring = ring_cast(vring);
+    return ring->tail.load(std::memory_order_acquire) == ring->head.load(std::memory_order_acquire);
+}
+
+static inline bool ring_push(volatile ring_t *vring, const transaction_t &entry) {
+    ring_t *ring = ring_cast(vring);
+    uint32 head = ring->head.load(std::memory_order_relaxed);
+    if(head - ring->tail.load(std::memory_order_acquire) >= RING_SIZE) return false;
+
+    ring->entries[head % RING_SIZE] = entry;
+    ring->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+static inline bool ring_peek(volatile ring_t *vring, transaction_t &entry) {
+    ring_t *ring = ring_cast(vring);
+    uint32 tail = ring->tail.load(std::memory_order_relaxed);
+    if(tail == ring->head.load(std::memory_order_acquire)) return false;
+
+    entry = ring->entries[tail % RING_SIZE];
+    return true;
+}
+
+static inline void ring_pop(volatile ring_t *vring) {
+    ring_t *ring = ring_cast(vring);
+    ring->tail.store(ring->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+//spin briefly, then give the core away; never sleeps on a timer
+static inline void ring_backoff(uint32 &spins) {
+    spins++;
+    if(spins > 256) sched_yield();
+}
+
+static inline void transport_post(volatile ring_t *ring, uint32 &sequence, uint32 address, uint32 data, uint32 byteenable, uint32 is_write) {
+    transaction_t entry;
+    entry.sequence   = sequence++;
+    entry.address    = address;
+    entry.data       = data;
+    entry.byteenable = byteenable;
+    entry.is_write   = is_write;
+
+    uint32 spins = 0;
+    while(ring_push(ring, entry) == false) ring_backoff(spins);
+}
+
+static inline uint32 transport_wait(volatile ring_t *ring) {
+    transaction_t entry;
+
+    uint32 spins = 0;
+    while(ring_peek(ring, entry) == false) ring_backoff(spins);
+    ring_pop(ring);
+
+    return entry.data;
+}
+
+/* The hub side of the request rings: takes the request numbered
+ * next_sequence from the head of mem_req or io_req. The producer posts to one
+ * ring and then to the other without waiting, so a later request can already
+ * be at the head of one ring while the one before it is still being pushed to
+ * the other; nothing else than the next number is taken, the hub just asks
+ * again. The entry stays in its ring until the hub pops it.
+ */
+static inline bool transport_next(volatile transport_t *vtransport, transaction_t &entry, bool &is_io) {
+    transport_t *transport = const_cast<transport_t *>(vtransport);
+    uint32 next = transport->next_sequence.load(std::memory_order_relaxed);
+
+    if(ring_peek(&transport->mem_req, entry) && entry.sequence == next)     is_io = false;
+    else if(ring_peek(&transport->io_req, entry) && entry.sequence == next) is_io = true;
+    else return false;
+
+    transport->next_sequence.store(next + 1, std::memory_order_release);
+    return true;
+}
+
+//the sequence the hub waits for: a producer restored from a snapshot continues from it
+static inline uint32 transport_sequence(volatile transport_t *vtransport) {
+    return const_cast<transport_t *>(vtransport)->next_sequence.load(std::memory_order_acquire);
+}
+
+//wait until the consumer has retired every posted entry
+static inline void transport_drain(volatile ring_t *ring) {
+    uint32 spins = 0;
+    while(ring_empty(ring) == false) ring_backoff(spins);
+}
+
+//------------------------------------------------------------------------------ io dispatch
+
+/* Device plugins claim their ports with io_register()/io_claim() at startup
+ * and then count themselves in with io_ready(); sim_pc starts the cpus only
+ * once the expected number of devices is in, so no access can reach a port
+ * before its owner claimed it. The hub looks the port up in io_map and hands
+ * the access to the owning device's slot only, waking it with a futex. A port
+ * nobody claimed reads as a floating bus and ignores writes. io_map holds the
+ * slot index + 1, 0 is unclaimed.
+ *
+ * A device with nothing timed left blocks in io_wait() until the next access
+ * or the shutdown of sim_pc. One that keeps running between accesses calls
+ * io_pace() after each clock; it sleeps only when sim_pc runs with --io-pace.
+ */
+
+#define IO_DEVICE_MAX 16
+
+static_assert(sizeof(step_t) == sizeof(int), "io_step is used as a futex word");
+
+struct io_slot_t {
+    char   name[16];
+    
+    uint32 io_address;
+    uint32 io_data;
+    uint32 io_byteenable;
+    uint32 io_is_write;
+    step_t io_step;
+};
+
+//------------------------------------------------------------------------------ fast-forward handoff
+
+/* Architectural state at an instruction boundary, published by the reference
+ * model (sim/ref486) and loaded into the Verilated ao486 right after its
+ * reset (verilator/ao486/handoff.h). Registers are in x86 encoding order,
+ * segments in the ao486 order es, cs, ss, ds, fs, gs, ldtr, tr, each with the
+ * 64-bit descriptor ao486 keeps in its cache.
+ */
+struct arch_state_t {
+    uint32 instr_counter;
+    
+    uint32 regs[8];
+    uint32 eip;
+    uint32 eflags;
+    
+    uint32 cr0;
+    uint32 cr2;
+    uint32 cr3;
+    
+    uint32 gdtr_base;
+    uint32 gdtr_limit;
+    uint32 idtr_base;
+    uint32 idtr_limit;
+    
+    uint32 dr[8];
+    
+    uint16 seg_selector[8];
+    uint8  seg_rpl[8];
+    uint8  seg_valid[8];
+    uint64 seg_cache[8];
+};
+
+//------------------------------------------------------------------------------
+
 struct shared_mem_t {
     
     processor_t bochs486_pc;
@@ -66,8 +302,104 @@ struct shared_mem_t {
     uint32 irq_done_vector;
     step_t irq_done;
     
-    memory_t mem;
+    //REQ from the reference at its trigger, ACK from sim_pc once ao486 is started on it
+    arch_state_t handoff;
+    step_t       handoff_step;
+    uint32       handoff_lockstep;   //the reference keeps running in lockstep after the handoff
+    
+    //set by sim_pc for --lockstep and --fast-forward-lockstep: the ao486 harness must post its
+    //sdram writes to the hub, which pairs them with the reference
+    uint32 lockstep;
+    
+    transport_t ao486_transport;
+    
+    uint32    io_device_count;
+    uint32    io_ready_count;   //devices done with their claims
+    uint32    io_shutdown;      //set by sim_pc when it exits, every slot is woken
+    uint32    io_pace_ns;       //--io-pace: sleep of a running device between two clocks, 0 is none
+    uint8     io_map[65536];
+    io_slot_t io_slots[IO_DEVICE_MAX];
+    
+    //guest ram size in bytes, a power of two; set by sim_pc before any client starts
+    uint32 mem_size;
+    
+    //on its own huge page, so hugetlb backing maps whole pages
+    alignas(2 << 20) memory_t mem;
 };
 
+static inline uint64 shared_mem_file_size(uint32 mem_size) {
+    return offsetof(shared_mem_t, mem) + (uint64)mem_size;
+}
+
+//dword address mask for the configured ram size
+static inline uint32 mem_mask(volatile shared_mem_t *shared_ptr) {
+    return (shared_ptr->mem_size - 1) & 0xFFFFFFFC;
+}
+
+//lowest port touched by a dword access
+static inline uint32 io_port(uint32 address, uint32 byteenable) {
+    return (address + ((byteenable == 0)? 0 : __builtin_ctz(byteenable))) & 0xFFFF;
+}
+
+//a restarted plugin gets its old slot back
+static inline volatile io_slot_t *io_register(volatile shared_mem_t *shared_ptr, const char *name) {
+    for(uint32 i=0; i<shared_ptr->io_device_count && i<IO_DEVICE_MAX; i++) {
+        if(strncmp(const_cast<const char *>(shared_ptr->io_slots[i].name), name, sizeof(io_slot_t::name)) == 0) return &shared_ptr->io_slots[i];
+    }
+    
+    uint32 index = __atomic_fetch_add(&shared_ptr->io_device_count, 1, __ATOMIC_SEQ_CST);
+    if(index >= IO_DEVICE_MAX) return NULL;
+    
+    volatile io_slot_t *slot = &shared_ptr->io_slots[index];
+    strncpy(const_cast<char *>(slot->name), name, sizeof(io_slot_t::name) - 1);
+    slot->io_step = STEP_IDLE;
+    return slot;
+}
+
+static inline void io_claim(volatile shared_mem_t *shared_ptr, volatile io_slot_t *slot, uint32 first_port, uint32 last_port) {
+    uint8 value = (slot - shared_ptr->io_slots) + 1;
+    for(uint32 port=first_port; port<=last_port; port++) shared_ptr->io_map[port] = value;
+}
+
+//after the last io_claim() of a device
+static inline void io_ready(volatile shared_mem_t *shared_ptr) {
+    __atomic_fetch_add(&shared_ptr->io_ready_count, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline void io_wake(volatile io_slot_t *slot) {
+    syscall(SYS_futex, const_cast<step_t *>(&slot->io_step), FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/* Hub side, on exit. An idle slot is moved off STEP_IDLE before the wake, so a
+ * device between its io_shutdown check and the FUTEX_WAIT does not block
+ * either; device_running() then sees io_shutdown.
+ */
+static inline void io_wake_all(volatile shared_mem_t *shared_ptr) {
+    shared_ptr->io_shutdown = 1;
+    
+    for(uint32 i=0; i<shared_ptr->io_device_count && i<IO_DEVICE_MAX; i++) {
+        volatile io_slot_t *slot = &shared_ptr->io_slots[i];
+        
+        __sync_bool_compare_and_swap((int *)&slot->io_step, (int)STEP_IDLE, (int)STEP_ACK);
+        io_wake(slot);
+    }
+}
+
+//device side: block until the hub posts an access, sim_pc exits or a signal arrives
+static inline void io_wait(volatile shared_mem_t *shared_ptr, volatile io_slot_t *slot) {
+    if(slot->io_step != STEP_IDLE || shared_ptr->io_shutdown) return;
+    
+    syscall(SYS_futex, const_cast<step_t *>(&slot->io_step), FUTEX_WAIT, STEP_IDLE, NULL, NULL, 0);
+}
+
+//device side: sleep between two clocks of a running device, at most io_pace_ns; an access ends it
+static inline void io_pace(volatile shared_mem_t *shared_ptr, volatile io_slot_t *slot) {
+    uint32 pace_ns = shared_ptr->io_pace_ns;
+    if(pace_ns == 0 || slot->io_step != STEP_IDLE) return;
+    
+    struct timespec timeout = { (time_t)(pace_ns / 1000000000), (long)(pace_ns % 1000000000) };
+    syscall(SYS_futex, const_cast<step_t *>(&slot->io_step), FUTEX_WAIT, STEP_IDLE, &timeout, NULL, 0);
+}
+
 
 #endif //__SHARED_MEM_H
@@ -0,0 +1,107 @@
+/* Ordering test of the lock-free transport.
+ *
+ * First the race the hub has to survive, set up by hand: the hub found
+ * mem_req empty, then the cpu posted VGA write k and I/O k+1, and the hub
+ * looks at io_req. I/O k+1 must wait for the write.
+ *
+ * Then a producer thread posts VGA writes to mem_req without waiting and port
+ * I/O to io_req, the way the ao486 harness does, while the hub merges the
+ * rings with transport_next() and plays the devices. Every I/O carries the
+ * number of VGA writes posted before it; the io device checks that the vga
+ * device applied exactly that many when the access reaches it.
+ *
+ * usage: test_transport [rounds]
+ */
+
+#include <thread>
+
+#include "shared_mem.h"
+
+static transport_t transport;
+
+static void producer(uint32 rounds) {
+    uint32 sequence   = transport_sequence(&transport);
+    uint32 vga_posted = 0;
+    uint32 random     = 1;
+
+    for(uint32 i=0; i<rounds; i++) {
+        random = random * 1103515245 + 12345;
+
+        uint32 writes = (random >> 16) & 3;
+        for(uint32 j=0; j<writes; j++) {
+            transport_post(&transport.mem_req, sequence, 0xA0000 + 4 * (vga_posted % 0x4000), vga_posted, 0xF, 1);
+            vga_posted++;
+        }
+        if((random >> 20) & 1) sched_yield();
+
+        //io writes are answered too: the cpu side waits for every io access
+        transport_post(&transport.io_req, sequence, 0x3C4, vga_posted, 0xF, (random >> 24) & 1);
+        transport_wait(&transport.io_resp);
+    }
+    transport_drain(&transport.mem_req);
+}
+
+static bool scripted() {
+    transaction_t entry;
+    bool          is_io;
+
+    //VGA write 0 is still on its way, I/O 1 is already posted
+    transaction_t io = { 1, 0x3C4, 0, 0xF, 1 };
+    ring_push(&transport.io_req, io);
+    if(transport_next(&transport, entry, is_io)) {
+        printf("scripted: took %s %u before vga write 0\n", is_io? "io" : "vga write", entry.sequence);
+        return false;
+    }
+
+    transaction_t vga = { 0, 0xA0000, 0, 0xF, 1 };
+    ring_push(&transport.mem_req, vga);
+    bool first  = transport_next(&transport, entry, is_io) && is_io == false && entry.sequence == 0;
+    ring_pop(&transport.mem_req);
+    bool second = transport_next(&transport, entry, is_io) && is_io && entry.sequence == 1;
+    ring_pop(&transport.io_req);
+    if(first == false || second == false) {
+        printf("scripted: vga write 0 and io 1 not taken in order\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32 rounds = (argc > 1)? strtoul(argv[1], NULL, 0) : 1000000;
+
+    if(scripted() == false) return 1;
+
+    std::thread cpu(producer, rounds);
+
+    uint32 vga_applied = 0;
+    uint32 io_seen     = 0;
+    uint32 errors      = 0;
+    uint32 spins       = 0;
+
+    while(io_seen < rounds || ring_empty(&transport.mem_req) == false) {
+        transaction_t entry;
+        bool          is_io;
+
+        if(transport_next(&transport, entry, is_io) == false) {
+            ring_backoff(spins);
+            continue;
+        }
+        spins = 0;
+
+        if(is_io == false) {
+            if(entry.data != vga_applied && errors++ < 10) printf("vga write %u applied as %u\n", entry.data, vga_applied);
+            vga_applied++;
+            ring_pop(&transport.mem_req);
+        }
+        else {
+            if(entry.data != vga_applied && errors++ < 10) printf("io %u: saw %u vga writes, %u were posted before it\n", io_seen, vga_applied, entry.data);
+            io_seen++;
+            transport_post(&transport.io_resp, entry.sequence, entry.address, 0, entry.byteenable, entry.is_write);
+            ring_pop(&transport.io_req);
+        }
+    }
+    cpu.join();
+
+    printf("%u io accesses, %u vga writes, %u out of order\n", io_seen, vga_applied, errors);
+    return (errors == 0)? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#ifndef __HANDOFF_H
+#define __HANDOFF_H
+
+#include "shared_mem.h"
+
+/* Fast-forward: the reference model (sim/ref486) runs the boot and publishes
+ * its architectural state in shared_mem_t::handoff; the model is loaded with
+ * it between the last reset edge and the first edge out of reset. At that
+ * point the pipeline, the prefetch queue, the icache and the tlb are empty,
+ * so the registers below are all the state there is. They are public only in
+ * the models built with handoff.vlt (make main_handoff, main_plugin_handoff
+ * and main_stress); the main.cpp including this needs Vmain___024root.h.
+ *
+ * Not transferred: the fpu, the interrupt shadow of sti/mov ss (the reference
+ * does not hand off inside one) and the busy state of a debug breakpoint.
+ */
+
+#define HANDOFF_WR  main__DOT__ao486_inst__DOT__pipeline_inst__DOT__write_inst__DOT__write_register_inst__DOT__
+#define HANDOFF_W   main__DOT__ao486_inst__DOT__pipeline_inst__DOT__write_inst__DOT__
+#define HANDOFF_DEC main__DOT__ao486_inst__DOT__pipeline_inst__DOT__decode_inst__DOT__
+#define HANDOFF_PF  main__DOT__ao486_inst__DOT__memory_inst__DOT__prefetch_inst__DOT__
+
+#define HANDOFF_PASTE(prefix, name) prefix##name
+#define HANDOFF_SIGNAL(prefix, name) top->rootp->HANDOFF_PASTE(prefix, name)
+
+//base and byte limit of an ao486 descriptor cache entry
+static inline uint32 handoff_base(uint64 cache) {
+    return ((cache >> 16) & 0xFFFFFF) | ((cache >> 32) & 0xFF000000);
+}
+
+static inline uint32 handoff_limit(uint64 cache) {
+    uint32 limit = (cache & 0xFFFF) | ((cache >> 32) & 0x000F0000);
+    return (cache & (1ULL << 55))? ((limit << 12) | 0xFFF) : limit;
+}
+
+template<class T>
+void handoff_load(T *top, const volatile arch_state_t &state) {
+    const volatile uint32 *regs = state.regs;
+
+    HANDOFF_SIGNAL(HANDOFF_WR, eax) = regs[0];
+    HANDOFF_SIGNAL(HANDOFF_WR, ecx) = regs[1];
+    HANDOFF_SIGNAL(HANDOFF_WR, edx) = regs[2];
+    HANDOFF_SIGNAL(HANDOFF_WR, ebx) = regs[3];
+    HANDOFF_SIGNAL(HANDOFF_WR, esp) = regs[4];
+    HANDOFF_SIGNAL(HANDOFF_WR, ebp) = regs[5];
+    HANDOFF_SIGNAL(HANDOFF_WR, esi) = regs[6];
+    HANDOFF_SIGNAL(HANDOFF_WR, edi) = regs[7];
+
+    uint32 cr0 = state.cr0;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_pe) = (cr0 >> 0) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_mp) = (cr0 >> 1) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_em) = (cr0 >> 2) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_ts) = (cr0 >> 3) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_ne) = (cr0 >> 5) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_wp) = (cr0 >> 16) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_am) = (cr0 >> 18) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_nw) = (cr0 >> 29) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_cd) = (cr0 >> 30) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr0_pg) = (cr0 >> 31) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr2)    = state.cr2;
+    HANDOFF_SIGNAL(HANDOFF_WR, cr3)    = state.cr3;
+
+    uint32 eflags = state.eflags;
+    HANDOFF_SIGNAL(HANDOFF_WR, cflag)  = (eflags >> 0) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, pflag)  = (eflags >> 2) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, aflag)  = (eflags >> 4) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, zflag)  = (eflags >> 6) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, sflag)  = (eflags >> 7) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, tflag)  = (eflags >> 8) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, iflag)  = (eflags >> 9) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, dflag)  = (eflags >> 10) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, oflag)  = (eflags >> 11) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, iopl)   = (eflags >> 12) & 3;
+    HANDOFF_SIGNAL(HANDOFF_WR, ntflag) = (eflags >> 14) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, rflag)  = (eflags >> 16) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, vmflag) = (eflags >> 17) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, acflag) = (eflags >> 18) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, idflag) = (eflags >> 21) & 1;
+
+    HANDOFF_SIGNAL(HANDOFF_WR, gdtr_base)  = state.gdtr_base;
+    HANDOFF_SIGNAL(HANDOFF_WR, gdtr_limit) = state.gdtr_limit & 0xFFFF;
+    HANDOFF_SIGNAL(HANDOFF_WR, idtr_base)  = state.idtr_base;
+    HANDOFF_SIGNAL(HANDOFF_WR, idtr_limit) = state.idtr_limit & 0xFFFF;
+
+    uint32 dr6 = state.dr[6];
+    HANDOFF_SIGNAL(HANDOFF_WR, dr0)             = state.dr[0];
+    HANDOFF_SIGNAL(HANDOFF_WR, dr1)             = state.dr[1];
+    HANDOFF_SIGNAL(HANDOFF_WR, dr2)             = state.dr[2];
+    HANDOFF_SIGNAL(HANDOFF_WR, dr3)             = state.dr[3];
+    HANDOFF_SIGNAL(HANDOFF_WR, dr6_breakpoints) = dr6 & 0xF;
+    HANDOFF_SIGNAL(HANDOFF_WR, dr6_b12)         = (dr6 >> 12) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, dr6_bd)          = (dr6 >> 13) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, dr6_bs)          = (dr6 >> 14) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, dr6_bt)          = (dr6 >> 15) & 1;
+    HANDOFF_SIGNAL(HANDOFF_WR, dr7)             = state.dr[7];
+
+    //segments in the ao486 order: es, cs, ss, ds, fs, gs, ldtr, tr
+#define HANDOFF_SEGMENT(index, name) \
+    HANDOFF_SIGNAL(HANDOFF_WR, name)               = state.seg_selector[index]; \
+    HANDOFF_SIGNAL(HANDOFF_WR, name##_rpl)         = state.seg_rpl[index] & 3;  \
+    HANDOFF_SIGNAL(HANDOFF_WR, name##_cache)       = state.seg_cache[index];    \
+    HANDOFF_SIGNAL(HANDOFF_WR, name##_cache_valid) = state.seg_valid[index] & 1;
+
+    HANDOFF_SEGMENT(0, es)
+    HANDOFF_SEGMENT(1, cs)
+    HANDOFF_SEGMENT(2, ss)
+    HANDOFF_SEGMENT(3, ds)
+    HANDOFF_SEGMENT(4, fs)
+    HANDOFF_SEGMENT(5, gs)
+    HANDOFF_SEGMENT(6, ldtr)
+    HANDOFF_SEGMENT(7, tr)
+#undef HANDOFF_SEGMENT
+
+    //fetch restarts at cs:eip, as after a far jump
+    uint32 eip      = state.eip;
+    uint32 cs_base  = handoff_base(state.seg_cache[1]);
+    uint32 cs_limit = handoff_limit(state.seg_cache[1]);
+
+    HANDOFF_SIGNAL(HANDOFF_W,   wr_eip)        = eip;
+    HANDOFF_SIGNAL(HANDOFF_DEC, eip)           = eip;
+    HANDOFF_SIGNAL(HANDOFF_PF,  linear)        = cs_base + eip;
+    HANDOFF_SIGNAL(HANDOFF_PF,  delivered_eip) = cs_base + eip;
+    HANDOFF_SIGNAL(HANDOFF_PF,  limit)         = (cs_limit >= eip)? cs_limit - eip + 1 : 0;
+}
+
+#endif //__HANDOFF_H
@@ -1,5 +1,7 @@
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <csignal>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -8,20 +10,162 @@
 #include <unistd.h>
 
 #include "Vmain.h"
+#include "Vmain___024root.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
+#include "verilated_fst_c.h"
 
 #include "shared_mem.h"
+#ifdef HANDOFF
+#include "handoff.h"
+#endif
+#include "snapshot.h"
+#include "profile.h"
+#include "perf.h"
 
 //------------------------------------------------------------------------------
 
 volatile shared_mem_t *shared_ptr = NULL;
 
+//------------------------------------------------------------------------------ trace window
+
+/* Tracing is off unless asked for: by the hub through dump_enabled, or by a
+ * window on the command line. A window is bounded by cycle and/or by
+ * instr_counter; a zero stop bound means open-ended. With --trace-last N the
+ * window is written into two alternating files of N cycles each, so the
+ * last N..2N cycles before the run stops are always on disk.
+ *
+ * --trace-last is not an exact last-N window: the run ends with <name>.0.fst
+ * and <name>.1.fst, the older one complete and the newer one partial. Open
+ * both, in segment order, to see the cycles before the stop.
+ */
+
+struct trace_config_t {
+    const char *name;
+    bool        window;
+    uint64      start_cycle;
+    uint64      stop_cycle;
+    uint32      start_instr;
+    uint32      stop_instr;
+    uint64      ring_cycles;
+};
+
+struct trace_t {
+    VerilatedFstC *fst;
+    bool           open;
+    uint32         segment;
+    uint64         segment_start;
+};
+
+volatile sig_atomic_t stop_requested = 0;
+
+void stop_handler(int) {
+    stop_requested = 1;
+}
+
+bool trace_wanted(const trace_config_t &config, uint64 cycle, uint32 instr_counter) {
+    if(shared_ptr->dump_enabled) return true;
+    if(config.window == false)   return false;
+
+    return cycle >= config.start_cycle && (config.stop_cycle == 0 || cycle < config.stop_cycle) &&
+           instr_counter >= config.start_instr && (config.stop_instr == 0 || instr_counter < config.stop_instr);
+}
+
+void trace_open(const trace_config_t &config, trace_t &trace, uint64 cycle) {
+    char name[256];
+    if(config.ring_cycles > 0) snprintf(name, sizeof(name), "%s.%d.fst", config.name, trace.segment);
+    else                       snprintf(name, sizeof(name), "%s.fst", config.name);
+
+    trace.fst->open(name);
+    trace.open          = true;
+    trace.segment_start = cycle;
+}
+
+void trace_close(trace_t &trace) {
+    if(trace.open == false) return;
+    trace.fst->close();
+    trace.open = false;
+}
+
+void trace_dump(const trace_config_t &config, trace_t &trace, uint64 cycle, uint32 instr_counter) {
+    if(trace_wanted(config, cycle, instr_counter) == false) {
+        //a plain window closes for good; the ring keeps its last segment
+        if(trace.open && config.ring_cycles == 0) trace_close(trace);
+        return;
+    }
+
+    if(trace.open && config.ring_cycles > 0 && cycle - trace.segment_start >= config.ring_cycles) {
+        trace_close(trace);
+        trace.segment ^= 1;
+    }
+    if(trace.open == false) trace_open(config, trace, cycle);
+
+    trace.fst->dump(cycle);
+}
+
 //------------------------------------------------------------------------------
 
 int main(int argc, char **argv) {
+    //snapshot options; anything else is passed on to Verilated
+    uint32      save_at      = 0;
+    const char *save_file    = NULL;
+    const char *restore_file = NULL;
+    bool        hub_writes   = false;
+    bool        verbose      = false;
+    
+    const char *profile_file = NULL;
+    profile_t   profile;
+    profile_init(profile);
+    
+    const char *perf_file = NULL;
+    perf_t      perf;
+    perf_init(perf);
+    
+    trace_config_t trace_config;
+    memset(&trace_config, 0, sizeof(trace_config));
+    trace_config.name = strdup(instance_path("ao486", "ao486"));
+    
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--save-at") == 0 && i+1 < argc)      save_at      = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--save") == 0 && i+1 < argc)    save_file    = argv[++i];
+        else if(strcmp(argv[i], "--restore") == 0 && i+1 < argc) restore_file = argv[++i];
+        else if(strcmp(argv[i], "--hub-writes") == 0)            hub_writes   = true;
+        
+        //one line per sdram write, vga/io access and interrupt edge; off, the loop does no console io
+        else if(strcmp(argv[i], "--verbose") == 0)               verbose      = true;
+        
+        //eip profile; --profile-sym takes <file>[@<linear base>], the bios by default
+        else if(strcmp(argv[i], "--profile") == 0 && i+1 < argc)       profile_file = argv[++i];
+        else if(strcmp(argv[i], "--profile-range") == 0 && i+1 < argc) profile.range_shift = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--profile-sym") == 0 && i+1 < argc) {
+            char   *name = strdup(argv[++i]);
+            char   *at   = strchr(name, '@');
+            uint32  base = 0xF0000;
+            if(at != NULL) {
+                *at  = 0;
+                base = strtoul(at + 1, NULL, 0);
+            }
+            if(profile_load_symbols(profile, name, base) == false) fprintf(stderr, "Can not load symbols %s\n", name);
+            free(name);
+        }
+        
+        //pipeline counters; --perf-window adds <file>.csv with one line per window of instructions
+        else if(strcmp(argv[i], "--perf") == 0 && i+1 < argc)        perf_file         = argv[++i];
+        else if(strcmp(argv[i], "--perf-window") == 0 && i+1 < argc) perf.window_instr = strtoul(argv[++i], NULL, 0);
+        
+        //trace window; cycles count half-cycles, as the dump timestamps do
+        else if(strcmp(argv[i], "--trace") == 0 && i+1 < argc)             { trace_config.name        = argv[++i];                          trace_config.window = true; }
+        else if(strcmp(argv[i], "--trace-start-cycle") == 0 && i+1 < argc) { trace_config.start_cycle = strtoull(argv[++i], NULL, 0);       trace_config.window = true; }
+        else if(strcmp(argv[i], "--trace-stop-cycle") == 0 && i+1 < argc)  { trace_config.stop_cycle  = strtoull(argv[++i], NULL, 0);       trace_config.window = true; }
+        else if(strcmp(argv[i], "--trace-start-instr") == 0 && i+1 < argc) { trace_config.start_instr = strtoul(argv[++i], NULL, 0);        trace_config.window = true; }
+        else if(strcmp(argv[i], "--trace-stop-instr") == 0 && i+1 < argc)  { trace_config.stop_instr  = strtoul(argv[++i], NULL, 0);        trace_config.window = true; }
+        else if(strcmp(argv[i], "--trace-last") == 0 && i+1 < argc)        { trace_config.ring_cycles = strtoull(argv[++i], NULL, 0);       trace_config.window = true; }
+    }
+    
+    signal(SIGINT,  stop_handler);
+    signal(SIGTERM, stop_handler);
+    
     //map shared memory
-    int fd = open("./../../../sim/sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
+    int fd = open(instance_path("shared_mem.dat", "./../../../sim/sim_pc/shared_mem.dat"), O_RDWR, S_IRUSR | S_IWUSR);
     
     if(fd == -1) {
         perror("open() failed for shared_mem.dat");
@@ -44,6 +188,12 @@ int main(int argc, char **argv) {
         usleep(100000);
     }
     printf("done.\n");
+    
+    //the lockstep check in sim_pc pairs every ao486 write with the reference
+    if(shared_ptr->lockstep && hub_writes == false) {
+        printf("lockstep run: sdram writes go through the hub\n");
+        hub_writes = true;
+    }
 
     //--------------------------------------------------------------------------
     
@@ -51,52 +201,95 @@ int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     
     Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
+    
+    trace_t trace;
+    memset(&trace, 0, sizeof(trace));
+    trace.fst = new VerilatedFstC;
     
     Vmain *top = new Vmain();
-    top->trace (tracer, 99);
-    tracer->rolloverMB(1000000);
-    tracer->open("ao486.vcd");
-//tracer->flush();
-//return 0;
+    top->trace(trace.fst, 99);
     //reset
     top->clk = 0; top->rst_n = 1; top->eval();
     top->clk = 1; top->rst_n = 1; top->eval();
     top->clk = 1; top->rst_n = 0; top->eval();
     top->clk = 0; top->rst_n = 0; top->eval();
+    
+    //fast-forward: start from the state of the reference instead of the reset vector
+    if(shared_ptr->handoff_step != STEP_IDLE && restore_file == NULL) {
+#ifdef HANDOFF
+        handoff_load(top, shared_ptr->handoff);
+        printf("handoff at instr_counter %d, eip %08x\n", shared_ptr->handoff.instr_counter, shared_ptr->handoff.eip);
+#else
+        printf("ERROR: fast-forward needs the handoff build, make main_handoff\n");
+        return -1;
+#endif
+    }
+    
     top->clk = 0; top->rst_n = 1; top->eval();
     
     //--------------------------------------------------------------------------
     
-    uint32 sdram_read_count = 0;
-    uint32 sdram_read_data[4];
+    harness_state_t state;
+    memset(&state, 0, sizeof(state));
+    
+    uint32 &sdram_read_count = state.sdram_read_count;
+    uint32 (&sdram_read_data)[4] = state.sdram_read_data;
+    
+    uint32 &sdram_write_count = state.sdram_write_count;
+    uint32 &sdram_write_address = state.sdram_write_address;
+    
+    uint32 &vga_read_count = state.vga_read_count;
+    uint32 &vga_read_address = state.vga_read_address;
+    uint32 &vga_read_byteenable = state.vga_read_byteenable;
     
-    uint32 sdram_write_count = 0;
-    uint32 sdram_write_address = 0;
+    uint32 &vga_write_count = state.vga_write_count;
+    uint32 &vga_write_address = state.vga_write_address;
     
-    uint32 vga_read_count = 0;
-    uint32 vga_read_address = 0;
-    uint32 vga_read_byteenable = 0;
+    uint32 &io_read_count = state.io_read_count;
+    uint32 &io_read_address = state.io_read_address;
+    uint32 &io_read_byteenable = state.io_read_byteenable;
     
-    uint32 vga_write_count = 0;
-    uint32 vga_write_address = 0;
+    uint32 &ignored_intr_counter = state.ignored_intr_counter;
     
-    uint32 io_read_count = 0;
-    uint32 io_read_address = 0;
-    uint32 io_read_byteenable = 0;
+    volatile transport_t *transport = &shared_ptr->ao486_transport;
+    uint32 &sequence = state.sequence;
     
-    uint32 ignored_intr_counter = 0;
+    if(restore_file != NULL) {
+        if(snapshot_restore(restore_file, top, state, shared_ptr) == false) {
+            fprintf(stderr, "Can not restore snapshot %s\n", restore_file);
+            return -3;
+        }
+        printf("restored %s at instr_counter %d\n", restore_file, shared_ptr->ao486.instr_counter);
+        
+        //sim_pc starts with a fresh transport
+        sequence = transport_sequence(transport);
+    }
+    profile.last_clock = state.cycle / 2;
+    if(perf_file != NULL && perf_open(perf, perf_file, shared_ptr->ao486.instr_counter) == false) fprintf(stderr, "Can not open %s.csv\n", perf_file);
+    bool save_pending = false;
     
     //--------------------------------------------------------------------------
     
-    uint64 cycle = 0;
-    while(!Verilated::gotFinish()) {
+    uint64 &cycle = state.cycle;
+    while(!Verilated::gotFinish() && !stop_requested) {
         
         //----------------------------------------------------------------------
+        if(perf_file != NULL) {
+            uint8 states[PERF_STAGES] = { top->perf_fetch, top->perf_decode, top->perf_micro, top->perf_read, top->perf_execute, top->perf_write };
+            perf_clock(perf, states);
+        }
+        
         if(top->tb_finish_instr) {
             shared_ptr->ao486.instr_counter++;
             
+            //cycle counts half-cycles
+            if(profile_file != NULL) profile_retire(profile, top->prof_cs_base + top->prof_eip, cycle / 2);
+            if(perf_file != NULL)    perf_retire(perf, shared_ptr->ao486.instr_counter);
+            
+            if(save_at != 0 && shared_ptr->ao486.instr_counter == save_at) save_pending = true;
+            
             if(shared_ptr->ao486.stop == STEP_REQ) {
+                transport_drain(&transport->mem_req);
                 shared_ptr->ao486.stop = STEP_ACK;
                 while(shared_ptr->ao486.stop != STEP_IDLE) {
                     usleep(500);
@@ -109,7 +302,10 @@ int main(int argc, char **argv) {
         top->sdram_readdatavalid = 0;
         
         if(top->sdram_read) {
-            uint32 address = top->sdram_address & 0x07FFFFFC;
+            //sdram is read straight from the shared mapping: with hub writes, retire them first
+            if(hub_writes) transport_drain(&transport->mem_req);
+            
+            uint32 address = top->sdram_address & mem_mask(shared_ptr);
             
             for(uint32 i=0; i<4; i++) {
                 sdram_read_data[i] = shared_ptr->mem.ints[(address + i*4)/4];
@@ -131,7 +327,7 @@ int main(int argc, char **argv) {
         }
         
         if(top->sdram_write) {
-            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & 0x07FFFFFC;
+            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & mem_mask(shared_ptr);
             uint32 data = top->sdram_writedata;
             
             if((top->sdram_byteenable & 0x1) == 0) data &= 0xFFFFFF00;
@@ -139,25 +335,24 @@ int main(int argc, char **argv) {
             if((top->sdram_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->sdram_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-printf("sdram write: %08x %x %08x %d", address, top->sdram_byteenable, data, sdram_write_count);
-            shared_ptr->ao486.mem_address    = address;
-            shared_ptr->ao486.mem_byteenable = top->sdram_byteenable;
-            shared_ptr->ao486.mem_is_write   = 1;
-            shared_ptr->ao486.mem_data       = data;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
+if(verbose) printf("sdram write: %08x %x %08x %d", address, top->sdram_byteenable, data, sdram_write_count);
+            if(hub_writes) {
+                transport_post(&transport->mem_req, sequence, address, data, top->sdram_byteenable, 1);
+            }
+            else {
+                //outside a lockstep run with bochs486 nothing else writes sdram, so the write lands at once
+                for(uint32 i=0; i<4; i++) {
+                    if((top->sdram_byteenable >> i) & 1) shared_ptr->mem.bytes[address + i] = (data >> (i*8)) & 0xFF;
+                }
             }
-            shared_ptr->ao486.mem_step = STEP_IDLE;
             
             if(sdram_write_count == 0) {
-                sdram_write_address = (address + 4) & 0x07FFFFFC;
+                sdram_write_address = (address + 4) & mem_mask(shared_ptr);
                 sdram_write_count = top->sdram_burstcount;
             }
             
             if(sdram_write_count > 0) sdram_write_count--;
-printf("\n");
+if(verbose) printf("\n");
         }
         
         //---------------------------------------------------------------------- vga
@@ -169,26 +364,19 @@ printf("\n");
 
             vga_read_count = top->vga_burstcount;
             vga_read_byteenable = top->vga_byteenable;
-printf("vga read: %08x %x %d\n", vga_read_address, vga_read_byteenable, vga_read_count);
+if(verbose) printf("vga read: %08x %x %d\n", vga_read_address, vga_read_byteenable, vga_read_count);
         }
         else if(vga_read_count > 0) {
-            shared_ptr->ao486.mem_address    = vga_read_address;
-            shared_ptr->ao486.mem_byteenable = vga_read_byteenable;
-            shared_ptr->ao486.mem_is_write   = 0;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            uint32 value = shared_ptr->ao486.mem_data;
-            shared_ptr->ao486.mem_step = STEP_IDLE;
+            //vga writes stay posted: the read queues behind them in mem_req
+            transport_post(&transport->mem_req, sequence, vga_read_address, 0, vga_read_byteenable, 0);
+            uint32 value = transport_wait(&transport->mem_resp);
             
             top->vga_readdatavalid = 1;
             top->vga_readdata = value;
             
             vga_read_address = (vga_read_address + 4) & 0x000FFFFC;
             vga_read_count--;
-printf("\n");
+if(verbose) printf("\n");
         }
         
         if(top->vga_write) {
@@ -200,17 +388,8 @@ printf("\n");
             if((top->vga_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->vga_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-printf("vga write: %08x %x %08x %d", address, top->sdram_byteenable, data, vga_write_count);
-            shared_ptr->ao486.mem_address    = address;
-            shared_ptr->ao486.mem_byteenable = top->vga_byteenable;
-            shared_ptr->ao486.mem_is_write   = 1;
-            shared_ptr->ao486.mem_data       = data;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            shared_ptr->ao486.mem_step = STEP_IDLE;
+if(verbose) printf("vga write: %08x %x %08x %d", address, top->sdram_byteenable, data, vga_write_count);
+            transport_post(&transport->mem_req, sequence, address, data, top->vga_byteenable, 1);
             
             if(vga_write_count == 0) {
                 vga_write_address = (address + 4) & 0x07FFFFFC;
@@ -218,7 +397,7 @@ printf("vga write: %08x %x %08x %d", address, top->sdram_byteenable, data, vga_w
             }
             
             if(vga_write_count > 0) vga_write_count--;
-printf("\n", vga_write_count);
+if(verbose) printf(" left %u\n", vga_write_count);
         }
         
         //---------------------------------------------------------------------- io
@@ -230,25 +409,17 @@ printf("\n", vga_write_count);
 
             io_read_count = 1;
             io_read_byteenable = top->avalon_io_byteenable;
-printf("io read: %08x %x %d", io_read_address, io_read_byteenable, io_read_count);
+if(verbose) printf("io read: %08x %x %d", io_read_address, io_read_byteenable, io_read_count);
         }
         else if(io_read_count > 0) {
-            shared_ptr->ao486.io_address    = io_read_address;
-            shared_ptr->ao486.io_byteenable = io_read_byteenable;
-            shared_ptr->ao486.io_is_write   = 0;
-            shared_ptr->ao486.io_step       = STEP_REQ;
-            while(shared_ptr->ao486.io_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            uint32 value = shared_ptr->ao486.io_data;
-            shared_ptr->ao486.io_step = STEP_IDLE;
+            transport_post(&transport->io_req, sequence, io_read_address, 0, io_read_byteenable, 0);
+            uint32 value = transport_wait(&transport->io_resp);
             
             top->avalon_io_readdatavalid = 1;
             top->avalon_io_readdata = value;
             
             io_read_count--;
-printf("\n");
+if(verbose) printf("\n");
         }
         
         if(top->avalon_io_write) {
@@ -259,18 +430,10 @@ printf("\n");
             if((top->avalon_io_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->avalon_io_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-printf("io write: %08x %x %08x", (top->avalon_io_address & 0x0000FFFC), top->avalon_io_byteenable, data);
-            shared_ptr->ao486.io_address    = top->avalon_io_address & 0x0000FFFC;
-            shared_ptr->ao486.io_byteenable = top->avalon_io_byteenable;
-            shared_ptr->ao486.io_is_write   = 1;
-            shared_ptr->ao486.io_data       = data;
-            shared_ptr->ao486.io_step       = STEP_REQ;
-            while(shared_ptr->ao486.io_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            shared_ptr->ao486.io_step = STEP_IDLE;
-printf("\n");
+if(verbose) printf("io write: %08x %x %08x", (top->avalon_io_address & 0x0000FFFC), top->avalon_io_byteenable, data);
+            transport_post(&transport->io_req, sequence, top->avalon_io_address & 0x0000FFFC, data, top->avalon_io_byteenable, 1);
+            transport_wait(&transport->io_resp);
+if(verbose) printf("\n");
         }
         
         //---------------------------------------------------------------------- interrupt
@@ -278,16 +441,16 @@ printf("\n");
         top->interrupt_vector = shared_ptr->interrupt_vector;
         
         if(top->interrupt_do && top->interrupt_done) {
-printf("irq done at %d\n", shared_ptr->ao486.instr_counter);
+if(verbose) printf("irq done at %d\n", shared_ptr->ao486.instr_counter);
             top->interrupt_do = 0;
             ignored_intr_counter = shared_ptr->ao486.instr_counter;
         }
         else if(ignored_intr_counter != shared_ptr->ao486.instr_counter && shared_ptr->interrupt_at_counter == shared_ptr->ao486.instr_counter) {
-printf("irq do %02x at %d\n", top->interrupt_vector, shared_ptr->ao486.instr_counter);
+if(verbose) printf("irq do %02x at %d\n", top->interrupt_vector, shared_ptr->ao486.instr_counter);
             top->interrupt_do = 1; 
         }
         else if(shared_ptr->interrupt_at_counter == 0) {
-printf("irq lower at %d\n", shared_ptr->ao486.instr_counter);
+if(verbose) printf("irq lower at %d\n", shared_ptr->ao486.instr_counter);
             top->interrupt_do = 0;
         }
         
@@ -302,20 +465,39 @@ printf("irq lower at %d\n", shared_ptr->ao486.instr_counter);
         top->eval();
         
         cycle++;
-        if(shared_ptr->dump_enabled) tracer->dump(cycle);
+        trace_dump(trace_config, trace, cycle, shared_ptr->ao486.instr_counter);
         
         top->clk = 1;
         top->eval();
         
         cycle++;
-        if(shared_ptr->dump_enabled) tracer->dump(cycle);
+        trace_dump(trace_config, trace, cycle, shared_ptr->ao486.instr_counter);
         
-        if((cycle % 10000) == 0) printf("half-cycle: %lld\n", cycle);
+        if(verbose && (cycle % 10000) == 0) printf("half-cycle: %lld\n", cycle);
         //12320000
         
-        tracer->flush();
         //usleep(1);
+        
+        //between two cycles, with every posted write retired
+        if(save_pending) {
+            transport_drain(&transport->mem_req);
+            
+            char name[256];
+            if(save_file != NULL) snprintf(name, sizeof(name), "%s", save_file);
+            else                  snprintf(name, sizeof(name), "ao486_%u.snap", save_at);
+            
+            if(snapshot_save(name, top, state, shared_ptr)) printf("saved %s at instr_counter %d\n", name, shared_ptr->ao486.instr_counter);
+            else                                            fprintf(stderr, "Can not save snapshot %s\n", name);
+            save_pending = false;
+        }
     }
+    trace_close(trace);
+    
+    if(profile_file != NULL && profile_write(profile, profile_file) == false) fprintf(stderr, "Can not write profile %s\n", profile_file);
+    if(perf_file != NULL && perf_write(perf, perf_file, shared_ptr->ao486.instr_counter) == false) fprintf(stderr, "Can not write %s\n", perf_file);
+    delete trace.fst;
+    
+    top->final();
     delete top;
     return 0;
 }
@@ -46,6 +46,18 @@ module main(
     output              tb_finish_instr,
     //SW
     
+    //retiring instruction, sampled with tb_finish_instr for the eip profile
+    output  [31:0]      prof_eip,
+    output  [31:0]      prof_cs_base,
+    
+    //per-stage state for the pipeline counters, one PERF_* code each, see perf.h
+    output  [2:0]       perf_fetch,
+    output  [2:0]       perf_decode,
+    output  [2:0]       perf_micro,
+    output  [2:0]       perf_read,
+    output  [2:0]       perf_execute,
+    output  [2:0]       perf_write,
+    
     output  [15:0]      dbg_io_address,
     output  [3:0]       dbg_io_byteenable,
     output              dbg_io_write,
@@ -155,6 +167,94 @@ ao486 ao486_inst(
 
 //------------------------------------------------------------------------------
 
+//wr_eip already points past the instruction in the write stage, or at the
+//target of a taken JMP/Jcc/CALL/RET/IRET or interrupt: the start of the
+//instruction is taken from execute, as it moves into the write stage
+reg [31:0] prof_eip_start;
+reg [31:0] prof_cs_base_start;
+
+always @(posedge clk) begin
+    if(rst_n == 1'b0) begin
+        prof_eip_start     <= 32'h0000FFF0;
+        prof_cs_base_start <= 32'hFFFF0000;
+    end
+    else if(ao486_inst.pipeline_inst.write_inst.w_load) begin
+        prof_eip_start     <= ao486_inst.pipeline_inst.execute_inst.exe_eip - { 28'd0, ao486_inst.pipeline_inst.execute_inst.exe_consumed };
+        prof_cs_base_start <= { ao486_inst.pipeline_inst.write_inst.cs_cache[63:56], ao486_inst.pipeline_inst.write_inst.cs_cache[39:16] };
+    end
+end
+
+assign prof_eip     = prof_eip_start;
+assign prof_cs_base = prof_cs_base_start;
+
+//------------------------------------------------------------------------------ pipeline stage state
+
+localparam [2:0] PERF_EMPTY   = 3'd0; //nothing to do
+localparam [2:0] PERF_BUSY    = 3'd1; //hands its command on this cycle
+localparam [2:0] PERF_MUTEX   = 3'd2; //waiting on a register/memory mutex or a multi-cycle step
+localparam [2:0] PERF_MEMORY  = 3'd3; //waiting on a memory, io or tlb request
+localparam [2:0] PERF_BLOCKED = 3'd4; //next stage not ready
+
+wire fetch_empty = ao486_inst.pipeline_inst.fetch_inst.prefetchfifo_accept_empty;
+wire fetch_full  = ao486_inst.pipeline_inst.fetch_inst.dec_acceptable == 4'd0;
+
+assign perf_fetch =
+    (fetch_empty)?  PERF_MEMORY :
+    (fetch_full)?   PERF_BLOCKED :
+                    PERF_BUSY;
+
+assign perf_decode =
+    (ao486_inst.pipeline_inst.decode_inst.dec_ready)?    PERF_BUSY :
+    (ao486_inst.pipeline_inst.decode_inst.micro_busy)?   PERF_BLOCKED :
+                                                         PERF_EMPTY;
+
+wire micro_overlay = ao486_inst.pipeline_inst.microcode_inst.m_overlay;
+
+assign perf_micro =
+    (ao486_inst.pipeline_inst.microcode_inst.micro_ready)?              PERF_BUSY :
+    (micro_overlay && ao486_inst.pipeline_inst.microcode_inst.rd_busy)? PERF_BLOCKED :
+                                                                        PERF_EMPTY;
+
+wire read_memory =
+    (ao486_inst.pipeline_inst.read_inst.read_do    && ~ao486_inst.pipeline_inst.read_inst.read_done) ||
+    (ao486_inst.pipeline_inst.read_inst.io_read_do && ~ao486_inst.pipeline_inst.read_inst.io_read_done);
+
+//7'd0 is `CMD_NULL
+assign perf_read =
+    (ao486_inst.pipeline_inst.read_inst.rd_cmd == 7'd0)?        PERF_EMPTY :
+    (ao486_inst.pipeline_inst.read_inst.rd_ready)?              PERF_BUSY :
+    (read_memory)?                                              PERF_MEMORY :
+    (ao486_inst.pipeline_inst.read_inst.rd_waiting)?            PERF_MUTEX :
+    (ao486_inst.pipeline_inst.read_inst.exe_busy)?              PERF_BLOCKED :
+                                                                PERF_MUTEX;
+
+wire execute_memory =
+    (ao486_inst.pipeline_inst.execute_inst.tlbcheck_do     && ~ao486_inst.pipeline_inst.execute_inst.tlbcheck_done) ||
+    (ao486_inst.pipeline_inst.execute_inst.invdcode_do     && ~ao486_inst.pipeline_inst.execute_inst.invdcode_done) ||
+    (ao486_inst.pipeline_inst.execute_inst.invddata_do     && ~ao486_inst.pipeline_inst.execute_inst.invddata_done) ||
+    (ao486_inst.pipeline_inst.execute_inst.wbinvddata_do   && ~ao486_inst.pipeline_inst.execute_inst.wbinvddata_done);
+
+assign perf_execute =
+    (ao486_inst.pipeline_inst.execute_inst.exe_cmd == 7'd0)?        PERF_EMPTY :
+    (ao486_inst.pipeline_inst.execute_inst.exe_ready)?              PERF_BUSY :
+    (execute_memory)?                                               PERF_MEMORY :
+    (ao486_inst.pipeline_inst.execute_inst.exe_waiting)?            PERF_MUTEX :
+    (ao486_inst.pipeline_inst.execute_inst.wr_busy)?                PERF_BLOCKED :
+                                                                    PERF_MUTEX;
+
+wire write_memory =
+    (ao486_inst.pipeline_inst.write_inst.write_do    && ~ao486_inst.pipeline_inst.write_inst.write_done) ||
+    (ao486_inst.pipeline_inst.write_inst.io_write_do && ~ao486_inst.pipeline_inst.write_inst.io_write_done);
+
+//the write stage is the last one: it is never blocked
+assign perf_write =
+    (ao486_inst.pipeline_inst.write_inst.wr_cmd == 7'd0)?       PERF_EMPTY :
+    (ao486_inst.pipeline_inst.write_inst.wr_ready)?             PERF_BUSY :
+    (write_memory)?                                             PERF_MEMORY :
+                                                                PERF_MUTEX;
+
+//------------------------------------------------------------------------------
+
 wire [1:0]  ctrl_address    = 2'd0;
 wire        ctrl_write      = 1'b0;
 wire [31:0] ctrl_writedata  = 32'd0;
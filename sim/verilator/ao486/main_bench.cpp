@@ -0,0 +1,468 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <vector>
+
+#include "Vmain.h"
+#include "verilated.h"
+
+typedef unsigned char  uint8;
+typedef unsigned short uint16;
+typedef unsigned int   uint32;
+typedef unsigned long  uint64;
+
+/* Per-opcode cycle cost. Each benchmark is a tiny real mode program, run on a
+ * freshly reset model without the hub:
+ *
+ *   0xFFFF0: jmp 0000:0000          (the fake boot rom, as sim/modelsim/cpu/boot0.rom)
+ *   0x00000: mov [0x600],0x0009
+ *   0x00006: jmp body               (cold pass)
+ *   0x00009: mov [0x600],0x0012
+ *   0x0000F: jmp body               (hot pass)
+ *   0x00012: jmp $                  (end)
+ *   0x00100: body: setup; <unit> x count; jmp [0x600]
+ *
+ * The body returns through memory rather than with ret, so units may move
+ * the stack.
+ *
+ * The clocks since the previous retirement are charged to each retiring
+ * instruction of the measured <unit> range, so the setup and the jumps are not
+ * counted. The first pass runs with empty caches and tlb, the second pass
+ * finds the code and the data in the caches.
+ *
+ * Setup, as 32-bit moves: eax=3, ecx=1, edx=0, ebx=0x4000, esi=0x4400,
+ * edi=0x4800, ebp=0x4100, esp=0x7000, ds=es=ss=0, ZF=1, DF=0. Memory operands
+ * use these, far above the code. A unit must leave them usable when repeated.
+ */
+
+#define BENCH_BODY        0x0100
+#define BENCH_PASS0       0x0006
+#define BENCH_PASS1       0x000F
+#define BENCH_END         0x0012
+#define BENCH_RETURN      0x0600
+#define BENCH_MAX_CYCLES  200000
+
+struct bench_form_t {
+    const char *name;
+    uint8       bytes[16];
+    uint32      length;
+};
+
+#define B(...) { __VA_ARGS__ }, sizeof((uint8[]){ __VA_ARGS__ })
+
+static const bench_form_t bench_forms[] = {
+    //---------------------------------------------------------------------- alu
+    { "add r16,r16",                   B(0x01,0xD8) },
+    { "add r8,r8",                     B(0x00,0xD8) },
+    { "add r32,r32",                   B(0x66,0x01,0xD8) },
+    { "add ax,imm16",                  B(0x05,0x34,0x12) },
+    { "add r16,imm8",                  B(0x83,0xC0,0x05) },
+    { "add eax,imm32",                 B(0x66,0x05,0x78,0x56,0x34,0x12) },
+    { "add r16,[bx]",                  B(0x03,0x07) },
+    { "add r16,[bx+si]",               B(0x03,0x00) },
+    { "add r16,[bp+di+disp8]",         B(0x03,0x43,0x10) },
+    { "add r16,[disp16]",              B(0x03,0x06,0x00,0x50) },
+    { "add r16,es:[bx]",               B(0x26,0x03,0x07) },
+    { "add r32,[ebx]",                 B(0x66,0x67,0x03,0x03) },
+    { "add r16,[ebx+esi]",             B(0x67,0x03,0x04,0x33) },
+    { "add [bx],r16",                  B(0x01,0x07) },
+    { "lock add [bx],r16",             B(0xF0,0x01,0x07) },
+    { "adc r16,r16",                   B(0x11,0xD8) },
+    { "sub r16,r16",                   B(0x29,0xD8) },
+    { "sbb r16,r16",                   B(0x19,0xD8) },
+    { "and r16,r16",                   B(0x21,0xD8) },
+    { "or r16,r16",                    B(0x09,0xD8) },
+    { "xor r16,r16",                   B(0x31,0xD8) },
+    { "cmp r16,r16",                   B(0x39,0xD8) },
+    { "cmp r16,[bx]",                  B(0x3B,0x07) },
+    { "test r16,r16",                  B(0x85,0xD8) },
+    { "inc r16",                       B(0x40) },
+    { "dec r16",                       B(0x48) },
+    { "inc word [bx]",                 B(0xFF,0x07) },
+    { "neg r16",                       B(0xF7,0xD8) },
+    { "not r16",                       B(0xF7,0xD0) },
+    { "xadd r16,r16",                  B(0x0F,0xC1,0xD8) },
+    { "cmpxchg r16,r16",               B(0x0F,0xB1,0xD8) },
+    { "daa",                           B(0x27) },
+    { "aaa",                           B(0x37) },
+    { "aam",                           B(0xD4,0x0A) },
+    { "aad",                           B(0xD5,0x0A) },
+
+    //---------------------------------------------------------------------- mov
+    { "mov r16,r16",                   B(0x89,0xD8) },
+    { "mov r16,imm16",                 B(0xB8,0x34,0x12) },
+    { "mov r32,imm32",                 B(0x66,0xB8,0x78,0x56,0x34,0x12) },
+    { "mov r8,[bx]",                   B(0x8A,0x07) },
+    { "mov r16,[bx]",                  B(0x8B,0x07) },
+    { "mov r32,[bx]",                  B(0x66,0x8B,0x07) },
+    { "mov r16,[ebx+disp32]",          B(0x67,0x8B,0x83,0x00,0x01,0x00,0x00) },
+    { "mov [bx],r16",                  B(0x89,0x07) },
+    { "mov word [bx],imm16",           B(0xC7,0x07,0x34,0x12) },
+    { "mov es,r16",                    B(0x8E,0xC0) },
+    { "mov r16,es",                    B(0x8C,0xC0) },
+    { "lea r16,[bx+si+disp8]",         B(0x8D,0x40,0x10) },
+    { "movzx r16,r8",                  B(0x0F,0xB6,0xC3) },
+    { "movsx r32,r16",                 B(0x66,0x0F,0xBF,0xC3) },
+    { "xchg r16,r16",                  B(0x87,0xD8) },
+    { "xchg [bx],r16",                 B(0x87,0x07) },
+    { "lds r16,[bx]",                  B(0xC5,0x07) },
+    { "les r16,[bx]",                  B(0xC4,0x07) },
+    { "xlat",                          B(0xD7) },
+    { "bswap r32",                     B(0x0F,0xC8) },
+    { "cbw",                           B(0x98) },
+    { "cwd",                           B(0x99) },
+    { "cwde",                          B(0x66,0x98) },
+    { "cdq",                           B(0x66,0x99) },
+    { "nop",                           B(0x90) },
+
+    //---------------------------------------------------------------------- shift, bit
+    { "shl r16,1",                     B(0xD1,0xE0) },
+    { "shl r16,imm8",                  B(0xC1,0xE0,0x03) },
+    { "shl r16,cl",                    B(0xD3,0xE0) },
+    { "shl r32,cl",                    B(0x66,0xD3,0xE0) },
+    { "sar r16,1",                     B(0xD1,0xF8) },
+    { "rol r16,1",                     B(0xD1,0xC0) },
+    { "rcl r16,1",                     B(0xD1,0xD0) },
+    { "shl word [bx],1",               B(0xD1,0x27) },
+    { "shld r16,r16,imm8",             B(0x0F,0xA4,0xD8,0x03) },
+    { "shrd r16,r16,imm8",             B(0x0F,0xAC,0xD8,0x03) },
+    { "bt r16,imm8",                   B(0x0F,0xBA,0xE0,0x03) },
+    { "bts [bx],r16",                  B(0x0F,0xAB,0x07) },
+    { "bsf r16,r16",                   B(0x0F,0xBC,0xC3) },
+    { "bsr r16,r16",                   B(0x0F,0xBD,0xC3) },
+    { "setz r8",                       B(0x0F,0x94,0xC0) },
+
+    //---------------------------------------------------------------------- mul, div
+    { "mul r8",                        B(0xF6,0xE1) },
+    { "mul r16",                       B(0xF7,0xE1) },
+    { "mul r32",                       B(0x66,0xF7,0xE1) },
+    { "mul word [bx]",                 B(0xF7,0x27) },
+    { "imul r16,r16",                  B(0x0F,0xAF,0xC1) },
+    { "imul r16,r16,imm8",             B(0x6B,0xC1,0x05) },
+    { "div r8",                        B(0xF6,0xF1) },
+    { "div r16",                       B(0xF7,0xF1) },
+    { "div r32",                       B(0x66,0xF7,0xF1) },
+    { "idiv r16",                      B(0xF7,0xF9) },
+
+    //---------------------------------------------------------------------- flags
+    { "clc",                           B(0xF8) },
+    { "stc",                           B(0xF9) },
+    { "cmc",                           B(0xF5) },
+    { "cld",                           B(0xFC) },
+    { "cli",                           B(0xFA) },
+    { "lahf",                          B(0x9F) },
+    { "sahf",                          B(0x9E) },
+    { "pushf; popf",                   B(0x9C,0x9D) },
+
+    //---------------------------------------------------------------------- stack
+    { "push r16",                      B(0x50) },
+    { "push r32",                      B(0x66,0x50) },
+    { "pop r16",                       B(0x58) },
+    { "push imm16",                    B(0x68,0x34,0x12) },
+    { "push word [bx]",                B(0xFF,0x37) },
+    { "pop word [bx]",                 B(0x8F,0x07) },
+    { "push es",                       B(0x06) },
+    { "push es; pop es",               B(0x06,0x07) },
+    { "pusha",                         B(0x60) },
+    { "pusha; popa",                   B(0x60,0x61) },
+    { "enter 4,0; leave",              B(0xC8,0x04,0x00,0x00,0xC9) },
+
+    //---------------------------------------------------------------------- control
+    { "jmp rel8",                      B(0xEB,0x00) },
+    { "jmp rel16",                     B(0xE9,0x00,0x00) },
+    { "jz rel8, taken",                B(0x74,0x00) },
+    { "jnz rel8, not taken",           B(0x75,0x00) },
+    { "jz rel16, taken",               B(0x0F,0x84,0x00,0x00) },
+    { "loop rel8",                     B(0xE2,0x00) },
+    { "call rel16; add sp,2",          B(0xE8,0x00,0x00,0x83,0xC4,0x02) },
+    { "call rel16; ret; jmp rel8",     B(0xE8,0x02,0x00,0xEB,0x01,0xC3) },
+
+    //---------------------------------------------------------------------- loops: mov cx,8 and 8 iterations per unit
+    { "loop: add; dec cx; jnz",         B(0xB9,0x08,0x00,0x01,0xD8,0x49,0x75,0xFB) },
+    { "loop: add; loop",                B(0xB9,0x08,0x00,0x01,0xD8,0xE2,0xFC) },
+    { "loop: mov [bx],ax; add bx,2",    B(0xB9,0x08,0x00,0x89,0x07,0x83,0xC3,0x02,0xE2,0xF9) },
+    { "loop: call f; f: ret",           B(0xB9,0x08,0x00,0xE8,0x04,0x00,0xE2,0xFB,0xEB,0x01,0xC3) },
+    { "call; push; call; ret; ret 2",   B(0xE8,0x03,0x00,0xEB,0x0B,0x90,0x50,0xE8,0x02,0x00,0xC3,0x90,0x43,0xC2,0x02,0x00) },
+
+    //---------------------------------------------------------------------- string
+    { "movsb",                         B(0xA4) },
+    { "movsw",                         B(0xA5) },
+    { "movsd",                         B(0x66,0xA5) },
+    { "stosw",                         B(0xAB) },
+    { "lodsw",                         B(0xAD) },
+    { "cmpsw",                         B(0xA7) },
+    { "scasw",                         B(0xAF) },
+    { "mov cx,8; rep movsw",           B(0xB9,0x08,0x00,0xF3,0xA5) },
+    { "mov cx,8; rep stosd",           B(0xB9,0x08,0x00,0xF3,0x66,0xAB) },
+
+    //---------------------------------------------------------------------- io, system
+    { "in al,imm8",                    B(0xE4,0x80) },
+    { "out imm8,al",                   B(0xE6,0x80) },
+    { "smsw r16",                      B(0x0F,0x01,0xE0) },
+    { "cpuid",                         B(0x0F,0xA2) },
+};
+
+static const uint8 bench_setup[] = {
+    0x66,0x31,0xC0,                         //xor eax,eax
+    0x8E,0xD8,                              //mov ds,ax
+    0x8E,0xC0,                              //mov es,ax
+    0x8E,0xD0,                              //mov ss,ax
+    0xFC,                                   //cld
+    0x66,0xBC,0x00,0x70,0x00,0x00,          //mov esp,0x7000
+    0x66,0xBB,0x00,0x40,0x00,0x00,          //mov ebx,0x4000
+    0x66,0xBE,0x00,0x44,0x00,0x00,          //mov esi,0x4400
+    0x66,0xBF,0x00,0x48,0x00,0x00,          //mov edi,0x4800
+    0x66,0xBD,0x00,0x41,0x00,0x00,          //mov ebp,0x4100
+    0x66,0xB9,0x01,0x00,0x00,0x00,          //mov ecx,1
+    0x66,0xBA,0x00,0x00,0x00,0x00,          //mov edx,0
+    0x66,0xB8,0x03,0x00,0x00,0x00,          //mov eax,3
+};
+
+//------------------------------------------------------------------------------
+
+union memory_t {
+    uint8  bytes [134217728];
+    uint16 shorts[67108864];
+    uint32 ints  [33554432];
+};
+memory_t bench_memory;
+
+struct bench_result_t {
+    const bench_form_t *form;
+    bool                fault;
+    uint32              fault_at;
+    uint64              clocks[2];
+    uint32              instructions[2];
+};
+
+//returns the end of the measured range; the range starts after the setup
+static uint32 bench_load(const bench_form_t &form, uint32 count) {
+    memset(&bench_memory, 0, sizeof(bench_memory));
+
+    //fake boot rom: jmp 0000:0000 at the reset vector
+    const uint8 boot[] = { 0xEA, 0x00, 0x00, 0x00, 0x00 };
+    memcpy(&bench_memory.bytes[0xFFFF0], boot, sizeof(boot));
+
+    uint16 rel0 = BENCH_BODY - (BENCH_PASS0 + 3);
+    uint16 rel1 = BENCH_BODY - (BENCH_PASS1 + 3);
+    const uint8 main_code[] = {
+        0xC7, 0x06, BENCH_RETURN & 0xFF, BENCH_RETURN >> 8, BENCH_PASS0 + 3, 0x00,
+        0xE9, (uint8)rel0, (uint8)(rel0 >> 8),
+        0xC7, 0x06, BENCH_RETURN & 0xFF, BENCH_RETURN >> 8, BENCH_END, 0x00,
+        0xE9, (uint8)rel1, (uint8)(rel1 >> 8),
+        0xEB, 0xFE
+    };
+    memcpy(&bench_memory.bytes[0], main_code, sizeof(main_code));
+
+    uint32 address = BENCH_BODY;
+    memcpy(&bench_memory.bytes[address], bench_setup, sizeof(bench_setup));
+    address += sizeof(bench_setup);
+
+    for(uint32 i=0; i<count; i++) {
+        memcpy(&bench_memory.bytes[address], form.bytes, form.length);
+        address += form.length;
+    }
+    const uint8 back[] = { 0xFF, 0x26, BENCH_RETURN & 0xFF, BENCH_RETURN >> 8 }; //jmp [BENCH_RETURN]
+    memcpy(&bench_memory.bytes[address], back, sizeof(back));
+    return address;
+}
+
+static void bench_run(bench_result_t &result, uint32 count) {
+    uint32 measure_start = BENCH_BODY + sizeof(bench_setup);
+    uint32 measure_end   = bench_load(*result.form, count);
+
+    Vmain *top = new Vmain();
+
+    //reset
+    top->clk = 0; top->rst_n = 1; top->eval();
+    top->clk = 1; top->rst_n = 1; top->eval();
+    top->clk = 1; top->rst_n = 0; top->eval();
+    top->clk = 0; top->rst_n = 0; top->eval();
+    top->clk = 0; top->rst_n = 1; top->eval();
+
+    uint32 sdram_read_count = 0;
+    uint32 sdram_read_data[4];
+
+    uint32 sdram_write_count = 0;
+    uint32 sdram_write_address = 0;
+
+    uint32 vga_read_count = 0;
+    uint32 io_read_count = 0;
+
+    uint64 last_clock = 0;
+    int    pass       = -1;
+
+    top->interrupt_do     = 0;
+    top->interrupt_vector = 0;
+
+    for(uint64 clock=0; clock<BENCH_MAX_CYCLES; clock++) {
+
+        if(top->tb_finish_instr) {
+            uint32 linear = top->prof_cs_base + top->prof_eip;
+
+            if(linear == BENCH_PASS0 || linear == BENCH_PASS1) pass++;
+            else if(linear == BENCH_END) break;
+            else if(pass >= 0 && linear > BENCH_END && (linear < BENCH_BODY || linear > measure_end)) {
+                //an exception went through the vector table, which holds the program
+                result.fault    = true;
+                result.fault_at = linear;
+                break;
+            }
+            else if(pass >= 0 && pass < 2 && linear >= measure_start && linear < measure_end) {
+                result.clocks[pass] += clock - last_clock;
+                result.instructions[pass]++;
+            }
+            last_clock = clock;
+        }
+
+        //---------------------------------------------------------------------- sdram
+
+        top->sdram_readdatavalid = 0;
+
+        if(top->sdram_read) {
+            uint32 address = top->sdram_address & 0x07FFFFFC;
+
+            for(uint32 i=0; i<4; i++) {
+                sdram_read_data[i] = bench_memory.ints[((address + i*4) & 0x07FFFFFC)/4];
+
+                if(((top->sdram_byteenable >> 0) & 1) == 0) sdram_read_data[i] &= 0xFFFFFF00;
+                if(((top->sdram_byteenable >> 1) & 1) == 0) sdram_read_data[i] &= 0xFFFF00FF;
+                if(((top->sdram_byteenable >> 2) & 1) == 0) sdram_read_data[i] &= 0xFF00FFFF;
+                if(((top->sdram_byteenable >> 3) & 1) == 0) sdram_read_data[i] &= 0x00FFFFFF;
+            }
+            sdram_read_count = top->sdram_burstcount;
+        }
+        else if(sdram_read_count > 0) {
+            top->sdram_readdatavalid = 1;
+            top->sdram_readdata = sdram_read_data[0];
+            memmove(sdram_read_data, &sdram_read_data[1], sizeof(sdram_read_data)-sizeof(uint32));
+            sdram_read_count--;
+        }
+
+        if(top->sdram_write) {
+            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & 0x07FFFFFC;
+
+            for(uint32 i=0; i<4; i++) {
+                if((top->sdram_byteenable >> i) & 1) bench_memory.bytes[address + i] = (top->sdram_writedata >> (i*8)) & 0xFF;
+            }
+
+            if(sdram_write_count == 0) {
+                sdram_write_address = (address + 4) & 0x07FFFFFC;
+                sdram_write_count = top->sdram_burstcount;
+            }
+
+            if(sdram_write_count > 0) sdram_write_count--;
+        }
+
+        //---------------------------------------------------------------------- vga, io: no devices, reads float high
+
+        top->vga_readdatavalid = 0;
+
+        if(top->vga_read) {
+            vga_read_count = top->vga_burstcount;
+        }
+        else if(vga_read_count > 0) {
+            top->vga_readdatavalid = 1;
+            top->vga_readdata = 0xFFFFFFFF;
+            vga_read_count--;
+        }
+
+        top->avalon_io_readdatavalid = 0;
+
+        if(top->avalon_io_read) {
+            io_read_count = 1;
+        }
+        else if(io_read_count > 0) {
+            top->avalon_io_readdatavalid = 1;
+            top->avalon_io_readdata = 0xFFFFFFFF;
+            io_read_count--;
+        }
+
+        //----------------------------------------------------------------------
+
+        top->clk = 0;
+        top->eval();
+
+        top->clk = 1;
+        top->eval();
+    }
+
+    top->final();
+    delete top;
+}
+
+static double bench_per_unit(const bench_result_t &result, int pass, uint32 count) {
+    return result.clocks[pass] / (double)count;
+}
+
+static void bench_row(FILE *fp, const bench_result_t &result, uint32 count) {
+    char bytes[64] = "";
+    for(uint32 i=0; i<result.form->length; i++) snprintf(bytes + strlen(bytes), sizeof(bytes) - strlen(bytes), "%02x", result.form->bytes[i]);
+
+    if(result.fault) {
+        fprintf(fp, "%-32s %-16s  fault, retired at %08x\n", result.form->name, bytes, result.fault_at);
+        return;
+    }
+    if(result.instructions[0] == 0 || result.instructions[1] == 0) {
+        fprintf(fp, "%-32s %-16s  did not finish\n", result.form->name, bytes);
+        return;
+    }
+    fprintf(fp, "%-32s %-16s %6.2f %9.2f %9.2f\n", result.form->name, bytes, result.instructions[1] / (double)count,
+        bench_per_unit(result, 0, count), bench_per_unit(result, 1, count));
+}
+
+int main(int argc, char **argv) {
+    const char *out_file = "bench.txt";
+    const char *filter   = NULL;
+    uint32      count    = 16;
+
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--out") == 0 && i+1 < argc)         out_file = argv[++i];
+        else if(strcmp(argv[i], "--filter") == 0 && i+1 < argc) filter   = argv[++i];
+        else if(strcmp(argv[i], "--count") == 0 && i+1 < argc)  count    = strtoul(argv[++i], NULL, 0);
+    }
+    if(count == 0) count = 1;
+
+    Verilated::commandArgs(argc, argv);
+
+    std::vector<bench_result_t> results;
+
+    for(const bench_form_t &form : bench_forms) {
+        if(filter != NULL && strstr(form.name, filter) == NULL) continue;
+
+        bench_result_t result;
+        memset(&result, 0, sizeof(result));
+        result.form = &form;
+
+        bench_run(result, count);
+        bench_row(stdout, result, count);
+        results.push_back(result);
+    }
+
+    FILE *fp = fopen(out_file, "wb");
+    if(fp == NULL) {
+        fprintf(stderr, "#ao486_bench: can not open %s\n", out_file);
+        return -1;
+    }
+
+    //clocks per unit; a unit is the listed instruction, or the listed sequence
+    fprintf(fp, "units per run: %u\n\n", count);
+    fprintf(fp, "%-32s %-16s %6s %9s %9s\n", "form", "bytes", "instr", "cold", "hot");
+    for(const bench_result_t &result : results) bench_row(fp, result, count);
+
+    std::vector<bench_result_t> sorted(results);
+    std::stable_sort(sorted.begin(), sorted.end(), [count](const bench_result_t &a, const bench_result_t &b) {
+        double a_hot = (a.fault)? -1 : bench_per_unit(a, 1, count);
+        double b_hot = (b.fault)? -1 : bench_per_unit(b, 1, count);
+        return a_hot > b_hot;
+    });
+
+    fprintf(fp, "\nslowest first, by hot clocks:\n");
+    fprintf(fp, "%-32s %-16s %6s %9s %9s\n", "form", "bytes", "instr", "cold", "hot");
+    for(const bench_result_t &result : sorted) bench_row(fp, result, count);
+
+    fclose(fp);
+    return 0;
+}
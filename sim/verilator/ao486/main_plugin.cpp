@@ -8,20 +8,27 @@
 #include <unistd.h>
 
 #include "Vmain.h"
+#include "Vmain___024root.h"
 #include "verilated.h"
 #include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#ifdef HANDOFF
+#include "handoff.h"
+#endif
+#include "track.h"
 
 //------------------------------------------------------------------------------
 
 volatile shared_mem_t *shared_ptr = NULL;
 
+track_writer_t track;
+
 //------------------------------------------------------------------------------
 
 int main(int argc, char **argv) {
     //map shared memory
-    int fd = open("./../../../sim/sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
+    int fd = open(instance_path("shared_mem.dat", "./../../../sim/sim_pc/shared_mem.dat"), O_RDWR, S_IRUSR | S_IWUSR);
     
     if(fd == -1) {
         perror("open() failed for shared_mem.dat");
@@ -45,6 +52,11 @@ int main(int argc, char **argv) {
     }
     printf("done.\n");
 
+    if(track_writer_open(&track, instance_path("track.trk", "track.trk")) == false) {
+        perror("open() failed for track.trk");
+        return -3;
+    }
+
     //--------------------------------------------------------------------------
     
     
@@ -56,7 +68,7 @@ int main(int argc, char **argv) {
     Vmain *top = new Vmain();
     top->trace (tracer, 99);
 //    tracer->rolloverMB(1000000);
-    tracer->open("ao486.vcd");
+    tracer->open(instance_path("ao486.vcd", "ao486.vcd"));
 //tracer->flush();
 //return 0;
     //reset
@@ -64,6 +76,18 @@ int main(int argc, char **argv) {
     top->clk = 1; top->rst_n = 1; top->eval();
     top->clk = 1; top->rst_n = 0; top->eval();
     top->clk = 0; top->rst_n = 0; top->eval();
+    
+    //fast-forward: start from the state of the reference instead of the reset vector
+    if(shared_ptr->handoff_step != STEP_IDLE) {
+#ifdef HANDOFF
+        handoff_load(top, shared_ptr->handoff);
+        printf("handoff at instr_counter %d, eip %08x\n", shared_ptr->handoff.instr_counter, shared_ptr->handoff.eip);
+#else
+        printf("ERROR: fast-forward needs the handoff build, make main_plugin_handoff\n");
+        return -1;
+#endif
+    }
+    
     top->clk = 0; top->rst_n = 1; top->eval();
     
     //--------------------------------------------------------------------------
@@ -87,12 +111,18 @@ int main(int argc, char **argv) {
     
     uint32 ignored_intr_counter = 0;
     
+    volatile transport_t *transport = &shared_ptr->ao486_transport;
+    uint32 sequence = 0;
+    
     //--------------------------------------------------------------------------
     
     uint64 cycle = 0;
     
-    char irq_txt[256];
-    int  irq_delay = 0;
+    char   irq_txt[256];
+    int    irq_delay  = 0;
+    uint32 irq_vector = 0;
+    uint32 irq_type   = TRACK_IAC_NORMAL;
+    uint32 irq_at     = 0;
     
     while(!Verilated::gotFinish()) {
         
@@ -101,6 +131,7 @@ int main(int argc, char **argv) {
             shared_ptr->ao486.instr_counter++;
             
             if(shared_ptr->ao486.stop == STEP_REQ) {
+                transport_drain(&transport->mem_req);
                 shared_ptr->ao486.stop = STEP_ACK;
                 while(shared_ptr->ao486.stop != STEP_IDLE) {
                     usleep(500);
@@ -113,7 +144,10 @@ int main(int argc, char **argv) {
         top->sdram_readdatavalid = 0;
         
         if(top->sdram_read) {
-            uint32 address = top->sdram_address & 0x07FFFFFC;
+            //sdram is read straight from the shared mapping: retire posted writes first
+            transport_drain(&transport->mem_req);
+            
+            uint32 address = top->sdram_address & mem_mask(shared_ptr);
             
             for(uint32 i=0; i<4; i++) {
                 sdram_read_data[i] = shared_ptr->mem.ints[(address + i*4)/4];
@@ -136,7 +170,7 @@ int main(int argc, char **argv) {
         }
         
         if(top->sdram_write) {
-            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & 0x07FFFFFC;
+            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & mem_mask(shared_ptr);
             uint32 data = top->sdram_writedata;
             
             if((top->sdram_byteenable & 0x1) == 0) data &= 0xFFFFFF00;
@@ -146,23 +180,13 @@ int main(int argc, char **argv) {
             
 printf("sdram write: %08x %x %08x %d", address, top->sdram_byteenable, data, sdram_write_count);
 
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem wr %08x %x %08x\n", address, top->sdram_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_WR, shared_ptr->ao486.instr_counter, address, top->sdram_byteenable, data);
 
-            shared_ptr->ao486.mem_address    = address;
-            shared_ptr->ao486.mem_byteenable = top->sdram_byteenable;
-            shared_ptr->ao486.mem_is_write   = 1;
-            shared_ptr->ao486.mem_data       = data;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            shared_ptr->ao486.mem_step = STEP_IDLE;
+            //always through the hub, so a lockstep run (shared_ptr->lockstep) sees every write
+            transport_post(&transport->mem_req, sequence, address, data, top->sdram_byteenable, 1);
             
             if(sdram_write_count == 0) {
-                sdram_write_address = (address + 4) & 0x07FFFFFC;
+                sdram_write_address = (address + 4) & mem_mask(shared_ptr);
                 sdram_write_count = top->sdram_burstcount;
             }
             
@@ -182,23 +206,13 @@ printf("\n");
 printf("vga read: %08x %x %d\n", vga_read_address, vga_read_byteenable, vga_read_count);
         }
         else if(vga_read_count > 0) {
-            shared_ptr->ao486.mem_address    = vga_read_address;
-            shared_ptr->ao486.mem_byteenable = vga_read_byteenable;
-            shared_ptr->ao486.mem_is_write   = 0;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            uint32 value = shared_ptr->ao486.mem_data;
-            shared_ptr->ao486.mem_step = STEP_IDLE;
+            transport_post(&transport->mem_req, sequence, vga_read_address, 0, vga_read_byteenable, 0);
+            uint32 value = transport_wait(&transport->mem_resp);
             
             top->vga_readdatavalid = 1;
             top->vga_readdata = value;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem rd %08x %x %08x\n", vga_read_address, vga_read_byteenable, value);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_RD, shared_ptr->ao486.instr_counter, vga_read_address, vga_read_byteenable, value);
             
             vga_read_address = (vga_read_address + 4) & 0x000FFFFC;
             vga_read_count--;
@@ -214,21 +228,10 @@ printf("\n");
             if((top->vga_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->vga_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem wr %08x %x %08x\n", address, top->sdram_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_WR, shared_ptr->ao486.instr_counter, address, top->sdram_byteenable, data);
             
 printf("vga write: %08x %x %08x %d", address, top->sdram_byteenable, data, vga_write_count);
-            shared_ptr->ao486.mem_address    = address;
-            shared_ptr->ao486.mem_byteenable = top->vga_byteenable;
-            shared_ptr->ao486.mem_is_write   = 1;
-            shared_ptr->ao486.mem_data       = data;
-            shared_ptr->ao486.mem_step       = STEP_REQ;
-            while(shared_ptr->ao486.mem_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            shared_ptr->ao486.mem_step = STEP_IDLE;
+            transport_post(&transport->mem_req, sequence, address, data, top->vga_byteenable, 1);
             
             if(vga_write_count == 0) {
                 vga_write_address = (address + 4) & 0x07FFFFFC;
@@ -236,7 +239,7 @@ printf("vga write: %08x %x %08x %d", address, top->sdram_byteenable, data, vga_w
             }
             
             if(vga_write_count > 0) vga_write_count--;
-printf("\n", vga_write_count);
+printf(" left %u\n", vga_write_count);
         }
         
         //---------------------------------------------------------------------- io
@@ -251,20 +254,10 @@ printf("\n", vga_write_count);
 printf("io read: %08x %x %d", io_read_address, io_read_byteenable, io_read_count);
         }
         else if(io_read_count > 0) {
-            shared_ptr->ao486.io_address    = io_read_address;
-            shared_ptr->ao486.io_byteenable = io_read_byteenable;
-            shared_ptr->ao486.io_is_write   = 0;
-            shared_ptr->ao486.io_step       = STEP_REQ;
-            while(shared_ptr->ao486.io_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            uint32 value = shared_ptr->ao486.io_data;
-            shared_ptr->ao486.io_step = STEP_IDLE;
+            transport_post(&transport->io_req, sequence, io_read_address, 0, io_read_byteenable, 0);
+            uint32 value = transport_wait(&transport->io_resp);
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "io rd %04x %x %08x\n", io_read_address, io_read_byteenable, value);
-            fclose(fp);
+            track_write(&track, TRACK_IO_RD, shared_ptr->ao486.instr_counter, io_read_address, io_read_byteenable, value);
             
 //if(io_read_address == 0x01F0 && io_read_byteenable == 0xF && value == 0x655301c6) shared_ptr->dump_enabled = 1;
             
@@ -283,21 +276,11 @@ printf("\n");
             if((top->avalon_io_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->avalon_io_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "io wr %04x %x %08x\n", top->avalon_io_address & 0x0000FFFC, top->avalon_io_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_IO_WR, shared_ptr->ao486.instr_counter, top->avalon_io_address & 0x0000FFFC, top->avalon_io_byteenable, data);
             
 printf("io write: %08x %x %08x", (top->avalon_io_address & 0x0000FFFC), top->avalon_io_byteenable, data);
-            shared_ptr->ao486.io_address    = top->avalon_io_address & 0x0000FFFC;
-            shared_ptr->ao486.io_byteenable = top->avalon_io_byteenable;
-            shared_ptr->ao486.io_is_write   = 1;
-            shared_ptr->ao486.io_data       = data;
-            shared_ptr->ao486.io_step       = STEP_REQ;
-            while(shared_ptr->ao486.io_step != STEP_ACK) {
-                fflush(stdout);
-                usleep(10);
-            }
-            shared_ptr->ao486.io_step = STEP_IDLE;
+            transport_post(&transport->io_req, sequence, top->avalon_io_address & 0x0000FFFC, data, top->avalon_io_byteenable, 1);
+            transport_wait(&transport->io_resp);
 printf("\n");
         }
         
@@ -317,17 +300,18 @@ printf("\n");
             else if(shared_ptr->irq_do == STEP_ACK) txt = "-spurACK";
             
             sprintf(irq_txt, "IAC%s 0x%02x at %d\n", txt, vec, shared_ptr->ao486.instr_counter);
+            irq_vector = vec;
+            irq_type   = (shared_ptr->irq_do == STEP_IDLE)? TRACK_IAC_SPUR_IDLE : (shared_ptr->irq_do == STEP_ACK)? TRACK_IAC_SPUR_ACK : TRACK_IAC_NORMAL;
+            irq_at     = shared_ptr->ao486.instr_counter;
             irq_delay = 3;
             
             shared_ptr->irq_do = STEP_ACK;
         }
         else if(irq_delay > 0) {
             if(irq_delay == 1) {
-                FILE *fp = fopen("track.txt", "a");
-                fprintf(fp, irq_txt);
-                fclose(fp);
+                track_write(&track, TRACK_IAC, shared_ptr->ao486.instr_counter, irq_vector, irq_type, irq_at);
 
-                fp = fopen("interrupt.txt", "a");
+                FILE *fp = fopen(instance_path("interrupt.txt", "interrupt.txt"), "a");
                 fprintf(fp, irq_txt);
                 fclose(fp);
             }
@@ -338,14 +322,12 @@ printf("\n");
         //---------------------------------------------------------------------- exception
         
         if(top->dbg_exc) {
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "Exception 0x%02x at %d\n", top->dbg_exc_vector, shared_ptr->ao486.instr_counter);
-            fclose(fp);
+            track_write(&track, TRACK_EXCEPTION, shared_ptr->ao486.instr_counter, top->dbg_exc_vector, 0, shared_ptr->ao486.instr_counter);
         }
         
         //----------------------------------------------------------------------
         
-        if(shared_ptr->dump_enabled == 0 && fopen("start", "rb") != NULL) shared_ptr->dump_enabled = 1;
+        if(shared_ptr->dump_enabled == 0 && fopen(instance_path("start", "start"), "rb") != NULL) shared_ptr->dump_enabled = 1;
         //else if(cycle > 142400000 || shared_ptr->ao486.instr_counter > 7720000) shared_ptr->dump_enabled = 1;
         //else if(shared_ptr->ao486.instr_counter > 712000) shared_ptr->dump_enabled = 1;
         
@@ -367,12 +349,14 @@ printf("\n");
         if(shared_ptr->dump_enabled) tracer->dump(cycle++);
         
         if((cycle % 10000) == 0) printf("half-cycle: %lld\n", cycle);
+        if((cycle % 1000000) == 0) track_writer_flush(&track);
         
         //12320000
        
         tracer->flush();
         //usleep(1);
     }
+    track_writer_close(&track);
     delete top;
     return 0;
 }
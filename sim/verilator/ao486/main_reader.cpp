@@ -11,6 +11,8 @@
 #include "verilated.h"
 #include "verilated_vcd_c.h"
 
+#include "track.h"
+
 typedef unsigned char  uint8;
 typedef unsigned short uint16;
 typedef unsigned int   uint32;
@@ -18,10 +20,11 @@ typedef unsigned long  uint64;
 
 //------------------------------------------------------------------------------
 
-FILE *check_fp = NULL;
+track_reader_t check_reader;
+uint64         check_pos = 0;
 
-char check_line[256];
-char check_next[256];
+const track_record_t *check_line = NULL;
+const track_record_t *check_next = NULL;
 int check_state = 0;
 /*
 0 - both empty
@@ -41,6 +44,13 @@ memory_t check_memory;
 
 uint32 instr_counter = 0;
 
+track_writer_t track;
+
+//check_init() and the mismatch paths leave through exit()
+void track_close_at_exit() {
+    track_writer_close(&track);
+}
+
 void load_file(const char *name, int byte_location) {
     FILE *fp = fopen(name, "rb");
     if(fp == NULL) {
@@ -67,80 +77,66 @@ void load_file(const char *name, int byte_location) {
     fclose(fp);
 }
 
-bool check_read_fp(char *line) {
-    while(true) {
-        char *endoffile = fgets(line, 256, check_fp);
-        if(endoffile == NULL) return false;
-printf("line: %s\n", line);
-        uint32 val1 = 0, val2 = 0;
-        int scan_ret = sscanf(line, "Exception 0x%x at %x", &val1, &val2);
-        if(scan_ret == 2) {
+const track_record_t *check_read(uint64 *pos) {
+    while(*pos < check_reader.count) {
+        const track_record_t *record = &check_reader.records[(*pos)++];
+        
+        if(record->op == TRACK_EXCEPTION || record->op == TRACK_SYNC) {
             //ignore
             continue;
         }
-        
-        val1 = val2 = 0;
-        scan_ret = sscanf(line, "IAC 0x%x at %d", &val1, &val2);
-        if(scan_ret == 2) {
-            check_next_irq_vector = val1;
-            check_next_irq_at     = val2;
-            
+        if(record->op == TRACK_IAC) {
+            if(record->byteenable == TRACK_IAC_NORMAL) {
+                check_next_irq_vector = record->address;
+                check_next_irq_at     = record->data;
+            }
             continue;
         }
-        break;
+        return record;
     }
-    return true;
+    return NULL;
 }
 
-void check_look_ahead_fp() {
-    uint64 curr_pos = ftell(check_fp);
-    
-    char line[256];
-    check_read_fp(line);
-    check_read_fp(line);
-    check_read_fp(line);
+void check_look_ahead() {
+    uint64 pos = check_pos;
     
-    int ret = fseek(check_fp, curr_pos, SEEK_SET); 
-    if(ret != 0) {
-        fprintf(stderr, "#ao486_reader: can not seek reader file.\n");
-        exit(-1);
-    }
+    check_read(&pos);
+    check_read(&pos);
+    check_read(&pos);
 }
 
-uint64 total_size = 0;
 uint64 last_percent = 0;
 
 void check_init() {
-    if(check_fp == NULL) {
-        //const char *filename = "./../backup/run-10/track.txt";
-        const char *filename = "./../../../ao486/io_win95pipeline_1.txt";
+    if(check_reader.records == NULL) {
+        //const char *filename = "./../backup/run-10/track.trk";
+        const char *filename = "./../../../ao486/io_win95pipeline_1.trk";
         
-        check_fp = fopen(filename, "rb");
-        if(check_fp == NULL) {
+        if(track_reader_open(&check_reader, filename) == false) {
             fprintf(stderr, "#ao486_reader: can not open reader file.\n");
             exit(-1);
         }
-        
-        struct stat st;
-        memset(&st, 0, sizeof(struct stat));
-        stat(filename, &st);
-        total_size = st.st_size;
-        fprintf(stderr, "#ao486_reader: total file size: %d\n", total_size);
+        fprintf(stderr, "#ao486_reader: total records: %lu\n", check_reader.count);
+        if(check_reader.count == 0) {
+            fprintf(stderr, "#ao486_reader: EOF\n");
+            exit(0);
+        }
     }
     
-    uint64 curr_pos = ftell(check_fp);
-    uint64 curr_percent = curr_pos * 100 / total_size;
+    uint64 curr_percent = check_pos * 100 / check_reader.count;
     if(curr_percent != last_percent) {
         last_percent = curr_percent;
         fprintf(stderr, "#ao486_reader: %d percent\n", (uint32)last_percent);
     }
     
     if(check_state == 0) { 
-        if(check_read_fp(check_line) == false) {
+        check_line = check_read(&check_pos);
+        if(check_line == NULL) {
             fprintf(stderr, "#ao486_reader: EOF\n");
             exit(0);
         }
-        if(check_read_fp(check_next) == false) {
+        check_next = check_read(&check_pos);
+        if(check_next == NULL) {
             check_state = 1;
             return;
         }
@@ -151,36 +147,49 @@ void check_init() {
         exit(0);
     }
     else if(check_state == 2) {
-        memcpy(check_line, check_next, 256);
+        check_line = check_next;
         
-        if(check_read_fp(check_next) == false) {
+        check_next = check_read(&check_pos);
+        if(check_next == NULL) {
             check_state = 1;
             return;
         }
         
-        check_look_ahead_fp();
+        check_look_ahead();
         check_state = 2;
     }
 }
 
+static const char *check_op_name(uint32 op) {
+    switch(op) {
+        case TRACK_MEM_RD: return "mem rd";
+        case TRACK_MEM_WR: return "mem wr";
+        case TRACK_IO_RD:  return "io rd";
+        case TRACK_IO_WR:  return "io wr";
+    }
+    return "?";
+}
+
+#define CHECK_LINE_FMT  "%s %08x %x %08x"
+#define CHECK_LINE_ARGS check_op_name(check_line->op), check_line->address, check_line->byteenable, check_line->data
+
 uint32 check_io_rd(uint32 address, uint32 byteenable) {
     check_init();
     
-    uint32 io_addr = 0, io_byteena = 0, io_data = 0;
-    int scan_ret = sscanf(check_line, "io rd %x %x %x", &io_addr, &io_byteena, &io_data);
+    uint32 io_addr = check_line->address, io_byteena = check_line->byteenable, io_data = check_line->data;
     
-    if(scan_ret == 3) {
+    if(check_line->op == TRACK_IO_RD) {
         if(address != io_addr) {
-            fprintf(stderr, "#check_io_rd MISMATCH:%s != l:%04x %x\n", check_line, address, byteenable);
+            fprintf(stderr, "#check_io_rd MISMATCH:" CHECK_LINE_FMT " != l:%04x %x\n", CHECK_LINE_ARGS, address, byteenable);
             exit(-1);
         }
         if(byteenable != io_byteena) {
-            fprintf(stderr, "#check_io_rd MISMATCH:%s != l:%04x %x\n", check_line, address, byteenable);
+            fprintf(stderr, "#check_io_rd MISMATCH:" CHECK_LINE_FMT " != l:%04x %x\n", CHECK_LINE_ARGS, address, byteenable);
             exit(-1);
         }
     }
     else {
-        fprintf(stderr, "#check_io_rd MISMATCH: f:%s != l:%04x %x\n", check_line, address, byteenable);
+        fprintf(stderr, "#check_io_rd MISMATCH: f:" CHECK_LINE_FMT " != l:%04x %x\n", CHECK_LINE_ARGS, address, byteenable);
         exit(-1);
     }
     return io_data;
@@ -189,30 +198,29 @@ uint32 check_io_rd(uint32 address, uint32 byteenable) {
 void check_io_wr(uint32 address, uint32 byteenable, uint32 data) {
     check_init();
 
-    uint32 io_addr = 0, io_byteena = 0, io_data = 0;
-    int scan_ret = sscanf(check_line, "io wr %x %x %x", &io_addr, &io_byteena, &io_data);
+    uint32 io_addr = check_line->address, io_byteena = check_line->byteenable, io_data = check_line->data;
     
-    if(scan_ret == 3) {
+    if(check_line->op == TRACK_IO_WR) {
         if(((byteenable>>0) & 1) == 0) { data &= 0xFFFFFF00; io_data &= 0xFFFFFF00; }
         if(((byteenable>>1) & 1) == 0) { data &= 0xFFFF00FF; io_data &= 0xFFFF00FF; }
         if(((byteenable>>2) & 1) == 0) { data &= 0xFF00FFFF; io_data &= 0xFF00FFFF; }
         if(((byteenable>>3) & 1) == 0) { data &= 0x00FFFFFF; io_data &= 0x00FFFFFF; }
         
         if(address != io_addr) {
-            fprintf(stderr, "#check_io_wr MISMATCH:%s | %04x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_io_wr MISMATCH:" CHECK_LINE_FMT " | %04x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         }
         if(byteenable != io_byteena) {
-            fprintf(stderr, "#check_io_wr MISMATCH:%s | %04x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_io_wr MISMATCH:" CHECK_LINE_FMT " | %04x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         }
         if(data != io_data) {
-            fprintf(stderr, "#check_io_wr MISMATCH:%s | %04x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_io_wr MISMATCH:" CHECK_LINE_FMT " | %04x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         } 
     }
     else {
-        fprintf(stderr, "#check_io_wr MISMATCH:%s | %04x %x %08x\n", check_line, address, byteenable, data);
+        fprintf(stderr, "#check_io_wr MISMATCH:" CHECK_LINE_FMT " | %04x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
         exit(-1);
     }
 }
@@ -220,25 +228,24 @@ void check_io_wr(uint32 address, uint32 byteenable, uint32 data) {
 void check_mem_wr(uint32 address, uint32 byteenable, uint32 data) {
     check_init();
     
-    uint32 mem_addr = 0, mem_byteena = 0, mem_data = 0;
-    int scan_ret = sscanf(check_line, "mem wr %x %x %x", &mem_addr, &mem_byteena, &mem_data);
+    uint32 mem_addr = check_line->address, mem_byteena = check_line->byteenable, mem_data = check_line->data;
     
-    if(scan_ret == 3) {
+    if(check_line->op == TRACK_MEM_WR) {
         if(((byteenable>>0) & 1) == 0) { data &= 0xFFFFFF00; mem_data &= 0xFFFFFF00; }
         if(((byteenable>>1) & 1) == 0) { data &= 0xFFFF00FF; mem_data &= 0xFFFF00FF; }
         if(((byteenable>>2) & 1) == 0) { data &= 0xFF00FFFF; mem_data &= 0xFF00FFFF; }
         if(((byteenable>>3) & 1) == 0) { data &= 0x00FFFFFF; mem_data &= 0x00FFFFFF; }
         
         if(address != mem_addr) {
-            fprintf(stderr, "#check_mem_wr MISMATCH:%s != l:%08x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_mem_wr MISMATCH:" CHECK_LINE_FMT " != l:%08x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         }
         if(byteenable != mem_byteena) {
-            fprintf(stderr, "#check_mem_wr MISMATCH:%s != l:%08x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_mem_wr MISMATCH:" CHECK_LINE_FMT " != l:%08x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         }
         if(data != mem_data) {
-            fprintf(stderr, "#check_mem_wr MISMATCH:%s != l:%08x %x %08x\n", check_line, address, byteenable, data);
+            fprintf(stderr, "#check_mem_wr MISMATCH:" CHECK_LINE_FMT " != l:%08x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
             exit(-1);
         }
         
@@ -251,7 +258,7 @@ void check_mem_wr(uint32 address, uint32 byteenable, uint32 data) {
         }
     }
     else {
-        fprintf(stderr, "#check_io_wr MISMATCH:%s != l:%08x %x %08x\n", check_line, address, byteenable, data);
+        fprintf(stderr, "#check_io_wr MISMATCH:" CHECK_LINE_FMT " != l:%08x %x %08x\n", CHECK_LINE_ARGS, address, byteenable, data);
         exit(-1);
     }
 }
@@ -259,21 +266,20 @@ void check_mem_wr(uint32 address, uint32 byteenable, uint32 data) {
 uint32 check_mem_rd(uint32 address, uint32 byteenable) {
     check_init();
     
-    uint32 mem_addr = 0, mem_byteena = 0, mem_data = 0;
-    int scan_ret = sscanf(check_line, "mem rd %x %x %x", &mem_addr, &mem_byteena, &mem_data);
+    uint32 mem_addr = check_line->address, mem_byteena = check_line->byteenable, mem_data = check_line->data;
     
-    if(scan_ret == 3) {
+    if(check_line->op == TRACK_MEM_RD) {
         if(address != mem_addr) {
-            fprintf(stderr, "#check_mem_rd MISMATCH:%s != l:%08x %x\n", check_line, address, byteenable);
+            fprintf(stderr, "#check_mem_rd MISMATCH:" CHECK_LINE_FMT " != l:%08x %x\n", CHECK_LINE_ARGS, address, byteenable);
             exit(-1);
         }
         if(byteenable != mem_byteena) {
-            fprintf(stderr, "#check_mem_rd MISMATCH:%s != l:%08x %x\n", check_line, address, byteenable);
+            fprintf(stderr, "#check_mem_rd MISMATCH:" CHECK_LINE_FMT " != l:%08x %x\n", CHECK_LINE_ARGS, address, byteenable);
             exit(-1);
         }
     }
     else {
-        fprintf(stderr, "#check_mem_rd MISMATCH:%s != l:%04x %x\n", check_line, address, byteenable);
+        fprintf(stderr, "#check_mem_rd MISMATCH:" CHECK_LINE_FMT " != l:%04x %x\n", CHECK_LINE_ARGS, address, byteenable);
         exit(-1);
     }
     return mem_data;
@@ -287,10 +293,14 @@ int main(int argc, char **argv) {
     load_file("./../../../sd/vgabios/vgabios_lgpl", 0xC0000);
     
     {
-        FILE *fp = fopen("track.txt", "w");
-        fclose(fp);
+        if(track_writer_open(&track, "track.trk") == false) {
+            fprintf(stderr, "#ao486_reader: can not open track.trk.\n");
+            exit(-1);
+        }
         
-        fp = fopen("interrupt.txt", "w");
+        atexit(track_close_at_exit);
+        
+        FILE *fp = fopen("interrupt.txt", "w");
         fclose(fp);
     }
     //--------------------------------------------------------------------------
@@ -339,8 +349,10 @@ int main(int argc, char **argv) {
     
     uint64 cycle = 0;
     
-    char irq_txt[256];
-    int  irq_delay = 0;
+    char   irq_txt[256];
+    int    irq_delay  = 0;
+    uint32 irq_vector = 0;
+    uint32 irq_at     = 0;
     
     while(!Verilated::gotFinish()) {
         
@@ -382,9 +394,7 @@ int main(int argc, char **argv) {
             
 printf("mem wr: %08x %x %08x %d\n", address, top->sdram_byteenable, data, sdram_write_count);
 
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem wr %08x %x %08x\n", address, top->sdram_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_WR, instr_counter, address, top->sdram_byteenable, data);
             
             check_mem_wr(address, top->sdram_byteenable, data);
             
@@ -414,9 +424,7 @@ printf("mem rd: %08x %x %d\n", vga_read_address, vga_read_byteenable, vga_read_c
             top->vga_readdatavalid = 1;
             top->vga_readdata = value;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem rd %08x %x %08x\n", vga_read_address, vga_read_byteenable, value);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_RD, instr_counter, vga_read_address, vga_read_byteenable, value);
             
             vga_read_address = (vga_read_address + 4) & 0x000FFFFC;
             vga_read_count--;
@@ -431,9 +439,7 @@ printf("mem rd: %08x %x %d\n", vga_read_address, vga_read_byteenable, vga_read_c
             if((top->vga_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->vga_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "mem wr %08x %x %08x\n", address, top->sdram_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_MEM_WR, instr_counter, address, top->sdram_byteenable, data);
             
 printf("mem wr: %08x %x %08x %d\n", address, top->sdram_byteenable, data, vga_write_count);
 
@@ -462,9 +468,7 @@ printf("io rd: %08x %x %d\n", io_read_address, io_read_byteenable, io_read_count
             
             uint32 value = check_io_rd(io_read_address, io_read_byteenable);
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "io rd %04x %x %08x\n", io_read_address, io_read_byteenable, value);
-            fclose(fp);
+            track_write(&track, TRACK_IO_RD, instr_counter, io_read_address, io_read_byteenable, value);
             
 //if(io_read_address == 0x01F0 && io_read_byteenable == 0xF && value == 0x655301c6) shared_ptr->dump_enabled = 1;
             
@@ -482,9 +486,7 @@ printf("io rd: %08x %x %d\n", io_read_address, io_read_byteenable, io_read_count
             if((top->avalon_io_byteenable & 0x4) == 0) data &= 0xFF00FFFF;
             if((top->avalon_io_byteenable & 0x8) == 0) data &= 0x00FFFFFF;
             
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "io wr %04x %x %08x\n", top->avalon_io_address & 0x0000FFFC, top->avalon_io_byteenable, data);
-            fclose(fp);
+            track_write(&track, TRACK_IO_WR, instr_counter, top->avalon_io_address & 0x0000FFFC, top->avalon_io_byteenable, data);
             
 printf("io wr: %08x %x %08x\n", (top->avalon_io_address & 0x0000FFFC), top->avalon_io_byteenable, data);
 
@@ -503,15 +505,15 @@ if(instr_counter >= 77020000) dump_enabled = 1;
         
         if(top->interrupt_done) {
             sprintf(irq_txt, "IAC 0x%02x at %d\n", check_next_irq_vector, instr_counter);
+            irq_vector = check_next_irq_vector;
+            irq_at     = instr_counter;
             irq_delay = 3;
         }
         else if(irq_delay > 0) {
             if(irq_delay == 1) {
-                FILE *fp = fopen("track.txt", "a");
-                fprintf(fp, irq_txt);
-                fclose(fp);
+                track_write(&track, TRACK_IAC, instr_counter, irq_vector, TRACK_IAC_NORMAL, irq_at);
 
-                fp = fopen("interrupt.txt", "a");
+                FILE *fp = fopen("interrupt.txt", "a");
                 fprintf(fp, irq_txt);
                 fclose(fp);
             }
@@ -522,9 +524,7 @@ if(instr_counter >= 77020000) dump_enabled = 1;
         //---------------------------------------------------------------------- exception
         
         if(top->dbg_exc) {
-            FILE *fp = fopen("track.txt", "a");
-            fprintf(fp, "Exception 0x%02x at %d\n", top->dbg_exc_vector, instr_counter);
-            fclose(fp);
+            track_write(&track, TRACK_EXCEPTION, instr_counter, top->dbg_exc_vector, 0, instr_counter);
         }
         
         //----------------------------------------------------------------------
@@ -0,0 +1,1706 @@
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <vector>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Vmain.h"
+#include "Vmain___024root.h"
+#include "verilated.h"
+
+#include "ref486.h"
+#include "handoff.h"
+
+/* Random instruction stress test: replaces the modelsim flow of
+ * sim/modelsim/cpu/lua_tests/asm_code.lua (FASM, vsim_comm.lua and a manual
+ * diff of the cpu_export.vhd log).
+ *
+ * For every seed a random real mode program is generated and encoded here,
+ * then run twice from reset: on the Verilated core with a plain memory model,
+ * and on the reference model (sim/ref486). After every retired instruction
+ * the eight general registers and EFLAGS are recorded; the two traces are
+ * compared instruction by instruction, and at the end the stack and data
+ * window of both memories.
+ *
+ *   0xFFFF0: jmp 0000:0000          (the fake boot rom, as boot0.rom)
+ *   0x00000: prologue: ds=es=ss=0, esp=0x7000, random eax..edi
+ *   ...      random body
+ *   end:     jmp $
+ *
+ * The generator keeps the program well defined on any 486:
+ *   - esp is never written except by push/pop, which are kept balanced;
+ *   - memory operands are [bx+disp8] right after a mov bx,imm16 into the
+ *     data window, string operations get si/di the same way;
+ *   - div gets a non-zero divisor and a zero high half, bsf/bsr a non-zero
+ *     source, shift counts stay below the operand width;
+ *   - jumps are forward over nops only, so the set of defined flags at each
+ *     instruction does not depend on the path;
+ *   - a flag left undefined by an instruction (the manuals' "undefined") is
+ *     neither compared nor read until an instruction defines it again.
+ *
+ * With --x87 (an AO486_FPU build, make main_stress_x87) the program tests
+ * the FPU instead, see the x87 section below.
+ *
+ * Seeds are sharded over --jobs worker processes, each pinned to one core.
+ * A failing seed writes <out>/seed_<n>.txt: the first difference followed
+ * by the full listing.
+ */
+
+#define STRESS_MEMORY_SIZE  (2u << 20)
+#define STRESS_CODE_MAX     0x6000
+#define STRESS_WINDOW_START 0x6000  //stack and data, compared at the end
+#define STRESS_STACK        0x7000
+#define STRESS_DATA         0x8000
+#define STRESS_WINDOW_END   0x9000
+#define STRESS_STACK_MAX    128     //bytes pushed at most
+
+#define STRESS_CF 0x001
+#define STRESS_PF 0x004
+#define STRESS_AF 0x010
+#define STRESS_ZF 0x040
+#define STRESS_SF 0x080
+#define STRESS_DF 0x400
+#define STRESS_OF 0x800
+
+#define STRESS_ARITH  (STRESS_CF | STRESS_PF | STRESS_AF | STRESS_ZF | STRESS_SF | STRESS_OF)
+#define STRESS_LOGIC  (STRESS_CF | STRESS_PF | STRESS_ZF | STRESS_SF | STRESS_OF)
+#define STRESS_LAHF   (STRESS_CF | STRESS_PF | STRESS_AF | STRESS_ZF | STRESS_SF)
+
+//------------------------------------------------------------------------------ program
+
+struct stress_instr_t {
+    uint32 offset;
+    uint32 length;
+    uint32 defined;     //arithmetic flags defined after it
+    char   text[64];
+};
+
+struct stress_x87_block_t {
+    uint8  image[108];  //FRSTOR image: control, status, tag words, pointers, st(0)..st(7)
+    uint8  operand[16];
+    uint8  instr[2];
+    uint32 index;       //of the instruction in instrs
+};
+
+struct stress_program_t {
+    uint8  code[STRESS_CODE_MAX];
+    uint32 length;
+    uint32 end;         //offset of the final jmp $
+
+    std::vector<stress_instr_t> instrs;
+    std::vector<int>            index_at;   //instruction starting at an offset, or -1
+
+    std::vector<stress_x87_block_t> x87;    //--x87 only
+};
+
+struct stress_gen_t {
+    stress_program_t *program;
+
+    uint32 rng;
+    uint32 defined;
+    uint32 stack;       //bytes pushed
+
+    uint8  bytes[16];   //instruction being encoded
+    uint32 count;
+};
+
+static uint32 gen_random(stress_gen_t &g) {
+    g.rng ^= g.rng << 13;
+    g.rng ^= g.rng >> 17;
+    g.rng ^= g.rng << 5;
+    return g.rng;
+}
+
+static inline uint32 gen_below(stress_gen_t &g, uint32 n) {
+    return gen_random(g) % n;
+}
+
+static inline void gen_byte(stress_gen_t &g, uint32 value) {
+    g.bytes[g.count++] = value & 0xFF;
+}
+
+static void gen_imm(stress_gen_t &g, uint32 value, uint32 size) {
+    for(uint32 i=0; i<size/8; i++) gen_byte(g, value >> (i*8));
+}
+
+static inline void gen_prefix(stress_gen_t &g, uint32 size) {
+    if(size == 32) gen_byte(g, 0x66);
+}
+
+static inline bool gen_readable(const stress_gen_t &g, uint32 flags) {
+    return (g.defined & flags) == flags;
+}
+
+//closes the instruction in 'bytes' with the flags it defines and leaves undefined
+static void gen_end(stress_gen_t &g, uint32 defines, uint32 undefines, const char *format, ...) {
+    stress_program_t &p = *g.program;
+
+    stress_instr_t in;
+    in.offset = p.length;
+    in.length = g.count;
+
+    g.defined  = (g.defined | defines) & ~undefines;
+    in.defined = g.defined;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(in.text, sizeof(in.text), format, args);
+    va_end(args);
+
+    memcpy(&p.code[p.length], g.bytes, g.count);
+    p.index_at[p.length] = p.instrs.size();
+    p.instrs.push_back(in);
+
+    p.length += g.count;
+    g.count   = 0;
+}
+
+static const char *reg_names[3][8] = {
+    { "al",  "cl",  "dl",  "bl",  "ah",  "ch",  "dh",  "bh"  },
+    { "ax",  "cx",  "dx",  "bx",  "sp",  "bp",  "si",  "di"  },
+    { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" },
+};
+
+static const char *size_names[3] = { "byte", "word", "dword" };
+
+static const char *alu_names[8]   = { "add", "or", "adc", "sbb", "and", "sub", "xor", "cmp" };
+static const char *shift_names[8] = { "rol", "ror", "rcl", "rcr", "shl", "shr", "sal", "sar" };
+
+static const char *condition_names[16] = { "o", "no", "b", "nb", "z", "nz", "be", "nbe", "s", "ns", "p", "np", "l", "nl", "le", "nle" };
+static const uint32 condition_reads[8]  = { STRESS_OF, STRESS_CF, STRESS_ZF, STRESS_CF | STRESS_ZF, STRESS_SF, STRESS_PF, STRESS_SF | STRESS_OF, STRESS_ZF | STRESS_SF | STRESS_OF };
+
+static inline uint32 size_index(uint32 size) {
+    return (size == 8)? 0 : (size == 16)? 1 : 2;
+}
+
+static inline const char *reg_name(uint32 index, uint32 size) {
+    return reg_names[size_index(size)][index];
+}
+
+static inline uint32 gen_size(stress_gen_t &g) {
+    static const uint32 sizes[3] = { 8, 16, 32 };
+    return sizes[gen_below(g, 3)];
+}
+
+//any register; a written register is never sp/esp, ah (index 4 too) is fine
+static inline uint32 gen_reg(stress_gen_t &g) {
+    return gen_below(g, 8);
+}
+
+static uint32 gen_dst(stress_gen_t &g, uint32 size) {
+    uint32 index = gen_below(g, 8);
+    while(size != 8 && index == 4) index = gen_below(g, 8);
+    return index;
+}
+
+static uint32 gen_value(stress_gen_t &g, uint32 size) {
+    uint32 value = gen_random(g);
+    //small and boundary values find more carry and overflow cases than uniform ones
+    switch(gen_below(g, 4)) {
+        case 0: value &= 0xF; break;
+        case 1: value = (gen_below(g, 2))? 0 - (value & 0xF) : (0x7FFFFFFF - (value & 0xF)); break;
+        default: break;
+    }
+    return (size == 32)? value : value & ((1u << size) - 1);
+}
+
+//a condition readable now, or false
+static bool gen_condition(stress_gen_t &g, uint32 &cc) {
+    uint32 start = gen_below(g, 16);
+    for(uint32 i=0; i<16; i++) {
+        cc = (start + i) & 15;
+        if(gen_readable(g, condition_reads[cc >> 1])) return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------ forms
+
+static void gen_define_flags(stress_gen_t &g) {
+    uint32 size = gen_size(g);
+    uint32 a    = gen_reg(g);
+    uint32 b    = gen_reg(g);
+
+    gen_prefix(g, size);
+    gen_byte(g, (size == 8)? 0x38 : 0x39);
+    gen_byte(g, 0xC0 | (b << 3) | a);
+    gen_end(g, STRESS_ARITH, 0, "cmp %s, %s", reg_name(a, size), reg_name(b, size));
+}
+
+static void gen_alu(stress_gen_t &g) {
+    uint32 op   = gen_below(g, 8);
+    uint32 size = gen_size(g);
+    uint32 dst  = (op == 7)? gen_reg(g) : gen_dst(g, size);
+
+    if((op == 2 || op == 3) && gen_readable(g, STRESS_CF) == false) op = 0;
+
+    bool   logic    = op == 1 || op == 4 || op == 6;
+    uint32 defines  = (logic)? STRESS_LOGIC : STRESS_ARITH;
+    uint32 undefine = (logic)? STRESS_AF : 0;
+
+    gen_prefix(g, size);
+
+    if(gen_below(g, 2)) {
+        uint32 src = gen_reg(g);
+        gen_byte(g, op*8 + ((size == 8)? 0 : 1));
+        gen_byte(g, 0xC0 | (src << 3) | dst);
+        gen_end(g, defines, undefine, "%s %s, %s", alu_names[op], reg_name(dst, size), reg_name(src, size));
+    }
+    else if(size != 8 && gen_below(g, 2)) {
+        uint32 imm = gen_random(g) & 0xFF;
+        gen_byte(g, 0x83);
+        gen_byte(g, 0xC0 | (op << 3) | dst);
+        gen_byte(g, imm);
+        gen_end(g, defines, undefine, "%s %s, byte %d", alu_names[op], reg_name(dst, size), (int)(signed char)imm);
+    }
+    else {
+        uint32 imm = gen_value(g, size);
+        gen_byte(g, (size == 8)? 0x80 : 0x81);
+        gen_byte(g, 0xC0 | (op << 3) | dst);
+        gen_imm(g, imm, size);
+        gen_end(g, defines, undefine, "%s %s, 0x%x", alu_names[op], reg_name(dst, size), imm);
+    }
+}
+
+static void gen_test(stress_gen_t &g) {
+    uint32 size = gen_size(g);
+    uint32 a    = gen_reg(g);
+    uint32 b    = gen_reg(g);
+
+    gen_prefix(g, size);
+    gen_byte(g, (size == 8)? 0x84 : 0x85);
+    gen_byte(g, 0xC0 | (b << 3) | a);
+    gen_end(g, STRESS_LOGIC, STRESS_AF, "test %s, %s", reg_name(a, size), reg_name(b, size));
+}
+
+static void gen_mov(stress_gen_t &g) {
+    uint32 size = gen_size(g);
+    uint32 dst  = gen_dst(g, size);
+
+    gen_prefix(g, size);
+
+    if(gen_below(g, 2)) {
+        uint32 src = gen_reg(g);
+        gen_byte(g, (size == 8)? 0x88 : 0x89);
+        gen_byte(g, 0xC0 | (src << 3) | dst);
+        gen_end(g, 0, 0, "mov %s, %s", reg_name(dst, size), reg_name(src, size));
+    }
+    else {
+        uint32 imm = gen_value(g, size);
+        gen_byte(g, ((size == 8)? 0xB0 : 0xB8) + dst);
+        gen_imm(g, imm, size);
+        gen_end(g, 0, 0, "mov %s, 0x%x", reg_name(dst, size), imm);
+    }
+}
+
+static void gen_inc_dec_neg_not(stress_gen_t &g) {
+    uint32 size = gen_size(g);
+    uint32 dst  = gen_dst(g, size);
+    uint32 kind = gen_below(g, 4);
+
+    gen_prefix(g, size);
+
+    if(kind < 2) {
+        const char *name = (kind == 0)? "inc" : "dec";
+        if(size == 8) {
+            gen_byte(g, 0xFE);
+            gen_byte(g, 0xC0 | (kind << 3) | dst);
+        }
+        else {
+            gen_byte(g, ((kind == 0)? 0x40 : 0x48) + dst);
+        }
+        gen_end(g, STRESS_ARITH & ~STRESS_CF, 0, "%s %s", name, reg_name(dst, size));
+    }
+    else {
+        uint32 op = (kind == 2)? 3 : 2;
+        gen_byte(g, (size == 8)? 0xF6 : 0xF7);
+        gen_byte(g, 0xC0 | (op << 3) | dst);
+        if(op == 3) gen_end(g, STRESS_ARITH, 0, "neg %s", reg_name(dst, size));
+        else        gen_end(g, 0, 0, "not %s", reg_name(dst, size));
+    }
+}
+
+//count 1..width-1: larger counts leave CF undefined on the narrow forms
+static void gen_shift(stress_gen_t &g) {
+    static const uint32 ops[7] = { 0, 1, 2, 3, 4, 5, 7 };
+
+    uint32 op    = ops[gen_below(g, 7)];
+    uint32 size  = gen_size(g);
+    uint32 dst   = gen_dst(g, size);
+    uint32 count = (gen_below(g, 2))? 1 : 1 + gen_below(g, size - 1);
+
+    bool rotate = op < 4;
+    if((op == 2 || op == 3) && gen_readable(g, STRESS_CF) == false) op = 0;
+
+    gen_prefix(g, size);
+    if(count == 1) {
+        gen_byte(g, (size == 8)? 0xD0 : 0xD1);
+        gen_byte(g, 0xC0 | (op << 3) | dst);
+    }
+    else {
+        gen_byte(g, (size == 8)? 0xC0 : 0xC1);
+        gen_byte(g, 0xC0 | (op << 3) | dst);
+        gen_byte(g, count);
+    }
+
+    uint32 defines, undefines;
+    if(rotate) {
+        defines   = STRESS_CF | ((count == 1)? STRESS_OF : 0);
+        undefines = (count == 1)? 0 : STRESS_OF;
+    }
+    else {
+        defines   = STRESS_CF | STRESS_PF | STRESS_ZF | STRESS_SF | ((count == 1)? STRESS_OF : 0);
+        undefines = STRESS_AF | ((count == 1)? 0 : STRESS_OF);
+    }
+    gen_end(g, defines, undefines, "%s %s, %u", shift_names[op], reg_name(dst, size), count);
+}
+
+static void gen_shift_double(stress_gen_t &g) {
+    uint32 size  = (gen_below(g, 2))? 16 : 32;
+    uint32 dst   = gen_dst(g, size);
+    uint32 src   = gen_reg(g);
+    uint32 count = 1 + gen_below(g, size - 1);
+    bool   left  = gen_below(g, 2);
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x0F);
+    gen_byte(g, (left)? 0xA4 : 0xAC);
+    gen_byte(g, 0xC0 | (src << 3) | dst);
+    gen_byte(g, count);
+
+    uint32 defines   = STRESS_CF | STRESS_PF | STRESS_ZF | STRESS_SF | ((count == 1)? STRESS_OF : 0);
+    uint32 undefines = STRESS_AF | ((count == 1)? 0 : STRESS_OF);
+    gen_end(g, defines, undefines, "%s %s, %s, %u", (left)? "shld" : "shrd", reg_name(dst, size), reg_name(src, size), count);
+}
+
+static void gen_multiply(stress_gen_t &g) {
+    uint32 size      = gen_size(g);
+    uint32 defines   = STRESS_CF | STRESS_OF;
+    uint32 undefines = STRESS_SF | STRESS_ZF | STRESS_AF | STRESS_PF;
+    uint32 kind      = (size == 8)? 0 : gen_below(g, 3);
+
+    gen_prefix(g, size);
+
+    if(kind == 0) {
+        uint32 src       = gen_reg(g);
+        bool   is_signed = gen_below(g, 2);
+        gen_byte(g, (size == 8)? 0xF6 : 0xF7);
+        gen_byte(g, 0xC0 | (((is_signed)? 5 : 4) << 3) | src);
+        gen_end(g, defines, undefines, "%s %s", (is_signed)? "imul" : "mul", reg_name(src, size));
+    }
+    else if(kind == 1) {
+        uint32 dst = gen_dst(g, size);
+        uint32 src = gen_reg(g);
+        gen_byte(g, 0x0F);
+        gen_byte(g, 0xAF);
+        gen_byte(g, 0xC0 | (dst << 3) | src);
+        gen_end(g, defines, undefines, "imul %s, %s", reg_name(dst, size), reg_name(src, size));
+    }
+    else {
+        uint32 dst = gen_dst(g, size);
+        uint32 src = gen_reg(g);
+        uint32 imm = gen_random(g) & 0xFF;
+        gen_byte(g, 0x6B);
+        gen_byte(g, 0xC0 | (dst << 3) | src);
+        gen_byte(g, imm);
+        gen_end(g, defines, undefines, "imul %s, %s, %d", reg_name(dst, size), reg_name(src, size), (int)(signed char)imm);
+    }
+}
+
+//or divisor,1 then a zero high half: the quotient always fits
+static void gen_divide(stress_gen_t &g) {
+    uint32 size    = gen_size(g);
+    uint32 divisor = gen_dst(g, size);
+
+    //not the dividend: al/ah for bytes, ax/dx otherwise
+    while(divisor == 0 || divisor == ((size == 8)? 4u : 2u)) divisor = gen_dst(g, size);
+
+    gen_prefix(g, size);
+    gen_byte(g, (size == 8)? 0x80 : 0x83);
+    gen_byte(g, 0xC0 | (1 << 3) | divisor);
+    gen_byte(g, 1);
+    gen_end(g, STRESS_LOGIC, STRESS_AF, "or %s, 1", reg_name(divisor, size));
+
+    if(size == 8) {
+        gen_byte(g, 0xB4);
+        gen_byte(g, 0x00);
+        gen_end(g, 0, 0, "mov ah, 0");
+    }
+    else {
+        gen_prefix(g, size);
+        gen_byte(g, 0x31);
+        gen_byte(g, 0xD2);
+        gen_end(g, STRESS_LOGIC, STRESS_AF, "xor %s, %s", reg_name(2, size), reg_name(2, size));
+    }
+
+    gen_prefix(g, size);
+    gen_byte(g, (size == 8)? 0xF6 : 0xF7);
+    gen_byte(g, 0xC0 | (6 << 3) | divisor);
+    gen_end(g, 0, STRESS_ARITH, "div %s", reg_name(divisor, size));
+}
+
+static void gen_bit_test(stress_gen_t &g) {
+    static const char *names[4] = { "bt", "bts", "btr", "btc" };
+
+    uint32 size = (gen_below(g, 2))? 16 : 32;
+    uint32 op   = gen_below(g, 4);
+    uint32 dst  = gen_dst(g, size);
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x0F);
+
+    if(gen_below(g, 2)) {
+        uint32 src = gen_reg(g);
+        gen_byte(g, 0xA3 + op*8);
+        gen_byte(g, 0xC0 | (src << 3) | dst);
+        gen_end(g, STRESS_CF, STRESS_OF | STRESS_SF | STRESS_AF | STRESS_PF, "%s %s, %s", names[op], reg_name(dst, size), reg_name(src, size));
+    }
+    else {
+        uint32 bit = gen_random(g) & 0xFF;
+        gen_byte(g, 0xBA);
+        gen_byte(g, 0xC0 | ((4 + op) << 3) | dst);
+        gen_byte(g, bit);
+        gen_end(g, STRESS_CF, STRESS_OF | STRESS_SF | STRESS_AF | STRESS_PF, "%s %s, %u", names[op], reg_name(dst, size), bit);
+    }
+}
+
+//the destination of bsf/bsr is undefined for a zero source, so make it non-zero first
+static void gen_bit_scan(stress_gen_t &g) {
+    uint32 size    = (gen_below(g, 2))? 16 : 32;
+    uint32 dst     = gen_dst(g, size);
+    uint32 src     = gen_dst(g, size);
+    uint32 nonzero = 1 + gen_below(g, 0x7F);
+    bool   reverse = gen_below(g, 2);
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x83);
+    gen_byte(g, 0xC0 | (1 << 3) | src);
+    gen_byte(g, nonzero);
+    gen_end(g, STRESS_LOGIC, STRESS_AF, "or %s, %u", reg_name(src, size), nonzero);
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x0F);
+    gen_byte(g, (reverse)? 0xBD : 0xBC);
+    gen_byte(g, 0xC0 | (dst << 3) | src);
+    gen_end(g, STRESS_ZF, STRESS_ARITH & ~STRESS_ZF, "%s %s, %s", (reverse)? "bsr" : "bsf", reg_name(dst, size), reg_name(src, size));
+}
+
+static void gen_extend(stress_gen_t &g) {
+    uint32 size      = (gen_below(g, 2))? 16 : 32;
+    uint32 src_size  = (size == 32 && gen_below(g, 2))? 16 : 8;
+    bool   is_signed = gen_below(g, 2);
+    uint32 dst       = gen_dst(g, size);
+    uint32 src       = gen_reg(g);
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x0F);
+    gen_byte(g, ((is_signed)? 0xBE : 0xB6) + ((src_size == 16)? 1 : 0));
+    gen_byte(g, 0xC0 | (dst << 3) | src);
+    gen_end(g, 0, 0, "%s %s, %s", (is_signed)? "movsx" : "movzx", reg_name(dst, size), reg_name(src, src_size));
+}
+
+static void gen_exchange(stress_gen_t &g) {
+    uint32 size = gen_size(g);
+    uint32 a    = gen_dst(g, size);
+    uint32 b    = gen_dst(g, size);
+    uint32 kind = gen_below(g, 3);
+
+    gen_prefix(g, size);
+
+    if(kind == 0) {
+        gen_byte(g, (size == 8)? 0x86 : 0x87);
+        gen_byte(g, 0xC0 | (b << 3) | a);
+        gen_end(g, 0, 0, "xchg %s, %s", reg_name(a, size), reg_name(b, size));
+    }
+    else {
+        gen_byte(g, 0x0F);
+        gen_byte(g, ((kind == 1)? 0xC0 : 0xB0) + ((size == 8)? 0 : 1));
+        gen_byte(g, 0xC0 | (b << 3) | a);
+        gen_end(g, STRESS_ARITH, 0, "%s %s, %s", (kind == 1)? "xadd" : "cmpxchg", reg_name(a, size), reg_name(b, size));
+    }
+}
+
+//bswap needs the 32-bit operand size; the 16-bit form is undefined
+static void gen_bswap(stress_gen_t &g) {
+    uint32 dst = gen_dst(g, 32);
+
+    gen_byte(g, 0x66);
+    gen_byte(g, 0x0F);
+    gen_byte(g, 0xC8 + dst);
+    gen_end(g, 0, 0, "bswap %s", reg_name(dst, 32));
+}
+
+static void gen_setcc(stress_gen_t &g) {
+    uint32 cc;
+    if(gen_condition(g, cc) == false) {
+        gen_define_flags(g);
+        return;
+    }
+    uint32 dst = gen_reg(g);
+
+    gen_byte(g, 0x0F);
+    gen_byte(g, 0x90 + cc);
+    gen_byte(g, 0xC0 | dst);
+    gen_end(g, 0, 0, "set%s %s", condition_names[cc], reg_name(dst, 8));
+}
+
+//forward only, over nops
+static void gen_jump(stress_gen_t &g) {
+    uint32 cc;
+    bool   conditional = gen_below(g, 4) != 0;
+
+    if(conditional && gen_condition(g, cc) == false) {
+        gen_define_flags(g);
+        return;
+    }
+    uint32 distance = 1 + gen_below(g, 5);
+
+    gen_byte(g, (conditional)? 0x70 + cc : 0xEB);
+    gen_byte(g, distance);
+    if(conditional) gen_end(g, 0, 0, "j%s +%u", condition_names[cc], distance);
+    else            gen_end(g, 0, 0, "jmp +%u", distance);
+
+    for(uint32 i=0; i<distance; i++) {
+        gen_byte(g, 0x90);
+        gen_end(g, 0, 0, "nop");
+    }
+}
+
+static void gen_flag_op(stress_gen_t &g) {
+    switch(gen_below(g, 7)) {
+        case 0: gen_byte(g, 0xF8); gen_end(g, STRESS_CF, 0, "clc"); break;
+        case 1: gen_byte(g, 0xF9); gen_end(g, STRESS_CF, 0, "stc"); break;
+        case 2:
+            if(gen_readable(g, STRESS_CF) == false) { gen_byte(g, 0xF9); gen_end(g, STRESS_CF, 0, "stc"); break; }
+            gen_byte(g, 0xF5); gen_end(g, STRESS_CF, 0, "cmc");
+            break;
+        case 3: gen_byte(g, 0xFC); gen_end(g, 0, 0, "cld"); break;
+        case 4: gen_byte(g, 0xFD); gen_end(g, 0, 0, "std"); break;
+        case 5:
+            if(gen_readable(g, STRESS_LAHF) == false) { gen_define_flags(g); break; }
+            gen_byte(g, 0x9F); gen_end(g, 0, 0, "lahf");
+            break;
+        case 6: gen_byte(g, 0x9E); gen_end(g, STRESS_LAHF, 0, "sahf"); break;
+    }
+}
+
+static void gen_convert(stress_gen_t &g) {
+    static const char *names[4] = { "cbw", "cwde", "cwd", "cdq" };
+    uint32 kind = gen_below(g, 4);
+
+    if(kind & 1) gen_byte(g, 0x66);
+    gen_byte(g, (kind < 2)? 0x98 : 0x99);
+    gen_end(g, 0, 0, "%s", names[kind]);
+}
+
+static void gen_decimal(stress_gen_t &g) {
+    switch(gen_below(g, 6)) {
+        case 0: case 1: {
+            bool das = gen_below(g, 2);
+            if(gen_readable(g, STRESS_CF | STRESS_AF) == false) { gen_define_flags(g); break; }
+            gen_byte(g, (das)? 0x2F : 0x27);
+            gen_end(g, STRESS_LAHF, STRESS_OF, (das)? "das" : "daa");
+            break;
+        }
+        case 2: case 3: {
+            bool aas = gen_below(g, 2);
+            if(gen_readable(g, STRESS_AF) == false) { gen_define_flags(g); break; }
+            gen_byte(g, (aas)? 0x3F : 0x37);
+            gen_end(g, STRESS_AF | STRESS_CF, STRESS_OF | STRESS_SF | STRESS_ZF | STRESS_PF, (aas)? "aas" : "aaa");
+            break;
+        }
+        default: {
+            bool   aad  = gen_below(g, 2);
+            uint32 base = 1 + gen_below(g, 255);
+            gen_byte(g, (aad)? 0xD5 : 0xD4);
+            gen_byte(g, base);
+            gen_end(g, STRESS_SF | STRESS_ZF | STRESS_PF, STRESS_OF | STRESS_AF | STRESS_CF, "%s %u", (aad)? "aad" : "aam", base);
+            break;
+        }
+    }
+}
+
+static void gen_lea(stress_gen_t &g) {
+    static const char *bases[8] = { "bx+si", "bx+di", "bp+si", "bp+di", "si", "di", "bp", "bx" };
+
+    uint32 size = (gen_below(g, 2))? 16 : 32;
+    uint32 dst  = gen_dst(g, size);
+    uint32 rm   = gen_below(g, 8);
+    uint32 disp = gen_random(g) & 0xFF;
+
+    gen_prefix(g, size);
+    gen_byte(g, 0x8D);
+    gen_byte(g, 0x40 | (dst << 3) | rm);
+    gen_byte(g, disp);
+    gen_end(g, 0, 0, "lea %s, [%s%+d]", reg_name(dst, size), bases[rm], (int)(signed char)disp);
+}
+
+static void gen_stack(stress_gen_t &g) {
+    uint32 size  = (gen_below(g, 2))? 16 : 32;
+    uint32 bytes = size / 8;
+    uint32 kind  = gen_below(g, 4);
+
+    if(kind == 0 && g.stack >= bytes) {
+        uint32 dst = gen_dst(g, size);
+        gen_prefix(g, size);
+        gen_byte(g, 0x58 + dst);
+        gen_end(g, 0, 0, "pop %s", reg_name(dst, size));
+        g.stack -= bytes;
+        return;
+    }
+    if(g.stack + bytes > STRESS_STACK_MAX) {
+        gen_mov(g);
+        return;
+    }
+
+    gen_prefix(g, size);
+    if(kind == 1 && gen_readable(g, STRESS_ARITH)) {
+        gen_byte(g, 0x9C);
+        gen_end(g, 0, 0, (size == 32)? "pushfd" : "pushf");
+    }
+    else if(kind == 2) {
+        uint32 imm = gen_value(g, size);
+        gen_byte(g, 0x68);
+        gen_imm(g, imm, size);
+        gen_end(g, 0, 0, "push %s 0x%x", size_names[size_index(size)], imm);
+    }
+    else {
+        uint32 src = gen_reg(g);
+        gen_byte(g, 0x50 + src);
+        gen_end(g, 0, 0, "push %s", reg_name(src, size));
+    }
+    g.stack += bytes;
+}
+
+//mov bx,imm16 into the data window, then one [bx+disp8] form
+static void gen_memory(stress_gen_t &g) {
+    uint32 base = STRESS_DATA + 0x80 + gen_below(g, 0xE00);
+    uint32 size = gen_size(g);
+    uint32 disp = gen_random(g) & 0xFF;
+    int    d    = (signed char)disp;
+
+    gen_byte(g, 0xBB);
+    gen_imm(g, base, 16);
+    gen_end(g, 0, 0, "mov bx, 0x%x", base);
+
+    const char *mem  = size_names[size_index(size)];
+    uint32      wide = (size == 8)? 0 : 1;
+    uint32      kind = gen_below(g, 7);
+
+    gen_prefix(g, size);
+
+    if(kind == 0 || kind == 1) {
+        bool   load = kind == 0;
+        uint32 reg  = (load)? gen_dst(g, size) : gen_reg(g);
+        gen_byte(g, ((load)? 0x8A : 0x88) + wide);
+        gen_byte(g, 0x40 | (reg << 3) | 7);
+        gen_byte(g, disp);
+        if(load) gen_end(g, 0, 0, "mov %s, %s [bx%+d]", reg_name(reg, size), mem, d);
+        else     gen_end(g, 0, 0, "mov %s [bx%+d], %s", mem, d, reg_name(reg, size));
+    }
+    else if(kind == 2 || kind == 3) {
+        bool   load = kind == 2;
+        uint32 op   = gen_below(g, 8);
+        if((op == 2 || op == 3) && gen_readable(g, STRESS_CF) == false) op = 0;
+
+        bool   logic = op == 1 || op == 4 || op == 6;
+        uint32 reg   = (load && op != 7)? gen_dst(g, size) : gen_reg(g);
+
+        gen_byte(g, op*8 + ((load)? 2 : 0) + wide);
+        gen_byte(g, 0x40 | (reg << 3) | 7);
+        gen_byte(g, disp);
+        if(load) gen_end(g, (logic)? STRESS_LOGIC : STRESS_ARITH, (logic)? STRESS_AF : 0, "%s %s, %s [bx%+d]", alu_names[op], reg_name(reg, size), mem, d);
+        else     gen_end(g, (logic)? STRESS_LOGIC : STRESS_ARITH, (logic)? STRESS_AF : 0, "%s %s [bx%+d], %s", alu_names[op], mem, d, reg_name(reg, size));
+    }
+    else if(kind == 4) {
+        uint32 imm = gen_value(g, size);
+        gen_byte(g, 0xC6 + wide);
+        gen_byte(g, 0x40 | 7);
+        gen_byte(g, disp);
+        gen_imm(g, imm, size);
+        gen_end(g, 0, 0, "mov %s [bx%+d], 0x%x", mem, d, imm);
+    }
+    else if(kind == 5) {
+        uint32 op = gen_below(g, 4);
+        if(op < 2) {
+            gen_byte(g, 0xFE + wide);
+            gen_byte(g, 0x40 | (op << 3) | 7);
+            gen_byte(g, disp);
+            gen_end(g, STRESS_ARITH & ~STRESS_CF, 0, "%s %s [bx%+d]", (op == 0)? "inc" : "dec", mem, d);
+        }
+        else {
+            gen_byte(g, 0xF6 + wide);
+            gen_byte(g, 0x40 | (op << 3) | 7);
+            gen_byte(g, disp);
+            if(op == 3) gen_end(g, STRESS_ARITH, 0, "neg %s [bx%+d]", mem, d);
+            else        gen_end(g, 0, 0, "not %s [bx%+d]", mem, d);
+        }
+    }
+    else {
+        uint32 dst       = gen_dst(g, (size == 8)? 16 : size);
+        uint32 src_size  = (size == 32 && gen_below(g, 2))? 16 : 8;
+        bool   is_signed = gen_below(g, 2);
+        if(size == 8) {
+            size = 16;
+            mem  = size_names[0];
+        }
+        gen_byte(g, 0x0F);
+        gen_byte(g, ((is_signed)? 0xBE : 0xB6) + ((src_size == 16)? 1 : 0));
+        gen_byte(g, 0x40 | (dst << 3) | 7);
+        gen_byte(g, disp);
+        gen_end(g, 0, 0, "%s %s, %s [bx%+d]", (is_signed)? "movsx" : "movzx", reg_name(dst, size), size_names[size_index(src_size)], d);
+    }
+}
+
+//si/di into the data window first; either direction stays inside it
+static void gen_string(stress_gen_t &g) {
+    static const char    *names[5]   = { "movs", "stos", "lods", "cmps", "scas" };
+    static const uint8    opcodes[5] = { 0xA4, 0xAA, 0xAC, 0xA6, 0xAE };
+    static const char     suffix[3]  = { 'b', 'w', 'd' };
+
+    uint32 si = STRESS_DATA + 0x100 + gen_below(g, 0x600);
+    uint32 di = STRESS_DATA + 0x800 + gen_below(g, 0x600);
+
+    gen_byte(g, 0xBE);
+    gen_imm(g, si, 16);
+    gen_end(g, 0, 0, "mov si, 0x%x", si);
+
+    gen_byte(g, 0xBF);
+    gen_imm(g, di, 16);
+    gen_end(g, 0, 0, "mov di, 0x%x", di);
+
+    uint32 size = gen_size(g);
+    uint32 op   = gen_below(g, 5);
+
+    gen_prefix(g, size);
+    gen_byte(g, opcodes[op] + ((size == 8)? 0 : 1));
+    gen_end(g, (op >= 3)? STRESS_ARITH : 0, 0, "%s%c", names[op], suffix[size_index(size)]);
+}
+
+typedef void (*gen_form_t)(stress_gen_t &g);
+
+struct gen_weight_t {
+    gen_form_t form;
+    uint32     weight;
+};
+
+static const gen_weight_t gen_forms[] = {
+    { gen_alu,              12 },
+    { gen_test,              2 },
+    { gen_mov,               8 },
+    { gen_inc_dec_neg_not,   4 },
+    { gen_shift,             6 },
+    { gen_shift_double,      2 },
+    { gen_multiply,          3 },
+    { gen_divide,            2 },
+    { gen_bit_test,          2 },
+    { gen_bit_scan,          2 },
+    { gen_extend,            2 },
+    { gen_exchange,          3 },
+    { gen_bswap,             1 },
+    { gen_setcc,             2 },
+    { gen_jump,              4 },
+    { gen_flag_op,           3 },
+    { gen_convert,           1 },
+    { gen_decimal,           2 },
+    { gen_lea,               1 },
+    { gen_stack,             4 },
+    { gen_memory,            8 },
+    { gen_string,            2 },
+};
+
+static void stress_generate(stress_program_t &p, uint32 seed, uint32 length) {
+    memset(p.code, 0, sizeof(p.code));
+    p.length = 0;
+    p.instrs.clear();
+    p.index_at.assign(STRESS_CODE_MAX, -1);
+    p.x87.clear();
+
+    stress_gen_t g;
+    memset(&g, 0, sizeof(g));
+    g.program = &p;
+    g.rng     = seed * 2654435761u + 0x9E3779B9u;
+    if(g.rng == 0) g.rng = 1;
+
+    //flags are all defined after reset
+    g.defined = STRESS_ARITH;
+
+    //prologue
+    gen_byte(g, 0x31); gen_byte(g, 0xC0);
+    gen_end(g, STRESS_LOGIC, STRESS_AF, "xor ax, ax");
+    gen_byte(g, 0x8E); gen_byte(g, 0xD8);
+    gen_end(g, 0, 0, "mov ds, ax");
+    gen_byte(g, 0x8E); gen_byte(g, 0xC0);
+    gen_end(g, 0, 0, "mov es, ax");
+    gen_byte(g, 0x8E); gen_byte(g, 0xD0);
+    gen_end(g, 0, 0, "mov ss, ax");
+    gen_byte(g, 0x66); gen_byte(g, 0xBC); gen_imm(g, STRESS_STACK, 32);
+    gen_end(g, 0, 0, "mov esp, 0x%x", STRESS_STACK);
+
+    for(uint32 reg=0; reg<8; reg++) {
+        if(reg == 4) continue;
+        uint32 value = gen_random(g);
+        gen_byte(g, 0x66); gen_byte(g, 0xB8 + reg); gen_imm(g, value, 32);
+        gen_end(g, 0, 0, "mov %s, 0x%x", reg_name(reg, 32), value);
+    }
+
+    uint32 total = 0;
+    for(const gen_weight_t &form : gen_forms) total += form.weight;
+
+    //every form stays below 64 bytes
+    while(p.instrs.size() < length && p.length + 64 < STRESS_CODE_MAX) {
+        uint32 pick = gen_below(g, total);
+        for(const gen_weight_t &form : gen_forms) {
+            if(pick < form.weight) {
+                form.form(g);
+                break;
+            }
+            pick -= form.weight;
+        }
+    }
+
+    p.end = p.length;
+    p.code[p.length++] = 0xEB;
+    p.code[p.length++] = 0xFE;
+}
+
+//------------------------------------------------------------------------------ x87
+
+/* --x87: every block of the program loads a random FPU state, runs one random
+ * x87 instruction and saves the state again:
+ *
+ *   mov ebx, image; mov esi, operand; frstor [ebx]; <instruction> [esi]; mov [ax], ax; fnsave [ebx]
+ *
+ * The blocks live in the segment STRESS_X87_SEGMENT, one STRESS_X87_BLOCK each.
+ * The reference is the x87 of the host: the same instruction bytes run between
+ * an FRSTOR and an FNSAVE of the same image, with the operand at [rsi] (the
+ * modrm byte of [esi] with an address size prefix in real mode).
+ *
+ * Compared are the control, status and tag words, st(0)..st(7), the memory
+ * operand, and AX after FNSTSW AX; the instruction and data pointers are not,
+ * their layout differs between real mode and the 64-bit host. Not generated:
+ * FLDCW, FLDENV, FRSTOR, FNSTENV, FNSAVE (they frame every block) and the
+ * transcendentals, whose last bit differs between the 487 and current FPUs.
+ * The loaded states have no unmasked exception pending.
+ */
+
+#define STRESS_X87_SEGMENT  0x1000
+#define STRESS_X87_BLOCK    128     //image, operand, ax
+#define STRESS_X87_OPERAND  108
+#define STRESS_X87_AX       124
+#define STRESS_X87_BLOCKS   512
+
+enum stress_x87_format_t {
+    X87_NONE, X87_M32, X87_M64, X87_M80, X87_I16, X87_I32, X87_I64, X87_BCD
+};
+
+static inline uint64 gen_random64(stress_gen_t &g) {
+    uint64 high = gen_random(g);
+    return (high << 32) | gen_random(g);
+}
+
+static void x87_put(uint8 *out, uint32 sign_exp, uint64 sig) {
+    memcpy(out, &sig, 8);
+    out[8] = sign_exp & 0xFF;
+    out[9] = (sign_exp >> 8) & 0xFF;
+}
+
+static void x87_from_double(double value, uint8 *out) {
+    uint32 sign_exp = (std::signbit(value))? 0x8000 : 0;
+    uint64 sig      = 0;
+
+    if(value != 0) {
+        int exp;
+        double mantissa = frexp(fabs(value), &exp);
+        sig       = (uint64)ldexp(mantissa, 64);
+        sign_exp |= exp - 1 + 16383;
+    }
+    x87_put(out, sign_exp, sig);
+}
+
+//mostly normals near 1.0 and at the ends of the range, every special class
+static void gen_x87_value(stress_gen_t &g, uint8 *out) {
+    static const double small[] = { 1.0, 2.0, 0.5, 3.0, 1.5, -1.0, 10.0, 0.1, 100.0, 65536.0, 1e10, 1e-10, 1e20 };
+    static const double fraction[] = { 0, 0.5, 0.25, 0.75, 0.5000001 };
+
+    uint32 kind = gen_below(g, 15);
+    uint32 sign = gen_below(g, 2) << 15;
+    uint64 sig  = gen_random64(g);
+    uint32 exp  = 0;
+
+    if(kind < 6) {
+        switch(gen_below(g, 5)) {
+            case 0:  exp = 1 + gen_below(g, 32766);   break;
+            case 1:  exp = 16370 + gen_below(g, 31);  break;
+            case 2:  exp = 1 + gen_below(g, 80);      break;
+            case 3:  exp = 32700 + gen_below(g, 67);  break;
+            default: exp = 16000 + gen_below(g, 801); break;
+        }
+        sig |= 1ull << 63;
+        if(gen_below(g, 10) < 3) {
+            static const uint32 shifts[] = { 0, 11, 40, 43 };
+            sig = (1ull << 63) | ((uint64)(gen_random(g) & 0xFFFFF) << shifts[gen_below(g, 4)]);
+        }
+    }
+    else if(kind == 6)  { sig >>= 1 + gen_below(g, 63); if(sig == 0) sig = 1; }   //denormal
+    else if(kind == 7)  { sig = 0; }                                                //zero
+    else if(kind == 8)  { exp = 0x7FFF; sig = 1ull << 63; }                         //infinity
+    else if(kind == 9)  { exp = 0x7FFF; sig = (3ull << 62) | (sig >> (64 - ((gen_below(g, 2))? 20 : 62))); }
+    else if(kind == 10) { exp = 0x7FFF; sig = (1ull << 63) | (sig >> (64 - ((gen_below(g, 2))? 20 : 61))); if(sig == (1ull << 63)) sig |= 1; }
+    else if(kind == 11) { exp = 1 + gen_below(g, 0x7FFF); sig &= ~(1ull << 63); }  //unsupported
+    else if(kind == 12) { x87_from_double(small[gen_below(g, 13)] * ((sign)? -1 : 1), out); return; }
+    else if(kind == 13) { x87_from_double((int)gen_below(g, 140001) - 70000 + fraction[gen_below(g, 5)], out); return; }
+    else                { sig |= 1ull << 63; }                                      //pseudo denormal
+
+    x87_put(out, sign | exp, sig);
+}
+
+static void gen_x87_operand(stress_gen_t &g, stress_x87_format_t format, uint8 *out) {
+    memset(out, 0, 16);
+
+    bool   special = gen_below(g, 2) == 0;
+    uint64 value   = 0;
+
+    if(format == X87_M32) {
+        uint32 exp = 1 + gen_below(g, 254);
+        if(special) { static const uint32 exps[] = { 0, 255 }; exp = (gen_below(g, 2))? exps[gen_below(g, 2)] : 120 + gen_below(g, 16); }
+        uint32 mantissa = (gen_below(g, 5) > 0)? gen_random(g) & 0x7FFFFF : ((gen_below(g, 2))? 1 : 0) << (22 * gen_below(g, 2));
+        value = ((uint64)gen_below(g, 2) << 31) | (exp << 23) | mantissa;
+        memcpy(out, &value, 4);
+    }
+    else if(format == X87_M64) {
+        uint64 exp = 1 + gen_below(g, 2046);
+        if(special) { static const uint32 exps[] = { 0, 2047 }; exp = (gen_below(g, 2))? exps[gen_below(g, 2)] : 1000 + gen_below(g, 51); }
+        uint64 mantissa = (gen_below(g, 5) > 0)? gen_random64(g) & ((1ull << 52) - 1) : (uint64)((gen_below(g, 2))? 1 : 0) << (51 * gen_below(g, 2));
+        value = ((uint64)gen_below(g, 2) << 63) | (exp << 52) | mantissa;
+        memcpy(out, &value, 8);
+    }
+    else if(format == X87_M80) {
+        gen_x87_value(g, out);
+    }
+    else if(format == X87_I16 || format == X87_I32 || format == X87_I64) {
+        uint32 bits = (format == X87_I16)? 16 : (format == X87_I32)? 32 : 64;
+        uint64 min  = 1ull << (bits - 1);
+
+        switch(gen_below(g, 5)) {
+            case 0:  value = 0;                                 break;
+            case 1:  value = -min;                              break;
+            case 2:  value = (uint64)((int)gen_below(g, 201) - 100); break;
+            case 3:  value = (bits == 64)? (uint64)((long)(gen_random64(g) >> 10) - (1l << 53)) : gen_random(g); break;
+            default: value = gen_random64(g);                   break;
+        }
+        memcpy(out, &value, bits / 8);
+    }
+    else if(format == X87_BCD) {
+        uint32 digits = 1 + gen_below(g, 18);
+        for(uint32 i=0; i<digits; i++) out[i/2] |= gen_below(g, 10) << ((i & 1) * 4);
+        out[9] = (gen_below(g, 2))? 0x80 : 0x00;
+    }
+}
+
+static stress_x87_format_t x87_format(uint32 esc, uint32 modrm) {
+    uint32 nnn = (modrm >> 3) & 7;
+
+    if(modrm >= 0xC0)                               return X87_NONE;
+    if(esc == 0 || (esc == 1 && nnn < 4))           return X87_M32;
+    if(esc == 4 || (esc == 5 && nnn < 4))           return X87_M64;
+    if(esc == 3 && (nnn == 5 || nnn == 7))          return X87_M80;
+    if(esc == 6 || (esc == 7 && nnn < 4))           return X87_I16;
+    if(esc == 2 || (esc == 3 && nnn < 4))           return X87_I32;
+    if(esc == 7 && (nnn == 5 || nnn == 7))          return X87_I64;
+    if(esc == 7 && (nnn == 4 || nnn == 6))          return X87_BCD;
+    return X87_NONE;
+}
+
+//register forms of the 487 instruction set, without the transcendentals and the DB group
+static bool x87_register_form(uint32 esc, uint32 modrm) {
+    uint32 nnn = (modrm >> 3) & 7;
+    uint32 rm  = modrm & 7;
+
+    if(esc == 1) {
+        if(nnn == 2) return rm == 0;                                //fnop
+        if(nnn == 3) return false;
+        if(nnn == 4) return rm != 2 && rm != 3 && rm != 6 && rm != 7;
+        if(nnn == 5) return rm != 7;
+        if(nnn == 6) return rm >= 4;                                //fxtract .. fincstp
+        return rm == 0 || rm == 2 || rm == 4 || rm == 5;            //fprem, fsqrt, frndint, fscale
+    }
+    if(esc == 2) return modrm == 0xE9;                              //fucompp
+    if(esc == 3) return false;
+    if(esc == 5) return nnn < 6;
+    if(esc == 6) return nnn != 3 || rm == 1;                        //fcompp
+    if(esc == 7) return nnn < 4 || modrm == 0xE0;                   //fnstsw ax
+    return true;
+}
+
+//memory forms: loads, stores, arithmetic; FNSTCW and FNSTSW m16
+static bool x87_memory_form(uint32 esc, uint32 nnn) {
+    if((esc == 1 || esc == 5) && (nnn == 4 || nnn == 6)) return false;    //the environment
+    if(esc == 1 && nnn == 5) return false;                              //fldcw
+    if(nnn == 1 && (esc == 1 || esc == 3 || esc == 5 || esc == 7)) return false;
+    if(esc == 3 && (nnn == 4 || nnn == 6)) return false;
+    if(esc == 5 && nnn == 5) return false;
+    return true;
+}
+
+static void gen_x87_state(stress_gen_t &g, uint8 *image) {
+    static const uint32 precisions[] = { 0, 2, 3, 3, 3 };
+    static const uint32 valid[]      = { 0, 1, 2, 3, 8, 8, 8 };
+
+    uint32 masks = (gen_below(g, 10) < 6)? 0x3F : gen_random(g) & 0x3F;
+    uint32 cw    = 0x40 | (gen_below(g, 4) << 10) | (precisions[gen_below(g, 5)] << 8) | masks;
+    uint32 top   = gen_below(g, 8);
+
+    uint8  regs[8][10];
+    bool   empty[8];
+    uint32 count = valid[gen_below(g, 7)];
+
+    for(uint32 i=0; i<8; i++) {
+        gen_x87_value(g, regs[i]);
+        empty[i] = gen_below(g, 100) < 15;
+    }
+    for(uint32 i=count; i<8; i++) empty[(top + i) & 7] = true;
+
+    //only masked exceptions are pending
+    uint32 flags = gen_random(g) & masks;
+    uint32 cc    = gen_below(g, 16);
+    uint32 sw    = flags | ((cc & 7) << 8) | ((cc >> 3) << 14) | (top << 11) | ((flags & 1)? gen_below(g, 2) << 6 : 0);
+
+    uint32 tw = 0;
+    for(uint32 r=0; r<8; r++) {
+        uint64 sig;
+        memcpy(&sig, regs[r], 8);
+        uint32 exp = (regs[r][8] | (regs[r][9] << 8)) & 0x7FFF;
+
+        uint32 tag = (empty[r])?                                    3 :
+                     (exp == 0 && sig == 0)?                        1 :
+                     (exp == 0x7FFF || exp == 0 || (sig >> 63) == 0)? 2 :
+                                                                    0;
+        tw |= tag << (2*r);
+    }
+
+    uint32 words[7] = { cw | 0xFFFF0000, sw | 0xFFFF0000, tw | 0xFFFF0000, 0, 0, 0, 0xFFFF0000 };
+    memcpy(image, words, sizeof(words));
+    for(uint32 i=0; i<8; i++) memcpy(&image[28 + 10*i], regs[(top + i) & 7], 10);
+}
+
+static void stress_generate_x87(stress_program_t &p, uint32 seed, uint32 length) {
+    memset(p.code, 0, sizeof(p.code));
+    p.length = 0;
+    p.instrs.clear();
+    p.index_at.assign(STRESS_CODE_MAX, -1);
+    p.x87.clear();
+
+    stress_gen_t g;
+    memset(&g, 0, sizeof(g));
+    g.program = &p;
+    g.rng     = seed * 2654435761u + 0x9E3779B9u;
+    if(g.rng == 0) g.rng = 1;
+
+    //prologue
+    gen_byte(g, 0xB8); gen_imm(g, STRESS_X87_SEGMENT, 16);
+    gen_end(g, 0, 0, "mov ax, 0x%x", STRESS_X87_SEGMENT);
+    gen_byte(g, 0x8E); gen_byte(g, 0xD8);
+    gen_end(g, 0, 0, "mov ds, ax");
+
+    if(length > STRESS_X87_BLOCKS) length = STRESS_X87_BLOCKS;
+
+    //every block stays below 32 bytes
+    while(p.x87.size() < length && p.length + 32 < STRESS_CODE_MAX) {
+        stress_x87_block_t block;
+
+        uint32 esc, modrm;
+        while(true) {
+            esc = gen_below(g, 8);
+            if(gen_below(g, 2)) {
+                modrm = 0xC0 | gen_below(g, 64);
+                if(x87_register_form(esc, modrm)) break;
+            }
+            else {
+                uint32 nnn = gen_below(g, 8);
+                modrm = (nnn << 3) | 6;
+                if(x87_memory_form(esc, nnn)) break;
+            }
+        }
+        block.instr[0] = 0xD8 | esc;
+        block.instr[1] = modrm;
+
+        gen_x87_state(g, block.image);
+        gen_x87_operand(g, x87_format(esc, modrm), block.operand);
+
+        uint32 base = p.x87.size() * STRESS_X87_BLOCK;
+
+        gen_byte(g, 0x66); gen_byte(g, 0xBB); gen_imm(g, base, 32);
+        gen_end(g, 0, 0, "mov ebx, 0x%x", base);
+        gen_byte(g, 0x66); gen_byte(g, 0xBE); gen_imm(g, base + STRESS_X87_OPERAND, 32);
+        gen_end(g, 0, 0, "mov esi, 0x%x", base + STRESS_X87_OPERAND);
+        gen_byte(g, 0x66); gen_byte(g, 0x67); gen_byte(g, 0xDD); gen_byte(g, 0x23);
+        gen_end(g, 0, 0, "frstor [ebx]");
+
+        block.index = p.instrs.size();
+        gen_byte(g, 0x67); gen_byte(g, block.instr[0]); gen_byte(g, block.instr[1]);
+        gen_end(g, 0, 0, "x87 %02x %02x, block %zu", block.instr[0], block.instr[1], p.x87.size());
+
+        gen_byte(g, 0xA3); gen_imm(g, base + STRESS_X87_AX, 16);
+        gen_end(g, 0, 0, "mov [0x%x], ax", base + STRESS_X87_AX);
+        gen_byte(g, 0x66); gen_byte(g, 0x67); gen_byte(g, 0xDD); gen_byte(g, 0x33);
+        gen_end(g, 0, 0, "fnsave [ebx]");
+
+        p.x87.push_back(block);
+    }
+
+    p.end = p.length;
+    p.code[p.length++] = 0xEB;
+    p.code[p.length++] = 0xFE;
+}
+
+static void stress_load(const stress_program_t &p, uint8 *memory) {
+    memset(memory, 0, STRESS_MEMORY_SIZE);
+
+    //fake boot rom: jmp 0000:0000 at the reset vector
+    const uint8 boot[] = { 0xEA, 0x00, 0x00, 0x00, 0x00 };
+    memcpy(&memory[0xFFFF0], boot, sizeof(boot));
+
+    memcpy(memory, p.code, p.length);
+
+    for(uint32 i=0; i<p.x87.size(); i++) {
+        uint8 *block = &memory[(STRESS_X87_SEGMENT << 4) + i*STRESS_X87_BLOCK];
+        memcpy(block, p.x87[i].image, sizeof(p.x87[i].image));
+        memcpy(&block[STRESS_X87_OPERAND], p.x87[i].operand, sizeof(p.x87[i].operand));
+    }
+}
+
+//------------------------------------------------------------------------------ runs
+
+struct stress_state_t {
+    uint32 eip;         //linear address of the instruction
+    uint32 regs[8];     //eax, ecx, edx, ebx, esp, ebp, esi, edi
+    uint32 eflags;
+};
+
+struct stress_run_t {
+    std::vector<stress_state_t> trace;
+    bool        finished;
+    const char *error;
+    uint64      cycles;
+};
+
+static uint32 ref_mem_read(void *ctx, uint32 address, uint32 byteenable) {
+    uint8 *memory = (uint8 *)ctx;
+    uint32 value;
+    memcpy(&value, &memory[address & (STRESS_MEMORY_SIZE - 4)], 4);
+    return value;
+}
+
+static void ref_mem_write(void *ctx, uint32 address, uint32 data, uint32 byteenable) {
+    uint8 *memory = (uint8 *)ctx;
+    for(uint32 i=0; i<4; i++) {
+        if((byteenable >> i) & 1) memory[(address & (STRESS_MEMORY_SIZE - 4)) + i] = (data >> (i*8)) & 0xFF;
+    }
+}
+
+static uint32 ref_io_read(void *, uint32, uint32) {
+    return 0xFFFFFFFF;
+}
+
+static void ref_io_write(void *, uint32, uint32, uint32) {
+}
+
+static void stress_run_ref(const stress_program_t &p, uint8 *memory, stress_run_t &run) {
+    static ref486_t cpu;
+    memset(&cpu, 0, sizeof(cpu));
+
+    cpu.bus.ctx       = memory;
+    cpu.bus.ram       = memory;
+    cpu.bus.ram_size  = STRESS_MEMORY_SIZE;
+    cpu.bus.mem_read  = ref_mem_read;
+    cpu.bus.mem_write = ref_mem_write;
+    cpu.bus.io_read   = ref_io_read;
+    cpu.bus.io_write  = ref_io_write;
+
+    ref486_reset(cpu);
+
+    for(uint32 step=0; step<p.instrs.size() + 16; step++) {
+        uint32 linear = ref486_linear_eip(cpu);
+
+        if(linear == p.end) {
+            run.finished = true;
+            return;
+        }
+
+        ref486_status_t status = ref486_step(cpu);
+        if(status == REF486_UNSUPPORTED) { run.error = cpu.unsupported; return; }
+        if(status != REF486_OK)          { run.error = "halt or shutdown"; return; }
+        if(cpu.exception_counter != 0)   { run.error = "exception"; return; }
+
+        if(linear < p.end) {
+            stress_state_t state;
+            state.eip    = linear;
+            state.eflags = cpu.eflags;
+            memcpy(state.regs, cpu.regs, sizeof(state.regs));
+            run.trace.push_back(state);
+        }
+    }
+    run.error = "did not reach the end";
+}
+
+//the registers are public through handoff.vlt, see handoff.h
+static void stress_sample(Vmain *top, uint32 eip, stress_state_t &state) {
+    state.eip = eip;
+
+    state.regs[0] = HANDOFF_SIGNAL(HANDOFF_WR, eax);
+    state.regs[1] = HANDOFF_SIGNAL(HANDOFF_WR, ecx);
+    state.regs[2] = HANDOFF_SIGNAL(HANDOFF_WR, edx);
+    state.regs[3] = HANDOFF_SIGNAL(HANDOFF_WR, ebx);
+    state.regs[4] = HANDOFF_SIGNAL(HANDOFF_WR, esp);
+    state.regs[5] = HANDOFF_SIGNAL(HANDOFF_WR, ebp);
+    state.regs[6] = HANDOFF_SIGNAL(HANDOFF_WR, esi);
+    state.regs[7] = HANDOFF_SIGNAL(HANDOFF_WR, edi);
+
+    state.eflags =
+        (HANDOFF_SIGNAL(HANDOFF_WR, cflag)  << 0)  | 0x2 |
+        (HANDOFF_SIGNAL(HANDOFF_WR, pflag)  << 2)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, aflag)  << 4)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, zflag)  << 6)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, sflag)  << 7)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, tflag)  << 8)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, iflag)  << 9)  |
+        (HANDOFF_SIGNAL(HANDOFF_WR, dflag)  << 10) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, oflag)  << 11) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, iopl)   << 12) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, ntflag) << 14) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, rflag)  << 16) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, vmflag) << 17) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, acflag) << 18) |
+        (HANDOFF_SIGNAL(HANDOFF_WR, idflag) << 21);
+}
+
+/* The registers are written on the clock edge that ends the cycle with
+ * tb_finish_instr, so they are sampled right after it.
+ */
+static void stress_run_rtl(const stress_program_t &p, uint8 *memory, stress_run_t &run) {
+    Vmain *top = new Vmain();
+
+    //reset
+    top->clk = 0; top->rst_n = 1; top->eval();
+    top->clk = 1; top->rst_n = 1; top->eval();
+    top->clk = 1; top->rst_n = 0; top->eval();
+    top->clk = 0; top->rst_n = 0; top->eval();
+    top->clk = 0; top->rst_n = 1; top->eval();
+
+    uint32 sdram_read_count = 0;
+    uint32 sdram_read_data[4];
+
+    uint32 sdram_write_count = 0;
+    uint32 sdram_write_address = 0;
+
+    uint32 vga_read_count = 0;
+    uint32 io_read_count = 0;
+
+    top->interrupt_do     = 0;
+    top->interrupt_vector = 0;
+
+    uint64 max_cycles = 2000 + 200 * (uint64)p.instrs.size();
+    uint32 mask       = STRESS_MEMORY_SIZE - 4;
+
+    run.error = "timeout";
+
+    for(uint64 clock=0; clock<max_cycles; clock++) {
+
+        bool   retired = false;
+        uint32 linear  = 0;
+
+        if(top->tb_finish_instr) {
+            linear = top->prof_cs_base + top->prof_eip;
+
+            if(linear == p.end) {
+                run.finished = true;
+                run.error    = NULL;
+                run.cycles   = clock;
+                break;
+            }
+            retired = linear < p.end;
+        }
+
+        //---------------------------------------------------------------------- sdram
+
+        top->sdram_readdatavalid = 0;
+
+        if(top->sdram_read) {
+            uint32 address = top->sdram_address & mask;
+
+            for(uint32 i=0; i<4; i++) {
+                memcpy(&sdram_read_data[i], &memory[(address + i*4) & mask], 4);
+
+                if(((top->sdram_byteenable >> 0) & 1) == 0) sdram_read_data[i] &= 0xFFFFFF00;
+                if(((top->sdram_byteenable >> 1) & 1) == 0) sdram_read_data[i] &= 0xFFFF00FF;
+                if(((top->sdram_byteenable >> 2) & 1) == 0) sdram_read_data[i] &= 0xFF00FFFF;
+                if(((top->sdram_byteenable >> 3) & 1) == 0) sdram_read_data[i] &= 0x00FFFFFF;
+            }
+            sdram_read_count = top->sdram_burstcount;
+        }
+        else if(sdram_read_count > 0) {
+            top->sdram_readdatavalid = 1;
+            top->sdram_readdata = sdram_read_data[0];
+            memmove(sdram_read_data, &sdram_read_data[1], sizeof(sdram_read_data)-sizeof(uint32));
+            sdram_read_count--;
+        }
+
+        if(top->sdram_write) {
+            uint32 address = (sdram_write_count > 0)? sdram_write_address : top->sdram_address & mask;
+
+            for(uint32 i=0; i<4; i++) {
+                if((top->sdram_byteenable >> i) & 1) memory[address + i] = (top->sdram_writedata >> (i*8)) & 0xFF;
+            }
+
+            if(sdram_write_count == 0) {
+                sdram_write_address = (address + 4) & mask;
+                sdram_write_count = top->sdram_burstcount;
+            }
+
+            if(sdram_write_count > 0) sdram_write_count--;
+        }
+
+        //---------------------------------------------------------------------- vga, io: no devices, reads float high
+
+        top->vga_readdatavalid = 0;
+
+        if(top->vga_read) {
+            vga_read_count = top->vga_burstcount;
+        }
+        else if(vga_read_count > 0) {
+            top->vga_readdatavalid = 1;
+            top->vga_readdata = 0xFFFFFFFF;
+            vga_read_count--;
+        }
+
+        top->avalon_io_readdatavalid = 0;
+
+        if(top->avalon_io_read) {
+            io_read_count = 1;
+        }
+        else if(io_read_count > 0) {
+            top->avalon_io_readdatavalid = 1;
+            top->avalon_io_readdata = 0xFFFFFFFF;
+            io_read_count--;
+        }
+
+        //----------------------------------------------------------------------
+
+        top->clk = 0;
+        top->eval();
+
+        top->clk = 1;
+        top->eval();
+
+        if(retired) {
+            stress_state_t state;
+            stress_sample(top, linear, state);
+            run.trace.push_back(state);
+        }
+    }
+
+    top->final();
+    delete top;
+}
+
+//------------------------------------------------------------------------------ check
+
+static void stress_listing(FILE *fp, const stress_program_t &p) {
+    fprintf(fp, "\nlisting:\n");
+    for(const stress_instr_t &in : p.instrs) {
+        char bytes[48] = "";
+        for(uint32 i=0; i<in.length && i<15; i++) snprintf(bytes + strlen(bytes), sizeof(bytes) - strlen(bytes), "%02x", p.code[in.offset + i]);
+        fprintf(fp, "%04x: %-30s %s\n", in.offset, bytes, in.text);
+    }
+}
+
+static void stress_print_state(FILE *fp, const char *name, const stress_state_t &state) {
+    static const char *names[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+
+    fprintf(fp, "%-4s eip: %04x eflags: %08x", name, state.eip, state.eflags);
+    for(uint32 i=0; i<8; i++) fprintf(fp, " %s: %08x", names[i], state.regs[i]);
+    fprintf(fp, "\n");
+}
+
+//first difference into 'report', empty when the runs agree
+static bool stress_compare(const stress_program_t &p, const stress_run_t &ref, const stress_run_t &rtl, const uint8 *ref_memory, const uint8 *rtl_memory, FILE *report) {
+    if(ref.error != NULL) {
+        fprintf(report, "reference: %s after %zu instructions\n", ref.error, ref.trace.size());
+        return false;
+    }
+    if(rtl.error != NULL) {
+        fprintf(report, "ao486: %s after %zu instructions\n", rtl.error, rtl.trace.size());
+        return false;
+    }
+
+    size_t count = (ref.trace.size() < rtl.trace.size())? ref.trace.size() : rtl.trace.size();
+
+    for(size_t i=0; i<count; i++) {
+        const stress_state_t &a = ref.trace[i];
+        const stress_state_t &b = rtl.trace[i];
+
+        int    index = (a.eip < STRESS_CODE_MAX)? p.index_at[a.eip] : -1;
+        uint32 mask  = ((index >= 0)? p.instrs[index].defined : STRESS_ARITH) | STRESS_DF;
+
+        bool same = a.eip == b.eip && memcmp(a.regs, b.regs, sizeof(a.regs)) == 0 && ((a.eflags ^ b.eflags) & mask) == 0;
+        if(same) continue;
+
+        fprintf(report, "difference at instruction %zu: %s\n", i, (index >= 0)? p.instrs[index].text : "?");
+        fprintf(report, "compared eflags bits: %03x\n", mask);
+        stress_print_state(report, "ref", a);
+        stress_print_state(report, "rtl", b);
+        if(i > 0) {
+            fprintf(report, "before:\n");
+            stress_print_state(report, "ref", ref.trace[i-1]);
+            stress_print_state(report, "rtl", rtl.trace[i-1]);
+        }
+        return false;
+    }
+
+    if(ref.trace.size() != rtl.trace.size()) {
+        fprintf(report, "retired instructions: reference %zu, ao486 %zu\n", ref.trace.size(), rtl.trace.size());
+        return false;
+    }
+
+    for(uint32 address=STRESS_WINDOW_START; address<STRESS_WINDOW_END; address++) {
+        if(ref_memory[address] == rtl_memory[address]) continue;
+
+        fprintf(report, "memory difference at %05x: reference %02x, ao486 %02x\n", address, ref_memory[address], rtl_memory[address]);
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------ x87 reference
+
+#if defined(__x86_64__)
+
+/* frstor [rdi]; <instruction>; mov [rdx], ax; fnsave [rdi]; fninit; ret
+ * called as code(image, operand, &ax)
+ */
+static bool x87_host(uint8 *image, const uint8 *instr, uint8 *operand, uint16 &ax) {
+    static uint8 *page = NULL;
+
+    if(page == NULL) {
+        void *map = mmap(NULL, 4096, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(map == MAP_FAILED) return false;
+        page = (uint8 *)map;
+    }
+
+    const uint8 code[] = {
+        0xDD, 0x27,
+        instr[0], instr[1],
+        0x66, 0x89, 0x02,
+        0xDD, 0x37,
+        0xDB, 0xE3,
+        0xC3
+    };
+    memcpy(page, code, sizeof(code));
+    __builtin___clear_cache((char *)page, (char *)page + sizeof(code));
+
+    ax = 0;
+    ((void (*)(uint8 *, uint8 *, uint16 *))page)(image, operand, &ax);
+    return true;
+}
+
+#else
+
+static bool x87_host(uint8 *, const uint8 *, uint8 *, uint16 &) {
+    return false;
+}
+
+#endif
+
+static void stress_run_x87(const stress_program_t &p, uint8 *memory, stress_run_t &run) {
+    for(uint32 i=0; i<p.x87.size(); i++) {
+        uint8 *block = &memory[(STRESS_X87_SEGMENT << 4) + i*STRESS_X87_BLOCK];
+
+        uint8  operand[32] = {};
+        uint16 ax;
+        memcpy(operand, &block[STRESS_X87_OPERAND], 16);
+
+        if(x87_host(block, p.x87[i].instr, operand, ax) == false) {
+            run.error = "no host x87";
+            return;
+        }
+        memcpy(&block[STRESS_X87_OPERAND], operand, 16);
+        memcpy(&block[STRESS_X87_AX], &ax, 2);
+    }
+    run.finished = true;
+}
+
+static void stress_print_x87(FILE *fp, const char *name, const uint8 *image) {
+    uint16 words[3];
+    for(uint32 i=0; i<3; i++) memcpy(&words[i], &image[4*i], 2);
+
+    fprintf(fp, "%-4s cw: %04x sw: %04x tw: %04x\n", name, words[0], words[1], words[2]);
+    for(uint32 i=0; i<8; i++) {
+        fprintf(fp, "     st%u: ", i);
+        for(int j=9; j>=0; j--) fprintf(fp, "%02x", image[28 + 10*i + j]);
+        fprintf(fp, "\n");
+    }
+}
+
+//the FNSAVE images without the instruction and data pointers, the operands, AX after FNSTSW AX
+static bool stress_compare_x87(const stress_program_t &p, const stress_run_t &ref, const stress_run_t &rtl, const uint8 *ref_memory, const uint8 *rtl_memory, FILE *report) {
+    if(ref.error != NULL) {
+        fprintf(report, "reference: %s\n", ref.error);
+        return false;
+    }
+    if(rtl.error != NULL) {
+        fprintf(report, "ao486: %s after %zu instructions\n", rtl.error, rtl.trace.size());
+        return false;
+    }
+
+    for(uint32 i=0; i<p.x87.size(); i++) {
+        const stress_x87_block_t &block = p.x87[i];
+
+        const uint8 *a = &ref_memory[(STRESS_X87_SEGMENT << 4) + i*STRESS_X87_BLOCK];
+        const uint8 *b = &rtl_memory[(STRESS_X87_SEGMENT << 4) + i*STRESS_X87_BLOCK];
+
+        bool fnstsw_ax = block.instr[0] == 0xDF && block.instr[1] == 0xE0;
+
+        bool same =
+            memcmp(&a[0], &b[0], 2) == 0 && memcmp(&a[4], &b[4], 2) == 0 && memcmp(&a[8], &b[8], 2) == 0 &&
+            memcmp(&a[28], &b[28], 80) == 0 &&
+            memcmp(&a[STRESS_X87_OPERAND], &b[STRESS_X87_OPERAND], 16) == 0 &&
+            (fnstsw_ax == false || memcmp(&a[STRESS_X87_AX], &b[STRESS_X87_AX], 2) == 0);
+        if(same) continue;
+
+        fprintf(report, "difference at block %u: %s\n", i, p.instrs[block.index].text);
+        stress_print_x87(report, "in", block.image);
+        stress_print_x87(report, "ref", a);
+        stress_print_x87(report, "rtl", b);
+
+        fprintf(report, "operand in:  ");
+        for(uint32 j=0; j<16; j++) fprintf(report, "%02x", block.operand[j]);
+        fprintf(report, "\noperand ref: ");
+        for(uint32 j=0; j<16; j++) fprintf(report, "%02x", a[STRESS_X87_OPERAND + j]);
+        fprintf(report, "\noperand rtl: ");
+        for(uint32 j=0; j<16; j++) fprintf(report, "%02x", b[STRESS_X87_OPERAND + j]);
+        fprintf(report, "\n");
+
+        if(fnstsw_ax) fprintf(report, "ax ref: %02x%02x rtl: %02x%02x\n", a[STRESS_X87_AX + 1], a[STRESS_X87_AX], b[STRESS_X87_AX + 1], b[STRESS_X87_AX]);
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------ workers
+
+static uint8 ref_memory[STRESS_MEMORY_SIZE];
+static uint8 rtl_memory[STRESS_MEMORY_SIZE];
+
+static bool stress_seed(uint32 seed, uint32 length, bool x87, const char *out_dir) {
+    static stress_program_t program;
+    if(x87) stress_generate_x87(program, seed, length);
+    else    stress_generate(program, seed, length);
+
+    stress_run_t ref = {};
+    stress_run_t rtl = {};
+
+    stress_load(program, ref_memory);
+    if(x87) stress_run_x87(program, ref_memory, ref);
+    else    stress_run_ref(program, ref_memory, ref);
+
+    stress_load(program, rtl_memory);
+    stress_run_rtl(program, rtl_memory, rtl);
+
+    char  *text = NULL;
+    size_t size = 0;
+    FILE  *report = open_memstream(&text, &size);
+
+    bool ok = (x87)?
+        stress_compare_x87(program, ref, rtl, ref_memory, rtl_memory, report) :
+        stress_compare(program, ref, rtl, ref_memory, rtl_memory, report);
+    fclose(report);
+
+    if(ok) {
+        printf("seed %u: ok, %zu instructions in %lu cycles\n", seed, rtl.trace.size(), rtl.cycles);
+    }
+    else {
+        char name[512];
+        snprintf(name, sizeof(name), "%s/seed_%u.txt", out_dir, seed);
+
+        FILE *fp = fopen(name, "wb");
+        if(fp != NULL) {
+            fprintf(fp, "seed %u\n%s", seed, text);
+            stress_listing(fp, program);
+            fclose(fp);
+        }
+        printf("seed %u: FAILED, %s", seed, text);
+    }
+    fflush(stdout);
+    free(text);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32      first   = 1;
+    uint32      seeds   = 1;
+    uint32      length  = 1000;
+    uint32      jobs    = 1;
+    bool        x87     = false;
+    const char *out_dir = "stress";
+
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--seed") == 0 && i+1 < argc)        first   = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--seeds") == 0 && i+1 < argc)  seeds   = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--length") == 0 && i+1 < argc) length  = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--jobs") == 0 && i+1 < argc)   jobs    = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--out") == 0 && i+1 < argc)    out_dir = argv[++i];
+        else if(strcmp(argv[i], "--x87") == 0)                  x87     = true;
+    }
+
+    uint32 cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if(jobs == 0)     jobs = cpus;
+    if(jobs > seeds)  jobs = seeds;
+    if(jobs == 0)     jobs = 1;
+
+    mkdir(out_dir, 0755);
+    Verilated::commandArgs(argc, argv);
+
+    //worker j takes seeds first+j, first+j+jobs, ...; its exit code is its failure count
+    std::vector<pid_t> workers;
+    for(uint32 j=0; j<jobs; j++) {
+        pid_t pid = fork();
+        if(pid < 0) {
+            perror("fork() failed");
+            break;
+        }
+        if(pid == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(j % cpus, &set);
+            sched_setaffinity(0, sizeof(set), &set);
+
+            uint32 failed = 0;
+            for(uint32 seed=first+j; seed<first+seeds; seed+=jobs) {
+                if(stress_seed(seed, length, x87, out_dir) == false) failed++;
+            }
+            _exit((failed > 255)? 255 : failed);
+        }
+        workers.push_back(pid);
+    }
+
+    uint32 failed = 0;
+    for(pid_t pid : workers) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+
+        if(WIFEXITED(status)) failed += WEXITSTATUS(status);
+        else                  failed++;
+    }
+
+    printf("seeds: %u, failed: %u%s\n", seeds, failed, (failed)? ", see the seed_<n>.txt files" : "");
+    return (failed)? 1 : 0;
+}
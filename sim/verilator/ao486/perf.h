@@ -0,0 +1,136 @@
+
+#ifndef __PERF_H
+#define __PERF_H
+
+#include <cstdio>
+#include <cstring>
+
+#include "shared_mem.h"
+
+/* Pipeline occupancy counters. main.v drives one PERF_* state per stage
+ * (perf_fetch .. perf_write), sampled once per clock; each clock adds one to
+ * the counter of that state, both for the whole run and for the current
+ * window of 'window_instr' retired instructions.
+ *
+ * <name>      : run totals, written at exit
+ * <name>.csv  : one line per window, when window_instr != 0
+ */
+
+enum perf_state_t {
+    PERF_EMPTY   = 0,
+    PERF_BUSY    = 1,
+    PERF_MUTEX   = 2,
+    PERF_MEMORY  = 3,
+    PERF_BLOCKED = 4,
+    PERF_STATES  = 5
+};
+
+enum perf_stage_t {
+    PERF_FETCH   = 0,
+    PERF_DECODE  = 1,
+    PERF_MICRO   = 2,
+    PERF_READ    = 3,
+    PERF_EXECUTE = 4,
+    PERF_WRITE   = 5,
+    PERF_STAGES  = 6
+};
+
+static const char *perf_state_names[PERF_STATES] = { "empty", "busy", "mutex", "memory", "blocked" };
+static const char *perf_stage_names[PERF_STAGES] = { "fetch", "decode", "micro", "read", "execute", "write" };
+
+struct perf_t {
+    uint64 total[PERF_STAGES][PERF_STATES];
+    uint64 window[PERF_STAGES][PERF_STATES];
+
+    uint64 total_clocks;
+    uint64 window_clocks;
+
+    uint32 first_instr;
+    uint32 window_instr;
+    uint32 window_start;
+
+    FILE  *window_fp;
+};
+
+static inline void perf_init(perf_t &perf) {
+    memset(&perf, 0, sizeof(perf));
+}
+
+//instr_counter: where counting starts, after a restore
+static inline bool perf_open(perf_t &perf, const char *name, uint32 instr_counter) {
+    perf.first_instr  = instr_counter;
+    perf.window_start = instr_counter;
+
+    if(perf.window_instr == 0) return true;
+
+    char window_name[256];
+    snprintf(window_name, sizeof(window_name), "%s.csv", name);
+
+    perf.window_fp = fopen(window_name, "wb");
+    if(perf.window_fp == NULL) return false;
+
+    fprintf(perf.window_fp, "instr_start,instr_end,clocks");
+    for(int stage=0; stage<PERF_STAGES; stage++) {
+        for(int state=0; state<PERF_STATES; state++) fprintf(perf.window_fp, ",%s_%s", perf_stage_names[stage], perf_state_names[state]);
+    }
+    fprintf(perf.window_fp, "\n");
+    return true;
+}
+
+static inline void perf_clock(perf_t &perf, const uint8 states[PERF_STAGES]) {
+    for(int stage=0; stage<PERF_STAGES; stage++) {
+        uint8 state = (states[stage] < PERF_STATES)? states[stage] : PERF_EMPTY;
+        perf.total[stage][state]++;
+        perf.window[stage][state]++;
+    }
+    perf.total_clocks++;
+    perf.window_clocks++;
+}
+
+static inline void perf_window_flush(perf_t &perf, uint32 instr_counter) {
+    if(perf.window_fp == NULL || perf.window_clocks == 0) return;
+
+    fprintf(perf.window_fp, "%u,%u,%lu", perf.window_start, instr_counter, perf.window_clocks);
+    for(int stage=0; stage<PERF_STAGES; stage++) {
+        for(int state=0; state<PERF_STATES; state++) fprintf(perf.window_fp, ",%lu", perf.window[stage][state]);
+    }
+    fprintf(perf.window_fp, "\n");
+
+    memset(perf.window, 0, sizeof(perf.window));
+    perf.window_clocks = 0;
+    perf.window_start  = instr_counter;
+}
+
+//called on each retired instruction
+static inline void perf_retire(perf_t &perf, uint32 instr_counter) {
+    if(perf.window_instr != 0 && instr_counter - perf.window_start >= perf.window_instr) perf_window_flush(perf, instr_counter);
+}
+
+static inline bool perf_write(perf_t &perf, const char *name, uint32 instr_counter) {
+    perf_window_flush(perf, instr_counter);
+    if(perf.window_fp != NULL) fclose(perf.window_fp);
+    perf.window_fp = NULL;
+
+    FILE *fp = fopen(name, "wb");
+    if(fp == NULL) return false;
+
+    uint32 instructions = instr_counter - perf.first_instr;
+    double clocks       = (perf.total_clocks > 0)? perf.total_clocks : 1;
+
+    fprintf(fp, "instructions: %u, clocks: %lu, CPI: %.3f\n\n", instructions, perf.total_clocks, perf.total_clocks / (double)((instructions > 0)? instructions : 1));
+
+    fprintf(fp, "%-8s", "stage");
+    for(int state=0; state<PERF_STATES; state++) fprintf(fp, " %14s %7s", perf_state_names[state], "%");
+    fprintf(fp, "\n");
+
+    for(int stage=0; stage<PERF_STAGES; stage++) {
+        fprintf(fp, "%-8s", perf_stage_names[stage]);
+        for(int state=0; state<PERF_STATES; state++) fprintf(fp, " %14lu %6.2f%%", perf.total[stage][state], 100.0 * perf.total[stage][state] / clocks);
+        fprintf(fp, "\n");
+    }
+
+    fclose(fp);
+    return true;
+}
+
+#endif //__PERF_H
@@ -0,0 +1,172 @@
+
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shared_mem.h"
+
+/* Hot-spot profile keyed on the linear address (CS base + EIP) of each retired
+ * instruction. The clocks since the previous retirement are charged to the
+ * retiring instruction, which is exact for this in-order pipeline.
+ *
+ * The report has two flat tables sorted by clocks: one per address range
+ * (per symbol when symbol files are given, else per 2^range_shift bytes) and
+ * one per instruction address.
+ */
+
+struct profile_entry_t {
+    uint64 count;
+    uint64 clocks;
+};
+
+struct profile_symbol_t {
+    uint32      address;
+    std::string name;
+};
+
+struct profile_t {
+    std::unordered_map<uint32, profile_entry_t> eips;
+    std::vector<profile_symbol_t>               symbols;
+
+    uint64 last_clock;
+    uint64 total_count;
+    uint64 total_clocks;
+    uint32 range_shift;
+};
+
+static inline void profile_init(profile_t &profile) {
+    profile.eips.clear();
+    profile.symbols.clear();
+    profile.last_clock   = 0;
+    profile.total_count  = 0;
+    profile.total_clocks = 0;
+    profile.range_shift  = 8;
+}
+
+static inline void profile_retire(profile_t &profile, uint32 linear, uint64 clock) {
+    profile_entry_t &entry = profile.eips[linear];
+    uint64 clocks = clock - profile.last_clock;
+
+    entry.count++;
+    entry.clocks += clocks;
+
+    profile.total_count++;
+    profile.total_clocks += clocks;
+    profile.last_clock = clock;
+}
+
+/* Symbol files of the bios build (as86 -s, or any "... <hex address> ... <name>"
+ * per line); 'base' is the linear address of offset 0, 0xF0000 for the bios.
+ */
+static inline bool profile_load_symbols(profile_t &profile, const char *name, uint32 base) {
+    FILE *fp = fopen(name, "rb");
+    if(fp == NULL) return false;
+
+    char line[512];
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        bool   have_address = false;
+        uint32 address      = 0;
+        char  *symbol       = NULL;
+
+        for(char *token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")) {
+            size_t length = strlen(token);
+
+            char *end;
+            unsigned long value = strtoul(token, &end, 16);
+            if(have_address == false && *end == 0 && length >= 4 && length <= 8) {
+                address      = value;
+                have_address = true;
+            }
+            else if(isalpha((unsigned char)token[0]) || token[0] == '_' || token[0] == '.') {
+                symbol = token;
+            }
+        }
+        if(have_address && symbol != NULL) {
+            profile_symbol_t entry = { base + address, symbol };
+            profile.symbols.push_back(entry);
+        }
+    }
+    fclose(fp);
+
+    std::sort(profile.symbols.begin(), profile.symbols.end(), [](const profile_symbol_t &a, const profile_symbol_t &b) { return a.address < b.address; });
+    return true;
+}
+
+//index of the symbol covering 'linear', or -1
+static inline int profile_symbol(const profile_t &profile, uint32 linear) {
+    auto it = std::upper_bound(profile.symbols.begin(), profile.symbols.end(), linear, [](uint32 value, const profile_symbol_t &symbol) { return value < symbol.address; });
+    if(it == profile.symbols.begin()) return -1;
+    return (it - profile.symbols.begin()) - 1;
+}
+
+static inline void profile_symbol_name(const profile_t &profile, uint32 linear, char *buffer, size_t size) {
+    int index = profile_symbol(profile, linear);
+    if(index < 0) {
+        snprintf(buffer, size, "-");
+        return;
+    }
+    snprintf(buffer, size, "%s+0x%x", profile.symbols[index].name.c_str(), linear - profile.symbols[index].address);
+}
+
+static inline bool profile_write(const profile_t &profile, const char *name) {
+    FILE *fp = fopen(name, "wb");
+    if(fp == NULL) return false;
+
+    typedef std::pair<uint32, profile_entry_t> row_t;
+    auto by_clocks = [](const row_t &a, const row_t &b) { return a.second.clocks > b.second.clocks; };
+
+    //ranges: per symbol, or per 2^range_shift bytes without symbols
+    std::unordered_map<uint32, profile_entry_t> ranges;
+    for(auto &eip : profile.eips) {
+        uint32 key = eip.first >> profile.range_shift << profile.range_shift;
+        if(profile.symbols.empty() == false) {
+            int index = profile_symbol(profile, eip.first);
+            key = (index < 0)? 0xFFFFFFFF : profile.symbols[index].address;
+        }
+        ranges[key].count  += eip.second.count;
+        ranges[key].clocks += eip.second.clocks;
+    }
+
+    std::vector<row_t> rows(ranges.begin(), ranges.end());
+    std::sort(rows.begin(), rows.end(), by_clocks);
+
+    double total = (profile.total_clocks > 0)? profile.total_clocks : 1;
+
+    fprintf(fp, "instructions: %lu, clocks: %lu, CPI: %.3f\n\n", profile.total_count, profile.total_clocks, profile.total_clocks / (double)((profile.total_count > 0)? profile.total_count : 1));
+
+    fprintf(fp, "%7s %14s %12s %7s  %-8s  %s\n", "%clk", "clocks", "instr", "CPI", "range", "symbol");
+    for(auto &row : rows) {
+        const char *symbol = "-";
+        if(row.first == 0xFFFFFFFF)              symbol = "(no symbol)";
+        else if(profile.symbols.empty() == false) symbol = profile.symbols[profile_symbol(profile, row.first)].name.c_str();
+
+        fprintf(fp, "%6.2f%% %14lu %12lu %7.2f  %08x  %s\n", 100.0 * row.second.clocks / total, row.second.clocks, row.second.count,
+            row.second.clocks / (double)row.second.count, row.first, symbol);
+    }
+
+    rows.assign(profile.eips.begin(), profile.eips.end());
+    std::sort(rows.begin(), rows.end(), by_clocks);
+
+    fprintf(fp, "\n%7s %14s %12s %7s  %-8s  %s\n", "%clk", "clocks", "instr", "CPI", "linear", "symbol");
+    for(auto &row : rows) {
+        char symbol[256] = "-";
+        if(profile.symbols.empty() == false) profile_symbol_name(profile, row.first, symbol, sizeof(symbol));
+
+        fprintf(fp, "%6.2f%% %14lu %12lu %7.2f  %08x  %s\n", 100.0 * row.second.clocks / total, row.second.clocks, row.second.count,
+            row.second.clocks / (double)row.second.count, row.first, symbol);
+    }
+
+    fclose(fp);
+    return true;
+}
+
+#endif //__PROFILE_H
@@ -0,0 +1,126 @@
+
+#ifndef __SNAPSHOT_H
+#define __SNAPSHOT_H
+
+#include <cstring>
+
+#include "verilated_save.h"
+
+#include "shared_mem.h"
+
+/* One snapshot file holds, in order:
+ *   - snapshot_header_t
+ *   - harness_state_t: the burst/handshake state kept by main.cpp between cycles
+ *   - the ao486 processor_t counters and the interrupt injection fields
+ *   - guest ram, shared_mem_t::mem_size bytes of memory_t
+ *   - the Verilated model (needs verilator --savable)
+ *
+ * Snapshots are taken between two cycles with the posted write ring drained,
+ * so memory_t is consistent with the model.
+ */
+
+#define SNAPSHOT_MAGIC   "AO486SNP"
+#define SNAPSHOT_VERSION 2
+
+struct snapshot_header_t {
+    char   magic[8];
+    uint32 version;
+    uint32 instr_counter;
+    uint64 cycle;
+    uint32 mem_size;
+};
+
+struct harness_state_t {
+    uint64 cycle;
+
+    uint32 sdram_read_count;
+    uint32 sdram_read_data[4];
+
+    uint32 sdram_write_count;
+    uint32 sdram_write_address;
+
+    uint32 vga_read_count;
+    uint32 vga_read_address;
+    uint32 vga_read_byteenable;
+
+    uint32 vga_write_count;
+    uint32 vga_write_address;
+
+    uint32 io_read_count;
+    uint32 io_read_address;
+    uint32 io_read_byteenable;
+
+    uint32 ignored_intr_counter;
+
+    uint32 sequence;
+};
+
+template<class T>
+bool snapshot_save(const char *name, T *top, const harness_state_t &state, volatile shared_mem_t *shared_ptr) {
+    VerilatedSave os;
+    os.open(name);
+    if(os.isOpen() == false) return false;
+
+    snapshot_header_t header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version       = SNAPSHOT_VERSION;
+    header.instr_counter = shared_ptr->ao486.instr_counter;
+    header.cycle         = state.cycle;
+    header.mem_size      = shared_ptr->mem_size;
+
+    os.write(&header, sizeof(header));
+    os.write(&state,  sizeof(state));
+
+    processor_t  ao486                = const_cast<processor_t &>(shared_ptr->ao486);
+    uint32       interrupt_vector     = shared_ptr->interrupt_vector;
+    uint32       interrupt_at_counter = shared_ptr->interrupt_at_counter;
+
+    os.write(&ao486,                sizeof(ao486));
+    os.write(&interrupt_vector,     sizeof(interrupt_vector));
+    os.write(&interrupt_at_counter, sizeof(interrupt_at_counter));
+
+    os.write(const_cast<memory_t *>(&shared_ptr->mem), header.mem_size);
+
+    os << *top;
+    os.close();
+    return true;
+}
+
+template<class T>
+bool snapshot_restore(const char *name, T *top, harness_state_t &state, volatile shared_mem_t *shared_ptr) {
+    VerilatedRestore os;
+    os.open(name);
+    if(os.isOpen() == false) return false;
+
+    snapshot_header_t header;
+    os.read(&header, sizeof(header));
+
+    //a snapshot only restores into a hub started with the same --mem-mb
+    if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION || header.mem_size != shared_ptr->mem_size) {
+        os.close();
+        return false;
+    }
+
+    os.read(&state, sizeof(state));
+
+    processor_t ao486;
+    uint32      interrupt_vector;
+    uint32      interrupt_at_counter;
+
+    os.read(&ao486,                sizeof(ao486));
+    os.read(&interrupt_vector,     sizeof(interrupt_vector));
+    os.read(&interrupt_at_counter, sizeof(interrupt_at_counter));
+
+    //only the counters: the mailbox steps belong to the live hub
+    shared_ptr->ao486.instr_counter = ao486.instr_counter;
+    shared_ptr->interrupt_vector     = interrupt_vector;
+    shared_ptr->interrupt_at_counter = interrupt_at_counter;
+
+    os.read(const_cast<memory_t *>(&shared_ptr->mem), header.mem_size);
+
+    os >> *top;
+    os.close();
+    return true;
+}
+
+#endif //__SNAPSHOT_H
@@ -0,0 +1,233 @@
+
+#ifndef __TRACK_H
+#define __TRACK_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Binary bus trace, replacing the text track.txt.
+ *
+ * <name>     : track_header_t, then fixed-size track_record_t entries.
+ * <name>.idx : track_index_t entries, one each time instr_counter crosses a
+ *              multiple of TRACK_INDEX_INTERVAL, giving the first record at
+ *              or after that instruction.
+ *
+ * Records carry the instr_counter as a delta to the previous record. A delta
+ * that does not fit is preceded by a TRACK_SYNC record holding the absolute
+ * counter in 'data'. IAC and Exception records also hold the absolute counter
+ * in 'data', as the text lines did.
+ */
+
+#define TRACK_MAGIC          "AO486TRK"
+#define TRACK_VERSION        1
+#define TRACK_INDEX_INTERVAL 65536
+#define TRACK_BUFFER_SIZE    (1 << 20)
+
+enum track_op_t {
+    TRACK_MEM_RD    = 0,
+    TRACK_MEM_WR    = 1,
+    TRACK_IO_RD     = 2,
+    TRACK_IO_WR     = 3,
+    TRACK_IAC       = 4, //address: vector, byteenable: TRACK_IAC_*
+    TRACK_EXCEPTION = 5, //address: vector
+    TRACK_SYNC      = 6
+};
+
+enum track_iac_t {
+    TRACK_IAC_NORMAL    = 0,
+    TRACK_IAC_SPUR_IDLE = 1,
+    TRACK_IAC_SPUR_ACK  = 2
+};
+
+struct track_header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+struct track_record_t {
+    uint8_t  op;
+    uint8_t  byteenable;
+    uint16_t instr_delta;
+    uint32_t address;
+    uint32_t data;
+};
+
+struct track_index_t {
+    uint32_t instr_counter;
+    uint32_t base_instr;    //counter the delta of 'record' applies to
+    uint64_t record;
+};
+
+//------------------------------------------------------------------------------ writer
+
+struct track_writer_t {
+    FILE          *fp;
+    FILE          *index_fp;
+    track_record_t buffer[TRACK_BUFFER_SIZE / sizeof(track_record_t)];
+    uint32_t       used;
+    uint64_t       records;
+    uint32_t       last_instr;
+    uint32_t       next_index;
+};
+
+static inline bool track_writer_open(track_writer_t *writer, const char *name) {
+    char index_name[256];
+    snprintf(index_name, sizeof(index_name), "%s.idx", name);
+
+    writer->fp       = fopen(name, "wb");
+    writer->index_fp = fopen(index_name, "wb");
+    if(writer->fp == NULL || writer->index_fp == NULL) return false;
+
+    writer->used       = 0;
+    writer->records    = 0;
+    writer->last_instr = 0;
+    writer->next_index = 0;
+
+    track_header_t header;
+    memcpy(header.magic, TRACK_MAGIC, sizeof(header.magic));
+    header.version     = TRACK_VERSION;
+    header.record_size = sizeof(track_record_t);
+    fwrite(&header, sizeof(header), 1, writer->fp);
+    return true;
+}
+
+static inline void track_writer_flush(track_writer_t *writer) {
+    if(writer->used > 0) fwrite(writer->buffer, sizeof(track_record_t), writer->used, writer->fp);
+    writer->used = 0;
+    fflush(writer->fp);
+    fflush(writer->index_fp);
+}
+
+static inline void track_writer_push(track_writer_t *writer, const track_record_t &record) {
+    writer->buffer[writer->used++] = record;
+    writer->records++;
+
+    if(writer->used == sizeof(writer->buffer) / sizeof(track_record_t)) {
+        fwrite(writer->buffer, sizeof(track_record_t), writer->used, writer->fp);
+        writer->used = 0;
+    }
+}
+
+static inline void track_write(track_writer_t *writer, track_op_t op, uint32_t instr_counter, uint32_t address, uint32_t byteenable, uint32_t data) {
+    while(instr_counter >= writer->next_index) {
+        track_index_t index;
+        index.instr_counter = writer->next_index;
+        index.base_instr    = writer->last_instr;
+        index.record        = writer->records;
+        fwrite(&index, sizeof(index), 1, writer->index_fp);
+
+        writer->next_index += TRACK_INDEX_INTERVAL;
+        if(writer->next_index == 0) break;
+    }
+
+    uint32_t delta = instr_counter - writer->last_instr;
+    if(instr_counter < writer->last_instr || delta > 0xFFFF) {
+        track_record_t sync = { TRACK_SYNC, 0, 0, 0, instr_counter };
+        track_writer_push(writer, sync);
+        delta = 0;
+    }
+    writer->last_instr = instr_counter;
+
+    track_record_t record = { (uint8_t)op, (uint8_t)byteenable, (uint16_t)delta, address, data };
+    track_writer_push(writer, record);
+}
+
+static inline void track_writer_close(track_writer_t *writer) {
+    if(writer->fp == NULL) return;
+    track_writer_flush(writer);
+    fclose(writer->fp);
+    fclose(writer->index_fp);
+    writer->fp       = NULL;
+    writer->index_fp = NULL;
+}
+
+//------------------------------------------------------------------------------ reader
+
+struct track_reader_t {
+    const track_record_t *records;
+    uint64_t              count;
+    void                 *map;
+    size_t                map_size;
+
+    const track_index_t  *index;
+    uint64_t              index_count;
+    void                 *index_map;
+    size_t                index_map_size;
+};
+
+static inline void *track_map(const char *name, size_t *size) {
+    int fd = open(name, O_RDONLY);
+    if(fd == -1) return NULL;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return NULL;
+
+    madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+    *size = st.st_size;
+    return ptr;
+}
+
+//the index is optional: without it track_seek() falls back to record 0
+static inline bool track_reader_open(track_reader_t *reader, const char *name) {
+    memset(reader, 0, sizeof(track_reader_t));
+
+    reader->map = track_map(name, &reader->map_size);
+    if(reader->map == NULL || reader->map_size < sizeof(track_header_t)) return false;
+
+    const track_header_t *header = (const track_header_t *)reader->map;
+    if(memcmp(header->magic, TRACK_MAGIC, sizeof(header->magic)) != 0 || header->version != TRACK_VERSION || header->record_size != sizeof(track_record_t)) return false;
+
+    reader->records = (const track_record_t *)((const uint8_t *)reader->map + sizeof(track_header_t));
+    reader->count   = (reader->map_size - sizeof(track_header_t)) / sizeof(track_record_t);
+
+    char index_name[256];
+    snprintf(index_name, sizeof(index_name), "%s.idx", name);
+
+    reader->index_map = track_map(index_name, &reader->index_map_size);
+    if(reader->index_map != NULL) {
+        reader->index       = (const track_index_t *)reader->index_map;
+        reader->index_count = reader->index_map_size / sizeof(track_index_t);
+    }
+    return true;
+}
+
+//first record of the indexed interval holding instr_counter
+static inline uint64_t track_seek(const track_reader_t *reader, uint32_t instr_counter, uint32_t *base_instr) {
+    uint64_t lo = 0, hi = reader->index_count;
+
+    while(hi - lo > 1) {
+        uint64_t mid = (lo + hi) / 2;
+        if(reader->index[mid].instr_counter <= instr_counter) lo = mid;
+        else                                                  hi = mid;
+    }
+    if(reader->index_count == 0 || reader->index[lo].instr_counter > instr_counter) {
+        *base_instr = 0;
+        return 0;
+    }
+
+    *base_instr = reader->index[lo].base_instr;
+    return reader->index[lo].record;
+}
+
+static inline void track_reader_close(track_reader_t *reader) {
+    if(reader->map)       munmap(reader->map,       reader->map_size);
+    if(reader->index_map) munmap(reader->index_map, reader->index_map_size);
+    memset(reader, 0, sizeof(track_reader_t));
+}
+
+#endif //__TRACK_H
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "track.h"
+
+//converts an old text track.txt into the binary track format read by main_reader
+
+int main(int argc, char **argv) {
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s <track.txt> <track.trk>\n", argv[0]);
+        return -1;
+    }
+
+    FILE *fp = fopen(argv[1], "rb");
+    if(fp == NULL) {
+        fprintf(stderr, "#track_convert: can not open %s\n", argv[1]);
+        return -1;
+    }
+
+    static track_writer_t track;
+    if(track_writer_open(&track, argv[2]) == false) {
+        fprintf(stderr, "#track_convert: can not open %s\n", argv[2]);
+        fclose(fp);
+        return -1;
+    }
+
+    //text lines carry no instruction counter apart from IAC and Exception
+    uint32_t instr_counter = 0;
+    uint32_t lines = 0;
+
+    char line[256];
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        unsigned int val1 = 0, val2 = 0, val3 = 0;
+        char kind[32];
+
+        if(sscanf(line, "mem rd %x %x %x", &val1, &val2, &val3) == 3)      track_write(&track, TRACK_MEM_RD, instr_counter, val1, val2, val3);
+        else if(sscanf(line, "mem wr %x %x %x", &val1, &val2, &val3) == 3) track_write(&track, TRACK_MEM_WR, instr_counter, val1, val2, val3);
+        else if(sscanf(line, "io rd %x %x %x", &val1, &val2, &val3) == 3)  track_write(&track, TRACK_IO_RD,  instr_counter, val1, val2, val3);
+        else if(sscanf(line, "io wr %x %x %x", &val1, &val2, &val3) == 3)  track_write(&track, TRACK_IO_WR,  instr_counter, val1, val2, val3);
+        else if(sscanf(line, "Exception 0x%x at %u", &val1, &val2) == 2) {
+            instr_counter = val2;
+            track_write(&track, TRACK_EXCEPTION, instr_counter, val1, 0, val2);
+        }
+        else if(sscanf(line, "IAC 0x%x at %u", &val1, &val2) == 2) {
+            instr_counter = val2;
+            track_write(&track, TRACK_IAC, instr_counter, val1, TRACK_IAC_NORMAL, val2);
+        }
+        else if(sscanf(line, "IAC%31s 0x%x at %u", kind, &val1, &val2) == 3) {
+            instr_counter = val2;
+            track_write(&track, TRACK_IAC, instr_counter, val1, (strcmp(kind, "-spurIDLE") == 0)? TRACK_IAC_SPUR_IDLE : TRACK_IAC_SPUR_ACK, val2);
+        }
+        else {
+            fprintf(stderr, "#track_convert: skipped line %u: %s", lines + 1, line);
+        }
+        lines++;
+    }
+
+    fclose(fp);
+    track_writer_close(&track);
+
+    printf("#track_convert: %u lines, %lu records\n", lines, (unsigned long)track.records);
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "Vl1_icache.h"
+#include "verilated.h"
+
+/* LRU test of rtl/cache/l1_icache.v, 128 sets x 8 dwords x 4 ways.
+ *
+ * Lines A, B, C and D fill set 1, line X set 0, then B is read again: B is
+ * the newest line of set 1 and A the oldest. A read of the last dword of X
+ * hits X and goes on into line E of set 1, a miss. The LRU update of the X
+ * hit belongs to set 0; when it is written to set 1 instead, set 1 takes the
+ * order of set 0 and E replaces B. With the update in its own set, E replaces
+ * A, and B, C, D and E all hit afterwards.
+ *
+ * Every cpu read is a burst of 4 dwords; memory answers a readcode request
+ * with its 8 dwords after MEM_LATENCY clocks.
+ */
+
+//------------------------------------------------------------------------------
+
+#define LINE_BYTES  32
+#define WAY_BYTES   (128 * LINE_BYTES)  //same set, next tag
+#define MEM_LATENCY 3
+
+Vl1_icache *top = NULL;
+
+uint32_t fills = 0;
+
+void tick() {
+    top->CLK = 0; top->eval();
+    top->CLK = 1; top->eval();
+}
+
+void cpu_read(uint32_t address) {
+    top->CPU_ADDR = address;
+    top->CPU_REQ  = 1;
+    tick();
+    top->CPU_REQ = 0;
+
+    uint32_t words = 0;
+    uint32_t wait  = 0;
+    for(uint32_t i=0; ; i++) {
+        if(i == 1000) {
+            printf("read 0x%08x: no CPU_DONE\n", address);
+            exit(-1);
+        }
+
+        if(top->MEM_REQ && words == 0) {
+            fills++;
+            words = 8;
+            wait  = MEM_LATENCY;
+        }
+
+        top->MEM_DONE = 0;
+        if(wait > 0)       wait--;
+        else if(words > 0) {
+            top->MEM_DONE = 1;
+            top->MEM_DATA = address + words;
+            words--;
+        }
+
+        bool done = top->CPU_DONE;
+        tick();
+        if(done) break;
+    }
+    top->MEM_DONE = 0;
+
+    for(uint32_t i=0; i<3; i++) tick();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    top = new Vl1_icache();
+
+    top->pr_reset = 0;
+    top->DISABLE  = 0;
+    top->CPU_REQ  = 0;
+    top->MEM_DONE = 0;
+    top->snoop_we = 0;
+
+    //reset, then the START state clears every set
+    top->RESET = 1;
+    for(uint32_t i=0; i<3; i++) tick();
+    top->RESET = 0;
+    for(uint32_t i=0; i<200; i++) tick();
+
+    uint32_t base = 0x100000;
+    uint32_t A = base + 0 * WAY_BYTES + LINE_BYTES;
+    uint32_t B = base + 1 * WAY_BYTES + LINE_BYTES;
+    uint32_t C = base + 2 * WAY_BYTES + LINE_BYTES;
+    uint32_t D = base + 3 * WAY_BYTES + LINE_BYTES;
+    uint32_t X = base + 8 * WAY_BYTES;
+    uint32_t E = X + LINE_BYTES;
+
+    cpu_read(A); cpu_read(B); cpu_read(C); cpu_read(D);
+    cpu_read(X);
+    cpu_read(B);
+    cpu_read(E - 4);
+
+    if(fills != 6) {
+        printf("FAIL: %u fills to set up, expected 6\n", fills);
+        return 1;
+    }
+    fills = 0;
+
+    cpu_read(B); cpu_read(C); cpu_read(D); cpu_read(E);
+
+    delete top;
+
+    if(fills != 0) {
+        printf("FAIL: %u of B, C, D, E missed after E replaced the oldest line\n", fills);
+        return 1;
+    }
+    printf("l1_icache LRU: ok\n");
+    return 0;
+}
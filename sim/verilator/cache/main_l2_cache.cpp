@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "Vl2_cache.h"
+#include "verilated.h"
+
+/* LRU test of rtl/cache/l2_cache.v, 128 sets x 8 qwords x 4 ways.
+ *
+ * The sequence of main_l1_icache.cpp: A, B, C and D fill set 1, X fills set 0
+ * and B is read again. A burst of 2 dwords from the last dword of X hits X
+ * and misses at E in set 1; E must replace A, the oldest line of set 1, so B,
+ * C, D and E all hit afterwards. When the LRU update of the X hit lands on
+ * set 1, E replaces B.
+ *
+ * DDRAM is never busy and answers a read with its burst after DDRAM_LATENCY
+ * clocks. Addresses are in dwords, as on the CPU bus.
+ */
+
+//------------------------------------------------------------------------------
+
+#define LINE_DWORDS   16
+#define WAY_DWORDS    (128 * LINE_DWORDS)   //same set, next tag
+#define DDRAM_LATENCY 3
+
+Vl2_cache *top = NULL;
+
+uint32_t fills = 0;
+
+void tick() {
+    top->CLK = 0; top->eval();
+    top->CLK = 1; top->eval();
+}
+
+void cpu_read(uint32_t address, uint32_t burstcount) {
+    top->CPU_ADDR     = address;
+    top->CPU_BURSTCNT = burstcount;
+    top->CPU_BE       = 0xF;
+    top->CPU_RD       = 1;
+
+    uint32_t beats = 0;
+    uint32_t wait  = 0;
+    uint32_t words = 0;
+    for(uint32_t i=0; words < burstcount; i++) {
+        if(i == 1000) {
+            printf("read 0x%08x: %u of %u dwords\n", address, words, burstcount);
+            exit(-1);
+        }
+
+        if(top->DDRAM_RD) {
+            fills++;
+            beats = top->DDRAM_BURSTCNT;
+            wait  = DDRAM_LATENCY;
+        }
+        if(top->CPU_DOUT_READY) words++;
+
+        tick();
+        top->CPU_RD = 0;
+
+        top->DDRAM_DOUT_READY = 0;
+        if(wait > 0)       wait--;
+        else if(beats > 0) {
+            top->DDRAM_DOUT_READY = 1;
+            top->DDRAM_DOUT       = ((uint64_t)address << 32) | beats;
+            beats--;
+        }
+    }
+
+    for(uint32_t i=0; i<4; i++) tick();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    top = new Vl2_cache();
+
+    top->DISABLE          = 0;
+    top->CPU_RD           = 0;
+    top->CPU_WE           = 0;
+    top->DDRAM_BUSY       = 0;
+    top->DDRAM_DOUT_READY = 0;
+    top->VGA_MODE         = 0;
+    top->VGA_DIN          = 0;
+    top->VGA_FB_EN        = 0;
+    top->uma_ram          = 0;
+
+    //reset, then the START state clears every set
+    top->RESET = 1;
+    for(uint32_t i=0; i<4; i++) tick();
+    top->RESET = 0;
+    for(uint32_t i=0; i<300; i++) tick();
+
+    uint32_t base = 0x10000;
+    uint32_t A = base + 0 * WAY_DWORDS + LINE_DWORDS;
+    uint32_t B = base + 1 * WAY_DWORDS + LINE_DWORDS;
+    uint32_t C = base + 2 * WAY_DWORDS + LINE_DWORDS;
+    uint32_t D = base + 3 * WAY_DWORDS + LINE_DWORDS;
+    uint32_t X = base + 8 * WAY_DWORDS;
+    uint32_t E = X + LINE_DWORDS;
+
+    cpu_read(A, 1); cpu_read(B, 1); cpu_read(C, 1); cpu_read(D, 1);
+    cpu_read(X, 1);
+    cpu_read(B, 1);
+    cpu_read(E - 1, 2);
+
+    if(fills != 6) {
+        printf("FAIL: %u fills to set up, expected 6\n", fills);
+        return 1;
+    }
+    fills = 0;
+
+    cpu_read(B, 1); cpu_read(C, 1); cpu_read(D, 1); cpu_read(E, 1);
+
+    delete top;
+
+    if(fills != 0) {
+        printf("FAIL: %u of B, C, D, E missed after E replaced the oldest line\n", fills);
+        return 1;
+    }
+    printf("l2_cache LRU: ok\n");
+    return 0;
+}
@@ -0,0 +1,236 @@
+// Behavioural models of the vendor RAM primitives used by the RTL, for
+// Verilator builds only. Quartus uses altera_mf and rtl/common/bram.vhd.
+//
+// Only the configurations instantiated in rtl/ are modelled:
+//  - dpram / dpram_difclk: registered address, unregistered output,
+//    new data on same-port read-during-write, equal port widths.
+//  - altdpram: registered write, unregistered read address and output.
+//  - altsyncram DUAL_PORT: port A writes (width_a = N * width_b), port B
+//    reads with a registered address and unregistered output.
+//
+// Default input values follow bram.vhd and need Verilator 5.
+
+/* verilator lint_off UNUSEDPARAM */
+/* verilator lint_off UNUSEDSIGNAL */
+
+module dpram_difclk #(
+	parameter addr_width_a  = 8,
+	parameter data_width_a  = 8,
+	parameter addr_width_b  = 8,
+	parameter data_width_b  = 8,
+	parameter mem_init_file = " "
+)
+(
+	input                          clk_a,
+	input                          clk_b,
+
+	input       [addr_width_a-1:0] address_a,
+	input       [data_width_a-1:0] data_a   = '0,
+	input                          enable_a = 1'b1,
+	input                          wren_a   = 1'b0,
+	output      [data_width_a-1:0] q_a,
+	input                          cs_a     = 1'b1,
+
+	input       [addr_width_b-1:0] address_b = '0,
+	input       [data_width_b-1:0] data_b    = '0,
+	input                          enable_b  = 1'b1,
+	input                          wren_b    = 1'b0,
+	output      [data_width_b-1:0] q_b,
+	input                          cs_b      = 1'b1
+);
+
+reg [data_width_a-1:0] mem[0:(2**addr_width_a)-1];
+
+reg [addr_width_a-1:0] address_a_r;
+reg [addr_width_b-1:0] address_b_r;
+
+always @(posedge clk_a) if(enable_a) begin
+	address_a_r <= address_a;
+	if(wren_a & cs_a) mem[address_a] <= data_a;
+end
+
+always @(posedge clk_b) if(enable_b) begin
+	address_b_r <= address_b;
+	if(wren_b & cs_b) mem[address_b] <= data_b;
+end
+
+assign q_a = cs_a ? mem[address_a_r] : {data_width_a{1'b1}};
+assign q_b = cs_b ? mem[address_b_r] : {data_width_b{1'b1}};
+
+endmodule
+
+//------------------------------------------------------------------------------
+
+module dpram #(
+	parameter addr_width    = 8,
+	parameter data_width    = 8,
+	parameter mem_init_file = " "
+)
+(
+	input                        clock,
+
+	input       [addr_width-1:0] address_a,
+	input       [data_width-1:0] data_a   = '0,
+	input                        enable_a = 1'b1,
+	input                        wren_a   = 1'b0,
+	output      [data_width-1:0] q_a,
+	input                        cs_a     = 1'b1,
+
+	input       [addr_width-1:0] address_b = '0,
+	input       [data_width-1:0] data_b    = '0,
+	input                        enable_b  = 1'b1,
+	input                        wren_b    = 1'b0,
+	output      [data_width-1:0] q_b,
+	input                        cs_b      = 1'b1
+);
+
+dpram_difclk #(addr_width, data_width, addr_width, data_width, mem_init_file) ram
+(
+	.clk_a     (clock),
+	.clk_b     (clock),
+
+	.address_a (address_a),
+	.data_a    (data_a),
+	.enable_a  (enable_a),
+	.wren_a    (wren_a),
+	.q_a       (q_a),
+	.cs_a      (cs_a),
+
+	.address_b (address_b),
+	.data_b    (data_b),
+	.enable_b  (enable_b),
+	.wren_b    (wren_b),
+	.q_b       (q_b),
+	.cs_b      (cs_b)
+);
+
+endmodule
+
+//------------------------------------------------------------------------------
+
+module altdpram #(
+	parameter indata_aclr                        = "OFF",
+	parameter indata_reg                         = "INCLOCK",
+	parameter intended_device_family             = "Cyclone V",
+	parameter lpm_type                           = "altdpram",
+	parameter outdata_aclr                       = "OFF",
+	parameter outdata_reg                        = "UNREGISTERED",
+	parameter ram_block_type                     = "MLAB",
+	parameter rdaddress_aclr                     = "OFF",
+	parameter rdaddress_reg                      = "UNREGISTERED",
+	parameter rdcontrol_aclr                     = "OFF",
+	parameter rdcontrol_reg                      = "UNREGISTERED",
+	parameter read_during_write_mode_mixed_ports = "CONSTRAINED_DONT_CARE",
+	parameter width                              = 1,
+	parameter widthad                            = 1,
+	parameter width_byteena                      = 1,
+	parameter wraddress_aclr                     = "OFF",
+	parameter wraddress_reg                      = "INCLOCK",
+	parameter wrcontrol_aclr                     = "OFF",
+	parameter wrcontrol_reg                      = "INCLOCK"
+)
+(
+	input                inclock,
+	input                outclock       = 1'b1,
+
+	input    [width-1:0] data,
+	input  [widthad-1:0] rdaddress,
+	input  [widthad-1:0] wraddress,
+	input                wren,
+	output   [width-1:0] q,
+
+	input                aclr           = 1'b0,
+	input                byteena        = 1'b1,
+	input                inclocken      = 1'b1,
+	input                outclocken     = 1'b1,
+	input                rdaddressstall = 1'b0,
+	input                rden           = 1'b1,
+	input                sclr           = 1'b0,
+	input                wraddressstall = 1'b0
+);
+
+reg [width-1:0] mem[0:(2**widthad)-1];
+
+always @(posedge inclock) if(inclocken && wren) mem[wraddress] <= data;
+
+assign q = mem[rdaddress];
+
+endmodule
+
+//------------------------------------------------------------------------------
+
+module altsyncram #(
+	parameter address_aclr_b                     = "NONE",
+	parameter address_reg_b                      = "CLOCK0",
+	parameter byte_size                          = 8,
+	parameter clock_enable_input_a               = "BYPASS",
+	parameter clock_enable_input_b               = "BYPASS",
+	parameter clock_enable_output_b              = "BYPASS",
+	parameter intended_device_family             = "Cyclone V",
+	parameter lpm_type                           = "altsyncram",
+	parameter numwords_a                         = 256,
+	parameter numwords_b                         = 256,
+	parameter operation_mode                     = "DUAL_PORT",
+	parameter outdata_aclr_b                     = "NONE",
+	parameter outdata_reg_b                      = "UNREGISTERED",
+	parameter power_up_uninitialized             = "FALSE",
+	parameter read_during_write_mode_mixed_ports = "DONT_CARE",
+	parameter widthad_a                          = 8,
+	parameter widthad_b                          = 8,
+	parameter width_a                            = 8,
+	parameter width_b                            = 8,
+	parameter width_byteena_a                    = 1
+)
+(
+	input                        clock0,
+
+	input        [widthad_a-1:0] address_a,
+	input  [width_byteena_a-1:0] byteena_a,
+	input          [width_a-1:0] data_a,
+	input                        wren_a,
+
+	input        [widthad_b-1:0] address_b,
+	output         [width_b-1:0] q_b,
+
+	input                        aclr0          = 1'b0,
+	input                        aclr1          = 1'b0,
+	input                        addressstall_a = 1'b0,
+	input                        addressstall_b = 1'b0,
+	input                        byteena_b      = 1'b1,
+	input                        clock1         = 1'b1,
+	input                        clocken0       = 1'b1,
+	input                        clocken1       = 1'b1,
+	input                        clocken2       = 1'b1,
+	input                        clocken3       = 1'b1,
+	input          [width_b-1:0] data_b         = '0,
+	output                 [2:0] eccstatus,
+	output         [width_a-1:0] q_a,
+	input                        rden_a         = 1'b1,
+	input                        rden_b         = 1'b1,
+	input                        wren_b         = 1'b0
+);
+
+localparam RATIO = width_a / width_b;
+
+reg [width_b-1:0] mem[0:numwords_b-1];
+reg [widthad_b-1:0] address_b_r;
+
+integer i, j;
+always @(posedge clock0) begin
+	address_b_r <= address_b;
+
+	if(wren_a) begin
+		for(i = 0; i < RATIO; i = i + 1) begin
+			for(j = 0; j < width_b / byte_size; j = j + 1) begin
+				if(byteena_a[i * (width_b / byte_size) + j])
+					mem[address_a * RATIO + i][j * byte_size +: byte_size] <= data_a[i * width_b + j * byte_size +: byte_size];
+			end
+		end
+	end
+end
+
+assign q_b       = mem[address_b_r];
+assign q_a       = '0;
+assign eccstatus = 3'd0;
+
+endmodule
@@ -0,0 +1,102 @@
+// gh_uart_16550_sim.v
+//
+// Register-level stand-in for the VHDL gh_uart_16550, so that rtl/system.v
+// verilates without a mixed-language simulator. No serial line is modelled:
+// the transmitter is always empty, the receiver never has data and no
+// interrupt is ever raised. Scratch, control and divisor registers read back.
+
+/* verilator lint_off UNUSEDSIGNAL */
+/* verilator lint_off UNUSEDPARAM */
+
+module gh_uart_16550 #(
+	parameter MPU_MODE = 1'b0
+)
+(
+	input            clk,
+	input            BR_clk,
+	input            rst,
+	input            CS,
+	input            WR,
+	input      [2:0] ADD,
+	input      [7:0] D,
+
+	input            sRX,
+	input            CTSn = 1'b1,
+	input            DSRn = 1'b1,
+	input            RIn  = 1'b1,
+	input            DCDn = 1'b1,
+
+	output           sTX,
+	output           DTRn,
+	output           RTSn,
+	output           OUT1n,
+	output           OUT2n,
+	output           TXRDYn,
+	output           RXRDYn,
+
+	input            DIV2 = 1'b0,
+	output           RX_Empty,
+	output           RX_Full,
+	output           TX_Empty,
+	output           TX_Full,
+
+	output           IRQ,
+	output           B_CLK,
+	output reg [7:0] RD
+);
+
+reg [7:0] ier, lcr, mcr, scr, fcr, dll, dlm;
+
+always @(posedge clk) begin
+	if(rst) begin
+		ier <= 8'h00;
+		lcr <= 8'h00;
+		mcr <= 8'h00;
+		scr <= 8'h00;
+		fcr <= 8'h00;
+		dll <= 8'h00;
+		dlm <= 8'h00;
+	end
+	else if(CS & WR) begin
+		case(ADD)
+			0: if(lcr[7]) dll <= D;
+			1: if(lcr[7]) dlm <= D; else ier <= D;
+			2: fcr <= D;
+			3: lcr <= D;
+			4: mcr <= D;
+			7: scr <= D;
+			default: ;
+		endcase
+	end
+end
+
+always @(*) begin
+	case(ADD)
+		0: RD = lcr[7] ? dll : 8'h00;
+		1: RD = lcr[7] ? dlm : ier;
+		2: RD = fcr[0] ? 8'hC1 : 8'h01;
+		3: RD = lcr;
+		4: RD = mcr;
+		5: RD = 8'h60;
+		6: RD = mcr[4] ? {mcr[3:0], 4'h0} : {~DCDn, ~RIn, ~DSRn, ~CTSn, 4'h0};
+		7: RD = scr;
+	endcase
+end
+
+assign sTX      = 1'b1;
+assign DTRn     = ~mcr[0];
+assign RTSn     = ~mcr[1];
+assign OUT1n    = ~mcr[2];
+assign OUT2n    = ~mcr[3];
+assign TXRDYn   = 1'b0;
+assign RXRDYn   = 1'b1;
+
+assign RX_Empty = 1'b1;
+assign RX_Full  = 1'b0;
+assign TX_Empty = 1'b1;
+assign TX_Full  = 1'b0;
+
+assign IRQ      = 1'b0;
+assign B_CLK    = 1'b0;
+
+endmodule
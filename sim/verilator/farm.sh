@@ -0,0 +1,112 @@
+#!/bin/bash
+#
+# Runs independent simulation jobs in parallel, each in its own instance
+# directory (AO486_INSTANCE, see sim_pc/shared_mem.h) and pinned to its own
+# cores, and collects pass/fail plus cycles per second into one report.
+#
+# usage: farm.sh [-j jobs] [-c cores_per_job] [-o out_dir] job_file
+#
+# job_file, one job per line, '#' starts a comment:
+#   <name> <timeout_seconds> <command ...>
+#
+# The command runs through bash from the directory farm.sh was started in.
+# It is its own process group, which is killed when the command returns or
+# times out, so co-simulations may leave sim_pc and the device plugins
+# running in the background. A job passes when the command exits with 0.
+# Cycles per second are taken from the last "cycles per second: N" line of
+# its output.
+
+NCPU=$(nproc)
+JOBS=$NCPU
+CORES=1
+OUT=farm
+
+while getopts "j:c:o:" opt; do
+	case $opt in
+		j) JOBS=$OPTARG ;;
+		c) CORES=$OPTARG ;;
+		o) OUT=$OPTARG ;;
+		*) echo "usage: $0 [-j jobs] [-c cores_per_job] [-o out_dir] job_file"; exit 2 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+JOB_FILE=$1
+if [ -z "$JOB_FILE" ] || [ ! -f "$JOB_FILE" ]; then
+	echo "usage: $0 [-j jobs] [-c cores_per_job] [-o out_dir] job_file"
+	exit 2
+fi
+
+mkdir -p "$OUT"
+OUT=$(cd "$OUT" && pwd)
+
+mapfile -t LINES < <(grep -v '^\s*\(#\|$\)' "$JOB_FILE")
+
+run_job() {
+	local name=$1 limit=$2 cores=$3 cmd=$4
+	local dir=$OUT/$name
+
+	rm -rf "$dir"
+	mkdir -p "$dir"
+
+	local start=$(date +%s.%N)
+
+	#job control: the command gets a process group of its own, with id $pid
+	set -m
+	AO486_INSTANCE=$dir taskset -c "$cores" bash -c "$cmd" > "$dir/log.txt" 2>&1 &
+	local pid=$!
+	set +m
+	( sleep "$limit"; touch "$dir/timeout"; kill -TERM -- -$pid 2>/dev/null ) &
+	local timer=$!
+
+	wait $pid
+	local status=$?
+
+	#the sleep too, it would keep the output of farm.sh open until the limit
+	pkill -P $timer 2>/dev/null
+	kill $timer 2>/dev/null
+	wait $timer 2>/dev/null
+	kill -TERM -- -$pid 2>/dev/null
+
+	local seconds=$(awk "BEGIN { print $(date +%s.%N) - $start }")
+	local cps=$(grep -o 'cycles per second: [0-9]*' "$dir/log.txt" | tail -n 1 | awk '{ print $4 }')
+
+	local result=PASS
+	if [ -f "$dir/timeout" ]; then result=TIMEOUT
+	elif [ $status -ne 0 ]; then result="FAIL($status)"
+	fi
+
+	printf "%-24s %-10s %10.1f %14s  cores %s\n" "$name" "$result" "$seconds" "${cps:--}" "$cores" > "$dir/result.txt"
+}
+
+#worker k runs jobs k, k+JOBS, ... on cores k*CORES .. (k+1)*CORES-1, wrapped to the machine
+worker() {
+	local k=$1
+	local cores=$(( (k * CORES) % NCPU ))
+	for ((c = 1; c < CORES; c++)); do cores="$cores,$(( (k * CORES + c) % NCPU ))"; done
+
+	for ((i = k; i < ${#LINES[@]}; i += JOBS)); do
+		read -r name limit cmd <<< "${LINES[$i]}"
+		run_job "$name" "$limit" "$cores" "$cmd"
+	done
+}
+
+for ((k = 0; k < JOBS && k < ${#LINES[@]}; k++)); do
+	worker $k &
+done
+wait
+
+REPORT=$OUT/report.txt
+{
+	printf "%-24s %-10s %10s %14s\n" "job" "result" "seconds" "cycles/s"
+	for line in "${LINES[@]}"; do
+		read -r name rest <<< "$line"
+		cat "$OUT/$name/result.txt" 2>/dev/null || printf "%-24s %-10s\n" "$name" "NOT RUN"
+	done
+} > "$REPORT"
+
+cat "$REPORT"
+
+PASSED=$(grep -c ' PASS ' "$REPORT")
+echo "passed $PASSED of ${#LINES[@]}, report in $REPORT"
+[ "$PASSED" -eq "${#LINES[@]}" ]
@@ -0,0 +1,688 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include "Vao486.h"
+#include "Vpic.h"
+#include "Vpit.h"
+#include "Vrtc.h"
+#include "Vps2.h"
+#include "Vfloppy.h"
+#include "Vdma.h"
+#include "Vvga.h"
+#include "Vide.h"
+#include "verilated.h"
+
+#include "shared_mem.h"
+
+/* Single-process PC: the ao486 core and every device model are linked into
+ * one executable and clocked by one loop. I/O is dispatched by a direct call
+ * through a port-indexed decoder, following rtl/soc/iobus.v and the chip
+ * selects of rtl/system.v; memory is served from a private memory_t.
+ */
+
+//------------------------------------------------------------------------------
+
+#define CLOCK_RATE 90000000
+
+Vao486  *cpu    = NULL;
+Vpic    *pic    = NULL;
+Vpit    *pit    = NULL;
+Vrtc    *rtc    = NULL;
+Vps2    *ps2    = NULL;
+Vfloppy *floppy = NULL;
+Vdma    *dma    = NULL;
+Vvga    *vga    = NULL;
+Vide    *ide0   = NULL;
+
+memory_t *memory = NULL;
+
+FILE *debug_fp = NULL;
+
+//------------------------------------------------------------------------------ io decoder
+
+struct io_device_t {
+    const char *name;
+    void   (*access)(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize);
+    uint32 (*readdata)();
+};
+
+void pic_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    pic->io_address   = address & 1;
+    pic->io_read      = read;
+    pic->io_write     = write;
+    pic->io_writedata = writedata & 0xFF;
+    pic->io_master_cs = (address & 0xFFFE) == 0x0020;
+    pic->io_slave_cs  = (address & 0xFFFE) == 0x00A0;
+}
+uint32 pic_readdata() { return pic->io_readdata; }
+
+void pit_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    pit->io_address   = (((address >> 5) & 1) << 2) | (address & 3);
+    pit->io_read      = read;
+    pit->io_write     = write;
+    pit->io_writedata = writedata & 0xFF;
+}
+uint32 pit_readdata() { return pit->io_readdata; }
+
+void rtc_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    rtc->io_address   = address & 1;
+    rtc->io_read      = read;
+    rtc->io_write     = write;
+    rtc->io_writedata = writedata & 0xFF;
+}
+uint32 rtc_readdata() { return rtc->io_readdata; }
+
+void ps2_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    ps2->io_address   = address & 0xF;
+    ps2->io_read      = read;
+    ps2->io_write     = write;
+    ps2->io_writedata = writedata & 0xFF;
+    ps2->io_cs        = (address & 0xFFF8) == 0x0060;
+    ps2->ctl_cs       = (address & 0xFFF0) == 0x0090;
+}
+uint32 ps2_readdata() { return ps2->io_readdata; }
+
+void floppy_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    floppy->io_address   = address & 7;
+    floppy->io_read      = read;
+    floppy->io_write     = write;
+    floppy->io_writedata = writedata & 0xFF;
+}
+uint32 floppy_readdata() { return floppy->io_readdata; }
+
+void dma_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    dma->io_address   = address & 0x1F;
+    dma->io_read      = read;
+    dma->io_write     = write;
+    dma->io_writedata = writedata & 0xFF;
+    dma->io_master_cs = (address & 0xFFE0) == 0x00C0;
+    dma->io_slave_cs  = (address & 0xFFF0) == 0x0000;
+    dma->io_page_cs   = (address & 0xFFF0) == 0x0080;
+}
+uint32 dma_readdata() { return dma->io_readdata; }
+
+void vga_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    vga->io_address   = address & 0xF;
+    vga->io_read      = read;
+    vga->io_write     = write;
+    vga->io_writedata = writedata & 0xFF;
+    vga->io_b_cs      = (address & 0xFFF0) == 0x03B0;
+    vga->io_c_cs      = (address & 0xFFF0) == 0x03C0;
+    vga->io_d_cs      = (address & 0xFFF0) == 0x03D0;
+}
+uint32 vga_readdata() { return vga->io_readdata; }
+
+void ide0_access(uint16 address, bool read, bool write, uint32 writedata, uint32 datasize) {
+    ide0->io_address   = (((address >> 9) & 1) << 3) | (address & 7);
+    ide0->io_read      = read;
+    ide0->io_write     = write;
+    ide0->io_writedata = writedata;
+    ide0->io_32        = (datasize >> 2) & 1;
+}
+uint32 ide0_readdata() { return ide0->io_readdata; }
+
+io_device_t io_devices[] = {
+    { "",       NULL,          NULL             },
+    { "pic",    pic_access,    pic_readdata     },
+    { "pit",    pit_access,    pit_readdata     },
+    { "rtc",    rtc_access,    rtc_readdata     },
+    { "ps2",    ps2_access,    ps2_readdata     },
+    { "floppy", floppy_access, floppy_readdata  },
+    { "dma",    dma_access,    dma_readdata     },
+    { "vga",    vga_access,    vga_readdata     },
+    { "ide0",   ide0_access,   ide0_readdata    },
+};
+
+enum io_device_id_t {
+    IO_NONE = 0, IO_PIC, IO_PIT, IO_RTC, IO_PS2, IO_FLOPPY, IO_DMA, IO_VGA, IO_IDE0
+};
+
+uint8 io_map[65536];
+uint8 io_is32[65536];
+
+void io_register(uint32 first, uint32 last, uint8 device, bool is32) {
+    for(uint32 port = first; port <= last; port++) {
+        io_map[port]   = device;
+        io_is32[port]  = is32;
+    }
+}
+
+void io_init() {
+    memset(io_map,  IO_NONE, sizeof(io_map));
+    memset(io_is32, 0,       sizeof(io_is32));
+
+    io_register(0x0000, 0x000F, IO_DMA,    false);
+    io_register(0x0020, 0x0021, IO_PIC,    false);
+    io_register(0x0040, 0x0043, IO_PIT,    false);
+    io_register(0x0060, 0x0067, IO_PS2,    false);
+    io_register(0x0061, 0x0061, IO_PIT,    false);
+    io_register(0x0070, 0x0071, IO_RTC,    false);
+    io_register(0x0080, 0x008F, IO_DMA,    false);
+    io_register(0x0090, 0x009F, IO_PS2,    false);
+    io_register(0x00A0, 0x00A1, IO_PIC,    false);
+    io_register(0x00C0, 0x00DF, IO_DMA,    false);
+    io_register(0x01F0, 0x01F7, IO_IDE0,   true);
+    io_register(0x03B0, 0x03DF, IO_VGA,    false);
+    io_register(0x03F0, 0x03F5, IO_FLOPPY, false);
+    io_register(0x03F6, 0x03F6, IO_IDE0,   false);
+    io_register(0x03F7, 0x03F7, IO_FLOPPY, false);
+    io_register(0x8888, 0x8888, IO_NONE,   true);
+}
+
+//------------------------------------------------------------------------------ iobus
+
+enum io_state_t {
+    IO_IDLE,
+    IO_WRITE,
+    IO_WRITE_CHK,
+    IO_READ,
+    IO_READ_CHK
+};
+
+io_state_t   io_state     = IO_IDLE;
+uint16       io_address   = 0;
+uint32       io_datasize  = 0;
+uint32       io_writedata = 0;
+uint32       io_readdata  = 0;
+uint32       io_count     = 0;
+io_device_t *io_selected  = NULL;
+
+void io_cycle() {
+    cpu->io_read_done  = 0;
+    cpu->io_write_done = 0;
+
+    if(io_selected != NULL) {
+        io_selected->access(io_address, false, false, 0, io_datasize);
+        io_selected = NULL;
+    }
+
+    io_device_t *device = (io_map[io_address] != IO_NONE)? &io_devices[io_map[io_address]] : NULL;
+
+    switch(io_state) {
+        case IO_IDLE:
+            if(cpu->io_write_do) {
+                io_address   = cpu->io_write_address;
+                io_datasize  = cpu->io_write_length;
+                io_writedata = cpu->io_write_data;
+                io_state     = IO_WRITE;
+            }
+            else if(cpu->io_read_do) {
+                io_address   = cpu->io_read_address;
+                io_datasize  = cpu->io_read_length;
+                io_readdata  = 0;
+                io_count     = 0;
+                io_state     = IO_READ;
+            }
+            break;
+
+        case IO_WRITE:
+            if(device != NULL) {
+                device->access(io_address, false, true, io_writedata, io_datasize);
+                io_selected = device;
+            }
+            else if(io_address == 0x8888) {
+                fprintf(debug_fp, "%c", io_writedata & 0xFF);
+                fflush(debug_fp);
+            }
+            io_state = IO_WRITE_CHK;
+            break;
+
+        case IO_WRITE_CHK:
+            if(io_datasize == 1 || io_is32[io_address]) {
+                cpu->io_write_done = 1;
+                io_state = IO_IDLE;
+            }
+            else {
+                io_address++;
+                io_writedata >>= 8;
+                io_datasize--;
+                io_state = IO_WRITE;
+            }
+            break;
+
+        case IO_READ:
+            if(device != NULL) {
+                device->access(io_address, true, false, 0, io_datasize);
+                io_selected = device;
+            }
+            io_state = IO_READ_CHK;
+            break;
+
+        case IO_READ_CHK: {
+            uint32 value = (device != NULL)? device->readdata() : 0xFFFFFFFF;
+
+            if(io_is32[io_address]) io_readdata = value;
+            else                    io_readdata |= (value & 0xFF) << (io_count * 8);
+
+            if(io_datasize == 1 || io_is32[io_address]) {
+                cpu->io_read_data = io_readdata;
+                cpu->io_read_done = 1;
+                io_state = IO_IDLE;
+            }
+            else {
+                io_address++;
+                io_datasize--;
+                io_count++;
+                io_state = IO_READ;
+            }
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------ memory
+
+enum mem_state_t {
+    MEM_IDLE,
+    MEM_READ,
+    MEM_WRITE,
+    MEM_VGA_READ,
+    MEM_VGA_READ_WAIT,
+    MEM_VGA_READ_SAMPLE,
+    MEM_VGA_WRITE
+};
+
+mem_state_t mem_state      = MEM_IDLE;
+uint32      mem_address    = 0;
+uint32      mem_burstcount = 0;
+uint32      mem_byteenable = 0;
+uint32      mem_byte       = 0;
+uint32      mem_data       = 0;
+uint32      mem_vga_data[8];
+uint32      mem_vga_count  = 0;
+uint32      mem_vga_wait   = 0;
+
+uint32      mem_dwords     = MEMORY_DEFAULT_SIZE / 4;
+
+//dword address; rtl/cache/l2_cache.v vga_rgn and rom_rgn with uma_ram off
+bool mem_is_vga(uint32 address) {
+    uint32 mask = 0, cmp = 3;
+
+    switch(vga->vga_memmode) {
+        case 4: mask = 0; cmp = 0; break;
+        case 5: mask = 2; cmp = 0; break;
+        case 6: mask = 3; cmp = 2; break;
+        case 7: mask = 3; cmp = 3; break;
+    }
+    return (address >> 15) == 0x5 && (((address >> 13) & 3) & mask) == cmp;
+}
+
+bool mem_is_rom(uint32 address) {
+    return (address >> 16) == 0x3;
+}
+
+uint32 mem_read(uint32 address) {
+    if(address >= mem_dwords) return 0;
+    return memory->ints[address];
+}
+
+void mem_write(uint32 address, uint32 data, uint32 byteenable) {
+    if(address >= mem_dwords || mem_is_rom(address)) return;
+
+    for(uint32 i=0; i<4; i++) {
+        if((byteenable >> i) & 1) memory->bytes[address*4 + i] = (data >> (i*8)) & 0xFF;
+    }
+}
+
+void mem_cycle() {
+    cpu->avm_readdatavalid = 0;
+    cpu->avm_waitrequest   = 1;
+
+    vga->mem_read  = 0;
+    vga->mem_write = 0;
+
+    switch(mem_state) {
+        case MEM_IDLE:
+            if(cpu->avm_read) {
+                mem_address    = cpu->avm_address;
+                mem_burstcount = cpu->avm_burstcount;
+                mem_byteenable = cpu->avm_byteenable;
+
+                if(mem_is_vga(mem_address)) {
+                    mem_byte      = 0;
+                    mem_vga_count = 0;
+                    mem_data      = 0;
+                    mem_state     = MEM_VGA_READ;
+                }
+                else {
+                    cpu->avm_waitrequest = 0;
+                    mem_state = MEM_READ;
+                }
+            }
+            else if(cpu->avm_write) {
+                mem_address    = cpu->avm_address;
+                mem_burstcount = cpu->avm_burstcount;
+
+                if(mem_is_vga(mem_address)) {
+                    mem_byte  = 0;
+                    mem_state = MEM_VGA_WRITE;
+                }
+                else {
+                    cpu->avm_waitrequest = 0;
+                    mem_write(mem_address, cpu->avm_writedata, cpu->avm_byteenable);
+
+                    mem_address++;
+                    mem_burstcount--;
+                    if(mem_burstcount > 0) mem_state = MEM_WRITE;
+                }
+            }
+            break;
+
+        case MEM_READ:
+            cpu->avm_readdatavalid = 1;
+            cpu->avm_readdata      = mem_read(mem_address);
+
+            mem_address++;
+            mem_burstcount--;
+            if(mem_burstcount == 0) mem_state = MEM_IDLE;
+            break;
+
+        case MEM_WRITE:
+            if(cpu->avm_write) {
+                cpu->avm_waitrequest = 0;
+                mem_write(mem_address, cpu->avm_writedata, cpu->avm_byteenable);
+
+                mem_address++;
+                mem_burstcount--;
+                if(mem_burstcount == 0) mem_state = MEM_IDLE;
+            }
+            break;
+
+        //one byte lane per access, two cycles of read latency, as l2_cache VGAWAIT/VGAREAD
+        case MEM_VGA_READ:
+            if(mem_byte == 4) {
+                mem_vga_data[mem_vga_count++] = mem_data;
+                mem_address++;
+                mem_byte = 0;
+                mem_data = 0;
+
+                if(mem_vga_count == mem_burstcount) {
+                    cpu->avm_waitrequest = 0;
+                    mem_vga_count = 0;
+                    mem_state     = MEM_VGA_READ_SAMPLE;
+                }
+            }
+            else if((mem_byteenable >> mem_byte) & 1) {
+                vga->mem_address = ((mem_address & 0x7FFF) << 2) | mem_byte;
+                vga->mem_read    = 1;
+                mem_vga_wait = 0;
+                mem_state = MEM_VGA_READ_WAIT;
+            }
+            else {
+                mem_byte++;
+            }
+            break;
+
+        case MEM_VGA_READ_WAIT:
+            if(mem_vga_wait++ == 0) break;
+
+            mem_data |= (uint32)vga->mem_readdata << (mem_byte * 8);
+            mem_byte++;
+            mem_state = MEM_VGA_READ;
+            break;
+
+        case MEM_VGA_READ_SAMPLE:
+            cpu->avm_readdatavalid = 1;
+            cpu->avm_readdata      = mem_vga_data[mem_vga_count++];
+
+            if(mem_vga_count == mem_burstcount) mem_state = MEM_IDLE;
+            break;
+
+        case MEM_VGA_WRITE:
+            if(mem_byte == 4) {
+                cpu->avm_waitrequest = 0;
+
+                mem_address++;
+                mem_burstcount--;
+                mem_byte = 0;
+
+                if(mem_burstcount == 0) mem_state = MEM_IDLE;
+            }
+            else if(cpu->avm_write) {
+                if((cpu->avm_byteenable >> mem_byte) & 1) {
+                    vga->mem_address   = ((mem_address & 0x7FFF) << 2) | mem_byte;
+                    vga->mem_writedata = (cpu->avm_writedata >> (mem_byte * 8)) & 0xFF;
+                    vga->mem_write     = 1;
+                }
+                mem_byte++;
+            }
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------ wiring
+
+void connect_models() {
+    //interrupts, as the always block at the end of rtl/system.v
+    pic->interrupt_input =
+        (pit->irq       << 0)  |
+        (ps2->irq_keyb  << 1)  |
+        (floppy->irq    << 6)  |
+        (rtc->irq       << 8)  |
+        (vga->irq       << 9)  |
+        (ps2->irq_mouse << 12) |
+        (ide0->irq      << 14);
+
+    cpu->interrupt_do     = pic->interrupt_do;
+    cpu->interrupt_vector = pic->interrupt_vector;
+    pic->interrupt_done   = cpu->interrupt_done;
+
+    cpu->a20_enable = ps2->a20_enable;
+
+    //floppy on dma channel 2
+    dma->dma_2_req       = floppy->dma_req;
+    dma->dma_2_writedata = floppy->dma_writedata;
+    floppy->dma_ack      = dma->dma_2_ack;
+    floppy->dma_tc       = dma->dma_2_tc;
+    floppy->dma_readdata = dma->dma_2_readdata;
+
+    //dma master on the cpu memory port
+    cpu->dma_address       = dma->mem_address;
+    cpu->dma_16bit         = dma->mem_16bit;
+    cpu->dma_read          = dma->mem_read;
+    cpu->dma_write         = dma->mem_write;
+    cpu->dma_writedata     = dma->mem_writedata;
+    dma->mem_readdata      = cpu->dma_readdata;
+    dma->mem_readdatavalid = cpu->dma_readdatavalid;
+    dma->mem_waitrequest   = cpu->dma_waitrequest;
+}
+
+void eval_models() {
+    pic->eval();
+    pit->eval();
+    rtc->eval();
+    ps2->eval();
+    floppy->eval();
+    dma->eval();
+    vga->eval();
+    ide0->eval();
+    cpu->eval();
+}
+
+void set_clock(uint8 clk) {
+    cpu->clk    = clk;
+    pic->clk    = clk;
+    pit->clk    = clk;
+    rtc->clk    = clk;
+    ps2->clk    = clk;
+    floppy->clk = clk;
+    dma->clk    = clk;
+    vga->clk_sys = clk;
+    vga->clk_vga = clk;
+    ide0->clk   = clk;
+}
+
+void set_reset(uint8 rst_n) {
+    cpu->rst_n    = rst_n;
+    pic->rst_n    = rst_n;
+    pit->rst_n    = rst_n;
+    rtc->rst_n    = rst_n;
+    ps2->rst_n    = rst_n;
+    floppy->rst_n = rst_n;
+    dma->rst_n    = rst_n;
+    vga->rst_n    = rst_n;
+    ide0->rst_n   = rst_n;
+}
+
+void clock_cycle() {
+    set_clock(1);
+    eval_models();
+
+    set_clock(0);
+    eval_models();
+
+    //settle the combinational paths that cross model boundaries
+    connect_models();
+    eval_models();
+}
+
+//------------------------------------------------------------------------------
+
+int load_file(const char *name, int byte_location) {
+    FILE *fp = fopen(name, "rb");
+    if(fp == NULL) {
+        return -1;
+    }
+
+    int int_ret = fseek(fp, 0, SEEK_END);
+    if(int_ret != 0) {
+        fclose(fp);
+        return -2;
+    }
+
+    long size = ftell(fp);
+    rewind(fp);
+
+    int_ret = fread((void *)&memory->bytes[byte_location], size, 1, fp);
+    if(int_ret != 1) {
+        fclose(fp);
+        return -3;
+    }
+    fclose(fp);
+
+    return 0;
+}
+
+uint64 time_usec() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+int main(int argc, char **argv) {
+
+    const char *bios_file    = "./../../../releases/boot0.rom";
+    const char *vgabios_file = "./../../../releases/boot1.rom";
+    uint64      max_cycles   = 0;
+    uint32      mem_mb       = MEMORY_DEFAULT_SIZE >> 20;
+
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--bios") == 0 && i+1 < argc)         bios_file    = argv[++i];
+        else if(strcmp(argv[i], "--vgabios") == 0 && i+1 < argc) vgabios_file = argv[++i];
+        else if(strcmp(argv[i], "--cycles") == 0 && i+1 < argc)  max_cycles   = strtoull(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--mem-mb") == 0 && i+1 < argc)  mem_mb       = strtoul(argv[++i], NULL, 0);
+    }
+    //same sizes as sim_pc, whose mem_mask() needs a power of two
+    if(mem_mb < 1 || mem_mb > (MEMORY_MAX_SIZE >> 20) || (mem_mb & (mem_mb - 1)) != 0) {
+        fprintf(stderr, "--mem-mb %u: must be a power of two between 1 and %u\n", mem_mb, MEMORY_MAX_SIZE >> 20);
+        return -1;
+    }
+    mem_dwords = (mem_mb << 20) / 4;
+
+    //anonymous mapping: zero pages are only touched when written
+    memory = (memory_t *)mmap(NULL, sizeof(memory_t), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(memory == MAP_FAILED) {
+        perror("mmap() failed");
+        return -1;
+    }
+
+    if(load_file(bios_file, 0xF0000) != 0) {
+        fprintf(stderr, "Can not load bios file %s\n", bios_file);
+        return -2;
+    }
+    if(load_file(vgabios_file, 0xC0000) != 0) {
+        fprintf(stderr, "Can not load vgabios file %s\n", vgabios_file);
+        return -2;
+    }
+
+    debug_fp = fopen(instance_path("output.txt", "output.txt"), "w");
+
+    io_init();
+
+    //--------------------------------------------------------------------------
+
+    Verilated::commandArgs(argc, argv);
+
+    cpu    = new Vao486();
+    pic    = new Vpic();
+    pit    = new Vpit();
+    rtc    = new Vrtc();
+    ps2    = new Vps2();
+    floppy = new Vfloppy();
+    dma    = new Vdma();
+    vga    = new Vvga();
+    ide0   = new Vide();
+
+    cpu->cache_disable  = 0;
+
+    pit->clock_rate     = CLOCK_RATE;
+    rtc->clock_rate     = CLOCK_RATE;
+    floppy->clock_rate  = CLOCK_RATE;
+    vga->clock_rate_vga = CLOCK_RATE;
+
+    rtc->bootcfg        = 0;
+    floppy->wp          = 0;
+    ide0->use_fast      = 1;
+
+    ps2->ps2_kbclk      = 1;
+    ps2->ps2_kbdat      = 1;
+    ps2->ps2_mouseclk   = 1;
+    ps2->ps2_mousedat   = 1;
+
+    //reset
+    set_reset(0);
+    for(int i=0; i<16; i++) clock_cycle();
+    set_reset(1);
+
+    //--------------------------------------------------------------------------
+
+    uint64 cycle      = 0;
+    uint64 start_time = time_usec();
+
+    while(!Verilated::gotFinish()) {
+
+        io_cycle();
+        mem_cycle();
+
+        clock_cycle();
+        cycle++;
+
+        if((cycle % 1000000) == 0) printf("cycle: %lu\n", cycle);
+
+        if(max_cycles != 0 && cycle >= max_cycles) break;
+    }
+
+    uint64 elapsed = time_usec() - start_time;
+    printf("cycles: %lu, seconds: %.3f, cycles per second: %.0f\n", cycle, elapsed / 1000000.0, (elapsed > 0)? cycle * 1000000.0 / elapsed : 0.0);
+
+    cpu->final();
+
+    delete cpu;
+    delete pic;
+    delete pit;
+    delete rtc;
+    delete ps2;
+    delete floppy;
+    delete dma;
+    delete vga;
+    delete ide0;
+
+    fclose(debug_fp);
+    munmap(memory, sizeof(memory_t));
+
+    return 0;
+}
@@ -0,0 +1,475 @@
+#ifndef __DEVICE_H
+#define __DEVICE_H
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+
+#include "shared_mem.h"
+#include "idle.h"
+
+/* Common harness of the device plugins (soc/<device>/main_plugin.cpp).
+ *
+ * A plugin describes the avalon slaves of its model in a table of
+ * device_port_t: the io ports each one decodes, the model address of the
+ * first one, and the hooks driving its signals (DEVICE_PORT() and friends
+ * write them from the port prefix). device_open() maps the shared memory,
+ * registers the slot, claims the ports of the table and resets the model;
+ * each pass of the loop is then
+ *
+ *     device_io(dev);         the access handshake
+ *     ...                     irq and the other device specific signals
+ *     device_clock(dev);
+ *     device_wait(dev, timed);
+ *
+ * device_wait() blocks in io_wait() until the next access once the device
+ * has settled after the last one, unless the plugin says something is still
+ * timed; a running device paces its clocks with io_pace(). The plugin is
+ * counted in with io_ready() only after all its ports are claimed.
+ *
+ * Byte ports get one model access per enabled lane, lowest lane first: a
+ * write strobes and acks in the same pass, a read strobes and takes the data
+ * in the next one. Lanes of ports not in the table are dropped. A wide port
+ * (the 32-bit ide data port) gets the dword with its byteenable in one access,
+ * at model address base + (io_address - first) / 4.
+ *
+ * Tracing is off unless the plugin runs with --trace: <name>.vcd is then
+ * written from the first clock, and the plugin may toggle dev.dump itself.
+ * The file is flushed every DEVICE_FLUSH_CLOCKS clocks and closed by
+ * device_close(), so a stopped plugin leaves a complete dump.
+ *
+ * Every access is counted per port, with its latency in model clocks from
+ * the pass that saw the request to the ack, in log2 buckets. device_report()
+ * prints them and writes <name>_io.txt when the loop ends (SIGINT or SIGTERM
+ * included).
+ */
+
+//defined by the plugin
+extern volatile shared_mem_t *shared_ptr;
+
+//clock input of the model; the vga runs on clk_26
+#ifndef DEVICE_CLK
+#define DEVICE_CLK clk
+#endif
+
+#define DEVICE_PORT_MAX 8
+#define DEVICE_BUCKETS  12      //latency buckets: 0, 1, 2-3, 4-7, ..., >= 1024 clocks
+
+//clocks between two flushes of the vcd
+#ifndef DEVICE_FLUSH_CLOCKS
+#define DEVICE_FLUSH_CLOCKS (1 << 20)
+#endif
+
+template<class T>
+struct device_port_t {
+    const char *name;
+    uint32      first;          //io ports, inclusive
+    uint32      last;
+    uint32      base;           //model address of 'first'
+    bool        wide;
+
+    //drive one access: read or write strobe high, address and data set
+    void   (*access)(T *top, uint32 address, uint32 byteenable, uint32 data, bool is_write);
+    uint32 (*readdata)(T *top);
+    //both strobes low
+    void   (*release)(T *top);
+};
+
+//the hooks of an avalon slave '<port>_address/_read/_readdata/_write/_writedata'
+#define DEVICE_PORT(T, port)                                                                                        \
+    static void port##_access(T *top, uint32 address, uint32, uint32 data, bool is_write) {                        \
+        top->port##_address   = address;                                                                            \
+        top->port##_writedata = data;                                                                               \
+        top->port##_read      = is_write? 0 : 1;                                                                    \
+        top->port##_write     = is_write? 1 : 0;                                                                    \
+    }                                                                                                               \
+    static uint32 port##_readdata(T *top) { return top->port##_readdata; }                                          \
+    static void   port##_release(T *top)  { top->port##_read = 0; top->port##_write = 0; }
+
+//the same, with a byteenable input
+#define DEVICE_PORT_WIDE(T, port)                                                                                   \
+    static void port##_access(T *top, uint32 address, uint32 byteenable, uint32 data, bool is_write) {             \
+        top->port##_address    = address;                                                                           \
+        top->port##_byteenable = byteenable;                                                                        \
+        top->port##_writedata  = data;                                                                              \
+        top->port##_read       = is_write? 0 : 1;                                                                   \
+        top->port##_write      = is_write? 1 : 0;                                                                   \
+    }                                                                                                               \
+    static uint32 port##_readdata(T *top) { return top->port##_readdata; }                                          \
+    static void   port##_release(T *top)  { top->port##_read = 0; top->port##_write = 0; }
+
+//a single register, without address input
+#define DEVICE_PORT_SINGLE(T, port)                                                                                 \
+    static void port##_access(T *top, uint32, uint32, uint32 data, bool is_write) {                                \
+        top->port##_writedata = data;                                                                               \
+        top->port##_read      = is_write? 0 : 1;                                                                    \
+        top->port##_write     = is_write? 1 : 0;                                                                    \
+    }                                                                                                               \
+    static uint32 port##_readdata(T *top) { return top->port##_readdata; }                                          \
+    static void   port##_release(T *top)  { top->port##_read = 0; top->port##_write = 0; }
+
+#define DEVICE_HOOKS(port) port##_access, port##_readdata, port##_release
+
+struct device_stats_t {
+    uint64 reads;
+    uint64 writes;
+    uint64 clocks;              //sum of the latencies
+    uint64 max;
+    uint64 buckets[DEVICE_BUCKETS];
+};
+
+template<class T>
+struct device_t {
+    const char *name;
+
+    T                  *top;
+    volatile io_slot_t *io;
+
+    VerilatedVcdC *tracer;      //NULL without --trace
+    bool           dump;
+    uint64         cycle;       //dump timestamp, two per clock
+    uint64         flushed;     //cycle of the last flush
+
+    idle_t idle;
+
+    const device_port_t<T> *ports;
+    uint32                  port_count;
+    uint8                   decode[65536];  //port -> index + 1, 0 is not ours
+
+    //access in progress
+    int    port;                //stats index, -1 when none
+    uint32 lanes;               //lanes still to run
+    int    read_lane;           //lane read in the last clock, -1 when none
+    uint32 data;
+    uint64 start;
+
+    device_stats_t stats[DEVICE_PORT_MAX];
+};
+
+//------------------------------------------------------------------------------
+
+static volatile sig_atomic_t device_stop_requested = 0;
+
+static void device_stop_handler(int) {
+    device_stop_requested = 1;
+}
+
+static inline bool device_running() {
+    return !Verilated::gotFinish() && !device_stop_requested && shared_ptr->io_shutdown == 0;
+}
+
+//------------------------------------------------------------------------------
+
+template<class T>
+void device_clock(device_t<T> &dev) {
+    T *top = dev.top;
+
+    top->DEVICE_CLK = 0;
+    top->eval();
+    if(dev.dump && dev.tracer) dev.tracer->dump(dev.cycle);
+    dev.cycle++;
+
+    top->DEVICE_CLK = 1;
+    top->eval();
+    if(dev.dump && dev.tracer) dev.tracer->dump(dev.cycle);
+    dev.cycle++;
+
+    if(dev.tracer && dev.cycle - dev.flushed >= 2 * (uint64)DEVICE_FLUSH_CLOCKS) {
+        dev.tracer->flush();
+        dev.flushed = dev.cycle;
+    }
+
+    //strobes last one clock
+    for(uint32 i=0; i<dev.port_count; i++) dev.ports[i].release(top);
+
+    idle_clock(dev.idle, dev.io);
+}
+
+//idle_skip() with the dump timestamp kept in step
+template<class T>
+uint64 device_skip(device_t<T> &dev, uint64 clocks) {
+    uint64 done = idle_skip(dev.top, dev.io, dev.idle, clocks);
+    dev.cycle += 2 * done;
+    return done;
+}
+
+//no access half done and idle_ready()
+template<class T>
+bool device_idle(device_t<T> &dev) {
+    return dev.port < 0 && idle_ready(dev.idle, dev.io);
+}
+
+//between two passes: 'timed' when the model or the plugin still has something to do without an access
+template<class T>
+void device_wait(device_t<T> &dev, bool timed) {
+    if(timed == false && device_idle(dev)) io_wait(shared_ptr, dev.io);
+    else                                   io_pace(shared_ptr, dev.io);
+}
+
+//one clock with a management write; the model needs mgmt_address/_write/_writedata
+template<class T>
+void device_mgmt(device_t<T> &dev, uint32 address, uint32 data) {
+    dev.top->mgmt_address   = address;
+    dev.top->mgmt_writedata = data;
+    dev.top->mgmt_write     = 1;
+
+    device_clock(dev);
+
+    dev.top->mgmt_write = 0;
+}
+
+//------------------------------------------------------------------------------
+
+/* Returns 0, or the value for main() to return. The model is built here and
+ * taken through the reset sequence of the original harnesses.
+ */
+template<class T>
+int device_open(device_t<T> &dev, const char *name, const device_port_t<T> *ports, uint32 port_count, int argc, char **argv) {
+    memset(&dev, 0, sizeof(dev));
+    dev.name       = name;
+    dev.ports      = ports;
+    dev.port_count = port_count;
+    dev.port       = -1;
+    dev.read_lane  = -1;
+
+    if(port_count > DEVICE_PORT_MAX) {
+        fprintf(stderr, "%s: more than %d ports\n", name, DEVICE_PORT_MAX);
+        return -3;
+    }
+
+    bool trace = false;
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "--trace") == 0) trace = true;
+    }
+
+    //without SA_RESTART, so a signal ends an untimed io_wait()
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = device_stop_handler;
+    sigaction(SIGINT,  &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    //map shared memory
+    int fd = open(instance_path("shared_mem.dat", "./../../../sim_pc/shared_mem.dat"), O_RDWR, S_IRUSR | S_IWUSR);
+
+    if(fd == -1) {
+        perror("open() failed for shared_mem.dat");
+        return -1;
+    }
+
+    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if(shared_ptr == MAP_FAILED) {
+        perror("mmap() failed");
+        close(fd);
+        return -2;
+    }
+
+    dev.io = io_register(shared_ptr, name);
+    if(dev.io == NULL) {
+        fprintf(stderr, "io_register() failed: no free io slot\n");
+        return -3;
+    }
+
+    for(uint32 i=0; i<port_count; i++) {
+        io_claim(shared_ptr, dev.io, ports[i].first, ports[i].last);
+        for(uint32 port=ports[i].first; port<=ports[i].last; port++) dev.decode[port] = i + 1;
+    }
+    io_ready(shared_ptr);
+
+    Verilated::commandArgs(argc, argv);
+
+    if(trace) Verilated::traceEverOn(true);
+
+    dev.top = new T();
+    T *top = dev.top;
+
+    if(trace) {
+        char file[64];
+        snprintf(file, sizeof(file), "%s.vcd", name);
+
+        dev.tracer = new VerilatedVcdC;
+        top->trace(dev.tracer, 99);
+        dev.tracer->open(instance_path(file, file));
+        dev.dump = true;
+    }
+
+    //reset
+    top->DEVICE_CLK = 0; top->rst_n = 1; top->eval();
+    top->DEVICE_CLK = 1; top->rst_n = 1; top->eval();
+    top->DEVICE_CLK = 1; top->rst_n = 0; top->eval();
+    top->DEVICE_CLK = 0; top->rst_n = 0; top->eval();
+    top->DEVICE_CLK = 0; top->rst_n = 1; top->eval();
+
+    for(uint32 i=0; i<port_count; i++) ports[i].release(top);
+    return 0;
+}
+
+template<class T>
+void device_close(device_t<T> &dev) {
+    if(dev.tracer) {
+        dev.tracer->close();
+        delete dev.tracer;
+    }
+    delete dev.top;
+}
+
+//------------------------------------------------------------------------------
+
+static inline uint32 device_bucket(uint64 clocks) {
+    uint32 bucket = 0;
+    while(clocks != 0 && bucket < DEVICE_BUCKETS-1) {
+        clocks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+template<class T>
+static void device_finish(device_t<T> &dev) {
+    volatile io_slot_t *io = dev.io;
+    device_stats_t &stats  = dev.stats[dev.port];
+
+    uint64 clocks = dev.idle.clock - dev.start;
+
+    if(io->io_is_write) stats.writes++;
+    else                stats.reads++;
+
+    stats.clocks += clocks;
+    if(clocks > stats.max) stats.max = clocks;
+    stats.buckets[device_bucket(clocks)]++;
+
+    if(io->io_is_write == 0) io->io_data = dev.data;
+
+    dev.port      = -1;
+    dev.read_lane = -1;
+    io->io_step   = STEP_ACK;
+}
+
+//the handshake with the hub, once per clock
+template<class T>
+void device_io(device_t<T> &dev) {
+    volatile io_slot_t *io = dev.io;
+    T *top = dev.top;
+
+    if(io->io_step != STEP_REQ) return;
+
+    uint32 address    = io->io_address & 0xFFFC;
+    uint32 byteenable = io->io_byteenable & 0xF;
+
+    //new access: keep the lanes of our ports
+    if(dev.port < 0) {
+        uint32 lanes = 0;
+        int    first = -1;
+
+        for(uint32 lane=0; lane<4; lane++) {
+            if(((byteenable >> lane) & 1) == 0 || dev.decode[address + lane] == 0) continue;
+
+            lanes |= 1 << lane;
+            if(first < 0) first = dev.decode[address + lane] - 1;
+        }
+        if(first < 0) return;
+
+        dev.port      = first;
+        dev.lanes     = dev.ports[first].wide? 1 : lanes;
+        dev.read_lane = -1;
+        dev.data      = 0;
+        dev.start     = dev.idle.clock;
+    }
+
+    //data of the read strobed in the last clock
+    if(dev.read_lane >= 0) {
+        const device_port_t<T> &port = dev.ports[dev.port];
+        uint32 value = port.readdata(top);
+
+        if(port.wide) {
+            for(uint32 lane=0; lane<4; lane++) {
+                if(((byteenable >> lane) & 1) == 0) value &= ~(0xFFu << (8*lane));
+            }
+            dev.data = value;
+        }
+        else {
+            dev.data |= (value & 0xFF) << (8*dev.read_lane);
+        }
+        dev.read_lane = -1;
+    }
+
+    if(dev.lanes == 0) {
+        device_finish(dev);
+        return;
+    }
+
+    //next lane
+    uint32 lane = __builtin_ctz(dev.lanes);
+    dev.lanes &= dev.lanes - 1;
+
+    bool is_write = io->io_is_write != 0;
+
+    if(dev.ports[dev.port].wide) {
+        const device_port_t<T> &port = dev.ports[dev.port];
+        port.access(top, port.base + (address - port.first) / 4, byteenable, is_write? io->io_data : 0, is_write);
+    }
+    else {
+        const device_port_t<T> &port = dev.ports[dev.decode[address + lane] - 1];
+        port.access(top, port.base + (address + lane - port.first), 1 << lane, is_write? (io->io_data >> (8*lane)) & 0xFF : 0, is_write);
+    }
+
+    if(is_write) {
+        if(dev.lanes == 0) device_finish(dev);
+    }
+    else {
+        dev.read_lane = lane;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template<class T>
+static void device_report_to(device_t<T> &dev, FILE *fp) {
+    fprintf(fp, "%s: io accesses, latency in clocks\n", dev.name);
+    fprintf(fp, "%-12s %10s %10s %8s %6s |", "port", "reads", "writes", "avg", "max");
+    for(uint32 i=0; i<DEVICE_BUCKETS; i++) {
+        if(i == 0)                     fprintf(fp, " %7s", "0");
+        else if(i == DEVICE_BUCKETS-1) fprintf(fp, " %6d+", 1 << (i-1));
+        else                           fprintf(fp, " %7d", 1 << (i-1));
+    }
+    fprintf(fp, "\n");
+
+    for(uint32 i=0; i<dev.port_count; i++) {
+        const device_stats_t &stats = dev.stats[i];
+        uint64 count = stats.reads + stats.writes;
+
+        fprintf(fp, "%-12s %10llu %10llu %8.2f %6llu |", dev.ports[i].name, (unsigned long long)stats.reads, (unsigned long long)stats.writes,
+            (count == 0)? 0.0 : (double)stats.clocks / count, (unsigned long long)stats.max);
+        for(uint32 j=0; j<DEVICE_BUCKETS; j++) fprintf(fp, " %7llu", (unsigned long long)stats.buckets[j]);
+        fprintf(fp, "\n");
+    }
+    fprintf(fp, "clocks: %llu, skipped: %llu in %llu skips\n",
+        (unsigned long long)dev.idle.clock, (unsigned long long)dev.idle.skipped, (unsigned long long)dev.idle.skips);
+}
+
+template<class T>
+void device_report(device_t<T> &dev) {
+    device_report_to(dev, stdout);
+
+    char file[64];
+    snprintf(file, sizeof(file), "%s_io.txt", dev.name);
+
+    FILE *fp = fopen(instance_path(file, file), "w");
+    if(fp == NULL) return;
+
+    device_report_to(dev, fp);
+    fclose(fp);
+}
+
+#endif //__DEVICE_H
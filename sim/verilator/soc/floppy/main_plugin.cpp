@@ -3,17 +3,12 @@
 
 #include <dlfcn.h>
 
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-
 #include "Vfloppy.h"
+#include "Vfloppy___024root.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#include "device.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -25,46 +20,45 @@ volatile shared_mem_t *shared_ptr = NULL;
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
-//------------------------------------------------------------------------------
+#define FLOPPY floppy__DOT__
 
-int main(int argc, char **argv) {
-    //map shared memory
-    int fd = open("./../../../sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
-    
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
-        return -1;
-    }
-    
-    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    
-    if(shared_ptr == MAP_FAILED) {
-        perror("mmap() failed");
-        close(fd);
-        return -2;
-    }
-    
-    Verilated::commandArgs(argc, argv);
+//S_IDLE, see floppy.v
+#define FLOPPY_STATE_IDLE 0
+
+/* Outside of a command the only timed thing is a recalibrate or seek: every
+ * step rate period decrements delay_srt, then delay_steps, and the last one
+ * raises the interrupt. A period is clk_rate / delay_adder_r clocks or more.
+ */
+static uint64 floppy_horizon(Vfloppy *top) {
+    if(IDLE_SIGNAL(FLOPPY, state) != FLOPPY_STATE_IDLE) return 0;
     
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
+    uint32 periods = IDLE_SIGNAL(FLOPPY, delay_srt) + IDLE_SIGNAL(FLOPPY, delay_steps);
     
-    Vfloppy *top = new Vfloppy();
-    top->trace (tracer, 99);
-    //tracer->rolloverMB(1000000);
-    tracer->open("floppy.vcd");
+    if(periods == 0 && IDLE_SIGNAL(FLOPPY, delay_rate) == 0) return IDLE_NEVER;
+    if(periods <= 1) return 0;
     
-    bool dump = false;
+    return idle_clocks(periods - 1, IDLE_SIGNAL(FLOPPY, clk_rate), IDLE_SIGNAL(FLOPPY, delay_adder_r));
+}
+
+//------------------------------------------------------------------------------
+
+//3F6h belongs to the hdd
+DEVICE_PORT(Vfloppy, io)
+
+static const device_port_t<Vfloppy> floppy_ports[] = {
+    { "io 3f0h", 0x03F0, 0x03F5, 0, false, DEVICE_HOOKS(io) },
+    { "io 3f7h", 0x03F7, 0x03F7, 7, false, DEVICE_HOOKS(io) },
+};
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    static device_t<Vfloppy> dev;
     
-    //reset
-    top->clk = 0; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 1; top->eval();
+    int result = device_open(dev, "floppy", floppy_ports, 2, argc, argv);
+    if(result != 0) return result;
     
-    uint64 cycle = 0;
-    bool read_cycle = false;
+    Vfloppy *top = dev.top;
     
     /*
     0x00.[0]:      media present
@@ -134,10 +128,7 @@ int main(int argc, char **argv) {
                                 0x20;
 
     for(uint32 i=0; i<13; i++) {
-        
-        top->mgmt_address = 0;
-        top->mgmt_write = 1;
-        top->mgmt_writedata =
+        device_mgmt(dev, 0,
             (i==0)?     (floppy_index >= 0?   1 : 0) :
             (i==1)?     (floppy_writeprotect? 1 : 0) :
             (i==2)?     floppy_cylinders :
@@ -150,111 +141,30 @@ int main(int argc, char **argv) {
             (i==9)?     1666 : //wait rate 1: 1666us
             (i==10)?    2000 : //wait rate 2: 2000us
             (i==11)?    500  : //wait rate 3 : 500us
-                        floppy_media;
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+                        floppy_media);
     }
-    top->mgmt_write = 0;
     
     printf("floppy main_plugin.cpp\n");
-    while(!Verilated::gotFinish()) {
     
-        //----------------------------------------------------------------------
-        
-        /*
-        uint32 combined.io_address;
-        uint32 combined.io_data;
-        uint32 combined.io_byteenable;
-        uint32 combined.io_is_write;
-        step_t combined.io_step;
+    while(device_running()) {
         
-        //avalon slave 3f0-3f8
-        input       [2:0]   io_address,
-        input               io_read,
-        output reg  [7:0]   io_readdata,
-        input               io_write,
-        input       [7:0]   io_writedata,
-        */
+        //---------------------------------------------------------------------- idle skip
         
-        top->io_read      = 0;
-        top->io_write     = 0;
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && (shared_ptr->combined.io_address == 0x03F0 || shared_ptr->combined.io_address == 0x03F4) &&
-            (shared_ptr->combined.io_address == 0x03F0 || ((shared_ptr->combined.io_byteenable >> 2) & 1) == 0))
-        {
-            if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                printf("Vfloppy: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                exit(-1);
-            }
+        if(device_idle(dev)) {
+            uint64 horizon = floppy_horizon(top);
             
-            top->io_address    = (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                                                                                                             7;
-            top->io_writedata  = (shared_ptr->combined.io_byteenable == 1)?     shared_ptr->combined.io_data & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 2)?     (shared_ptr->combined.io_data >> 8) & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 4)?     (shared_ptr->combined.io_data >> 16) & 0xFF :
-                                                                                (shared_ptr->combined.io_data >> 24) & 0xFF;
-            top->io_read  = 0;
-            top->io_write = 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-        
-        if(read_cycle == false) {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && (shared_ptr->combined.io_address == 0x03F0 || shared_ptr->combined.io_address == 0x03F4) &&
-                (shared_ptr->combined.io_address == 0x03F0 || ((shared_ptr->combined.io_byteenable >> 2) & 1) == 0))
-            {
-                if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                    printf("Vfloppy: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                    exit(-1);
-                }
-                
-                top->io_address= (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x03F0 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                                                                                                             7;
-                top->io_writedata  = 0;
-                
-                top->io_read  = 1;
-                top->io_write = 0;
-                
-                read_cycle = true;
+            if(horizon == IDLE_NEVER) {
+                io_wait(shared_ptr, dev.io);
+                continue;
             }
-        }
-        else {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && (shared_ptr->combined.io_address == 0x03F0 || shared_ptr->combined.io_address == 0x03F4) &&
-                (shared_ptr->combined.io_address == 0x03F0 || ((shared_ptr->combined.io_byteenable >> 2) & 1) == 0))
-            {
-                uint32 val = top->io_readdata;
-                
-                if(shared_ptr->combined.io_byteenable & 1) val <<= 0;
-                if(shared_ptr->combined.io_byteenable & 2) val <<= 8;
-                if(shared_ptr->combined.io_byteenable & 4) val <<= 16;
-                if(shared_ptr->combined.io_byteenable & 8) val <<= 24;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
+            if(horizon >= IDLE_MIN) {
+                device_skip(dev, horizon);
+                continue;
             }
         }
         
+        device_io(dev);
+        
         //----------------------------------------------------------------------
         
         if(top->irq) {
@@ -297,21 +207,12 @@ int main(int argc, char **argv) {
         
         //----------------------------------------------------------------------
         
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_clock(dev);
         
-        usleep(1);
+        io_pace(shared_ptr, dev.io);
     }
-    tracer->close();
-    delete tracer;
-    delete top;
+    device_report(dev);
+    device_close(dev);
     
     return 0;
 }
@@ -3,17 +3,11 @@
 
 #include <dlfcn.h>
 
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-
 #include "Vhdd.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#include "device.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -133,44 +127,22 @@ uint32 sd_command;
 bool sd_mutex = false;
 uint32 sd_waiting = 0;
 
+//1F0h-1F7h as two dwords: data port and task file
+DEVICE_PORT_WIDE(Vhdd, io)
+DEVICE_PORT_SINGLE(Vhdd, ide_3f6)
+
+static const device_port_t<Vhdd> hdd_ports[] = {
+    { "io 1f0h",  0x01F0, 0x01F7, 0, true,  DEVICE_HOOKS(io) },
+    { "ide 3f6h", 0x03F6, 0x03F6, 0, false, DEVICE_HOOKS(ide_3f6) },
+};
+
 int main(int argc, char **argv) {
-    //map shared memory
-    int fd = open("./../../../sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
-    
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
-        return -1;
-    }
-    
-    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    
-    if(shared_ptr == MAP_FAILED) {
-        perror("mmap() failed");
-        close(fd);
-        return -2;
-    }
-    
-    Verilated::commandArgs(argc, argv);
-    
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
-    
-    Vhdd *top = new Vhdd();
-    top->trace (tracer, 99);
-    //tracer->rolloverMB(1000000);
-    tracer->open("hdd.vcd");
+    static device_t<Vhdd> dev;
     
-    bool dump = false;
+    int result = device_open(dev, "hdd", hdd_ports, 2, argc, argv);
+    if(result != 0) return result;
     
-    //reset
-    top->clk = 0; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 1; top->eval();
-    
-    uint64 cycle = 0;
-    bool read_cycle = false;
+    Vhdd *top = dev.top;
     
     /*
     0x00.[31:0]:    identify write
@@ -183,137 +155,17 @@ int main(int argc, char **argv) {
     */
     
     for(uint32 i=0; i<128; i++) {
-        
-        top->mgmt_address = 0;
-        top->mgmt_write = 1;
-        top->mgmt_writedata = ((unsigned int)identify[2*i+1] << 16) | (unsigned int)identify[2*i+0];
-        
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_mgmt(dev, 0, ((unsigned int)identify[2*i+1] << 16) | (unsigned int)identify[2*i+0]);
     }
     
     for(uint32 i=0; i<6; i++) {
-        top->mgmt_address = i+1;
-        top->mgmt_write   = 1;
-        top->mgmt_writedata = (i==0)? hd_cylinders : (i==1)? hd_heads : (i==2)? hd_spt : (i==3)? hd_heads * hd_spt : (i==4)? hd_total_sectors : 0;
-        
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_mgmt(dev, i+1, (i==0)? hd_cylinders : (i==1)? hd_heads : (i==2)? hd_spt : (i==3)? hd_heads * hd_spt : (i==4)? hd_total_sectors : 0);
     }
-    top->mgmt_write = 0;
     
     printf("hdd main_plugin.cpp\n");
-    while(!Verilated::gotFinish()) {
-    
-        //----------------------------------------------------------------------
-        
-        /*
-        uint32 combined.io_address;
-        uint32 combined.io_data;
-        uint32 combined.io_byteenable;
-        uint32 combined.io_is_write;
-        step_t combined.io_step;
-        
-        //avalon slave
-        input               io_address,
-        input       [3:0]   io_byteenable,
-        input               io_read,
-        output reg  [31:0]  io_readdata,
-        input               io_write,
-        input       [31:0]  io_writedata, 
-        
-        //ide shared port 0x3F6
-        input               ide_3f6_read,
-        output reg  [7:0]   ide_3f6_readdata,
-        input               ide_3f6_write,
-        input       [7:0]   ide_3f6_writedata,
-        */
-        
-        top->io_read      = 0;
-        top->io_write     = 0;
-        
-        top->ide_3f6_read = 0;
-        top->ide_3f6_write= 0;
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && (shared_ptr->combined.io_address == 0x01F0 || shared_ptr->combined.io_address == 0x01F4)) {
-            top->io_address    = (shared_ptr->combined.io_address == 0x01F0)? 0 : 1;
-            top->io_byteenable = shared_ptr->combined.io_byteenable;
-            top->io_writedata  = shared_ptr->combined.io_data;
-            
-            top->io_read  = 0;
-            top->io_write = 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-            
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 0x4) {
-            top->ide_3f6_writedata = (shared_ptr->combined.io_data >> 16) & 0xFF;
-            
-            top->ide_3f6_read = 0;
-            top->ide_3f6_write= 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
+    while(device_running()) {
         
-        if(read_cycle == false) {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && (shared_ptr->combined.io_address == 0x01F0 || shared_ptr->combined.io_address == 0x01F4)) {
-                top->io_address    = (shared_ptr->combined.io_address == 0x01F0)? 0 : 1;
-                top->io_byteenable = shared_ptr->combined.io_byteenable;
-                top->io_writedata  = 0;
-                
-                top->io_read  = 1;
-                top->io_write = 0;
-                
-                read_cycle = true;
-            }
-            
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 0x4) {
-                top->ide_3f6_writedata = 0;
-                
-                top->ide_3f6_read = 1;
-                top->ide_3f6_write= 0;
-                
-                read_cycle = true;
-            }
-        }
-        else {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && (shared_ptr->combined.io_address == 0x01F0 || shared_ptr->combined.io_address == 0x01F4)) {
-                uint32 val = top->io_readdata;
-                
-                if((shared_ptr->combined.io_byteenable & 1) == 0) val &= 0xFFFFFF00;
-                if((shared_ptr->combined.io_byteenable & 2) == 0) val &= 0xFFFF00FF;
-                if((shared_ptr->combined.io_byteenable & 4) == 0) val &= 0xFF00FFFF;
-                if((shared_ptr->combined.io_byteenable & 8) == 0) val &= 0x00FFFFFF;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
-            }
-            
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x03F4 && shared_ptr->combined.io_byteenable == 0x4) {
-                uint32 val = (top->ide_3f6_readdata & 0xFF) << 16;
-                
-                shared_ptr->combined.io_data = val;
-                
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
-            }
-        }
+        device_io(dev);
         
         //----------------------------------------------------------------------
         
@@ -366,30 +218,14 @@ printf("sd_master %08x %08x\n", top->sd_master_address, top->sd_master_writedata
                     top->sd_slave_write = 1;
                     top->sd_slave_writedata = val;
                     
-                    top->clk = 0;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    top->clk = 1;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    tracer->flush();
+                    device_clock(dev);
                 }
                 
                 top->sd_slave_write = 0;
                 sd_command = 0;
                 
                 for(uint32 i=0; i<30; i++) {
-                    top->clk = 0;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    top->clk = 1;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    tracer->flush();
+                    device_clock(dev);
                 }
                 
                 fclose(fp);
@@ -405,15 +241,7 @@ printf("sd_master %08x %08x\n", top->sd_master_address, top->sd_master_writedata
                     
                     top->sd_slave_read = (wait == false)? 1 : 0;
                     
-                    top->clk = 0;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    top->clk = 1;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    tracer->flush();
+                    device_clock(dev);
                     
                     if(wait) {
                         wait = (wait == false)? true : false;
@@ -434,15 +262,7 @@ printf("sd_master %08x %08x\n", top->sd_master_address, top->sd_master_writedata
                 sd_command = 0;
                 
                 for(uint32 i=0; i<30; i++) {
-                    top->clk = 0;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    top->clk = 1;
-                    top->eval();
-                    if(dump) tracer->dump(cycle++);
-                    
-                    tracer->flush();
+                    device_clock(dev);
                 }
                 
                 fclose(fp);
@@ -451,21 +271,12 @@ printf("sd_master %08x %08x\n", top->sd_master_address, top->sd_master_writedata
         
         //----------------------------------------------------------------------
         
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_clock(dev);
         
-        usleep(10);
+        device_wait(dev, sd_command != 0);
     }
-    tracer->close();
-    delete tracer;
-    delete top;
+    device_report(dev);
+    device_close(dev);
     
     return 0;
 }
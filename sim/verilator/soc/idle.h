@@ -0,0 +1,81 @@
+#ifndef __IDLE_H
+#define __IDLE_H
+
+#include "shared_mem.h"
+
+/* Idle skipping for the timer bound device plugins (pit, rtc, ps2, floppy).
+ *
+ * Between two io accesses the hub only sees a device through its irq line.
+ * When no access is pending, the plugin asks its model for the clocks until
+ * the next edge the irq line can make (a counter reaching its reload value,
+ * the next periodic or update interrupt of the rtc, the end of a seek) and
+ * runs them in one go with idle_skip(): no trace dump, no flush, no irq
+ * publication and no io_wait() per clock.
+ *
+ * The model is still clocked every cycle, so its state stays exact; the
+ * horizons only have to be lower bounds. An access that arrives during a
+ * skip ends it at the next poll. A model that has nothing timed left
+ * (IDLE_NEVER) is not clocked at all until the next access.
+ *
+ * The signals the horizons read are marked verilator public_flat_rd in
+ * rtl/soc; the main_plugin.cpp including this needs V<model>___024root.h.
+ */
+
+#define IDLE_SETTLE 1024        //clocks after an access before skipping: writes and reloads take effect
+#define IDLE_MIN    64          //shorter horizons stay in the normal loop
+#define IDLE_MAX    (1 << 20)   //clocks in one skip
+#define IDLE_POLL   256         //clocks between two looks at the io slot
+
+#define IDLE_NEVER  0xFFFFFFFFFFFFFFFFULL
+
+#define IDLE_PASTE(prefix, name) prefix##name
+#define IDLE_SIGNAL(prefix, name) top->rootp->IDLE_PASTE(prefix, name)
+
+struct idle_t {
+    uint64 clock;       //clocks run
+    uint64 last_io;     //clock of the last io access
+    uint64 skipped;     //clocks run by idle_skip()
+    uint64 skips;
+};
+
+//once per clock of the normal loop
+static inline void idle_clock(idle_t &idle, volatile io_slot_t *io) {
+    idle.clock++;
+    if(io->io_step != STEP_IDLE) idle.last_io = idle.clock;
+}
+
+static inline bool idle_ready(const idle_t &idle, volatile io_slot_t *io) {
+    return io->io_step == STEP_IDLE && idle.clock - idle.last_io >= IDLE_SETTLE;
+}
+
+//lower bound of clocks in 'ticks' periods of an enable generated by adding 'increment' per clock up to 'clk_rate'
+static inline uint64 idle_clocks(uint64 ticks, uint64 clk_rate, uint64 increment) {
+    if(increment == 0) return 0;
+    return ticks * (clk_rate / increment);
+}
+
+//runs up to 'clocks' clocks; returns the clocks run
+template<class T>
+uint64 idle_skip(T *top, volatile io_slot_t *io, idle_t &idle, uint64 clocks) {
+    if(clocks > IDLE_MAX) clocks = IDLE_MAX;
+
+    uint64 done = 0;
+    while(done < clocks) {
+        if((done % IDLE_POLL) == 0 && io->io_step != STEP_IDLE) break;
+
+        top->clk = 0;
+        top->eval();
+
+        top->clk = 1;
+        top->eval();
+
+        done++;
+    }
+
+    idle.clock   += done;
+    idle.skipped += done;
+    idle.skips++;
+    return done;
+}
+
+#endif //__IDLE_H
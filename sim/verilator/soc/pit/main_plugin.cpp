@@ -3,17 +3,12 @@
 
 #include <dlfcn.h>
 
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-
 #include "Vpit.h"
+#include "Vpit___024root.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#include "device.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -27,180 +22,76 @@ volatile shared_mem_t *shared_ptr = NULL;
 
 //------------------------------------------------------------------------------
 
+#define PIT_COUNTER_0 pit__DOT__pit_counter_0__DOT__
+
+//26250000 = 11 * (2 * pit clock), see pit.v
+#define PIT_INCREMENT 26250000
+
+/* Clocks until irq (counter 0 out) can change: the counter reaching 2 in
+ * mode 2, its terminal count in mode 3 (counting by 2), 1 in the others. The
+ * pit clock is two enables of the accumulator in pit.v. A bcd count stays in
+ * the normal loop.
+ */
+static uint64 pit_horizon(Vpit *top) {
+    if(IDLE_SIGNAL(PIT_COUNTER_0, bcd)) return 0;
+
+    uint32 mode    = IDLE_SIGNAL(PIT_COUNTER_0, mode) & 3;
+    uint32 counter = IDLE_SIGNAL(PIT_COUNTER_0, counter);
+    uint32 count   = (counter == 0)? 0x10000 : counter;
+
+    uint32 ticks = (mode == 2)? ((count > 2)? count - 2 : 0) :
+                   (mode == 3)? ((count > 2)? (count - 2) / 2 : 0) :
+                                ((count > 1)? count - 1 : 0);
+
+    //margin for the enable phase and the edge detection
+    if(ticks <= 2) return 0;
+    return idle_clocks(ticks - 2, top->rootp->pit__DOT__clk_rate, PIT_INCREMENT) * 2;
+}
+
+DEVICE_PORT(Vpit, io)
+DEVICE_PORT_SINGLE(Vpit, speaker_61h)
+
+static const device_port_t<Vpit> pit_ports[] = {
+    { "io 40h",      0x0040, 0x0043, 0, false, DEVICE_HOOKS(io) },
+    { "speaker 61h", 0x0061, 0x0061, 0, false, DEVICE_HOOKS(speaker_61h) },
+};
+
+//------------------------------------------------------------------------------
+
 int main(int argc, char **argv) {
+    static device_t<Vpit> dev;
     
-    //map shared memory
-    int fd = open("./../../../sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
+    int result = device_open(dev, "pit", pit_ports, 2, argc, argv);
+    if(result != 0) return result;
     
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
-        return -1;
-    }
-    
-    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    
-    if(shared_ptr == MAP_FAILED) {
-        perror("mmap() failed");
-        close(fd);
-        return -2;
-    }
-    
-    Verilated::commandArgs(argc, argv);
-    
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
-    
-    Vpit *top = new Vpit();
-    top->trace (tracer, 99);
-    //tracer->rolloverMB(1000000);
-    tracer->open("pit.vcd");
-    
-    //reset
-    top->clk = 0; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 1; top->eval();
-    
-    bool dump = false;
-    uint64 cycle = 0;
-    bool read_cycle = false;
+    Vpit *top = dev.top;
     
     int CYCLES_IN_SYSCLOCK = 2;
     
     /*
     0.[7:0]: cycles in sysclock 1193181 Hz
     */
-    top->mgmt_address = 0;
-    top->mgmt_write   = 1;
-    top->mgmt_writedata = CYCLES_IN_SYSCLOCK;
-    
-    top->clk = 0;
-    top->eval();
-    cycle++; if(dump) tracer->dump(cycle);
-    
-    top->clk = 1;
-    top->eval();
-    cycle++; if(dump) tracer->dump(cycle);
-    
-    tracer->flush();
-    top->mgmt_write = 0;
+    device_mgmt(dev, 0, CYCLES_IN_SYSCLOCK);
     
     printf("pit main_plugin.cpp\n");
     
     int sleep_counter = 0;
     
-    while(!Verilated::gotFinish()) {
-        
-        /*
-        uint32 combined.io_address;
-        uint32 combined.io_data;
-        uint32 combined.io_byteenable;
-        uint32 combined.io_is_write;
-        step_t combined.io_step;
+    while(device_running()) {
         
-        //io slave 040h-043h
-        input       [1:0]   io_address,
-        input               io_read,
-        output reg  [7:0]   io_readdata,
-        input               io_write,
-        input       [7:0]   io_writedata,
+        //---------------------------------------------------------------------- idle skip
         
-        //speaker port 61h
-        input               speaker_61h_read,
-        output      [7:0]   speaker_61h_readdata,
-        input               speaker_61h_write,
-        input       [7:0]   speaker_61h_writedata,
-        */
-        
-        top->io_read      = 0;
-        top->io_write     = 0;
-        
-        top->speaker_61h_read = 0;
-        top->speaker_61h_write= 0;
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && shared_ptr->combined.io_address == 0x0040) {
-            if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                printf("Vpit: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                exit(-1);
-            }
-
-            top->io_address    = (shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_byteenable == 4)?     2 :
-                                                                                3;
-            top->io_writedata  = (shared_ptr->combined.io_byteenable == 1)?     shared_ptr->combined.io_data & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 2)?     (shared_ptr->combined.io_data >> 8) & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 4)?     (shared_ptr->combined.io_data >> 16) & 0xFF :
-                                                                                (shared_ptr->combined.io_data >> 24) & 0xFF;
-            top->io_read  = 0;
-            top->io_write = 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-            
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 0x2) {
-            top->speaker_61h_writedata = (shared_ptr->combined.io_data >> 8) & 0xFF;
-            
-            top->speaker_61h_read = 0;
-            top->speaker_61h_write= 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-        
-        if(read_cycle == false) {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0040) {
-                if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                    printf("Vpit: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                    exit(-1);
-                }
-                
-                top->io_address = (shared_ptr->combined.io_byteenable == 1)?     0 :
-                                  (shared_ptr->combined.io_byteenable == 2)?     1 :
-                                  (shared_ptr->combined.io_byteenable == 4)?     2 :
-                                                                                 3;
-                top->io_writedata  = 0;
-                
-                top->io_read  = 1;
-                top->io_write = 0;
-                
-                read_cycle = true;
-            }
+        if(device_idle(dev)) {
+            uint64 horizon = pit_horizon(top);
             
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 0x2) {
-                top->speaker_61h_writedata = 0;
-                
-                top->speaker_61h_read = 1;
-                top->speaker_61h_write= 0;
-                
-                read_cycle = true;
-            }
-        }
-        else {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0040) {
-                uint32 val = top->io_readdata;
-                
-                if(shared_ptr->combined.io_byteenable & 1) val <<= 0;
-                if(shared_ptr->combined.io_byteenable & 2) val <<= 8;
-                if(shared_ptr->combined.io_byteenable & 4) val <<= 16;
-                if(shared_ptr->combined.io_byteenable & 8) val <<= 24;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
-            }
-            
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 0x2) {
-                uint32 val = top->speaker_61h_readdata << 8;
-                
-                shared_ptr->combined.io_data = val;
-                
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
+            if(horizon >= IDLE_MIN) {
+                device_skip(dev, horizon);
+                continue;
             }
         }
         
+        device_io(dev);
+        
         //----------------------------------------------------------------------
         
         if(top->irq) {
@@ -211,28 +102,14 @@ int main(int argc, char **argv) {
         }
         
         //----------------------------------------------------------------------
-
-//if((cycle % 5000) == 0) printf("-- %d\n", cycle);
-        
-        
-        //----------------------------------------------------------------------
-        
-        top->clk = 0;
-        top->eval();
-        cycle++; if(dump) tracer->dump(cycle);
-        
-        top->clk = 1;
-        top->eval();
-        cycle++; if(dump) tracer->dump(cycle);
         
-        tracer->flush();
+        device_clock(dev);
         
         sleep_counter++;
-        if((sleep_counter % 20) == 0) usleep(1);
+        if((sleep_counter % 20) == 0) io_pace(shared_ptr, dev.io);
     }
-    tracer->close();
-    delete tracer;
-    delete top;
+    device_report(dev);
+    device_close(dev);
     
     return 0;
 }
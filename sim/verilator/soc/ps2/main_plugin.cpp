@@ -3,17 +3,12 @@
 
 #include <dlfcn.h>
 
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-
 #include "Vps2.h"
+#include "Vps2___024root.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#include "device.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -27,6 +22,11 @@ volatile shared_mem_t *shared_ptr = NULL;
 
 #define SEND_BUF_LIMIT 5
 
+#define PS2 ps2__DOT__
+
+//PS2_IDLE, see ps2.v
+#define PS2_STATE_IDLE 0
+
 int kb_send[SEND_BUF_LIMIT];
 int kb_send_count = 0;
 
@@ -221,46 +221,27 @@ void proceed_ps2(int &index, int &waiting, int &wait_limit, int &recv_byte, bool
 }
 
 
+//------------------------------------------------------------------------------
+
+//61h belongs to the pit
+DEVICE_PORT(Vps2, io)
+DEVICE_PORT(Vps2, sysctl)
+
+static const device_port_t<Vps2> ps2_ports[] = {
+    { "io 60h",     0x0060, 0x0060, 0, false, DEVICE_HOOKS(io) },
+    { "io 62h",     0x0062, 0x0067, 2, false, DEVICE_HOOKS(io) },
+    { "sysctl 90h", 0x0090, 0x009F, 0, false, DEVICE_HOOKS(sysctl) },
+};
+
 //------------------------------------------------------------------------------
 
 int main(int argc, char **argv) {
+    static device_t<Vps2> dev;
     
-    //map shared memory
-    int fd = open("./../../../sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
-    
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
-        return -1;
-    }
-    
-    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int result = device_open(dev, "ps2", ps2_ports, 3, argc, argv);
+    if(result != 0) return result;
     
-    if(shared_ptr == MAP_FAILED) {
-        perror("mmap() failed");
-        close(fd);
-        return -2;
-    }
-    
-    Verilated::commandArgs(argc, argv);
-    
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
-    
-    Vps2 *top = new Vps2();
-    top->trace (tracer, 99);
-    //tracer->rolloverMB(1000000);
-    tracer->open("ps2.vcd");
-    
-    //reset
-    top->clk = 0; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 1; top->eval();
-    
-    bool dump = false;
-    uint64 cycle = 0;
-    bool read_cycle = false;
+    Vps2 *top = dev.top;
     
     printf("ps2 main_plugin.cpp\n");
     
@@ -290,7 +271,22 @@ int main(int argc, char **argv) {
     
     int a20_last = 1;
     
-    while(!Verilated::gotFinish()) {
+    while(device_running()) {
+        
+        //---------------------------------------------------------------------- idle skip
+        
+        /* With both channels idle on the controller side and on the lines here,
+         * nothing in the model is timed: it waits for the next access unclocked.
+         */
+        bool lines_idle = kb_is_recv == false && ms_is_recv == false && kb_send_count == 0 && mouse_send_count == 0 &&
+                          kb_clk_hold == false && kb_dat_hold == false && ms_clk_hold == false && ms_dat_hold == false;
+        
+        if(lines_idle && device_idle(dev) &&
+            IDLE_SIGNAL(PS2, keyb_state) == PS2_STATE_IDLE && IDLE_SIGNAL(PS2, mouse_state) == PS2_STATE_IDLE)
+        {
+            io_wait(shared_ptr, dev.io);
+            continue;
+        }
         
         //test
         /*
@@ -322,188 +318,7 @@ int main(int argc, char **argv) {
             top->v__DOT__ps2_mousedat_out,
             true);
         
-        /*
-        uint32 combined.io_address;
-        uint32 combined.io_data;
-        uint32 combined.io_byteenable;
-        uint32 combined.io_is_write;
-        step_t combined.io_step;
-        
-        //io slave 0x60-0x67
-        input       [2:0]       io_address,
-        input                   io_read,
-        output reg  [7:0]       io_readdata,
-        input                   io_write,
-        input       [7:0]       io_writedata,
-        
-        //io slave 0x90-0x9F
-        input       [3:0]       sysctl_address,
-        input                   sysctl_read,
-        output reg  [7:0]       sysctl_readdata,
-        input                   sysctl_write,
-        input       [7:0]       sysctl_writedata,
-        */
-        
-        top->io_read      = 0;
-        top->io_write     = 0;
-        
-        top->sysctl_read  = 0;
-        top->sysctl_write = 0;
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write &&
-            ((shared_ptr->combined.io_address == 0x0060 && ((shared_ptr->combined.io_byteenable >> 1) & 1) == 0) || shared_ptr->combined.io_address == 0x0064))
-        {
-            if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                printf("Vps2 0x60: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                exit(-1);
-            }
-
-            top->io_address    = (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                                                                                                             7;
-                                 
-            top->io_writedata  = (shared_ptr->combined.io_byteenable == 1)?     shared_ptr->combined.io_data & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 2)?     (shared_ptr->combined.io_data >> 8) & 0xFF :
-                                 (shared_ptr->combined.io_byteenable == 4)?     (shared_ptr->combined.io_data >> 16) & 0xFF :
-                                                                                (shared_ptr->combined.io_data >> 24) & 0xFF;
-            top->io_read  = 0;
-            top->io_write = 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write &&
-            (shared_ptr->combined.io_address == 0x0090 || shared_ptr->combined.io_address == 0x0094 || shared_ptr->combined.io_address == 0x0098 || shared_ptr->combined.io_address == 0x009C))
-        {
-            if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                printf("Vps2 0x90: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                exit(-1);
-            }
-
-            top->sysctl_address= (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 8)?     7 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 1)?     8 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 2)?     9 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 4)?     10 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 8)?     11 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 1)?     12 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 2)?     13 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 4)?     14 :
-                                                                                                                             15;
-                                 
-            top->sysctl_writedata = (shared_ptr->combined.io_byteenable == 1)?     shared_ptr->combined.io_data & 0xFF :
-                                    (shared_ptr->combined.io_byteenable == 2)?     (shared_ptr->combined.io_data >> 8) & 0xFF :
-                                    (shared_ptr->combined.io_byteenable == 4)?     (shared_ptr->combined.io_data >> 16) & 0xFF :
-                                                                                   (shared_ptr->combined.io_data >> 24) & 0xFF;
-            top->sysctl_read  = 0;
-            top->sysctl_write = 1;
-            
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-        
-        
-        if(read_cycle == false) {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 &&
-                ((shared_ptr->combined.io_address == 0x0060 && ((shared_ptr->combined.io_byteenable >> 1) & 1) == 0) || shared_ptr->combined.io_address == 0x0064))
-            {
-                if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                    printf("Vps2 0x60: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                    exit(-1);
-                }
-                
-                top->io_address= (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x0060 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x0064 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                                                                                                             7;
-                top->io_writedata  = 0;
-                
-                top->io_read  = 1;
-                top->io_write = 0;
-                
-                read_cycle = true;
-            }
-            
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 &&
-                (shared_ptr->combined.io_address == 0x0090 || shared_ptr->combined.io_address == 0x0094 || shared_ptr->combined.io_address == 0x0098 || shared_ptr->combined.io_address == 0x009C))
-            {
-                if(shared_ptr->combined.io_byteenable != 1 && shared_ptr->combined.io_byteenable != 2 && shared_ptr->combined.io_byteenable != 4 && shared_ptr->combined.io_byteenable != 8) {
-                    printf("Vps2 0x90: combined.io_byteenable invalid: %x\n", shared_ptr->combined.io_byteenable);
-                    exit(-1);
-                }
-                
-                top->sysctl_address= (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 1)?     0 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 2)?     1 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 4)?     2 :
-                                 (shared_ptr->combined.io_address == 0x0090 && shared_ptr->combined.io_byteenable == 8)?     3 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 1)?     4 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 2)?     5 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 4)?     6 :
-                                 (shared_ptr->combined.io_address == 0x0094 && shared_ptr->combined.io_byteenable == 8)?     7 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 1)?     8 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 2)?     9 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 4)?     10 :
-                                 (shared_ptr->combined.io_address == 0x0098 && shared_ptr->combined.io_byteenable == 8)?     11 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 1)?     12 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 2)?     13 :
-                                 (shared_ptr->combined.io_address == 0x009C && shared_ptr->combined.io_byteenable == 4)?     14 :
-                                                                                                                             15;
-                top->sysctl_writedata  = 0;
-                
-                top->sysctl_read  = 1;
-                top->sysctl_write = 0;
-                
-                read_cycle = true;
-            }
-        }
-        else {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 &&
-                ((shared_ptr->combined.io_address == 0x0060 && ((shared_ptr->combined.io_byteenable >> 1) & 1) == 0) || shared_ptr->combined.io_address == 0x0064))
-            {
-                uint32 val = top->io_readdata;
-                
-                if(shared_ptr->combined.io_byteenable & 1) val <<= 0;
-                if(shared_ptr->combined.io_byteenable & 2) val <<= 8;
-                if(shared_ptr->combined.io_byteenable & 4) val <<= 16;
-                if(shared_ptr->combined.io_byteenable & 8) val <<= 24;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
-            }
-            
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 &&
-                (shared_ptr->combined.io_address == 0x0090 || shared_ptr->combined.io_address == 0x0094 || shared_ptr->combined.io_address == 0x0098 || shared_ptr->combined.io_address == 0x009C))
-            {
-                uint32 val = top->sysctl_readdata;
-                
-                if(shared_ptr->combined.io_byteenable & 1) val <<= 0;
-                if(shared_ptr->combined.io_byteenable & 2) val <<= 8;
-                if(shared_ptr->combined.io_byteenable & 4) val <<= 16;
-                if(shared_ptr->combined.io_byteenable & 8) val <<= 24;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
-            }
-        }
-        
+        device_io(dev);
         
         //----------------------------------------------------------------------
         
@@ -534,39 +349,18 @@ int main(int argc, char **argv) {
         
         //----------------------------------------------------------------------
         
+        //the model does not drive its inputs: the held levels stay over both edges
         if(kb_clk_hold) top->ps2_kbclk    = kb_clk_hold_value;
         if(kb_dat_hold) top->ps2_kbdat    = kb_dat_hold_value;
         if(ms_clk_hold) top->ps2_mouseclk = ms_clk_hold_value;
         if(ms_dat_hold) top->ps2_mousedat = ms_dat_hold_value;
         
-        top->clk = 0;
-        top->eval();
-        
-        if(kb_clk_hold) top->ps2_kbclk    = kb_clk_hold_value;
-        if(kb_dat_hold) top->ps2_kbdat    = kb_dat_hold_value;
-        if(ms_clk_hold) top->ps2_mouseclk = ms_clk_hold_value;
-        if(ms_dat_hold) top->ps2_mousedat = ms_dat_hold_value;
-        
-        cycle++; if(dump) tracer->dump(cycle);
-        
-        
-        top->clk = 1;
-        top->eval();
-        
-        if(kb_clk_hold) top->ps2_kbclk    = kb_clk_hold_value;
-        if(kb_dat_hold) top->ps2_kbdat    = kb_dat_hold_value;
-        if(ms_clk_hold) top->ps2_mouseclk = ms_clk_hold_value;
-        if(ms_dat_hold) top->ps2_mousedat = ms_dat_hold_value;
-        
-        cycle++; if(dump) tracer->dump(cycle);
-        
-        tracer->flush();
+        device_clock(dev);
         
-        usleep(1);
+        io_pace(shared_ptr, dev.io);
     }
-    tracer->close();
-    delete tracer;
-    delete top;
+    device_report(dev);
+    device_close(dev);
     
     return 0;
 }
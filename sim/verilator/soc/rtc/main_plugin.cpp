@@ -3,17 +3,12 @@
 
 #include <dlfcn.h>
 
-#include <sys/mman.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <unistd.h>
-
 #include "Vrtc.h"
+#include "Vrtc___024root.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 #include "shared_mem.h"
+#include "device.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -25,6 +20,46 @@ volatile shared_mem_t *shared_ptr = NULL;
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
+#define RTC rtc__DOT__
+
+//sec_state, see rtc.v
+#define RTC_SEC_UPDATE_IN_PROGRESS 1
+#define RTC_SEC_SECOND_IN_PROGRESS 3
+#define RTC_SEC_STOPPED            4
+
+/* Clocks until irq can rise: the next periodic interrupt (periodic_major
+ * counting down to 1 on the 8192 Hz enable) and the next update and alarm
+ * check (sec_timeout on the 800 Hz enable). With irq up, the line does not
+ * move until register 0Ch is read.
+ */
+static uint64 rtc_horizon(Vrtc *top) {
+    if(top->irq) return IDLE_MAX;
+    
+    uint64 clk_rate = IDLE_SIGNAL(RTC, clk_rate);
+    uint64 horizon  = IDLE_MAX;
+    
+    bool periodic_enabled = (IDLE_SIGNAL(RTC, divider) >> 1) != 0 && IDLE_SIGNAL(RTC, periodic_rate) != 0;
+    
+    if(IDLE_SIGNAL(RTC, crb_int_periodic_ena) && periodic_enabled) {
+        uint32 major  = IDLE_SIGNAL(RTC, periodic_major);
+        uint64 clocks = (major > 2)? idle_clocks(major - 2, clk_rate, 8192) : 0;
+        
+        if(clocks < horizon) horizon = clocks;
+    }
+    
+    if(IDLE_SIGNAL(RTC, crb_int_update_ena) || IDLE_SIGNAL(RTC, crb_int_alarm_ena)) {
+        uint32 state   = IDLE_SIGNAL(RTC, sec_state);
+        uint32 timeout = IDLE_SIGNAL(RTC, sec_timeout);
+        
+        bool   counting = state == RTC_SEC_UPDATE_IN_PROGRESS || state == RTC_SEC_SECOND_IN_PROGRESS;
+        uint64 clocks   = (state == RTC_SEC_STOPPED)?   IDLE_MAX :
+                          (counting && timeout > 2)?    idle_clocks(timeout - 2, clk_rate, 800) :
+                                                        0;
+        if(clocks < horizon) horizon = clocks;
+    }
+    return horizon;
+}
+
 uint32 fdd_type       = 0x40;
 uint32 hd_cylinders   = 1024;
 uint32 hd_heads       = 16;
@@ -121,45 +156,21 @@ unsigned int cmos[128] = {
 
 //------------------------------------------------------------------------------
 
+DEVICE_PORT(Vrtc, io)
+
+static const device_port_t<Vrtc> rtc_ports[] = {
+    { "io 70h", 0x0070, 0x0071, 0, false, DEVICE_HOOKS(io) },
+};
+
+//------------------------------------------------------------------------------
+
 int main(int argc, char **argv) {
+    static device_t<Vrtc> dev;
     
-    //map shared memory
-    int fd = open("./../../../sim_pc/shared_mem.dat", O_RDWR, S_IRUSR | S_IWUSR);
+    int result = device_open(dev, "rtc", rtc_ports, 1, argc, argv);
+    if(result != 0) return result;
     
-    if(fd == -1) {
-        perror("open() failed for shared_mem.dat");
-        return -1;
-    }
-    
-    shared_ptr = (shared_mem_t *)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    
-    if(shared_ptr == MAP_FAILED) {
-        perror("mmap() failed");
-        close(fd);
-        return -2;
-    }
-    
-    Verilated::commandArgs(argc, argv);
-    
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* tracer = new VerilatedVcdC;
-    
-    Vrtc *top = new Vrtc();
-    top->trace (tracer, 99);
-    //tracer->rolloverMB(1000000);
-    tracer->open("rtc.vcd");
-    
-    bool dump = false;
-    
-    //reset
-    top->clk = 0; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 1; top->eval();
-    top->clk = 1; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 0; top->eval();
-    top->clk = 0; top->rst_n = 1; top->eval();
-    
-    uint64 cycle = 0;
-    bool read_cycle = false;
+    Vrtc *top = dev.top;
     
     int CYCLES_IN_SECOND = 1000000;
     int CYCLES_IN_122_US = 100;
@@ -168,87 +179,26 @@ int main(int argc, char **argv) {
     //129.[12:0]: cycles in 122.07031 us
     
     for(uint32 i=0; i<130; i++) {
-        top->mgmt_write = 1;
-        top->mgmt_address = i;
-        top->mgmt_writedata = (i==128)? CYCLES_IN_SECOND : (i==129)? CYCLES_IN_122_US : cmos[i];
-        
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_mgmt(dev, i, (i==128)? CYCLES_IN_SECOND : (i==129)? CYCLES_IN_122_US : cmos[i]);
     }
-    top->mgmt_write = 0;
     
     printf("rtc main_plugin.cpp\n");
     
-    while(!Verilated::gotFinish()) {
+    while(device_running()) {
         
-        /*
-        uint32 combined.io_address;
-        uint32 combined.io_data;
-        uint32 combined.io_byteenable;
-        uint32 combined.io_is_write;
-        step_t combined.io_step;
+        //---------------------------------------------------------------------- idle skip
         
-        //io slave 0x70-0x71
-        input               io_address,
-        input               io_read,
-        output reg  [7:0]   io_readdata,
-        input               io_write,
-        input       [7:0]   io_writedata,
-        */
-        
-        top->io_read      = 0;
-        top->io_write     = 0;
-        
-        if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write && shared_ptr->combined.io_address == 0x0070 &&
-            (shared_ptr->combined.io_byteenable == 1 || shared_ptr->combined.io_byteenable == 2))
-        {
-            top->io_address    = (shared_ptr->combined.io_byteenable == 1)?     0 :
-                                                                                1;
-            top->io_writedata  = (shared_ptr->combined.io_byteenable == 1)?     shared_ptr->combined.io_data & 0xFF :
-                                                                                (shared_ptr->combined.io_data >> 8) & 0xFF;
-            top->io_read  = 0;
-            top->io_write = 1;
+        if(device_idle(dev)) {
+            uint64 horizon = rtc_horizon(top);
             
-            shared_ptr->combined.io_step = STEP_ACK;
-        }
-        
-        if(read_cycle == false) {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0070 &&
-                (shared_ptr->combined.io_byteenable == 1 || shared_ptr->combined.io_byteenable == 2))
-            {
-                top->io_address = (shared_ptr->combined.io_byteenable == 1)?     0 :
-                                                                                 1;
-                top->io_writedata  = 0;
-                
-                top->io_read  = 1;
-                top->io_write = 0;
-                
-                read_cycle = true;
-            }
-        }
-        else {
-            if(shared_ptr->combined.io_step == STEP_REQ && shared_ptr->combined.io_is_write == 0 && shared_ptr->combined.io_address == 0x0070 &&
-                (shared_ptr->combined.io_byteenable == 1 || shared_ptr->combined.io_byteenable == 2))
-            {
-                uint32 val = top->io_readdata;
-                
-                if(shared_ptr->combined.io_byteenable & 1) val <<= 0;
-                if(shared_ptr->combined.io_byteenable & 2) val <<= 8;
-                
-                shared_ptr->combined.io_data = val;
-                    
-                read_cycle = false;
-                shared_ptr->combined.io_step = STEP_ACK;
+            if(horizon >= IDLE_MIN) {
+                device_skip(dev, horizon);
+                continue;
             }
         }
         
+        device_io(dev);
+        
         //----------------------------------------------------------------------
         
         if(top->irq) {
@@ -260,21 +210,12 @@ int main(int argc, char **argv) {
         
         //----------------------------------------------------------------------
         
-        top->clk = 0;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        top->clk = 1;
-        top->eval();
-        if(dump) tracer->dump(cycle++);
-        
-        tracer->flush();
+        device_clock(dev);
         
-        usleep(1);
+        io_pace(shared_ptr, dev.io);
     }
-    tracer->close();
-    delete tracer;
-    delete top;
+    device_report(dev);
+    device_close(dev);
     
     return 0;
 }
@@ -0,0 +1,1013 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <deque>
+
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include "Vsystem.h"
+#include "Vsystem___024root.h"
+#include "verilated.h"
+
+/* Harness around rtl/system.v, the same SoC top that ao486.sv instantiates.
+ *
+ * - the 64-bit DDRAM_* port is served by a C++ memory model with configurable
+ *   first-beat latency, inter-beat gap and command busy time;
+ * - the mgmt_* bus is driven by a stand-in for the MiSTer HPS: it configures
+ *   the RTC, the IDE channels (0xF0/0xF1) and the floppy (0xF2), and answers
+ *   their sector requests from host disk images.
+ *
+ * Everything runs on one clock: clk_sys, clk_vga, the uart/mpu baud clocks
+ * and clk_audio are all driven from the same toggle.
+ */
+
+//------------------------------------------------------------------------------
+
+#define CLOCK_RATE 90000000
+
+#define DDRAM_SIZE (256 * 1024 * 1024)
+
+Vsystem *top = NULL;
+
+uint64_t cycle = 0;
+
+//------------------------------------------------------------------------------ ddram
+
+struct ddram_config_t {
+    uint32_t read_latency; //cycles from command accept to the first beat
+    uint32_t beat_gap;     //idle cycles between two beats of a burst
+    uint32_t busy_cycles;  //BUSY held after each accepted command or write beat
+};
+
+struct ddram_read_t {
+    uint32_t address;
+    uint32_t burstcount;
+    uint64_t ready_at;
+};
+
+ddram_config_t ddram_config = { 10, 0, 0 };
+
+uint8_t *ddram = NULL;
+
+std::deque<ddram_read_t> ddram_reads;
+
+uint32_t ddram_write_address   = 0;
+uint32_t ddram_write_remaining = 0;
+uint32_t ddram_busy            = 0;
+uint64_t ddram_next_beat       = 0;
+
+uint64_t ddram_read_commands   = 0;
+uint64_t ddram_read_beats      = 0;
+uint64_t ddram_write_beats     = 0;
+uint64_t ddram_busy_total      = 0;
+
+uint64_t *ddram_word(uint32_t address) {
+    return (uint64_t *)&ddram[(address * 8ull) % DDRAM_SIZE];
+}
+
+//sample the handshake the way the slave sees it just before the rising edge
+void ddram_accept() {
+    if(top->DDRAM_BUSY) {
+        ddram_busy_total++;
+        return;
+    }
+
+    if(top->DDRAM_RD) {
+        ddram_read_t read;
+        read.address    = top->DDRAM_ADDR;
+        read.burstcount = (top->DDRAM_BURSTCNT == 0)? 256 : top->DDRAM_BURSTCNT;
+        read.ready_at   = cycle + ddram_config.read_latency;
+        ddram_reads.push_back(read);
+
+        ddram_read_commands++;
+        ddram_busy = ddram_config.busy_cycles;
+    }
+    else if(top->DDRAM_WE) {
+        if(ddram_write_remaining == 0) {
+            ddram_write_address   = top->DDRAM_ADDR;
+            ddram_write_remaining = (top->DDRAM_BURSTCNT == 0)? 256 : top->DDRAM_BURSTCNT;
+        }
+
+        uint8_t *bytes = (uint8_t *)ddram_word(ddram_write_address);
+        for(int i=0; i<8; i++) {
+            if((top->DDRAM_BE >> i) & 1) bytes[i] = (top->DDRAM_DIN >> (i*8)) & 0xFF;
+        }
+
+        ddram_write_address++;
+        ddram_write_remaining--;
+
+        ddram_write_beats++;
+        ddram_busy = ddram_config.busy_cycles;
+    }
+}
+
+//drive the slave outputs for the next cycle
+void ddram_update() {
+    top->DDRAM_DOUT_READY = 0;
+
+    if(ddram_reads.empty() == false && ddram_reads.front().ready_at <= cycle && ddram_next_beat <= cycle) {
+        ddram_read_t &read = ddram_reads.front();
+
+        top->DDRAM_DOUT       = *ddram_word(read.address);
+        top->DDRAM_DOUT_READY = 1;
+
+        read.address++;
+        read.burstcount--;
+        ddram_read_beats++;
+
+        ddram_next_beat = cycle + 1 + ddram_config.beat_gap;
+
+        if(read.burstcount == 0) ddram_reads.pop_front();
+    }
+
+    top->DDRAM_BUSY = (ddram_busy > 0)? 1 : 0;
+    if(ddram_busy > 0) ddram_busy--;
+}
+
+//------------------------------------------------------------------------------ clock
+
+void tick() {
+    ddram_accept();
+
+    top->clk_sys   = 1;
+    top->clk_vga   = 1;
+    top->clk_uart1 = 1;
+    top->clk_uart2 = 1;
+    top->clk_mpu   = 1;
+    top->clk_audio = 1;
+    top->eval();
+
+    top->clk_sys   = 0;
+    top->clk_vga   = 0;
+    top->clk_uart1 = 0;
+    top->clk_uart2 = 0;
+    top->clk_mpu   = 0;
+    top->clk_audio = 0;
+    top->eval();
+
+    cycle++;
+
+    ddram_update();
+    top->eval();
+}
+
+//------------------------------------------------------------------------------ cache stats
+
+/* The caches and the tlb keep simulation-only counters (translate_off blocks
+ * marked public_flat_rd). They are sampled every --cache-window cycles into
+ * <file>.csv as deltas, the workload phases, and summed into <file> at exit.
+ * DCACHE is the system parameter of the same name, passed by the Makefile.
+ */
+
+#ifndef DCACHE
+#define DCACHE 0
+#endif
+
+#define L1  system__DOT__ao486__DOT__memory_inst__DOT__icache_inst__DOT__l1_icache_inst__DOT__
+#define IC  system__DOT__ao486__DOT__memory_inst__DOT__icache_inst__DOT__
+#define DC  system__DOT__ao486__DOT__memory_inst__DOT__gdcache__DOT__l1_dcache_inst__DOT__
+#define L2  system__DOT__cache__DOT__
+#define TLB system__DOT__ao486__DOT__memory_inst__DOT__tlb_inst__DOT__
+
+#define CACHE_PASTE(prefix, name)   prefix##name
+#define CACHE_COUNTER(prefix, name) top->rootp->CACHE_PASTE(prefix, name)
+
+enum cache_counter_t {
+    L1_REQUESTS, L1_FILLS, L1_EVICTIONS, L1_SNOOPS, L1_SNOOP_HITS, L1_PREFETCHES, L1_PREFETCH_USEFUL, L1_PREFETCH_WASTED,
+    IC_READS, IC_READ_CYCLES, IC_SNOOP_RESETS,
+    DC_READS, DC_FILLS, DC_UNCACHED, DC_WRITES, DC_WRITE_HITS, DC_WRITEBACKS, DC_SNOOPS, DC_SNOOP_HITS,
+    L2_READS, L2_FILLS, L2_UNCACHED, L2_EVICTIONS, L2_WRITES, L2_WRITE_HITS, L2_VGA_READS, L2_VGA_WRITES,
+    TLB_CODE_LOOKUPS, TLB_CODE_MISSES, TLB_DATA_LOOKUPS, TLB_DATA_MISSES, TLB_WALK_CYCLES, TLB_FLUSHES,
+    CACHE_COUNTERS
+};
+
+const char *cache_counter_names[CACHE_COUNTERS] = {
+    "l1_requests", "l1_fills", "l1_evictions", "l1_snoops", "l1_snoop_hits", "l1_prefetches", "l1_prefetch_useful", "l1_prefetch_wasted",
+    "icache_reads", "icache_read_cycles", "icache_snoop_resets",
+    "dc_reads", "dc_fills", "dc_uncached", "dc_writes", "dc_write_hits", "dc_writebacks", "dc_snoops", "dc_snoop_hits",
+    "l2_reads", "l2_fills", "l2_uncached", "l2_evictions", "l2_writes", "l2_write_hits", "l2_vga_reads", "l2_vga_writes",
+    "tlb_code_lookups", "tlb_code_misses", "tlb_data_lookups", "tlb_data_misses", "tlb_walk_cycles", "tlb_flushes"
+};
+
+struct cache_stats_t {
+    FILE    *window_fp;
+    uint64_t window_cycles;
+    uint64_t window_start;
+    uint64_t last[CACHE_COUNTERS];
+};
+
+cache_stats_t cache_stats;
+
+void cache_sample(uint64_t *values) {
+    values[L1_REQUESTS]      = CACHE_COUNTER(L1, perf_requests);
+    values[L1_FILLS]         = CACHE_COUNTER(L1, perf_fills);
+    values[L1_EVICTIONS]     = CACHE_COUNTER(L1, perf_evictions);
+    values[L1_SNOOPS]        = CACHE_COUNTER(L1, perf_snoops);
+    values[L1_SNOOP_HITS]    = CACHE_COUNTER(L1, perf_snoop_hit);
+    values[L1_PREFETCHES]    = CACHE_COUNTER(L1, perf_prefetches);
+    values[L1_PREFETCH_USEFUL] = CACHE_COUNTER(L1, perf_prefetch_useful);
+    values[L1_PREFETCH_WASTED] = CACHE_COUNTER(L1, perf_prefetch_wasted);
+    values[IC_READS]         = CACHE_COUNTER(IC, perf_reads);
+    values[IC_READ_CYCLES]   = CACHE_COUNTER(IC, perf_read_cycles);
+    values[IC_SNOOP_RESETS]  = CACHE_COUNTER(IC, perf_snoop_resets);
+#if DCACHE
+    values[DC_READS]         = CACHE_COUNTER(DC, perf_reads);
+    values[DC_FILLS]         = CACHE_COUNTER(DC, perf_fills);
+    values[DC_UNCACHED]      = CACHE_COUNTER(DC, perf_uncached);
+    values[DC_WRITES]        = CACHE_COUNTER(DC, perf_writes);
+    values[DC_WRITE_HITS]    = CACHE_COUNTER(DC, perf_write_hits);
+    values[DC_WRITEBACKS]    = CACHE_COUNTER(DC, perf_writebacks);
+    values[DC_SNOOPS]        = CACHE_COUNTER(DC, perf_snoops);
+    values[DC_SNOOP_HITS]    = CACHE_COUNTER(DC, perf_snoop_hit);
+#else
+    for(int i=DC_READS; i<=DC_SNOOP_HITS; i++) values[i] = 0; //built with DCACHE=0, no l1_dcache
+#endif
+    values[L2_READS]         = CACHE_COUNTER(L2, perf_reads);
+    values[L2_FILLS]         = CACHE_COUNTER(L2, perf_fills);
+    values[L2_UNCACHED]      = CACHE_COUNTER(L2, perf_uncached);
+    values[L2_EVICTIONS]     = CACHE_COUNTER(L2, perf_evictions);
+    values[L2_WRITES]        = CACHE_COUNTER(L2, perf_writes);
+    values[L2_WRITE_HITS]    = CACHE_COUNTER(L2, perf_write_hits);
+    values[L2_VGA_READS]     = CACHE_COUNTER(L2, perf_vga_reads);
+    values[L2_VGA_WRITES]    = CACHE_COUNTER(L2, perf_vga_writes);
+    values[TLB_CODE_LOOKUPS] = CACHE_COUNTER(TLB, perf_code_lookups);
+    values[TLB_CODE_MISSES]  = CACHE_COUNTER(TLB, perf_code_misses);
+    values[TLB_DATA_LOOKUPS] = CACHE_COUNTER(TLB, perf_data_lookups);
+    values[TLB_DATA_MISSES]  = CACHE_COUNTER(TLB, perf_data_misses);
+    values[TLB_WALK_CYCLES]  = CACHE_COUNTER(TLB, perf_walk_cycles);
+    values[TLB_FLUSHES]      = CACHE_COUNTER(TLB, perf_flushes);
+}
+
+double cache_rate(uint64_t part, uint64_t total) {
+    return (total > 0)? 100.0 * part / total : 0.0;
+}
+
+bool cache_stats_open(const char *name, uint64_t window_cycles) {
+    memset(&cache_stats, 0, sizeof(cache_stats));
+    cache_stats.window_cycles = window_cycles;
+    cache_stats.window_start  = cycle;
+    cache_sample(cache_stats.last);
+
+    if(window_cycles == 0) return true;
+
+    char window_name[256];
+    snprintf(window_name, sizeof(window_name), "%s.csv", name);
+
+    cache_stats.window_fp = fopen(window_name, "wb");
+    if(cache_stats.window_fp == NULL) return false;
+
+    fprintf(cache_stats.window_fp, "cycle_start,cycle_end");
+    for(int i=0; i<CACHE_COUNTERS; i++) fprintf(cache_stats.window_fp, ",%s", cache_counter_names[i]);
+    fprintf(cache_stats.window_fp, ",l1_miss_pct,dc_miss_pct,l2_miss_pct,tlb_code_miss_pct,tlb_data_miss_pct\n");
+    return true;
+}
+
+void cache_stats_window() {
+    if(cache_stats.window_fp == NULL || cycle == cache_stats.window_start) return;
+
+    uint64_t now[CACHE_COUNTERS], delta[CACHE_COUNTERS];
+    cache_sample(now);
+    for(int i=0; i<CACHE_COUNTERS; i++) delta[i] = now[i] - cache_stats.last[i];
+
+    fprintf(cache_stats.window_fp, "%lu,%lu", cache_stats.window_start, cycle);
+    for(int i=0; i<CACHE_COUNTERS; i++) fprintf(cache_stats.window_fp, ",%lu", delta[i]);
+    fprintf(cache_stats.window_fp, ",%.2f,%.2f,%.2f,%.2f,%.2f\n", cache_rate(delta[L1_FILLS], delta[L1_REQUESTS]), cache_rate(delta[DC_FILLS], delta[DC_READS]),
+        cache_rate(delta[L2_FILLS], delta[L2_READS]),
+        cache_rate(delta[TLB_CODE_MISSES], delta[TLB_CODE_LOOKUPS]), cache_rate(delta[TLB_DATA_MISSES], delta[TLB_DATA_LOOKUPS]));
+
+    memcpy(cache_stats.last, now, sizeof(now));
+    cache_stats.window_start = cycle;
+}
+
+bool cache_stats_close(const char *name) {
+    cache_stats_window();
+    if(cache_stats.window_fp != NULL) fclose(cache_stats.window_fp);
+    cache_stats.window_fp = NULL;
+
+    FILE *fp = fopen(name, "wb");
+    if(fp == NULL) return false;
+
+    uint64_t v[CACHE_COUNTERS];
+    cache_sample(v);
+
+    fprintf(fp, "cycles: %lu\n\n", cycle);
+    for(int i=0; i<CACHE_COUNTERS; i++) fprintf(fp, "%-22s %14lu\n", cache_counter_names[i], v[i]);
+
+    //a fill per read request: a burst crossing a line counts twice
+    fprintf(fp, "\n");
+    fprintf(fp, "l1 miss rate:           %6.2f%% of requests\n",      cache_rate(v[L1_FILLS], v[L1_REQUESTS]));
+    fprintf(fp, "l1 evictions:           %6.2f%% of fills\n",         cache_rate(v[L1_EVICTIONS], v[L1_FILLS]));
+    fprintf(fp, "l1 prefetch useful:     %6.2f%% of prefetches\n",    cache_rate(v[L1_PREFETCH_USEFUL], v[L1_PREFETCHES]));
+    fprintf(fp, "l1 prefetch wasted:     %6.2f%% of prefetches\n",    cache_rate(v[L1_PREFETCH_WASTED], v[L1_PREFETCHES]));
+    fprintf(fp, "dcache miss rate:       %6.2f%% of reads\n",         cache_rate(v[DC_FILLS], v[DC_READS]));
+    fprintf(fp, "dcache uncached:        %6.2f%% of reads\n",         cache_rate(v[DC_UNCACHED], v[DC_READS] + v[DC_UNCACHED]));
+    fprintf(fp, "l2 miss rate:           %6.2f%% of reads\n",         cache_rate(v[L2_FILLS], v[L2_READS]));
+    fprintf(fp, "l2 evictions:           %6.2f%% of fills\n",         cache_rate(v[L2_EVICTIONS], v[L2_FILLS]));
+    fprintf(fp, "l2 write hits:          %6.2f%% of writes\n",        cache_rate(v[L2_WRITE_HITS], v[L2_WRITES]));
+    fprintf(fp, "tlb code miss rate:     %6.2f%% of lookups\n",       cache_rate(v[TLB_CODE_MISSES], v[TLB_CODE_LOOKUPS]));
+    fprintf(fp, "tlb data miss rate:     %6.2f%% of lookups\n",       cache_rate(v[TLB_DATA_MISSES], v[TLB_DATA_LOOKUPS]));
+    fprintf(fp, "tlb walk:               %6.2f cycles per miss\n",    (v[TLB_CODE_MISSES] + v[TLB_DATA_MISSES] > 0)? v[TLB_WALK_CYCLES] / (double)(v[TLB_CODE_MISSES] + v[TLB_DATA_MISSES]) : 0.0);
+
+    fclose(fp);
+    return true;
+}
+
+//------------------------------------------------------------------------------ mgmt bus
+
+#define MGMT_IDE0 0xF000
+#define MGMT_IDE1 0xF100
+#define MGMT_FDD  0xF200
+#define MGMT_RTC  0xF400
+
+//one write strobe; the ide data buffer advances on its falling edge
+void mgmt_write(uint16_t address, uint16_t data) {
+    top->mgmt_address   = address;
+    top->mgmt_writedata = data;
+    top->mgmt_write     = 1;
+    tick();
+    top->mgmt_write     = 0;
+    tick();
+}
+
+//readdata is registered behind the address, so sample before the strobe
+uint16_t mgmt_read(uint16_t address) {
+    top->mgmt_address = address;
+    tick();
+    tick();
+    tick();
+    uint16_t data = top->mgmt_readdata;
+
+    top->mgmt_read = 1;
+    tick();
+    top->mgmt_read = 0;
+    tick();
+    return data;
+}
+
+//------------------------------------------------------------------------------ rtc
+
+uint8_t bcd(int value) {
+    return ((value / 10) << 4) | (value % 10);
+}
+
+void rtc_init(uint32_t mem_mb, int fdd0_type) {
+    uint8_t cmos[128];
+    memset(cmos, 0, sizeof(cmos));
+
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+
+    cmos[0x00] = bcd(t->tm_sec);
+    cmos[0x02] = bcd(t->tm_min);
+    cmos[0x04] = bcd(t->tm_hour);
+    cmos[0x06] = bcd(t->tm_wday + 1);
+    cmos[0x07] = bcd(t->tm_mday);
+    cmos[0x08] = bcd(t->tm_mon + 1);
+    cmos[0x09] = bcd(t->tm_year % 100);
+    cmos[0x32] = bcd(19 + t->tm_year / 100);
+
+    cmos[0x0A] = 0x26;
+    cmos[0x0B] = 0x02;
+    cmos[0x0D] = 0x80;
+
+    cmos[0x10] = fdd0_type << 4;
+    cmos[0x14] = (fdd0_type != 0)? 0x01 : 0x00;
+
+    //640 KB base, extended memory in KB up to 64 MB, above 16 MB in 64 KB units
+    uint32_t ext_kb = (mem_mb - 1) * 1024;
+    if(ext_kb > 0xFC00) ext_kb = 0xFC00;
+    uint32_t high_64k = (mem_mb > 16)? (mem_mb - 16) * 16 : 0;
+
+    cmos[0x15] = 0x80;
+    cmos[0x16] = 0x02;
+    cmos[0x17] = cmos[0x30] = ext_kb & 0xFF;
+    cmos[0x18] = cmos[0x31] = ext_kb >> 8;
+    cmos[0x34] = high_64k & 0xFF;
+    cmos[0x35] = high_64k >> 8;
+
+    uint16_t sum = 0;
+    for(int i=0x10; i<=0x2D; i++) sum += cmos[i];
+    cmos[0x2E] = sum >> 8;
+    cmos[0x2F] = sum & 0xFF;
+
+    for(int i=0; i<128; i++) mgmt_write(MGMT_RTC | i, cmos[i]);
+}
+
+//------------------------------------------------------------------------------ ide
+
+/* ide.v mgmt registers:
+ *   0  r: {features, 6'd0, use_fast, io_done}     w: {error, block size in sectors}
+ *   1  r/w: {sector[7:0], sector_count[7:0]}
+ *   2  r/w: cylinder[15:0]
+ *   3  r/w: {sector[15:8], sector_count[15:8]}
+ *   4  r/w: cylinder[31:16]
+ *   5  r: {cmd, drv_addr}  w: {bsy, drdy, fast, dsc, drq, irq, last, err, drv_addr}
+ *   6  w: drive present / lba48 enables
+ *   15 r/w: sector buffer, 16 bits per access
+ */
+
+#define IDE_BSY  0x8000
+#define IDE_DRDY 0x4000
+#define IDE_DSC  0x1000
+#define IDE_DRQ  0x0800
+#define IDE_IRQ  0x0400
+#define IDE_LAST 0x0200
+#define IDE_ERR  0x0100
+
+#define IDE_ERR_ABRT 0x04
+#define IDE_ERR_IDNF 0x10
+
+#define IDE_MAX_MULTIPLE 16
+
+struct ide_drive_t {
+    FILE    *fp;
+    uint64_t sectors;
+    uint32_t cylinders;
+    uint32_t heads;
+    uint32_t spt;
+    uint32_t multiple;
+};
+
+struct ide_channel_t {
+    uint16_t    base;
+    ide_drive_t drive[2];
+
+    //command in flight
+    uint8_t  cmd;
+    uint8_t  drv_addr;
+    bool     lba48;
+    uint64_t lba;
+    uint32_t remaining;
+    uint32_t block;
+    bool     is_write;
+};
+
+ide_channel_t ide[2];
+
+uint16_t ide_buffer[256 * IDE_MAX_MULTIPLE];
+
+uint64_t ide_sectors_read    = 0;
+uint64_t ide_sectors_written = 0;
+
+bool ide_open(ide_drive_t *drive, const char *name) {
+    drive->fp = fopen(name, "r+b");
+    if(drive->fp == NULL) return false;
+
+    fseek(drive->fp, 0, SEEK_END);
+    drive->sectors = ftell(drive->fp) / 512;
+
+    drive->heads     = 16;
+    drive->spt       = 63;
+    drive->cylinders = drive->sectors / (drive->heads * drive->spt);
+    if(drive->cylinders > 16383) drive->cylinders = 16383;
+    drive->multiple  = IDE_MAX_MULTIPLE;
+    return true;
+}
+
+void ide_string(uint16_t *words, const char *str, int length) {
+    char buf[64];
+    memset(buf, ' ', sizeof(buf));
+    memcpy(buf, str, strlen(str) < (size_t)length? strlen(str) : length);
+
+    for(int i=0; i<length/2; i++) words[i] = (buf[i*2] << 8) | buf[i*2 + 1];
+}
+
+void ide_identify(ide_drive_t *drive) {
+    uint16_t *id = ide_buffer;
+    memset(id, 0, 512);
+
+    uint32_t chs = drive->cylinders * drive->heads * drive->spt;
+    uint64_t lba28 = (drive->sectors > 0x0FFFFFFF)? 0x0FFFFFFF : drive->sectors;
+
+    id[0]  = 0x0040;
+    id[1]  = drive->cylinders;
+    id[3]  = drive->heads;
+    id[6]  = drive->spt;
+    ide_string(&id[10], "AO486SIM", 20);
+    ide_string(&id[23], "1.0", 8);
+    ide_string(&id[27], "ao486 simulated disk", 40);
+    id[47] = 0x8000 | IDE_MAX_MULTIPLE;
+    id[49] = 0x0200;
+    id[51] = 0x0200;
+    id[53] = 0x0007;
+    id[54] = drive->cylinders;
+    id[55] = drive->heads;
+    id[56] = drive->spt;
+    id[57] = chs & 0xFFFF;
+    id[58] = chs >> 16;
+    id[59] = 0x0100 | drive->multiple;
+    id[60] = lba28 & 0xFFFF;
+    id[61] = lba28 >> 16;
+    id[80] = 0x007E;
+    id[82] = 0x4000;
+    id[83] = 0x4400;
+    id[84] = 0x4000;
+    id[86] = 0x0400;
+    id[100] = (drive->sectors >>  0) & 0xFFFF;
+    id[101] = (drive->sectors >> 16) & 0xFFFF;
+    id[102] = (drive->sectors >> 32) & 0xFFFF;
+}
+
+void ide_set_config(ide_channel_t *ch) {
+    uint16_t cfg = 0x0088;
+    if(ch->drive[0].fp) cfg |= 0x03;
+    if(ch->drive[1].fp) cfg |= 0x30;
+    mgmt_write(ch->base | 6, cfg);
+}
+
+//write the task file back with the current address, as a completed transfer leaves it
+void ide_set_regs(ide_channel_t *ch, uint8_t error, uint32_t block) {
+    ide_drive_t *drive = &ch->drive[(ch->drv_addr >> 4) & 1];
+
+    uint32_t sector_count = ch->remaining & 0xFFFF;
+    uint32_t sector, cylinder;
+
+    if(ch->lba48) {
+        sector   = ((ch->lba >> 16) & 0xFF00) | (ch->lba & 0xFF);
+        cylinder = ((ch->lba >> 8) & 0xFFFF) | (((ch->lba >> 32) & 0xFFFF) << 16);
+    }
+    else if(ch->drv_addr & 0x40) {
+        sector   = ch->lba & 0xFF;
+        cylinder = (ch->lba >> 8) & 0xFFFF;
+        ch->drv_addr = (ch->drv_addr & 0xF0) | ((ch->lba >> 24) & 0x0F);
+    }
+    else {
+        uint32_t c = ch->lba / (drive->heads * drive->spt);
+        uint32_t h = (ch->lba / drive->spt) % drive->heads;
+        sector   = (ch->lba % drive->spt) + 1;
+        cylinder = c;
+        ch->drv_addr = (ch->drv_addr & 0xF0) | h;
+    }
+
+    mgmt_write(ch->base | 1, ((sector & 0xFF) << 8) | (sector_count & 0xFF));
+    mgmt_write(ch->base | 2, cylinder & 0xFFFF);
+    mgmt_write(ch->base | 3, (sector & 0xFF00) | (sector_count >> 8));
+    mgmt_write(ch->base | 4, cylinder >> 16);
+    mgmt_write(ch->base | 0, (error << 8) | block);
+}
+
+void ide_set_status(ide_channel_t *ch, uint16_t status) {
+    mgmt_write(ch->base | 5, status | ch->drv_addr);
+}
+
+void ide_abort(ide_channel_t *ch, uint8_t error) {
+    mgmt_write(ch->base | 0, error << 8);
+    ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_ERR | IDE_IRQ);
+}
+
+void ide_send_buffer(ide_channel_t *ch, uint32_t words) {
+    for(uint32_t i=0; i<words; i++) mgmt_write(ch->base | 15, ide_buffer[i]);
+}
+
+void ide_read_block(ide_channel_t *ch) {
+    ide_drive_t *drive = &ch->drive[(ch->drv_addr >> 4) & 1];
+
+    ch->block = (ch->remaining < ch->block)? ch->remaining : ch->block;
+
+    fseek(drive->fp, ch->lba * 512, SEEK_SET);
+    if(fread(ide_buffer, 512, ch->block, drive->fp) != ch->block) memset(ide_buffer, 0, ch->block * 512);
+
+    ch->lba       += ch->block;
+    ch->remaining -= ch->block;
+    ide_sectors_read += ch->block;
+
+    ide_set_regs(ch, 0, ch->block);
+    ide_send_buffer(ch, ch->block * 256);
+    ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_DRQ | IDE_IRQ | ((ch->remaining == 0)? IDE_LAST : 0));
+}
+
+void ide_write_block(ide_channel_t *ch) {
+    ide_drive_t *drive = &ch->drive[(ch->drv_addr >> 4) & 1];
+
+    for(uint32_t i=0; i<ch->block * 256; i++) ide_buffer[i] = mgmt_read(ch->base | 15);
+
+    fseek(drive->fp, ch->lba * 512, SEEK_SET);
+    fwrite(ide_buffer, 512, ch->block, drive->fp);
+
+    ch->lba       += ch->block;
+    ch->remaining -= ch->block;
+    ide_sectors_written += ch->block;
+
+    if(ch->remaining == 0) {
+        ide_set_regs(ch, 0, 0);
+        ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_IRQ);
+        return;
+    }
+
+    ch->block = (ch->remaining < ch->block)? ch->remaining : ch->block;
+    ide_set_regs(ch, 0, ch->block);
+    ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_DRQ | IDE_IRQ);
+}
+
+void ide_command(ide_channel_t *ch) {
+    uint16_t regs[6];
+    for(int i=0; i<6; i++) regs[i] = mgmt_read(ch->base | i);
+
+    uint8_t  features     = regs[0] >> 8;
+    uint32_t sector_count = (regs[1] & 0xFF) | ((regs[3] & 0xFF) << 8);
+    uint32_t sector       = (regs[1] >> 8) | (regs[3] & 0xFF00);
+    uint32_t cylinder     = regs[2] | (regs[4] << 16);
+
+    ch->cmd      = regs[5] >> 8;
+    ch->drv_addr = regs[5] & 0xFF;
+
+    ide_drive_t *drive = &ch->drive[(ch->drv_addr >> 4) & 1];
+
+    if(drive->fp == NULL) {
+        ide_abort(ch, IDE_ERR_ABRT);
+        return;
+    }
+
+    ch->lba48 = (ch->cmd == 0x24 || ch->cmd == 0x29 || ch->cmd == 0x34 || ch->cmd == 0x39);
+
+    if(ch->lba48) {
+        ch->lba       = (sector & 0xFF) | ((uint64_t)(cylinder & 0xFFFF) << 8) | ((uint64_t)(sector >> 8) << 24) | ((uint64_t)(cylinder >> 16) << 32);
+        ch->remaining = (sector_count == 0)? 65536 : sector_count;
+    }
+    else if(ch->drv_addr & 0x40) {
+        ch->lba       = (sector & 0xFF) | ((cylinder & 0xFFFF) << 8) | ((ch->drv_addr & 0x0F) << 24);
+        ch->remaining = ((sector_count & 0xFF) == 0)? 256 : (sector_count & 0xFF);
+    }
+    else {
+        ch->lba       = ((uint64_t)(cylinder & 0xFFFF) * drive->heads + (ch->drv_addr & 0x0F)) * drive->spt + (sector & 0xFF) - 1;
+        ch->remaining = ((sector_count & 0xFF) == 0)? 256 : (sector_count & 0xFF);
+    }
+
+    bool multiple = (ch->cmd == 0xC4 || ch->cmd == 0xC5 || ch->cmd == 0x29 || ch->cmd == 0x39);
+    ch->block = multiple? drive->multiple : 1;
+
+    switch(ch->cmd) {
+        case 0x20: case 0x21: case 0x24: case 0x29: case 0xC4:
+        case 0x30: case 0x31: case 0x34: case 0x39: case 0xC5:
+            if(ch->lba + ch->remaining > drive->sectors) {
+                ide_abort(ch, IDE_ERR_IDNF);
+                return;
+            }
+            ch->is_write = (ch->cmd >= 0x30 && ch->cmd <= 0x39) || ch->cmd == 0xC5;
+
+            if(ch->is_write) {
+                ch->block = (ch->remaining < ch->block)? ch->remaining : ch->block;
+                mgmt_write(ch->base | 0, ch->block);
+                ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_DRQ);
+            }
+            else {
+                ide_read_block(ch);
+            }
+            break;
+
+        case 0xEC:
+            ide_identify(drive);
+            ch->remaining = 0;
+            mgmt_write(ch->base | 0, 1);
+            ide_send_buffer(ch, 256);
+            ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_DRQ | IDE_IRQ | IDE_LAST);
+            break;
+
+        case 0xC6:
+            if(sector_count == 0 || (sector_count & 0xFF) > IDE_MAX_MULTIPLE || (sector_count & (sector_count - 1))) {
+                ide_abort(ch, IDE_ERR_ABRT);
+                return;
+            }
+            drive->multiple = sector_count & 0xFF;
+            ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_IRQ);
+            break;
+
+        case 0xF8: case 0x27:
+            ch->lba       = drive->sectors - 1;
+            ch->lba48     = (ch->cmd == 0x27);
+            ch->remaining = 0;
+            ide_set_regs(ch, 0, 0);
+            ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_IRQ);
+            break;
+
+        case 0x10: case 0x40: case 0x41: case 0x42: case 0x70: case 0x91:
+        case 0xE0: case 0xE1: case 0xE5: case 0xE7: case 0xEA: case 0xEF:
+            (void)features;
+            ide_set_status(ch, IDE_DRDY | IDE_DSC | IDE_IRQ);
+            break;
+
+        default:
+            ide_abort(ch, IDE_ERR_ABRT);
+            break;
+    }
+}
+
+void ide_data(ide_channel_t *ch) {
+    //any register access also rewinds the mgmt side of the sector buffer
+    mgmt_read(ch->base | 0);
+
+    if(ch->is_write) ide_write_block(ch);
+    else             ide_read_block(ch);
+}
+
+void ide_reset(ide_channel_t *ch) {
+    ide_set_config(ch);
+
+    //ata signature, diagnostics passed
+    ch->drv_addr = 0;
+    mgmt_write(ch->base | 1, 0x0101);
+    mgmt_write(ch->base | 2, 0x0000);
+    mgmt_write(ch->base | 3, 0x0000);
+    mgmt_write(ch->base | 4, 0x0000);
+    mgmt_write(ch->base | 0, 0x0100);
+    ide_set_status(ch, IDE_DRDY | IDE_DSC);
+}
+
+void ide_poll(ide_channel_t *ch, uint8_t request) {
+    if((request & 4) == 0) return;
+
+    if(request == 6)      ide_reset(ch);
+    else if(request == 4) ide_command(ch);
+    else if(request == 5) ide_data(ch);
+}
+
+//------------------------------------------------------------------------------ floppy
+
+/* floppy.v mgmt registers, drive selected by address bit 7:
+ *   0  r: {drive, sector}  w: media present
+ *   1  w: write protect
+ *   2  w: cylinders, 3 w: sectors per track, 4 w: total sectors, 5 w: heads
+ *   15 r/w: sector fifo, 8 bits per access
+ */
+
+struct floppy_drive_t {
+    FILE    *fp;
+    uint32_t cylinders;
+    uint32_t spt;
+    uint32_t heads;
+    uint32_t sectors;
+    int      cmos_type;
+};
+
+floppy_drive_t floppy[2];
+
+uint8_t floppy_buffer[512];
+
+bool floppy_open(floppy_drive_t *drive, const char *name) {
+    drive->fp = fopen(name, "r+b");
+    if(drive->fp == NULL) return false;
+
+    fseek(drive->fp, 0, SEEK_END);
+    long size = ftell(drive->fp);
+
+    drive->heads = 2;
+    if(size == 368640)       { drive->cylinders = 40; drive->spt = 9;  drive->heads = 1; drive->cmos_type = 1; }
+    else if(size == 737280)  { drive->cylinders = 80; drive->spt = 9;  drive->cmos_type = 3; }
+    else if(size == 1228800) { drive->cylinders = 80; drive->spt = 15; drive->cmos_type = 2; }
+    else if(size == 2949120) { drive->cylinders = 80; drive->spt = 36; drive->cmos_type = 5; }
+    else                     { drive->cylinders = 80; drive->spt = 18; drive->cmos_type = 4; }
+
+    drive->sectors = drive->cylinders * drive->spt * drive->heads;
+    return true;
+}
+
+void floppy_init() {
+    for(int i=0; i<2; i++) {
+        uint16_t base = MGMT_FDD | (i << 7);
+        floppy_drive_t *drive = &floppy[i];
+
+        mgmt_write(base | 0, drive->fp? 1 : 0);
+        if(drive->fp == NULL) continue;
+
+        mgmt_write(base | 1, 0);
+        mgmt_write(base | 2, drive->cylinders);
+        mgmt_write(base | 3, drive->spt);
+        mgmt_write(base | 4, drive->sectors);
+        mgmt_write(base | 5, drive->heads);
+    }
+}
+
+void floppy_poll(uint8_t request) {
+    if(request == 0) return;
+
+    uint16_t info = mgmt_read(MGMT_FDD | 0);
+    floppy_drive_t *drive = &floppy[info >> 15];
+    uint32_t sector = info & 0x7FFF;
+
+    if(request & 1) {
+        memset(floppy_buffer, 0, sizeof(floppy_buffer));
+        if(drive->fp) {
+            fseek(drive->fp, sector * 512, SEEK_SET);
+            if(fread(floppy_buffer, 512, 1, drive->fp) != 1) memset(floppy_buffer, 0, sizeof(floppy_buffer));
+        }
+        for(int i=0; i<512; i++) mgmt_write(MGMT_FDD | 15, floppy_buffer[i]);
+    }
+    else {
+        for(int i=0; i<512; i++) floppy_buffer[i] = mgmt_read(MGMT_FDD | 15);
+        if(drive->fp) {
+            fseek(drive->fp, sector * 512, SEEK_SET);
+            fwrite(floppy_buffer, 512, 1, drive->fp);
+        }
+    }
+
+    //let the controller leave its wait state before the request is sampled again
+    for(int i=0; i<4; i++) tick();
+}
+
+//------------------------------------------------------------------------------
+
+int load_file(const char *name, int byte_location) {
+    FILE *fp = fopen(name, "rb");
+    if(fp == NULL) {
+        return -1;
+    }
+
+    int int_ret = fseek(fp, 0, SEEK_END);
+    if(int_ret != 0) {
+        fclose(fp);
+        return -2;
+    }
+
+    long size = ftell(fp);
+    rewind(fp);
+
+    int_ret = fread((void *)&ddram[byte_location], size, 1, fp);
+    if(int_ret != 1) {
+        fclose(fp);
+        return -3;
+    }
+    fclose(fp);
+
+    return 0;
+}
+
+uint64_t time_usec() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+void usage(const char *name) {
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --bios <file>          boot0.rom, loaded at 0xF0000\n"
+        "  --vgabios <file>       boot1.rom, loaded at 0xC0000\n"
+        "  --hdd0..--hdd3 <file>  ide0 master/slave, ide1 master/slave\n"
+        "  --fdd0, --fdd1 <file>  floppy images\n"
+        "  --mem-mb <n>           memory reported in CMOS (default 256)\n"
+        "  --cycles <n>           stop after n cycles\n"
+        "  --until-e9 <byte>      stop when the guest writes byte to port 0xE9\n"
+        "  --ddr-latency <n>      cycles to the first read beat (default 10)\n"
+        "  --ddr-gap <n>          idle cycles between read beats (default 0)\n"
+        "  --ddr-busy <n>         BUSY cycles after each command (default 0)\n"
+        "  --cache-stats <file>   cache and tlb counters at exit\n"
+        "  --cache-window <n>     also <file>.csv, one line of deltas per n cycles\n",
+        name);
+}
+
+int main(int argc, char **argv) {
+
+    const char *bios_file    = "./../../../releases/boot0.rom";
+    const char *vgabios_file = "./../../../releases/boot1.rom";
+    const char *hdd_file[4]  = { NULL, NULL, NULL, NULL };
+    const char *fdd_file[2]  = { NULL, NULL };
+    uint32_t    mem_mb       = 256;
+    uint64_t    max_cycles   = 0;
+    int         until_e9     = -1;
+    const char *cache_file   = NULL;
+    uint64_t    cache_window = 0;
+
+    for(int i=1; i<argc; i++) {
+        bool has_arg = (i+1 < argc);
+        int  unit    = (strlen(argv[i]) == 6)? argv[i][5] - '0' : -1;
+
+        if(strcmp(argv[i], "--bios") == 0 && has_arg)              bios_file    = argv[++i];
+        else if(strcmp(argv[i], "--vgabios") == 0 && has_arg)      vgabios_file = argv[++i];
+        else if(strncmp(argv[i], "--hdd", 5) == 0 && unit >= 0 && unit <= 3 && has_arg) hdd_file[unit] = argv[++i];
+        else if(strncmp(argv[i], "--fdd", 5) == 0 && unit >= 0 && unit <= 1 && has_arg) fdd_file[unit] = argv[++i];
+        else if(strcmp(argv[i], "--mem-mb") == 0 && has_arg)       mem_mb       = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--cycles") == 0 && has_arg)       max_cycles   = strtoull(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--until-e9") == 0 && has_arg)     until_e9     = strtol(argv[++i], NULL, 0) & 0xFF;
+        else if(strcmp(argv[i], "--ddr-latency") == 0 && has_arg) ddram_config.read_latency = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--ddr-gap") == 0 && has_arg)      ddram_config.beat_gap     = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--ddr-busy") == 0 && has_arg)     ddram_config.busy_cycles  = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "--cache-stats") == 0 && has_arg)  cache_file   = argv[++i];
+        else if(strcmp(argv[i], "--cache-window") == 0 && has_arg) cache_window = strtoull(argv[++i], NULL, 0);
+        else if(argv[i][0] == '+') ; //verilator plusargs
+        else {
+            usage(argv[0]);
+            return -1;
+        }
+    }
+    if(mem_mb < 1 || mem_mb > DDRAM_SIZE / (1024 * 1024)) mem_mb = DDRAM_SIZE / (1024 * 1024);
+
+    //anonymous mapping: only pages the guest touches are ever backed
+    ddram = (uint8_t *)mmap(NULL, DDRAM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(ddram == MAP_FAILED) {
+        perror("mmap() failed");
+        return -1;
+    }
+
+    if(load_file(bios_file, 0xF0000) != 0) {
+        fprintf(stderr, "Can not load bios file %s\n", bios_file);
+        return -2;
+    }
+    if(load_file(vgabios_file, 0xC0000) != 0) {
+        fprintf(stderr, "Can not load vgabios file %s\n", vgabios_file);
+        return -2;
+    }
+
+    memset(ide, 0, sizeof(ide));
+    ide[0].base = MGMT_IDE0;
+    ide[1].base = MGMT_IDE1;
+    for(int i=0; i<4; i++) {
+        if(hdd_file[i] != NULL && ide_open(&ide[i/2].drive[i%2], hdd_file[i]) == false) {
+            fprintf(stderr, "Can not open hdd image %s\n", hdd_file[i]);
+            return -3;
+        }
+    }
+
+    memset(floppy, 0, sizeof(floppy));
+    for(int i=0; i<2; i++) {
+        if(fdd_file[i] != NULL && floppy_open(&floppy[i], fdd_file[i]) == false) {
+            fprintf(stderr, "Can not open fdd image %s\n", fdd_file[i]);
+            return -3;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    Verilated::commandArgs(argc, argv);
+
+    top = new Vsystem();
+
+    top->clock_rate      = CLOCK_RATE;
+    top->clock_rate_vga  = CLOCK_RATE;
+
+    top->l1_disable      = 0;
+    top->l2_disable      = 0;
+    top->uma_ram         = 0;
+    top->bootcfg         = 0;
+    top->floppy_wp       = 0;
+
+    top->ps2_kbclk_in    = 1;
+    top->ps2_kbdat_in    = 1;
+    top->ps2_mouseclk_in = 1;
+    top->ps2_mousedat_in = 1;
+
+    top->uart1_rx        = 1;
+    top->uart1_cts_n     = 1;
+    top->uart1_dcd_n     = 1;
+    top->uart1_dsr_n     = 1;
+    top->uart2_rx        = 1;
+    top->uart2_cts_n     = 1;
+    top->uart2_dcd_n     = 1;
+    top->uart2_dsr_n     = 1;
+    top->mpu_rx          = 1;
+
+    top->joystick_dis    = 3;
+
+    //reset
+    top->reset = 1;
+    for(int i=0; i<16; i++) tick();
+    top->reset = 0;
+
+    //what the HPS does once the core is out of reset
+    ide_set_config(&ide[0]);
+    ide_set_config(&ide[1]);
+    floppy_init();
+    rtc_init(mem_mb, floppy[0].fp? floppy[0].cmos_type : 0);
+
+    //--------------------------------------------------------------------------
+
+    if(cache_file != NULL && cache_stats_open(cache_file, cache_window) == false) fprintf(stderr, "Can not open %s.csv\n", cache_file);
+
+    uint64_t start_time = time_usec();
+
+    while(!Verilated::gotFinish()) {
+
+        tick();
+
+        ide_poll(&ide[0], top->ide0_request);
+        ide_poll(&ide[1], top->ide1_request);
+        floppy_poll(top->fdd_request);
+
+        if((cycle % 1000000) == 0) printf("cycle: %lu\n", cycle);
+        if(cache_file != NULL && cache_window != 0 && cycle - cache_stats.window_start >= cache_window) cache_stats_window();
+
+        if(max_cycles != 0 && cycle >= max_cycles) break;
+
+        //the io bus signals are made public by system.vlt
+        if(until_e9 >= 0 && top->rootp->system__DOT__iobus_write && top->rootp->system__DOT__iobus_address == 0xE9 &&
+            (top->rootp->system__DOT__iobus_writedata & 0xFF) == (uint32_t)until_e9) break;
+    }
+
+    uint64_t elapsed = time_usec() - start_time;
+    printf("cycles: %lu, seconds: %.3f, cycles per second: %.0f\n", cycle, elapsed / 1000000.0, (elapsed > 0)? cycle * 1000000.0 / elapsed : 0.0);
+    printf("ddram: read commands %lu, read beats %lu, write beats %lu, busy cycles %lu\n", ddram_read_commands, ddram_read_beats, ddram_write_beats, ddram_busy_total);
+    printf("ide: sectors read %lu, sectors written %lu\n", ide_sectors_read, ide_sectors_written);
+    if(cache_file != NULL && cache_stats_close(cache_file) == false) fprintf(stderr, "Can not write %s\n", cache_file);
+
+    top->final();
+    delete top;
+
+    for(int i=0; i<4; i++) if(ide[i/2].drive[i%2].fp) fclose(ide[i/2].drive[i%2].fp);
+    for(int i=0; i<2; i++) if(floppy[i].fp) fclose(floppy[i].fp);
+
+    munmap(ddram, DDRAM_SIZE);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#!/bin/bash
+#
+# Cache geometry sweep: builds one Vsystem per line of the matrix, runs the
+# same workload on each through farm.sh and reports hit rates and total cycles
+# next to the data RAM each geometry needs.
+#
+# usage: sweep.sh [-j jobs] [-t timeout_seconds] [-m matrix_file] [-o out_dir] [-- Vsystem options]
+#
+# matrix_file, one geometry per line, '#' starts a comment:
+#   <name> <l1i_lines> <l1i_linesize> <l1i_ways> <l2_lines> <l2_linesize> <l2_ways> [l1i_prefetch [dc_lines dc_ways [dc_writeback]]]
+# l1i_linesize is in dwords and a multiple of 8, l2_linesize in 64 bit words,
+# l1i_prefetch 1 turns on the next line prefetch of the l1 icache (default 0).
+# A prefetch the cpu does not want is cancelled at the next word, but the
+# readcode burst it is in (8 dwords) still ends on the bus: its cost shows in
+# the cycles, not only in "l1 prefetch wasted".
+# The l1 data cache is left out by default (dc_lines 0, DCACHE=0); dc_lines
+# builds it in (4 ways, write-through unless given) and dc_writeback 1 makes
+# it write-back.
+# Without -m the matrix below is used, each line one step away from the
+# default geometry.
+#
+# The Vsystem options are the workload. Give it a fixed end: --until-e9 for a
+# guest that writes a marker byte to port 0xE9 when done, so the cycles can
+# be compared, or just --cycles to compare the rates over the same time.
+
+JOBS=$(nproc)
+LIMIT=86400
+MATRIX=
+OUT=sweep
+
+while getopts "j:t:m:o:" opt; do
+	case $opt in
+		j) JOBS=$OPTARG ;;
+		t) LIMIT=$OPTARG ;;
+		m) MATRIX=$OPTARG ;;
+		o) OUT=$OPTARG ;;
+		*) echo "usage: $0 [-j jobs] [-t timeout_seconds] [-m matrix_file] [-o out_dir] [-- Vsystem options]"; exit 2 ;;
+	esac
+done
+shift $((OPTIND - 1))
+ARGS="$*"
+[ -z "$ARGS" ] && ARGS="--cycles 20000000"
+
+DEFAULT_MATRIX="
+default      128  8 4   128 8 4
+l1i-1way     128  8 1   128 8 4
+l1i-2way     128  8 2   128 8 4
+l1i-8way     128  8 8   128 8 4
+l1i-64       64   8 4   128 8 4
+l1i-256      256  8 4   128 8 4
+l1i-512      512  8 4   128 8 4
+l1i-line16   128 16 4   128 8 4
+l1i-prefetch 128  8 4   128 8 4   1
+dc-on        128  8 4   128 8 4   0 128 4
+dc-2way      128  8 4   128 8 4   0 128 2
+dc-8way      128  8 4   128 8 4   0 128 8
+dc-256       128  8 4   128 8 4   0 256 4
+dc-writeback 128  8 4   128 8 4   0 128 4 1
+l2-1way      128  8 4   128 8 1
+l2-2way      128  8 4   128 8 2
+l2-8way      128  8 4   128 8 8
+l2-256       128  8 4   256 8 4
+l2-512       128  8 4   512 8 4
+l2-line16    128  8 4   128 16 4
+"
+
+if [ -n "$MATRIX" ]; then
+	mapfile -t GEOMETRIES < <(grep -v '^\s*\(#\|$\)' "$MATRIX")
+else
+	mapfile -t GEOMETRIES < <(echo "$DEFAULT_MATRIX" | grep -v '^\s*$')
+fi
+
+mkdir -p "$OUT"
+OUT=$(cd "$OUT" && pwd)
+
+JOB_FILE=$OUT/jobs.txt
+: > "$JOB_FILE"
+
+for line in "${GEOMETRIES[@]}"; do
+	read -r name l1_lines l1_size l1_ways l2_lines l2_size l2_ways l1_prefetch dc_lines dc_ways dc_writeback <<< "$line"
+	dc_lines=${dc_lines:-0}
+
+	echo "building $name"
+	make MDIR=obj_sweep_$name DCACHE=$([ "$dc_lines" -ne 0 ] && echo 1 || echo 0) \
+		GEOMETRY="-GL1I_LINES=$l1_lines -GL1I_LINESIZE=$l1_size -GL1I_ASSOCIATIVITY=$l1_ways -GL1I_PREFETCH=${l1_prefetch:-0} \
+		-GDCACHE_LINES=$([ "$dc_lines" -ne 0 ] && echo $dc_lines || echo 128) -GDCACHE_ASSOCIATIVITY=${dc_ways:-4} -GDCACHE_WRITEBACK=${dc_writeback:-0} \
+		-GL2_LINES=$l2_lines -GL2_LINESIZE=$l2_size -GL2_ASSOCIATIVITY=$l2_ways" > "$OUT/build_$name.txt" 2>&1 \
+		|| { echo "build of $name failed, see $OUT/build_$name.txt"; exit 1; }
+
+	echo "$name $LIMIT ./obj_sweep_$name/Vsystem $ARGS --cache-stats $OUT/$name.txt" >> "$JOB_FILE"
+done
+
+./../farm.sh -j "$JOBS" -o "$OUT/farm" "$JOB_FILE"
+
+#value after the label in a --cache-stats file
+stat_value() {
+	awk -v key="$2" 'index($0, key) == 1 { sub(/%.*/, "", $0); print $NF; exit }' "$1"
+}
+
+REPORT=$OUT/report.txt
+{
+	printf "%-14s %9s %9s %9s %14s %10s %10s %10s\n" "geometry" "l1i KB" "dc KB" "l2 KB" "cycles" "l1i hit%" "dc hit%" "l2 hit%"
+	for line in "${GEOMETRIES[@]}"; do
+		read -r name l1_lines l1_size l1_ways l2_lines l2_size l2_ways l1_prefetch dc_lines dc_ways dc_writeback <<< "$line"
+		file=$OUT/$name.txt
+		l1_kb=$(awk "BEGIN { print $l1_lines * $l1_size * 4 * $l1_ways / 1024 }")
+		dc_kb=$(awk "BEGIN { print ${dc_lines:-0} * 8 * 4 * ${dc_ways:-4} / 1024 }")
+		l2_kb=$(awk "BEGIN { print $l2_lines * $l2_size * 8 * $l2_ways / 1024 }")
+		if [ ! -f "$file" ]; then
+			printf "%-14s %9s %9s %9s %14s\n" "$name" "$l1_kb" "$dc_kb" "$l2_kb" "NOT RUN"
+			continue
+		fi
+		dc_hit=$(awk "BEGIN { printf \"%.2f\", 100 - $(stat_value "$file" "dcache miss rate:") }")
+		if [ "${dc_lines:-0}" -eq 0 ]; then dc_kb=-; dc_hit=-; fi
+		printf "%-14s %9s %9s %9s %14s %10.2f %10s %10.2f\n" "$name" "$l1_kb" "$dc_kb" "$l2_kb" "$(stat_value "$file" "cycles:")" \
+			"$(awk "BEGIN { print 100 - $(stat_value "$file" "l1 miss rate:") }")" "$dc_hit" \
+			"$(awk "BEGIN { print 100 - $(stat_value "$file" "l2 miss rate:") }")"
+	done
+} > "$REPORT"
+
+cat "$REPORT"
+echo "report in $REPORT"